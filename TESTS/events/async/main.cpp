@@ -0,0 +1,300 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_events.h"
+#include "mbed.h"
+#include "rtos.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] async task test cases require a RTOS to run
+#endif
+
+#define TEST_SESSIONS       32
+// A timeout and a wake up event per task
+#define TEST_EQUEUE_SIZE    (2*TEST_SESSIONS*EVENTS_EVENT_SIZE)
+#define TEST_STACK_SIZE     1024
+
+#define TEST_FLAG           0x4u
+
+// Task going through the awaits of a session
+class Session : public AsyncTask {
+public:
+    Session(EventQueue *queue, Semaphore *sem, EventFlags *flags)
+        : AsyncTask(queue), _sem(sem), _flags(flags),
+          steps(0), timeouts(0) {}
+
+    int steps;
+    int timeouts;
+
+    // The steps of run as a thread would go through them, blocking
+    void block() {
+        Thread::yield();
+        steps++;
+
+        Thread::wait(10);
+        timeouts++;
+        steps++;
+
+        timeouts += !_sem->wait(10);
+        steps++;
+
+        _sem->wait();
+        steps++;
+
+        _flags->wait_any(TEST_FLAG, 1000, false);
+        steps++;
+    }
+
+protected:
+    virtual void run() {
+        ASYNC_BEGIN();
+        ASYNC_YIELD();
+        steps++;
+
+        ASYNC_DELAY(10);
+        timeouts += timed_out();
+        steps++;
+
+        // Nothing releases the semaphore yet
+        ASYNC_AWAIT_FOR(try_acquire(*_sem), 10);
+        timeouts += timed_out();
+        steps++;
+
+        ASYNC_AWAIT(try_acquire(*_sem));
+        steps++;
+
+        ASYNC_AWAIT_FOR(try_wait_flags(*_flags, TEST_FLAG, false, false), 1000);
+        timeouts += timed_out();
+        steps++;
+        ASYNC_END();
+    }
+
+private:
+    Semaphore *_sem;
+    EventFlags *_flags;
+};
+
+// Task counting its wake ups, resumed by wake only
+class Counter : public AsyncTask {
+public:
+    Counter(EventQueue *queue)
+        : AsyncTask(queue), count(0), target(0), runs(0) {}
+
+    volatile int count;
+    int target;
+    int runs;
+
+protected:
+    virtual void run() {
+        runs++;
+        ASYNC_BEGIN();
+        while (true) {
+            ASYNC_AWAIT(count >= target);
+            target++;
+        }
+        ASYNC_END();
+    }
+};
+
+void release_sessions(Semaphore *sem) {
+    for (int i = 0; i < TEST_SESSIONS; i++) {
+        sem->release();
+    }
+}
+
+void session_test() {
+    EventQueue queue(TEST_EQUEUE_SIZE);
+    Semaphore sem(0, TEST_SESSIONS);
+    EventFlags flags;
+    Session *sessions[TEST_SESSIONS];
+
+    for (int i = 0; i < TEST_SESSIONS; i++) {
+        sessions[i] = new Session(&queue, &sem, &flags);
+        sessions[i]->start();
+    }
+
+    queue.dispatch(50);
+    for (int i = 0; i < TEST_SESSIONS; i++) {
+        TEST_ASSERT_EQUAL(3, sessions[i]->steps);
+        TEST_ASSERT_EQUAL(2, sessions[i]->timeouts);
+    }
+
+    // Released from another context, the tasks poll the semaphore
+    queue.call(release_sessions, &sem);
+    queue.dispatch(10 + 2*ASYNC_TASK_POLL_INTERVAL);
+    flags.set(TEST_FLAG);
+    queue.dispatch(10 + 2*ASYNC_TASK_POLL_INTERVAL);
+
+    for (int i = 0; i < TEST_SESSIONS; i++) {
+        TEST_ASSERT_TRUE(sessions[i]->finished());
+        TEST_ASSERT_EQUAL(5, sessions[i]->steps);
+        TEST_ASSERT_EQUAL(2, sessions[i]->timeouts);
+        delete sessions[i];
+    }
+}
+
+void wake_test() {
+    EventQueue queue(TEST_EQUEUE_SIZE);
+    Counter counter(&queue);
+
+    counter.start();
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(1, counter.target);
+
+    // Without a wake up the task is not polled
+    counter.count = 1;
+    queue.dispatch(2*ASYNC_TASK_POLL_INTERVAL);
+    TEST_ASSERT_EQUAL(1, counter.target);
+
+    counter.wake();
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(2, counter.target);
+
+    // Wake ups before the dispatch are merged
+    int runs = counter.runs;
+    counter.count = 3;
+    counter.wake();
+    counter.wake();
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(runs + 1, counter.runs);
+    TEST_ASSERT_EQUAL(4, counter.target);
+
+    counter.cancel();
+    TEST_ASSERT_TRUE(counter.finished());
+    counter.count = 10;
+    counter.wake();
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(4, counter.target);
+
+    counter.start();
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(11, counter.target);
+}
+
+static uint32_t heap_now() {
+#if defined(MBED_HEAP_STATS_ENABLED)
+    mbed_stats_heap_t stats;
+    mbed_stats_heap_get(&stats);
+    return stats.current_size;
+#else
+    return 0;
+#endif
+}
+
+void memory_test() {
+    Semaphore sem(0, TEST_SESSIONS);
+    EventFlags flags;
+    Session *sessions[TEST_SESSIONS];
+    Thread *threads[TEST_SESSIONS];
+
+    // A thread per session, measured while the sessions wait for the flag
+    uint32_t heap = heap_now();
+    for (int i = 0; i < TEST_SESSIONS; i++) {
+        sessions[i] = new Session(NULL, &sem, &flags);
+        threads[i] = new Thread(osPriorityNormal, TEST_STACK_SIZE);
+        TEST_ASSERT_EQUAL(osOK, threads[i]->start(callback(sessions[i], &Session::block)));
+    }
+
+    Thread::wait(50);
+    release_sessions(&sem);
+    Thread::wait(10);
+    uint32_t threads_heap = heap_now() - heap;
+    uint32_t threads_stack = 0;
+    for (int i = 0; i < TEST_SESSIONS; i++) {
+        TEST_ASSERT_EQUAL(4, sessions[i]->steps);
+        threads_stack += threads[i]->max_stack();
+    }
+
+    flags.set(TEST_FLAG);
+    for (int i = 0; i < TEST_SESSIONS; i++) {
+        threads[i]->join();
+        TEST_ASSERT_EQUAL(5, sessions[i]->steps);
+        TEST_ASSERT_EQUAL(2, sessions[i]->timeouts);
+        delete threads[i];
+        delete sessions[i];
+    }
+    flags.clear(TEST_FLAG);
+
+    // The same sessions as tasks of a queue dispatched by one thread
+    heap = heap_now();
+    EventQueue *queue = new EventQueue(TEST_EQUEUE_SIZE);
+    Thread *dispatcher = new Thread(osPriorityNormal, TEST_STACK_SIZE);
+    for (int i = 0; i < TEST_SESSIONS; i++) {
+        sessions[i] = new Session(queue, &sem, &flags);
+        sessions[i]->start();
+    }
+    TEST_ASSERT_EQUAL(osOK, dispatcher->start(callback(queue, &EventQueue::dispatch_forever)));
+
+    Thread::wait(50);
+    release_sessions(&sem);
+    Thread::wait(10 + 2*ASYNC_TASK_POLL_INTERVAL);
+    uint32_t tasks_heap = heap_now() - heap;
+    uint32_t tasks_stack = dispatcher->max_stack();
+    for (int i = 0; i < TEST_SESSIONS; i++) {
+        TEST_ASSERT_EQUAL(4, sessions[i]->steps);
+    }
+
+    flags.set(TEST_FLAG);
+    Thread::wait(10 + 2*ASYNC_TASK_POLL_INTERVAL);
+    queue->break_dispatch();
+    dispatcher->join();
+    for (int i = 0; i < TEST_SESSIONS; i++) {
+        TEST_ASSERT_TRUE(sessions[i]->finished());
+        delete sessions[i];
+    }
+    delete dispatcher;
+    delete queue;
+
+    printf("%d sessions as threads with %d B stacks: heap %lu B, stack used %lu B\r\n",
+           TEST_SESSIONS, TEST_STACK_SIZE,
+           (unsigned long)threads_heap, (unsigned long)threads_stack);
+    printf("%d sessions as tasks dispatched with a %d B stack: heap %lu B, stack used %lu B\r\n",
+           TEST_SESSIONS, TEST_STACK_SIZE,
+           (unsigned long)tasks_heap, (unsigned long)tasks_stack);
+
+#if defined(MBED_HEAP_STATS_ENABLED)
+    // Nothing is counted if the allocator of the toolchain is not wrapped
+    if (threads_heap != 0 || tasks_heap != 0) {
+        TEST_ASSERT(tasks_heap < threads_heap / 4);
+    }
+#endif
+#if defined(MBED_STACK_STATS_ENABLED) && MBED_STACK_STATS_ENABLED
+    TEST_ASSERT(tasks_stack < threads_stack / 4);
+#endif
+}
+
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+const Case cases[] = {
+    Case("Testing 32 concurrent sessions", session_test),
+    Case("Testing task wake up", wake_test),
+    Case("Testing memory of 32 sessions", memory_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main() {
+    return !Harness::run(specification);
+}
@@ -16,6 +16,8 @@
 #include "utest/utest.h"
 #include "unity/unity.h"
 #include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "mbed_stats.h"
 
 #if !DEVICE_SLEEP
 #error [NOT_SUPPORTED] test not supported
@@ -37,6 +39,99 @@ void sleep_manager_deepsleep_counter_test()
     TEST_ASSERT_TRUE(deep_sleep_allowed);
 }
 
+void sleep_manager_wake_up_latency_test()
+{
+    const uint32_t latency = MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY;
+
+    // no early wake up unless deep sleep would be used for the rest
+    TEST_ASSERT_EQUAL_UINT32(0, sleep_manager_wake_up_latency(0));
+    if (latency > 0) {
+        TEST_ASSERT_EQUAL_UINT32(0, sleep_manager_wake_up_latency(2 * latency - 1));
+    }
+#ifndef MBED_DEBUG
+    TEST_ASSERT_EQUAL_UINT32(latency, sleep_manager_wake_up_latency(2 * latency));
+#endif
+
+    sleep_manager_lock_deep_sleep();
+    TEST_ASSERT_EQUAL_UINT32(0, sleep_manager_wake_up_latency(2 * latency + 1000));
+    sleep_manager_unlock_deep_sleep();
+}
+
+#if defined(MBED_SLEEP_STATS_ENABLED) && MBED_SLEEP_STATS_ENABLED
+static void wake_up()
+{
+}
+
+void sleep_manager_idle_governor_stats_test()
+{
+    mbed_stats_sleep_t start;
+    mbed_stats_sleep_t end;
+
+    // the timeout locks deep sleep and wakes up the sleep
+    mbed::Timeout timeout;
+    timeout.attach_us(&wake_up, 1000);
+    mbed_stats_sleep_get(&start);
+    sleep_manager_sleep_auto_for(1000 + MBED_CONF_PLATFORM_SLEEP_LATENCY);
+    mbed_stats_sleep_get(&end);
+    timeout.detach();
+
+    TEST_ASSERT_EQUAL_UINT32(start.sleep_cnt + 1, end.sleep_cnt);
+    TEST_ASSERT_EQUAL_UINT32(start.deep_sleep_cnt, end.deep_sleep_cnt);
+    TEST_ASSERT_EQUAL_UINT32(start.demoted_cnt, end.demoted_cnt);
+
+#if MBED_CONF_PLATFORM_SLEEP_LATENCY > 0
+    // too short to sleep at all
+    mbed_stats_sleep_get(&start);
+    sleep_manager_sleep_auto_for(MBED_CONF_PLATFORM_SLEEP_LATENCY - 1);
+    mbed_stats_sleep_get(&end);
+
+    TEST_ASSERT_EQUAL_UINT32(start.awake_cnt + 1, end.awake_cnt);
+    TEST_ASSERT_EQUAL_UINT32(start.sleep_cnt, end.sleep_cnt);
+    TEST_ASSERT_EQUAL_UINT32(start.deep_sleep_cnt, end.deep_sleep_cnt);
+#endif
+}
+#endif
+
+#if defined(MBED_SLEEP_TRACING_ENABLED) && MBED_SLEEP_TRACING_ENABLED
+#define MAX_LOCK_OWNERS 16
+
+static mbed_stats_sleep_lock_t lock_stats[MAX_LOCK_OWNERS];
+
+static const mbed_stats_sleep_lock_t *find_owner(const char *owner, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(lock_stats[i].owner, owner) == 0) {
+            return &lock_stats[i];
+        }
+    }
+    return NULL;
+}
+
+void sleep_manager_lock_tracing_test()
+{
+    sleep_manager_lock_deep_sleep();
+    wait_ms(10);
+
+    size_t count = mbed_stats_sleep_lock_get_each(lock_stats, MAX_LOCK_OWNERS);
+    const mbed_stats_sleep_lock_t *owner = find_owner("main.cpp", count);
+    TEST_ASSERT_NOT_NULL(owner);
+    TEST_ASSERT_EQUAL_UINT32(1, owner->count);
+    uint32_t lock_cnt = owner->lock_cnt;
+    TEST_ASSERT(owner->held_time >= 10 * 1000);
+
+    sleep_manager_unlock_deep_sleep();
+    wait_ms(10);
+
+    count = mbed_stats_sleep_lock_get_each(lock_stats, MAX_LOCK_OWNERS);
+    owner = find_owner("main.cpp", count);
+    TEST_ASSERT_NOT_NULL(owner);
+    TEST_ASSERT_EQUAL_UINT32(0, owner->count);
+    TEST_ASSERT_EQUAL_UINT32(lock_cnt, owner->lock_cnt);
+    // the held time stops at the unlock
+    TEST_ASSERT(owner->held_time < 20 * 1000);
+}
+#endif
+
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) 
 {
     greentea_case_failure_abort_handler(source, reason);
@@ -51,6 +146,13 @@ utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
 
 Case cases[] = {
     Case("sleep manager -  deep sleep counter", sleep_manager_deepsleep_counter_test, greentea_failure_handler),
+    Case("sleep manager - wake up latency", sleep_manager_wake_up_latency_test, greentea_failure_handler),
+#if defined(MBED_SLEEP_STATS_ENABLED) && MBED_SLEEP_STATS_ENABLED
+    Case("sleep manager - idle governor stats", sleep_manager_idle_governor_stats_test, greentea_failure_handler),
+#endif
+#if defined(MBED_SLEEP_TRACING_ENABLED) && MBED_SLEEP_TRACING_ENABLED
+    Case("sleep manager - deep sleep lock tracing", sleep_manager_lock_tracing_test, greentea_failure_handler),
+#endif
 };
 
 Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "mbed_stats.h"
+
+using utest::v1::Case;
+
+#if !defined(MBED_CPU_STATS_ENABLED) || !MBED_CPU_STATS_ENABLED
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+#define THREAD_STACK_SIZE   512
+#define MAX_THREAD_STATS    16
+#define BUSY_TIME_MS        100
+/* Allowed error in measured times, the lp ticker of tickless targets counts ~30 us steps */
+#define TIME_DELTA_US       (5 * 1000)
+
+static mbed_stats_thread_t thread_stats[MAX_THREAD_STATS];
+static Semaphore busy_done(0);
+static Semaphore finish(0);
+static osThreadId busy_id;
+static osThreadId sleeper_id;
+
+static void busy_thread()
+{
+    Timer timer;
+    busy_id = Thread::gettid();
+    timer.start();
+    while (timer.read_ms() < BUSY_TIME_MS) {
+    }
+    busy_done.release();
+    // Stay alive, terminated threads are not listed
+    finish.wait();
+}
+
+static void sleep_thread()
+{
+    sleeper_id = Thread::gettid();
+    Thread::wait(BUSY_TIME_MS);
+    finish.wait();
+}
+
+static void busy_raw_thread(void *arg)
+{
+    Timer timer;
+    timer.start();
+    while (timer.read_ms() < BUSY_TIME_MS) {
+    }
+    busy_done.release();
+}
+
+static void wait_raw_thread(void *arg)
+{
+    finish.wait();
+    busy_done.release();
+}
+
+static const mbed_stats_thread_t *find_thread(osThreadId_t id, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (thread_stats[i].id == (uint32_t)id) {
+            return &thread_stats[i];
+        }
+    }
+    return NULL;
+}
+
+/** Test that uptime grows with time and idle time grows while main sleeps
+
+    Given CPU stats enabled
+    When main thread waits
+    Then uptime and idle time grow by the waiting time and thread switches are counted
+ */
+void test_cpu_idle_time()
+{
+    mbed_stats_cpu_t start;
+    mbed_stats_cpu_t end;
+
+    mbed_stats_cpu_get(&start);
+    Thread::wait(BUSY_TIME_MS);
+    mbed_stats_cpu_get(&end);
+
+    TEST_ASSERT_UINT64_WITHIN(TIME_DELTA_US, BUSY_TIME_MS * 1000, end.uptime - start.uptime);
+    TEST_ASSERT_UINT64_WITHIN(TIME_DELTA_US, BUSY_TIME_MS * 1000, end.idle_time - start.idle_time);
+    TEST_ASSERT(end.switch_cnt >= start.switch_cnt + 2);
+}
+
+/** Test that run time of a busy thread is accounted to it and not to idle time
+
+    Given CPU stats enabled
+    When a thread is busy for BUSY_TIME_MS and another thread sleeps
+    Then the busy thread has run for BUSY_TIME_MS and the sleeping one for much less
+ */
+void test_thread_run_time()
+{
+    Thread busy(osPriorityNormal, THREAD_STACK_SIZE);
+    Thread sleeper(osPriorityNormal, THREAD_STACK_SIZE);
+    mbed_stats_cpu_t start;
+    mbed_stats_cpu_t end;
+
+    mbed_stats_cpu_get(&start);
+    TEST_ASSERT_EQUAL(osOK, sleeper.start(sleep_thread));
+    TEST_ASSERT_EQUAL(osOK, busy.start(busy_thread));
+    TEST_ASSERT_EQUAL(1, busy_done.wait());
+
+    size_t count = mbed_stats_thread_get_each(thread_stats, MAX_THREAD_STATS);
+    TEST_ASSERT(count > 0 && count <= MAX_THREAD_STATS);
+    const mbed_stats_thread_t *busy_stats = find_thread(busy_id, count);
+    const mbed_stats_thread_t *sleeper_stats = find_thread(sleeper_id, count);
+    const mbed_stats_thread_t *main_stats = find_thread(Thread::gettid(), count);
+    TEST_ASSERT_NOT_NULL(busy_stats);
+    TEST_ASSERT_NOT_NULL(sleeper_stats);
+    TEST_ASSERT_NOT_NULL(main_stats);
+    TEST_ASSERT_UINT64_WITHIN(TIME_DELTA_US, BUSY_TIME_MS * 1000, busy_stats->run_time);
+    TEST_ASSERT(sleeper_stats->run_time < TIME_DELTA_US);
+    TEST_ASSERT(busy_stats->switch_cnt >= 1);
+    TEST_ASSERT(main_stats->switch_cnt >= 1);
+
+    finish.release();
+    finish.release();
+    busy.join();
+    sleeper.join();
+
+    // The busy thread kept the CPU from idling
+    mbed_stats_cpu_get(&end);
+    TEST_ASSERT(end.idle_time - start.idle_time < end.uptime - start.uptime - (BUSY_TIME_MS * 1000 - TIME_DELTA_US));
+}
+
+/** Test that the stats of a thread created from the RTOS memory pool start at zero
+
+    Given a thread created with osThreadNew and no memory attributes, which was busy and has exited
+    When another thread is created the same way, likely in the control block of the first one
+    Then the new thread starts with no run time and no switches of the first one
+ */
+void test_raw_thread_stats()
+{
+    TEST_ASSERT_NOT_NULL(osThreadNew(busy_raw_thread, NULL, NULL));
+    TEST_ASSERT_EQUAL(1, busy_done.wait());
+    // Let the thread exit and its control block be freed
+    Thread::wait(10);
+
+    osThreadId_t id = osThreadNew(wait_raw_thread, NULL, NULL);
+    TEST_ASSERT_NOT_NULL(id);
+    Thread::wait(10);
+
+    size_t count = mbed_stats_thread_get_each(thread_stats, MAX_THREAD_STATS);
+    const mbed_stats_thread_t *stats = find_thread(id, count);
+    TEST_ASSERT_NOT_NULL(stats);
+    TEST_ASSERT(stats->run_time < TIME_DELTA_US);
+    TEST_ASSERT(stats->switch_cnt <= 2);
+
+    finish.release();
+    TEST_ASSERT_EQUAL(1, busy_done.wait());
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return utest::v1::verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test CPU idle time", test_cpu_idle_time),
+    Case("Test thread run time", test_thread_run_time),
+    Case("Test stats of a thread from the RTOS pool", test_raw_thread_stats),
+};
+
+utest::v1::Specification specification(test_setup, cases);
+
+int main()
+{
+    return !utest::v1::Harness::run(specification);
+}
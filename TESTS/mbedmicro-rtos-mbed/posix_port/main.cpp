@@ -0,0 +1,178 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+#if !defined(TARGET_POSIX)
+  #error [NOT_SUPPORTED] test of the POSIX port only
+#endif
+
+using namespace utest::v1;
+
+#define THREAD_STACK_SIZE 1024
+#define THREAD_COUNT 4
+#define THREAD_LOOPS 1000
+#define QUEUE_SIZE 4
+#define QUEUE_MSGS 100
+#define TICKER_PERIOD_US 10000
+#define TICKER_TICKS 50
+#define TICKER_TOLERANCE_US 5000
+
+Mutex counter_mutex;
+volatile uint32_t counter;
+
+Ticker ticker;
+Timer ticker_timer;
+Semaphore ticker_sem(0);
+volatile uint32_t ticker_count;
+volatile int ticker_last_us;
+
+void increment_counter()
+{
+    for (int i = 0; i < THREAD_LOOPS; i++) {
+        counter_mutex.lock();
+        // The other threads run in the middle of the increment, they would
+        // lose it if the mutex did not keep them out
+        uint32_t value = counter;
+        Thread::yield();
+        counter = value + 1;
+        counter_mutex.unlock();
+    }
+}
+
+void send_messages(Queue<uint32_t, QUEUE_SIZE> *queue)
+{
+    for (uint32_t i = 1; i <= QUEUE_MSGS; i++) {
+        osStatus stat = queue->put((uint32_t *)i, osWaitForever);
+        TEST_ASSERT_EQUAL(osOK, stat);
+    }
+}
+
+void ticker_callback()
+{
+    if (++ticker_count == TICKER_TICKS) {
+        ticker_last_us = ticker_timer.read_us();
+        ticker_sem.release();
+    }
+}
+
+/** Test threads and mutex
+
+    Given threads incrementing a counter while they hold a mutex
+    When the threads yield to each other in the middle of an increment
+    Then no increment is lost and the threads are joined
+ */
+void test_thread_mutex()
+{
+    Thread *threads[THREAD_COUNT];
+
+    counter = 0;
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        threads[i] = new Thread(osPriorityNormal, THREAD_STACK_SIZE);
+        TEST_ASSERT_EQUAL(osOK, threads[i]->start(increment_counter));
+    }
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        TEST_ASSERT_EQUAL(osOK, threads[i]->join());
+        TEST_ASSERT_EQUAL(Thread::Deleted, threads[i]->get_state());
+        delete threads[i];
+    }
+
+    TEST_ASSERT_EQUAL(THREAD_COUNT * THREAD_LOOPS, counter);
+}
+
+/** Test queue
+
+    Given a thread putting more messages than the queue holds
+    When the messages are got from the main thread
+    Then the sender blocks on the full queue and all the messages are got in order
+ */
+void test_queue()
+{
+    Queue<uint32_t, QUEUE_SIZE> queue;
+    Thread thread(osPriorityNormal, THREAD_STACK_SIZE);
+
+    TEST_ASSERT_EQUAL(osOK, thread.start(callback(send_messages, &queue)));
+    for (uint32_t i = 1; i <= QUEUE_MSGS; i++) {
+        osEvent evt = queue.get(1000);
+        TEST_ASSERT_EQUAL(osEventMessage, evt.status);
+        TEST_ASSERT_EQUAL(i, evt.value.v);
+    }
+    thread.join();
+
+    osEvent evt = queue.get(0);
+    TEST_ASSERT_EQUAL(osOK, evt.status);
+}
+
+/** Test ticker
+
+    Given a ticker with a period of 10 ms
+    When it is attached for 50 ticks
+    Then the ticks take 500 ms of the us ticker and wake up the waiting thread
+ */
+void test_ticker()
+{
+    ticker_count = 0;
+    ticker_timer.reset();
+    ticker_timer.start();
+    ticker.attach_us(ticker_callback, TICKER_PERIOD_US);
+
+    int32_t tokens = ticker_sem.wait(2 * TICKER_TICKS * TICKER_PERIOD_US / 1000);
+    ticker.detach();
+    ticker_timer.stop();
+
+    TEST_ASSERT_EQUAL(1, tokens);
+    TEST_ASSERT_UINT32_WITHIN(TICKER_TOLERANCE_US, TICKER_TICKS * TICKER_PERIOD_US, ticker_last_us);
+}
+
+/** Test thread wait
+
+    Given the us ticker
+    When a thread waits for 100 ms
+    Then it is woken up after 100 ms
+ */
+void test_thread_wait()
+{
+    Timer timer;
+
+    timer.start();
+    Thread::wait(100);
+    timer.stop();
+
+    TEST_ASSERT_UINT32_WITHIN(TICKER_TOLERANCE_US, 100000, timer.read_us());
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test threads and mutex", test_thread_mutex),
+    Case("Test queue", test_queue),
+    Case("Test ticker", test_ticker),
+    Case("Test thread wait", test_thread_wait),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
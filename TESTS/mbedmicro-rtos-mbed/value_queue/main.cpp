@@ -0,0 +1,345 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define THREAD_STACK_SIZE 512
+#define TEST_TIMEOUT 50
+#define QUEUE_SIZE 8
+#define BATCH_SIZE 4
+#define BENCH_MSG_COUNT 10000
+
+typedef struct {
+    uint32_t time;
+    int16_t x;
+    int16_t y;
+    int16_t z;
+    uint16_t seq;
+} sample_t;
+
+static sample_t make_sample(uint32_t i)
+{
+    sample_t sample = { i * 3, (int16_t)i, (int16_t)-i, (int16_t)(i >> 1), (uint16_t)i };
+    return sample;
+}
+
+/** Test pass message by value
+
+    Given a value queue for a struct type
+    When a message is put into the queue and the original is changed
+    Then the message got from the queue is the one put into the queue
+ */
+void test_pass_value()
+{
+    ValueQueue<sample_t, 1> q;
+    sample_t msg = make_sample(1);
+    sample_t got;
+
+    TEST_ASSERT_EQUAL(osOK, q.put(msg));
+    msg.seq = 2;
+    TEST_ASSERT_EQUAL(osOK, q.get(got, 0));
+    TEST_ASSERT_EQUAL(1, got.seq);
+    TEST_ASSERT_EQUAL(3, got.time);
+    TEST_ASSERT_EQUAL(-1, got.y);
+}
+
+/** Test get from empty queue and put to full queue
+
+    Given an empty value queue with one slot
+    When a message is got, one is put and another is put
+    Then get and second put time out and the try variants fail without waiting
+ */
+void test_empty_full()
+{
+    ValueQueue<sample_t, 1> q;
+    sample_t msg = make_sample(1);
+    Timer timer;
+
+    TEST_ASSERT_TRUE(q.empty());
+    TEST_ASSERT_FALSE(q.try_get(msg));
+    timer.start();
+    TEST_ASSERT_EQUAL(osErrorTimeout, q.get(msg, TEST_TIMEOUT));
+    TEST_ASSERT_UINT32_WITHIN(5000, TEST_TIMEOUT * 1000, timer.read_us());
+
+    TEST_ASSERT_TRUE(q.try_put(msg));
+    TEST_ASSERT_TRUE(q.full());
+    TEST_ASSERT_EQUAL(1, q.count());
+    TEST_ASSERT_FALSE(q.try_put(msg));
+    TEST_ASSERT_EQUAL(osErrorResource, q.put(msg));
+    timer.reset();
+    TEST_ASSERT_EQUAL(osErrorTimeout, q.put(msg, TEST_TIMEOUT));
+    TEST_ASSERT_UINT32_WITHIN(5000, TEST_TIMEOUT * 1000, timer.read_us());
+}
+
+/** Test message ordering and priority
+
+    Given a value queue
+    When messages are put with different priorities
+    Then they are got in priority order, first in first out for the same priority
+ */
+void test_msg_prio()
+{
+    ValueQueue<uint16_t, 4> q;
+    uint16_t msg;
+
+    TEST_ASSERT_EQUAL(osOK, q.put(1, 0, 0));
+    TEST_ASSERT_EQUAL(osOK, q.put(2, 0, 0));
+    TEST_ASSERT_EQUAL(osOK, q.put(3, 0, 1));
+    TEST_ASSERT_EQUAL(osOK, q.get(msg, 0));
+    TEST_ASSERT_EQUAL(3, msg);
+    TEST_ASSERT_EQUAL(osOK, q.get(msg, 0));
+    TEST_ASSERT_EQUAL(1, msg);
+    TEST_ASSERT_EQUAL(osOK, q.get(msg, 0));
+    TEST_ASSERT_EQUAL(2, msg);
+}
+
+/** Test batch put and get
+
+    Given a value queue with QUEUE_SIZE slots
+    When more messages than fit are put with put_n and got with get_n
+    Then put_n puts only the messages that fit, and get_n gets the available ones in order
+ */
+void test_put_get_n()
+{
+    ValueQueue<sample_t, QUEUE_SIZE> q;
+    sample_t msgs[QUEUE_SIZE + 2];
+    sample_t got[QUEUE_SIZE + 2];
+
+    for (uint32_t i = 0; i < QUEUE_SIZE + 2; i++) {
+        msgs[i] = make_sample(i);
+    }
+    TEST_ASSERT_EQUAL(0, q.put_n(msgs, 0));
+    TEST_ASSERT_EQUAL(QUEUE_SIZE, q.put_n(msgs, QUEUE_SIZE + 2));
+    TEST_ASSERT_TRUE(q.full());
+    TEST_ASSERT_EQUAL(0, q.put_n(msgs, 1));
+
+    TEST_ASSERT_EQUAL(BATCH_SIZE, q.get_n(got, BATCH_SIZE, 0));
+    TEST_ASSERT_EQUAL(QUEUE_SIZE - BATCH_SIZE, q.get_n(&got[BATCH_SIZE], QUEUE_SIZE + 2, 0));
+    TEST_ASSERT_EQUAL_MEMORY(msgs, got, QUEUE_SIZE * sizeof(sample_t));
+    TEST_ASSERT_EQUAL(0, q.get_n(got, 1, 0));
+}
+
+static ValueQueue<sample_t, QUEUE_SIZE> isr_queue;
+static uint32_t isr_count;
+
+static void isr_put()
+{
+    if (isr_queue.try_put(make_sample(isr_count))) {
+        isr_count++;
+    }
+}
+
+/** Test put from ISR
+
+    Given a ticker putting messages to a value queue with try_put
+    When a thread waits for the messages
+    Then the messages are got in order
+ */
+void test_isr_put()
+{
+    Ticker ticker;
+    sample_t msg;
+
+    isr_count = 0;
+    ticker.attach_us(isr_put, 1000);
+    for (uint32_t i = 0; i < QUEUE_SIZE * 2; i++) {
+        TEST_ASSERT_EQUAL(osOK, isr_queue.get(msg, TEST_TIMEOUT));
+        TEST_ASSERT_EQUAL(i, msg.seq);
+    }
+    ticker.detach();
+}
+
+#define ISR_BATCH_SIZE (2 * OS_ISR_FIFO_QUEUE)
+
+static ValueQueue<sample_t, ISR_BATCH_SIZE> isr_batch_queue;
+static sample_t isr_batch[ISR_BATCH_SIZE];
+static volatile uint32_t isr_batch_count;
+static Semaphore isr_batch_sem(0);
+
+static void isr_put_n()
+{
+    isr_batch_count = isr_batch_queue.put_n(isr_batch, ISR_BATCH_SIZE);
+    isr_batch_sem.release();
+}
+
+static void isr_get_n()
+{
+    isr_batch_count = isr_batch_queue.get_n(isr_batch, ISR_BATCH_SIZE, 0);
+    isr_batch_sem.release();
+}
+
+/** Test batch put and get from ISR
+
+    Given a value queue with room for twice the RTOS ISR queue
+    When a batch as large as the value queue is put and got from a timeout
+    Then only OS_ISR_FIFO_QUEUE messages are moved, without overflowing the ISR queue
+ */
+void test_isr_put_get_n()
+{
+    Timeout timeout;
+    sample_t msgs[ISR_BATCH_SIZE];
+
+    for (uint32_t i = 0; i < ISR_BATCH_SIZE; i++) {
+        isr_batch[i] = make_sample(i);
+    }
+    timeout.attach_us(isr_put_n, 1000);
+    TEST_ASSERT_EQUAL(1, isr_batch_sem.wait(TEST_TIMEOUT));
+    TEST_ASSERT_EQUAL(OS_ISR_FIFO_QUEUE, isr_batch_count);
+    TEST_ASSERT_EQUAL(OS_ISR_FIFO_QUEUE, isr_batch_queue.get_n(msgs, ISR_BATCH_SIZE, 0));
+    TEST_ASSERT_EQUAL_MEMORY(isr_batch, msgs, OS_ISR_FIFO_QUEUE * sizeof(sample_t));
+
+    for (uint32_t i = 0; i < ISR_BATCH_SIZE; i++) {
+        msgs[i] = make_sample(i);
+    }
+    TEST_ASSERT_EQUAL(ISR_BATCH_SIZE, isr_batch_queue.put_n(msgs, ISR_BATCH_SIZE));
+    timeout.attach_us(isr_get_n, 1000);
+    TEST_ASSERT_EQUAL(1, isr_batch_sem.wait(TEST_TIMEOUT));
+    TEST_ASSERT_EQUAL(OS_ISR_FIFO_QUEUE, isr_batch_count);
+    TEST_ASSERT_EQUAL_MEMORY(msgs, isr_batch, OS_ISR_FIFO_QUEUE * sizeof(sample_t));
+    TEST_ASSERT_EQUAL(ISR_BATCH_SIZE - OS_ISR_FIFO_QUEUE, isr_batch_queue.count());
+}
+
+static Mail<sample_t, QUEUE_SIZE> bench_mail;
+static ValueQueue<sample_t, QUEUE_SIZE> bench_queue;
+
+static void mail_producer()
+{
+    for (uint32_t i = 0; i < BENCH_MSG_COUNT; i++) {
+        sample_t *msg;
+        while ((msg = bench_mail.alloc()) == NULL) {
+            Thread::yield();
+        }
+        *msg = make_sample(i);
+        bench_mail.put(msg);
+    }
+}
+
+static void queue_producer()
+{
+    for (uint32_t i = 0; i < BENCH_MSG_COUNT; i++) {
+        bench_queue.put(make_sample(i), osWaitForever);
+    }
+}
+
+static void queue_batch_producer()
+{
+    sample_t msgs[BATCH_SIZE];
+    for (uint32_t i = 0; i < BENCH_MSG_COUNT; ) {
+        uint32_t n = BENCH_MSG_COUNT - i < BATCH_SIZE ? BENCH_MSG_COUNT - i : BATCH_SIZE;
+        for (uint32_t j = 0; j < n; j++) {
+            msgs[j] = make_sample(i + j);
+        }
+        i += bench_queue.put_n(msgs, n, osWaitForever);
+    }
+}
+
+static uint32_t msgs_per_sec(int us)
+{
+    return (uint64_t)BENCH_MSG_COUNT * 1000000 / (us > 0 ? us : 1);
+}
+
+/** Benchmark messages per second of Mail and ValueQueue
+
+    Given a producer thread sending BENCH_MSG_COUNT samples
+    When main thread receives them with Mail, ValueQueue and batched ValueQueue
+    Then all messages arrive in order, and the message rates are printed
+ */
+void test_benchmark()
+{
+    Timer timer;
+    uint32_t seq;
+
+    {
+        Thread producer(osPriorityNormal, THREAD_STACK_SIZE);
+        timer.start();
+        TEST_ASSERT_EQUAL(osOK, producer.start(mail_producer));
+        for (seq = 0; seq < BENCH_MSG_COUNT; seq++) {
+            osEvent evt = bench_mail.get();
+            TEST_ASSERT_EQUAL(osEventMail, evt.status);
+            sample_t *msg = (sample_t *)evt.value.p;
+            TEST_ASSERT_EQUAL((uint16_t)seq, msg->seq);
+            bench_mail.free(msg);
+        }
+        timer.stop();
+        producer.join();
+        utest_printf("Mail:             %lu msg/s\r\n", (unsigned long)msgs_per_sec(timer.read_us()));
+    }
+
+    {
+        Thread producer(osPriorityNormal, THREAD_STACK_SIZE);
+        sample_t msg;
+        timer.reset();
+        timer.start();
+        TEST_ASSERT_EQUAL(osOK, producer.start(queue_producer));
+        for (seq = 0; seq < BENCH_MSG_COUNT; seq++) {
+            TEST_ASSERT_EQUAL(osOK, bench_queue.get(msg));
+            TEST_ASSERT_EQUAL((uint16_t)seq, msg.seq);
+        }
+        timer.stop();
+        producer.join();
+        utest_printf("ValueQueue:       %lu msg/s\r\n", (unsigned long)msgs_per_sec(timer.read_us()));
+    }
+
+    {
+        Thread producer(osPriorityNormal, THREAD_STACK_SIZE);
+        sample_t msgs[BATCH_SIZE];
+        timer.reset();
+        timer.start();
+        TEST_ASSERT_EQUAL(osOK, producer.start(queue_batch_producer));
+        for (seq = 0; seq < BENCH_MSG_COUNT; ) {
+            uint32_t n = bench_queue.get_n(msgs, BATCH_SIZE);
+            TEST_ASSERT(n > 0);
+            for (uint32_t j = 0; j < n; j++, seq++) {
+                TEST_ASSERT_EQUAL((uint16_t)seq, msgs[j].seq);
+            }
+        }
+        timer.stop();
+        producer.join();
+        utest_printf("ValueQueue batch: %lu msg/s\r\n", (unsigned long)msgs_per_sec(timer.read_us()));
+    }
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test pass value", test_pass_value),
+    Case("Test empty and full queue", test_empty_full),
+    Case("Test message priority", test_msg_prio),
+    Case("Test put_n and get_n", test_put_get_n),
+    Case("Test put from ISR", test_isr_put),
+    Case("Test put_n and get_n from ISR", test_isr_put_get_n),
+    Case("Benchmark Mail and ValueQueue", test_benchmark)
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,873 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * mbed TLS benchmarks.
+ *
+ * Plain C on top of the mbed TLS API and the two clock hooks declared in
+ * benchmark.h, so the same code runs under greentea and natively. The
+ * module APIs are called directly (rather than through the cipher or md
+ * layers) so that *_alt.c accelerators are what gets measured.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+
+#include "mbedtls/aes.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/ccm.h"
+#include "mbedtls/sha1.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/hmac_drbg.h"
+#include "mbedtls/md.h"
+#include "mbedtls/cipher.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/ecdh.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/certs.h"
+
+#if defined(__MBED__)
+#define EOL "\r\n"
+#else
+#define EOL "\n"
+#endif
+
+/* Time spent on each measurement */
+#if !defined(BENCH_THROUGHPUT_MS)
+#define BENCH_THROUGHPUT_MS     250
+#endif
+#if !defined(BENCH_OPS_MS)
+#define BENCH_OPS_MS            1000
+#endif
+
+/* Operations always run at least this many times, however slow */
+#define BENCH_MIN_OPS           2
+
+#define BUFSIZE                 1024
+
+typedef int (*bench_fn)(void *ctx);
+
+static unsigned char buf[BUFSIZE];
+
+static void report(const char *group, const char *name,
+                   uint64_t value_x100, const char *unit)
+{
+    printf("bench,%s,%s,%lu.%02lu,%s" EOL, group, name,
+           (unsigned long) (value_x100 / 100), (unsigned long) (value_x100 % 100),
+           unit);
+}
+
+/* Run fn, which processes len bytes, for BENCH_THROUGHPUT_MS */
+static int throughput_len(const char *group, const char *name,
+                          bench_fn fn, void *ctx, size_t len)
+{
+    const uint64_t budget = (uint64_t) bench_cycles_hz() * BENCH_THROUGHPUT_MS / 1000;
+    uint64_t start, elapsed;
+    uint64_t bytes = 0;
+    int ret;
+
+    /* Warm up caches and lazily allocated state */
+    if ((ret = fn(ctx)) != 0) {
+        return ret;
+    }
+
+    start = bench_cycles();
+    do {
+        if ((ret = fn(ctx)) != 0) {
+            return ret;
+        }
+        bytes += len;
+        elapsed = bench_cycles() - start;
+    } while (elapsed < budget);
+
+    report(group, name, elapsed * 100 / bytes, "cycles/byte");
+    return 0;
+}
+
+/* Run fn, which processes BUFSIZE bytes, for BENCH_THROUGHPUT_MS */
+static int throughput(const char *group, const char *name,
+                      bench_fn fn, void *ctx)
+{
+    return throughput_len(group, name, fn, ctx, BUFSIZE);
+}
+
+/* Run fn, which performs one operation, for BENCH_OPS_MS */
+static int operations(const char *group, const char *name,
+                      bench_fn fn, void *ctx)
+{
+    const uint64_t budget = (uint64_t) bench_cycles_hz() * BENCH_OPS_MS / 1000;
+    uint64_t start, elapsed;
+    uint64_t ops = 0;
+    int ret;
+
+    start = bench_cycles();
+    do {
+        if ((ret = fn(ctx)) != 0) {
+            return ret;
+        }
+        ops++;
+        elapsed = bench_cycles() - start;
+    } while (elapsed < budget || ops < BENCH_MIN_OPS);
+
+    report(group, name, ops * bench_cycles_hz() * 100 / elapsed, "ops/s");
+    return 0;
+}
+
+void bench_header(void)
+{
+    printf("bench,group,name,value,unit" EOL);
+    report("clock", "frequency", (uint64_t) bench_cycles_hz() * 100, "Hz");
+}
+
+/*
+ * Deterministic seed: the figures do not depend on the quality of the
+ * randomness, and this keeps runs comparable
+ */
+static int bench_entropy(void *ctx, unsigned char *out, size_t len)
+{
+    (void) ctx;
+    for (size_t i = 0; i < len; i++) {
+        out[i] = (unsigned char) i;
+    }
+    return 0;
+}
+
+#if defined(MBEDTLS_CTR_DRBG_C)
+static mbedtls_ctr_drbg_context drbg;
+
+static int drbg_setup(void)
+{
+    mbedtls_ctr_drbg_init(&drbg);
+    return mbedtls_ctr_drbg_seed(&drbg, bench_entropy, NULL,
+                                 (const unsigned char *) "bench", 5);
+}
+#endif
+
+/*
+ * AES
+ */
+#if defined(MBEDTLS_AES_C)
+static mbedtls_aes_context aes;
+static unsigned char iv[16];
+
+static int aes_ecb(void *ctx)
+{
+    int ret = 0;
+
+    (void) ctx;
+    for (size_t i = 0; i < BUFSIZE && ret == 0; i += 16) {
+        ret = mbedtls_aes_crypt_ecb(&aes, MBEDTLS_AES_ENCRYPT, buf + i, buf + i);
+    }
+    return ret;
+}
+
+#if defined(MBEDTLS_CIPHER_MODE_CBC)
+static int aes_cbc(void *ctx)
+{
+    (void) ctx;
+    return mbedtls_aes_crypt_cbc(&aes, MBEDTLS_AES_ENCRYPT, BUFSIZE, iv, buf, buf);
+}
+#endif
+
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+static int aes_ctr(void *ctx)
+{
+    unsigned char stream[16];
+    size_t nc_off = 0;
+
+    (void) ctx;
+    return mbedtls_aes_crypt_ctr(&aes, BUFSIZE, &nc_off, iv, stream, buf, buf);
+}
+#endif
+
+#if defined(MBEDTLS_GCM_C)
+static int aes_gcm(void *ctx)
+{
+    unsigned char tag[16];
+
+    return mbedtls_gcm_crypt_and_tag((mbedtls_gcm_context *) ctx, MBEDTLS_GCM_ENCRYPT,
+                                     BUFSIZE, iv, 12, NULL, 0, buf, buf, sizeof(tag), tag);
+}
+#endif
+
+#if defined(MBEDTLS_CCM_C)
+static int aes_ccm(void *ctx)
+{
+    unsigned char tag[16];
+
+    return mbedtls_ccm_encrypt_and_tag((mbedtls_ccm_context *) ctx, BUFSIZE,
+                                       iv, 12, NULL, 0, buf, buf, tag, sizeof(tag));
+}
+#endif
+#endif /* MBEDTLS_AES_C */
+
+int bench_aes(void)
+{
+#if defined(MBEDTLS_AES_C)
+    static const unsigned char key[32] = { 0 };
+    static const unsigned int keybits[] = { 128, 256 };
+    char name[24];
+    int ret = 0;
+
+    for (size_t k = 0; k < sizeof(keybits) / sizeof(keybits[0]) && ret == 0; k++) {
+        unsigned int bits = keybits[k];
+
+        mbedtls_aes_init(&aes);
+        ret = mbedtls_aes_setkey_enc(&aes, key, bits);
+        if (ret == 0) {
+            snprintf(name, sizeof(name), "aes-%u-ecb", bits);
+            ret = throughput("aes", name, aes_ecb, NULL);
+        }
+#if defined(MBEDTLS_CIPHER_MODE_CBC)
+        if (ret == 0) {
+            snprintf(name, sizeof(name), "aes-%u-cbc", bits);
+            ret = throughput("aes", name, aes_cbc, NULL);
+        }
+#endif
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+        if (ret == 0) {
+            snprintf(name, sizeof(name), "aes-%u-ctr", bits);
+            ret = throughput("aes", name, aes_ctr, NULL);
+        }
+#endif
+        mbedtls_aes_free(&aes);
+
+#if defined(MBEDTLS_GCM_C)
+        if (ret == 0) {
+            mbedtls_gcm_context gcm;
+
+            mbedtls_gcm_init(&gcm);
+            ret = mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, key, bits);
+            if (ret == 0) {
+                snprintf(name, sizeof(name), "aes-%u-gcm", bits);
+                ret = throughput("aes", name, aes_gcm, &gcm);
+            }
+            mbedtls_gcm_free(&gcm);
+        }
+#endif
+#if defined(MBEDTLS_CCM_C)
+        if (ret == 0) {
+            mbedtls_ccm_context ccm;
+
+            mbedtls_ccm_init(&ccm);
+            ret = mbedtls_ccm_setkey(&ccm, MBEDTLS_CIPHER_ID_AES, key, bits);
+            if (ret == 0) {
+                snprintf(name, sizeof(name), "aes-%u-ccm", bits);
+                ret = throughput("aes", name, aes_ccm, &ccm);
+            }
+            mbedtls_ccm_free(&ccm);
+        }
+#endif
+    }
+
+    return ret;
+#else
+    return 0;
+#endif /* MBEDTLS_AES_C */
+}
+
+/*
+ * TLS records, through the cipher layer as ssl_tls.c does: 12-byte nonce,
+ * 13 bytes of additional data and a 16-byte tag. Records are encrypted in
+ * place like TLS does, and 1 KB records also into a separate buffer, which
+ * lets GCM and CCM hand the whole record to mbedtls_aes_crypt_ecb_blocks().
+ */
+#if defined(MBEDTLS_AES_C) && (defined(MBEDTLS_GCM_C) || defined(MBEDTLS_CCM_C))
+#define RECORD_MAX_LEN          16384
+
+static unsigned char record[RECORD_MAX_LEN];
+static size_t record_len;
+static unsigned char *record_out;
+
+static int record_encrypt(void *ctx)
+{
+    static const unsigned char nonce[12] = { 0 };
+    static const unsigned char add[13] = { 0 };
+    unsigned char tag[16];
+    size_t olen;
+
+    return mbedtls_cipher_auth_encrypt((mbedtls_cipher_context_t *) ctx, nonce, sizeof(nonce),
+                                       add, sizeof(add), record, record_len,
+                                       record_out, &olen, tag, sizeof(tag));
+}
+
+static int record_cipher(mbedtls_cipher_type_t type, const char *mode)
+{
+    static const unsigned char key[32] = { 0 };
+    static const size_t lengths[] = { 1024, RECORD_MAX_LEN };
+    const mbedtls_cipher_info_t *info = mbedtls_cipher_info_from_type(type);
+    mbedtls_cipher_context_t cipher;
+    char name[32];
+    int ret;
+
+    mbedtls_cipher_init(&cipher);
+    ret = mbedtls_cipher_setup(&cipher, info);
+    if (ret == 0) {
+        ret = mbedtls_cipher_setkey(&cipher, key, info->key_bitlen, MBEDTLS_ENCRYPT);
+    }
+
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]) && ret == 0; i++) {
+        record_len = lengths[i];
+        record_out = record;
+        snprintf(name, sizeof(name), "aes-%u-%s-%u", info->key_bitlen, mode,
+                 (unsigned) record_len);
+        ret = throughput_len("record", name, record_encrypt, &cipher, record_len);
+    }
+
+    if (ret == 0) {
+        record_len = BUFSIZE;
+        record_out = buf;
+        snprintf(name, sizeof(name), "aes-%u-%s-%u-out", info->key_bitlen, mode,
+                 (unsigned) record_len);
+        ret = throughput_len("record", name, record_encrypt, &cipher, record_len);
+    }
+
+    mbedtls_cipher_free(&cipher);
+    return ret;
+}
+#endif
+
+int bench_record(void)
+{
+    int ret = 0;
+
+#if defined(MBEDTLS_AES_C) && defined(MBEDTLS_GCM_C)
+    if (ret == 0) {
+        ret = record_cipher(MBEDTLS_CIPHER_AES_128_GCM, "gcm");
+    }
+    if (ret == 0) {
+        ret = record_cipher(MBEDTLS_CIPHER_AES_256_GCM, "gcm");
+    }
+#endif
+#if defined(MBEDTLS_AES_C) && defined(MBEDTLS_CCM_C)
+    if (ret == 0) {
+        ret = record_cipher(MBEDTLS_CIPHER_AES_128_CCM, "ccm");
+    }
+#endif
+
+    return ret;
+}
+
+/*
+ * Hashes, measured on the update step as with a long message
+ */
+#if defined(MBEDTLS_SHA1_C)
+static int sha1_update(void *ctx)
+{
+    mbedtls_sha1_update((mbedtls_sha1_context *) ctx, buf, BUFSIZE);
+    return 0;
+}
+#endif
+
+#if defined(MBEDTLS_SHA256_C)
+static int sha256_update(void *ctx)
+{
+    mbedtls_sha256_update((mbedtls_sha256_context *) ctx, buf, BUFSIZE);
+    return 0;
+}
+#endif
+
+#if defined(MBEDTLS_SHA512_C)
+static int sha512_update(void *ctx)
+{
+    mbedtls_sha512_update((mbedtls_sha512_context *) ctx, buf, BUFSIZE);
+    return 0;
+}
+#endif
+
+int bench_hash(void)
+{
+    int ret = 0;
+
+#if defined(MBEDTLS_SHA1_C)
+    if (ret == 0) {
+        mbedtls_sha1_context sha1;
+
+        mbedtls_sha1_init(&sha1);
+        mbedtls_sha1_starts(&sha1);
+        ret = throughput("hash", "sha1", sha1_update, &sha1);
+        mbedtls_sha1_free(&sha1);
+    }
+#endif
+#if defined(MBEDTLS_SHA256_C)
+    if (ret == 0) {
+        mbedtls_sha256_context sha256;
+
+        mbedtls_sha256_init(&sha256);
+        mbedtls_sha256_starts(&sha256, 0);
+        ret = throughput("hash", "sha256", sha256_update, &sha256);
+        mbedtls_sha256_free(&sha256);
+    }
+#endif
+#if defined(MBEDTLS_SHA512_C)
+    if (ret == 0) {
+        mbedtls_sha512_context sha512;
+
+        mbedtls_sha512_init(&sha512);
+        mbedtls_sha512_starts(&sha512, 0);
+        ret = throughput("hash", "sha512", sha512_update, &sha512);
+        mbedtls_sha512_free(&sha512);
+    }
+#endif
+
+    return ret;
+}
+
+/*
+ * DRBGs
+ */
+#if defined(MBEDTLS_CTR_DRBG_C)
+static int ctr_drbg_output(void *ctx)
+{
+    return mbedtls_ctr_drbg_random(ctx, buf, BUFSIZE);
+}
+#endif
+
+#if defined(MBEDTLS_HMAC_DRBG_C)
+static int hmac_drbg_output(void *ctx)
+{
+    return mbedtls_hmac_drbg_random(ctx, buf, BUFSIZE);
+}
+#endif
+
+int bench_drbg(void)
+{
+    int ret = 0;
+
+#if defined(MBEDTLS_CTR_DRBG_C)
+    if (ret == 0) {
+        mbedtls_ctr_drbg_context ctr;
+
+        mbedtls_ctr_drbg_init(&ctr);
+        ret = mbedtls_ctr_drbg_seed(&ctr, bench_entropy, NULL, NULL, 0);
+        if (ret == 0) {
+            ret = throughput("drbg", "ctr_drbg", ctr_drbg_output, &ctr);
+        }
+        mbedtls_ctr_drbg_free(&ctr);
+    }
+#endif
+#if defined(MBEDTLS_HMAC_DRBG_C) && defined(MBEDTLS_SHA256_C)
+    if (ret == 0) {
+        mbedtls_hmac_drbg_context hmac;
+
+        mbedtls_hmac_drbg_init(&hmac);
+        ret = mbedtls_hmac_drbg_seed(&hmac, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
+                                     bench_entropy, NULL, NULL, 0);
+        if (ret == 0) {
+            ret = throughput("drbg", "hmac_drbg-sha256", hmac_drbg_output, &hmac);
+        }
+        mbedtls_hmac_drbg_free(&hmac);
+    }
+#endif
+
+    return ret;
+}
+
+/*
+ * Public key operations, all on a SHA-256 sized hash
+ */
+#if defined(MBEDTLS_CTR_DRBG_C)
+static const unsigned char hash[32] = { 0x2a };
+static unsigned char sig[MBEDTLS_MPI_MAX_SIZE];
+static size_t sig_len;
+#endif
+
+#if defined(MBEDTLS_PK_PARSE_C) && defined(MBEDTLS_RSA_C) && \
+    defined(MBEDTLS_CERTS_C) && defined(MBEDTLS_PEM_PARSE_C) && \
+    defined(MBEDTLS_CTR_DRBG_C)
+#define BENCH_RSA
+
+static int pk_sign(void *ctx)
+{
+    return mbedtls_pk_sign((mbedtls_pk_context *) ctx, MBEDTLS_MD_SHA256,
+                           hash, sizeof(hash), sig, &sig_len,
+                           mbedtls_ctr_drbg_random, &drbg);
+}
+
+static int pk_verify(void *ctx)
+{
+    return mbedtls_pk_verify((mbedtls_pk_context *) ctx, MBEDTLS_MD_SHA256,
+                             hash, sizeof(hash), sig, sig_len);
+}
+#endif
+
+int bench_rsa(void)
+{
+#if defined(BENCH_RSA)
+    mbedtls_pk_context pk;
+    char name[24];
+    int ret;
+
+    mbedtls_pk_init(&pk);
+    ret = drbg_setup();
+    if (ret == 0) {
+        ret = mbedtls_pk_parse_key(&pk, (const unsigned char *) mbedtls_test_srv_key_rsa,
+                                   mbedtls_test_srv_key_rsa_len, NULL, 0);
+    }
+    if (ret == 0) {
+        snprintf(name, sizeof(name), "rsa-%u-private", (unsigned) mbedtls_pk_get_bitlen(&pk));
+        ret = operations("rsa", name, pk_sign, &pk);
+    }
+    if (ret == 0) {
+        snprintf(name, sizeof(name), "rsa-%u-public", (unsigned) mbedtls_pk_get_bitlen(&pk));
+        ret = operations("rsa", name, pk_verify, &pk);
+    }
+
+    mbedtls_pk_free(&pk);
+    mbedtls_ctr_drbg_free(&drbg);
+    return ret;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * ECC, on every curve in the configuration
+ */
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_CTR_DRBG_C)
+static int ecdsa_sign(void *ctx)
+{
+    return mbedtls_ecdsa_write_signature((mbedtls_ecdsa_context *) ctx, MBEDTLS_MD_SHA256,
+                                         hash, sizeof(hash), sig, &sig_len,
+                                         mbedtls_ctr_drbg_random, &drbg);
+}
+
+static int ecdsa_verify(void *ctx)
+{
+    return mbedtls_ecdsa_read_signature((mbedtls_ecdsa_context *) ctx,
+                                        hash, sizeof(hash), sig, sig_len);
+}
+#endif
+
+#if defined(MBEDTLS_ECDH_C) && defined(MBEDTLS_CTR_DRBG_C)
+/* One ephemeral key exchange as done by a TLS endpoint: new key, then the
+ * shared secret with the peer's public key (which ctx->Qp holds) */
+static int ecdh_exchange(void *ctx)
+{
+    mbedtls_ecdh_context *ecdh = (mbedtls_ecdh_context *) ctx;
+    int ret;
+
+    ret = mbedtls_ecdh_gen_public(&ecdh->grp, &ecdh->d, &ecdh->Q,
+                                  mbedtls_ctr_drbg_random, &drbg);
+    if (ret == 0) {
+        ret = mbedtls_ecdh_compute_shared(&ecdh->grp, &ecdh->z, &ecdh->Qp, &ecdh->d,
+                                          mbedtls_ctr_drbg_random, &drbg);
+    }
+    return ret;
+}
+#endif
+
+int bench_ecc(void)
+{
+#if defined(MBEDTLS_ECP_C) && defined(MBEDTLS_CTR_DRBG_C)
+    const mbedtls_ecp_curve_info *curve;
+    char name[40];
+    int ret;
+
+    ret = drbg_setup();
+
+    for (curve = mbedtls_ecp_curve_list();
+         ret == 0 && curve->grp_id != MBEDTLS_ECP_DP_NONE; curve++) {
+#if defined(MBEDTLS_ECDSA_C)
+        /* ECDSA is only defined for short Weierstrass curves */
+        if (curve->grp_id != MBEDTLS_ECP_DP_CURVE25519) {
+            mbedtls_ecdsa_context ecdsa;
+
+            mbedtls_ecdsa_init(&ecdsa);
+            ret = mbedtls_ecdsa_genkey(&ecdsa, curve->grp_id,
+                                       mbedtls_ctr_drbg_random, &drbg);
+            if (ret == 0) {
+                snprintf(name, sizeof(name), "ecdsa-sign-%s", curve->name);
+                ret = operations("ecc", name, ecdsa_sign, &ecdsa);
+            }
+            if (ret == 0) {
+                snprintf(name, sizeof(name), "ecdsa-verify-%s", curve->name);
+                ret = operations("ecc", name, ecdsa_verify, &ecdsa);
+            }
+            mbedtls_ecdsa_free(&ecdsa);
+        }
+#endif
+#if defined(MBEDTLS_ECDH_C)
+        if (ret == 0) {
+            mbedtls_ecdh_context ecdh;
+            mbedtls_mpi peer_d;
+
+            mbedtls_ecdh_init(&ecdh);
+            mbedtls_mpi_init(&peer_d);
+            ret = mbedtls_ecp_group_load(&ecdh.grp, curve->grp_id);
+            if (ret == 0) {
+                ret = mbedtls_ecdh_gen_public(&ecdh.grp, &peer_d, &ecdh.Qp,
+                                              mbedtls_ctr_drbg_random, &drbg);
+            }
+            if (ret == 0) {
+                snprintf(name, sizeof(name), "ecdh-%s", curve->name);
+                ret = operations("ecc", name, ecdh_exchange, &ecdh);
+            }
+            mbedtls_mpi_free(&peer_d);
+            mbedtls_ecdh_free(&ecdh);
+        }
+#endif
+    }
+
+    mbedtls_ctr_drbg_free(&drbg);
+    return ret;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Full handshakes, client and server in the same thread over memory pipes
+ */
+#if defined(MBEDTLS_SSL_CLI_C) && defined(MBEDTLS_SSL_SRV_C) && \
+    defined(MBEDTLS_CERTS_C) && defined(MBEDTLS_PEM_PARSE_C) && \
+    defined(MBEDTLS_X509_CRT_PARSE_C) && defined(MBEDTLS_CTR_DRBG_C) && \
+    defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C) && defined(MBEDTLS_SHA256_C)
+#define BENCH_HANDSHAKE
+
+#define PIPE_SIZE       4096
+#define MAX_STEPS       1000
+
+/* One direction of the in-memory connection */
+typedef struct {
+    unsigned char data[PIPE_SIZE];
+    size_t len;
+} pipe_t;
+
+typedef struct {
+    pipe_t *rx;
+    pipe_t *tx;
+} endpoint_t;
+
+static pipe_t to_server;
+static pipe_t to_client;
+
+static int pipe_send(void *ctx, const unsigned char *data, size_t len)
+{
+    pipe_t *p = ((endpoint_t *) ctx)->tx;
+    size_t n = PIPE_SIZE - p->len;
+
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(p->data + p->len, data, n);
+    p->len += n;
+    return (int) n;
+}
+
+static int pipe_recv(void *ctx, unsigned char *data, size_t len)
+{
+    pipe_t *p = ((endpoint_t *) ctx)->rx;
+    size_t n = p->len;
+
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(data, p->data, n);
+    memmove(p->data, p->data + n, p->len - n);
+    p->len -= n;
+    return (int) n;
+}
+
+static int can_continue(int ret)
+{
+    return ret == 0 || ret == MBEDTLS_ERR_SSL_WANT_READ ||
+           ret == MBEDTLS_ERR_SSL_WANT_WRITE;
+}
+
+/* The default profile, plus SHA-1 which signs the RSA test certificates */
+static const mbedtls_x509_crt_profile cert_profile = {
+    MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_SHA1) |
+    MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_SHA224) |
+    MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_SHA256) |
+    MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_SHA384) |
+    MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_SHA512),
+    0xFFFFFFF, /* any PK alg */
+    0xFFFFFFF, /* any curve */
+    2048,
+};
+
+typedef struct {
+    mbedtls_ssl_config cli_conf;
+    mbedtls_ssl_config srv_conf;
+} handshake_t;
+
+/* Set up a new pair of connections and complete the handshake */
+static int handshake(void *ctx)
+{
+    handshake_t *hs = (handshake_t *) ctx;
+    mbedtls_ssl_context cli, srv;
+    endpoint_t cli_end = { &to_client, &to_server };
+    endpoint_t srv_end = { &to_server, &to_client };
+    int ret, steps = 0;
+
+    to_server.len = 0;
+    to_client.len = 0;
+    mbedtls_ssl_init(&cli);
+    mbedtls_ssl_init(&srv);
+
+    ret = mbedtls_ssl_setup(&cli, &hs->cli_conf);
+    if (ret == 0) {
+        ret = mbedtls_ssl_setup(&srv, &hs->srv_conf);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_set_hostname(&cli, "localhost");
+    }
+    mbedtls_ssl_set_bio(&cli, &cli_end, pipe_send, pipe_recv, NULL);
+    mbedtls_ssl_set_bio(&srv, &srv_end, pipe_send, pipe_recv, NULL);
+
+    while (ret == 0 && (cli.state != MBEDTLS_SSL_HANDSHAKE_OVER ||
+                        srv.state != MBEDTLS_SSL_HANDSHAKE_OVER)) {
+        if (cli.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            ret = mbedtls_ssl_handshake_step(&cli);
+            ret = can_continue(ret) ? 0 : ret;
+        }
+        if (ret == 0 && srv.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            ret = mbedtls_ssl_handshake_step(&srv);
+            ret = can_continue(ret) ? 0 : ret;
+        }
+        if (++steps > MAX_STEPS) {
+            ret = MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+        }
+    }
+
+    mbedtls_ssl_free(&cli);
+    mbedtls_ssl_free(&srv);
+    return ret;
+}
+
+static int handshake_suite(const char *name, int ciphersuite,
+                           const char *crt, size_t crt_len,
+                           const char *key, size_t key_len)
+{
+    const int ciphersuites[] = { ciphersuite, 0 };
+    mbedtls_x509_crt cacert, srvcert;
+    mbedtls_pk_context srvkey;
+    handshake_t hs;
+    int ret;
+
+    mbedtls_x509_crt_init(&cacert);
+    mbedtls_x509_crt_init(&srvcert);
+    mbedtls_pk_init(&srvkey);
+    mbedtls_ssl_config_init(&hs.cli_conf);
+    mbedtls_ssl_config_init(&hs.srv_conf);
+
+    ret = mbedtls_x509_crt_parse(&cacert, (const unsigned char *) mbedtls_test_cas_pem,
+                                 mbedtls_test_cas_pem_len);
+    if (ret == 0) {
+        ret = mbedtls_x509_crt_parse(&srvcert, (const unsigned char *) crt, crt_len);
+    }
+    if (ret == 0) {
+        ret = mbedtls_pk_parse_key(&srvkey, (const unsigned char *) key, key_len, NULL, 0);
+    }
+
+    if (ret == 0) {
+        ret = mbedtls_ssl_config_defaults(&hs.cli_conf, MBEDTLS_SSL_IS_CLIENT,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) {
+        mbedtls_ssl_conf_rng(&hs.cli_conf, mbedtls_ctr_drbg_random, &drbg);
+        mbedtls_ssl_conf_ca_chain(&hs.cli_conf, &cacert, NULL);
+        mbedtls_ssl_conf_cert_profile(&hs.cli_conf, &cert_profile);
+        mbedtls_ssl_conf_authmode(&hs.cli_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+        mbedtls_ssl_conf_ciphersuites(&hs.cli_conf, ciphersuites);
+        ret = mbedtls_ssl_config_defaults(&hs.srv_conf, MBEDTLS_SSL_IS_SERVER,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) {
+        mbedtls_ssl_conf_rng(&hs.srv_conf, mbedtls_ctr_drbg_random, &drbg);
+        ret = mbedtls_ssl_conf_own_cert(&hs.srv_conf, &srvcert, &srvkey);
+    }
+
+    if (ret == 0) {
+        const uint64_t budget = (uint64_t) bench_cycles_hz() * BENCH_OPS_MS / 1000;
+        uint64_t start = bench_cycles(), elapsed;
+        uint64_t count = 0;
+
+        do {
+            ret = handshake(&hs);
+            count++;
+            elapsed = bench_cycles() - start;
+        } while (ret == 0 && (elapsed < budget || count < BENCH_MIN_OPS));
+
+        if (ret == 0) {
+            report("handshake", name,
+                   elapsed * 1000 * 100 / bench_cycles_hz() / count, "ms");
+        }
+    }
+
+    mbedtls_ssl_config_free(&hs.cli_conf);
+    mbedtls_ssl_config_free(&hs.srv_conf);
+    mbedtls_pk_free(&srvkey);
+    mbedtls_x509_crt_free(&srvcert);
+    mbedtls_x509_crt_free(&cacert);
+    return ret;
+}
+#endif /* BENCH_HANDSHAKE */
+
+int bench_handshake(void)
+{
+#if defined(BENCH_HANDSHAKE)
+    int ret;
+
+    ret = drbg_setup();
+
+#if defined(MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED) && \
+    defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+    if (ret == 0) {
+        ret = handshake_suite("ecdhe-ecdsa-aes128-gcm-sha256",
+                              MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,
+                              mbedtls_test_srv_crt_ec, mbedtls_test_srv_crt_ec_len,
+                              mbedtls_test_srv_key_ec, mbedtls_test_srv_key_ec_len);
+    }
+#endif
+#if defined(MBEDTLS_KEY_EXCHANGE_ECDHE_RSA_ENABLED) && defined(MBEDTLS_RSA_C) && \
+    defined(MBEDTLS_SHA1_C)
+    if (ret == 0) {
+        ret = handshake_suite("ecdhe-rsa-aes128-gcm-sha256",
+                              MBEDTLS_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256,
+                              mbedtls_test_srv_crt_rsa, mbedtls_test_srv_crt_rsa_len,
+                              mbedtls_test_srv_key_rsa, mbedtls_test_srv_key_rsa_len);
+    }
+#endif
+
+    mbedtls_ctr_drbg_free(&drbg);
+    return ret;
+#else
+    return 0;
+#endif
+}
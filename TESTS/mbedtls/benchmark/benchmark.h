@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBEDTLS_BENCHMARK_H
+#define MBEDTLS_BENCHMARK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Platform hooks, provided by main.cpp on mbed and by linux_main.c natively.
+ */
+
+/** Free-running cycle counter; must not wrap during a benchmark run */
+uint64_t bench_cycles(void);
+
+/** Frequency of bench_cycles(), in Hz */
+uint32_t bench_cycles_hz(void);
+
+/*
+ * Benchmarks. Each prints one line per measurement, in the form
+ *
+ *     bench,<group>,<name>,<value>,<unit>
+ *
+ * and returns 0, or the mbed TLS error code of the operation that failed.
+ * Algorithms that are not enabled in the configuration are skipped.
+ */
+
+/** Print the header line and the clock used for the measurements */
+void bench_header(void);
+
+/** Cycles per byte for AES-ECB/CBC/CTR/GCM/CCM */
+int bench_aes(void);
+
+/** Cycles per byte for AES-GCM/CCM records of 1 KB and 16 KB */
+int bench_record(void);
+
+/** Cycles per byte for SHA-1/256/512 */
+int bench_hash(void);
+
+/** Cycles per byte for CTR_DRBG and HMAC_DRBG output */
+int bench_drbg(void);
+
+/** Operations per second for RSA private and public key operations */
+int bench_rsa(void);
+
+/** Operations per second for ECDSA sign/verify and ECDH on every curve */
+int bench_ecc(void);
+
+/** Time of a full handshake, client and server over an in-memory BIO */
+int bench_handshake(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_BENCHMARK_H */
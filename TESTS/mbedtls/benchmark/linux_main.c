@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Native build of the mbed TLS benchmarks, for comparison with a host or to
+ * check the effect of a configuration change quickly. From the root of the
+ * tree:
+ *
+ *   gcc -O2 -DDEVICE_TRNG -Ifeatures/mbedtls/inc -Ifeatures/mbedtls \
+ *       TESTS/mbedtls/benchmark/benchmark.c TESTS/mbedtls/benchmark/linux_main.c \
+ *       features/mbedtls/src/[a-z]*.c -o bench
+ *
+ * Cycles are nanoseconds of CLOCK_MONOTONIC unless BENCH_CYCLES_HZ is set to
+ * the CPU frequency. The output has the same format as on target.
+ */
+
+#if !defined(__MBED__)
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "benchmark.h"
+
+#if !defined(BENCH_CYCLES_HZ)
+#define BENCH_CYCLES_HZ     1000000000
+#endif
+
+uint64_t bench_cycles(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec) *
+           (BENCH_CYCLES_HZ / 1000000) / 1000;
+}
+
+uint32_t bench_cycles_hz(void)
+{
+    return BENCH_CYCLES_HZ;
+}
+
+/* Entropy source for the mbed configuration (MBEDTLS_ENTROPY_HARDWARE_ALT) */
+int mbedtls_hardware_poll(void *data, unsigned char *output, size_t len, size_t *olen)
+{
+    FILE *f = fopen("/dev/urandom", "rb");
+    size_t n = 0;
+
+    (void) data;
+    if (f != NULL) {
+        n = fread(output, 1, len, f);
+        fclose(f);
+    }
+    *olen = n;
+    return n == len ? 0 : -1;
+}
+
+int main(void)
+{
+    int (*const groups[])(void) = {
+        bench_aes, bench_record, bench_hash, bench_drbg, bench_rsa, bench_ecc, bench_handshake
+    };
+    int ret = 0;
+
+    bench_header();
+    for (size_t i = 0; i < sizeof(groups) / sizeof(groups[0]) && ret == 0; i++) {
+        ret = groups[i]();
+    }
+
+    if (ret != 0) {
+        fprintf(stderr, "benchmark failed: -0x%04x\n", (unsigned) -ret);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+#endif /* !__MBED__ */
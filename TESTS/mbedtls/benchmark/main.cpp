@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * mbed TLS benchmarks.
+ *
+ * Runs the benchmarks of benchmark.c, one test case per group, and prints
+ * the results as "bench,<group>,<name>,<value>,<unit>" lines. Cycles come
+ * from the DWT cycle counter where the core has one, otherwise from the
+ * microsecond ticker scaled by SystemCoreClock.
+ */
+
+#include <stdio.h>
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "hal/us_ticker_api.h"
+
+#include "benchmark.h"
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if !defined(MBEDTLS_CTR_DRBG_C)
+  #error [NOT_SUPPORTED] CTR_DRBG not enabled
+#endif
+
+using namespace utest::v1;
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CoreDebug_DEMCR_TRCENA_Msk)
+#define HAVE_DWT
+#endif
+
+static bool use_dwt;
+static uint32_t dwt_last;
+static uint64_t dwt_high;
+
+static void clock_init()
+{
+#if defined(HAVE_DWT)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(DWT_CTRL_NOCYCCNT_Msk)
+    if (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) {
+        return;
+    }
+#endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* Some cores implement the register without a counter behind it */
+    uint32_t start = DWT->CYCCNT;
+    __NOP();
+    __NOP();
+    use_dwt = DWT->CYCCNT != start;
+#endif
+}
+
+/* The 32-bit DWT counter is extended in software, which only needs this to
+ * be called at least once per wrap (over 20 s at 200 MHz) */
+uint64_t bench_cycles(void)
+{
+#if defined(HAVE_DWT)
+    if (use_dwt) {
+        uint32_t now = DWT->CYCCNT;
+        if (now < dwt_last) {
+            dwt_high += (uint64_t) 1 << 32;
+        }
+        dwt_last = now;
+        return dwt_high | now;
+    }
+#endif
+    return ticker_read_us(get_us_ticker_data()) * SystemCoreClock / 1000000;
+}
+
+uint32_t bench_cycles_hz(void)
+{
+    return SystemCoreClock;
+}
+
+#define BENCH_CASE(group)                       \
+    void test_ ## group()                       \
+    {                                           \
+        TEST_ASSERT_EQUAL(0, bench_ ## group()); \
+    }
+
+BENCH_CASE(aes)
+BENCH_CASE(record)
+BENCH_CASE(hash)
+BENCH_CASE(drbg)
+BENCH_CASE(rsa)
+BENCH_CASE(ecc)
+BENCH_CASE(handshake)
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("mbedtls benchmark aes", test_aes, greentea_failure_handler),
+    Case("mbedtls benchmark record", test_record, greentea_failure_handler),
+    Case("mbedtls benchmark hash", test_hash, greentea_failure_handler),
+    Case("mbedtls benchmark drbg", test_drbg, greentea_failure_handler),
+    Case("mbedtls benchmark rsa", test_rsa, greentea_failure_handler),
+    Case("mbedtls benchmark ecc", test_ecc, greentea_failure_handler),
+    Case("mbedtls benchmark handshake", test_handshake, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(600, "default_auto");
+    clock_init();
+    printf("# cycle counter: %s\r\n", use_dwt ? "DWT" : "us ticker");
+    bench_header();
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main() {
+    Harness::run(specification);
+}
@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Shared DRBG service.
+ *
+ * Checks mbed_drbg_random() from several threads at once, then compares it
+ * with a CTR_DRBG context of the caller's own: bytes per second for a burst
+ * of requests of each size, the time a request takes when the refill thread
+ * had time to run before it, and the time of a TLS handshake (client and
+ * server in the same thread over in-memory pipes) including seeding a DRBG
+ * for the connection, as TLSSocket used to, against one on the service.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed_drbg.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/ssl_internal.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/certs.h"
+
+#if !defined(MBED_DRBG_PRESENT)
+  #error [NOT_SUPPORTED] MBEDTLS_CTR_DRBG_C or MBEDTLS_ENTROPY_C not enabled
+#endif
+
+#if !defined(MBEDTLS_SSL_CLI_C) || !defined(MBEDTLS_SSL_SRV_C) || \
+    !defined(MBEDTLS_CERTS_C) || \
+    !defined(MBEDTLS_X509_CRT_PARSE_C) || !defined(MBEDTLS_PEM_PARSE_C) || \
+    !defined(MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED) || \
+    !defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+  #error [NOT_SUPPORTED] mbed TLS client, server, ECDHE-ECDSA or test certificates not enabled
+#endif
+
+using namespace utest::v1;
+
+#define THREAD_COUNT        3
+#define THREAD_STACK_SIZE   1024
+#define THREAD_REQUESTS     200
+#define THREAD_MAX_LEN      96
+
+#define BURST_BYTES         (16 * 1024)
+#define IDLE_REQUESTS       32
+#define IDLE_WAIT_MS        5
+#define IDLE_LEN            32
+
+#if !defined(HANDSHAKE_ROUNDS)
+#define HANDSHAKE_ROUNDS    3
+#endif
+
+#define PIPE_SIZE           4096
+#define MAX_STEPS           1000
+
+static const size_t request_sizes[] = { 16, 32, 64, 256, 2048 };
+
+/* Each thread checks that no block of its output repeats one of another */
+static unsigned char first_blocks[THREAD_COUNT][THREAD_REQUESTS][16];
+static int thread_result[THREAD_COUNT];
+
+static void request_thread(int *index)
+{
+    unsigned char buf[THREAD_MAX_LEN];
+    int id = index - thread_result;
+
+    for (int i = 0; i < THREAD_REQUESTS; i++) {
+        size_t len = 16 + (i * 13) % (THREAD_MAX_LEN - 16);
+        memset(buf, 0, sizeof(buf));
+        int ret = mbed_drbg_random(NULL, buf, len);
+        if (ret != 0) {
+            *index = ret;
+            return;
+        }
+        memcpy(first_blocks[id][i], buf, 16);
+    }
+    *index = 0;
+}
+
+void test_concurrent()
+{
+    mbed_drbg_stats_t before, after;
+    Thread *threads[THREAD_COUNT];
+
+    TEST_ASSERT_EQUAL(0, mbed_drbg_init());
+    mbed_drbg_get_stats(&before);
+
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        thread_result[t] = -1;
+        threads[t] = new Thread(osPriorityNormal, THREAD_STACK_SIZE);
+        threads[t]->start(callback(request_thread, &thread_result[t]));
+    }
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads[t]->join();
+        delete threads[t];
+        TEST_ASSERT_EQUAL(0, thread_result[t]);
+    }
+
+    mbed_drbg_get_stats(&after);
+    TEST_ASSERT_EQUAL(THREAD_COUNT * THREAD_REQUESTS, after.requests - before.requests);
+
+    size_t expected = 0;
+    for (int i = 0; i < THREAD_REQUESTS; i++) {
+        expected += 16 + (i * 13) % (THREAD_MAX_LEN - 16);
+    }
+    TEST_ASSERT_EQUAL(THREAD_COUNT * expected, (size_t) (after.bytes - before.bytes));
+
+    /* Any repeat means two callers were handed the same pool bytes */
+    const unsigned char *blocks = &first_blocks[0][0][0];
+    const size_t count = THREAD_COUNT * THREAD_REQUESTS;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = i + 1; j < count; j++) {
+            TEST_ASSERT_TRUE(memcmp(blocks + 16 * i, blocks + 16 * j, 16) != 0);
+        }
+    }
+
+    printf("requests %lu bytes %lu refills %lu inline %lu reseeds %lu\r\n",
+           (unsigned long) (after.requests - before.requests),
+           (unsigned long) (after.bytes - before.bytes),
+           (unsigned long) (after.refills - before.refills),
+           (unsigned long) (after.inline_refills - before.inline_refills),
+           (unsigned long) (after.reseeds - before.reseeds));
+}
+
+void test_reseed()
+{
+    unsigned char a[32], b[32];
+    mbed_drbg_stats_t before, after;
+
+    mbed_drbg_get_stats(&before);
+    TEST_ASSERT_EQUAL(0, mbed_drbg_random(NULL, a, sizeof(a)));
+    TEST_ASSERT_EQUAL(0, mbed_drbg_reseed());
+    TEST_ASSERT_EQUAL(0, mbed_drbg_random(NULL, b, sizeof(b)));
+    mbed_drbg_get_stats(&after);
+
+    TEST_ASSERT_TRUE(memcmp(a, b, sizeof(a)) != 0);
+    TEST_ASSERT_TRUE(after.reseeds > before.reseeds);
+}
+
+static int own_random(void *p_rng, unsigned char *output, size_t len)
+{
+    /* Split as mbedtls_ctr_drbg_random would refuse more */
+    for (size_t n, done = 0; done < len; done += n) {
+        n = len - done;
+        if (n > MBEDTLS_CTR_DRBG_MAX_REQUEST) {
+            n = MBEDTLS_CTR_DRBG_MAX_REQUEST;
+        }
+        int ret = mbedtls_ctr_drbg_random(p_rng, output + done, n);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    return 0;
+}
+
+/* Bytes per second for BURST_BYTES in requests of len */
+static unsigned long burst_rate(mbedtls_ctr_drbg_context *drbg, size_t len)
+{
+    static unsigned char buf[2048];
+    Timer timer;
+
+    timer.start();
+    for (size_t done = 0; done < BURST_BYTES; done += len) {
+        int ret = drbg ? own_random(drbg, buf, len) : mbed_drbg_random(NULL, buf, len);
+        TEST_ASSERT_EQUAL(0, ret);
+    }
+    timer.stop();
+
+    int us = timer.read_us();
+    return (unsigned long) ((uint64_t) BURST_BYTES * 1000000 / (us > 0 ? us : 1));
+}
+
+/* Microseconds spent in IDLE_REQUESTS requests made IDLE_WAIT_MS apart */
+static int idle_time(mbedtls_ctr_drbg_context *drbg)
+{
+    unsigned char buf[IDLE_LEN];
+    Timer timer;
+
+    for (int i = 0; i < IDLE_REQUESTS; i++) {
+        wait_ms(IDLE_WAIT_MS);
+        timer.start();
+        int ret = drbg ? own_random(drbg, buf, sizeof(buf)) : mbed_drbg_random(NULL, buf, sizeof(buf));
+        timer.stop();
+        TEST_ASSERT_EQUAL(0, ret);
+    }
+    return timer.read_us();
+}
+
+void test_throughput()
+{
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context drbg;
+
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&drbg);
+    TEST_ASSERT_EQUAL(0, mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy, NULL, 0));
+    TEST_ASSERT_EQUAL(0, mbed_drbg_init());
+
+    for (size_t i = 0; i < sizeof(request_sizes) / sizeof(request_sizes[0]); i++) {
+        size_t len = request_sizes[i];
+        unsigned long own = burst_rate(&drbg, len);
+        unsigned long shared = burst_rate(NULL, len);
+        printf("%4lu byte requests: own %7lu B/s  shared %7lu B/s\r\n",
+               (unsigned long) len, own, shared);
+    }
+
+    int own = idle_time(&drbg);
+    int shared = idle_time(NULL);
+    printf("%d %d byte requests after %d ms idle: own %d us  shared %d us\r\n",
+           IDLE_REQUESTS, IDLE_LEN, IDLE_WAIT_MS, own, shared);
+
+    mbedtls_ctr_drbg_free(&drbg);
+    mbedtls_entropy_free(&entropy);
+}
+
+struct pipe_t {
+    unsigned char data[PIPE_SIZE];
+    size_t len;
+};
+
+struct endpoint_t {
+    pipe_t *rx;
+    pipe_t *tx;
+};
+
+static pipe_t to_server;
+static pipe_t to_client;
+
+static int pipe_send(void *ctx, const unsigned char *data, size_t len)
+{
+    pipe_t *p = ((endpoint_t *) ctx)->tx;
+    size_t n = PIPE_SIZE - p->len;
+
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(p->data + p->len, data, n);
+    p->len += n;
+    return (int) n;
+}
+
+static int pipe_recv(void *ctx, unsigned char *data, size_t len)
+{
+    pipe_t *p = ((endpoint_t *) ctx)->rx;
+    size_t n = p->len;
+
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(data, p->data, n);
+    memmove(p->data, p->data + n, p->len - n);
+    p->len -= n;
+    return (int) n;
+}
+
+static int can_continue(int ret)
+{
+    return ret == 0 || ret == MBEDTLS_ERR_SSL_WANT_READ ||
+           ret == MBEDTLS_ERR_SSL_WANT_WRITE;
+}
+
+/* One full handshake. With shared false, the connection seeds a DRBG of
+ * its own from the entropy sources first, as TLSSocket did. */
+static int run_handshake(bool shared)
+{
+    const int ciphersuites[] = { MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256, 0 };
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context drbg;
+    mbedtls_x509_crt cacert, srvcert;
+    mbedtls_pk_context srvkey;
+    mbedtls_ssl_config cli_conf, srv_conf;
+    mbedtls_ssl_context cli, srv;
+    endpoint_t cli_end = { &to_client, &to_server };
+    endpoint_t srv_end = { &to_server, &to_client };
+    int (*f_rng)(void *, unsigned char *, size_t);
+    void *p_rng;
+    int ret = 0, steps = 0;
+
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&drbg);
+    mbedtls_x509_crt_init(&cacert);
+    mbedtls_x509_crt_init(&srvcert);
+    mbedtls_pk_init(&srvkey);
+    mbedtls_ssl_config_init(&cli_conf);
+    mbedtls_ssl_config_init(&srv_conf);
+    mbedtls_ssl_init(&cli);
+    mbedtls_ssl_init(&srv);
+    to_server.len = 0;
+    to_client.len = 0;
+
+    if (shared) {
+        f_rng = mbed_drbg_random;
+        p_rng = NULL;
+    } else {
+        static const char pers[] = "handshake";
+        f_rng = mbedtls_ctr_drbg_random;
+        p_rng = &drbg;
+        ret = mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy,
+                                    (const unsigned char *) pers, sizeof(pers) - 1);
+    }
+    if (ret == 0) {
+        ret = mbedtls_x509_crt_parse(&cacert, (const unsigned char *) mbedtls_test_cas_pem,
+                                     mbedtls_test_cas_pem_len);
+    }
+    if (ret == 0) {
+        ret = mbedtls_x509_crt_parse(&srvcert, (const unsigned char *) mbedtls_test_srv_crt_ec,
+                                     mbedtls_test_srv_crt_ec_len);
+    }
+    if (ret == 0) {
+        ret = mbedtls_pk_parse_key(&srvkey, (const unsigned char *) mbedtls_test_srv_key_ec,
+                                   mbedtls_test_srv_key_ec_len, NULL, 0);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_config_defaults(&cli_conf, MBEDTLS_SSL_IS_CLIENT,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) {
+        mbedtls_ssl_conf_rng(&cli_conf, f_rng, p_rng);
+        mbedtls_ssl_conf_ca_chain(&cli_conf, &cacert, NULL);
+        mbedtls_ssl_conf_authmode(&cli_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+        mbedtls_ssl_conf_ciphersuites(&cli_conf, ciphersuites);
+        ret = mbedtls_ssl_config_defaults(&srv_conf, MBEDTLS_SSL_IS_SERVER,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) {
+        mbedtls_ssl_conf_rng(&srv_conf, f_rng, p_rng);
+        ret = mbedtls_ssl_conf_own_cert(&srv_conf, &srvcert, &srvkey);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_setup(&cli, &cli_conf);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_setup(&srv, &srv_conf);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_set_hostname(&cli, "localhost");
+    }
+    mbedtls_ssl_set_bio(&cli, &cli_end, pipe_send, pipe_recv, NULL);
+    mbedtls_ssl_set_bio(&srv, &srv_end, pipe_send, pipe_recv, NULL);
+
+    while (ret == 0 && (cli.state != MBEDTLS_SSL_HANDSHAKE_OVER ||
+                        srv.state != MBEDTLS_SSL_HANDSHAKE_OVER)) {
+        if (cli.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            ret = mbedtls_ssl_handshake_step(&cli);
+            ret = can_continue(ret) ? 0 : ret;
+        }
+        if (ret == 0 && srv.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            ret = mbedtls_ssl_handshake_step(&srv);
+            ret = can_continue(ret) ? 0 : ret;
+        }
+        if (++steps > MAX_STEPS) {
+            ret = MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+        }
+    }
+
+    mbedtls_ssl_free(&cli);
+    mbedtls_ssl_free(&srv);
+    mbedtls_ssl_config_free(&cli_conf);
+    mbedtls_ssl_config_free(&srv_conf);
+    mbedtls_pk_free(&srvkey);
+    mbedtls_x509_crt_free(&srvcert);
+    mbedtls_x509_crt_free(&cacert);
+    mbedtls_ctr_drbg_free(&drbg);
+    mbedtls_entropy_free(&entropy);
+    return ret;
+}
+
+void test_handshake()
+{
+    Timer own, shared;
+
+    TEST_ASSERT_EQUAL(0, mbed_drbg_init());
+
+    for (int i = 0; i < HANDSHAKE_ROUNDS; i++) {
+        own.start();
+        TEST_ASSERT_EQUAL(0, run_handshake(false));
+        own.stop();
+
+        shared.start();
+        TEST_ASSERT_EQUAL(0, run_handshake(true));
+        shared.stop();
+    }
+
+    printf("handshake: own DRBG %d ms  shared %d ms\r\n",
+           own.read_ms() / HANDSHAKE_ROUNDS, shared.read_ms() / HANDSHAKE_ROUNDS);
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("mbed_drbg concurrent requests", test_concurrent, greentea_failure_handler),
+    Case("mbed_drbg explicit reseed", test_reseed, greentea_failure_handler),
+    Case("mbed_drbg throughput against own context", test_throughput, greentea_failure_handler),
+    Case("mbed_drbg handshake time", test_handshake, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(300, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main() {
+    Harness::run(specification);
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Fixed-base comb tables.
+ *
+ * Checks multiplications by the base point against a computation that does
+ * not use the base point table, then times key generation on a freshly
+ * loaded group (as done for every TLS handshake) and a multiplication on a
+ * group that already has its table, and prints the heap kept by the group.
+ * Build once with and once without MBEDTLS_ECP_FIXED_POINT_TABLES to compare.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "mbed_stats.h"
+
+#include "mbedtls/ecp.h"
+
+#if !defined(MBEDTLS_ECP_C) || !defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+  #error [NOT_SUPPORTED] ECP or secp256r1 not enabled
+#endif
+
+using namespace utest::v1;
+
+#define CHECK_ROUNDS    8
+#define TIMING_ROUNDS   10
+
+static uint32_t rng_state = 1;
+
+/* Simple generator, the test measures speed rather than security */
+static int test_rng(void *ctx, unsigned char *buf, size_t len)
+{
+    (void) ctx;
+    for (size_t i = 0; i < len; i++) {
+        rng_state = rng_state * 1103515245 + 12345;
+        buf[i] = (unsigned char) (rng_state >> 16);
+    }
+    return 0;
+}
+
+static uint32_t heap_now()
+{
+#if defined(MBED_HEAP_STATS_ENABLED)
+    mbed_stats_heap_t stats;
+    mbed_stats_heap_get(&stats);
+    return stats.current_size;
+#else
+    return 0;
+#endif
+}
+
+/* k * G must match (k / 2) * (2 * G), which does not use the table for G */
+static void check_base_mul(mbedtls_ecp_group_id id)
+{
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point R, R2, H;
+    mbedtls_mpi k, k2, two;
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&R);
+    mbedtls_ecp_point_init(&R2);
+    mbedtls_ecp_point_init(&H);
+    mbedtls_mpi_init(&k);
+    mbedtls_mpi_init(&k2);
+    mbedtls_mpi_init(&two);
+
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&grp, id));
+#if defined(MBEDTLS_ECP_FIXED_POINT_TABLES)
+    TEST_ASSERT_NOT_NULL(grp.T);
+    TEST_ASSERT_EQUAL(0, grp.T_size);
+#endif
+
+    TEST_ASSERT_EQUAL(0, mbedtls_mpi_lset(&two, 2));
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_mul(&grp, &H, &two, &grp.G, test_rng, NULL));
+
+    for (int i = 0; i < CHECK_ROUNDS; i++) {
+        if (i == 0) {
+            TEST_ASSERT_EQUAL(0, mbedtls_mpi_lset(&k, 1));
+        } else if (i == 1) {
+            TEST_ASSERT_EQUAL(0, mbedtls_mpi_sub_int(&k, &grp.N, 1));
+        } else {
+            TEST_ASSERT_EQUAL(0, mbedtls_ecp_gen_privkey(&grp, &k, test_rng, NULL));
+        }
+
+        TEST_ASSERT_EQUAL(0, mbedtls_ecp_mul(&grp, &R, &k, &grp.G, test_rng, NULL));
+
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_inv_mod(&k2, &two, &grp.N));
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_mul_mpi(&k2, &k2, &k));
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_mod_mpi(&k2, &k2, &grp.N));
+        TEST_ASSERT_EQUAL(0, mbedtls_ecp_mul(&grp, &R2, &k2, &H, test_rng, NULL));
+
+        TEST_ASSERT_EQUAL(0, mbedtls_ecp_point_cmp(&R, &R2));
+    }
+
+    mbedtls_mpi_free(&two);
+    mbedtls_mpi_free(&k2);
+    mbedtls_mpi_free(&k);
+    mbedtls_ecp_point_free(&H);
+    mbedtls_ecp_point_free(&R2);
+    mbedtls_ecp_point_free(&R);
+    mbedtls_ecp_group_free(&grp);
+}
+
+static void time_base_mul(mbedtls_ecp_group_id id, const char *name)
+{
+    Timer timer;
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point R;
+    mbedtls_mpi k;
+
+    mbedtls_ecp_point_init(&R);
+    mbedtls_mpi_init(&k);
+
+    /* Fresh group every time, the table (if any) is built by the keygen */
+    timer.start();
+    for (int i = 0; i < TIMING_ROUNDS; i++) {
+        mbedtls_ecp_keypair key;
+        mbedtls_ecp_keypair_init(&key);
+        TEST_ASSERT_EQUAL(0, mbedtls_ecp_gen_key(id, &key, test_rng, NULL));
+        mbedtls_ecp_keypair_free(&key);
+    }
+    timer.stop();
+    int fresh_us = timer.read_us() / TIMING_ROUNDS;
+
+    /* Same group, table already available */
+    mbedtls_ecp_group_init(&grp);
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&grp, id));
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_gen_privkey(&grp, &k, test_rng, NULL));
+    mbedtls_ecp_group_free(&grp);
+
+    /* Known curves use static constants, so whatever the group keeps on the
+     * heap after a multiplication by G is the comb table */
+    uint32_t heap_before = heap_now();
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&grp, id));
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_mul(&grp, &R, &k, &grp.G, test_rng, NULL));
+    mbedtls_ecp_point_free(&R);
+    uint32_t table_heap = heap_now() - heap_before;
+
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < TIMING_ROUNDS; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_ecp_mul(&grp, &R, &k, &grp.G, test_rng, NULL));
+    }
+    timer.stop();
+    int warm_us = timer.read_us() / TIMING_ROUNDS;
+
+#if defined(MBEDTLS_ECP_FIXED_POINT_TABLES)
+    const char *mode = "static";
+#else
+    const char *mode = "heap";
+#endif
+    printf("%s (%s table): keygen on new group %d us, "
+           "mul by G %d us, heap kept by group %lu\r\n", name, mode,
+           fresh_us, warm_us, (unsigned long) table_heap);
+
+#if defined(MBEDTLS_ECP_FIXED_POINT_TABLES) && defined(MBED_HEAP_STATS_ENABLED)
+    TEST_ASSERT_EQUAL(0, table_heap);
+#endif
+
+    mbedtls_mpi_free(&k);
+    mbedtls_ecp_point_free(&R);
+    mbedtls_ecp_group_free(&grp);
+}
+
+void test_secp256r1()
+{
+    check_base_mul(MBEDTLS_ECP_DP_SECP256R1);
+    time_base_mul(MBEDTLS_ECP_DP_SECP256R1, "secp256r1");
+}
+
+#if defined(MBEDTLS_ECP_DP_SECP384R1_ENABLED)
+void test_secp384r1()
+{
+    check_base_mul(MBEDTLS_ECP_DP_SECP384R1);
+    time_base_mul(MBEDTLS_ECP_DP_SECP384R1, "secp384r1");
+}
+#endif
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("mbedtls ecp comb secp256r1", test_secp256r1, greentea_failure_handler),
+#if defined(MBEDTLS_ECP_DP_SECP384R1_ENABLED)
+    Case("mbedtls ecp comb secp384r1", test_secp384r1, greentea_failure_handler),
+#endif
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main() {
+    Harness::run(specification);
+}
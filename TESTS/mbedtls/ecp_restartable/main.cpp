@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Restartable ECC.
+ *
+ * Runs ECDSA, ECDH and an ECDHE-ECDSA handshake (with client
+ * authentication, client and server in the same thread over in-memory
+ * pipes) with several operation budgets, checks the results match the
+ * blocking functions, and prints the longest time a single call blocked.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/ecdh.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/certs.h"
+
+#if !defined(MBEDTLS_ECP_RESTARTABLE)
+  #error [NOT_SUPPORTED] MBEDTLS_ECP_RESTARTABLE not enabled
+#endif
+
+#if !defined(MBEDTLS_ECDSA_C) || !defined(MBEDTLS_ECDH_C) || \
+    !defined(MBEDTLS_CTR_DRBG_C) || !defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+  #error [NOT_SUPPORTED] ECDSA, ECDH or secp256r1 not enabled
+#endif
+
+using namespace utest::v1;
+
+#define PIPE_SIZE       4096
+#define MAX_CALLS       20000
+
+/* Budgets to try; 0 disables restart and gives the blocking time */
+static const unsigned budgets[] = { 0, 5000, 1000, 300 };
+
+static mbedtls_ctr_drbg_context drbg;
+static Timer timer;
+static int max_us;
+static int calls;
+
+/* Deterministic seed, the test measures latency rather than security */
+static int test_entropy(void *ctx, unsigned char *buf, size_t len)
+{
+    (void) ctx;
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (unsigned char) i;
+    }
+    return 0;
+}
+
+static void timing_reset()
+{
+    max_us = 0;
+    calls = 0;
+}
+
+static void timing_start()
+{
+    timer.reset();
+    timer.start();
+}
+
+static void timing_stop()
+{
+    timer.stop();
+    int us = timer.read_us();
+    if (us > max_us) {
+        max_us = us;
+    }
+    calls++;
+    TEST_ASSERT_MESSAGE(calls < MAX_CALLS, "operation did not complete");
+}
+
+static void report(const char *what, unsigned budget)
+{
+    printf("%-28s max_ops %5u: %4d calls, longest call %6d us\r\n",
+           what, budget, calls, max_us);
+}
+
+void test_ecdsa()
+{
+    const unsigned char hash[32] = { 0x2a };
+    unsigned char sig[MBEDTLS_ECDSA_MAX_LEN];
+    unsigned char ref[MBEDTLS_ECDSA_MAX_LEN];
+    size_t sig_len, ref_len;
+    mbedtls_ecdsa_context key;
+    mbedtls_ecdsa_restart_ctx rs;
+    int ret;
+
+    mbedtls_ecdsa_init(&key);
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_genkey(&key, MBEDTLS_ECP_DP_SECP256R1,
+                      mbedtls_ctr_drbg_random, &drbg));
+
+    mbedtls_ecp_set_max_ops(0);
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_write_signature(&key, MBEDTLS_MD_SHA256,
+                      hash, sizeof(hash), ref, &ref_len, mbedtls_ctr_drbg_random, &drbg));
+
+    for (size_t i = 0; i < sizeof(budgets) / sizeof(budgets[0]); i++) {
+        mbedtls_ecp_set_max_ops(budgets[i]);
+        mbedtls_ecdsa_restart_init(&rs);
+
+        timing_reset();
+        do {
+            timing_start();
+            ret = mbedtls_ecdsa_write_signature_restartable(&key, MBEDTLS_MD_SHA256,
+                    hash, sizeof(hash), sig, &sig_len,
+                    mbedtls_ctr_drbg_random, &drbg, &rs);
+            timing_stop();
+        } while (ret == MBEDTLS_ERR_ECP_IN_PROGRESS);
+        TEST_ASSERT_EQUAL(0, ret);
+        report("ecdsa sign (secp256r1)", budgets[i]);
+
+#if defined(MBEDTLS_ECDSA_DETERMINISTIC)
+        /* Same key and hash give the same signature */
+        TEST_ASSERT_EQUAL(ref_len, sig_len);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, sig, sig_len);
+#endif
+
+        timing_reset();
+        do {
+            timing_start();
+            ret = mbedtls_ecdsa_read_signature_restartable(&key, hash, sizeof(hash),
+                    sig, sig_len, &rs);
+            timing_stop();
+        } while (ret == MBEDTLS_ERR_ECP_IN_PROGRESS);
+        TEST_ASSERT_EQUAL(0, ret);
+        report("ecdsa verify (secp256r1)", budgets[i]);
+
+        /* A bad signature must still be rejected */
+        sig[sig_len - 1] ^= 1;
+        do {
+            ret = mbedtls_ecdsa_read_signature_restartable(&key, hash, sizeof(hash),
+                    sig, sig_len, &rs);
+        } while (ret == MBEDTLS_ERR_ECP_IN_PROGRESS);
+        TEST_ASSERT_EQUAL(MBEDTLS_ERR_ECP_VERIFY_FAILED, ret);
+
+        mbedtls_ecdsa_restart_free(&rs);
+    }
+
+    mbedtls_ecp_set_max_ops(0);
+    mbedtls_ecdsa_free(&key);
+}
+
+void test_ecdh()
+{
+    unsigned char buf[MBEDTLS_ECP_MAX_PT_LEN];
+    unsigned char z_cli[MBEDTLS_ECP_MAX_BYTES], z_srv[MBEDTLS_ECP_MAX_BYTES];
+    size_t len, z_cli_len, z_srv_len;
+    mbedtls_ecdh_context cli, srv;
+    int ret;
+
+    for (size_t i = 0; i < sizeof(budgets) / sizeof(budgets[0]); i++) {
+        mbedtls_ecp_set_max_ops(budgets[i]);
+
+        mbedtls_ecdh_init(&cli);
+        mbedtls_ecdh_init(&srv);
+        TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&cli.grp, MBEDTLS_ECP_DP_SECP256R1));
+        TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&srv.grp, MBEDTLS_ECP_DP_SECP256R1));
+        mbedtls_ecdh_enable_restart(&cli);
+
+        /* The server side stays blocking as the reference */
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdh_make_public(&srv, &len, buf, sizeof(buf),
+                          mbedtls_ctr_drbg_random, &drbg));
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdh_read_public(&cli, buf, len));
+
+        timing_reset();
+        do {
+            timing_start();
+            ret = mbedtls_ecdh_make_public(&cli, &len, buf, sizeof(buf),
+                                           mbedtls_ctr_drbg_random, &drbg);
+            timing_stop();
+        } while (ret == MBEDTLS_ERR_ECP_IN_PROGRESS);
+        TEST_ASSERT_EQUAL(0, ret);
+
+        do {
+            timing_start();
+            ret = mbedtls_ecdh_calc_secret(&cli, &z_cli_len, z_cli, sizeof(z_cli),
+                                           mbedtls_ctr_drbg_random, &drbg);
+            timing_stop();
+        } while (ret == MBEDTLS_ERR_ECP_IN_PROGRESS);
+        TEST_ASSERT_EQUAL(0, ret);
+        report("ecdh (secp256r1)", budgets[i]);
+
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdh_read_public(&srv, buf, len));
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdh_calc_secret(&srv, &z_srv_len, z_srv, sizeof(z_srv),
+                          mbedtls_ctr_drbg_random, &drbg));
+        TEST_ASSERT_EQUAL(z_srv_len, z_cli_len);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(z_srv, z_cli, z_cli_len);
+
+        mbedtls_ecdh_free(&cli);
+        mbedtls_ecdh_free(&srv);
+    }
+
+    mbedtls_ecp_set_max_ops(0);
+}
+
+#if defined(MBEDTLS_SSL_CLI_C) && defined(MBEDTLS_SSL_SRV_C) && \
+    defined(MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED) && \
+    defined(MBEDTLS_CERTS_C) && defined(MBEDTLS_PEM_PARSE_C) && \
+    defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+
+/* One direction of the in-memory connection */
+struct pipe_t {
+    unsigned char data[PIPE_SIZE];
+    size_t len;
+};
+
+struct endpoint_t {
+    pipe_t *rx;
+    pipe_t *tx;
+};
+
+static pipe_t to_server;
+static pipe_t to_client;
+
+static int pipe_send(void *ctx, const unsigned char *buf, size_t len)
+{
+    pipe_t *p = static_cast<endpoint_t *>(ctx)->tx;
+    size_t n = PIPE_SIZE - p->len;
+
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(p->data + p->len, buf, n);
+    p->len += n;
+    return n;
+}
+
+static int pipe_recv(void *ctx, unsigned char *buf, size_t len)
+{
+    pipe_t *p = static_cast<endpoint_t *>(ctx)->rx;
+    size_t n = p->len;
+
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(buf, p->data, n);
+    memmove(p->data, p->data + n, p->len - n);
+    p->len -= n;
+    return n;
+}
+
+static bool can_continue(int ret)
+{
+    return ret == 0 || ret == MBEDTLS_ERR_SSL_WANT_READ ||
+           ret == MBEDTLS_ERR_SSL_WANT_WRITE ||
+           ret == MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS;
+}
+
+static const int ciphersuites[] = {
+    MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256, 0
+};
+
+void test_handshake()
+{
+    mbedtls_x509_crt cacert, srvcert, clicert;
+    mbedtls_pk_context srvkey, clikey;
+    mbedtls_ssl_config cli_conf, srv_conf;
+    mbedtls_ssl_context cli, srv;
+    endpoint_t cli_end = { &to_client, &to_server };
+    endpoint_t srv_end = { &to_server, &to_client };
+
+    mbedtls_x509_crt_init(&cacert);
+    mbedtls_x509_crt_init(&srvcert);
+    mbedtls_x509_crt_init(&clicert);
+    mbedtls_pk_init(&srvkey);
+    mbedtls_pk_init(&clikey);
+    mbedtls_ssl_config_init(&cli_conf);
+    mbedtls_ssl_config_init(&srv_conf);
+
+    TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_parse(&cacert,
+                      (const unsigned char *) mbedtls_test_cas_pem, mbedtls_test_cas_pem_len));
+    TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_parse(&srvcert,
+                      (const unsigned char *) mbedtls_test_srv_crt_ec, mbedtls_test_srv_crt_ec_len));
+    TEST_ASSERT_EQUAL(0, mbedtls_pk_parse_key(&srvkey,
+                      (const unsigned char *) mbedtls_test_srv_key_ec, mbedtls_test_srv_key_ec_len, NULL, 0));
+    TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_parse(&clicert,
+                      (const unsigned char *) mbedtls_test_cli_crt_ec, mbedtls_test_cli_crt_ec_len));
+    TEST_ASSERT_EQUAL(0, mbedtls_pk_parse_key(&clikey,
+                      (const unsigned char *) mbedtls_test_cli_key_ec, mbedtls_test_cli_key_ec_len, NULL, 0));
+
+    TEST_ASSERT_EQUAL(0, mbedtls_ssl_config_defaults(&cli_conf, MBEDTLS_SSL_IS_CLIENT,
+                      MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT));
+    mbedtls_ssl_conf_rng(&cli_conf, mbedtls_ctr_drbg_random, &drbg);
+    mbedtls_ssl_conf_ca_chain(&cli_conf, &cacert, NULL);
+    mbedtls_ssl_conf_authmode(&cli_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+    mbedtls_ssl_conf_ciphersuites(&cli_conf, ciphersuites);
+    TEST_ASSERT_EQUAL(0, mbedtls_ssl_conf_own_cert(&cli_conf, &clicert, &clikey));
+
+    TEST_ASSERT_EQUAL(0, mbedtls_ssl_config_defaults(&srv_conf, MBEDTLS_SSL_IS_SERVER,
+                      MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT));
+    mbedtls_ssl_conf_rng(&srv_conf, mbedtls_ctr_drbg_random, &drbg);
+    mbedtls_ssl_conf_ca_chain(&srv_conf, &cacert, NULL);
+    mbedtls_ssl_conf_authmode(&srv_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+    TEST_ASSERT_EQUAL(0, mbedtls_ssl_conf_own_cert(&srv_conf, &srvcert, &srvkey));
+
+    for (size_t i = 0; i < sizeof(budgets) / sizeof(budgets[0]); i++) {
+        int cli_max_us = 0, srv_max_us = 0, in_progress = 0;
+
+        /* The budget must be set before the handshake is set up */
+        mbedtls_ecp_set_max_ops(budgets[i]);
+
+        to_server.len = 0;
+        to_client.len = 0;
+        mbedtls_ssl_init(&cli);
+        mbedtls_ssl_init(&srv);
+        TEST_ASSERT_EQUAL(0, mbedtls_ssl_setup(&cli, &cli_conf));
+        TEST_ASSERT_EQUAL(0, mbedtls_ssl_setup(&srv, &srv_conf));
+        TEST_ASSERT_EQUAL(0, mbedtls_ssl_set_hostname(&cli, "localhost"));
+        mbedtls_ssl_set_bio(&cli, &cli_end, pipe_send, pipe_recv, NULL);
+        mbedtls_ssl_set_bio(&srv, &srv_end, pipe_send, pipe_recv, NULL);
+
+        timing_reset();
+        while (cli.state != MBEDTLS_SSL_HANDSHAKE_OVER ||
+               srv.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            int ret;
+
+            if (cli.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+                max_us = 0;
+                timing_start();
+                ret = mbedtls_ssl_handshake_step(&cli);
+                timing_stop();
+                TEST_ASSERT_MESSAGE(can_continue(ret), "client handshake failed");
+                in_progress += ret == MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS;
+                if (max_us > cli_max_us) {
+                    cli_max_us = max_us;
+                }
+            }
+
+            if (srv.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+                max_us = 0;
+                timing_start();
+                ret = mbedtls_ssl_handshake_step(&srv);
+                timing_stop();
+                TEST_ASSERT_MESSAGE(can_continue(ret), "server handshake failed");
+                in_progress += ret == MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS;
+                if (max_us > srv_max_us) {
+                    srv_max_us = max_us;
+                }
+            }
+        }
+
+        /* The longest client step includes X.509 chain verification,
+         * which is not restartable */
+        printf("%-28s max_ops %5u: %4d calls, %4d in progress, "
+               "longest client step %6d us, longest server step %6d us\r\n",
+               "handshake (ECDHE-ECDSA)", budgets[i], calls, in_progress,
+               cli_max_us, srv_max_us);
+
+        if (budgets[i] == 0) {
+            TEST_ASSERT_EQUAL(0, in_progress);
+        } else {
+            TEST_ASSERT(in_progress > 0);
+        }
+
+        mbedtls_ssl_free(&cli);
+        mbedtls_ssl_free(&srv);
+    }
+
+    mbedtls_ecp_set_max_ops(0);
+    mbedtls_ssl_config_free(&cli_conf);
+    mbedtls_ssl_config_free(&srv_conf);
+    mbedtls_pk_free(&clikey);
+    mbedtls_pk_free(&srvkey);
+    mbedtls_x509_crt_free(&clicert);
+    mbedtls_x509_crt_free(&srvcert);
+    mbedtls_x509_crt_free(&cacert);
+}
+#endif
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("mbedtls restartable ecdsa", test_ecdsa, greentea_failure_handler),
+    Case("mbedtls restartable ecdh", test_ecdh, greentea_failure_handler),
+#if defined(MBEDTLS_SSL_CLI_C) && defined(MBEDTLS_SSL_SRV_C) && \
+    defined(MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED) && \
+    defined(MBEDTLS_CERTS_C) && defined(MBEDTLS_PEM_PARSE_C) && \
+    defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+    Case("mbedtls restartable handshake", test_handshake, greentea_failure_handler),
+#endif
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(300, "default_auto");
+    mbedtls_ctr_drbg_init(&drbg);
+    if (mbedtls_ctr_drbg_seed(&drbg, test_entropy, NULL, NULL, 0) != 0) {
+        return STATUS_ABORT;
+    }
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main() {
+    Harness::run(specification);
+}
@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Handshake replay for the buffer allocator.
+ *
+ * Records the mbedtls_calloc() and mbedtls_free() calls of a TLS handshake,
+ * client and server in the same thread over in-memory pipes, then replays
+ * the recording against a fresh mbedtls_memory_buffer_alloc heap. Prints the
+ * time spent in the allocator and the peak footprint, the end of the highest
+ * block in use, against the peak of bytes requested. Build once with the
+ * default MBEDTLS_MEMORY_FREE_LISTS of 1 (single first-fit list) and once
+ * with, say, 20 to compare.
+ *
+ * A full ECDHE-ECDSA handshake makes over 100000 calls, mostly bignum limbs,
+ * so only the first REPLAY_MAX_EVENTS are kept (4 bytes each). Blocks still
+ * live at the end of the recording are freed at the end of the replay.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbedtls/memory_buffer_alloc.h"
+#include "mbedtls/platform.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/ssl_internal.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/certs.h"
+
+#if !defined(MBEDTLS_MEMORY_BUFFER_ALLOC_C)
+  #error [NOT_SUPPORTED] MBEDTLS_MEMORY_BUFFER_ALLOC_C not enabled
+#endif
+
+#if !defined(MBEDTLS_SSL_CLI_C) || !defined(MBEDTLS_SSL_SRV_C) || \
+    !defined(MBEDTLS_CTR_DRBG_C) || !defined(MBEDTLS_CERTS_C) || \
+    !defined(MBEDTLS_X509_CRT_PARSE_C) || !defined(MBEDTLS_PEM_PARSE_C) || \
+    !defined(MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED) || \
+    !defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+  #error [NOT_SUPPORTED] mbed TLS client, server, ECDHE-ECDSA or test certificates not enabled
+#endif
+
+using namespace utest::v1;
+
+/* Record buffers of both endpoints, plus the handshake itself */
+#if !defined(REPLAY_HEAP_SIZE)
+#define REPLAY_HEAP_SIZE    (4 * MBEDTLS_SSL_BUFFER_LEN + 48 * 1024)
+#endif
+#if !defined(REPLAY_MAX_EVENTS)
+#define REPLAY_MAX_EVENTS   16384
+#endif
+#define REPLAY_MAX_LIVE     512     /* fits alloc_event_t::slot */
+#if !defined(REPLAY_ROUNDS)
+#define REPLAY_ROUNDS       10
+#endif
+
+#define PIPE_SIZE           4096
+#define MAX_STEPS           1000
+
+/* One allocator call of the recording; slot pairs a free with its calloc */
+struct alloc_event_t {
+    uint32_t slot : 9;
+    uint32_t is_free : 1;
+    uint32_t size : 22;
+};
+
+static unsigned char heap_buf[REPLAY_HEAP_SIZE];
+static alloc_event_t events[REPLAY_MAX_EVENTS];
+static size_t event_count;
+static size_t call_count;
+static bool live_overflow;
+static void *live[REPLAY_MAX_LIVE];
+static size_t live_size[REPLAY_MAX_LIVE];
+
+static void *(*real_calloc)(size_t, size_t);
+static void (*real_free)(void *);
+
+static void record(uint16_t slot, uint16_t is_free, size_t size)
+{
+    events[event_count].slot = slot;
+    events[event_count].is_free = is_free;
+    events[event_count].size = (uint32_t) size;
+    event_count++;
+}
+
+static void *record_calloc(size_t n, size_t size)
+{
+    void *p = real_calloc(n, size);
+
+    call_count++;
+    if (p != NULL && event_count < REPLAY_MAX_EVENTS) {
+        for (uint16_t slot = 0; slot < REPLAY_MAX_LIVE; slot++) {
+            if (live[slot] == NULL) {
+                live[slot] = p;
+                record(slot, 0, n * size);
+                return p;
+            }
+        }
+        live_overflow = true;
+    }
+    return p;
+}
+
+static void record_free(void *p)
+{
+    call_count += p != NULL;
+    if (p != NULL && event_count < REPLAY_MAX_EVENTS) {
+        for (uint16_t slot = 0; slot < REPLAY_MAX_LIVE; slot++) {
+            if (live[slot] == p) {
+                live[slot] = NULL;
+                record(slot, 1, 0);
+                break;
+            }
+        }
+    }
+    real_free(p);
+}
+
+/* In-memory connection, kept out of the heap */
+struct pipe_t {
+    unsigned char data[PIPE_SIZE];
+    size_t len;
+};
+
+struct endpoint_t {
+    pipe_t *rx;
+    pipe_t *tx;
+};
+
+static pipe_t to_server;
+static pipe_t to_client;
+
+static int pipe_send(void *ctx, const unsigned char *data, size_t len)
+{
+    pipe_t *p = ((endpoint_t *) ctx)->tx;
+    size_t n = PIPE_SIZE - p->len;
+
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(p->data + p->len, data, n);
+    p->len += n;
+    return (int) n;
+}
+
+static int pipe_recv(void *ctx, unsigned char *data, size_t len)
+{
+    pipe_t *p = ((endpoint_t *) ctx)->rx;
+    size_t n = p->len;
+
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(data, p->data, n);
+    memmove(p->data, p->data + n, p->len - n);
+    p->len -= n;
+    return (int) n;
+}
+
+static int can_continue(int ret)
+{
+    return ret == 0 || ret == MBEDTLS_ERR_SSL_WANT_READ ||
+           ret == MBEDTLS_ERR_SSL_WANT_WRITE;
+}
+
+static int test_entropy(void *ctx, unsigned char *buf, size_t len)
+{
+    (void) ctx;
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (unsigned char) (i * 7 + 1);
+    }
+    return 0;
+}
+
+/* Parse the credentials and run one full handshake, everything on the heap */
+static int run_handshake()
+{
+    const int ciphersuites[] = { MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256, 0 };
+    mbedtls_ctr_drbg_context drbg;
+    mbedtls_x509_crt cacert, srvcert;
+    mbedtls_pk_context srvkey;
+    mbedtls_ssl_config cli_conf, srv_conf;
+    mbedtls_ssl_context cli, srv;
+    endpoint_t cli_end = { &to_client, &to_server };
+    endpoint_t srv_end = { &to_server, &to_client };
+    int ret, steps = 0;
+
+    mbedtls_ctr_drbg_init(&drbg);
+    mbedtls_x509_crt_init(&cacert);
+    mbedtls_x509_crt_init(&srvcert);
+    mbedtls_pk_init(&srvkey);
+    mbedtls_ssl_config_init(&cli_conf);
+    mbedtls_ssl_config_init(&srv_conf);
+    mbedtls_ssl_init(&cli);
+    mbedtls_ssl_init(&srv);
+    to_server.len = 0;
+    to_client.len = 0;
+
+    ret = mbedtls_ctr_drbg_seed(&drbg, test_entropy, NULL, NULL, 0);
+    if (ret == 0) {
+        ret = mbedtls_x509_crt_parse(&cacert, (const unsigned char *) mbedtls_test_cas_pem,
+                                     mbedtls_test_cas_pem_len);
+    }
+    if (ret == 0) {
+        ret = mbedtls_x509_crt_parse(&srvcert, (const unsigned char *) mbedtls_test_srv_crt_ec,
+                                     mbedtls_test_srv_crt_ec_len);
+    }
+    if (ret == 0) {
+        ret = mbedtls_pk_parse_key(&srvkey, (const unsigned char *) mbedtls_test_srv_key_ec,
+                                   mbedtls_test_srv_key_ec_len, NULL, 0);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_config_defaults(&cli_conf, MBEDTLS_SSL_IS_CLIENT,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) {
+        mbedtls_ssl_conf_rng(&cli_conf, mbedtls_ctr_drbg_random, &drbg);
+        mbedtls_ssl_conf_ca_chain(&cli_conf, &cacert, NULL);
+        mbedtls_ssl_conf_authmode(&cli_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+        mbedtls_ssl_conf_ciphersuites(&cli_conf, ciphersuites);
+        ret = mbedtls_ssl_config_defaults(&srv_conf, MBEDTLS_SSL_IS_SERVER,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) {
+        mbedtls_ssl_conf_rng(&srv_conf, mbedtls_ctr_drbg_random, &drbg);
+        ret = mbedtls_ssl_conf_own_cert(&srv_conf, &srvcert, &srvkey);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_setup(&cli, &cli_conf);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_setup(&srv, &srv_conf);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_set_hostname(&cli, "localhost");
+    }
+    mbedtls_ssl_set_bio(&cli, &cli_end, pipe_send, pipe_recv, NULL);
+    mbedtls_ssl_set_bio(&srv, &srv_end, pipe_send, pipe_recv, NULL);
+
+    while (ret == 0 && (cli.state != MBEDTLS_SSL_HANDSHAKE_OVER ||
+                        srv.state != MBEDTLS_SSL_HANDSHAKE_OVER)) {
+        if (cli.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            ret = mbedtls_ssl_handshake_step(&cli);
+            ret = can_continue(ret) ? 0 : ret;
+        }
+        if (ret == 0 && srv.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            ret = mbedtls_ssl_handshake_step(&srv);
+            ret = can_continue(ret) ? 0 : ret;
+        }
+        if (++steps > MAX_STEPS) {
+            ret = MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+        }
+    }
+
+    mbedtls_ssl_free(&cli);
+    mbedtls_ssl_free(&srv);
+    mbedtls_ssl_config_free(&cli_conf);
+    mbedtls_ssl_config_free(&srv_conf);
+    mbedtls_pk_free(&srvkey);
+    mbedtls_x509_crt_free(&srvcert);
+    mbedtls_x509_crt_free(&cacert);
+    mbedtls_ctr_drbg_free(&drbg);
+    return ret;
+}
+
+void test_record()
+{
+    mbedtls_memory_buffer_alloc_init(heap_buf, sizeof(heap_buf));
+    real_calloc = mbedtls_calloc;
+    real_free = mbedtls_free;
+    mbedtls_platform_set_calloc_free(record_calloc, record_free);
+
+    int ret = run_handshake();
+
+    mbedtls_platform_set_calloc_free(real_calloc, real_free);
+    TEST_ASSERT_EQUAL(0, mbedtls_memory_buffer_alloc_verify());
+    mbedtls_memory_buffer_alloc_free();
+
+    TEST_ASSERT_EQUAL(0, ret);
+    TEST_ASSERT_FALSE(live_overflow);
+
+    printf("recorded %u of %u allocator calls\r\n", (unsigned) event_count,
+           (unsigned) call_count);
+}
+
+/* Replay the recording on a fresh heap, returning the failed allocations.
+ * With stats, also track the peak of bytes requested and of the footprint. */
+static size_t replay(size_t *peak_requested, size_t *peak_footprint)
+{
+    size_t failed = 0, requested = 0;
+
+    mbedtls_memory_buffer_alloc_init(heap_buf, sizeof(heap_buf));
+    memset(live, 0, sizeof(live));
+
+    for (size_t i = 0; i < event_count; i++) {
+        const alloc_event_t *e = &events[i];
+
+        if (e->is_free) {
+            mbedtls_free(live[e->slot]);
+            if (peak_requested != NULL && live[e->slot] != NULL) {
+                requested -= live_size[e->slot];
+            }
+            live[e->slot] = NULL;
+            continue;
+        }
+
+        live[e->slot] = mbedtls_calloc(1, e->size);
+        if (live[e->slot] == NULL) {
+            failed++;
+        } else if (peak_requested != NULL) {
+            size_t end = (unsigned char *) live[e->slot] + e->size - heap_buf;
+
+            live_size[e->slot] = e->size;
+            requested += e->size;
+            if (requested > *peak_requested) {
+                *peak_requested = requested;
+            }
+            if (end > *peak_footprint) {
+                *peak_footprint = end;
+            }
+        }
+    }
+
+    for (size_t slot = 0; slot < REPLAY_MAX_LIVE; slot++) {
+        mbedtls_free(live[slot]);
+    }
+
+    TEST_ASSERT_EQUAL(0, mbedtls_memory_buffer_alloc_verify());
+    mbedtls_memory_buffer_alloc_free();
+    return failed;
+}
+
+void test_replay()
+{
+    Timer timer;
+    size_t peak_requested = 0, peak_footprint = 0;
+
+    TEST_ASSERT_NOT_EQUAL(0, event_count);
+
+    timer.start();
+    for (int i = 0; i < REPLAY_ROUNDS; i++) {
+        TEST_ASSERT_EQUAL(0, replay(NULL, NULL));
+    }
+    timer.stop();
+
+    TEST_ASSERT_EQUAL(0, replay(&peak_requested, &peak_footprint));
+
+    printf("free lists %d: %u calls in %d us, peak requested %lu, "
+           "peak footprint %lu (%lu%% overhead)\r\n",
+           MBEDTLS_MEMORY_FREE_LISTS, (unsigned) event_count,
+           timer.read_us() / REPLAY_ROUNDS, (unsigned long) peak_requested,
+           (unsigned long) peak_footprint,
+           (unsigned long) ((peak_footprint - peak_requested) * 100 / peak_requested));
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("mbedtls buffer alloc record handshake", test_record, greentea_failure_handler),
+    Case("mbedtls buffer alloc replay handshake", test_replay, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main() {
+    Harness::run(specification);
+}
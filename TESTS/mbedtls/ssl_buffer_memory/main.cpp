@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Heap used by a TLS connection.
+ *
+ * Runs a client and a server in the same thread, connected by in-memory
+ * pipes, and samples mbed_stats_heap_get() between every handshake step
+ * and record to find the peak heap taken by the connection. Build once with
+ * and once without MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH to compare.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "mbed_stats.h"
+
+#include "mbedtls/ssl.h"
+#include "mbedtls/ssl_internal.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/certs.h"
+
+#if !defined(MBED_HEAP_STATS_ENABLED)
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+#if !defined(MBEDTLS_SSL_CLI_C) || !defined(MBEDTLS_SSL_SRV_C) || \
+    !defined(MBEDTLS_CTR_DRBG_C) || !defined(MBEDTLS_CERTS_C) || \
+    !defined(MBEDTLS_X509_CRT_PARSE_C) || !defined(MBEDTLS_PEM_PARSE_C)
+  #error [NOT_SUPPORTED] mbed TLS client, server or test certificates not enabled
+#endif
+
+using namespace utest::v1;
+
+#define PIPE_SIZE       4096
+#define MAX_STEPS       2000
+
+/* One direction of the in-memory connection */
+struct pipe_t {
+    unsigned char data[PIPE_SIZE];
+    size_t len;
+};
+
+struct endpoint_t {
+    pipe_t *rx;
+    pipe_t *tx;
+};
+
+/* Kept out of the heap so they do not count towards the measurement */
+static pipe_t to_server;
+static pipe_t to_client;
+static unsigned char app_data[MBEDTLS_SSL_MAX_CONTENT_LEN];
+static unsigned char app_recv[MBEDTLS_SSL_MAX_CONTENT_LEN];
+
+static mbed_stats_heap_t heap_base;
+static uint32_t heap_peak;
+
+static void heap_sample()
+{
+    mbed_stats_heap_t stats;
+    mbed_stats_heap_get(&stats);
+    uint32_t used = stats.current_size - heap_base.current_size;
+    if (used > heap_peak) {
+        heap_peak = used;
+    }
+}
+
+static void heap_reset()
+{
+    mbed_stats_heap_get(&heap_base);
+    heap_peak = 0;
+}
+
+static uint32_t heap_now()
+{
+    mbed_stats_heap_t stats;
+    mbed_stats_heap_get(&stats);
+    return stats.current_size - heap_base.current_size;
+}
+
+static int pipe_send(void *ctx, const unsigned char *buf, size_t len)
+{
+    pipe_t *p = static_cast<endpoint_t *>(ctx)->tx;
+    size_t n = PIPE_SIZE - p->len;
+
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(p->data + p->len, buf, n);
+    p->len += n;
+    return n;
+}
+
+static int pipe_recv(void *ctx, unsigned char *buf, size_t len)
+{
+    pipe_t *p = static_cast<endpoint_t *>(ctx)->rx;
+    size_t n = p->len;
+
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(buf, p->data, n);
+    memmove(p->data, p->data + n, p->len - n);
+    p->len -= n;
+    return n;
+}
+
+/* Deterministic seed, the test measures memory rather than security */
+static int test_entropy(void *ctx, unsigned char *buf, size_t len)
+{
+    (void) ctx;
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (unsigned char) i;
+    }
+    return 0;
+}
+
+static bool would_block(int ret)
+{
+    return ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE;
+}
+
+class Connection {
+public:
+    Connection()
+    {
+        mbedtls_ctr_drbg_init(&drbg);
+        mbedtls_x509_crt_init(&cacert);
+        mbedtls_x509_crt_init(&srvcert);
+        mbedtls_pk_init(&srvkey);
+        mbedtls_ssl_config_init(&cli_conf);
+        mbedtls_ssl_config_init(&srv_conf);
+        mbedtls_ssl_init(&cli);
+        mbedtls_ssl_init(&srv);
+    }
+
+    ~Connection()
+    {
+        mbedtls_ssl_free(&cli);
+        mbedtls_ssl_free(&srv);
+        mbedtls_ssl_config_free(&cli_conf);
+        mbedtls_ssl_config_free(&srv_conf);
+        mbedtls_pk_free(&srvkey);
+        mbedtls_x509_crt_free(&srvcert);
+        mbedtls_x509_crt_free(&cacert);
+        mbedtls_ctr_drbg_free(&drbg);
+    }
+
+    void configure()
+    {
+        TEST_ASSERT_EQUAL(0, mbedtls_ctr_drbg_seed(&drbg, test_entropy, NULL, NULL, 0));
+
+#if defined(MBEDTLS_ECDSA_C)
+        const unsigned char *crt = (const unsigned char *) mbedtls_test_srv_crt_ec;
+        size_t crt_len = mbedtls_test_srv_crt_ec_len;
+        const unsigned char *key = (const unsigned char *) mbedtls_test_srv_key_ec;
+        size_t key_len = mbedtls_test_srv_key_ec_len;
+#else
+        const unsigned char *crt = (const unsigned char *) mbedtls_test_srv_crt;
+        size_t crt_len = mbedtls_test_srv_crt_len;
+        const unsigned char *key = (const unsigned char *) mbedtls_test_srv_key;
+        size_t key_len = mbedtls_test_srv_key_len;
+#endif
+        TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_parse(&cacert,
+                          (const unsigned char *) mbedtls_test_cas_pem, mbedtls_test_cas_pem_len));
+        TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_parse(&srvcert, crt, crt_len));
+        TEST_ASSERT_EQUAL(0, mbedtls_pk_parse_key(&srvkey, key, key_len, NULL, 0));
+
+        TEST_ASSERT_EQUAL(0, mbedtls_ssl_config_defaults(&cli_conf, MBEDTLS_SSL_IS_CLIENT,
+                          MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT));
+        mbedtls_ssl_conf_rng(&cli_conf, mbedtls_ctr_drbg_random, &drbg);
+        mbedtls_ssl_conf_ca_chain(&cli_conf, &cacert, NULL);
+        mbedtls_ssl_conf_authmode(&cli_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+
+        TEST_ASSERT_EQUAL(0, mbedtls_ssl_config_defaults(&srv_conf, MBEDTLS_SSL_IS_SERVER,
+                          MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT));
+        mbedtls_ssl_conf_rng(&srv_conf, mbedtls_ctr_drbg_random, &drbg);
+        TEST_ASSERT_EQUAL(0, mbedtls_ssl_conf_own_cert(&srv_conf, &srvcert, &srvkey));
+    }
+
+    void setup()
+    {
+        to_server.len = 0;
+        to_client.len = 0;
+        cli_end.rx = &to_client;
+        cli_end.tx = &to_server;
+        srv_end.rx = &to_server;
+        srv_end.tx = &to_client;
+
+        TEST_ASSERT_EQUAL(0, mbedtls_ssl_setup(&cli, &cli_conf));
+        TEST_ASSERT_EQUAL(0, mbedtls_ssl_setup(&srv, &srv_conf));
+        TEST_ASSERT_EQUAL(0, mbedtls_ssl_set_hostname(&cli, "localhost"));
+        mbedtls_ssl_set_bio(&cli, &cli_end, pipe_send, pipe_recv, NULL);
+        mbedtls_ssl_set_bio(&srv, &srv_end, pipe_send, pipe_recv, NULL);
+    }
+
+    void handshake()
+    {
+        int steps = 0;
+        while (cli.state != MBEDTLS_SSL_HANDSHAKE_OVER ||
+               srv.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+            TEST_ASSERT_MESSAGE(++steps < MAX_STEPS, "handshake did not complete");
+
+            if (cli.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+                int ret = mbedtls_ssl_handshake_step(&cli);
+                TEST_ASSERT_MESSAGE(ret == 0 || would_block(ret), "client handshake failed");
+            }
+            heap_sample();
+
+            if (srv.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+                int ret = mbedtls_ssl_handshake_step(&srv);
+                TEST_ASSERT_MESSAGE(ret == 0 || would_block(ret), "server handshake failed");
+            }
+            heap_sample();
+        }
+    }
+
+    void transfer(size_t len)
+    {
+        size_t sent = 0, received = 0;
+        int steps = 0;
+
+        while (received < len) {
+            TEST_ASSERT_MESSAGE(++steps < MAX_STEPS, "transfer did not complete");
+
+            if (sent < len) {
+                int ret = mbedtls_ssl_write(&cli, app_data + sent, len - sent);
+                TEST_ASSERT_MESSAGE(ret > 0 || would_block(ret), "write failed");
+                if (ret > 0) {
+                    sent += ret;
+                }
+            }
+            heap_sample();
+
+            int ret = mbedtls_ssl_read(&srv, app_recv + received, len - received);
+            TEST_ASSERT_MESSAGE(ret > 0 || would_block(ret), "read failed");
+            if (ret > 0) {
+                received += ret;
+            }
+            heap_sample();
+        }
+
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(app_data, app_recv, len);
+    }
+
+private:
+    mbedtls_ctr_drbg_context drbg;
+    mbedtls_x509_crt cacert;
+    mbedtls_x509_crt srvcert;
+    mbedtls_pk_context srvkey;
+    mbedtls_ssl_config cli_conf;
+    mbedtls_ssl_config srv_conf;
+    mbedtls_ssl_context cli;
+    mbedtls_ssl_context srv;
+    endpoint_t cli_end;
+    endpoint_t srv_end;
+};
+
+void test_connection_heap()
+{
+    for (size_t i = 0; i < sizeof(app_data); i++) {
+        app_data[i] = (unsigned char) i;
+    }
+
+    Connection *conn = new Connection;
+    conn->configure();
+
+    heap_reset();
+    conn->setup();
+    uint32_t setup = heap_now();
+
+    conn->handshake();
+    uint32_t handshake_peak = heap_peak;
+    uint32_t idle = heap_now();
+
+    heap_peak = idle;
+    conn->transfer(256);
+    uint32_t small_peak = heap_peak;
+
+    heap_peak = heap_now();
+    conn->transfer(sizeof(app_data));
+    uint32_t large_peak = heap_peak;
+
+    delete conn;
+
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    const char *mode = "variable";
+#else
+    const char *mode = "fixed";
+#endif
+    /* Figures cover both endpoints of one connection */
+    printf("ssl heap (%s buffers): setup %lu, handshake peak %lu, idle %lu, "
+           "small record peak %lu, large record peak %lu\r\n", mode,
+           (unsigned long) setup, (unsigned long) handshake_peak,
+           (unsigned long) idle, (unsigned long) small_peak,
+           (unsigned long) large_peak);
+
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    /* The buffers must be back to their initial size after the handshake
+     * and must not grow for small records */
+    TEST_ASSERT(idle < handshake_peak);
+    TEST_ASSERT(idle < 4 * MBEDTLS_SSL_BUFFER_LEN);
+    TEST_ASSERT_EQUAL(idle, small_peak);
+#endif
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("mbedtls ssl connection heap", test_connection_heap, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main() {
+    Harness::run(specification);
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * In-place X.509 parsing.
+ *
+ * Loads a 30 certificate trust store from flash with mbedtls_x509_crt_parse_der()
+ * and with mbedtls_x509_crt_parse_der_nocopy(), prints the heap kept by each
+ * and the time to verify a chain against it, and checks that certificates
+ * parsed in place verify, match host names and extended key usages the same
+ * way as copied ones.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "mbed_stats.h"
+
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/oid.h"
+
+#include "trust_store.h"
+
+#if !defined(MBEDTLS_X509_CRT_PARSE_C) || !defined(MBEDTLS_ECDSA_C) || \
+    !defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED) || !defined(MBEDTLS_SHA256_C)
+  #error [NOT_SUPPORTED] X.509 with ECDSA P-256 and SHA-256 not enabled
+#endif
+
+using namespace utest::v1;
+
+#define VERIFY_ROUNDS   5
+
+typedef int (*parse_der_t)(mbedtls_x509_crt *, const unsigned char *, size_t);
+
+static uint32_t heap_now()
+{
+#if defined(MBED_HEAP_STATS_ENABLED)
+    mbed_stats_heap_t stats;
+    mbed_stats_heap_get(&stats);
+    return stats.current_size;
+#else
+    return 0;
+#endif
+}
+
+static void load(parse_der_t parse, mbedtls_x509_crt *trust, mbedtls_x509_crt *chain)
+{
+    mbedtls_x509_crt_init(trust);
+    mbedtls_x509_crt_init(chain);
+
+    for (size_t i = 0; i < TRUST_STORE_ROOTS; i++) {
+        TEST_ASSERT_EQUAL(0, parse(trust, trust_store_roots[i].der, trust_store_roots[i].len));
+    }
+
+    TEST_ASSERT_EQUAL(0, parse(chain, trust_store_leaf, sizeof(trust_store_leaf)));
+    TEST_ASSERT_EQUAL(0, parse(chain, trust_store_intermediate, sizeof(trust_store_intermediate)));
+}
+
+static void unload(mbedtls_x509_crt *trust, mbedtls_x509_crt *chain)
+{
+    mbedtls_x509_crt_free(chain);
+    mbedtls_x509_crt_free(trust);
+}
+
+static void measure(parse_der_t parse, const char *mode)
+{
+    Timer timer;
+    mbedtls_x509_crt trust, chain;
+    uint32_t flags;
+
+    uint32_t heap_before = heap_now();
+    timer.start();
+    load(parse, &trust, &chain);
+    timer.stop();
+    uint32_t heap = heap_now() - heap_before;
+    int parse_us = timer.read_us();
+
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < VERIFY_ROUNDS; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_verify(&chain, &trust, NULL,
+                                                     "localhost", &flags, NULL, NULL));
+        TEST_ASSERT_EQUAL(0, flags);
+    }
+    timer.stop();
+    int verify_us = timer.read_us() / VERIFY_ROUNDS;
+
+    printf("%s: %u certificates, heap %lu, parse %d us, verify %d us\r\n",
+           mode, (unsigned) TRUST_STORE_ROOTS + 2, (unsigned long) heap,
+           parse_us, verify_us);
+
+    unload(&trust, &chain);
+}
+
+void test_in_place()
+{
+    mbedtls_x509_crt trust, chain;
+    const mbedtls_x509_crt *crt;
+    size_t i = 0;
+
+    load(mbedtls_x509_crt_parse_der_nocopy, &trust, &chain);
+
+    for (crt = &trust; crt != NULL; crt = crt->next, i++) {
+        TEST_ASSERT_EQUAL_PTR(trust_store_roots[i].der, crt->raw.p);
+        TEST_ASSERT_EQUAL(0, crt->own_buffer);
+        TEST_ASSERT_NULL(crt->subject.oid.p);
+        TEST_ASSERT_EQUAL(1, crt->ca_istrue);
+    }
+    TEST_ASSERT_EQUAL(TRUST_STORE_ROOTS, i);
+
+    /* Names are decoded on demand for printing */
+    char buf[1024];
+    TEST_ASSERT_TRUE(mbedtls_x509_crt_info(buf, sizeof(buf), "", &chain) > 0);
+    TEST_ASSERT_NOT_NULL(strstr(buf, "CN=localhost"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "*.example.com"));
+
+    unload(&trust, &chain);
+}
+
+static void check_verify(parse_der_t parse)
+{
+    mbedtls_x509_crt trust, chain;
+    uint32_t flags;
+
+    load(parse, &trust, &chain);
+
+    /* subjectAltName, including the wildcard */
+    TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_verify(&chain, &trust, NULL,
+                                                 "localhost", &flags, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, flags);
+    TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_verify(&chain, &trust, NULL,
+                                                 "www.example.com", &flags, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, flags);
+    TEST_ASSERT_NOT_EQUAL(0, mbedtls_x509_crt_verify(&chain, &trust, NULL,
+                                                     "example.org", &flags, NULL, NULL));
+    TEST_ASSERT_EQUAL(MBEDTLS_X509_BADCERT_CN_MISMATCH, flags);
+
+    /* Subject CN of a certificate without subjectAltName */
+    TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_verify(&trust, &trust, NULL,
+                                                 "mbed TLS Test Root 01", &flags, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, flags);
+    TEST_ASSERT_NOT_EQUAL(0, mbedtls_x509_crt_verify(&trust, &trust, NULL,
+                                                     "mbed TLS Test Root 02", &flags, NULL, NULL));
+    TEST_ASSERT_EQUAL(MBEDTLS_X509_BADCERT_CN_MISMATCH, flags);
+
+    /* The intermediate alone does not chain to a trusted root without root 30 */
+    mbedtls_x509_crt *last = &trust;
+    while (last->next->next != NULL) {
+        last = last->next;
+    }
+    mbedtls_x509_crt *root30 = last->next;
+    last->next = NULL;
+    TEST_ASSERT_NOT_EQUAL(0, mbedtls_x509_crt_verify(&chain, &trust, NULL,
+                                                     "localhost", &flags, NULL, NULL));
+    TEST_ASSERT_TRUE(flags & MBEDTLS_X509_BADCERT_NOT_TRUSTED);
+    last->next = root30;
+
+#if defined(MBEDTLS_X509_CHECK_EXTENDED_KEY_USAGE)
+    TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_check_extended_key_usage(&chain,
+                         MBEDTLS_OID_SERVER_AUTH, MBEDTLS_OID_SIZE(MBEDTLS_OID_SERVER_AUTH)));
+    TEST_ASSERT_NOT_EQUAL(0, mbedtls_x509_crt_check_extended_key_usage(&chain,
+                             MBEDTLS_OID_CLIENT_AUTH, MBEDTLS_OID_SIZE(MBEDTLS_OID_CLIENT_AUTH)));
+    /* No extension means no restriction */
+    TEST_ASSERT_EQUAL(0, mbedtls_x509_crt_check_extended_key_usage(&trust,
+                         MBEDTLS_OID_CLIENT_AUTH, MBEDTLS_OID_SIZE(MBEDTLS_OID_CLIENT_AUTH)));
+#endif
+
+    unload(&trust, &chain);
+}
+
+void test_verify_copy()
+{
+    check_verify(mbedtls_x509_crt_parse_der);
+}
+
+void test_verify_in_place()
+{
+    check_verify(mbedtls_x509_crt_parse_der_nocopy);
+}
+
+void test_measure()
+{
+    measure(mbedtls_x509_crt_parse_der, "copy");
+    measure(mbedtls_x509_crt_parse_der_nocopy, "in place");
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("mbedtls x509 parse in place", test_in_place, greentea_failure_handler),
+    Case("mbedtls x509 verify copied chain", test_verify_copy, greentea_failure_handler),
+    Case("mbedtls x509 verify chain parsed in place", test_verify_in_place, greentea_failure_handler),
+    Case("mbedtls x509 trust store heap and time", test_measure, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main() {
+    Harness::run(specification);
+}
@@ -0,0 +1,1489 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Test trust store: 30 self-signed P-256 roots ("CN=mbed TLS Test Root NN"),
+ * and a chain of an intermediate issued by root 30 and a leaf for localhost
+ * (SAN localhost and *.example.com, EKU serverAuth). Generated with:
+ *
+ *   openssl ecparam -name prime256v1 -genkey -noout -out rootNN.key
+ *   openssl req -new -x509 -key rootNN.key -sha256 -days 10950 -set_serial NN \
+ *       -subj "/C=NL/O=mbed TLS/OU=Trust Store/CN=mbed TLS Test Root NN" \
+ *       -extensions v3 -outform DER -out rootNN.der
+ *   (v3: basicConstraints=critical,CA:TRUE, keyUsage=critical,keyCertSign,cRLSign)
+ *
+ * and the intermediate and leaf with "openssl x509 -req" from root 30.
+ */
+
+#ifndef X509_NOCOPY_TRUST_STORE_H
+#define X509_NOCOPY_TRUST_STORE_H
+
+#include <stddef.h>
+
+static const unsigned char trust_store_root_01[482] = {
+    0x30, 0x82, 0x01, 0xde, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x01, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x31, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x31, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x77, 0xa0, 0x98, 0x82, 0x13, 0xb1, 0xe8, 0x04, 0xef, 0xea, 0x9a,
+    0x7c, 0x91, 0xfb, 0x59, 0x0f, 0xaf, 0xcf, 0x0f, 0x20, 0xd5, 0x1d, 0x80,
+    0xa3, 0x28, 0xf9, 0x46, 0x2e, 0xf3, 0xc9, 0xe0, 0x99, 0x6d, 0x94, 0xb0,
+    0x8c, 0x84, 0x78, 0xd5, 0x76, 0xd1, 0x4d, 0x74, 0x62, 0x72, 0x91, 0x11,
+    0x21, 0x54, 0xbb, 0xf5, 0x42, 0xeb, 0x58, 0xf8, 0xaa, 0xb9, 0x8c, 0x27,
+    0x72, 0xc1, 0x3b, 0x92, 0x5b, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x8e, 0x03, 0x84, 0x30, 0x27, 0xa0, 0x80,
+    0x2c, 0xa1, 0x80, 0x46, 0x9c, 0xb3, 0xf4, 0x35, 0x6b, 0x92, 0x85, 0x10,
+    0xbe, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x47, 0x00, 0x30, 0x44, 0x02, 0x20, 0x3b, 0xf9, 0x25, 0xd8,
+    0x0e, 0x98, 0xf4, 0xab, 0x59, 0xe2, 0x06, 0xde, 0x96, 0xff, 0x75, 0x3c,
+    0xa4, 0x2f, 0x5f, 0x9b, 0xfb, 0x8a, 0xd2, 0xac, 0x10, 0x5c, 0x07, 0xc0,
+    0xce, 0x21, 0x42, 0x57, 0x02, 0x20, 0x5b, 0x23, 0x41, 0x6f, 0xa7, 0x87,
+    0x74, 0x72, 0x9b, 0xfb, 0x1a, 0xc9, 0x73, 0x15, 0x64, 0x12, 0x12, 0x97,
+    0xf2, 0x52, 0x47, 0x1f, 0xfd, 0x67, 0xf0, 0x6f, 0x73, 0xcf, 0xfa, 0xc1,
+    0xdf, 0x97,
+};
+
+static const unsigned char trust_store_root_02[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x02, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x32, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x32, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0xc8, 0xd4, 0xa4, 0x6d, 0xdd, 0x14, 0x90, 0x75, 0x08, 0xc3, 0xea,
+    0x77, 0x9e, 0x59, 0x1b, 0xe3, 0x7e, 0x61, 0x5d, 0xfc, 0x51, 0x1c, 0x7e,
+    0x2a, 0xce, 0x1a, 0x55, 0x63, 0xb6, 0xae, 0x36, 0xad, 0xd8, 0x98, 0x18,
+    0x10, 0x15, 0x84, 0x78, 0xa4, 0xbb, 0x76, 0x40, 0xaf, 0xa3, 0xb3, 0x80,
+    0xe1, 0xf0, 0x81, 0x35, 0x2c, 0xfe, 0x90, 0x18, 0xb8, 0x13, 0xc1, 0xf9,
+    0x4d, 0x40, 0x48, 0x42, 0x0a, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xc0, 0xd5, 0xf6, 0x71, 0x22, 0x7f, 0xc6,
+    0x27, 0xc7, 0x56, 0xaa, 0x93, 0x4b, 0x5f, 0x56, 0x6e, 0x6c, 0x8a, 0xf1,
+    0xd6, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0x8c, 0xd2, 0x7f,
+    0xb0, 0x66, 0x27, 0xd2, 0xb9, 0x8a, 0xf3, 0xdb, 0x7a, 0x0b, 0x2b, 0x44,
+    0x86, 0xbc, 0xfc, 0x05, 0x5c, 0x67, 0x56, 0x80, 0xa4, 0xe8, 0xef, 0x7a,
+    0x9e, 0x43, 0xe0, 0xd6, 0xfe, 0x02, 0x20, 0x2d, 0xdb, 0x42, 0x6f, 0x5d,
+    0x73, 0x0a, 0xe7, 0x33, 0x88, 0xd7, 0xdd, 0xe3, 0x60, 0x49, 0x65, 0x02,
+    0xdc, 0xf5, 0x6b, 0x38, 0x76, 0x89, 0x9e, 0x21, 0xcc, 0xc6, 0x4f, 0x98,
+    0x56, 0xad, 0xfd,
+};
+
+static const unsigned char trust_store_root_03[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x03, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x33, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x33, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x4c, 0x14, 0x55, 0x27, 0xb5, 0xb4, 0x33, 0xe0, 0x04, 0x79, 0x58,
+    0xbd, 0x75, 0x03, 0xc7, 0x87, 0x23, 0x1a, 0x3d, 0x0f, 0x96, 0x11, 0x05,
+    0xdc, 0xc9, 0x4f, 0x68, 0xb3, 0x06, 0x10, 0x4d, 0xda, 0x3f, 0xee, 0x6b,
+    0x8f, 0x4d, 0x9a, 0xda, 0xba, 0xef, 0xe5, 0x11, 0x0b, 0x72, 0xa1, 0x8f,
+    0x72, 0x48, 0xc0, 0xfd, 0xef, 0x93, 0xe2, 0xf1, 0xd1, 0x90, 0x26, 0xce,
+    0x86, 0xf1, 0xd1, 0x24, 0x07, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xb2, 0x53, 0x56, 0xeb, 0x22, 0xee, 0x23,
+    0x9c, 0xaa, 0xaf, 0x59, 0x60, 0x8c, 0x1b, 0x82, 0x6e, 0xc3, 0x8c, 0xc1,
+    0xc5, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x20, 0x03, 0x93, 0xdd, 0xfa,
+    0x92, 0x7e, 0xbe, 0x25, 0x27, 0x76, 0xda, 0x75, 0xb0, 0x56, 0x80, 0xaa,
+    0x69, 0x33, 0xf1, 0x8f, 0x35, 0xd6, 0x55, 0x2b, 0xbc, 0x8c, 0x76, 0x5d,
+    0xb9, 0x83, 0x91, 0xec, 0x02, 0x21, 0x00, 0x97, 0x1d, 0x83, 0x95, 0xce,
+    0xe3, 0xfa, 0x4d, 0xd2, 0x59, 0x8f, 0xa8, 0xf4, 0x66, 0x1f, 0x8d, 0x6c,
+    0x0f, 0x69, 0x63, 0x1c, 0x67, 0xb2, 0x36, 0x6a, 0x26, 0x80, 0xad, 0xef,
+    0x8e, 0x9d, 0xda,
+};
+
+static const unsigned char trust_store_root_04[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x04, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x34, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x34, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x8e, 0xaf, 0xfe, 0x2f, 0x8c, 0xde, 0x54, 0xe3, 0x30, 0x2a, 0x57,
+    0x72, 0x7f, 0x1f, 0xd1, 0xcd, 0x2f, 0x17, 0x74, 0xa9, 0xf4, 0x68, 0x68,
+    0xa5, 0xdf, 0x1b, 0x6c, 0x9c, 0xf6, 0xd2, 0x8e, 0xf6, 0x21, 0x9a, 0x77,
+    0xc4, 0x21, 0x2a, 0xe9, 0x56, 0x72, 0x33, 0x52, 0x35, 0xdf, 0xed, 0xa6,
+    0x01, 0x84, 0xbe, 0xfa, 0x8a, 0xe6, 0xa8, 0x40, 0xc5, 0x93, 0x6c, 0xca,
+    0x89, 0xb3, 0x18, 0x58, 0x03, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xd8, 0xd5, 0x2b, 0xeb, 0xe9, 0xb9, 0x66,
+    0xba, 0x82, 0xeb, 0xbb, 0x0f, 0xe4, 0xa8, 0xdf, 0x6a, 0xf7, 0x86, 0x37,
+    0x06, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0xe8, 0xf3, 0x40,
+    0x86, 0x39, 0xd0, 0xac, 0x81, 0x61, 0x96, 0x42, 0x61, 0xf3, 0xf0, 0x1b,
+    0x29, 0xff, 0x42, 0xa4, 0x80, 0xda, 0xaa, 0xce, 0x13, 0x55, 0x93, 0x15,
+    0x9d, 0xeb, 0xb1, 0x2d, 0xbb, 0x02, 0x20, 0x18, 0xc3, 0x74, 0x50, 0xa0,
+    0xd1, 0x0b, 0xfd, 0x66, 0x49, 0x92, 0xb3, 0x68, 0x0d, 0xb9, 0x16, 0x08,
+    0x80, 0xb1, 0xf2, 0x95, 0xd1, 0x17, 0x42, 0x07, 0x40, 0xb2, 0x74, 0x04,
+    0x13, 0x05, 0x49,
+};
+
+static const unsigned char trust_store_root_05[484] = {
+    0x30, 0x82, 0x01, 0xe0, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x05, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x35, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x35, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x46, 0xb1, 0xba, 0xee, 0xd7, 0xa8, 0xd9, 0x1e, 0xcd, 0x0a, 0xe6,
+    0x9c, 0x14, 0xf8, 0x8c, 0x85, 0x54, 0x94, 0x46, 0x65, 0xa3, 0xe0, 0x2c,
+    0x67, 0xeb, 0xaa, 0x94, 0xbf, 0x0e, 0x26, 0x58, 0x4d, 0x38, 0xf1, 0x1c,
+    0x92, 0x6a, 0xf2, 0xe4, 0x5c, 0xcd, 0xfb, 0x8c, 0xf8, 0x40, 0xcb, 0xe1,
+    0x37, 0xaf, 0xdb, 0xbd, 0x0d, 0xb2, 0xab, 0x26, 0x20, 0x6b, 0xf7, 0x95,
+    0xe7, 0x90, 0xa8, 0x0c, 0xc7, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x77, 0x8d, 0x93, 0x7e, 0x35, 0x17, 0x0f,
+    0x45, 0xbe, 0x41, 0x8d, 0x35, 0x77, 0x5c, 0xf8, 0x78, 0x48, 0x72, 0xcc,
+    0x20, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0xf9, 0x98, 0x80,
+    0x12, 0x2d, 0x30, 0x0e, 0x03, 0xde, 0xbf, 0x77, 0xe0, 0xe0, 0x4e, 0x2e,
+    0x0c, 0x63, 0x5d, 0x81, 0xac, 0x6b, 0x6c, 0xa6, 0x95, 0xe9, 0x32, 0x52,
+    0x56, 0x52, 0xa7, 0x13, 0x15, 0x02, 0x21, 0x00, 0xc2, 0x50, 0xd8, 0x37,
+    0xd1, 0xbf, 0x7c, 0x92, 0xb8, 0xc1, 0x6d, 0xb7, 0x34, 0xe8, 0x5b, 0x33,
+    0x25, 0xa4, 0x7f, 0x10, 0xb1, 0xf9, 0x11, 0x58, 0xc3, 0xa1, 0xa3, 0x53,
+    0x1e, 0x61, 0x87, 0x4b,
+};
+
+static const unsigned char trust_store_root_06[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x06, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x36, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x36, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x11, 0xed, 0x2d, 0xd6, 0x9b, 0x2d, 0x53, 0x0c, 0xd9, 0x3d, 0x7c,
+    0x92, 0xfc, 0xcf, 0xdf, 0x8f, 0x66, 0x28, 0x85, 0x50, 0x9e, 0x29, 0x9a,
+    0xb2, 0x35, 0x68, 0x62, 0xfb, 0xc2, 0xc5, 0x14, 0x5d, 0xac, 0x59, 0x73,
+    0xe2, 0x9c, 0x4a, 0xd9, 0x5d, 0x43, 0x75, 0x67, 0x16, 0x9e, 0x4b, 0xd0,
+    0x58, 0x4c, 0x57, 0xdf, 0xe2, 0xe3, 0x87, 0xc9, 0xc8, 0x9f, 0x29, 0x95,
+    0x71, 0x1d, 0xa7, 0x6a, 0x09, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x93, 0x5c, 0xfb, 0x3e, 0xb4, 0xc5, 0x17,
+    0x1c, 0x97, 0x53, 0x9e, 0x7b, 0x5c, 0x63, 0x05, 0xb0, 0xdd, 0x2c, 0x3d,
+    0xf3, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x20, 0x65, 0xa8, 0x6f, 0xa9,
+    0x9d, 0x15, 0x8b, 0x21, 0xb1, 0xb7, 0xf5, 0x7f, 0x17, 0x7e, 0x6a, 0x35,
+    0x3d, 0xac, 0xe1, 0x73, 0x2a, 0x57, 0xfa, 0xa2, 0xd8, 0xf8, 0x11, 0xe5,
+    0x94, 0x80, 0x79, 0x51, 0x02, 0x21, 0x00, 0xcb, 0x67, 0xb6, 0x2b, 0x52,
+    0x98, 0x30, 0x42, 0x2d, 0xab, 0x23, 0x07, 0x9f, 0x54, 0xf8, 0x57, 0x45,
+    0xde, 0x11, 0xa9, 0x01, 0x33, 0x4c, 0x12, 0xc9, 0x50, 0x60, 0x6f, 0x74,
+    0x5f, 0x7d, 0xc5,
+};
+
+static const unsigned char trust_store_root_07[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x07, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x37, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x37, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x8d, 0xef, 0xed, 0xce, 0x21, 0x5d, 0x33, 0xc4, 0x8c, 0xc7, 0x88,
+    0x46, 0x58, 0x2e, 0x19, 0xeb, 0x77, 0x0d, 0x6e, 0x49, 0x0d, 0x71, 0x3a,
+    0x3f, 0x45, 0xb8, 0x7e, 0xec, 0x7c, 0xbe, 0xa4, 0x9e, 0xe9, 0x61, 0x0c,
+    0x92, 0x12, 0x51, 0xfc, 0x33, 0xe2, 0x08, 0xa2, 0xe0, 0xc8, 0xa5, 0xaa,
+    0xcd, 0x72, 0xcc, 0x9e, 0x77, 0x0c, 0xd7, 0x67, 0xcc, 0x56, 0x71, 0x03,
+    0xc2, 0xc3, 0x25, 0x9e, 0xdf, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xd5, 0x4d, 0x6a, 0xae, 0xf7, 0xf9, 0x55,
+    0x55, 0x04, 0xe1, 0xe9, 0x91, 0x46, 0xf2, 0xfd, 0x9e, 0x3a, 0x08, 0x01,
+    0x83, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0xce, 0xc1, 0xe2,
+    0x6d, 0x5d, 0x4a, 0x2c, 0x74, 0x0a, 0xa8, 0xe2, 0x26, 0xfd, 0x59, 0x42,
+    0x47, 0x66, 0xa9, 0x84, 0x5a, 0x8d, 0x36, 0x80, 0xf5, 0x27, 0xc7, 0x64,
+    0xd9, 0xde, 0xe9, 0xb7, 0xce, 0x02, 0x20, 0x20, 0xad, 0x28, 0xbe, 0x2e,
+    0xef, 0x9c, 0xb9, 0xb7, 0x93, 0xb0, 0x85, 0x88, 0x5d, 0xb3, 0x75, 0xef,
+    0xea, 0xed, 0xe1, 0x9a, 0x13, 0x23, 0x56, 0xbb, 0x56, 0x76, 0xff, 0xd3,
+    0x33, 0x4c, 0xb5,
+};
+
+static const unsigned char trust_store_root_08[484] = {
+    0x30, 0x82, 0x01, 0xe0, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x08, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x38, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x38, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x8e, 0xbd, 0x9e, 0x8f, 0x2f, 0xf0, 0x83, 0xeb, 0xc6, 0x38, 0x5e,
+    0x4f, 0x46, 0x9a, 0xb3, 0x52, 0x06, 0xf2, 0xac, 0x6f, 0x2f, 0x52, 0x50,
+    0xc4, 0xc1, 0x59, 0xf5, 0x34, 0x1b, 0x25, 0x0e, 0xfd, 0x92, 0x86, 0x65,
+    0x25, 0x52, 0x84, 0x8a, 0xeb, 0x1a, 0xab, 0x4b, 0x4a, 0x1f, 0xb8, 0x9b,
+    0xb8, 0x97, 0x8a, 0xe5, 0x02, 0x0b, 0x45, 0xd8, 0x59, 0x7c, 0x87, 0x6b,
+    0x96, 0x00, 0xda, 0x68, 0x0a, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x37, 0xc8, 0x33, 0x01, 0x6c, 0x76, 0x01,
+    0xc2, 0xaf, 0x5c, 0x33, 0x92, 0x81, 0x58, 0xa7, 0x65, 0x74, 0x90, 0x7b,
+    0x71, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0xdc, 0x58, 0xf1,
+    0xf6, 0x5f, 0xf3, 0x0d, 0xf6, 0xd9, 0x4a, 0x51, 0x74, 0xd4, 0x84, 0xd0,
+    0xfe, 0x9e, 0x6d, 0xf2, 0x88, 0x41, 0xb5, 0xde, 0xb3, 0x0f, 0x37, 0xc1,
+    0x28, 0x6a, 0x97, 0x07, 0x0a, 0x02, 0x21, 0x00, 0xe2, 0x66, 0xa2, 0x00,
+    0x07, 0xee, 0x75, 0x5d, 0x01, 0xc8, 0x25, 0xf2, 0x99, 0x13, 0xfc, 0x1a,
+    0xee, 0xb2, 0xed, 0x24, 0x5a, 0x83, 0x34, 0x42, 0x0f, 0x32, 0x10, 0x73,
+    0x56, 0x23, 0xe9, 0x55,
+};
+
+static const unsigned char trust_store_root_09[482] = {
+    0x30, 0x82, 0x01, 0xde, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x09, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x39, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x30, 0x39, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0xab, 0x8c, 0x81, 0x74, 0xe5, 0x0d, 0xa7, 0xab, 0x98, 0x59, 0x57,
+    0x21, 0xde, 0x8c, 0xc9, 0xaa, 0xaf, 0x5f, 0xef, 0x8d, 0x32, 0x8c, 0x80,
+    0x2e, 0xcf, 0x89, 0x8b, 0x60, 0x59, 0xb7, 0xaf, 0x7f, 0xb0, 0xbd, 0x15,
+    0x80, 0x89, 0x63, 0x2d, 0x0c, 0xd3, 0xd4, 0xad, 0x06, 0x2d, 0x67, 0x10,
+    0x07, 0x1d, 0x79, 0x02, 0x8b, 0x89, 0x90, 0x66, 0xee, 0x25, 0x00, 0xb5,
+    0xea, 0xff, 0x07, 0xd4, 0x27, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xed, 0x10, 0xe8, 0x55, 0x58, 0xb0, 0x3a,
+    0x8c, 0xbb, 0x6f, 0x4f, 0x16, 0xef, 0x2b, 0xeb, 0x93, 0x23, 0xfa, 0x4a,
+    0x01, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x47, 0x00, 0x30, 0x44, 0x02, 0x20, 0x29, 0xae, 0xf0, 0x51,
+    0x67, 0x6b, 0xa1, 0x95, 0x66, 0x3d, 0xe5, 0xe0, 0x69, 0x73, 0x30, 0x4d,
+    0x2e, 0x77, 0x1d, 0x29, 0x13, 0xca, 0x4e, 0x47, 0xf0, 0x5e, 0x11, 0x3b,
+    0x15, 0x98, 0x10, 0x66, 0x02, 0x20, 0x73, 0x0b, 0x6a, 0xe8, 0xdc, 0x5f,
+    0x7d, 0xec, 0xaa, 0x99, 0xc5, 0x31, 0x16, 0x68, 0x54, 0x8d, 0x1c, 0xc3,
+    0x94, 0x25, 0x0d, 0xdb, 0xc4, 0x05, 0xe1, 0x81, 0xe2, 0x95, 0xfe, 0x70,
+    0x69, 0x2b,
+};
+
+static const unsigned char trust_store_root_10[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x0a, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x30, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x30, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0xcd, 0xd8, 0xf2, 0x13, 0xc9, 0x55, 0x18, 0x39, 0x08, 0xba, 0xf0,
+    0xb2, 0xcc, 0xa5, 0x62, 0x3b, 0xd8, 0x03, 0xeb, 0x18, 0x5c, 0x79, 0x7d,
+    0x18, 0x16, 0x28, 0xe1, 0x61, 0x53, 0x85, 0x28, 0xfa, 0x2a, 0x8f, 0x7c,
+    0xf7, 0xe5, 0x77, 0x56, 0x18, 0x1a, 0x07, 0xfc, 0xf9, 0x06, 0xc7, 0xb3,
+    0x54, 0x81, 0xa3, 0x5d, 0x30, 0xd1, 0x29, 0x57, 0x3b, 0x7d, 0xe8, 0x1d,
+    0x9e, 0xa5, 0x41, 0xdc, 0x17, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x2d, 0xfd, 0x37, 0x3e, 0x79, 0xd1, 0x51,
+    0x5a, 0x68, 0x29, 0x85, 0xae, 0xfe, 0x77, 0x4e, 0x3f, 0xb5, 0x2b, 0x77,
+    0x9f, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x20, 0x2d, 0x99, 0x3b, 0xd1,
+    0x81, 0x7a, 0x6c, 0xdb, 0x2e, 0xa9, 0x3b, 0xe4, 0x6e, 0xd8, 0xad, 0x42,
+    0xb1, 0x6d, 0x6c, 0xe4, 0xb2, 0x7e, 0xa2, 0x67, 0x33, 0xc4, 0x26, 0xe5,
+    0xba, 0x97, 0xd7, 0x9d, 0x02, 0x21, 0x00, 0xff, 0x74, 0x97, 0x60, 0x8e,
+    0x4d, 0x40, 0x42, 0x3b, 0x85, 0x04, 0xf5, 0x9b, 0x38, 0xe1, 0xac, 0x7b,
+    0x84, 0x21, 0xd5, 0x77, 0x2e, 0xf2, 0xb0, 0xca, 0xc0, 0x7b, 0x31, 0xae,
+    0x0e, 0xe7, 0x33,
+};
+
+static const unsigned char trust_store_root_11[484] = {
+    0x30, 0x82, 0x01, 0xe0, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x0b, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x31, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x31, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x6d, 0xa9, 0xe0, 0x29, 0x13, 0x7c, 0x46, 0xea, 0x9d, 0xf0, 0xbe,
+    0xcc, 0xbe, 0x1c, 0xda, 0xb4, 0x2a, 0xa4, 0x8b, 0x3f, 0xe7, 0xbc, 0x77,
+    0x5d, 0x8a, 0x1f, 0xc1, 0x33, 0x67, 0x64, 0x24, 0x31, 0xbb, 0xf7, 0x5f,
+    0x29, 0xeb, 0xcf, 0x16, 0x8e, 0x29, 0x1e, 0x9e, 0x90, 0xee, 0x2c, 0x1d,
+    0xc3, 0x95, 0x66, 0x35, 0x7a, 0x0a, 0x33, 0xca, 0x1c, 0x4d, 0x8f, 0xb6,
+    0x30, 0x7f, 0xdd, 0x64, 0xfe, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xda, 0x47, 0xce, 0x87, 0x20, 0x86, 0x86,
+    0x33, 0x26, 0x20, 0x33, 0x32, 0x5f, 0xc9, 0xa4, 0xe8, 0x95, 0xa3, 0x88,
+    0xa2, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0x99, 0x95, 0x4d,
+    0xac, 0x8f, 0x4e, 0x40, 0x81, 0xdb, 0x13, 0x63, 0x15, 0xbb, 0x20, 0xd9,
+    0x0d, 0xd3, 0x43, 0x1b, 0x61, 0xe5, 0x81, 0xfb, 0x9f, 0x4e, 0x66, 0xb1,
+    0xf3, 0x55, 0xcd, 0x04, 0xac, 0x02, 0x21, 0x00, 0xc5, 0x0c, 0x58, 0xa5,
+    0xf5, 0xed, 0x3b, 0x50, 0x3e, 0xed, 0x55, 0xcf, 0xbc, 0x6a, 0x40, 0x4b,
+    0xfd, 0x84, 0x8e, 0x7f, 0x2a, 0x99, 0xb9, 0x27, 0x9e, 0xf3, 0xd2, 0xd4,
+    0x4e, 0x7e, 0x4a, 0x2b,
+};
+
+static const unsigned char trust_store_root_12[482] = {
+    0x30, 0x82, 0x01, 0xde, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x0c, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x32, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x32, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0xd2, 0xbc, 0xdf, 0x0a, 0x69, 0x1b, 0x1c, 0x85, 0x49, 0xa7, 0xc6,
+    0x6b, 0x89, 0xa1, 0xdc, 0x6e, 0x20, 0xc0, 0x1e, 0x24, 0xf9, 0x48, 0xfc,
+    0xee, 0xe9, 0x65, 0x66, 0x64, 0xeb, 0x4d, 0xdd, 0xa7, 0xe1, 0xaa, 0x0a,
+    0xde, 0xc4, 0xf9, 0x80, 0x12, 0x80, 0x5f, 0x04, 0x47, 0x2d, 0x41, 0x06,
+    0x15, 0x0f, 0x22, 0x0e, 0xc9, 0x63, 0x06, 0x54, 0x2f, 0xc7, 0x81, 0x45,
+    0x07, 0x8f, 0x1f, 0x53, 0x2d, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xb2, 0xb1, 0x6d, 0xaa, 0x0b, 0x32, 0xc8,
+    0xe8, 0x2e, 0x6e, 0x58, 0x19, 0xf5, 0x8a, 0x29, 0x71, 0x83, 0x3d, 0x84,
+    0x7a, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x47, 0x00, 0x30, 0x44, 0x02, 0x20, 0x7b, 0x2d, 0x9f, 0x80,
+    0xfa, 0xcb, 0xc3, 0x21, 0xa2, 0x83, 0xd0, 0xe5, 0x76, 0x74, 0x43, 0x12,
+    0x78, 0xea, 0xd6, 0xd7, 0xcf, 0xd7, 0xc5, 0xfa, 0x67, 0x06, 0xd5, 0x12,
+    0x33, 0xba, 0xdd, 0x48, 0x02, 0x20, 0x62, 0xe1, 0xb2, 0x54, 0x2b, 0xda,
+    0xe4, 0x4e, 0x91, 0x34, 0x4a, 0xca, 0xef, 0x4c, 0xd2, 0xda, 0xa2, 0x4e,
+    0x60, 0x66, 0xcc, 0xa1, 0xc1, 0xb6, 0x5b, 0xe4, 0x68, 0x1b, 0x63, 0x22,
+    0xc6, 0x3d,
+};
+
+static const unsigned char trust_store_root_13[484] = {
+    0x30, 0x82, 0x01, 0xe0, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x0d, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x33, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x33, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x31, 0x60, 0x1e, 0x59, 0x02, 0xcc, 0x0b, 0x84, 0x9f, 0x59, 0x7e,
+    0x75, 0x72, 0x5b, 0x8f, 0xfc, 0xf6, 0x4d, 0xd7, 0xc0, 0x94, 0xbf, 0x21,
+    0xbc, 0xb3, 0xf7, 0xca, 0xb0, 0x0c, 0xc1, 0x37, 0xc3, 0x9f, 0x2d, 0x4d,
+    0x2e, 0x54, 0x3c, 0x89, 0x55, 0xf8, 0x08, 0x50, 0x0a, 0x2f, 0xf6, 0x3a,
+    0x91, 0x81, 0x7b, 0x2e, 0xe4, 0x74, 0x63, 0x26, 0xc7, 0x23, 0x5b, 0x78,
+    0x91, 0x52, 0x1e, 0x71, 0x5c, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x5c, 0x33, 0x38, 0x4b, 0x35, 0xc4, 0xb6,
+    0x96, 0x24, 0x51, 0x81, 0xec, 0x98, 0x36, 0x3a, 0x1f, 0xc8, 0xef, 0xc3,
+    0x5a, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0xff, 0x80, 0x54,
+    0x24, 0x78, 0x0c, 0xfb, 0xbb, 0xcb, 0xf8, 0x81, 0x59, 0xbe, 0x1a, 0x85,
+    0x74, 0x2f, 0x96, 0xc1, 0x6b, 0xfe, 0x28, 0x3a, 0xed, 0x4d, 0x8d, 0xa1,
+    0xa1, 0xbb, 0xd3, 0x74, 0x78, 0x02, 0x21, 0x00, 0x94, 0x3e, 0x30, 0xd4,
+    0xbc, 0xa8, 0x06, 0x7f, 0x51, 0x07, 0x68, 0xf2, 0xf7, 0xe0, 0x16, 0x98,
+    0xe6, 0x07, 0xe7, 0x38, 0x53, 0xfc, 0xe5, 0xf0, 0xc3, 0x3c, 0x19, 0x60,
+    0x58, 0x35, 0x20, 0xc8,
+};
+
+static const unsigned char trust_store_root_14[484] = {
+    0x30, 0x82, 0x01, 0xe0, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x0e, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x34, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x34, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x09, 0xbf, 0x9f, 0xa2, 0x0a, 0x34, 0x42, 0xeb, 0xd0, 0x88, 0x65,
+    0xc0, 0x5f, 0x75, 0x41, 0x7a, 0x6d, 0xad, 0x52, 0x36, 0x8e, 0x73, 0x71,
+    0x6d, 0xac, 0x7a, 0xcf, 0x03, 0x9f, 0xb3, 0xde, 0xbb, 0xcd, 0x7f, 0x29,
+    0x5f, 0xc8, 0xa9, 0x88, 0x89, 0x35, 0xb4, 0x77, 0x72, 0x7f, 0xfe, 0x00,
+    0x2e, 0xfb, 0xd6, 0x59, 0x5b, 0x00, 0x7e, 0x4a, 0x18, 0x86, 0x36, 0x77,
+    0x3d, 0x73, 0xdd, 0x36, 0xc3, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x4c, 0x67, 0xa0, 0xa5, 0x45, 0xb4, 0xe5,
+    0xf6, 0x5a, 0x32, 0x80, 0xbd, 0x7f, 0xc9, 0xe4, 0x31, 0x89, 0x8a, 0xa9,
+    0x4e, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0x95, 0xb3, 0x02,
+    0x24, 0x67, 0x3c, 0x9f, 0xdb, 0x69, 0xee, 0x1d, 0x53, 0xf8, 0xb6, 0x81,
+    0xa8, 0xdb, 0x6c, 0xc0, 0xc7, 0x12, 0xa8, 0x71, 0xb7, 0x16, 0x83, 0xae,
+    0x97, 0xf1, 0xba, 0x18, 0x8f, 0x02, 0x21, 0x00, 0xb7, 0xa4, 0x9e, 0x7b,
+    0x00, 0x37, 0x05, 0x32, 0xd8, 0x1b, 0x79, 0xe5, 0x21, 0x07, 0x99, 0xaf,
+    0x5d, 0x28, 0x68, 0x22, 0xb0, 0x73, 0xc5, 0x17, 0xae, 0xa6, 0x08, 0x56,
+    0x3c, 0x4e, 0x05, 0x9c,
+};
+
+static const unsigned char trust_store_root_15[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x0f, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x35, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x35, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0xfd, 0x46, 0xdb, 0xb9, 0x7f, 0x57, 0x37, 0xa5, 0x57, 0x8c, 0x44,
+    0x33, 0x58, 0x44, 0x35, 0xec, 0x3e, 0xd8, 0x08, 0x1b, 0xd8, 0x37, 0xbd,
+    0x6e, 0x92, 0x1d, 0x8e, 0x4f, 0x40, 0x97, 0x3e, 0xca, 0x77, 0x26, 0x16,
+    0x33, 0xc5, 0xd7, 0x80, 0xab, 0xce, 0x4c, 0x7e, 0x70, 0x24, 0x2c, 0xf9,
+    0x46, 0x54, 0x58, 0x55, 0xa5, 0xb3, 0xad, 0x83, 0xab, 0xd1, 0x3c, 0x98,
+    0xf8, 0xee, 0xf8, 0x6b, 0xd4, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xc5, 0x51, 0x42, 0xb5, 0x25, 0xb8, 0xd0,
+    0x89, 0xb6, 0xaf, 0xca, 0xc4, 0x5b, 0xdd, 0x80, 0x7f, 0x4e, 0xd9, 0x2a,
+    0xa1, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0xba, 0xdd, 0x76,
+    0x46, 0xef, 0xe5, 0xf7, 0xdc, 0x0d, 0x39, 0x09, 0xc9, 0x23, 0x8c, 0x83,
+    0x74, 0x47, 0x55, 0x4e, 0x81, 0xf2, 0xa7, 0xc6, 0xf8, 0xc5, 0x24, 0x48,
+    0xd9, 0x79, 0x7a, 0x45, 0x47, 0x02, 0x20, 0x0b, 0xe2, 0xf9, 0x02, 0x81,
+    0x01, 0x09, 0x85, 0x81, 0xc3, 0x77, 0x7d, 0x19, 0x18, 0xe1, 0xb3, 0x7f,
+    0x2d, 0x7d, 0x21, 0xeb, 0xf4, 0x1f, 0x80, 0xfb, 0xe9, 0x57, 0x6a, 0x8f,
+    0x2c, 0x61, 0x98,
+};
+
+static const unsigned char trust_store_root_16[484] = {
+    0x30, 0x82, 0x01, 0xe0, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x10, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x36, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x36, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x05, 0x37, 0x86, 0xd0, 0xdd, 0xe8, 0x28, 0x50, 0x99, 0xcd, 0x6b,
+    0x09, 0xd6, 0x2e, 0x11, 0x56, 0x8e, 0xe3, 0x3e, 0x05, 0x65, 0x40, 0x51,
+    0x66, 0xb5, 0x70, 0x2e, 0xec, 0xab, 0x08, 0xe3, 0x5a, 0xad, 0x24, 0xcc,
+    0xd9, 0xe0, 0xea, 0xbd, 0x66, 0x1f, 0xe9, 0x73, 0x9b, 0x37, 0x47, 0x91,
+    0x8e, 0xc2, 0x80, 0xbe, 0xd0, 0xc9, 0x26, 0xcd, 0xb3, 0x6f, 0x07, 0x3b,
+    0xb6, 0xdf, 0x9b, 0x61, 0xe4, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x13, 0x4b, 0xba, 0x20, 0xe9, 0x17, 0xbf,
+    0xd8, 0x0c, 0xe9, 0xf4, 0xdc, 0x34, 0x9d, 0x90, 0x9e, 0x71, 0xd8, 0x59,
+    0x39, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0x8d, 0xfc, 0x41,
+    0x92, 0x15, 0xda, 0x8a, 0x25, 0x98, 0x26, 0xd2, 0x44, 0x5e, 0x4b, 0xa5,
+    0x35, 0x25, 0xa3, 0xc5, 0x3e, 0x13, 0xb0, 0xa0, 0xd9, 0x96, 0x32, 0xe3,
+    0x2b, 0xac, 0x40, 0xac, 0x79, 0x02, 0x21, 0x00, 0xe5, 0x4c, 0xb6, 0x40,
+    0x53, 0x18, 0x35, 0xe1, 0xd5, 0xf2, 0xfd, 0x79, 0xd2, 0x85, 0x24, 0x91,
+    0x55, 0xd4, 0xfb, 0x44, 0x4e, 0xfa, 0x5f, 0x8c, 0x82, 0xab, 0x24, 0x72,
+    0x38, 0xd8, 0x42, 0x65,
+};
+
+static const unsigned char trust_store_root_17[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x11, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x37, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x37, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0xed, 0x8e, 0x97, 0x6f, 0x76, 0x96, 0x7e, 0xf8, 0x7d, 0x9d, 0x29,
+    0xbc, 0x3d, 0x0b, 0x7e, 0xc2, 0x34, 0xc4, 0x0e, 0x72, 0xb2, 0x58, 0x3a,
+    0x0e, 0x93, 0xf2, 0x50, 0x70, 0x2e, 0x21, 0x7f, 0x54, 0xba, 0xee, 0x59,
+    0xb2, 0x85, 0xf5, 0x87, 0xad, 0xe4, 0x2c, 0x21, 0x32, 0xa2, 0x7f, 0x14,
+    0x83, 0x48, 0xe5, 0x42, 0x19, 0x68, 0x33, 0x36, 0x53, 0xff, 0x3a, 0x7c,
+    0x3e, 0x72, 0xfc, 0x93, 0xc4, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xbe, 0x5f, 0xea, 0x5f, 0x9c, 0xbc, 0x76,
+    0x40, 0xb5, 0xd0, 0x88, 0x6c, 0x83, 0xc2, 0x6b, 0xee, 0xce, 0x98, 0xa7,
+    0x61, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x20, 0x54, 0x32, 0x84, 0x0d,
+    0x81, 0x1a, 0xc8, 0xe7, 0xd1, 0x9d, 0x6e, 0xd2, 0x11, 0x78, 0x6b, 0x74,
+    0xf3, 0xef, 0x54, 0x5d, 0x21, 0x9d, 0xcc, 0x1d, 0x5a, 0xe0, 0x78, 0x91,
+    0x27, 0xa2, 0x60, 0x4a, 0x02, 0x21, 0x00, 0xb3, 0x0d, 0x73, 0x19, 0x78,
+    0x95, 0x7e, 0x68, 0x80, 0x27, 0xda, 0xe9, 0x12, 0x61, 0xed, 0xb3, 0xd9,
+    0x9c, 0xe0, 0x62, 0x47, 0x48, 0x35, 0xa8, 0x78, 0x4a, 0xfe, 0x9e, 0x70,
+    0x0f, 0x52, 0x06,
+};
+
+static const unsigned char trust_store_root_18[482] = {
+    0x30, 0x82, 0x01, 0xde, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x12, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x38, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x38, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x5f, 0x30, 0x38, 0xcd, 0x80, 0x38, 0x2a, 0x1b, 0xd8, 0x7d, 0x04,
+    0xa0, 0x29, 0xa3, 0xa7, 0x26, 0x51, 0x6c, 0x26, 0x5d, 0x10, 0x57, 0x22,
+    0x09, 0x2e, 0xa5, 0xe1, 0xe1, 0x93, 0x2b, 0xdc, 0xa7, 0x85, 0xc8, 0x0f,
+    0xa8, 0x6b, 0x0e, 0x6d, 0xc8, 0xe4, 0x89, 0xdf, 0x5a, 0x7b, 0x24, 0x0a,
+    0x21, 0xbf, 0x44, 0x9b, 0x52, 0xa0, 0xa3, 0x2e, 0xd3, 0x8f, 0xe2, 0xdb,
+    0xa8, 0x24, 0x45, 0xe0, 0x08, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x34, 0xd1, 0x2a, 0xcc, 0x75, 0xa7, 0x7e,
+    0xb0, 0x4d, 0x5c, 0x97, 0xef, 0x44, 0x92, 0xda, 0xe8, 0x68, 0x86, 0x63,
+    0x45, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x47, 0x00, 0x30, 0x44, 0x02, 0x20, 0x47, 0xc7, 0x5d, 0xfa,
+    0xb2, 0xe4, 0x3f, 0xe3, 0x4a, 0x6d, 0x6b, 0x8b, 0xf7, 0x4e, 0x73, 0x0a,
+    0xc9, 0x9a, 0x6c, 0x06, 0x79, 0xcf, 0x62, 0xbc, 0x7c, 0x20, 0xa5, 0xc0,
+    0x13, 0xec, 0xcd, 0xcb, 0x02, 0x20, 0x58, 0xd6, 0xa1, 0xd3, 0xf7, 0xcb,
+    0x86, 0xc7, 0xd7, 0x70, 0x15, 0x08, 0xc6, 0xa2, 0x65, 0xe0, 0x51, 0x86,
+    0xf4, 0xbb, 0x31, 0x1d, 0x06, 0xaf, 0x22, 0x73, 0x80, 0x5a, 0x61, 0x84,
+    0xc7, 0x7c,
+};
+
+static const unsigned char trust_store_root_19[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x13, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x39, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x31, 0x39, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x7a, 0xc1, 0x70, 0xc5, 0x67, 0x41, 0x51, 0x41, 0x65, 0x15, 0xd1,
+    0x06, 0xfd, 0x51, 0x35, 0xd8, 0xcd, 0x0d, 0x13, 0xcc, 0x2d, 0xf6, 0xe6,
+    0x6e, 0xc1, 0x11, 0x7e, 0x7f, 0xc9, 0x2e, 0x99, 0x51, 0x0f, 0xce, 0x8c,
+    0x4f, 0x41, 0x16, 0x2e, 0x3c, 0x39, 0xac, 0xc3, 0x6c, 0xb0, 0xa3, 0xed,
+    0x45, 0x38, 0xac, 0x96, 0x2b, 0xfa, 0xb6, 0xf2, 0x4c, 0x15, 0x7c, 0x92,
+    0x2e, 0x9c, 0x53, 0xb6, 0x13, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xda, 0xa3, 0xe3, 0xe2, 0xae, 0xfc, 0x4e,
+    0xbd, 0x04, 0x08, 0xb8, 0x53, 0xd3, 0xd5, 0xce, 0x1e, 0x73, 0xb0, 0xcd,
+    0x5a, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0xe5, 0x8f, 0x50,
+    0xf5, 0x06, 0xb2, 0x25, 0xa3, 0xdb, 0xb3, 0x03, 0x1a, 0xce, 0x2e, 0x68,
+    0x2f, 0x6b, 0x81, 0x65, 0x68, 0x4b, 0x1a, 0x13, 0x47, 0x13, 0xda, 0xf6,
+    0x3c, 0xb9, 0x72, 0xdd, 0x30, 0x02, 0x20, 0x23, 0x54, 0x60, 0x54, 0xb4,
+    0xa5, 0xab, 0x36, 0x58, 0x95, 0x86, 0x6d, 0x0f, 0x27, 0xb7, 0x1d, 0x12,
+    0x99, 0x82, 0x7a, 0x67, 0x99, 0x6f, 0x13, 0x18, 0x21, 0x1e, 0xf8, 0x16,
+    0xd1, 0xe6, 0x82,
+};
+
+static const unsigned char trust_store_root_20[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x14, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x30, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x30, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0xce, 0x52, 0xb0, 0x43, 0x6f, 0xaf, 0xc3, 0x04, 0xcf, 0x41, 0x40,
+    0x86, 0x3b, 0xc5, 0x90, 0xe0, 0x8e, 0x9e, 0xb1, 0xd1, 0x7d, 0x27, 0x1c,
+    0xa7, 0xb7, 0x14, 0xb7, 0x86, 0x25, 0xc3, 0x96, 0xa7, 0x1b, 0xb7, 0x5d,
+    0x35, 0xac, 0xfc, 0x1e, 0x54, 0x0b, 0x94, 0x16, 0x60, 0x66, 0x37, 0x05,
+    0x9a, 0x5a, 0x5c, 0xc8, 0xad, 0xeb, 0xc3, 0x7d, 0x45, 0xea, 0x08, 0x9a,
+    0x7f, 0xbc, 0xc8, 0x5d, 0xbc, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x50, 0x60, 0xae, 0x1a, 0xfd, 0x7f, 0xd5,
+    0x68, 0xb9, 0xd8, 0xb9, 0x0f, 0x52, 0x30, 0xd2, 0x4d, 0xa6, 0xcf, 0xb5,
+    0x93, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0xa8, 0x41, 0xaa,
+    0x11, 0xc9, 0x54, 0x01, 0x00, 0xb5, 0x95, 0xf0, 0x21, 0x8a, 0x99, 0xc3,
+    0xed, 0xc0, 0x00, 0x30, 0x5a, 0x7c, 0x9a, 0xb0, 0x78, 0x08, 0xa9, 0x89,
+    0x92, 0x88, 0x75, 0x0e, 0xca, 0x02, 0x20, 0x54, 0x04, 0x49, 0x5e, 0x52,
+    0xaa, 0xc2, 0x9b, 0x42, 0x19, 0x27, 0x4a, 0x4a, 0xeb, 0x17, 0xca, 0xe7,
+    0x21, 0x0a, 0x31, 0x3b, 0x5a, 0x6e, 0xbe, 0x3d, 0x0d, 0x5f, 0x33, 0xa6,
+    0x2f, 0x75, 0xbf,
+};
+
+static const unsigned char trust_store_root_21[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x15, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x31, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x31, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0xec, 0xdd, 0x67, 0xac, 0x3b, 0xcf, 0x41, 0x20, 0x77, 0x42, 0x1b,
+    0x3b, 0x3e, 0xfb, 0x7f, 0x37, 0x4c, 0x2b, 0x77, 0x79, 0x16, 0x25, 0xb0,
+    0x18, 0x40, 0x13, 0xd8, 0xf3, 0x00, 0x26, 0xfe, 0xc6, 0xff, 0xe9, 0x6a,
+    0xdb, 0x9f, 0x00, 0x08, 0x1c, 0x39, 0x4e, 0xd0, 0x86, 0xf5, 0x9f, 0x9d,
+    0xaf, 0x8c, 0xd4, 0x5d, 0xfe, 0x02, 0x99, 0x3c, 0x2a, 0x16, 0x3c, 0x8f,
+    0x3b, 0xe5, 0xe7, 0x8b, 0x78, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xe8, 0x09, 0xaf, 0xf7, 0x6a, 0xb1, 0xe4,
+    0x2f, 0x13, 0x85, 0xb5, 0x1b, 0x43, 0x52, 0x53, 0x9e, 0x65, 0x61, 0xd3,
+    0xfd, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0xa0, 0xe2, 0x11,
+    0x8d, 0x9b, 0x67, 0x2f, 0x84, 0x1c, 0xa6, 0x71, 0x6d, 0x7b, 0x05, 0x78,
+    0x60, 0x30, 0xd8, 0x02, 0x35, 0xcb, 0xfb, 0xb7, 0x63, 0x5c, 0x42, 0x02,
+    0xd4, 0xce, 0x8a, 0x86, 0x43, 0x02, 0x20, 0x68, 0x14, 0x80, 0x52, 0x15,
+    0x94, 0x86, 0xee, 0x84, 0xcc, 0x86, 0x65, 0xe2, 0xd6, 0xf1, 0x80, 0xdd,
+    0x29, 0x15, 0x24, 0xdb, 0xf7, 0xdc, 0x9f, 0x5f, 0x5a, 0x5e, 0x22, 0xb3,
+    0xe8, 0xee, 0x53,
+};
+
+static const unsigned char trust_store_root_22[484] = {
+    0x30, 0x82, 0x01, 0xe0, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x16, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x32, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x32, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x04, 0x25, 0xf2, 0xa5, 0x29, 0xc3, 0x4e, 0x02, 0x8e, 0xab, 0x45,
+    0x71, 0x6b, 0xf4, 0x4f, 0xf2, 0x2f, 0xdf, 0x57, 0xcd, 0x4b, 0x37, 0xb9,
+    0x03, 0x78, 0x7c, 0x2a, 0xf5, 0xe5, 0x33, 0xc2, 0xeb, 0x91, 0x34, 0x12,
+    0x01, 0x38, 0xff, 0x19, 0xd7, 0x25, 0xa7, 0xbb, 0x08, 0xcc, 0x1b, 0xcf,
+    0x14, 0xa6, 0xb9, 0xe1, 0x2d, 0xb0, 0x15, 0xea, 0x01, 0x65, 0x92, 0x1e,
+    0x06, 0x3e, 0x48, 0x7a, 0x1e, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xa3, 0xfb, 0xc4, 0x46, 0x0d, 0x45, 0x0f,
+    0x32, 0xba, 0x9b, 0x24, 0x3a, 0x39, 0x0c, 0xf5, 0x20, 0x1e, 0x13, 0x06,
+    0xde, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0x9d, 0x00, 0x4d,
+    0x5d, 0x21, 0xcc, 0x2b, 0x9e, 0xf4, 0xa8, 0x3b, 0xcd, 0xa7, 0xf8, 0x8a,
+    0x1a, 0x17, 0x18, 0x04, 0xc8, 0x47, 0xd8, 0xb1, 0xaa, 0xe3, 0x91, 0x0e,
+    0xb6, 0x53, 0x3c, 0xcc, 0xa5, 0x02, 0x21, 0x00, 0xd5, 0xef, 0x25, 0x80,
+    0xd9, 0x7f, 0xab, 0x82, 0x2d, 0x1c, 0x41, 0x0c, 0x75, 0x7d, 0x26, 0x3b,
+    0xbe, 0x3c, 0x41, 0xc1, 0xd6, 0xa7, 0x8d, 0xfb, 0x5c, 0xd4, 0xab, 0x16,
+    0x30, 0x16, 0x69, 0xec,
+};
+
+static const unsigned char trust_store_root_23[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x17, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x33, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x33, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x88, 0x78, 0xf4, 0x3f, 0x0c, 0xe5, 0xda, 0xeb, 0x43, 0x94, 0x48,
+    0x1b, 0x95, 0x5a, 0x9d, 0xc8, 0xb2, 0x88, 0xc7, 0xba, 0x69, 0x22, 0x53,
+    0x6c, 0x68, 0xd8, 0x84, 0x7d, 0x80, 0x3f, 0x58, 0x7a, 0xcc, 0x3e, 0x33,
+    0x10, 0xba, 0x94, 0xc7, 0x84, 0x5e, 0x3b, 0x29, 0xe3, 0x5a, 0x45, 0x59,
+    0xa3, 0x46, 0xcf, 0xb8, 0xd2, 0xac, 0xaa, 0x7c, 0x20, 0xcb, 0x35, 0x46,
+    0x2a, 0x71, 0x15, 0x61, 0x5a, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x6e, 0xf1, 0x14, 0x2d, 0xe8, 0x5c, 0x6a,
+    0xa1, 0x0a, 0xae, 0x04, 0x13, 0xa9, 0xc5, 0xf2, 0x5c, 0x40, 0x27, 0xb7,
+    0x95, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0xbf, 0x63, 0x20,
+    0xbf, 0x95, 0x81, 0x6d, 0xd6, 0x80, 0x54, 0x96, 0x1a, 0x80, 0xc6, 0xf6,
+    0x04, 0x99, 0x82, 0x04, 0x37, 0x6c, 0x97, 0x94, 0xbb, 0x39, 0xf5, 0x3e,
+    0x1b, 0x90, 0x8a, 0xf6, 0x27, 0x02, 0x20, 0x01, 0x15, 0xb9, 0xab, 0x34,
+    0x55, 0xb6, 0x13, 0xcc, 0xac, 0x2c, 0x43, 0xaf, 0x42, 0x9c, 0x70, 0x71,
+    0x4b, 0x2b, 0xd1, 0x1b, 0x4d, 0x8d, 0x65, 0xda, 0x1f, 0x4b, 0xb6, 0xe3,
+    0x69, 0xe0, 0xc1,
+};
+
+static const unsigned char trust_store_root_24[484] = {
+    0x30, 0x82, 0x01, 0xe0, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x18, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x34, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x35,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x35, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x34, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x00, 0xfd, 0x04, 0x41, 0xee, 0x8a, 0x74, 0xb5, 0xf7, 0x01, 0xd9,
+    0xac, 0x5c, 0x9e, 0xc5, 0x88, 0x0c, 0x77, 0xe3, 0xc9, 0x14, 0xf8, 0x2c,
+    0x33, 0x63, 0x8d, 0x9c, 0xf1, 0x5f, 0x3a, 0xa5, 0x9f, 0x55, 0x68, 0xc9,
+    0xa0, 0xd7, 0x4f, 0x6d, 0xb8, 0x27, 0xcb, 0x7b, 0x89, 0x98, 0x0a, 0x8a,
+    0x61, 0x44, 0x68, 0x81, 0xc1, 0x88, 0xa9, 0xef, 0x64, 0x82, 0x38, 0x27,
+    0x5e, 0xf2, 0x12, 0x46, 0x94, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x8b, 0xee, 0xe7, 0xcc, 0xe1, 0xba, 0xca,
+    0xe5, 0x3c, 0x4d, 0x62, 0x20, 0xbf, 0x64, 0x9e, 0x73, 0x3b, 0xbe, 0x90,
+    0x6f, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0xf9, 0x87, 0x1f,
+    0xa6, 0x36, 0xe6, 0xfe, 0x61, 0x9a, 0x43, 0xb9, 0x5d, 0x64, 0xfd, 0x8d,
+    0x36, 0x79, 0xeb, 0x6b, 0x30, 0xb5, 0x89, 0xef, 0xb7, 0x72, 0xa2, 0x48,
+    0x03, 0xf8, 0x36, 0x16, 0xf1, 0x02, 0x21, 0x00, 0xb7, 0xa7, 0xc8, 0xa9,
+    0x7a, 0x5d, 0xfa, 0xde, 0xdd, 0xd6, 0x6b, 0xa2, 0x2f, 0xa4, 0xe5, 0xc2,
+    0xd7, 0x29, 0xec, 0x22, 0xc0, 0x5a, 0xaa, 0xb4, 0x14, 0xbc, 0x74, 0xf0,
+    0x9a, 0x93, 0x45, 0x43,
+};
+
+static const unsigned char trust_store_root_25[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x19, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x35, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x36,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x36, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x35, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x34, 0x78, 0x2a, 0x58, 0xda, 0x1b, 0x75, 0xd4, 0xe1, 0x7e, 0xb7,
+    0xa3, 0x26, 0xa6, 0x14, 0xe6, 0x88, 0xdd, 0x08, 0xbf, 0xeb, 0x92, 0x60,
+    0x11, 0x96, 0x42, 0xfc, 0x8f, 0xdc, 0x57, 0x6c, 0xfa, 0xdb, 0x8f, 0xbb,
+    0x2c, 0x47, 0x4f, 0x7f, 0x15, 0x20, 0x68, 0x4a, 0x4d, 0x37, 0x2c, 0x32,
+    0x97, 0xb2, 0xeb, 0x64, 0xd2, 0x90, 0xc4, 0x85, 0xcd, 0x31, 0x1b, 0xe6,
+    0x7a, 0x77, 0x9f, 0x9d, 0x9d, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x4e, 0x39, 0xc9, 0x4b, 0xff, 0x5d, 0xec,
+    0x7d, 0x07, 0x78, 0x4c, 0xe2, 0x12, 0x21, 0x21, 0x0b, 0xb1, 0x30, 0xa3,
+    0x99, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x20, 0x2f, 0x0b, 0xd7, 0xe7,
+    0xab, 0x50, 0xae, 0x21, 0x0f, 0x7e, 0xfa, 0x6f, 0x91, 0x2a, 0xd2, 0x11,
+    0x44, 0x7f, 0x5b, 0x59, 0xe6, 0x35, 0x0d, 0x0d, 0xd9, 0x21, 0x9a, 0x11,
+    0x36, 0x4e, 0x32, 0x87, 0x02, 0x21, 0x00, 0xab, 0x03, 0x42, 0x07, 0x7d,
+    0x60, 0x3b, 0x1a, 0x24, 0x78, 0xc6, 0x89, 0xdf, 0xe6, 0xe9, 0x81, 0x13,
+    0xfb, 0xdc, 0x4f, 0xf6, 0xe5, 0x0b, 0x34, 0xb8, 0xf9, 0x9c, 0xff, 0x55,
+    0x91, 0x39, 0x32,
+};
+
+static const unsigned char trust_store_root_26[484] = {
+    0x30, 0x82, 0x01, 0xe0, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x1a, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x36, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x36,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x36, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x36, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0xbb, 0x41, 0xcb, 0xfc, 0x69, 0x7a, 0x88, 0xa9, 0x62, 0x03, 0xeb,
+    0x53, 0x7d, 0xf7, 0x2d, 0xbc, 0x42, 0x35, 0xe1, 0xf3, 0x9c, 0xb2, 0xed,
+    0xc2, 0x56, 0x6d, 0x75, 0x93, 0x36, 0x9f, 0x57, 0xd2, 0x22, 0xa9, 0x2c,
+    0x86, 0x1e, 0xb0, 0x5c, 0x4c, 0xd4, 0x06, 0xb0, 0x21, 0x47, 0x3c, 0xd4,
+    0xe1, 0x48, 0xb1, 0xae, 0x66, 0xaf, 0x01, 0x80, 0xc3, 0x0e, 0x28, 0xe9,
+    0xf0, 0xbb, 0x01, 0x31, 0xe7, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xc3, 0xd5, 0x15, 0x57, 0xc5, 0x23, 0xc3,
+    0xfb, 0xcf, 0x5f, 0xc4, 0x0d, 0x79, 0x93, 0xaa, 0x7a, 0x3e, 0xf5, 0xec,
+    0xf9, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0x8e, 0x8a, 0x1a,
+    0x12, 0x52, 0x9e, 0x02, 0xdd, 0xca, 0x0f, 0x7b, 0x2a, 0xfd, 0xf7, 0xd4,
+    0xee, 0x88, 0xcc, 0x88, 0x35, 0x4e, 0xdd, 0x6f, 0xd6, 0x07, 0x45, 0x6b,
+    0x08, 0xcb, 0x96, 0x44, 0xe5, 0x02, 0x21, 0x00, 0x97, 0x3e, 0xeb, 0x20,
+    0xda, 0xf8, 0xbe, 0x2a, 0x8b, 0xbe, 0x10, 0x90, 0x68, 0x10, 0xc7, 0x34,
+    0xd6, 0x26, 0xe4, 0xae, 0x2a, 0x63, 0xa7, 0x9e, 0x7a, 0x93, 0x29, 0xe3,
+    0xf9, 0xf3, 0xf2, 0x0a,
+};
+
+static const unsigned char trust_store_root_27[484] = {
+    0x30, 0x82, 0x01, 0xe0, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x1b, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x37, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x36,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x36, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x37, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0xab, 0xd9, 0xfd, 0xe8, 0xd2, 0xb5, 0xf1, 0x39, 0x50, 0xd7, 0x2b,
+    0xe7, 0x72, 0x92, 0x4f, 0x38, 0x03, 0xc2, 0x92, 0x25, 0xaf, 0xa6, 0x40,
+    0x78, 0xf0, 0xc8, 0x47, 0xdf, 0xec, 0xda, 0x36, 0x85, 0xb4, 0x2e, 0x37,
+    0x2a, 0x9d, 0x1b, 0x42, 0x16, 0x24, 0x9c, 0x86, 0xcf, 0x42, 0x94, 0x06,
+    0x03, 0xb2, 0x5e, 0x76, 0xc1, 0x5d, 0xf9, 0x24, 0x71, 0x0e, 0x1d, 0x5d,
+    0x69, 0xf7, 0x10, 0x87, 0xfb, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xfd, 0x42, 0xc3, 0x8e, 0x93, 0x70, 0x66,
+    0x50, 0x46, 0x92, 0x15, 0x70, 0x2a, 0xed, 0xf8, 0x35, 0xbf, 0x72, 0xf9,
+    0x65, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0xe4, 0xa8, 0x5a,
+    0x54, 0xde, 0xa1, 0x5c, 0xef, 0xd5, 0x77, 0xed, 0x5b, 0x9b, 0x7e, 0x56,
+    0x37, 0x1b, 0xce, 0x11, 0xa5, 0x32, 0x49, 0x3e, 0x09, 0xd5, 0x45, 0xa5,
+    0x89, 0x64, 0x58, 0x74, 0x42, 0x02, 0x21, 0x00, 0xdb, 0x5a, 0xea, 0x50,
+    0x6a, 0x13, 0x53, 0xb8, 0x55, 0xdc, 0xbe, 0xbe, 0x0f, 0x0d, 0x8a, 0xa2,
+    0x80, 0x98, 0x26, 0x54, 0xfa, 0xda, 0x2e, 0xe5, 0xa2, 0xa0, 0x5a, 0x2e,
+    0x01, 0x7e, 0x2c, 0x7c,
+};
+
+static const unsigned char trust_store_root_28[482] = {
+    0x30, 0x82, 0x01, 0xde, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x1c, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x38, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x36,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x36, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x38, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x5e, 0x26, 0x00, 0x36, 0xfd, 0x3f, 0x5b, 0x6b, 0xcd, 0xda, 0x5f,
+    0x0f, 0x11, 0x6e, 0x2d, 0x0f, 0x59, 0x16, 0x2d, 0xbf, 0x2f, 0x62, 0x40,
+    0x4e, 0xd1, 0xd4, 0xa7, 0x59, 0x6e, 0x02, 0x8a, 0x6c, 0xe2, 0xce, 0xeb,
+    0xfa, 0x7d, 0x54, 0x1a, 0x1a, 0x3e, 0xcb, 0x1b, 0x6f, 0x39, 0x3f, 0xb5,
+    0x57, 0x48, 0x8e, 0x1e, 0x4f, 0x7b, 0xfa, 0x4f, 0xe0, 0x1f, 0x4d, 0x70,
+    0x9f, 0x8f, 0xd3, 0xa2, 0x20, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x15, 0x82, 0xfe, 0x52, 0x61, 0x16, 0x14,
+    0xf8, 0xda, 0x46, 0x7f, 0x84, 0xbc, 0x67, 0xd5, 0x66, 0xfd, 0x25, 0xb0,
+    0x01, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x47, 0x00, 0x30, 0x44, 0x02, 0x20, 0x20, 0xf3, 0x89, 0xe9,
+    0x6a, 0xd6, 0x43, 0xa6, 0x42, 0x9a, 0x9a, 0x84, 0xd6, 0x29, 0x1b, 0x6a,
+    0x06, 0xdc, 0xe0, 0xa3, 0x3d, 0x17, 0x91, 0x8b, 0xad, 0x3b, 0xa7, 0xe3,
+    0x22, 0x13, 0x40, 0x5e, 0x02, 0x20, 0x1e, 0x7f, 0x1c, 0xd0, 0x0b, 0xbe,
+    0x22, 0x99, 0x82, 0x72, 0x70, 0x9e, 0x8d, 0x9d, 0x69, 0x73, 0xc7, 0xb0,
+    0x99, 0xaf, 0x85, 0x2c, 0x12, 0xa3, 0x7a, 0x71, 0x0f, 0xdd, 0x57, 0xa8,
+    0xdd, 0x11,
+};
+
+static const unsigned char trust_store_root_29[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x1d, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x39, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x36,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x36, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x32, 0x39, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x66, 0x38, 0xcd, 0x9c, 0x8f, 0x91, 0x92, 0x7b, 0xcd, 0xf0, 0xd4,
+    0x07, 0xb9, 0x33, 0xc3, 0xbc, 0xea, 0xb9, 0xe3, 0x74, 0x9a, 0x1e, 0x51,
+    0x5e, 0x2f, 0x2e, 0xca, 0xce, 0x4e, 0xc3, 0xb1, 0x3e, 0x77, 0x0f, 0xc6,
+    0xb1, 0x6b, 0x1d, 0xab, 0x75, 0x1e, 0x4e, 0x08, 0xaa, 0x31, 0x3f, 0x9d,
+    0xdb, 0x95, 0x4c, 0x95, 0x15, 0x6b, 0x32, 0xac, 0x4b, 0xec, 0xcd, 0xf0,
+    0xdb, 0x9b, 0x01, 0x6b, 0x56, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x10, 0xb6, 0xbf, 0x9d, 0xce, 0xee, 0xf9,
+    0x0c, 0x9e, 0x7e, 0x53, 0x44, 0xea, 0x38, 0xd7, 0x94, 0x3d, 0x0f, 0x8f,
+    0x5a, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0xe9, 0x38, 0x71,
+    0xb0, 0x43, 0xa2, 0xe1, 0x8c, 0x2a, 0xb0, 0x36, 0xd8, 0x01, 0xb6, 0xd3,
+    0x83, 0x5a, 0x58, 0x84, 0x78, 0x6f, 0x55, 0x17, 0xbc, 0x21, 0x23, 0x3b,
+    0xfe, 0x2d, 0x60, 0x48, 0x73, 0x02, 0x20, 0x79, 0x6e, 0xf2, 0x7b, 0x3d,
+    0x32, 0x35, 0xbb, 0x42, 0xf8, 0x9c, 0x35, 0x14, 0x44, 0x4d, 0x71, 0x1f,
+    0xe4, 0xe6, 0xc9, 0xf5, 0x90, 0x8a, 0xe0, 0x78, 0x67, 0x1a, 0x28, 0xdf,
+    0xb1, 0x1c, 0x6e,
+};
+
+static const unsigned char trust_store_root_30[483] = {
+    0x30, 0x82, 0x01, 0xdf, 0x30, 0x82, 0x01, 0x85, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x1e, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x33, 0x30, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x36,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x36, 0x5a, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04,
+    0x0b, 0x0c, 0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f,
+    0x72, 0x65, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x15, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65,
+    0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x33, 0x30, 0x30, 0x59,
+    0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06,
+    0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00,
+    0x04, 0x81, 0xc1, 0x7f, 0xcc, 0xf6, 0xe4, 0x46, 0x6a, 0x07, 0xde, 0x64,
+    0xcb, 0x6a, 0xa7, 0x9d, 0x6e, 0x13, 0x46, 0x0c, 0x4c, 0x3b, 0x78, 0x1f,
+    0x64, 0xdb, 0x42, 0x04, 0xfc, 0x20, 0x83, 0x37, 0xfb, 0x53, 0xe3, 0x57,
+    0x5c, 0xf4, 0xd3, 0x6e, 0xfb, 0xee, 0xf1, 0x57, 0x88, 0x88, 0x8a, 0xbf,
+    0x70, 0x39, 0x39, 0x17, 0x76, 0x52, 0x7f, 0x3a, 0x90, 0x7f, 0x17, 0xc9,
+    0xc0, 0xe1, 0xb9, 0x3c, 0x85, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01,
+    0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff,
+    0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0x9f, 0x2c, 0xce, 0x4f, 0x96, 0x08, 0x22,
+    0xdf, 0xa5, 0xeb, 0x9d, 0xa5, 0x15, 0x7f, 0xe9, 0x7d, 0x84, 0xb6, 0x70,
+    0x6c, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x21, 0x00, 0xc6, 0xa9, 0xb1,
+    0xc7, 0x73, 0xda, 0x34, 0xff, 0xa8, 0x1a, 0x54, 0x3f, 0x9a, 0xf2, 0x90,
+    0xf0, 0x42, 0xfb, 0x56, 0x7b, 0x51, 0xc4, 0x1d, 0x7b, 0x6a, 0xbe, 0x6e,
+    0x75, 0x49, 0xf9, 0xcd, 0x4f, 0x02, 0x20, 0x7c, 0x11, 0xb0, 0x5d, 0x38,
+    0x1e, 0xb1, 0x01, 0x25, 0xc6, 0xfe, 0x4f, 0x73, 0x18, 0x72, 0x38, 0xb3,
+    0xfb, 0x66, 0x07, 0x5e, 0x73, 0xeb, 0xdc, 0xfc, 0x0d, 0x82, 0xc9, 0x19,
+    0xe3, 0xe8, 0x88,
+};
+
+static const unsigned char trust_store_intermediate[500] = {
+    0x30, 0x82, 0x01, 0xf0, 0x30, 0x82, 0x01, 0x95, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x64, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x30, 0x56, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54,
+    0x4c, 0x53, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+    0x0b, 0x54, 0x72, 0x75, 0x73, 0x74, 0x20, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x15, 0x6d,
+    0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54, 0x65, 0x73, 0x74,
+    0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x33, 0x30, 0x30, 0x20, 0x17, 0x0d,
+    0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x36,
+    0x5a, 0x18, 0x0f, 0x32, 0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31,
+    0x33, 0x35, 0x36, 0x31, 0x36, 0x5a, 0x30, 0x45, 0x31, 0x0b, 0x30, 0x09,
+    0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30,
+    0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64,
+    0x20, 0x54, 0x4c, 0x53, 0x31, 0x23, 0x30, 0x21, 0x06, 0x03, 0x55, 0x04,
+    0x03, 0x0c, 0x1a, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20,
+    0x54, 0x65, 0x73, 0x74, 0x20, 0x49, 0x6e, 0x74, 0x65, 0x72, 0x6d, 0x65,
+    0x64, 0x69, 0x61, 0x74, 0x65, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2a,
+    0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04, 0x2f, 0x26, 0x09, 0xe5,
+    0xf9, 0x93, 0xba, 0xa9, 0x5b, 0x42, 0x03, 0x30, 0x20, 0x95, 0x58, 0xea,
+    0xce, 0x04, 0x3c, 0x61, 0x6a, 0xc6, 0xda, 0x4c, 0x4d, 0x44, 0x26, 0x8f,
+    0xb6, 0xf6, 0x21, 0x9d, 0x31, 0xbb, 0xe6, 0xe0, 0xc4, 0xfa, 0xb7, 0x68,
+    0x2d, 0xa8, 0xb5, 0x99, 0x6c, 0x66, 0x42, 0xa8, 0xc8, 0x1d, 0x68, 0x8a,
+    0xa4, 0x5a, 0xef, 0x7b, 0x6e, 0xfa, 0x4f, 0x15, 0x8a, 0xb3, 0xc5, 0x32,
+    0xa3, 0x63, 0x30, 0x61, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01,
+    0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0e, 0x06,
+    0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01,
+    0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14,
+    0x06, 0x97, 0xa5, 0x1d, 0x75, 0xbd, 0x75, 0x28, 0xb4, 0xe8, 0x27, 0x6f,
+    0xd9, 0x49, 0x1d, 0x5f, 0x99, 0x71, 0xa3, 0xca, 0x30, 0x1f, 0x06, 0x03,
+    0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x9f, 0x2c, 0xce,
+    0x4f, 0x96, 0x08, 0x22, 0xdf, 0xa5, 0xeb, 0x9d, 0xa5, 0x15, 0x7f, 0xe9,
+    0x7d, 0x84, 0xb6, 0x70, 0x6c, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48,
+    0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21,
+    0x00, 0xfd, 0x76, 0xd4, 0x49, 0xcb, 0xc6, 0xfa, 0x9e, 0x50, 0xfa, 0x64,
+    0x06, 0x5a, 0x82, 0x79, 0xe6, 0x82, 0x56, 0xd4, 0x9c, 0xc7, 0x3b, 0x00,
+    0xcc, 0x4f, 0xca, 0xe0, 0x4c, 0x34, 0x34, 0x96, 0xc7, 0x02, 0x21, 0x00,
+    0x9b, 0x0c, 0xa5, 0xfb, 0xd1, 0x8b, 0xa7, 0x1d, 0xa9, 0x12, 0x11, 0xb9,
+    0xf8, 0xaa, 0xb8, 0xab, 0x25, 0x48, 0x31, 0xee, 0x2d, 0x94, 0x90, 0xd9,
+    0x96, 0x68, 0x4e, 0xbf, 0x61, 0x48, 0x32, 0xcc,
+};
+
+static const unsigned char trust_store_leaf[521] = {
+    0x30, 0x82, 0x02, 0x05, 0x30, 0x82, 0x01, 0xaa, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x02, 0x00, 0xc8, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48,
+    0xce, 0x3d, 0x04, 0x03, 0x02, 0x30, 0x45, 0x31, 0x0b, 0x30, 0x09, 0x06,
+    0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f,
+    0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20,
+    0x54, 0x4c, 0x53, 0x31, 0x23, 0x30, 0x21, 0x06, 0x03, 0x55, 0x04, 0x03,
+    0x0c, 0x1a, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x54,
+    0x65, 0x73, 0x74, 0x20, 0x49, 0x6e, 0x74, 0x65, 0x72, 0x6d, 0x65, 0x64,
+    0x69, 0x61, 0x74, 0x65, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30,
+    0x31, 0x39, 0x31, 0x33, 0x35, 0x36, 0x31, 0x36, 0x5a, 0x18, 0x0f, 0x32,
+    0x30, 0x35, 0x36, 0x31, 0x30, 0x31, 0x31, 0x31, 0x33, 0x35, 0x36, 0x31,
+    0x36, 0x5a, 0x30, 0x34, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04,
+    0x06, 0x13, 0x02, 0x4e, 0x4c, 0x31, 0x11, 0x30, 0x0f, 0x06, 0x03, 0x55,
+    0x04, 0x0a, 0x0c, 0x08, 0x6d, 0x62, 0x65, 0x64, 0x20, 0x54, 0x4c, 0x53,
+    0x31, 0x12, 0x30, 0x10, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x09, 0x6c,
+    0x6f, 0x63, 0x61, 0x6c, 0x68, 0x6f, 0x73, 0x74, 0x30, 0x59, 0x30, 0x13,
+    0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a,
+    0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04, 0x7a,
+    0xaa, 0x01, 0xcc, 0xe3, 0xb7, 0x01, 0x83, 0x32, 0x76, 0xc9, 0xf3, 0xec,
+    0x2f, 0x02, 0x60, 0x84, 0x13, 0x21, 0x80, 0x37, 0x95, 0xb0, 0xa4, 0x58,
+    0xcb, 0xb0, 0x61, 0x89, 0xc1, 0x71, 0x04, 0xe8, 0xe7, 0x1b, 0x4c, 0x7b,
+    0x91, 0x19, 0x24, 0xdf, 0x68, 0xf0, 0xdb, 0x39, 0x46, 0x89, 0x90, 0x19,
+    0xbc, 0xbe, 0x0c, 0x21, 0x2e, 0x39, 0x40, 0x98, 0x57, 0xc3, 0xf7, 0x73,
+    0x7f, 0x4d, 0xf5, 0xa3, 0x81, 0x98, 0x30, 0x81, 0x95, 0x30, 0x09, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x04, 0x02, 0x30, 0x00, 0x30, 0x0e, 0x06, 0x03,
+    0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x07, 0x80,
+    0x30, 0x13, 0x06, 0x03, 0x55, 0x1d, 0x25, 0x04, 0x0c, 0x30, 0x0a, 0x06,
+    0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07, 0x03, 0x01, 0x30, 0x23, 0x06,
+    0x03, 0x55, 0x1d, 0x11, 0x04, 0x1c, 0x30, 0x1a, 0x82, 0x09, 0x6c, 0x6f,
+    0x63, 0x61, 0x6c, 0x68, 0x6f, 0x73, 0x74, 0x82, 0x0d, 0x2a, 0x2e, 0x65,
+    0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x30, 0x1d,
+    0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x43, 0x80, 0x55,
+    0x1b, 0x4f, 0xae, 0x1b, 0x86, 0xf8, 0xa3, 0xc2, 0x6f, 0x55, 0x4a, 0x39,
+    0x3c, 0x72, 0x5c, 0x10, 0x33, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23,
+    0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x06, 0x97, 0xa5, 0x1d, 0x75, 0xbd,
+    0x75, 0x28, 0xb4, 0xe8, 0x27, 0x6f, 0xd9, 0x49, 0x1d, 0x5f, 0x99, 0x71,
+    0xa3, 0xca, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04,
+    0x03, 0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0xa3, 0x80,
+    0x9d, 0x79, 0x50, 0xfb, 0x00, 0x70, 0xab, 0x9c, 0x66, 0x34, 0xd7, 0xc7,
+    0xfb, 0xce, 0x4f, 0x93, 0x6b, 0xb8, 0xfd, 0xa6, 0x2b, 0x48, 0x5b, 0xb0,
+    0x42, 0x04, 0x67, 0x01, 0xbf, 0x33, 0x02, 0x21, 0x00, 0xac, 0x91, 0x17,
+    0x12, 0x48, 0x62, 0xee, 0xc1, 0x82, 0x4d, 0x44, 0xb6, 0xed, 0xe4, 0xab,
+    0x69, 0x7c, 0xcd, 0xc3, 0x8c, 0xb6, 0x45, 0xd3, 0x3e, 0x9b, 0x2a, 0xdb,
+    0x81, 0x7f, 0xf6, 0x9a, 0x64,
+};
+
+typedef struct {
+    const unsigned char *der;
+    size_t len;
+} trust_store_cert_t;
+
+static const trust_store_cert_t trust_store_roots[] = {
+    { trust_store_root_01, sizeof(trust_store_root_01) },
+    { trust_store_root_02, sizeof(trust_store_root_02) },
+    { trust_store_root_03, sizeof(trust_store_root_03) },
+    { trust_store_root_04, sizeof(trust_store_root_04) },
+    { trust_store_root_05, sizeof(trust_store_root_05) },
+    { trust_store_root_06, sizeof(trust_store_root_06) },
+    { trust_store_root_07, sizeof(trust_store_root_07) },
+    { trust_store_root_08, sizeof(trust_store_root_08) },
+    { trust_store_root_09, sizeof(trust_store_root_09) },
+    { trust_store_root_10, sizeof(trust_store_root_10) },
+    { trust_store_root_11, sizeof(trust_store_root_11) },
+    { trust_store_root_12, sizeof(trust_store_root_12) },
+    { trust_store_root_13, sizeof(trust_store_root_13) },
+    { trust_store_root_14, sizeof(trust_store_root_14) },
+    { trust_store_root_15, sizeof(trust_store_root_15) },
+    { trust_store_root_16, sizeof(trust_store_root_16) },
+    { trust_store_root_17, sizeof(trust_store_root_17) },
+    { trust_store_root_18, sizeof(trust_store_root_18) },
+    { trust_store_root_19, sizeof(trust_store_root_19) },
+    { trust_store_root_20, sizeof(trust_store_root_20) },
+    { trust_store_root_21, sizeof(trust_store_root_21) },
+    { trust_store_root_22, sizeof(trust_store_root_22) },
+    { trust_store_root_23, sizeof(trust_store_root_23) },
+    { trust_store_root_24, sizeof(trust_store_root_24) },
+    { trust_store_root_25, sizeof(trust_store_root_25) },
+    { trust_store_root_26, sizeof(trust_store_root_26) },
+    { trust_store_root_27, sizeof(trust_store_root_27) },
+    { trust_store_root_28, sizeof(trust_store_root_28) },
+    { trust_store_root_29, sizeof(trust_store_root_29) },
+    { trust_store_root_30, sizeof(trust_store_root_30) },
+};
+
+#define TRUST_STORE_ROOTS   (sizeof(trust_store_roots) / sizeof(trust_store_roots[0]))
+
+#endif /* X509_NOCOPY_TRUST_STORE_H */
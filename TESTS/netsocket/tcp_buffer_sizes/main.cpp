@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_CONF_APP_CONNECT_STATEMENT
+#error [NOT_SUPPORTED] No network configuration found for this target.
+#endif
+
+#include "mbed.h"
+#include MBED_CONF_APP_HEADER_FILE
+#include "TCPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+#ifndef MBED_CONF_APP_TCP_BUFFER_SIZES_TRANSFER
+#define MBED_CONF_APP_TCP_BUFFER_SIZES_TRANSFER 8192
+#endif
+
+namespace
+{
+NetworkInterface *net;
+SocketAddress tcp_addr;
+char tx_buffer[512];
+char rx_buffer[512];
+}
+
+static void prep_buffer(char *buffer, size_t size, unsigned seed)
+{
+    for (size_t i = 0; i < size; ++i) {
+        buffer[i] = (char)('0' + (seed + i) % 10);
+    }
+}
+
+static bool buffer_sizes_supported(TCPSocket &sock)
+{
+    int size = 0;
+    unsigned len = sizeof size;
+    int err = sock.getsockopt(NSAPI_SOCKET, NSAPI_SNDBUF, &size, &len);
+    if (err == NSAPI_ERROR_UNSUPPORTED) {
+        printf("MBED: stack does not support per-socket buffer sizes\r\n");
+        return false;
+    }
+
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(sizeof size, len);
+    TEST_ASSERT(size > 0);
+    return true;
+}
+
+void test_tcp_buffer_setsockopt()
+{
+    TCPSocket sock(net);
+    TEST_ASSERT_EQUAL(0, sock.connect(tcp_addr));
+
+    if (!buffer_sizes_supported(sock)) {
+        sock.close();
+        return;
+    }
+
+    int size = 1024;
+    TEST_ASSERT_EQUAL(0, sock.setsockopt(NSAPI_SOCKET, NSAPI_SNDBUF, &size, sizeof size));
+    TEST_ASSERT_EQUAL(0, sock.setsockopt(NSAPI_SOCKET, NSAPI_RCVBUF, &size, sizeof size));
+
+    // The stack may round to its own limits, but never beyond what was asked
+    int got = 0;
+    unsigned len = sizeof got;
+    TEST_ASSERT_EQUAL(0, sock.getsockopt(NSAPI_SOCKET, NSAPI_SNDBUF, &got, &len));
+    TEST_ASSERT(got > 0 && got <= size);
+
+    size = -1;
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_PARAMETER, sock.setsockopt(NSAPI_SOCKET, NSAPI_SNDBUF, &size, sizeof size));
+
+    // Zero hands sizing back to the stack
+    size = 0;
+    TEST_ASSERT_EQUAL(0, sock.setsockopt(NSAPI_SOCKET, NSAPI_SNDBUF, &size, sizeof size));
+    TEST_ASSERT_EQUAL(0, sock.setsockopt(NSAPI_SOCKET, NSAPI_RCVBUF, &size, sizeof size));
+
+    sock.close();
+}
+
+void test_tcp_buffer_small_echo()
+{
+    TCPSocket sock(net);
+    TEST_ASSERT_EQUAL(0, sock.connect(tcp_addr));
+
+    if (!buffer_sizes_supported(sock)) {
+        sock.close();
+        return;
+    }
+
+    // Small buffers must slow a transfer down, not corrupt or stall it
+    int size = 1;
+    TEST_ASSERT_EQUAL(0, sock.setsockopt(NSAPI_SOCKET, NSAPI_SNDBUF, &size, sizeof size));
+    TEST_ASSERT_EQUAL(0, sock.setsockopt(NSAPI_SOCKET, NSAPI_RCVBUF, &size, sizeof size));
+
+    for (unsigned sent = 0; sent < MBED_CONF_APP_TCP_BUFFER_SIZES_TRANSFER; sent += sizeof tx_buffer) {
+        prep_buffer(tx_buffer, sizeof tx_buffer, sent);
+        TEST_ASSERT_EQUAL(sizeof tx_buffer, sock.send(tx_buffer, sizeof tx_buffer));
+
+        size_t recvd = 0;
+        while (recvd < sizeof rx_buffer) {
+            int n = sock.recv(rx_buffer + recvd, sizeof rx_buffer - recvd);
+            TEST_ASSERT(n > 0);
+            recvd += n;
+        }
+        TEST_ASSERT_EQUAL_MEMORY(tx_buffer, rx_buffer, sizeof rx_buffer);
+    }
+
+    sock.close();
+}
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(240, "tcp_echo");
+
+    net = MBED_CONF_APP_OBJECT_CONSTRUCTION;
+    int err = MBED_CONF_APP_CONNECT_STATEMENT;
+    TEST_ASSERT_EQUAL(0, err);
+
+    printf("MBED: TCPClient IP address is '%s'\n", net->get_ip_address());
+
+#if defined(MBED_CONF_APP_ECHO_SERVER_ADDR) && defined(MBED_CONF_APP_ECHO_SERVER_PORT)
+    tcp_addr.set_ip_address(MBED_CONF_APP_ECHO_SERVER_ADDR);
+    tcp_addr.set_port(MBED_CONF_APP_ECHO_SERVER_PORT);
+#else /* MBED_CONF_APP_ECHO_SERVER_ADDR && MBED_CONF_APP_ECHO_SERVER_PORT */
+    char recv_key[] = "host_port";
+    char ipbuf[60] = {0};
+    char portbuf[16] = {0};
+    unsigned int port = 0;
+
+    greentea_send_kv("target_ip", net->get_ip_address());
+    greentea_send_kv("host_ip", " ");
+    greentea_parse_kv(recv_key, ipbuf, sizeof(recv_key), sizeof(ipbuf));
+
+    greentea_send_kv("host_port", " ");
+    greentea_parse_kv(recv_key, portbuf, sizeof(recv_key), sizeof(ipbuf));
+    sscanf(portbuf, "%u", &port);
+
+    tcp_addr.set_ip_address(ipbuf);
+    tcp_addr.set_port(port);
+#endif /* MBED_CONF_APP_ECHO_SERVER_ADDR && MBED_CONF_APP_ECHO_SERVER_PORT */
+
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("TCP buffer setsockopt", test_tcp_buffer_setsockopt),
+    Case("TCP echo with small buffers", test_tcp_buffer_small_echo),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Compares full and resumed TLS handshakes made by TLSSocket.
+ *
+ * Needs an mbed TLS test server on the local network with session
+ * tickets and a session cache, using the mbed TLS test certificates:
+ *
+ *     programs/ssl/ssl_server2 server_port=4433 tickets=1 cache_max=16
+ *
+ * with tls-server-addr and tls-server-port set in the application config.
+ */
+
+#ifndef MBED_CONF_APP_CONNECT_STATEMENT
+#error [NOT_SUPPORTED] No network configuration found for this target.
+#endif
+
+#if !defined(MBED_CONF_APP_TLS_SERVER_ADDR) || !defined(MBED_CONF_APP_TLS_SERVER_PORT)
+#error [NOT_SUPPORTED] No TLS test server configured.
+#endif
+
+#include "mbed.h"
+#include MBED_CONF_APP_HEADER_FILE
+#include "TLSSocket.h"
+#include "mbedtls/certs.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+
+#if !defined(MBEDTLS_SSL_CLI_C) || !defined(MBEDTLS_CERTS_C)
+#error [NOT_SUPPORTED] TLS client or test certificates not enabled.
+#endif
+
+using namespace utest::v1;
+
+#ifndef MBED_CONF_APP_TLS_SERVER_NAME
+#define MBED_CONF_APP_TLS_SERVER_NAME "localhost"
+#endif
+
+#ifndef MBED_CONF_APP_TLS_HANDSHAKE_ITERATIONS
+#define MBED_CONF_APP_TLS_HANDSHAKE_ITERATIONS 5
+#endif
+
+namespace
+{
+NetworkInterface *net;
+SocketAddress server_addr;
+TLSSessionCache session_cache;
+}
+
+// Connects, exchanges a request so the session is fully established,
+// and returns the handshake time in microseconds
+static int timed_handshake(bool tickets, bool *resumed)
+{
+    TLSSocket sock(net);
+    TEST_ASSERT_EQUAL(0, sock.set_root_ca_cert(mbedtls_test_cas_pem, mbedtls_test_cas_pem_len));
+    TEST_ASSERT_EQUAL(0, sock.set_hostname(MBED_CONF_APP_TLS_SERVER_NAME));
+    sock.set_session_cache(&session_cache);
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    mbedtls_ssl_conf_session_tickets(sock.get_ssl_config(), tickets ?
+                                     MBEDTLS_SSL_SESSION_TICKETS_ENABLED : MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+#endif
+
+    Timer timer;
+    timer.start();
+    nsapi_error_t err = sock.connect(server_addr);
+    timer.stop();
+    if (err) {
+        printf("MBED: handshake failed %d (mbed TLS -0x%04x)\r\n", err, -sock.get_tls_error());
+    }
+    TEST_ASSERT_EQUAL(0, err);
+
+    static const char request[] = "GET / HTTP/1.0\r\n\r\n";
+    TEST_ASSERT_EQUAL(sizeof request - 1, sock.send(request, sizeof request - 1));
+
+    char reply[256];
+    TEST_ASSERT(sock.recv(reply, sizeof reply) > 0);
+
+    *resumed = sock.is_resumed();
+    sock.close();
+    return timer.read_us();
+}
+
+static void test_resumption(bool tickets)
+{
+    int full_us = 0;
+    int resumed_us = 0;
+    bool resumed;
+
+    for (int i = 0; i < MBED_CONF_APP_TLS_HANDSHAKE_ITERATIONS; i++) {
+        session_cache.clear();
+        full_us += timed_handshake(tickets, &resumed);
+        TEST_ASSERT_FALSE(resumed);
+
+        resumed_us += timed_handshake(tickets, &resumed);
+        TEST_ASSERT_TRUE(resumed);
+    }
+
+    full_us /= MBED_CONF_APP_TLS_HANDSHAKE_ITERATIONS;
+    resumed_us /= MBED_CONF_APP_TLS_HANDSHAKE_ITERATIONS;
+    printf("MBED: %s full handshake %d us, resumed handshake %d us\r\n",
+           tickets ? "ticket" : "session ID", full_us, resumed_us);
+
+    TEST_ASSERT(resumed_us < full_us);
+}
+
+void test_resumption_session_id()
+{
+    test_resumption(false);
+}
+
+void test_resumption_ticket()
+{
+    test_resumption(true);
+}
+
+void test_resumption_empty_cache()
+{
+    bool resumed;
+
+    session_cache.clear();
+    timed_handshake(true, &resumed);
+
+    // A session for another server is not offered
+    TLSSessionCache other_cache;
+    TLSSocket sock(net);
+    TEST_ASSERT_EQUAL(0, sock.set_root_ca_cert(mbedtls_test_cas_pem, mbedtls_test_cas_pem_len));
+    TEST_ASSERT_EQUAL(0, sock.set_hostname(MBED_CONF_APP_TLS_SERVER_NAME));
+    sock.set_session_cache(&other_cache);
+    TEST_ASSERT_EQUAL(0, sock.connect(server_addr));
+    TEST_ASSERT_FALSE(sock.is_resumed());
+    sock.close();
+}
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(480, "default_auto");
+
+    net = MBED_CONF_APP_OBJECT_CONSTRUCTION;
+    int err = MBED_CONF_APP_CONNECT_STATEMENT;
+    TEST_ASSERT_EQUAL(0, err);
+
+    server_addr.set_ip_address(MBED_CONF_APP_TLS_SERVER_ADDR);
+    server_addr.set_port(MBED_CONF_APP_TLS_SERVER_PORT);
+
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("TLS session ID resumption", test_resumption_session_id),
+    Case("TLS session ticket resumption", test_resumption_ticket),
+    Case("TLS resumption with empty cache", test_resumption_empty_cache),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2013-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_CONF_APP_CONNECT_STATEMENT
+    #error [NOT_SUPPORTED] No network configuration found for this target.
+#endif
+
+#include "mbed.h"
+#include MBED_CONF_APP_HEADER_FILE
+#include "UDPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+
+#ifndef MBED_CFG_UDP_BATCH_DATAGRAM_SIZE
+#define MBED_CFG_UDP_BATCH_DATAGRAM_SIZE 64
+#endif
+
+#ifndef MBED_CFG_UDP_BATCH_SIZE
+#define MBED_CFG_UDP_BATCH_SIZE 16
+#endif
+
+#ifndef MBED_CFG_UDP_BATCH_DATAGRAMS
+#define MBED_CFG_UDP_BATCH_DATAGRAMS 1024
+#endif
+
+#ifndef MBED_CFG_UDP_BATCH_TIMEOUT
+#define MBED_CFG_UDP_BATCH_TIMEOUT 500
+#endif
+
+namespace {
+    NetworkInterface *net;
+    SocketAddress udp_addr;
+    char tx_buffer[MBED_CFG_UDP_BATCH_SIZE][MBED_CFG_UDP_BATCH_DATAGRAM_SIZE];
+    char rx_buffer[MBED_CFG_UDP_BATCH_SIZE][MBED_CFG_UDP_BATCH_DATAGRAM_SIZE];
+    nsapi_datagram_t tx_dgrams[MBED_CFG_UDP_BATCH_SIZE];
+    nsapi_datagram_t rx_dgrams[MBED_CFG_UDP_BATCH_SIZE];
+}
+
+static void print_rate(const char *name, int datagrams, Timer &timer)
+{
+    printf("MBED: %s: %d datagrams in %dus, %d datagrams/s\r\n", name,
+           datagrams, timer.read_us(), (int)(datagrams / timer.read()));
+}
+
+void test_udp_batch_setup()
+{
+    net = MBED_CONF_APP_OBJECT_CONSTRUCTION;
+    int err =  MBED_CONF_APP_CONNECT_STATEMENT;
+    TEST_ASSERT_EQUAL(0, err);
+
+    printf("UDP client IP Address is %s\n", net->get_ip_address());
+
+#if defined(MBED_CONF_APP_ECHO_SERVER_ADDR) && defined(MBED_CONF_APP_ECHO_SERVER_PORT)
+    udp_addr = SocketAddress(MBED_CONF_APP_ECHO_SERVER_ADDR, MBED_CONF_APP_ECHO_SERVER_PORT);
+#else /* MBED_CONF_APP_ECHO_SERVER_ADDR && MBED_CONF_APP_ECHO_SERVER_PORT */
+    char recv_key[] = "host_port";
+    char ipbuf[60] = {0};
+    char portbuf[16] = {0};
+    unsigned int port = 0;
+
+    greentea_send_kv("target_ip", net->get_ip_address());
+    greentea_send_kv("host_ip", " ");
+    greentea_parse_kv(recv_key, ipbuf, sizeof(recv_key), sizeof(ipbuf));
+
+    greentea_send_kv("host_port", " ");
+    greentea_parse_kv(recv_key, portbuf, sizeof(recv_key), sizeof(ipbuf));
+    sscanf(portbuf, "%u", &port);
+
+    udp_addr = SocketAddress(ipbuf, port);
+#endif /* MBED_CONF_APP_ECHO_SERVER_ADDR && MBED_CONF_APP_ECHO_SERVER_PORT */
+
+    for (int i = 0; i < MBED_CFG_UDP_BATCH_SIZE; i++) {
+        memset(tx_buffer[i], '0' + (i % 10), MBED_CFG_UDP_BATCH_DATAGRAM_SIZE);
+        tx_dgrams[i].addr = udp_addr.get_addr();
+        tx_dgrams[i].port = udp_addr.get_port();
+        tx_dgrams[i].data = tx_buffer[i];
+        tx_dgrams[i].size = MBED_CFG_UDP_BATCH_DATAGRAM_SIZE;
+        rx_dgrams[i].data = rx_buffer[i];
+        rx_dgrams[i].size = MBED_CFG_UDP_BATCH_DATAGRAM_SIZE;
+    }
+}
+
+void test_udp_sendto_rate()
+{
+    UDPSocket sock;
+    TEST_ASSERT_EQUAL(0, sock.open(net));
+
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < MBED_CFG_UDP_BATCH_DATAGRAMS; i++) {
+        int sent = sock.sendto(udp_addr, tx_buffer[i % MBED_CFG_UDP_BATCH_SIZE],
+                               MBED_CFG_UDP_BATCH_DATAGRAM_SIZE);
+        TEST_ASSERT_EQUAL(MBED_CFG_UDP_BATCH_DATAGRAM_SIZE, sent);
+    }
+    timer.stop();
+
+    print_rate("sendto", MBED_CFG_UDP_BATCH_DATAGRAMS, timer);
+    TEST_ASSERT_EQUAL(0, sock.close());
+}
+
+void test_udp_sendto_batch_rate()
+{
+    UDPSocket sock;
+    TEST_ASSERT_EQUAL(0, sock.open(net));
+
+    Timer timer;
+    timer.start();
+    int count = 0;
+    while (count < MBED_CFG_UDP_BATCH_DATAGRAMS) {
+        int sent = sock.sendto_batch(tx_dgrams, MBED_CFG_UDP_BATCH_SIZE);
+        TEST_ASSERT(sent > 0);
+        count += sent;
+    }
+    timer.stop();
+
+    print_rate("sendto_batch", count, timer);
+    TEST_ASSERT_EQUAL(0, sock.close());
+}
+
+void test_udp_recvfrom_batch_echo()
+{
+    UDPSocket sock;
+    TEST_ASSERT_EQUAL(0, sock.open(net));
+    sock.set_timeout(MBED_CFG_UDP_BATCH_TIMEOUT);
+
+    int sent = sock.sendto_batch(tx_dgrams, MBED_CFG_UDP_BATCH_SIZE);
+    TEST_ASSERT_EQUAL(MBED_CFG_UDP_BATCH_SIZE, sent);
+
+    // UDP may drop echoes, so only require that whatever arrives is intact
+    int received = 0;
+    while (received < MBED_CFG_UDP_BATCH_SIZE) {
+        int recv = sock.recvfrom_batch(rx_dgrams, MBED_CFG_UDP_BATCH_SIZE - received);
+        if (recv == NSAPI_ERROR_WOULD_BLOCK) {
+            break;
+        }
+        TEST_ASSERT(recv > 0);
+
+        for (int i = 0; i < recv; i++) {
+            TEST_ASSERT_EQUAL(MBED_CFG_UDP_BATCH_DATAGRAM_SIZE, rx_dgrams[i].len);
+            TEST_ASSERT_EQUAL(udp_addr.get_port(), rx_dgrams[i].port);
+        }
+        received += recv;
+    }
+
+    printf("MBED: recvfrom_batch: %d of %d echoes received\r\n",
+           received, MBED_CFG_UDP_BATCH_SIZE);
+    TEST_ASSERT(received > 0);
+    TEST_ASSERT_EQUAL(0, sock.close());
+
+    net->disconnect();
+}
+
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(120, "udp_echo");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("UDP batch setup", test_udp_batch_setup),
+    Case("UDP sendto rate", test_udp_sendto_rate),
+    Case("UDP sendto_batch rate", test_udp_sendto_batch_rate),
+    Case("UDP recvfrom_batch echo", test_udp_recvfrom_batch_echo),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if !DEVICE_EMAC || !defined(FEATURE_LWIP)
+#error [NOT_SUPPORTED] EMAC zero copy test requires an EMAC target and lwIP
+#endif
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+extern "C" {
+#include "lwip/tcpip.h"
+#include "lwip/netif.h"
+#include "lwip/pbuf.h"
+#include "lwip/udp.h"
+#include "eth_arch.h"
+}
+
+#include "emac_api.h"
+#include "emac_stack_mem.h"
+
+using namespace utest::v1;
+
+#define TEST_PAYLOAD_LEN        512
+#define TEST_PACKETS            32
+#define TEST_PORT               7
+#define TEST_RX_RING            2
+
+// Loopback EMAC, transmitted frames are received back through the input
+// callback. The copies are counted by the stack, the loopback only checks
+// which memory the frames are in on both ends.
+static struct {
+    emac_link_input_fn input_cb;
+    void *input_data;
+    emac_stack_mem_chain_t *ring[TEST_RX_RING];
+    unsigned ring_count;
+    emac_stack_mem_chain_t *rx_last;
+    unsigned tx_in_place;
+    unsigned app_in_place;
+    unsigned app_packets;
+    uint8_t dma[1514];
+} loopback;
+
+static uint32_t loopback_caps;
+static struct netif loopback_netif;
+static uint8_t payload[TEST_PAYLOAD_LEN];
+static Semaphore received;
+
+static uint32_t loopback_get_mtu_size(emac_interface_t *emac)
+{
+    return 1500;
+}
+
+static void loopback_get_ifname(emac_interface_t *emac, char *name, uint8_t size)
+{
+    memcpy(name, "lo", (size < 2) ? size : 2);
+}
+
+static uint8_t loopback_get_hwaddr_size(emac_interface_t *emac)
+{
+    return 6;
+}
+
+static void loopback_get_hwaddr(emac_interface_t *emac, uint8_t *addr)
+{
+    static const uint8_t hwaddr[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+    memcpy(addr, hwaddr, sizeof hwaddr);
+}
+
+static void loopback_set_hwaddr(emac_interface_t *emac, uint8_t *addr)
+{
+}
+
+static void loopback_input(emac_stack_mem_chain_t *chain)
+{
+    loopback.rx_last = chain;
+    loopback.input_cb(loopback.input_data, chain);
+}
+
+// Legacy single buffer transmit, the frame is gathered into the DMA buffer
+// and received back into a buffer allocated for it
+static bool loopback_link_out(emac_interface_t *emac, emac_stack_mem_t *buf)
+{
+    uint32_t len = 0;
+    for (emac_stack_mem_t *mem = buf; mem; mem = emac_stack_mem_chain_next(NULL, mem)) {
+        memcpy(loopback.dma + len, emac_stack_mem_ptr(NULL, mem), emac_stack_mem_len(NULL, mem));
+        len += emac_stack_mem_len(NULL, mem);
+    }
+
+    emac_stack_mem_t *rx = emac_stack_mem_alloc(NULL, len, 0);
+    TEST_ASSERT_NOT_NULL(rx);
+    memcpy(emac_stack_mem_ptr(NULL, rx), loopback.dma, len);
+    loopback_input(rx);
+    return true;
+}
+
+// Scatter-gather transmit into a posted receive buffer, the segments go
+// on the wire from where the stack built them
+static bool loopback_link_out_chain(emac_interface_t *emac, emac_stack_mem_chain_t *chain)
+{
+    for (emac_stack_mem_t *mem = chain; mem; mem = emac_stack_mem_chain_next(NULL, mem)) {
+        if (emac_stack_mem_ptr(NULL, mem) == payload) {
+            loopback.tx_in_place++;
+        }
+    }
+
+    if (!loopback.ring_count) {
+        // No receive buffer posted, the frame is lost
+        return true;
+    }
+
+    emac_stack_mem_chain_t *rx = loopback.ring[0];
+    loopback.ring_count--;
+    memmove(&loopback.ring[0], &loopback.ring[1], loopback.ring_count * sizeof(loopback.ring[0]));
+
+    emac_stack_mem_chain_set_len(NULL, rx, emac_stack_mem_chain_len(NULL, chain));
+    emac_stack_mem_copy(NULL, rx, chain);
+    loopback_input(rx);
+    return true;
+}
+
+static bool loopback_rx_post(emac_interface_t *emac, emac_stack_mem_chain_t *chain)
+{
+    if (loopback.ring_count == TEST_RX_RING) {
+        return false;
+    }
+
+    loopback.ring[loopback.ring_count++] = chain;
+    return true;
+}
+
+static bool loopback_power_up(emac_interface_t *emac)
+{
+    return true;
+}
+
+static void loopback_power_down(emac_interface_t *emac)
+{
+    while (loopback.ring_count) {
+        emac_stack_mem_free(NULL, loopback.ring[--loopback.ring_count]);
+    }
+}
+
+static void loopback_set_link_input_cb(emac_interface_t *emac, emac_link_input_fn input_cb, void *data)
+{
+    loopback.input_cb = input_cb;
+    loopback.input_data = data;
+}
+
+static void loopback_set_link_state_cb(emac_interface_t *emac, emac_link_state_change_fn state_cb, void *data)
+{
+}
+
+static uint32_t loopback_get_capabilities(emac_interface_t *emac)
+{
+    return loopback_caps;
+}
+
+static emac_interface_t legacy_emac = {
+    {
+        loopback_get_mtu_size,
+        loopback_get_ifname,
+        loopback_get_hwaddr_size,
+        loopback_get_hwaddr,
+        loopback_set_hwaddr,
+        loopback_link_out,
+        loopback_power_up,
+        loopback_power_down,
+        loopback_set_link_input_cb,
+        loopback_set_link_state_cb,
+        NULL,
+        NULL,
+        NULL,
+    },
+    NULL
+};
+
+static emac_interface_t zero_copy_emac = {
+    {
+        loopback_get_mtu_size,
+        loopback_get_ifname,
+        loopback_get_hwaddr_size,
+        loopback_get_hwaddr,
+        loopback_set_hwaddr,
+        loopback_link_out,
+        loopback_power_up,
+        loopback_power_down,
+        loopback_set_link_input_cb,
+        loopback_set_link_state_cb,
+        loopback_link_out_chain,
+        loopback_get_capabilities,
+        loopback_rx_post,
+    },
+    NULL
+};
+
+// Application end, checks the datagram and if it is still in the memory
+// the driver received it in
+static void loopback_udp_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p,
+                              const ip_addr_t *addr, u16_t port)
+{
+    uint8_t check[TEST_PAYLOAD_LEN];
+    TEST_ASSERT_EQUAL(TEST_PAYLOAD_LEN, p->tot_len);
+    pbuf_copy_partial(p, check, TEST_PAYLOAD_LEN, 0);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, check, TEST_PAYLOAD_LEN);
+
+    if (p == (struct pbuf *)loopback.rx_last) {
+        loopback.app_in_place++;
+    }
+    loopback.app_packets++;
+    pbuf_free(p);
+    received.release();
+}
+
+// Sends datagrams through the real stack, from a UDP pcb down to the EMAC
+// and back up to the pcb, and returns the copies the stack counted
+static void run_loopback(emac_interface_t *emac, emac_lwip_copy_stats_t *copies)
+{
+    emac_lwip_copy_stats_t before, after;
+    ip4_addr_t addr, mask, gw, bcast;
+
+    memset(&loopback, 0, sizeof loopback);
+    for (int i = 0; i < TEST_PAYLOAD_LEN; i++) {
+        payload[i] = i;
+    }
+    IP4_ADDR(&addr, 10, 0, 0, 1);
+    IP4_ADDR(&mask, 255, 255, 255, 0);
+    IP4_ADDR(&gw, 10, 0, 0, 254);
+    IP4_ADDR(&bcast, 10, 0, 0, 255);
+
+    LOCK_TCPIP_CORE();
+    TEST_ASSERT_NOT_NULL(netif_add(&loopback_netif, &addr, &mask, &gw,
+                                   emac, emac_lwip_if_init, tcpip_input));
+    netif_set_up(&loopback_netif);
+    netif_set_link_up(&loopback_netif);
+    struct udp_pcb *pcb = udp_new();
+    TEST_ASSERT_NOT_NULL(pcb);
+    TEST_ASSERT_EQUAL(ERR_OK, udp_bind(pcb, IP_ADDR_ANY, TEST_PORT));
+    udp_recv(pcb, loopback_udp_recv, NULL);
+    UNLOCK_TCPIP_CORE();
+
+    // Counted from here on, leaving out the gratuitous ARP of the link up
+    wait_ms(100);
+    loopback.tx_in_place = 0;
+    emac_lwip_get_copy_stats(&before);
+
+    for (int i = 0; i < TEST_PACKETS; i++) {
+        // Payload referenced from the application, as UDPSocket::sendto
+        // does with netbuf_ref
+        struct pbuf *data = pbuf_alloc(PBUF_TRANSPORT, TEST_PAYLOAD_LEN, PBUF_REF);
+        TEST_ASSERT_NOT_NULL(data);
+        data->payload = payload;
+
+        LOCK_TCPIP_CORE();
+        TEST_ASSERT_EQUAL(ERR_OK, udp_sendto(pcb, data, (ip_addr_t *)&bcast, TEST_PORT));
+        UNLOCK_TCPIP_CORE();
+        pbuf_free(data);
+
+        TEST_ASSERT_TRUE(received.wait(1000) > 0);
+    }
+    emac_lwip_get_copy_stats(&after);
+
+    LOCK_TCPIP_CORE();
+    udp_remove(pcb);
+    netif_remove(&loopback_netif);
+    UNLOCK_TCPIP_CORE();
+    loopback_power_down(emac);
+
+    copies->tx_frames = after.tx_frames - before.tx_frames;
+    copies->tx_gathered = after.tx_gathered - before.tx_gathered;
+    copies->rx_frames = after.rx_frames - before.rx_frames;
+    copies->rx_copied = after.rx_copied - before.rx_copied;
+    copies->rx_posted = after.rx_posted - before.rx_posted;
+
+    TEST_ASSERT_EQUAL(TEST_PACKETS, loopback.app_packets);
+    TEST_ASSERT_EQUAL(TEST_PACKETS, copies->rx_frames);
+    printf("MBED: %u packets, %u tx gathered, %u rx copied, %u in place to the driver, %u in place to the application\r\n",
+           (unsigned)copies->tx_frames, (unsigned)copies->tx_gathered, (unsigned)copies->rx_copied,
+           loopback.tx_in_place, loopback.app_in_place);
+}
+
+void test_emac_legacy_copies()
+{
+    emac_lwip_copy_stats_t copies;
+
+    loopback_caps = 0;
+    run_loopback(&legacy_emac, &copies);
+
+    // Each frame is gathered on the way out and copied on the way in
+    TEST_ASSERT_EQUAL(TEST_PACKETS, copies.tx_gathered);
+    TEST_ASSERT_EQUAL(TEST_PACKETS, copies.rx_copied);
+    TEST_ASSERT_EQUAL(0, copies.rx_posted);
+    TEST_ASSERT_EQUAL(TEST_PACKETS, loopback.app_in_place);
+}
+
+void test_emac_zero_copy()
+{
+    emac_lwip_copy_stats_t copies;
+
+    loopback_caps = EMAC_CAP_RX_POOL;
+    run_loopback(&zero_copy_emac, &copies);
+
+    // The application data reaches the driver where the application left
+    // it, and the received frame reaches the application in the pool
+    // buffer the stack posted to the driver
+    TEST_ASSERT_EQUAL(0, copies.tx_gathered);
+    TEST_ASSERT_EQUAL(0, copies.rx_copied);
+    TEST_ASSERT_TRUE(copies.rx_posted >= TEST_PACKETS);
+    TEST_ASSERT_EQUAL(TEST_PACKETS, loopback.tx_in_place);
+    TEST_ASSERT_EQUAL(TEST_PACKETS, loopback.app_in_place);
+}
+
+void test_emac_checksum_offload()
+{
+    loopback_caps = EMAC_CAP_TX_CHECKSUM_IP | EMAC_CAP_TX_CHECKSUM_UDP | EMAC_CAP_RX_CHECKSUM_TCP;
+
+    LOCK_TCPIP_CORE();
+    TEST_ASSERT_NOT_NULL(netif_add(&loopback_netif, NULL, NULL, NULL,
+                                   &zero_copy_emac, emac_lwip_if_init, tcpip_input));
+    UNLOCK_TCPIP_CORE();
+
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    TEST_ASSERT_FALSE(loopback_netif.chksum_flags & NETIF_CHECKSUM_GEN_IP);
+    TEST_ASSERT_FALSE(loopback_netif.chksum_flags & NETIF_CHECKSUM_GEN_UDP);
+    TEST_ASSERT_FALSE(loopback_netif.chksum_flags & NETIF_CHECKSUM_CHECK_TCP);
+    TEST_ASSERT_TRUE(loopback_netif.chksum_flags & NETIF_CHECKSUM_GEN_TCP);
+    TEST_ASSERT_TRUE(loopback_netif.chksum_flags & NETIF_CHECKSUM_CHECK_UDP);
+#endif
+
+    LOCK_TCPIP_CORE();
+    netif_remove(&loopback_netif);
+    UNLOCK_TCPIP_CORE();
+    loopback_power_down(&zero_copy_emac);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    tcpip_init(NULL, NULL);
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("EMAC legacy link_out copies", test_emac_legacy_copies),
+    Case("EMAC scatter-gather and rx pool copies", test_emac_zero_copy),
+    Case("EMAC checksum offload flags", test_emac_checksum_offload),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
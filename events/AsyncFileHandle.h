@@ -0,0 +1,122 @@
+/* events
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASYNC_FILE_HANDLE_H
+#define ASYNC_FILE_HANDLE_H
+
+#include "events/AsyncTask.h"
+#include "platform/FileHandle.h"
+#include "platform/NonCopyable.h"
+#include <errno.h>
+
+namespace events {
+/** \addtogroup events */
+
+/** AsyncFileHandle
+ *
+ *  Adapter to await a FileHandle from an AsyncTask
+ *
+ *  The FileHandle is set to non-blocking mode and its sigio wakes up the
+ *  task, so the awaits of the task on the FileHandle are evaluated again
+ *  when its state changes instead of being polled.
+ *
+ *  @code
+ *  ASYNC_AWAIT(_serial.try_read(_buffer, sizeof(_buffer), &_size));
+ *  @endcode
+ *
+ *  @note FileHandles without sigio, such as the files of a file system,
+ *  never return -EAGAIN so their awaits don't suspend the task.
+ *
+ * @ingroup events
+ */
+class AsyncFileHandle : private mbed::NonCopyable<AsyncFileHandle> {
+public:
+    /** Attach a FileHandle to a task
+     *
+     *  @param task     Task awaiting the FileHandle
+     *  @param fh       FileHandle, set to non-blocking mode
+     */
+    AsyncFileHandle(AsyncTask *task, mbed::FileHandle *fh)
+        : _fh(fh) {
+        _fh->set_blocking(false);
+        _fh->sigio(mbed::callback(task, &AsyncTask::wake));
+    }
+
+    /** Detach the FileHandle from the task
+     *
+     *  The FileHandle is left in non-blocking mode.
+     */
+    ~AsyncFileHandle() {
+        _fh->sigio(NULL);
+    }
+
+    /** Check if the FileHandle can be read, for use in an await
+     *
+     *  @return         True if data can be read, or on hang up or error
+     */
+    bool readable() const {
+        return _fh->poll(POLLIN) & (POLLIN | POLLHUP | POLLERR | POLLNVAL);
+    }
+
+    /** Check if the FileHandle can be written, for use in an await
+     *
+     *  @return         True if data can be written, or on hang up or error
+     */
+    bool writable() const {
+        return _fh->poll(POLLOUT) & (POLLOUT | POLLHUP | POLLERR | POLLNVAL);
+    }
+
+    /** Try to read from the FileHandle, for use in an await
+     *
+     *  @param buffer   Buffer to read into
+     *  @param size     Size of the buffer in bytes
+     *  @param result   Where to store the number of bytes read or the
+     *                  negative error code of the read
+     *  @return         False if the read would block
+     */
+    bool try_read(void *buffer, size_t size, ssize_t *result) {
+        *result = _fh->read(buffer, size);
+        return *result != -EAGAIN;
+    }
+
+    /** Try to write to the FileHandle, for use in an await
+     *
+     *  @param buffer   Data to write
+     *  @param size     Size of the data in bytes
+     *  @param result   Where to store the number of bytes written or the
+     *                  negative error code of the write
+     *  @return         False if the write would block
+     */
+    bool try_write(const void *buffer, size_t size, ssize_t *result) {
+        *result = _fh->write(buffer, size);
+        return *result != -EAGAIN;
+    }
+
+    /** FileHandle of the adapter
+     *
+     *  @return         FileHandle attached to the task
+     */
+    mbed::FileHandle *handle() const {
+        return _fh;
+    }
+
+private:
+    mbed::FileHandle *_fh;
+};
+
+}
+
+#endif
@@ -0,0 +1,179 @@
+/* events
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "events/AsyncTask.h"
+
+#include "platform/mbed_critical.h"
+
+using namespace events;
+
+// Task state
+enum {
+    ASYNC_FINISHED  = 0x01,
+    ASYNC_DEADLINE  = 0x02,
+    ASYNC_TIMED_OUT = 0x04,
+    ASYNC_POLL      = 0x08,
+};
+
+AsyncTask::AsyncTask(EventQueue *queue)
+    : _async_line(0), _queue(queue), _flags(ASYNC_FINISHED), _pending(0),
+      _deadline(0), _timer(0), _wake(0) {
+}
+
+AsyncTask::~AsyncTask() {
+    _flags |= ASYNC_FINISHED;
+    if (_timer) {
+        _queue->cancel(_timer);
+    }
+    if (_pending) {
+        _queue->cancel(_wake);
+    }
+}
+
+void AsyncTask::start() {
+    _async_line = 0;
+    _flags = 0;
+    wake();
+}
+
+void AsyncTask::cancel() {
+    _flags |= ASYNC_FINISHED;
+    if (_timer) {
+        _queue->cancel(_timer);
+        _timer = 0;
+    }
+}
+
+void AsyncTask::wake() {
+    // A single wake up event is pending at a time, the task evaluates its
+    // await when it runs so the wake ups in between are not lost
+    uint8_t pending = 0;
+    if (!core_util_atomic_cas_u8((uint8_t *)&_pending, &pending, 1)) {
+        return;
+    }
+
+    int id = _queue->call(this, &AsyncTask::resume);
+    if (id) {
+        _wake = id;
+    } else {
+        // No memory for the event, the task resumes at its next timeout
+        _pending = 0;
+    }
+}
+
+bool AsyncTask::finished() const {
+    return _flags & ASYNC_FINISHED;
+}
+
+bool AsyncTask::timed_out() const {
+    return _flags & ASYNC_TIMED_OUT;
+}
+
+void AsyncTask::poll() {
+    _flags |= ASYNC_POLL;
+}
+
+#ifdef MBED_CONF_RTOS_PRESENT
+bool AsyncTask::try_acquire(rtos::Semaphore &sem) {
+    if (sem.wait(0) > 0) {
+        return true;
+    }
+
+    poll();
+    return false;
+}
+
+bool AsyncTask::try_wait_flags(rtos::EventFlags &flags, uint32_t mask,
+                               bool all, bool clear, uint32_t *result) {
+    uint32_t set = all ? flags.wait_all(mask, 0, clear)
+                       : flags.wait_any(mask, 0, clear);
+    if (!(set & osFlagsError)) {
+        if (result) {
+            *result = set;
+        }
+        return true;
+    }
+
+    poll();
+    return false;
+}
+#endif
+
+void AsyncTask::_async_await(uint16_t line, int ms) {
+    _async_line = line;
+    _flags &= ~(ASYNC_DEADLINE | ASYNC_TIMED_OUT);
+    if (ms >= 0) {
+        _deadline = _queue->tick() + ms;
+        _flags |= ASYNC_DEADLINE;
+    }
+}
+
+bool AsyncTask::_async_expired() {
+    if (!(_flags & ASYNC_DEADLINE) ||
+            (int)(_queue->tick() - _deadline) < 0) {
+        return false;
+    }
+
+    _flags = (_flags & ~ASYNC_DEADLINE) | ASYNC_TIMED_OUT;
+    return true;
+}
+
+void AsyncTask::_async_exit() {
+    _flags |= ASYNC_FINISHED;
+}
+
+void AsyncTask::resume() {
+    // Cleared before running, a wake up during run() posts a new event
+    _pending = 0;
+    step();
+}
+
+void AsyncTask::expire() {
+    _timer = 0;
+    step();
+}
+
+void AsyncTask::step() {
+    if (_timer) {
+        _queue->cancel(_timer);
+        _timer = 0;
+    }
+
+    if (_flags & ASYNC_FINISHED) {
+        return;
+    }
+
+    _flags &= ~ASYNC_POLL;
+    run();
+    if (_flags & ASYNC_FINISHED) {
+        return;
+    }
+
+    // Suspended in an await, resume at its deadline or to poll it
+    int delay = -1;
+    if (_flags & ASYNC_DEADLINE) {
+        int left = (int)(_deadline - _queue->tick());
+        delay = left > 0 ? left : 0;
+    }
+
+    if ((_flags & ASYNC_POLL) &&
+            (delay < 0 || delay > ASYNC_TASK_POLL_INTERVAL)) {
+        delay = ASYNC_TASK_POLL_INTERVAL;
+    }
+
+    if (delay >= 0) {
+        _timer = _queue->call_in(delay, this, &AsyncTask::expire);
+    }
+}
@@ -0,0 +1,258 @@
+/* events
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASYNC_TASK_H
+#define ASYNC_TASK_H
+
+#include "events/EventQueue.h"
+#include "platform/NonCopyable.h"
+#include <stdint.h>
+
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "rtos/Semaphore.h"
+#include "rtos/EventFlags.h"
+#endif
+
+namespace events {
+/** \addtogroup events */
+
+/** ASYNC_TASK_POLL_INTERVAL
+ *  Interval in milliseconds at which a task awaiting a Semaphore or
+ *  EventFlags checks them again, see AsyncTask::try_acquire
+ */
+#ifdef MBED_CONF_EVENTS_ASYNC_POLL_INTERVAL
+#define ASYNC_TASK_POLL_INTERVAL MBED_CONF_EVENTS_ASYNC_POLL_INTERVAL
+#else
+#define ASYNC_TASK_POLL_INTERVAL 10
+#endif
+
+/** Start the body of AsyncTask::run */
+#define ASYNC_BEGIN() switch (_async_line) { case 0:
+
+/** End the body of AsyncTask::run, the task is finished when it gets there */
+#define ASYNC_END() } _async_exit()
+
+/** Suspend the task until cond is true
+ *
+ *  cond is evaluated again each time the task is woken up.
+ */
+#define ASYNC_AWAIT(cond) ASYNC_AWAIT_FOR(cond, -1)
+
+/** Suspend the task until cond is true or ms milliseconds have passed
+ *
+ *  After the await, AsyncTask::timed_out tells if the time ran out.
+ */
+#define ASYNC_AWAIT_FOR(cond, ms)                                   \
+    do {                                                            \
+        _async_await(__LINE__, ms);                                 \
+        if (0) {                                                    \
+        case __LINE__:;                                             \
+        }                                                           \
+        if (!(cond) && !_async_expired()) {                         \
+            return;                                                 \
+        }                                                           \
+    } while (0)
+
+/** Suspend the task for ms milliseconds */
+#define ASYNC_DELAY(ms) ASYNC_AWAIT_FOR(false, ms)
+
+/** Let the other events of the queue run before the task goes on */
+#define ASYNC_YIELD()                                               \
+    do {                                                            \
+        _async_await(__LINE__, 0);                                  \
+        return;                                                     \
+        case __LINE__:;                                             \
+    } while (0)
+
+/** Finish the task from anywhere in AsyncTask::run */
+#define ASYNC_EXIT()                                                \
+    do {                                                            \
+        _async_exit();                                              \
+        return;                                                     \
+    } while (0)
+
+
+/** AsyncTask
+ *
+ *  Stackless task dispatched by an EventQueue
+ *
+ *  A task runs on the stack of the thread dispatching its queue, so any
+ *  number of tasks share one stack instead of owning one each. The task
+ *  is a resumable function: run() is called again each time the task is
+ *  woken up and jumps back to the await where it was suspended, in the
+ *  style of protothreads.
+ *
+ *  @code
+ *  class Blinky : public AsyncTask {
+ *  public:
+ *      Blinky(EventQueue *queue, rtos::Semaphore *sem)
+ *          : AsyncTask(queue), _sem(sem), _count(0) {}
+ *
+ *  protected:
+ *      virtual void run() {
+ *          ASYNC_BEGIN();
+ *          for (_count = 0; _count < 10; _count++) {
+ *              ASYNC_AWAIT_FOR(try_acquire(*_sem), 500);
+ *              led = !led;
+ *          }
+ *          ASYNC_END();
+ *      }
+ *
+ *  private:
+ *      rtos::Semaphore *_sem;
+ *      int _count;
+ *  };
+ *  @endcode
+ *
+ *  @note
+ *  The local variables of run() are lost when the task is suspended, the
+ *  state that lives across awaits must be kept in members of the task.
+ *  The awaits are case labels of a switch statement: they cannot be used
+ *  inside a switch statement of run() and only one of them fits on a line.
+ *
+ *  @note
+ *  The events that resume the task are allocated from the queue, which
+ *  needs room for one timeout and one wake up event per task.
+ *
+ * @ingroup events
+ */
+class AsyncTask : private mbed::NonCopyable<AsyncTask> {
+public:
+    /** Create an AsyncTask
+     *
+     *  @param queue    Event queue dispatching the task
+     */
+    AsyncTask(EventQueue *queue);
+
+    /** Destroy an AsyncTask
+     *
+     *  @note The task must be destroyed from the thread dispatching its
+     *  queue, or once the queue is not dispatched anymore.
+     */
+    virtual ~AsyncTask();
+
+    /** Start the task
+     *
+     *  run() is called from the beginning by the event queue. A finished
+     *  or cancelled task can be started again.
+     *
+     *  @note A task that is not finished must be started again from the
+     *  thread dispatching its queue.
+     */
+    void start();
+
+    /** Cancel the task
+     *
+     *  The task is not resumed anymore and is finished.
+     *
+     *  @note The cancel function must be called from the thread
+     *  dispatching the queue of the task.
+     */
+    void cancel();
+
+    /** Wake up the task
+     *
+     *  The condition of the current await is evaluated again from the
+     *  event queue. Waking up a task that is not waiting has no effect.
+     *
+     *  The wake function is thread and irq safe, it is the callback to
+     *  attach to the sigio of sockets and FileHandles.
+     */
+    void wake();
+
+    /** Check if the task is finished
+     *
+     *  @return         True if the task got to its end, exited or was
+     *                  cancelled
+     */
+    bool finished() const;
+
+protected:
+    /** Body of the task
+     *
+     *  Starts with ASYNC_BEGIN() and ends with ASYNC_END(), in between
+     *  the task is suspended with the ASYNC_AWAIT macros.
+     */
+    virtual void run() = 0;
+
+    /** Check if the last await ran out of time
+     *
+     *  @return         True if the time of the last ASYNC_AWAIT_FOR ran
+     *                  out before its condition got true
+     */
+    bool timed_out() const;
+
+    /** Ask to evaluate the condition of the current await again later
+     *
+     *  For conditions on objects that can't wake up the task, the await
+     *  is then checked every ASYNC_TASK_POLL_INTERVAL milliseconds.
+     */
+    void poll();
+
+#ifdef MBED_CONF_RTOS_PRESENT
+    /** Try to acquire a semaphore, for use in an await
+     *
+     *  A Semaphore can't wake up the task when it is released, so the
+     *  await polls it unless the releasing side also calls wake().
+     *
+     *  @param sem      Semaphore to acquire
+     *  @return         True if a token was acquired
+     */
+    bool try_acquire(rtos::Semaphore &sem);
+
+    /** Try to wait for event flags, for use in an await
+     *
+     *  Like a Semaphore, EventFlags are polled unless the side setting
+     *  them also calls wake().
+     *
+     *  @param flags    EventFlags to wait for
+     *  @param mask     Flags to wait for
+     *  @param all      True to wait for all the flags of mask, false for
+     *                  any of them (default to false)
+     *  @param clear    Clear the flags that were waited for
+     *                  (default to true)
+     *  @param result   Where to store the flags that were set
+     *                  (default to NULL)
+     *  @return         True if the flags were set
+     */
+    bool try_wait_flags(rtos::EventFlags &flags, uint32_t mask,
+                        bool all = false, bool clear = true,
+                        uint32_t *result = NULL);
+#endif
+
+    // Used by the ASYNC macros
+    void _async_await(uint16_t line, int ms);
+    bool _async_expired();
+    void _async_exit();
+
+    uint16_t _async_line;
+
+private:
+    void resume();
+    void expire();
+    void step();
+
+    EventQueue *_queue;
+    uint8_t _flags;
+    volatile uint8_t _pending;
+    unsigned _deadline;
+    int _timer;
+    volatile int _wake;
+};
+
+}
+
+#endif
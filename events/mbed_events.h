@@ -27,6 +27,8 @@
 
 #include "events/EventQueue.h"
 #include "events/Event.h"
+#include "events/AsyncTask.h"
+#include "events/AsyncFileHandle.h"
 
 #include "events/mbed_shared_queues.h"
 
@@ -155,11 +155,14 @@ typedef enum sn_coap_status_ {
     COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING = 3, /**< User will get whole message after all message blocks received.
                                                          User must release messages with this status. */
     COAP_STATUS_PARSER_BLOCKWISE_ACK           = 4, /**< Acknowledgement for sent Blockwise message received */
-    COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED  = 5, /**< Blockwise message received but not supported by compiling switch */
+    COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED  = 5, /**< Blockwise message received but not supported by compiling switch,
+                                                         or streamed transfer aborted. User must release messages with this status. */
     COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED  = 6, /**< Blockwise message fully received and returned to app.
                                                          User must take care of releasing whole payload of the blockwise messages */
-    COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED = 7  /**< When re-transmissions have been done and ACK not received, CoAP library calls
+    COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED = 7, /**< When re-transmissions have been done and ACK not received, CoAP library calls
                                                          RX callback with this status */
+    COAP_STATUS_PARSER_BLOCKWISE_MSG_STREAMED  = 8  /**< Last block of a transfer given to the block stream callback.
+                                                         Payload is the last block only, released with the message */
 } sn_coap_status_e;
 
 
@@ -208,6 +211,7 @@ typedef struct sn_coap_options_list_ {
  */
 typedef struct sn_coap_hdr_ {
     uint8_t                 token_len;          /**< 1-8 bytes. */
+    uint8_t                 arena;              /**< Set if parsed by sn_coap_parser_into(). Not for user */
 
     sn_coap_status_e        coap_status;        /**< Used for telling to User special cases when parsing message */
     sn_coap_msg_code_e      msg_code;           /**< Empty: 0; Requests: 1-31; Responses: 64-191 */
@@ -227,6 +231,37 @@ typedef struct sn_coap_hdr_ {
     sn_coap_options_list_s *options_list_ptr;   /**< Must be set to NULL if not used */
 } sn_coap_hdr_s;
 
+/**
+ * \brief One piece of a CoAP packet built by sn_coap_builder_scatter()
+ */
+typedef struct sn_coap_iovec_ {
+    const uint8_t          *ptr;
+    uint16_t                len;
+} sn_coap_iovec_s;
+
+/** Pieces of a packet built by sn_coap_builder_scatter(): head and payload */
+#define SN_COAP_SCATTER_IOV_COUNT 2
+
+/**
+ * \brief Memory for messages parsed without the heap
+ *
+ * Set up with sn_coap_arena_init(). Each sn_coap_parser_into() takes what it
+ * needs from the unused part and nothing is given back until the arena is
+ * initialised again.
+ */
+typedef struct sn_coap_arena_ {
+    uint8_t                *buf_ptr;
+    uint16_t                size;
+    uint16_t                used;
+} sn_coap_arena_s;
+
+/**
+ * \brief Arena size for which sn_coap_parser_into() never runs out, for any
+ *        message of at most len bytes
+ */
+#define SN_COAP_PARSER_ARENA_SIZE(len) \
+    (sizeof(sn_coap_hdr_s) + sizeof(sn_coap_options_list_s) + (len) + 8 * sizeof(void *))
+
 /* * * * * * * * * * * * * * */
 /* * * * ENUMERATIONS  * * * */
 /* * * * * * * * * * * * * * */
@@ -304,6 +339,52 @@ typedef struct sn_nsdl_addr_ {
  */
 extern sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr);
 
+/**
+ * \fn void sn_coap_arena_init(sn_coap_arena_s *arena_ptr, uint8_t *buf_ptr, uint16_t size)
+ *
+ * \brief Sets up an arena for sn_coap_parser_into(), or empties it again
+ *
+ *        Messages parsed into the arena before are no longer valid.
+ *
+ * \param *arena_ptr is the arena to set up
+ *
+ * \param *buf_ptr is memory for the arena, SN_COAP_PARSER_ARENA_SIZE(len) bytes
+ *        for one message of up to len bytes
+ *
+ * \param size is size of buf_ptr
+ */
+extern void sn_coap_arena_init(sn_coap_arena_s *arena_ptr, uint8_t *buf_ptr, uint16_t size);
+
+/**
+ * \fn sn_coap_hdr_s *sn_coap_parser_into(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
+ *
+ * \brief Parses CoAP message from given Packet data without allocating from the heap
+ *
+ *        As sn_coap_parser(), except that the message and its options list
+ *        are taken from the arena, and the token and option values point into
+ *        the Packet data, as the payload always did. Only options made of
+ *        several parts (Uri-Path, Uri-Query, ...) are joined in the arena.
+ *        The message is valid while both the arena and the Packet data are.
+ *        sn_coap_parser_release_allocated_coap_msg_mem() may still be called
+ *        for it, and releases nothing.
+ *
+ * \param *handle Pointer to CoAP library handle
+ *
+ * \param *arena_ptr is arena the message is parsed into
+ *
+ * \param packet_data_len is length of given Packet data to be parsed to CoAP message
+ *
+ * \param *packet_data_ptr is source for Packet data to be parsed to CoAP message
+ *
+ * \param *coap_version_ptr is destination for parsed CoAP specification version
+ *
+ * \return Return value is pointer to parsed CoAP message.\n
+ *         In following failure cases NULL is returned:\n
+ *          -Failure in given pointer (= NULL)\n
+ *          -Not enough room left in the arena
+ */
+extern sn_coap_hdr_s *sn_coap_parser_into(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr);
+
 /**
  * \fn void sn_coap_parser_release_allocated_coap_msg_mem(struct coap_s *handle, sn_coap_hdr_s *freed_coap_msg_ptr)
  *
@@ -376,6 +457,31 @@ extern int16_t sn_coap_builder_2(uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *sr
  */
 extern uint16_t sn_coap_builder_calc_needed_packet_data_size_2(sn_coap_hdr_s *src_coap_msg_ptr, uint16_t blockwise_payload_size);
 
+/**
+ * \fn int16_t sn_coap_builder_scatter(uint8_t *dst_head_ptr, uint16_t dst_head_size, sn_coap_hdr_s *src_coap_msg_ptr, sn_coap_iovec_s *dst_iov_ptr)
+ *
+ * \brief Builds an outgoing message as head and payload, without copying the payload.
+ *
+ *        Header, token, options and Payload marker are built to dst_head_ptr.
+ *        dst_iov_ptr[0] is set to the head and dst_iov_ptr[1] to the payload
+ *        of src_coap_msg_ptr, which is not limited to any block size. Sending
+ *        both pieces in order gives the same Packet data as sn_coap_builder().
+ *
+ * \param *dst_head_ptr is pointer to destination for the head
+ *
+ * \param dst_head_size is size of dst_head_ptr
+ *
+ * \param *src_coap_msg_ptr is pointer to source structure for building Packet data
+ *
+ * \param *dst_iov_ptr is destination for SN_COAP_SCATTER_IOV_COUNT pieces
+ *
+ * \return Return value is byte count of whole Packet data. In failure cases:\n
+ *          -1 = Failure in given CoAP header structure\n
+ *          -2 = Failure in given pointer (= NULL)\n
+ *          -3 = Head does not fit in dst_head_size
+ */
+extern int16_t sn_coap_builder_scatter(uint8_t *dst_head_ptr, uint16_t dst_head_size, sn_coap_hdr_s *src_coap_msg_ptr, sn_coap_iovec_s *dst_iov_ptr);
+
 /**
  * \fn sn_coap_hdr_s *sn_coap_build_response(struct coap_s *handle, sn_coap_hdr_s *coap_packet_ptr, uint8_t msg_code)
  *
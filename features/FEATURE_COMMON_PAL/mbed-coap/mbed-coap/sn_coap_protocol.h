@@ -90,6 +90,56 @@ extern int8_t sn_coap_protocol_destroy(struct coap_s *handle);
  */
 extern int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *src_coap_msg_ptr, void *param);
 
+/**
+ * \fn int16_t sn_coap_protocol_build_scatter(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint8_t *dst_head_ptr, uint16_t dst_head_size, sn_coap_hdr_s *src_coap_msg_ptr, sn_coap_iovec_s *dst_iov_ptr, void *param)
+ *
+ * \brief Builds message to be sent as head and payload, without copying the payload
+ *
+ *        As sn_coap_protocol_build(), except that only the head is built, by
+ *        sn_coap_builder_scatter(), and the packet is sent as the pieces in
+ *        dst_iov_ptr. When a scatter tx callback is set, a Confirmable message
+ *        is stored for resending as the head and a reference to the payload,
+ *        which must then stay valid until the message is acknowledged, fails
+ *        or is deleted. Otherwise the payload is copied as before.
+ *        Messages needing blockwise transfer are built with sn_coap_protocol_build().
+ *
+ * \param *dst_addr_ptr is pointer to destination address where CoAP message will be sent
+ *
+ * \param *dst_head_ptr is pointer to destination for the head
+ *
+ * \param dst_head_size is size of dst_head_ptr
+ *
+ * \param *src_coap_msg_ptr is pointer to source of built Packet data
+ *
+ * \param *dst_iov_ptr is destination for SN_COAP_SCATTER_IOV_COUNT pieces of the packet
+ *
+ * \param param void pointer that will be passed to tx/rx function callback when those are called.
+ *
+ * \return Return value is byte count of whole Packet data.\n
+ *         In failure cases:\n
+ *          -1 = Failure in CoAP header structure, or message needs blockwise transfer\n
+ *          -2 = Failure in given pointer (= NULL)\n
+ *          -3 = Head does not fit in dst_head_size\n
+ *          -4 = Failure in Resending message store
+ */
+extern int16_t sn_coap_protocol_build_scatter(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint8_t *dst_head_ptr, uint16_t dst_head_size, sn_coap_hdr_s *src_coap_msg_ptr, sn_coap_iovec_s *dst_iov_ptr, void *param);
+
+/**
+ * \fn int8_t sn_coap_protocol_set_tx_scatter_callback(struct coap_s *handle, uint8_t (*used_tx_scatter_callback_ptr)(const sn_coap_iovec_s *, uint8_t, sn_nsdl_addr_s *, void *))
+ *
+ * \brief Sets callback for resending messages built by sn_coap_protocol_build_scatter()
+ *
+ *        The callback sends the given pieces, in order, as one datagram. It is
+ *        only used for resending messages whose payload was not copied, so it
+ *        must not be removed while such messages are waiting.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param used_tx_scatter_callback_ptr Callback, NULL to copy the payload of stored messages again
+ *
+ * \return  0 = success, -1 = failure
+ */
+extern int8_t sn_coap_protocol_set_tx_scatter_callback(struct coap_s *handle, uint8_t (*used_tx_scatter_callback_ptr)(const sn_coap_iovec_s *, uint8_t, sn_nsdl_addr_s *, void *));
+
 /**
  * \fn sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr)
  *
@@ -114,6 +164,34 @@ extern int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst
  */
 extern sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, void *);
 
+/**
+ * \fn sn_coap_hdr_s *sn_coap_protocol_parse_into(struct coap_s *handle, sn_coap_arena_s *arena_ptr, sn_nsdl_addr_s *src_addr_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, void *param)
+ *
+ * \brief Parses received CoAP message from given Packet data without allocating it from the heap
+ *
+ *        As sn_coap_protocol_parse(), but the message is parsed with
+ *        sn_coap_parser_into() and so is valid only while the arena and the
+ *        Packet data are. The whole payload of a received blockwise message
+ *        (COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED) is still allocated, and
+ *        released by the User as before.
+ *
+ * \param *handle Pointer to CoAP library handle
+ *
+ * \param *arena_ptr is arena the message is parsed into, see sn_coap_arena_init()
+ *
+ * \param *src_addr_ptr is pointer to source address of received CoAP message
+ *
+ * \param packet_data_len is length of given Packet data to be parsed to CoAP message
+ *
+ * \param *packet_data_ptr is pointer to source of Packet data to be parsed to CoAP message
+ *
+ * \param param void pointer that will be passed to tx/rx function callback when those are called.
+ *
+ * \return Return value is pointer to parsed CoAP message structure, or NULL
+ *         as sn_coap_protocol_parse(), or if the arena is too small
+ */
+extern sn_coap_hdr_s *sn_coap_protocol_parse_into(struct coap_s *handle, sn_coap_arena_s *arena_ptr, sn_nsdl_addr_s *src_addr_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, void *param);
+
 /**
  * \fn int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time)
  *
@@ -247,6 +325,44 @@ extern int8_t sn_coap_convert_block_size(uint16_t block_size);
  */
 extern int8_t sn_coap_protocol_handle_block2_response_internally(struct coap_s *handle, uint8_t handle_response);
 
+/**
+ * \fn int8_t sn_coap_protocol_set_block_stream_callback(struct coap_s *handle, int8_t (*block_stream_cb)(...))
+ *
+ * \brief Streams received blockwise transfers to the application instead of reassembling them.
+ *
+ * Once set, every received Block1 request and, when block 2 responses are handled internally,
+ * every Block2 response is given to the callback one block at a time, in order, and then
+ * dropped. Only a small state per transfer is kept, so the size of a transfer is not limited by
+ * SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE or by the heap. The message with the last block is
+ * returned by the parser with status COAP_STATUS_PARSER_BLOCKWISE_MSG_STREAMED, and the
+ * application responds to it as to a normal request.
+ *
+ * The callback gets the received message, with the block as payload, the offset of the block in
+ * the whole transfer and whether it is the last one. It returns 0 to continue, 1 to hold the ACK
+ * or the request for the next block until sn_coap_protocol_block_stream_resume() is called, or
+ * a negative value to abort the transfer.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param block_stream_cb Callback, NULL to reassemble transfers again
+ *
+ * \return  0 = success, -1 = failure
+ */
+extern int8_t sn_coap_protocol_set_block_stream_callback(struct coap_s *handle,
+        int8_t (*block_stream_cb)(struct coap_s *, sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t offset, uint8_t last, void *));
+
+/**
+ * \fn int8_t sn_coap_protocol_block_stream_resume(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
+ *
+ * \brief Sends the ACK or next block request held by the block stream callback for a transfer.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param *addr_ptr Address of the transfer's peer
+ * \param msg_id Message ID of the block the callback held the transfer for
+ *
+ * \return  0 = success, -1 = no held transfer matching the address and message ID
+ */
+extern int8_t sn_coap_protocol_block_stream_resume(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t msg_id);
+
 #endif /* SN_COAP_PROTOCOL_H_ */
 
 #ifdef __cplusplus
@@ -73,6 +73,16 @@ struct sn_coap_hdr_;
 
 #define RESPONSE_RANDOM_FACTOR                          1.5   /**< Resending random factor, value is specified in IETF CoAP specification */
 
+/* Number of buckets in the tables used to look up re-sending and duplication detection messages by address, */
+/* port and message ID. Must be a power of two. Raise it with the queue sizes to keep lookups short.          */
+#ifndef SN_COAP_LOOKUP_TABLE_SIZE
+#define SN_COAP_LOOKUP_TABLE_SIZE                       8
+#endif
+
+#if (SN_COAP_LOOKUP_TABLE_SIZE == 0) || (SN_COAP_LOOKUP_TABLE_SIZE & (SN_COAP_LOOKUP_TABLE_SIZE - 1))
+#error "SN_COAP_LOOKUP_TABLE_SIZE must be a power of two"
+#endif
+
 /* * For Message duplication detecting * */
 
 /* Init value for the maximum count of messages to be stored for duplication detection          */
@@ -145,30 +155,39 @@ int8_t prepare_blockwise_message(struct coap_s *handle, struct sn_coap_hdr_ *coa
 typedef struct coap_send_msg_ {
     uint8_t             resending_counter;  /* Tells how many times message is still tried to resend */
     uint32_t            resending_time;     /* Tells next resending time */
+    uint16_t            msg_id;             /* Message ID of the stored message */
+    uint16_t            lookup_key;         /* Hash of destination address, port and message ID */
 
     sn_nsdl_transmit_s *send_msg_ptr;
+    const uint8_t       *payload_ptr;       /* Payload sent after send_msg_ptr, not copied, or NULL */
+    uint16_t            payload_len;        /* Length of referenced payload */
 
     struct coap_s       *coap;              /* CoAP library handle */
     void                *param;             /* Extra parameter that will be passed to TX/RX callback functions */
 
-    ns_list_link_t      link;
+    ns_list_link_t      link;               /* Link in the list ordered by resending time */
+    ns_list_link_t      lookup_link;        /* Link in the lookup table bucket */
 } coap_send_msg_s;
 
 typedef NS_LIST_HEAD(coap_send_msg_s, link) coap_send_msg_list_t;
+typedef NS_LIST_HEAD(coap_send_msg_s, lookup_link) coap_send_msg_bucket_t;
 
 /* Structure which is stored to Linked list for message duplication detection purposes */
 typedef struct coap_duplication_info_ {
     uint32_t            timestamp; /* Tells when duplication information is stored to Linked list */
     uint16_t            msg_id;
+    uint16_t            lookup_key; /* Hash of source address, port and message ID */
     uint16_t            packet_len;
     uint8_t             *packet_ptr;
     struct coap_s       *coap;  /* CoAP library handle */
     sn_nsdl_addr_s      *address;
     void                *param;
-    ns_list_link_t      link;
+    ns_list_link_t      link;        /* Link in the list ordered by timestamp */
+    ns_list_link_t      lookup_link; /* Link in the lookup table bucket */
 } coap_duplication_info_s;
 
 typedef NS_LIST_HEAD(coap_duplication_info_s, link) coap_duplication_info_list_t;
+typedef NS_LIST_HEAD(coap_duplication_info_s, lookup_link) coap_duplication_info_bucket_t;
 
 /* Structure which is stored to Linked list for blockwise messages sending purposes */
 typedef struct coap_blockwise_msg_ {
@@ -200,35 +219,63 @@ typedef struct coap_blockwise_payload_ {
 
 typedef NS_LIST_HEAD(coap_blockwise_payload_s, link) coap_blockwise_payload_list_t;
 
+/* Structure which is stored to Linked list for each blockwise transfer streamed to the application */
+typedef struct coap_blockwise_stream_ {
+    uint32_t            timestamp;  /* Tells when last block of the transfer was received */
+
+    uint8_t             addr_len;
+    uint8_t             *addr_ptr;
+    uint16_t            port;
+    bool                block1;      /* Block1 request being received, otherwise Block2 response */
+    bool                held_resend; /* Held packet is a request to be resent until answered */
+    uint32_t            block_offset; /* Offset of the last block given to the application */
+    uint32_t            next_offset;  /* Offset of the block expected next */
+    uint16_t            msg_id;       /* Message ID of the last block given to the application */
+
+    uint16_t            held_packet_len;
+    uint8_t             *held_packet_ptr; /* ACK or next block request held by the application, NULL if none */
+    void                *param;
+
+    ns_list_link_t      link;
+} coap_blockwise_stream_s;
+
+typedef NS_LIST_HEAD(coap_blockwise_stream_s, link) coap_blockwise_stream_list_t;
+
 struct coap_s {
     void *(*sn_coap_protocol_malloc)(uint16_t);
     void (*sn_coap_protocol_free)(void *);
 
     uint8_t (*sn_coap_tx_callback)(uint8_t *, uint16_t, sn_nsdl_addr_s *, void *);
     int8_t (*sn_coap_rx_callback)(sn_coap_hdr_s *, sn_nsdl_addr_s *, void *);
+    uint8_t (*sn_coap_tx_scatter_callback)(const sn_coap_iovec_s *, uint8_t, sn_nsdl_addr_s *, void *);
 
     #if ENABLE_RESENDINGS /* If Message resending is not used at all, this part of code will not be compiled */
-        coap_send_msg_list_t linked_list_resent_msgs; /* Active resending messages are stored to this Linked list */
+        coap_send_msg_list_t linked_list_resent_msgs; /* Active resending messages are stored to this Linked list, earliest resending time first */
+        coap_send_msg_bucket_t resent_msgs_table[SN_COAP_LOOKUP_TABLE_SIZE]; /* Same messages, by lookup key */
         uint16_t count_resent_msgs;
+        uint32_t count_resent_bytes;
     #endif
 
     #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
         coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list */
+        coap_duplication_info_bucket_t duplication_msgs_table[SN_COAP_LOOKUP_TABLE_SIZE]; /* Same messages, by lookup key */
         uint16_t                      count_duplication_msgs;
     #endif
 
     #if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwise is not used at all, this part of code will not be compiled */
         coap_blockwise_msg_list_t     linked_list_blockwise_sent_msgs; /* Blockwise message to to be sent is stored to this Linked list */
         coap_blockwise_payload_list_t linked_list_blockwise_received_payloads; /* Blockwise payload to to be received is stored to this Linked list */
+        coap_blockwise_stream_list_t  linked_list_blockwise_streams; /* Transfers given to sn_coap_block_stream_callback */
+        int8_t (*sn_coap_block_stream_callback)(struct coap_s *, sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t, uint8_t, void *);
     #endif
 
     uint32_t system_time;    /* System time seconds */
     uint16_t sn_coap_block_data_size;
-    uint8_t sn_coap_resending_queue_msgs;
+    uint16_t sn_coap_resending_queue_msgs;
     uint32_t sn_coap_resending_queue_bytes;
     uint8_t sn_coap_resending_count;
     uint8_t sn_coap_resending_intervall;
-    uint8_t sn_coap_duplication_buffer_size;
+    uint16_t sn_coap_duplication_buffer_size;
     uint8_t sn_coap_internal_block2_resp_handling; /* If this is set then coap itself sends a next GET request automatically */
 };
 
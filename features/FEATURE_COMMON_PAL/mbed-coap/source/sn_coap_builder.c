@@ -147,6 +147,63 @@ int16_t sn_coap_builder_2(uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *src_coap_
     /* * * * Return built Packet data length * * * */
     return (dst_packet_data_ptr - base_packet_data_ptr);
 }
+
+int16_t sn_coap_builder_scatter(uint8_t *dst_head_ptr, uint16_t dst_head_size, sn_coap_hdr_s *src_coap_msg_ptr, sn_coap_iovec_s *dst_iov_ptr)
+{
+    uint8_t *base_head_ptr = dst_head_ptr;
+    uint16_t payload_len = 0;
+
+    /* * * * Check given pointers  * * * */
+    if (dst_head_ptr == NULL || src_coap_msg_ptr == NULL || dst_iov_ptr == NULL) {
+        return -2;
+    }
+
+    /* Payload is not built, so it is not limited to any block size here */
+    uint16_t dst_byte_count_to_be_built = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_msg_ptr, 0);
+    if (!dst_byte_count_to_be_built) {
+        tr_error("sn_coap_builder_scatter - failed to calculate message size!");
+        return -1;
+    }
+
+    /* Head is everything up to and including Payload marker */
+    if (src_coap_msg_ptr->msg_type != COAP_MSG_TYPE_RESET && src_coap_msg_ptr->payload_len) {
+        dst_byte_count_to_be_built -= src_coap_msg_ptr->payload_len;
+        if (src_coap_msg_ptr->payload_ptr != NULL) {
+            payload_len = src_coap_msg_ptr->payload_len;
+        } else {
+            dst_byte_count_to_be_built--;
+        }
+    }
+
+    if (dst_byte_count_to_be_built > dst_head_size) {
+        tr_error("sn_coap_builder_scatter - head does not fit!");
+        return -3;
+    }
+
+    memset(dst_head_ptr, 0, dst_byte_count_to_be_built);
+
+    if (sn_coap_builder_header_build(&dst_head_ptr, src_coap_msg_ptr) != 0) {
+        tr_error("sn_coap_builder_scatter - header building failed!");
+        return -1;
+    }
+
+    /* If else than Reset message because Reset message must be empty */
+    if (src_coap_msg_ptr->msg_type != COAP_MSG_TYPE_RESET) {
+        sn_coap_builder_options_build(&dst_head_ptr, src_coap_msg_ptr);
+
+        if (payload_len) {
+            *dst_head_ptr++ = 0xff;
+        }
+    }
+
+    dst_iov_ptr[0].ptr = base_head_ptr;
+    dst_iov_ptr[0].len = dst_head_ptr - base_head_ptr;
+    dst_iov_ptr[1].ptr = payload_len ? src_coap_msg_ptr->payload_ptr : NULL;
+    dst_iov_ptr[1].len = payload_len;
+
+    return dst_iov_ptr[0].len + payload_len;
+}
+
 uint16_t sn_coap_builder_calc_needed_packet_data_size(sn_coap_hdr_s *src_coap_msg_ptr)
 {
     return sn_coap_builder_calc_needed_packet_data_size_2(src_coap_msg_ptr, SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE);
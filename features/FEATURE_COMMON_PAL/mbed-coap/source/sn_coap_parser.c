@@ -42,9 +42,12 @@
 /* * * * LOCAL FUNCTION PROTOTYPES * * * */
 /* * * * * * * * * * * * * * * * * * * * */
 
+static void    *sn_coap_parser_malloc(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint16_t size);
+static sn_coap_hdr_s *sn_coap_parser_parse(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr);
+static sn_coap_options_list_s *sn_coap_parser_options_list(struct coap_s *handle, sn_coap_arena_s *arena_ptr, sn_coap_hdr_s *coap_msg_ptr);
 static void     sn_coap_parser_header_parse(uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, coap_version_e *coap_version_ptr);
-static int8_t   sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len);
-static int8_t   sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len);
+static int8_t   sn_coap_parser_options_parse(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len);
+static int8_t   sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len);
 static int16_t  sn_coap_parser_options_count_needed_memory_multiple_option(uint8_t *packet_data_ptr, uint16_t packet_left_len, sn_coap_option_numbers_e option, uint16_t option_number_len);
 static int8_t   sn_coap_parser_payload_parse(uint16_t packet_data_len, uint8_t *packet_data_start_ptr, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr);
 
@@ -86,13 +89,18 @@ sn_coap_options_list_s *sn_coap_parser_alloc_options(struct coap_s *handle, sn_c
         return NULL;
     }
 
+    return sn_coap_parser_options_list(handle, NULL, coap_msg_ptr);
+}
+
+static sn_coap_options_list_s *sn_coap_parser_options_list(struct coap_s *handle, sn_coap_arena_s *arena_ptr, sn_coap_hdr_s *coap_msg_ptr)
+{
     /* * * * If the message already has options, return them * * * */
     if (coap_msg_ptr->options_list_ptr) {
         return coap_msg_ptr->options_list_ptr;
     }
 
     /* * * * Allocate memory for options and initialize allocated memory with with default values  * * * */
-    coap_msg_ptr->options_list_ptr = handle->sn_coap_protocol_malloc(sizeof(sn_coap_options_list_s));
+    coap_msg_ptr->options_list_ptr = sn_coap_parser_malloc(handle, arena_ptr, sizeof(sn_coap_options_list_s));
 
     if (coap_msg_ptr->options_list_ptr == NULL) {
         tr_error("sn_coap_parser_alloc_options - failed to allocate options list!");
@@ -112,7 +120,57 @@ sn_coap_options_list_s *sn_coap_parser_alloc_options(struct coap_s *handle, sn_c
     return coap_msg_ptr->options_list_ptr;
 }
 
+void sn_coap_arena_init(sn_coap_arena_s *arena_ptr, uint8_t *buf_ptr, uint16_t size)
+{
+    if (arena_ptr == NULL) {
+        return;
+    }
+
+    arena_ptr->buf_ptr = buf_ptr;
+    arena_ptr->size = buf_ptr ? size : 0;
+    arena_ptr->used = 0;
+}
+
+/**
+ * \brief Allocates from the arena if one is given, otherwise from the heap
+ *
+ * Arena allocations are aligned for the message and options structures.
+ */
+static void *sn_coap_parser_malloc(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint16_t size)
+{
+    uint8_t *ptr;
+    uint16_t offset;
+
+    if (arena_ptr == NULL) {
+        return handle->sn_coap_protocol_malloc(size);
+    }
+
+    offset = (arena_ptr->used + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    if (offset > arena_ptr->size || size > arena_ptr->size - offset) {
+        tr_error("sn_coap_parser_malloc - arena full!");
+        return NULL;
+    }
+
+    ptr = arena_ptr->buf_ptr + offset;
+    arena_ptr->used = offset + size;
+    return ptr;
+}
+
 sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
+{
+    return sn_coap_parser_parse(handle, NULL, packet_data_len, packet_data_ptr, coap_version_ptr);
+}
+
+sn_coap_hdr_s *sn_coap_parser_into(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
+{
+    if (arena_ptr == NULL) {
+        return NULL;
+    }
+
+    return sn_coap_parser_parse(handle, arena_ptr, packet_data_len, packet_data_ptr, coap_version_ptr);
+}
+
+static sn_coap_hdr_s *sn_coap_parser_parse(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
 {
     uint8_t       *data_temp_ptr                    = packet_data_ptr;
     sn_coap_hdr_s *parsed_and_returned_coap_msg_ptr = NULL;
@@ -123,18 +181,20 @@ sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, u
     }
 
     /* * * * Allocate and initialize CoAP message  * * * */
-    parsed_and_returned_coap_msg_ptr = sn_coap_parser_alloc_message(handle);
+    parsed_and_returned_coap_msg_ptr = sn_coap_parser_init_message(sn_coap_parser_malloc(handle, arena_ptr, sizeof(sn_coap_hdr_s)));
 
     if (parsed_and_returned_coap_msg_ptr == NULL) {
         tr_error("sn_coap_parser - failed to allocate message!");
         return NULL;
     }
 
+    parsed_and_returned_coap_msg_ptr->arena = (arena_ptr != NULL);
+
     /* * * * Header parsing, move pointer over the header...  * * * */
     sn_coap_parser_header_parse(&data_temp_ptr, parsed_and_returned_coap_msg_ptr, coap_version_ptr);
 
     /* * * * Options parsing, move pointer over the options... * * * */
-    if (sn_coap_parser_options_parse(handle, &data_temp_ptr, parsed_and_returned_coap_msg_ptr, packet_data_ptr, packet_data_len) != 0) {
+    if (sn_coap_parser_options_parse(handle, arena_ptr, &data_temp_ptr, parsed_and_returned_coap_msg_ptr, packet_data_ptr, packet_data_len) != 0) {
         parsed_and_returned_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_ERROR_IN_HEADER;
         return parsed_and_returned_coap_msg_ptr;
     }
@@ -155,7 +215,9 @@ void sn_coap_parser_release_allocated_coap_msg_mem(struct coap_s *handle, sn_coa
         return;
     }
 
-    if (freed_coap_msg_ptr != NULL) {
+    /* Everything of a message parsed into an arena is in the arena or
+     * the Packet data */
+    if (freed_coap_msg_ptr != NULL && !freed_coap_msg_ptr->arena) {
         if (freed_coap_msg_ptr->uri_path_ptr != NULL) {
             handle->sn_coap_protocol_free(freed_coap_msg_ptr->uri_path_ptr);
         }
@@ -253,7 +315,7 @@ static uint32_t sn_coap_parser_options_parse_uint(uint8_t **packet_data_pptr, ui
  *
  * \return Return value is 0 in ok case and -1 in failure case
  */
-static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len)
+static int8_t sn_coap_parser_options_parse(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len)
 {
     uint8_t previous_option_number = 0;
     uint8_t i                      = 0;
@@ -269,14 +331,18 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             return -1;
         }
 
-        dst_coap_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(dst_coap_msg_ptr->token_len);
+        if (arena_ptr) {
+            dst_coap_msg_ptr->token_ptr = *packet_data_pptr;
+        } else {
+            dst_coap_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(dst_coap_msg_ptr->token_len);
 
-        if (dst_coap_msg_ptr->token_ptr == NULL) {
-            tr_error("sn_coap_parser_options_parse - failed to allocate token!");
-            return -1;
-        }
+            if (dst_coap_msg_ptr->token_ptr == NULL) {
+                tr_error("sn_coap_parser_options_parse - failed to allocate token!");
+                return -1;
+            }
 
-        memcpy(dst_coap_msg_ptr->token_ptr, *packet_data_pptr, dst_coap_msg_ptr->token_len);
+            memcpy(dst_coap_msg_ptr->token_ptr, *packet_data_pptr, dst_coap_msg_ptr->token_len);
+        }
         (*packet_data_pptr) += dst_coap_msg_ptr->token_len;
     }
 
@@ -344,7 +410,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             case COAP_OPTION_ACCEPT:
             case COAP_OPTION_SIZE1:
             case COAP_OPTION_SIZE2:
-                if (sn_coap_parser_alloc_options(handle, dst_coap_msg_ptr) == NULL) {
+                if (sn_coap_parser_options_list(handle, arena_ptr, dst_coap_msg_ptr) == NULL) {
                     tr_error("sn_coap_parser_options_parse - failed to allocate options!");
                     return -1;
                 }
@@ -379,14 +445,18 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 dst_coap_msg_ptr->options_list_ptr->proxy_uri_len = option_len;
                 (*packet_data_pptr)++;
 
-                dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = handle->sn_coap_protocol_malloc(option_len);
+                if (arena_ptr) {
+                    dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = *packet_data_pptr;
+                } else {
+                    dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = handle->sn_coap_protocol_malloc(option_len);
 
-                if (dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr == NULL) {
-                    tr_error("sn_coap_parser_options_parse - COAP_OPTION_PROXY_URI allocation failed!");
-                    return -1;
-                }
+                    if (dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr == NULL) {
+                        tr_error("sn_coap_parser_options_parse - COAP_OPTION_PROXY_URI allocation failed!");
+                        return -1;
+                    }
 
-                memcpy(dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr, *packet_data_pptr, option_len);
+                    memcpy(dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr, *packet_data_pptr, option_len);
+                }
                 (*packet_data_pptr) += option_len;
 
                 break;
@@ -394,7 +464,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             case COAP_OPTION_ETAG:
                 /* This is managed independently because User gives this option in one character table */
 
-                ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr,
+                ret_status = sn_coap_parser_options_parse_multiple_options(handle, arena_ptr, packet_data_pptr,
                              message_left,
                              &dst_coap_msg_ptr->options_list_ptr->etag_ptr,
                              (uint16_t *)&dst_coap_msg_ptr->options_list_ptr->etag_len,
@@ -415,13 +485,17 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 dst_coap_msg_ptr->options_list_ptr->uri_host_len = option_len;
                 (*packet_data_pptr)++;
 
-                dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = handle->sn_coap_protocol_malloc(option_len);
+                if (arena_ptr) {
+                    dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = *packet_data_pptr;
+                } else {
+                    dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = handle->sn_coap_protocol_malloc(option_len);
 
-                if (dst_coap_msg_ptr->options_list_ptr->uri_host_ptr == NULL) {
-                    tr_error("sn_coap_parser_options_parse - COAP_OPTION_URI_HOST allocation failed!");
-                    return -1;
+                    if (dst_coap_msg_ptr->options_list_ptr->uri_host_ptr == NULL) {
+                        tr_error("sn_coap_parser_options_parse - COAP_OPTION_URI_HOST allocation failed!");
+                        return -1;
+                    }
+                    memcpy(dst_coap_msg_ptr->options_list_ptr->uri_host_ptr, *packet_data_pptr, option_len);
                 }
-                memcpy(dst_coap_msg_ptr->options_list_ptr->uri_host_ptr, *packet_data_pptr, option_len);
                 (*packet_data_pptr) += option_len;
 
                 break;
@@ -432,7 +506,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                     return -1;
                 }
                 /* This is managed independently because User gives this option in one character table */
-                ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
+                ret_status = sn_coap_parser_options_parse_multiple_options(handle, arena_ptr, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->options_list_ptr->location_path_ptr, &dst_coap_msg_ptr->options_list_ptr->location_path_len,
                              COAP_OPTION_LOCATION_PATH, option_len);
                 if (ret_status >= 0) {
@@ -456,7 +530,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 break;
 
             case COAP_OPTION_LOCATION_QUERY:
-                ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
+                ret_status = sn_coap_parser_options_parse_multiple_options(handle, arena_ptr, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->options_list_ptr->location_query_ptr, &dst_coap_msg_ptr->options_list_ptr->location_query_len,
                              COAP_OPTION_LOCATION_QUERY, option_len);
                 if (ret_status >= 0) {
@@ -469,7 +543,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 break;
 
             case COAP_OPTION_URI_PATH:
-                ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
+                ret_status = sn_coap_parser_options_parse_multiple_options(handle, arena_ptr, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->uri_path_ptr, &dst_coap_msg_ptr->uri_path_len,
                              COAP_OPTION_URI_PATH, option_len);
                 if (ret_status >= 0) {
@@ -494,7 +568,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 break;
 
             case COAP_OPTION_URI_QUERY:
-                ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
+                ret_status = sn_coap_parser_options_parse_multiple_options(handle, arena_ptr, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->options_list_ptr->uri_query_ptr, &dst_coap_msg_ptr->options_list_ptr->uri_query_len,
                              COAP_OPTION_URI_QUERY, option_len);
                 if (ret_status >= 0) {
@@ -593,7 +667,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
  *
  * \return Return value is count of Uri-query optios parsed. In failure case -1 is returned.
 */
-static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len)
+static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, sn_coap_arena_s *arena_ptr, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len)
 {
     int16_t     uri_query_needed_heap       = sn_coap_parser_options_count_needed_memory_multiple_option(*packet_data_pptr, packet_left_len, option, option_number_len);
     uint8_t    *temp_parsed_uri_query_ptr   = NULL;
@@ -603,8 +677,17 @@ static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handl
         return -1;
     }
 
+    /* A single part needs no separators, so it can stay in the Packet data */
+    if (arena_ptr && option_number_len && uri_query_needed_heap == option_number_len) {
+        (*packet_data_pptr)++;
+        *dst_pptr = *packet_data_pptr;
+        *dst_len_ptr = option_number_len;
+        (*packet_data_pptr) += option_number_len;
+        return 1;
+    }
+
     if (uri_query_needed_heap) {
-        *dst_pptr = (uint8_t *) handle->sn_coap_protocol_malloc(uri_query_needed_heap);
+        *dst_pptr = (uint8_t *) sn_coap_parser_malloc(handle, arena_ptr, uri_query_needed_heap);
 
         if (*dst_pptr == NULL) {
             tr_error("sn_coap_parser_options_parse_multiple_options - failed to allocate options!");
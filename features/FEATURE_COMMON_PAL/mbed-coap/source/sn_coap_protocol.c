@@ -48,10 +48,16 @@
 /* * * * * * * * * * * * * * * * * * * * */
 
 static void                  sn_coap_protocol_send_rst(struct coap_s *handle, uint16_t msg_id, sn_nsdl_addr_s *addr_ptr, void *param);
+static int16_t               sn_coap_protocol_build_message(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint8_t *dst_packet_data_ptr, uint16_t dst_head_size, sn_coap_hdr_s *src_coap_msg_ptr, sn_coap_iovec_s *dst_iov_ptr, void *param);
+static sn_coap_hdr_s        *sn_coap_protocol_parse_message(struct coap_s *handle, sn_coap_arena_s *arena_ptr, sn_nsdl_addr_s *src_addr_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, void *param);
+#if ENABLE_RESENDINGS || SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+static uint16_t              sn_coap_protocol_lookup_key(const sn_nsdl_addr_s *addr_ptr, uint16_t msg_id);
+static bool                  sn_coap_protocol_address_match(const sn_nsdl_addr_s *addr_ptr, const sn_nsdl_addr_s *stored_addr_ptr);
+#endif
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT/* If Message duplication detection is not used at all, this part of code will not be compiled */
 static void                  sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id, void *param);
 static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(struct coap_s *handle, sn_nsdl_addr_s *scr_addr_ptr, uint16_t msg_id);
-static void                  sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *scr_addr_ptr, uint16_t port, uint16_t msg_id);
+static void                  sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr);
 static void                  sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle);
 #endif
 #if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is not used at all, this part of code will not be compiled */
@@ -64,15 +70,21 @@ static void                  sn_coap_protocol_linked_list_blockwise_payload_remo
 static uint32_t              sn_coap_protocol_linked_list_blockwise_payloads_get_len(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr);
 static void                  sn_coap_protocol_linked_list_blockwise_remove_old_data(struct coap_s *handle);
 static sn_coap_hdr_s        *sn_coap_handle_blockwise_message(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param);
+static uint8_t              *sn_coap_protocol_build_block1_ack(struct coap_s *handle, sn_coap_hdr_s *received_coap_msg_ptr, bool blocks_in_order, uint32_t max_size, uint16_t *packet_len);
+static int8_t                sn_coap_protocol_request_next_block2(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param, coap_blockwise_stream_s *hold_stream_ptr);
+static coap_blockwise_stream_s *sn_coap_protocol_linked_list_blockwise_stream_search(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, bool block1);
+static coap_blockwise_stream_s *sn_coap_protocol_linked_list_blockwise_stream_store(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, bool block1);
+static void                  sn_coap_protocol_linked_list_blockwise_stream_remove(struct coap_s *handle, coap_blockwise_stream_s *removed_stream_ptr);
+static sn_coap_hdr_s        *sn_coap_handle_blockwise_stream(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param);
 static sn_coap_hdr_s        *sn_coap_protocol_copy_header(struct coap_s *handle, sn_coap_hdr_s *source_header_ptr);
 #endif
 #if ENABLE_RESENDINGS
-static uint8_t               sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, uint32_t sending_time, void *param);
-static sn_nsdl_transmit_s   *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle,sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
-static void                  sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
+static uint8_t               sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, const uint8_t *payload_ptr, uint16_t payload_len, uint32_t sending_time, void *param);
+static coap_send_msg_s      *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
+static void                  sn_coap_protocol_linked_list_send_msg_insert(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+static void                  sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *removed_msg_ptr);
 static coap_send_msg_s      *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t packet_data_len);
 static void                  sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handle, coap_send_msg_s *freed_send_msg_ptr);
-static uint16_t              sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr);
 static uint32_t              sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint8_t interval, const uint8_t counter);
 #endif
 
@@ -94,24 +106,7 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
 
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     ns_list_foreach_safe(coap_duplication_info_s, tmp, &handle->linked_list_duplication_msgs) {
-        if (tmp->coap == handle) {
-            if (tmp->address) {
-                if (tmp->address->addr_ptr) {
-                    handle->sn_coap_protocol_free(tmp->address->addr_ptr);
-                    tmp->address->addr_ptr = 0;
-                }
-                handle->sn_coap_protocol_free(tmp->address);
-                tmp->address = 0;
-            }
-            if (tmp->packet_ptr) {
-                handle->sn_coap_protocol_free(tmp->packet_ptr);
-                tmp->packet_ptr = 0;
-            }
-            ns_list_remove(&handle->linked_list_duplication_msgs, tmp);
-            handle->count_duplication_msgs--;
-            handle->sn_coap_protocol_free(tmp);
-            tmp = 0;
-        }
+        sn_coap_protocol_linked_list_duplication_info_remove(handle, tmp);
     }
 
 #endif
@@ -147,6 +142,9 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
             tmp = 0;
         }
     }
+    ns_list_foreach_safe(coap_blockwise_stream_s, tmp, &handle->linked_list_blockwise_streams) {
+        sn_coap_protocol_linked_list_blockwise_stream_remove(handle, tmp);
+    }
 #endif
 
     handle->sn_coap_protocol_free(handle);
@@ -187,6 +185,9 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 #if ENABLE_RESENDINGS  /* If Message resending is not used at all, this part of code will not be compiled */
     /* * * * Create Linked list for storing active resending messages  * * * */
     ns_list_init(&handle->linked_list_resent_msgs);
+    for (uint16_t i = 0; i < SN_COAP_LOOKUP_TABLE_SIZE; i++) {
+        ns_list_init(&handle->resent_msgs_table[i]);
+    }
     handle->sn_coap_resending_queue_msgs = SN_COAP_RESENDING_QUEUE_SIZE_MSGS;
     handle->sn_coap_resending_queue_bytes = SN_COAP_RESENDING_QUEUE_SIZE_BYTES;
     handle->sn_coap_resending_intervall = DEFAULT_RESPONSE_TIMEOUT;
@@ -198,6 +199,9 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     /* * * * Create Linked list for storing Duplication info * * * */
     ns_list_init(&handle->linked_list_duplication_msgs);
+    for (uint16_t i = 0; i < SN_COAP_LOOKUP_TABLE_SIZE; i++) {
+        ns_list_init(&handle->duplication_msgs_table[i]);
+    }
     handle->sn_coap_duplication_buffer_size = SN_COAP_DUPLICATION_MAX_MSGS_COUNT;
 #endif
 
@@ -205,6 +209,7 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 
     ns_list_init(&handle->linked_list_blockwise_sent_msgs);
     ns_list_init(&handle->linked_list_blockwise_received_payloads);
+    ns_list_init(&handle->linked_list_blockwise_streams);
     handle->sn_coap_block_data_size = SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE;
 
 #endif /* ENABLE_RESENDINGS */
@@ -229,6 +234,64 @@ int8_t sn_coap_protocol_handle_block2_response_internally(struct coap_s *handle,
     return 0;
 }
 
+int8_t sn_coap_protocol_set_block_stream_callback(struct coap_s *handle,
+        int8_t (*block_stream_cb)(struct coap_s *, sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t offset, uint8_t last, void *))
+{
+    (void) handle;
+    (void) block_stream_cb;
+#if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    if (handle == NULL) {
+        return -1;
+    }
+
+    handle->sn_coap_block_stream_callback = block_stream_cb;
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+int8_t sn_coap_protocol_block_stream_resume(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
+{
+#if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    if (handle == NULL || addr_ptr == NULL) {
+        return -1;
+    }
+
+    /* Block1 and Block2 transfers with the same peer are told apart by the message ID */
+    ns_list_foreach(coap_blockwise_stream_s, stream_ptr, &handle->linked_list_blockwise_streams) {
+        if (stream_ptr->held_packet_ptr && stream_ptr->msg_id == msg_id && stream_ptr->port == addr_ptr->port &&
+                stream_ptr->addr_len == addr_ptr->addr_len &&
+                0 == memcmp(stream_ptr->addr_ptr, addr_ptr->addr_ptr, addr_ptr->addr_len)) {
+            uint8_t *packet_ptr = stream_ptr->held_packet_ptr;
+            uint16_t packet_len = stream_ptr->held_packet_len;
+            bool resend = stream_ptr->held_resend;
+            void *param = stream_ptr->param;
+
+            /* Taken off the stream first, the tx callback may feed the answer straight back */
+            stream_ptr->held_packet_ptr = NULL;
+
+            handle->sn_coap_tx_callback(packet_ptr, packet_len, addr_ptr, param);
+#if ENABLE_RESENDINGS
+            if (resend) {
+                uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
+                sn_coap_protocol_linked_list_send_msg_store(handle, addr_ptr, packet_len, packet_ptr, NULL, 0, resend_time, param);
+            }
+#else
+            (void) resend;
+#endif
+            handle->sn_coap_protocol_free(packet_ptr);
+            return 0;
+        }
+    }
+#else
+    (void) handle;
+    (void) addr_ptr;
+    (void) msg_id;
+#endif
+    return -1;
+}
+
 int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t block_size)
 {
     (void) handle;
@@ -320,9 +383,8 @@ void sn_coap_protocol_clear_retransmission_buffer(struct coap_s *handle)
         return;
     }
     ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        ns_list_remove(&handle->linked_list_resent_msgs, tmp);
+        sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
         sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-        --handle->count_resent_msgs;
     }
 #endif
 }
@@ -333,16 +395,12 @@ int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint16_t ms
     if (handle == NULL) {
         return -1;
     }
+    /* No address to look up with, so this one walks the list */
     ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        if (tmp->send_msg_ptr && tmp->send_msg_ptr->packet_ptr ) {
-            uint16_t temp_msg_id = (tmp->send_msg_ptr->packet_ptr[2] << 8);
-            temp_msg_id += (uint16_t)tmp->send_msg_ptr->packet_ptr[3];
-            if(temp_msg_id == msg_id){
-                ns_list_remove(&handle->linked_list_resent_msgs, tmp);
-                --handle->count_resent_msgs;
-                sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-                return 0;
-            }
+        if (tmp->msg_id == msg_id) {
+            sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
+            sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
+            return 0;
         }
     }
 #endif
@@ -388,8 +446,40 @@ int8_t prepare_blockwise_message(struct coap_s *handle, sn_coap_hdr_s *src_coap_
 
 int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr,
                                uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *src_coap_msg_ptr, void *param)
+{
+    return sn_coap_protocol_build_message(handle, dst_addr_ptr, dst_packet_data_ptr, 0, src_coap_msg_ptr, NULL, param);
+}
+
+int16_t sn_coap_protocol_build_scatter(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr,
+                                       uint8_t *dst_head_ptr, uint16_t dst_head_size, sn_coap_hdr_s *src_coap_msg_ptr,
+                                       sn_coap_iovec_s *dst_iov_ptr, void *param)
+{
+    if (dst_iov_ptr == NULL) {
+        return -2;
+    }
+
+    return sn_coap_protocol_build_message(handle, dst_addr_ptr, dst_head_ptr, dst_head_size, src_coap_msg_ptr, dst_iov_ptr, param);
+}
+
+int8_t sn_coap_protocol_set_tx_scatter_callback(struct coap_s *handle,
+        uint8_t (*used_tx_scatter_callback_ptr)(const sn_coap_iovec_s *, uint8_t, sn_nsdl_addr_s *, void *))
+{
+    if (handle == NULL) {
+        return -1;
+    }
+
+    handle->sn_coap_tx_scatter_callback = used_tx_scatter_callback_ptr;
+    return 0;
+}
+
+static int16_t sn_coap_protocol_build_message(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr,
+                                              uint8_t *dst_packet_data_ptr, uint16_t dst_head_size, sn_coap_hdr_s *src_coap_msg_ptr,
+                                              sn_coap_iovec_s *dst_iov_ptr, void *param)
 {
     int16_t  byte_count_built     = 0;
+    uint16_t head_len             = 0;
+    const uint8_t *payload_ptr    = NULL;
+    uint16_t payload_len          = 0;
 #if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is not used at all, this part of code will not be compiled */
     uint16_t original_payload_len = 0;
 #endif
@@ -419,6 +509,11 @@ int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_p
 
     /* If blockwising needed */
     if ((src_coap_msg_ptr->payload_len > handle->sn_coap_block_data_size) && (handle->sn_coap_block_data_size > 0)) {
+        /* Later blocks are built from a copy of the whole payload */
+        if (dst_iov_ptr) {
+            tr_error("sn_coap_protocol_build_message - blockwise message can not be scattered!");
+            return -1;
+        }
         /* Store original Payload length */
         original_payload_len = src_coap_msg_ptr->payload_len;
         /* Change Payload length of send message because Payload is blockwised */
@@ -430,7 +525,18 @@ int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_p
     /* * * * Build Packet data from CoAP message by using CoAP Header builder  * * * */
     /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-    byte_count_built = sn_coap_builder_2(dst_packet_data_ptr, src_coap_msg_ptr, handle->sn_coap_block_data_size);
+    if (dst_iov_ptr) {
+        /* Payload stays where it is, only the head is built */
+        byte_count_built = sn_coap_builder_scatter(dst_packet_data_ptr, dst_head_size, src_coap_msg_ptr, dst_iov_ptr);
+        if (byte_count_built >= 0) {
+            head_len = dst_iov_ptr[0].len;
+            payload_ptr = dst_iov_ptr[1].ptr;
+            payload_len = dst_iov_ptr[1].len;
+        }
+    } else {
+        byte_count_built = sn_coap_builder_2(dst_packet_data_ptr, src_coap_msg_ptr, handle->sn_coap_block_data_size);
+        head_len = byte_count_built;
+    }
 
     if (byte_count_built < 0) {
         tr_error("sn_coap_protocol_build - failed to build message!");
@@ -443,7 +549,8 @@ int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_p
     if (src_coap_msg_ptr->msg_type == COAP_MSG_TYPE_CONFIRMABLE) {
         /* Store message to Linked list for resending purposes */
         uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
-        if (sn_coap_protocol_linked_list_send_msg_store(handle, dst_addr_ptr, byte_count_built, dst_packet_data_ptr,
+        if (sn_coap_protocol_linked_list_send_msg_store(handle, dst_addr_ptr, head_len, dst_packet_data_ptr,
+                payload_ptr, payload_len,
                 resend_time,
                 param) == 0) {
             return -4;
@@ -462,7 +569,10 @@ int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_p
         if (info && info->packet_ptr == NULL) {
             info->packet_ptr = handle->sn_coap_protocol_malloc(byte_count_built);
             if (info->packet_ptr) {
-                memcpy(info->packet_ptr, dst_packet_data_ptr, byte_count_built);
+                memcpy(info->packet_ptr, dst_packet_data_ptr, head_len);
+                if (payload_len) {
+                    memcpy(info->packet_ptr + head_len, payload_ptr, payload_len);
+                }
                 info->packet_len = byte_count_built;
             } else {
                 tr_error("sn_coap_protocol_build - failed to allocate duplication info!");
@@ -552,6 +662,20 @@ int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_p
 }
 
 sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, void *param)
+{
+    return sn_coap_protocol_parse_message(handle, NULL, src_addr_ptr, packet_data_len, packet_data_ptr, param);
+}
+
+sn_coap_hdr_s *sn_coap_protocol_parse_into(struct coap_s *handle, sn_coap_arena_s *arena_ptr, sn_nsdl_addr_s *src_addr_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, void *param)
+{
+    if (arena_ptr == NULL) {
+        return NULL;
+    }
+
+    return sn_coap_protocol_parse_message(handle, arena_ptr, src_addr_ptr, packet_data_len, packet_data_ptr, param);
+}
+
+static sn_coap_hdr_s *sn_coap_protocol_parse_message(struct coap_s *handle, sn_coap_arena_s *arena_ptr, sn_nsdl_addr_s *src_addr_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, void *param)
 {
     sn_coap_hdr_s   *returned_dst_coap_msg_ptr = NULL;
     coap_version_e   coap_version              = COAP_VERSION_UNKNOWN;
@@ -563,7 +687,11 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
     }
 
     /* * * * Parse Packet data to CoAP message by using CoAP Header parser * * * */
-    returned_dst_coap_msg_ptr = sn_coap_parser(handle, packet_data_len, packet_data_ptr, &coap_version);
+    if (arena_ptr) {
+        returned_dst_coap_msg_ptr = sn_coap_parser_into(handle, arena_ptr, packet_data_len, packet_data_ptr, &coap_version);
+    } else {
+        returned_dst_coap_msg_ptr = sn_coap_parser(handle, packet_data_len, packet_data_ptr, &coap_version);
+    }
 
     /* Check status of returned pointer */
     if (returned_dst_coap_msg_ptr == NULL) {
@@ -650,10 +778,7 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
                 coap_duplication_info_s *stored_duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs);
 
                 /* Remove oldest stored duplication message for getting room for new duplication message */
-                sn_coap_protocol_linked_list_duplication_info_remove(handle,
-                                                                     stored_duplication_info_ptr->address->addr_ptr,
-                                                                     stored_duplication_info_ptr->address->port,
-                                                                     stored_duplication_info_ptr->msg_id);
+                sn_coap_protocol_linked_list_duplication_info_remove(handle, stored_duplication_info_ptr);
             }
 
             /* Store Duplication info to Linked list */
@@ -744,14 +869,15 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
 
         /* Check if there is ongoing active message resendings */
         if (stored_resending_msgs_count > 0) {
-            sn_nsdl_transmit_s *removed_msg_ptr = NULL;
+            coap_send_msg_s *removed_msg_ptr = NULL;
 
             /* Check if received message was confirmation for some active resending message */
             removed_msg_ptr = sn_coap_protocol_linked_list_send_msg_search(handle, src_addr_ptr, returned_dst_coap_msg_ptr->msg_id);
 
             if (removed_msg_ptr != NULL) {
                 /* Remove resending message from active message resending Linked list */
-                sn_coap_protocol_linked_list_send_msg_remove(handle, src_addr_ptr, returned_dst_coap_msg_ptr->msg_id);
+                sn_coap_protocol_linked_list_send_msg_unlink(handle, removed_msg_ptr);
+                sn_coap_protocol_release_allocated_send_msg_mem(handle, removed_msg_ptr);
             }
         }
     }
@@ -782,58 +908,71 @@ int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time)
 #endif
 
 #if ENABLE_RESENDINGS
-    /* Check if there is ongoing active message sendings */
-    /* foreach_safe isn't sufficient because callback routine could cancel messages. */
-rescan:
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        // First check that msg belongs to handle
-        if( stored_msg_ptr->coap == handle ){
-            /* Check if it is time to send this message */
-            if (current_time >= stored_msg_ptr->resending_time) {
-                /* * * Increase Resending counter  * * */
-                stored_msg_ptr->resending_counter++;
-
-                /* Check if all re-sendings have been done */
-                if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
-                    coap_version_e coap_version = COAP_VERSION_UNKNOWN;
-
-                    /* Get message ID from stored sending message */
-                    uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-                    temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
-                    /* Remove message from Linked list */
-                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                    --handle->count_resent_msgs;
-
-                    /* If RX callback have been defined.. */
-                    if (stored_msg_ptr->coap->sn_coap_rx_callback != 0) {
-                        sn_coap_hdr_s *tmp_coap_hdr_ptr;
-                        /* Parse CoAP message, set status and call RX callback */
-                        tmp_coap_hdr_ptr = sn_coap_parser(stored_msg_ptr->coap, stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->packet_ptr, &coap_version);
-
-                        if (tmp_coap_hdr_ptr != 0) {
-                            tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
-                            stored_msg_ptr->coap->sn_coap_rx_callback(tmp_coap_hdr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
-
-                            sn_coap_parser_release_allocated_coap_msg_mem(stored_msg_ptr->coap, tmp_coap_hdr_ptr);
-                        }
+    /* Messages are kept in resending time order, so only the due ones are
+     * visited. The first message is fetched again after every callback,
+     * which may have cancelled any of the others. */
+    coap_send_msg_s *stored_msg_ptr;
+
+    while ((stored_msg_ptr = ns_list_get_first(&handle->linked_list_resent_msgs)) != NULL &&
+            current_time >= stored_msg_ptr->resending_time) {
+        /* * * Increase Resending counter  * * */
+        stored_msg_ptr->resending_counter++;
+
+        /* Check if all re-sendings have been done */
+        if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
+            coap_version_e coap_version = COAP_VERSION_UNKNOWN;
+
+            /* Remove message from Linked list */
+            sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
+
+            /* If RX callback have been defined.. */
+            if (stored_msg_ptr->coap->sn_coap_rx_callback != 0) {
+                sn_coap_hdr_s *tmp_coap_hdr_ptr;
+                /* Parse CoAP message, set status and call RX callback */
+                uint16_t packet_len = stored_msg_ptr->send_msg_ptr->packet_len;
+
+                /* Referenced payload is not in the stored packet, leave its marker out too */
+                if (stored_msg_ptr->payload_ptr) {
+                    packet_len--;
+                }
+                tmp_coap_hdr_ptr = sn_coap_parser(stored_msg_ptr->coap, packet_len, stored_msg_ptr->send_msg_ptr->packet_ptr, &coap_version);
+
+                if (tmp_coap_hdr_ptr != 0) {
+                    if (stored_msg_ptr->payload_ptr) {
+                        tmp_coap_hdr_ptr->payload_ptr = (uint8_t *)stored_msg_ptr->payload_ptr;
+                        tmp_coap_hdr_ptr->payload_len = stored_msg_ptr->payload_len;
                     }
+                    tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
+                    stored_msg_ptr->coap->sn_coap_rx_callback(tmp_coap_hdr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
 
-                    /* Free memory of stored message */
-                    sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
-                } else {
-                    /* Send message  */
-                    stored_msg_ptr->coap->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr->packet_ptr,
-                            stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
-
-                    /* * * Count new Resending time  * * */
-                    stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
-                                                                                       handle->sn_coap_resending_intervall,
-                                                                                       stored_msg_ptr->resending_counter);
+                    sn_coap_parser_release_allocated_coap_msg_mem(stored_msg_ptr->coap, tmp_coap_hdr_ptr);
                 }
-                /* Callback routine could have wiped the list (eg as a response to sending failed) */
-                /* Be super cautious and rescan from the start */
-                goto rescan;
+            }
+
+            /* Free memory of stored message */
+            sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
+        } else {
+            /* * * Count new Resending time and move the message to its place  * * */
+            stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
+                                                                               handle->sn_coap_resending_intervall,
+                                                                               stored_msg_ptr->resending_counter);
+            ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+            sn_coap_protocol_linked_list_send_msg_insert(handle, stored_msg_ptr);
+
+            /* Send message, last, as the callback may cancel it  */
+            if (stored_msg_ptr->payload_ptr) {
+                if (handle->sn_coap_tx_scatter_callback) {
+                    sn_coap_iovec_s iov[SN_COAP_SCATTER_IOV_COUNT];
+                    iov[0].ptr = stored_msg_ptr->send_msg_ptr->packet_ptr;
+                    iov[0].len = stored_msg_ptr->send_msg_ptr->packet_len;
+                    iov[1].ptr = stored_msg_ptr->payload_ptr;
+                    iov[1].len = stored_msg_ptr->payload_len;
+                    handle->sn_coap_tx_scatter_callback(iov, SN_COAP_SCATTER_IOV_COUNT,
+                            stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
+                }
+            } else {
+                stored_msg_ptr->coap->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr->packet_ptr,
+                        stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
             }
         }
     }
@@ -846,7 +985,7 @@ rescan:
 #if ENABLE_RESENDINGS  /* If Message resending is not used at all, this part of code will not be compiled */
 
 /**************************************************************************//**
- * \fn static uint8_t sn_coap_protocol_linked_list_send_msg_store(sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, uint32_t sending_time)
+ * \fn static uint8_t sn_coap_protocol_linked_list_send_msg_store(sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, const uint8_t *payload_ptr, uint16_t payload_len, uint32_t sending_time)
  *
  * \brief Stores message to Linked list for sending purposes.
 
@@ -856,6 +995,11 @@ rescan:
  *
  * \param *send_packet_data_ptr is Packet data to be stored
  *
+ * \param *payload_ptr is payload sent after the Packet data, or NULL. It is
+ *        referenced when there is a scatter tx callback, otherwise copied.
+ *
+ * \param payload_len is length of payload_ptr
+ *
  * \param sending_time is stored sending time
  *
  * \return 0 Allocation or buffer limit reached
@@ -864,10 +1008,15 @@ rescan:
  *****************************************************************************/
 
 static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len,
-        uint8_t *send_packet_data_ptr, uint32_t sending_time, void *param)
+        uint8_t *send_packet_data_ptr, const uint8_t *payload_ptr, uint16_t payload_len, uint32_t sending_time, void *param)
 {
 
     coap_send_msg_s *stored_msg_ptr              = NULL;
+    uint16_t         stored_packet_data_len      = send_packet_data_len;
+
+    if (payload_len && !handle->sn_coap_tx_scatter_callback) {
+        stored_packet_data_len += payload_len;
+    }
 
     /* If both queue parameters are "0" or resending count is "0", then re-sending is disabled */
     if (((handle->sn_coap_resending_queue_msgs == 0) && (handle->sn_coap_resending_queue_bytes == 0)) || (handle->sn_coap_resending_count == 0)) {
@@ -883,14 +1032,14 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
 
     /* Count resending queue size, if buffer size is defined */
     if (handle->sn_coap_resending_queue_bytes > 0) {
-        if ((sn_coap_count_linked_list_size(&handle->linked_list_resent_msgs) + send_packet_data_len) > handle->sn_coap_resending_queue_bytes) {
+        if ((handle->count_resent_bytes + stored_packet_data_len) > handle->sn_coap_resending_queue_bytes) {
             tr_error("sn_coap_protocol_linked_list_send_msg_store - resend buffer size reached!");
             return 0;
         }
     }
 
     /* Allocating memory for stored message */
-    stored_msg_ptr = sn_coap_protocol_allocate_mem_for_msg(handle, dst_addr_ptr, send_packet_data_len);
+    stored_msg_ptr = sn_coap_protocol_allocate_mem_for_msg(handle, dst_addr_ptr, stored_packet_data_len);
 
     if (stored_msg_ptr == 0) {
         tr_error("sn_coap_protocol_linked_list_send_msg_store - failed to allocate message!");
@@ -903,8 +1052,14 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
 
     /* Filling of sn_nsdl_transmit_s */
     stored_msg_ptr->send_msg_ptr->protocol = SN_NSDL_PROTOCOL_COAP;
-    stored_msg_ptr->send_msg_ptr->packet_len = send_packet_data_len;
+    stored_msg_ptr->send_msg_ptr->packet_len = stored_packet_data_len;
     memcpy(stored_msg_ptr->send_msg_ptr->packet_ptr, send_packet_data_ptr, send_packet_data_len);
+    if (stored_packet_data_len != send_packet_data_len) {
+        memcpy(stored_msg_ptr->send_msg_ptr->packet_ptr + send_packet_data_len, payload_ptr, payload_len);
+    } else if (payload_len) {
+        stored_msg_ptr->payload_ptr = payload_ptr;
+        stored_msg_ptr->payload_len = payload_len;
+    }
 
     /* Filling of sn_nsdl_addr_s */
     stored_msg_ptr->send_msg_ptr->dst_addr_ptr->type = dst_addr_ptr->type;
@@ -914,17 +1069,21 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
 
     stored_msg_ptr->coap = handle;
     stored_msg_ptr->param = param;
+    stored_msg_ptr->msg_id = (send_packet_data_ptr[2] << 8) | send_packet_data_ptr[3];
+    stored_msg_ptr->lookup_key = sn_coap_protocol_lookup_key(dst_addr_ptr, stored_msg_ptr->msg_id);
 
-    /* Storing Resending message to Linked list */
-    ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    /* Storing Resending message to Linked list and lookup table */
+    sn_coap_protocol_linked_list_send_msg_insert(handle, stored_msg_ptr);
+    ns_list_add_to_end(&handle->resent_msgs_table[stored_msg_ptr->lookup_key & (SN_COAP_LOOKUP_TABLE_SIZE - 1)], stored_msg_ptr);
     ++handle->count_resent_msgs;
+    handle->count_resent_bytes += stored_packet_data_len;
     return 1;
 }
 
 /**************************************************************************//**
- * \fn static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
+ * \fn static coap_send_msg_s *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
  *
- * \brief Searches stored resending message from Linked list
+ * \brief Searches stored resending message from lookup table
  *
  * \param *src_addr_ptr is searching key for searched message
  *
@@ -934,68 +1093,62 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
  *         list or NULL if message not found
  *****************************************************************************/
 
-static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle,
+static coap_send_msg_s *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle,
         sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-        temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
-        /* If message's Message ID is same than is searched */
-        if (temp_msg_id == msg_id) {
-            /* If message's Source address is same than is searched */
-            if (0 == memcmp(src_addr_ptr->addr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr->addr_ptr, src_addr_ptr->addr_len)) {
-                /* If message's Source address port is same than is searched */
-                if (stored_msg_ptr->send_msg_ptr->dst_addr_ptr->port == src_addr_ptr->port) {
-                    /* * * Message found, return pointer to that stored resending message * * * */
-                    return stored_msg_ptr->send_msg_ptr;
-                }
-            }
+    uint16_t lookup_key = sn_coap_protocol_lookup_key(src_addr_ptr, msg_id);
+
+    /* Loop stored resending messages with the same lookup key bits */
+    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->resent_msgs_table[lookup_key & (SN_COAP_LOOKUP_TABLE_SIZE - 1)]) {
+        if (stored_msg_ptr->lookup_key == lookup_key && stored_msg_ptr->msg_id == msg_id &&
+                sn_coap_protocol_address_match(src_addr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr)) {
+            /* * * Message found, return pointer to that stored resending message * * * */
+            return stored_msg_ptr;
         }
     }
 
     /* Message not found */
     return NULL;
 }
+
 /**************************************************************************//**
- * \fn static void sn_coap_protocol_linked_list_send_msg_remove(sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
+ * \fn static void sn_coap_protocol_linked_list_send_msg_insert(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
  *
- * \brief Removes stored resending message from Linked list
+ * \brief Adds resending message to Linked list in resending time order
  *
- * \param *src_addr_ptr is searching key for searched message
- * \param msg_id is searching key for removed message
+ * Messages are stored with about the same timeout, so the place of a new
+ * message is searched from the end of the list.
+ *
+ * \param *stored_msg_ptr is message to be added
  *****************************************************************************/
 
-static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
+static void sn_coap_protocol_linked_list_send_msg_insert(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
 {
-    /* Loop all stored resending messages in Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-        temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
-        /* If message's Message ID is same than is searched */
-        if (temp_msg_id == msg_id) {
-            /* If message's Source address is same than is searched */
-            if (0 == memcmp(src_addr_ptr->addr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr->addr_ptr, src_addr_ptr->addr_len)) {
-                /* If message's Source address port is same than is searched */
-                if (stored_msg_ptr->send_msg_ptr->dst_addr_ptr->port == src_addr_ptr->port) {
-                    /* * * Message found * * */
-
-                    /* Remove message from Linked list */
-                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                    --handle->count_resent_msgs;
-
-                    /* Free memory of stored message */
-                    sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
-
-                    return;
-                }
-            }
+    ns_list_foreach_reverse(coap_send_msg_s, msg_ptr, &handle->linked_list_resent_msgs) {
+        if (msg_ptr->resending_time <= stored_msg_ptr->resending_time) {
+            ns_list_add_after(&handle->linked_list_resent_msgs, msg_ptr, stored_msg_ptr);
+            return;
         }
     }
+
+    ns_list_add_to_start(&handle->linked_list_resent_msgs, stored_msg_ptr);
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *removed_msg_ptr)
+ *
+ * \brief Removes stored resending message from Linked list and lookup table.
+ *        Memory of message is not released.
+ *
+ * \param *removed_msg_ptr is message to be removed
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *removed_msg_ptr)
+{
+    ns_list_remove(&handle->linked_list_resent_msgs, removed_msg_ptr);
+    ns_list_remove(&handle->resent_msgs_table[removed_msg_ptr->lookup_key & (SN_COAP_LOOKUP_TABLE_SIZE - 1)], removed_msg_ptr);
+    --handle->count_resent_msgs;
+    handle->count_resent_bytes -= removed_msg_ptr->send_msg_ptr->packet_len;
 }
 
 uint32_t sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint8_t interval, const uint8_t counter)
@@ -1026,6 +1179,39 @@ static void sn_coap_protocol_send_rst(struct coap_s *handle, uint16_t msg_id, sn
     handle->sn_coap_tx_callback(packet_ptr, 4, addr_ptr, param);
 
 }
+
+#if ENABLE_RESENDINGS || SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+/**************************************************************************//**
+ * \fn static uint16_t sn_coap_protocol_lookup_key(const sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
+ *
+ * \brief Hashes address, port and Message ID for the lookup tables. Message
+ *        IDs of one peer are consecutive, so they are added last to spread
+ *        its messages over the buckets.
+ *
+ * \param *addr_ptr is pointer to address and port to be hashed
+ * \param msg_id is Message ID to be hashed
+ *
+ * \return Lookup key, of which the low bits select the bucket
+ *****************************************************************************/
+
+static uint16_t sn_coap_protocol_lookup_key(const sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
+{
+    uint16_t key = 5381;
+
+    for (uint8_t i = 0; i < addr_ptr->addr_len; i++) {
+        key = (key << 5) + key + addr_ptr->addr_ptr[i];
+    }
+
+    return key ^ addr_ptr->port ^ msg_id;
+}
+
+static bool sn_coap_protocol_address_match(const sn_nsdl_addr_s *addr_ptr, const sn_nsdl_addr_s *stored_addr_ptr)
+{
+    return addr_ptr->port == stored_addr_ptr->port &&
+           addr_ptr->addr_len == stored_addr_ptr->addr_len &&
+           0 == memcmp(addr_ptr->addr_ptr, stored_addr_ptr->addr_ptr, addr_ptr->addr_len);
+}
+#endif
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
 
 /**************************************************************************//**
@@ -1084,85 +1270,67 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
     stored_duplication_info_ptr->coap = handle;
 
     stored_duplication_info_ptr->param = param;
-    /* * * * Storing Duplication info to Linked list * * * */
+    stored_duplication_info_ptr->lookup_key = sn_coap_protocol_lookup_key(addr_ptr, msg_id);
+    /* * * * Storing Duplication info to Linked list and lookup table * * * */
 
     ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
+    ns_list_add_to_end(&handle->duplication_msgs_table[stored_duplication_info_ptr->lookup_key & (SN_COAP_LOOKUP_TABLE_SIZE - 1)],
+                       stored_duplication_info_ptr);
     ++handle->count_duplication_msgs;
 }
 
 /**************************************************************************//**
- * \fn static int8_t sn_coap_protocol_linked_list_duplication_info_search(sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
+ * \fn static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
  *
- * \brief Searches stored message from Linked list (Address and Message ID as key)
+ * \brief Searches stored message from lookup table (Address and Message ID as key)
  *
  * \param *addr_ptr is pointer to Address key to be searched
  * \param msg_id is Message ID key to be searched
  *
- * \return Return value is 0 when message found and -1 if not found
+ * \return Return value is pointer to found Duplication info or NULL if not found
  *****************************************************************************/
 
 static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_search(struct coap_s *handle,
         sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
 {
-    /* Loop all nodes in Linked list for searching Message ID */
-    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        /* If message's Message ID is same than is searched */
-        if (stored_duplication_info_ptr->msg_id == msg_id) {
-            /* If message's Source address is same than is searched */
-            if (0 == memcmp(addr_ptr->addr_ptr, stored_duplication_info_ptr->address->addr_ptr, addr_ptr->addr_len)) {
-                /* If message's Source address port is same than is searched */
-                if (stored_duplication_info_ptr->address->port == addr_ptr->port) {
-                    /* * * Correct Duplication info found * * * */
-                    return stored_duplication_info_ptr;
-                }
-            }
+    uint16_t lookup_key = sn_coap_protocol_lookup_key(addr_ptr, msg_id);
+
+    /* Loop Duplication infos with the same lookup key bits */
+    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr,
+                    &handle->duplication_msgs_table[lookup_key & (SN_COAP_LOOKUP_TABLE_SIZE - 1)]) {
+        if (stored_duplication_info_ptr->lookup_key == lookup_key && stored_duplication_info_ptr->msg_id == msg_id &&
+                sn_coap_protocol_address_match(addr_ptr, stored_duplication_info_ptr->address)) {
+            /* * * Correct Duplication info found * * * */
+            return stored_duplication_info_ptr;
         }
     }
     return NULL;
 }
 
 /**************************************************************************//**
- * \fn static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *addr_ptr, uint16_t port, uint16_t msg_id)
+ * \fn static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr)
  *
- * \brief Removes stored Duplication info from Linked list
+ * \brief Removes stored Duplication info from Linked list and lookup table,
+ *        and releases its memory
  *
- * \param *addr_ptr is pointer to Address key to be removed
- *
- * \param port is Port key to be removed
- *
- * \param msg_id is Message ID key to be removed
+ * \param *removed_duplication_info_ptr is Duplication info to be removed
  *****************************************************************************/
 
-static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *addr_ptr, uint16_t port, uint16_t msg_id)
+static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr)
 {
-    /* Loop all stored duplication messages in Linked list */
-    ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        /* If message's Address is same than is searched */
-        if (handle == removed_duplication_info_ptr->coap && 0 == memcmp(addr_ptr,
-                                                                        removed_duplication_info_ptr->address->addr_ptr,
-                                                                        removed_duplication_info_ptr->address->addr_len)) {
-            /* If message's Address prt is same than is searched */
-            if (removed_duplication_info_ptr->address->port == port) {
-                /* If Message ID is same than is searched */
-                if (removed_duplication_info_ptr->msg_id == msg_id) {
-                    /* * * * Correct Duplication info found, remove it from Linked list * * * */
-                    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-                    --handle->count_duplication_msgs;
-
-                    /* Free memory of stored Duplication info */
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
-                    removed_duplication_info_ptr->address->addr_ptr = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
-                    removed_duplication_info_ptr->address = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
-                    removed_duplication_info_ptr->packet_ptr = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr);
-                    removed_duplication_info_ptr = 0;
-                    return;
-                }
-            }
-        }
-    }
+    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
+    ns_list_remove(&handle->duplication_msgs_table[removed_duplication_info_ptr->lookup_key & (SN_COAP_LOOKUP_TABLE_SIZE - 1)],
+                   removed_duplication_info_ptr);
+    --handle->count_duplication_msgs;
+
+    /* Free memory of stored Duplication info */
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
+    removed_duplication_info_ptr->address->addr_ptr = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
+    removed_duplication_info_ptr->address = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
+    removed_duplication_info_ptr->packet_ptr = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr);
 }
 
 /**************************************************************************//**
@@ -1173,23 +1341,12 @@ static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *
 
 static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle)
 {
-    /* Loop all stored duplication messages in Linked list */
+    /* Infos are stored in timestamp order, so stop at the first one to keep */
     ns_list_foreach_safe(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        if ((handle->system_time - removed_duplication_info_ptr->timestamp)  > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
-            /* * * * Old Duplication info found, remove it from Linked list * * * */
-            ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-            --handle->count_duplication_msgs;
-
-            /* Free memory of stored Duplication info */
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
-            removed_duplication_info_ptr->address->addr_ptr = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
-            removed_duplication_info_ptr->address = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
-            removed_duplication_info_ptr->packet_ptr = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr);
-            removed_duplication_info_ptr = 0;
+        if ((handle->system_time - removed_duplication_info_ptr->timestamp) <= SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
+            break;
         }
+        sn_coap_protocol_linked_list_duplication_info_remove(handle, removed_duplication_info_ptr);
     }
 }
 
@@ -1454,6 +1611,75 @@ static void sn_coap_protocol_linked_list_blockwise_remove_old_data(struct coap_s
             sn_coap_protocol_linked_list_blockwise_payload_remove(handle, removed_blocwise_payload_ptr);
         }
     }
+
+    /* Loop all streamed transfers in Linked list */
+    ns_list_foreach_safe(coap_blockwise_stream_s, removed_stream_ptr, &handle->linked_list_blockwise_streams) {
+        if ((handle->system_time - removed_stream_ptr->timestamp)  > SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED) {
+            sn_coap_protocol_linked_list_blockwise_stream_remove(handle, removed_stream_ptr);
+        }
+    }
+}
+
+/**************************************************************************//**
+ * \fn static coap_blockwise_stream_s *sn_coap_protocol_linked_list_blockwise_stream_search(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, bool block1)
+ *
+ * \brief Searches the streamed transfer from given address and direction
+ *
+ * \return Pointer to the transfer state, NULL if not found
+ *****************************************************************************/
+
+static coap_blockwise_stream_s *sn_coap_protocol_linked_list_blockwise_stream_search(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, bool block1)
+{
+    ns_list_foreach(coap_blockwise_stream_s, stream_ptr, &handle->linked_list_blockwise_streams) {
+        if (stream_ptr->block1 == block1 && stream_ptr->port == addr_ptr->port &&
+                stream_ptr->addr_len == addr_ptr->addr_len &&
+                0 == memcmp(stream_ptr->addr_ptr, addr_ptr->addr_ptr, addr_ptr->addr_len)) {
+            return stream_ptr;
+        }
+    }
+    return NULL;
+}
+
+/**************************************************************************//**
+ * \fn static coap_blockwise_stream_s *sn_coap_protocol_linked_list_blockwise_stream_store(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, bool block1)
+ *
+ * \brief Starts a streamed transfer from given address, address is stored in the same allocation
+ *
+ * \return Pointer to the transfer state, NULL if allocation failed
+ *****************************************************************************/
+
+static coap_blockwise_stream_s *sn_coap_protocol_linked_list_blockwise_stream_store(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, bool block1)
+{
+    coap_blockwise_stream_s *stored_stream_ptr = handle->sn_coap_protocol_malloc(sizeof(coap_blockwise_stream_s) + addr_ptr->addr_len);
+    if (!stored_stream_ptr) {
+        return NULL;
+    }
+    memset(stored_stream_ptr, 0, sizeof(coap_blockwise_stream_s));
+
+    stored_stream_ptr->timestamp = handle->system_time;
+    stored_stream_ptr->addr_len = addr_ptr->addr_len;
+    stored_stream_ptr->addr_ptr = (uint8_t *)(stored_stream_ptr + 1);
+    memcpy(stored_stream_ptr->addr_ptr, addr_ptr->addr_ptr, addr_ptr->addr_len);
+    stored_stream_ptr->port = addr_ptr->port;
+    stored_stream_ptr->block1 = block1;
+
+    ns_list_add_to_end(&handle->linked_list_blockwise_streams, stored_stream_ptr);
+    return stored_stream_ptr;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_blockwise_stream_remove(struct coap_s *handle, coap_blockwise_stream_s *removed_stream_ptr)
+ *
+ * \brief Removes a streamed transfer and the packet held for it, if any
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_blockwise_stream_remove(struct coap_s *handle, coap_blockwise_stream_s *removed_stream_ptr)
+{
+    ns_list_remove(&handle->linked_list_blockwise_streams, removed_stream_ptr);
+    if (removed_stream_ptr->held_packet_ptr) {
+        handle->sn_coap_protocol_free(removed_stream_ptr->held_packet_ptr);
+    }
+    handle->sn_coap_protocol_free(removed_stream_ptr);
 }
 
 #endif /* SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE */
@@ -1529,26 +1755,6 @@ static void sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handl
     }
 }
 
-/**************************************************************************//**
- * \fn static uint16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr)
- *
- * \brief Counts total message size of all messages in linked list
- *
- * \param const coap_send_msg_list_t *linked_list_ptr pointer to linked list
- *****************************************************************************/
-static uint16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr)
-{
-    uint16_t total_size = 0;
-
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, linked_list_ptr) {
-        if (stored_msg_ptr->send_msg_ptr) {
-            total_size += stored_msg_ptr->send_msg_ptr->packet_len;
-        }
-    }
-
-    return total_size;
-}
-
 #endif
 
 #if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
@@ -1619,6 +1825,14 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
     uint16_t original_payload_len = 0;
     uint8_t *original_payload_ptr = NULL;
 
+    /* Received transfers go to the application block by block, if it asked for that */
+    if (handle->sn_coap_block_stream_callback &&
+            (received_coap_msg_ptr->options_list_ptr->block1 != COAP_OPTION_BLOCK_NONE ?
+             received_coap_msg_ptr->msg_code <= COAP_MSG_CODE_REQUEST_DELETE :
+             received_coap_msg_ptr->msg_code > COAP_MSG_CODE_REQUEST_DELETE && handle->sn_coap_internal_block2_resp_handling)) {
+        return sn_coap_handle_blockwise_stream(handle, src_addr_ptr, received_coap_msg_ptr, param);
+    }
+
     /* Block1 Option in a request (e.g., PUT or POST) */
     // Blocked request sending, received ACK, sending next block..
     if (received_coap_msg_ptr->options_list_ptr->block1 != COAP_OPTION_BLOCK_NONE) {
@@ -1741,87 +1955,16 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
             /* If not last block (more value is set) */
             /* Block option length can be 1-3 bytes. First 4-20 bits are for block number. Last 4 bits are ALWAYS more bit + block size. */
             if (received_coap_msg_ptr->options_list_ptr->block1 & 0x08) {
-                src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
-                if (src_coap_blockwise_ack_msg_ptr == NULL) {
-                    tr_error("sn_coap_handle_blockwise_message - (recv block1) failed to allocate ack message!");
-                    sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                    return NULL;
-                }
-
-                if (sn_coap_parser_alloc_options(handle, src_coap_blockwise_ack_msg_ptr) == NULL) {
-                   tr_error("sn_coap_handle_blockwise_message - (recv block1) failed to allocate options!");
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                    src_coap_blockwise_ack_msg_ptr = 0;
-                    sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                    return NULL;
-                }
-
-                if (!blocks_in_order) {
-                    tr_error("sn_coap_handle_blockwise_message - (recv block1) COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE!");
-                    src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE;
-                } else if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_REQUEST_GET) {
-                    src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_CONTENT;
-                } else if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_REQUEST_POST) {
-                    src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_CONTINUE;
-                } else if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_REQUEST_PUT) {
-                    src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_CONTINUE;
-                } else if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_REQUEST_DELETE) {
-                    src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_DELETED;
-                }
-
-                // Response with COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE if the payload size is more than we can handle
-                if (received_coap_msg_ptr->options_list_ptr->size1 > SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE) {
-                    // Include maximum size that stack can handle into response
-                    tr_error("sn_coap_handle_blockwise_message - (recv block1) COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE!");
-                    src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
-                }
-                else {
-                    src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 = received_coap_msg_ptr->options_list_ptr->block1;
-                    src_coap_blockwise_ack_msg_ptr->msg_type = COAP_MSG_TYPE_ACKNOWLEDGEMENT;
-
-                    /* Check block size */
-                    block_temp = (src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 & 0x07);
-                    uint16_t block_size = 1u << (block_temp + 4);
-                    if (block_size >  handle->sn_coap_block_data_size) {
-                         // Include maximum size that stack can handle into response
-                         tr_error("sn_coap_handle_blockwise_message - (recv block1) COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE!");
-                         src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
-                         src_coap_blockwise_ack_msg_ptr->options_list_ptr->size1 = handle->sn_coap_block_data_size;
-                         sn_coap_protocol_linked_list_blockwise_payload_remove_oldest(handle);
-                    }
-
-                    if (block_temp > sn_coap_convert_block_size(handle->sn_coap_block_data_size)) {
-                        src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 &= 0xFFFFF8;
-                        src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 |= sn_coap_convert_block_size(handle->sn_coap_block_data_size);
-                    }
-                }
-
-                src_coap_blockwise_ack_msg_ptr->msg_id = received_coap_msg_ptr->msg_id;
-
-                // Copy token to response
-                src_coap_blockwise_ack_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(received_coap_msg_ptr->token_len);
-                if (src_coap_blockwise_ack_msg_ptr->token_ptr) {
-                    memcpy(src_coap_blockwise_ack_msg_ptr->token_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
-                    src_coap_blockwise_ack_msg_ptr->token_len = received_coap_msg_ptr->token_len;
-                }
-
-                dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
-
-                dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
+                dst_ack_packet_data_ptr = sn_coap_protocol_build_block1_ack(handle, received_coap_msg_ptr, blocks_in_order,
+                                                                            SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE,
+                                                                            &dst_packed_data_needed_mem);
                 if (!dst_ack_packet_data_ptr) {
-                    tr_error("sn_coap_handle_blockwise_message - (recv block1) message allocation failed!");
                     sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                    src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                    src_coap_blockwise_ack_msg_ptr = 0;
                     return NULL;
                 }
 
-                sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
                 handle->sn_coap_tx_callback(dst_ack_packet_data_ptr, dst_packed_data_needed_mem, src_addr_ptr, param);
 
-                sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
                 handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
                 dst_ack_packet_data_ptr = 0;
 
@@ -1868,8 +2011,6 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
         //This is response to request we made
         if (received_coap_msg_ptr->msg_code > COAP_MSG_CODE_REQUEST_DELETE) {
             if (handle->sn_coap_internal_block2_resp_handling) {
-                uint32_t block_number = 0;
-
                 /* Store blockwise payload to Linked list */
                 //todo: add block number to stored values - just to make sure all packets are in order
                 sn_coap_protocol_linked_list_blockwise_payload_store(handle,
@@ -1879,156 +2020,13 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                                                                      received_coap_msg_ptr->options_list_ptr->block2 >> 4);
                 /* If not last block (more value is set) */
                 if (received_coap_msg_ptr->options_list_ptr->block2 & 0x08) {
-                    coap_blockwise_msg_s *previous_blockwise_msg_ptr = NULL;
                     //build and send ack
                     received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
 
-                    ns_list_foreach(coap_blockwise_msg_s, msg, &handle->linked_list_blockwise_sent_msgs) {
-                        if (received_coap_msg_ptr->msg_id == msg->coap_msg_ptr->msg_id) {
-                            previous_blockwise_msg_ptr = msg;
-                            break;
-                        }
-                    }
-
-                    if (!previous_blockwise_msg_ptr || !previous_blockwise_msg_ptr->coap_msg_ptr) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) previous message null!");
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                        return 0;
-                    }
-
-                    src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
-                    if (src_coap_blockwise_ack_msg_ptr == NULL) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate message!");
-                        return 0;
-                    }
-
-                    /* * * Then build CoAP Acknowledgement message * * */
-
-                    if (sn_coap_parser_alloc_options(handle, src_coap_blockwise_ack_msg_ptr) == NULL) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate options!");
-                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                        src_coap_blockwise_ack_msg_ptr = 0;
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                        return NULL;
-                    }
-
-                    src_coap_blockwise_ack_msg_ptr->msg_id = message_id++;
-                    if (message_id == 0) {
-                        message_id = 1;
-                    }
-
-                    /* Update block option */
-                    block_temp = received_coap_msg_ptr->options_list_ptr->block2 & 0x07;
-
-                    block_number = received_coap_msg_ptr->options_list_ptr->block2 >> 4;
-                    block_number ++;
-
-                    src_coap_blockwise_ack_msg_ptr->options_list_ptr->block2 = (block_number << 4) | block_temp;
-
-
-                    /* Set BLOCK2 (subsequent) GET msg code and copy uri path from previous msg*/
-                    if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_RESPONSE_CONTENT) {
-                        src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_REQUEST_GET;
-                        if (previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_ptr) {
-                            src_coap_blockwise_ack_msg_ptr->uri_path_len = previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_len;
-                            src_coap_blockwise_ack_msg_ptr->uri_path_ptr = handle->sn_coap_protocol_malloc(previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_len);
-                            if (!src_coap_blockwise_ack_msg_ptr->uri_path_ptr) {
-                                sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
-                                tr_error("sn_coap_handle_blockwise_message - failed to allocate for uri path ptr!");
-                                return NULL;
-                            }
-                            memcpy(src_coap_blockwise_ack_msg_ptr->uri_path_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_len);
-                        }
-                        if (previous_blockwise_msg_ptr->coap_msg_ptr->token_ptr) {
-                            src_coap_blockwise_ack_msg_ptr->token_len = previous_blockwise_msg_ptr->coap_msg_ptr->token_len;
-                            src_coap_blockwise_ack_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(previous_blockwise_msg_ptr->coap_msg_ptr->token_len);
-                            if (!src_coap_blockwise_ack_msg_ptr->token_ptr) {
-                                sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
-                                tr_error("sn_coap_handle_blockwise_message - failed to allocate for token ptr!");
-                                return NULL;
-                            }
-                            memcpy(src_coap_blockwise_ack_msg_ptr->token_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->token_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->token_len);
-                        }
-                    }
-
-                    ns_list_remove(&handle->linked_list_blockwise_sent_msgs, previous_blockwise_msg_ptr);
-                    if (previous_blockwise_msg_ptr->coap_msg_ptr) {
-                        if (previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr) {
-                            handle->sn_coap_protocol_free(previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr);
-                            previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr = 0;
-                        }
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, previous_blockwise_msg_ptr->coap_msg_ptr);
-                        previous_blockwise_msg_ptr->coap_msg_ptr = 0;
-                    }
-                    handle->sn_coap_protocol_free(previous_blockwise_msg_ptr);
-                    previous_blockwise_msg_ptr = 0;
-
-                    /* Then get needed memory count for Packet data */
-                    dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr ,handle->sn_coap_block_data_size);
-
-                    /* Then allocate memory for Packet data */
-                    dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
-
-                    if (dst_ack_packet_data_ptr == NULL) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate packet!");
-                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                        src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
-                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                        src_coap_blockwise_ack_msg_ptr = 0;
+                    if (sn_coap_protocol_request_next_block2(handle, src_addr_ptr, received_coap_msg_ptr, param, NULL) != 0) {
                         sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
                         return NULL;
                     }
-                    memset(dst_ack_packet_data_ptr, 0, dst_packed_data_needed_mem);
-
-                    /* * * Then build Acknowledgement message to Packed data * * */
-                    if ((sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size)) < 0) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) builder failed!");
-                        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
-                        dst_ack_packet_data_ptr = 0;
-                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                        src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
-                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                        src_coap_blockwise_ack_msg_ptr = 0;
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                        return NULL;
-                    }
-
-                    /* * * Save to linked list * * */
-                    coap_blockwise_msg_s *stored_blockwise_msg_ptr;
-
-                    stored_blockwise_msg_ptr = handle->sn_coap_protocol_malloc(sizeof(coap_blockwise_msg_s));
-                    if (!stored_blockwise_msg_ptr) {
-                        tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate blockwise message!");
-                        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
-                        dst_ack_packet_data_ptr = 0;
-                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                        src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
-                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                        src_coap_blockwise_ack_msg_ptr = 0;
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
-                        return 0;
-                    }
-                    memset(stored_blockwise_msg_ptr, 0, sizeof(coap_blockwise_msg_s));
-
-                    stored_blockwise_msg_ptr->timestamp = handle->system_time;
-
-                    stored_blockwise_msg_ptr->coap_msg_ptr = src_coap_blockwise_ack_msg_ptr;
-                    stored_blockwise_msg_ptr->coap = handle;
-                    ns_list_add_to_end(&handle->linked_list_blockwise_sent_msgs, stored_blockwise_msg_ptr);
-
-                    /* * * Then release memory of CoAP Acknowledgement message * * */
-                    handle->sn_coap_tx_callback(dst_ack_packet_data_ptr,
-                                                dst_packed_data_needed_mem, src_addr_ptr, param);
-
-    #if ENABLE_RESENDINGS
-                    uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
-                    sn_coap_protocol_linked_list_send_msg_store(handle, src_addr_ptr,
-                            dst_packed_data_needed_mem,
-                            dst_ack_packet_data_ptr,
-                            resend_time, param);
-    #endif
-                    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
-                    dst_ack_packet_data_ptr = 0;
                 }
 
                 //Last block received
@@ -2169,6 +2167,396 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
     return received_coap_msg_ptr;
 }
 
+/**************************************************************************//**
+ * \fn static uint8_t *sn_coap_protocol_build_block1_ack(struct coap_s *handle, sn_coap_hdr_s *received_coap_msg_ptr, bool blocks_in_order, uint32_t max_size, uint16_t *packet_len)
+ *
+ * \brief Builds the Acknowledgement asking for the next block of a received Block1 request
+ *
+ * \param *received_coap_msg_ptr Received block
+ * \param blocks_in_order False if the block was not the expected one
+ * \param max_size Largest Size1 accepted
+ * \param *packet_len Length of the built packet
+ *
+ * \return Built packet, released by caller, NULL if allocation failed
+ *****************************************************************************/
+
+static uint8_t *sn_coap_protocol_build_block1_ack(struct coap_s *handle, sn_coap_hdr_s *received_coap_msg_ptr,
+                                                  bool blocks_in_order, uint32_t max_size, uint16_t *packet_len)
+{
+    sn_coap_hdr_s *src_coap_blockwise_ack_msg_ptr = NULL;
+    uint8_t *dst_ack_packet_data_ptr = NULL;
+    uint8_t block_temp = 0;
+
+    src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
+    if (src_coap_blockwise_ack_msg_ptr == NULL) {
+        tr_error("sn_coap_protocol_build_block1_ack - failed to allocate ack message!");
+        return NULL;
+    }
+
+    if (sn_coap_parser_alloc_options(handle, src_coap_blockwise_ack_msg_ptr) == NULL) {
+        tr_error("sn_coap_protocol_build_block1_ack - failed to allocate options!");
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+        src_coap_blockwise_ack_msg_ptr = 0;
+        return NULL;
+    }
+
+    if (!blocks_in_order) {
+        tr_error("sn_coap_protocol_build_block1_ack - COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE!");
+        src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE;
+    } else if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_REQUEST_GET) {
+        src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_CONTENT;
+    } else if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_REQUEST_POST) {
+        src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_CONTINUE;
+    } else if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_REQUEST_PUT) {
+        src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_CONTINUE;
+    } else if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_REQUEST_DELETE) {
+        src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_DELETED;
+    }
+
+    // Response with COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE if the payload size is more than we can handle
+    if (received_coap_msg_ptr->options_list_ptr->size1 > max_size) {
+        // Include maximum size that stack can handle into response
+        tr_error("sn_coap_protocol_build_block1_ack - COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE!");
+        src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
+    }
+    else {
+        src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 = received_coap_msg_ptr->options_list_ptr->block1;
+        src_coap_blockwise_ack_msg_ptr->msg_type = COAP_MSG_TYPE_ACKNOWLEDGEMENT;
+
+        /* Check block size */
+        block_temp = (src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 & 0x07);
+        uint16_t block_size = 1u << (block_temp + 4);
+        if (block_size >  handle->sn_coap_block_data_size) {
+             // Include maximum size that stack can handle into response
+             tr_error("sn_coap_protocol_build_block1_ack - COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE!");
+             src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
+             src_coap_blockwise_ack_msg_ptr->options_list_ptr->size1 = handle->sn_coap_block_data_size;
+             sn_coap_protocol_linked_list_blockwise_payload_remove_oldest(handle);
+        }
+
+        if (block_temp > sn_coap_convert_block_size(handle->sn_coap_block_data_size)) {
+            src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 &= 0xFFFFF8;
+            src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 |= sn_coap_convert_block_size(handle->sn_coap_block_data_size);
+        }
+    }
+
+    src_coap_blockwise_ack_msg_ptr->msg_id = received_coap_msg_ptr->msg_id;
+
+    // Copy token to response
+    src_coap_blockwise_ack_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(received_coap_msg_ptr->token_len);
+    if (src_coap_blockwise_ack_msg_ptr->token_ptr) {
+        memcpy(src_coap_blockwise_ack_msg_ptr->token_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+        src_coap_blockwise_ack_msg_ptr->token_len = received_coap_msg_ptr->token_len;
+    }
+
+    *packet_len = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
+
+    dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(*packet_len);
+    if (dst_ack_packet_data_ptr) {
+        sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
+    } else {
+        tr_error("sn_coap_protocol_build_block1_ack - message allocation failed!");
+    }
+
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+    return dst_ack_packet_data_ptr;
+}
+
+/**************************************************************************//**
+ * \fn static int8_t sn_coap_protocol_request_next_block2(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param, coap_blockwise_stream_s *hold_stream_ptr)
+ *
+ * \brief Requests the block following a received Block2 response
+ *
+ * The request replaces the previous one in the list of sent blockwise messages.
+ *
+ * \param *received_coap_msg_ptr Received block
+ * \param *hold_stream_ptr If not NULL, the request is stored there instead of sent
+ *
+ * \return 0 = success, -1 = failure
+ *****************************************************************************/
+
+static int8_t sn_coap_protocol_request_next_block2(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr,
+                                                   sn_coap_hdr_s *received_coap_msg_ptr, void *param,
+                                                   coap_blockwise_stream_s *hold_stream_ptr)
+{
+    coap_blockwise_msg_s *previous_blockwise_msg_ptr = NULL;
+    sn_coap_hdr_s *src_coap_blockwise_ack_msg_ptr = NULL;
+    uint16_t dst_packed_data_needed_mem = 0;
+    uint8_t *dst_ack_packet_data_ptr = NULL;
+    uint8_t block_temp = 0;
+    uint32_t block_number = 0;
+
+    ns_list_foreach(coap_blockwise_msg_s, msg, &handle->linked_list_blockwise_sent_msgs) {
+        if (received_coap_msg_ptr->msg_id == msg->coap_msg_ptr->msg_id) {
+            previous_blockwise_msg_ptr = msg;
+            break;
+        }
+    }
+
+    if (!previous_blockwise_msg_ptr || !previous_blockwise_msg_ptr->coap_msg_ptr) {
+        tr_error("sn_coap_protocol_request_next_block2 - previous message null!");
+        return -1;
+    }
+
+    src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
+    if (src_coap_blockwise_ack_msg_ptr == NULL) {
+        tr_error("sn_coap_protocol_request_next_block2 - failed to allocate message!");
+        return -1;
+    }
+
+    /* * * Then build CoAP Acknowledgement message * * */
+
+    if (sn_coap_parser_alloc_options(handle, src_coap_blockwise_ack_msg_ptr) == NULL) {
+        tr_error("sn_coap_protocol_request_next_block2 - failed to allocate options!");
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+        src_coap_blockwise_ack_msg_ptr = 0;
+        return -1;
+    }
+
+    src_coap_blockwise_ack_msg_ptr->msg_id = message_id++;
+    if (message_id == 0) {
+        message_id = 1;
+    }
+
+    /* Update block option */
+    block_temp = received_coap_msg_ptr->options_list_ptr->block2 & 0x07;
+
+    block_number = received_coap_msg_ptr->options_list_ptr->block2 >> 4;
+    block_number ++;
+
+    src_coap_blockwise_ack_msg_ptr->options_list_ptr->block2 = (block_number << 4) | block_temp;
+
+
+    /* Set BLOCK2 (subsequent) GET msg code and copy uri path from previous msg*/
+    if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_RESPONSE_CONTENT) {
+        src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_REQUEST_GET;
+        if (previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_ptr) {
+            src_coap_blockwise_ack_msg_ptr->uri_path_len = previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_len;
+            src_coap_blockwise_ack_msg_ptr->uri_path_ptr = handle->sn_coap_protocol_malloc(previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_len);
+            if (!src_coap_blockwise_ack_msg_ptr->uri_path_ptr) {
+                sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+                tr_error("sn_coap_protocol_request_next_block2 - failed to allocate for uri path ptr!");
+                return -1;
+            }
+            memcpy(src_coap_blockwise_ack_msg_ptr->uri_path_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->uri_path_len);
+        }
+        if (previous_blockwise_msg_ptr->coap_msg_ptr->token_ptr) {
+            src_coap_blockwise_ack_msg_ptr->token_len = previous_blockwise_msg_ptr->coap_msg_ptr->token_len;
+            src_coap_blockwise_ack_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(previous_blockwise_msg_ptr->coap_msg_ptr->token_len);
+            if (!src_coap_blockwise_ack_msg_ptr->token_ptr) {
+                sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+                tr_error("sn_coap_protocol_request_next_block2 - failed to allocate for token ptr!");
+                return -1;
+            }
+            memcpy(src_coap_blockwise_ack_msg_ptr->token_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->token_ptr, previous_blockwise_msg_ptr->coap_msg_ptr->token_len);
+        }
+    }
+
+    ns_list_remove(&handle->linked_list_blockwise_sent_msgs, previous_blockwise_msg_ptr);
+    if (previous_blockwise_msg_ptr->coap_msg_ptr) {
+        if (previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr) {
+            handle->sn_coap_protocol_free(previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr);
+            previous_blockwise_msg_ptr->coap_msg_ptr->payload_ptr = 0;
+        }
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, previous_blockwise_msg_ptr->coap_msg_ptr);
+        previous_blockwise_msg_ptr->coap_msg_ptr = 0;
+    }
+    handle->sn_coap_protocol_free(previous_blockwise_msg_ptr);
+    previous_blockwise_msg_ptr = 0;
+
+    /* Then get needed memory count for Packet data */
+    dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr ,handle->sn_coap_block_data_size);
+
+    /* Then allocate memory for Packet data */
+    dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
+
+    if (dst_ack_packet_data_ptr == NULL) {
+        tr_error("sn_coap_protocol_request_next_block2 - failed to allocate packet!");
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+        return -1;
+    }
+    memset(dst_ack_packet_data_ptr, 0, dst_packed_data_needed_mem);
+
+    /* * * Then build Acknowledgement message to Packed data * * */
+    if ((sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size)) < 0) {
+        tr_error("sn_coap_protocol_request_next_block2 - builder failed!");
+        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+        dst_ack_packet_data_ptr = 0;
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+        return -1;
+    }
+
+    /* * * Save to linked list * * */
+    coap_blockwise_msg_s *stored_blockwise_msg_ptr;
+
+    stored_blockwise_msg_ptr = handle->sn_coap_protocol_malloc(sizeof(coap_blockwise_msg_s));
+    if (!stored_blockwise_msg_ptr) {
+        tr_error("sn_coap_protocol_request_next_block2 - failed to allocate blockwise message!");
+        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+        dst_ack_packet_data_ptr = 0;
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
+        return -1;
+    }
+    memset(stored_blockwise_msg_ptr, 0, sizeof(coap_blockwise_msg_s));
+    stored_blockwise_msg_ptr->timestamp = handle->system_time;
+
+    stored_blockwise_msg_ptr->coap_msg_ptr = src_coap_blockwise_ack_msg_ptr;
+    stored_blockwise_msg_ptr->coap = handle;
+    ns_list_add_to_end(&handle->linked_list_blockwise_sent_msgs, stored_blockwise_msg_ptr);
+
+    /* Sent, and stored for resending, when the application resumes the transfer */
+    if (hold_stream_ptr) {
+        hold_stream_ptr->held_packet_ptr = dst_ack_packet_data_ptr;
+        hold_stream_ptr->held_packet_len = dst_packed_data_needed_mem;
+        hold_stream_ptr->held_resend = true;
+        hold_stream_ptr->param = param;
+        return 0;
+    }
+
+    /* * * Then release memory of CoAP Acknowledgement message * * */
+    handle->sn_coap_tx_callback(dst_ack_packet_data_ptr,
+                                dst_packed_data_needed_mem, src_addr_ptr, param);
+
+#if ENABLE_RESENDINGS
+    uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
+    sn_coap_protocol_linked_list_send_msg_store(handle, src_addr_ptr,
+            dst_packed_data_needed_mem,
+            dst_ack_packet_data_ptr,
+            NULL, 0,
+            resend_time, param);
+#endif
+    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+    dst_ack_packet_data_ptr = 0;
+
+    return 0;
+}
+
+/**************************************************************************//**
+ * \fn static sn_coap_hdr_s *sn_coap_handle_blockwise_stream(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param)
+ *
+ * \brief Gives a received block to the block stream callback, in place of storing it
+ *
+ * Blocks must arrive in order. A repeated block is acknowledged again unless the
+ * application holds the transfer, anything else restarts or aborts the transfer.
+ *
+ * \return Received message, or NULL if it was released
+ *****************************************************************************/
+
+static sn_coap_hdr_s *sn_coap_handle_blockwise_stream(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param)
+{
+    bool block1 = received_coap_msg_ptr->options_list_ptr->block1 != COAP_OPTION_BLOCK_NONE;
+    int32_t block = block1 ? received_coap_msg_ptr->options_list_ptr->block1 : received_coap_msg_ptr->options_list_ptr->block2;
+    uint16_t block_size = 1u << ((block & 0x07) + 4);
+    uint32_t offset = (uint32_t)(block >> 4) * block_size;
+    bool last = !(block & 0x08);
+    uint16_t dst_packed_data_needed_mem = 0;
+    uint8_t *dst_ack_packet_data_ptr = NULL;
+    coap_blockwise_stream_s *stream_ptr;
+    int8_t ret;
+
+    stream_ptr = sn_coap_protocol_linked_list_blockwise_stream_search(handle, src_addr_ptr, block1);
+
+    if (stream_ptr && offset != stream_ptr->next_offset && offset == stream_ptr->block_offset) {
+        /* Repeated block, already given to the application */
+        if (block1 && !stream_ptr->held_packet_ptr) {
+            dst_ack_packet_data_ptr = sn_coap_protocol_build_block1_ack(handle, received_coap_msg_ptr, true, UINT32_MAX, &dst_packed_data_needed_mem);
+            if (dst_ack_packet_data_ptr) {
+                handle->sn_coap_tx_callback(dst_ack_packet_data_ptr, dst_packed_data_needed_mem, src_addr_ptr, param);
+                handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+            }
+        }
+        received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
+        return received_coap_msg_ptr;
+    }
+
+    if (offset == 0) {
+        /* First block, or the peer started over */
+        if (stream_ptr) {
+            sn_coap_protocol_linked_list_blockwise_stream_remove(handle, stream_ptr);
+        }
+        stream_ptr = sn_coap_protocol_linked_list_blockwise_stream_store(handle, src_addr_ptr, block1);
+        if (!stream_ptr) {
+            tr_error("sn_coap_handle_blockwise_stream - failed to allocate stream!");
+            sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
+            return NULL;
+        }
+    }
+
+    /* Out of order, or larger blocks than we take: ACK tells which, and the transfer ends */
+    if (!stream_ptr || offset != stream_ptr->next_offset ||
+            (block1 && block_size > handle->sn_coap_block_data_size)) {
+        tr_error("sn_coap_handle_blockwise_stream - block rejected!");
+        if (block1) {
+            dst_ack_packet_data_ptr = sn_coap_protocol_build_block1_ack(handle, received_coap_msg_ptr, stream_ptr && offset == stream_ptr->next_offset,
+                                                                        UINT32_MAX, &dst_packed_data_needed_mem);
+            if (dst_ack_packet_data_ptr) {
+                handle->sn_coap_tx_callback(dst_ack_packet_data_ptr, dst_packed_data_needed_mem, src_addr_ptr, param);
+                handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+            }
+        }
+        if (stream_ptr) {
+            sn_coap_protocol_linked_list_blockwise_stream_remove(handle, stream_ptr);
+        }
+        received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED;
+        return received_coap_msg_ptr;
+    }
+
+    if (received_coap_msg_ptr->payload_len > block_size) {
+        received_coap_msg_ptr->payload_len = block_size;
+    }
+    stream_ptr->timestamp = handle->system_time;
+    stream_ptr->block_offset = offset;
+    stream_ptr->next_offset = offset + received_coap_msg_ptr->payload_len;
+    stream_ptr->msg_id = received_coap_msg_ptr->msg_id;
+
+    ret = handle->sn_coap_block_stream_callback(handle, received_coap_msg_ptr, src_addr_ptr, offset, last, param);
+
+    if (ret < 0) {
+        if (block1) {
+            dst_ack_packet_data_ptr = sn_coap_protocol_build_block1_ack(handle, received_coap_msg_ptr, false, UINT32_MAX, &dst_packed_data_needed_mem);
+            if (dst_ack_packet_data_ptr) {
+                handle->sn_coap_tx_callback(dst_ack_packet_data_ptr, dst_packed_data_needed_mem, src_addr_ptr, param);
+                handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+            }
+        }
+        sn_coap_protocol_linked_list_blockwise_stream_remove(handle, stream_ptr);
+        received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED;
+        return received_coap_msg_ptr;
+    }
+
+    if (last) {
+        /* Application responds to the request itself */
+        sn_coap_protocol_linked_list_blockwise_stream_remove(handle, stream_ptr);
+        received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_STREAMED;
+        return received_coap_msg_ptr;
+    }
+
+    if (block1) {
+        dst_ack_packet_data_ptr = sn_coap_protocol_build_block1_ack(handle, received_coap_msg_ptr, true, UINT32_MAX, &dst_packed_data_needed_mem);
+        if (!dst_ack_packet_data_ptr) {
+            sn_coap_protocol_linked_list_blockwise_stream_remove(handle, stream_ptr);
+            sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
+            return NULL;
+        }
+        if (ret > 0) {
+            stream_ptr->held_packet_ptr = dst_ack_packet_data_ptr;
+            stream_ptr->held_packet_len = dst_packed_data_needed_mem;
+            stream_ptr->held_resend = false;
+            stream_ptr->param = param;
+        } else {
+            handle->sn_coap_tx_callback(dst_ack_packet_data_ptr, dst_packed_data_needed_mem, src_addr_ptr, param);
+            handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+        }
+    } else if (sn_coap_protocol_request_next_block2(handle, src_addr_ptr, received_coap_msg_ptr, param, ret > 0 ? stream_ptr : NULL) != 0) {
+        sn_coap_protocol_linked_list_blockwise_stream_remove(handle, stream_ptr);
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
+        return NULL;
+    }
+
+    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
+    return received_coap_msg_ptr;
+}
+
 int8_t sn_coap_convert_block_size(uint16_t block_size)
 {
     if (block_size == 16) {
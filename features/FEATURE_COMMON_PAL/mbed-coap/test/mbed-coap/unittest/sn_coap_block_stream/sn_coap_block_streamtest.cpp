@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2015-2017, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "test_sn_coap_block_stream.h"
+
+TEST_GROUP(sn_coap_block_stream)
+{
+    void setup()
+    {
+        CHECK(test_sn_coap_block_stream_setup());
+    }
+
+    void teardown()
+    {
+        test_sn_coap_block_stream_teardown();
+    }
+};
+
+TEST(sn_coap_block_stream, test_sn_coap_block_stream_download)
+{
+    CHECK(test_sn_coap_block_stream_download());
+}
+
+TEST(sn_coap_block_stream, test_sn_coap_block_stream_upload)
+{
+    CHECK(test_sn_coap_block_stream_upload());
+}
+
+TEST(sn_coap_block_stream, test_sn_coap_block_stream_abort)
+{
+    CHECK(test_sn_coap_block_stream_abort());
+}
@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2015-2017, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Moves 1 MB through the library in each direction with a block stream
+ * callback set, holding every HOLD_EVERY'th block for a while, and checks
+ * that the heap in use stays a few buffers, not the size of the transfer.
+ * The peer is a second handle using the plain parser and builder.
+ */
+#include "test_sn_coap_block_stream.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ns_types.h"
+#include "mbed-coap/sn_coap_header.h"
+#include "mbed-coap/sn_coap_protocol.h"
+#include "sn_coap_protocol_internal.h"
+
+#define TRANSFER_SIZE       (1024 * 1024)
+#define BLOCK_SIZE          1024
+#define BLOCK_SZX           6
+#define HOLD_EVERY          100
+#define HEAP_LIMIT          4096
+
+static struct coap_s *handle;
+static struct coap_s *peer;
+
+static uint8_t peer_addr_buf[16];
+static sn_nsdl_addr_s peer_addr;
+
+/* Heap of the handle under test, sizes kept in front of each block */
+typedef union {
+    size_t size;
+    void *align;
+} heap_header_t;
+
+static size_t heap_in_use;
+static size_t heap_peak;
+
+/* Last packet sent by the handle under test */
+static uint8_t sent_packet[BLOCK_SIZE + 64];
+static uint16_t sent_len;
+static uint32_t sent_count;
+
+/* What the stream callback saw */
+static uint32_t stream_bytes;
+static uint32_t stream_blocks;
+static uint32_t stream_errors;
+static uint32_t stream_last;
+static uint32_t stream_abort_at;
+static bool stream_held;
+static uint16_t stream_held_msg_id;
+
+/* Not reused between uploads, the handle would take them for duplicates */
+static uint16_t upload_msg_id;
+
+static void *test_malloc(uint16_t size)
+{
+    heap_header_t *h = malloc(sizeof(heap_header_t) + size);
+    if (!h) {
+        return NULL;
+    }
+    h->size = size;
+    heap_in_use += size;
+    if (heap_in_use > heap_peak) {
+        heap_peak = heap_in_use;
+    }
+    return h + 1;
+}
+
+static void test_free(void *ptr)
+{
+    if (ptr) {
+        heap_header_t *h = (heap_header_t *) ptr - 1;
+        heap_in_use -= h->size;
+        free(h);
+    }
+}
+
+static void *peer_malloc(uint16_t size)
+{
+    return malloc(size);
+}
+
+static void peer_free(void *ptr)
+{
+    free(ptr);
+}
+
+static uint8_t test_tx(uint8_t *data_ptr, uint16_t data_len, sn_nsdl_addr_s *address_ptr, void *param)
+{
+    if (data_len > sizeof(sent_packet) || sent_len) {
+        /* Too big, or a second packet before the peer answered the first */
+        stream_errors++;
+        return 0;
+    }
+    memcpy(sent_packet, data_ptr, data_len);
+    sent_len = data_len;
+    sent_count++;
+    return 1;
+}
+
+static uint8_t peer_tx(uint8_t *data_ptr, uint16_t data_len, sn_nsdl_addr_s *address_ptr, void *param)
+{
+    return 0;
+}
+
+static uint8_t pattern(uint32_t offset)
+{
+    return (uint8_t)(offset * 7 + (offset >> 10));
+}
+
+static int8_t stream_cb(struct coap_s *h, sn_coap_hdr_s *msg, sn_nsdl_addr_s *addr, uint32_t offset, uint8_t last, void *param)
+{
+    if (h != handle || addr->port != peer_addr.port || offset != stream_bytes) {
+        stream_errors++;
+    }
+    for (uint16_t i = 0; i < msg->payload_len; i++) {
+        if (msg->payload_ptr[i] != pattern(offset + i)) {
+            stream_errors++;
+            break;
+        }
+    }
+    stream_bytes += msg->payload_len;
+    stream_blocks++;
+    if (last) {
+        stream_last++;
+    }
+
+    if (stream_blocks == stream_abort_at) {
+        return -1;
+    }
+    if (stream_blocks % HOLD_EVERY == 0) {
+        stream_held = true;
+        stream_held_msg_id = msg->msg_id;
+        return 1;
+    }
+    return 0;
+}
+
+bool test_sn_coap_block_stream_setup()
+{
+    heap_in_use = 0;
+    heap_peak = 0;
+    sent_len = 0;
+    sent_count = 0;
+    stream_bytes = 0;
+    stream_blocks = 0;
+    stream_errors = 0;
+    stream_last = 0;
+    stream_abort_at = 0;
+    stream_held = false;
+    upload_msg_id = 0x2000;
+
+    memset(peer_addr_buf, 0, sizeof(peer_addr_buf));
+    peer_addr_buf[0] = 0xfd;
+    peer_addr_buf[15] = 1;
+    peer_addr.addr_ptr = peer_addr_buf;
+    peer_addr.addr_len = sizeof(peer_addr_buf);
+    peer_addr.port = 5683;
+    peer_addr.type = SN_NSDL_ADDRESS_TYPE_IPV6;
+
+    handle = sn_coap_protocol_init(test_malloc, test_free, test_tx, NULL);
+    peer = sn_coap_protocol_init(peer_malloc, peer_free, peer_tx, NULL);
+    if (!handle || !peer) {
+        return false;
+    }
+    return sn_coap_protocol_set_block_stream_callback(handle, stream_cb) == 0;
+}
+
+void test_sn_coap_block_stream_teardown()
+{
+    sn_coap_protocol_destroy(handle);
+    sn_coap_protocol_destroy(peer);
+    handle = NULL;
+    peer = NULL;
+}
+
+static void init_options(sn_coap_options_list_s *opts)
+{
+    memset(opts, 0, sizeof(*opts));
+    opts->max_age = COAP_OPTION_MAX_AGE_DEFAULT;
+    opts->uri_port = COAP_OPTION_URI_PORT_NONE;
+    opts->observe = COAP_OBSERVE_NONE;
+    opts->accept = COAP_CT_NONE;
+    opts->block1 = COAP_OPTION_BLOCK_NONE;
+    opts->block2 = COAP_OPTION_BLOCK_NONE;
+}
+
+static void fill_block(uint8_t *buf, uint32_t offset, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        buf[i] = pattern(offset + i);
+    }
+}
+
+/* Takes the packet the handle sent, resuming a held transfer if there is none */
+static sn_coap_hdr_s *peer_receive()
+{
+    coap_version_e version;
+    sn_coap_hdr_s *msg;
+
+    if (!sent_len) {
+        if (!stream_held) {
+            return NULL;
+        }
+        /* Only the block the transfer was held for resumes it */
+        if (sn_coap_protocol_block_stream_resume(handle, &peer_addr, stream_held_msg_id + 1) == 0 ||
+                sn_coap_protocol_block_stream_resume(handle, &peer_addr, stream_held_msg_id) != 0) {
+            return NULL;
+        }
+        stream_held = false;
+        /* Only the one held packet */
+        if (sn_coap_protocol_block_stream_resume(handle, &peer_addr, stream_held_msg_id) == 0) {
+            return NULL;
+        }
+    }
+    msg = sn_coap_parser(peer, sent_len, sent_packet, &version);
+    sent_len = 0;
+    return msg;
+}
+
+static sn_coap_hdr_s *peer_send(sn_coap_hdr_s *msg)
+{
+    uint8_t packet[BLOCK_SIZE + 64];
+    int16_t len = sn_coap_builder(packet, msg);
+    if (len <= 0) {
+        return NULL;
+    }
+    return sn_coap_protocol_parse(handle, &peer_addr, len, packet, NULL);
+}
+
+static bool streams_idle()
+{
+    return ns_list_is_empty(&handle->linked_list_blockwise_streams) &&
+           ns_list_is_empty(&handle->linked_list_blockwise_received_payloads);
+}
+
+bool test_sn_coap_block_stream_download()
+{
+    static uint8_t token[] = { 0x5a, 0xa5 };
+    uint8_t packet[64];
+    uint8_t block[BLOCK_SIZE];
+    sn_coap_options_list_s opts;
+    sn_coap_hdr_s msg;
+    uint32_t rounds = 0;
+    size_t heap_start;
+    bool done = false;
+
+    sn_coap_parser_init_message(&msg);
+    msg.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    msg.msg_code = COAP_MSG_CODE_REQUEST_GET;
+    msg.msg_id = 0x100;
+    msg.token_ptr = token;
+    msg.token_len = sizeof(token);
+    msg.uri_path_ptr = (uint8_t *) "fw";
+    msg.uri_path_len = 2;
+    int16_t len = sn_coap_protocol_build(handle, &peer_addr, packet, &msg, NULL);
+    if (len <= 0) {
+        return false;
+    }
+    test_tx(packet, len, &peer_addr, NULL);
+    heap_start = heap_in_use;
+    heap_peak = heap_in_use;
+
+    while (!done) {
+        sn_coap_hdr_s *request = peer_receive();
+        if (!request || request->msg_code != COAP_MSG_CODE_REQUEST_GET ||
+                request->uri_path_len != 2 || memcmp(request->uri_path_ptr, "fw", 2) ||
+                request->token_len != sizeof(token) || memcmp(request->token_ptr, token, sizeof(token))) {
+            return false;
+        }
+
+        uint32_t number = 0;
+        if (request->options_list_ptr && request->options_list_ptr->block2 != COAP_OPTION_BLOCK_NONE) {
+            number = request->options_list_ptr->block2 >> 4;
+        }
+        uint32_t offset = number * BLOCK_SIZE;
+        bool more = offset + BLOCK_SIZE < TRANSFER_SIZE;
+        fill_block(block, offset, BLOCK_SIZE);
+
+        sn_coap_parser_init_message(&msg);
+        init_options(&opts);
+        opts.block2 = (number << 4) | (more ? 0x08 : 0) | BLOCK_SZX;
+        msg.options_list_ptr = &opts;
+        msg.msg_type = COAP_MSG_TYPE_ACKNOWLEDGEMENT;
+        msg.msg_code = COAP_MSG_CODE_RESPONSE_CONTENT;
+        msg.msg_id = request->msg_id;
+        msg.token_ptr = request->token_ptr;
+        msg.token_len = request->token_len;
+        msg.payload_ptr = block;
+        msg.payload_len = BLOCK_SIZE;
+
+        sn_coap_hdr_s *response = peer_send(&msg);
+        sn_coap_parser_release_allocated_coap_msg_mem(peer, request);
+        if (!response) {
+            return false;
+        }
+        if (response->coap_status == COAP_STATUS_PARSER_BLOCKWISE_MSG_STREAMED) {
+            done = true;
+        } else if (response->coap_status != COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING) {
+            return false;
+        }
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, response);
+        rounds++;
+    }
+
+    printf("\n1 MB download in %u blocks, %u packets sent, heap peak %u bytes over %u at start\n",
+           (unsigned) rounds, (unsigned) sent_count, (unsigned)(heap_peak - heap_start), (unsigned) heap_start);
+
+    return stream_errors == 0 && stream_bytes == TRANSFER_SIZE && stream_last == 1 &&
+           rounds == TRANSFER_SIZE / BLOCK_SIZE && sent_len == 0 &&
+           handle->count_resent_msgs == 0 && streams_idle() &&
+           heap_peak - heap_start < HEAP_LIMIT;
+}
+
+/* Sends the whole upload, returns the number of the block rejected or the
+ * transfer size in blocks when all were taken */
+static int32_t upload(uint32_t skip_block)
+{
+    static uint8_t token[] = { 0x77 };
+    uint8_t block[BLOCK_SIZE];
+    sn_coap_options_list_s opts;
+    sn_coap_hdr_s msg;
+    uint32_t number;
+
+    for (number = 0; number < TRANSFER_SIZE / BLOCK_SIZE; number++) {
+        if (number == skip_block) {
+            continue;
+        }
+        uint32_t offset = number * BLOCK_SIZE;
+        bool more = offset + BLOCK_SIZE < TRANSFER_SIZE;
+        fill_block(block, offset, BLOCK_SIZE);
+
+        sn_coap_parser_init_message(&msg);
+        init_options(&opts);
+        opts.block1 = (number << 4) | (more ? 0x08 : 0) | BLOCK_SZX;
+        opts.size1 = TRANSFER_SIZE;
+        opts.use_size1 = true;
+        msg.options_list_ptr = &opts;
+        msg.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+        msg.msg_code = COAP_MSG_CODE_REQUEST_PUT;
+        msg.msg_id = upload_msg_id++;
+        msg.token_ptr = token;
+        msg.token_len = sizeof(token);
+        msg.uri_path_ptr = (uint8_t *) "fw";
+        msg.uri_path_len = 2;
+        msg.payload_ptr = block;
+        msg.payload_len = BLOCK_SIZE;
+
+        sn_coap_hdr_s *request = peer_send(&msg);
+        if (!request) {
+            return -1;
+        }
+        sn_coap_status_e status = request->coap_status;
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, request);
+
+        if (status == COAP_STATUS_PARSER_BLOCKWISE_MSG_STREAMED) {
+            return more ? -1 : (int32_t)(number + 1);
+        }
+
+        sn_coap_hdr_s *ack = peer_receive();
+        if (!ack || ack->msg_type != COAP_MSG_TYPE_ACKNOWLEDGEMENT || ack->msg_id != msg.msg_id) {
+            sn_coap_parser_release_allocated_coap_msg_mem(peer, ack);
+            return -1;
+        }
+        bool accepted = ack->msg_code == COAP_MSG_CODE_RESPONSE_CONTINUE &&
+                        ack->options_list_ptr && ack->options_list_ptr->block1 == opts.block1;
+        sn_coap_parser_release_allocated_coap_msg_mem(peer, ack);
+
+        if (status == COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED && !accepted) {
+            return number;
+        }
+        if (status != COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING || !accepted) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+bool test_sn_coap_block_stream_upload()
+{
+    size_t heap_start = heap_in_use;
+    heap_peak = heap_in_use;
+
+    if (upload(UINT32_MAX) != TRANSFER_SIZE / BLOCK_SIZE) {
+        return false;
+    }
+
+    printf("\n1 MB upload, %u ACKs sent, heap peak %u bytes over %u at start\n",
+           (unsigned) sent_count, (unsigned)(heap_peak - heap_start), (unsigned) heap_start);
+
+    return stream_errors == 0 && stream_bytes == TRANSFER_SIZE && stream_last == 1 &&
+           sent_count == TRANSFER_SIZE / BLOCK_SIZE - 1 && streams_idle() &&
+           heap_peak - heap_start < HEAP_LIMIT;
+}
+
+bool test_sn_coap_block_stream_abort()
+{
+    /* Callback gives up at the 10th block */
+    stream_abort_at = 10;
+    if (upload(UINT32_MAX) != 9 || stream_blocks != 10 || !streams_idle()) {
+        return false;
+    }
+
+    /* A missing block ends the transfer without the callback seeing the next one */
+    stream_abort_at = 0;
+    stream_bytes = 0;
+    stream_blocks = 0;
+    if (upload(5) != 6 || stream_blocks != 5 || !streams_idle()) {
+        return false;
+    }
+
+    /* Nothing held, nothing to resume */
+    return sn_coap_protocol_block_stream_resume(handle, &peer_addr, upload_msg_id - 1) == -1 && stream_errors == 0;
+}
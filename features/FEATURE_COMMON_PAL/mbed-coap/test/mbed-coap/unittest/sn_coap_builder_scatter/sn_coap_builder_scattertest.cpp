@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2015-2017, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "test_sn_coap_builder_scatter.h"
+
+TEST_GROUP(sn_coap_builder_scatter)
+{
+    void setup()
+    {
+        CHECK(test_sn_coap_builder_scatter_setup());
+    }
+
+    void teardown()
+    {
+        test_sn_coap_builder_scatter_teardown();
+    }
+};
+
+TEST(sn_coap_builder_scatter, test_sn_coap_builder_scatter_same_bytes)
+{
+    CHECK(test_sn_coap_builder_scatter_same_bytes());
+}
+
+TEST(sn_coap_builder_scatter, test_sn_coap_builder_scatter_errors)
+{
+    CHECK(test_sn_coap_builder_scatter_errors());
+}
+
+TEST(sn_coap_builder_scatter, test_sn_coap_builder_scatter_resend)
+{
+    CHECK(test_sn_coap_builder_scatter_resend());
+}
+
+TEST(sn_coap_builder_scatter, test_sn_coap_builder_scatter_resend_copied)
+{
+    CHECK(test_sn_coap_builder_scatter_resend_copied());
+}
+
+TEST(sn_coap_builder_scatter, test_sn_coap_builder_scatter_bytes_copied)
+{
+    CHECK(test_sn_coap_builder_scatter_bytes_copied());
+}
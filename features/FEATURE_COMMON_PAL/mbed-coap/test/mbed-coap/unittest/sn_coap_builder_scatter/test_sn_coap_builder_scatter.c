@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2015-2017, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Checks that a message built as head and payload is the same packet as one
+ * built by sn_coap_builder(), that Confirmable messages whose payload was not
+ * copied are resent and reported as before, and compares the bytes written
+ * and stored per message by sn_coap_protocol_build() and
+ * sn_coap_protocol_build_scatter().
+ */
+#include "test_sn_coap_builder_scatter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ns_types.h"
+#include "mbed-coap/sn_coap_header.h"
+#include "mbed-coap/sn_coap_protocol.h"
+#include "sn_coap_protocol_internal.h"
+
+#define PAYLOAD_SIZE        1000
+#define HEAD_SIZE           64
+#define BENCH_MESSAGES      20000
+
+static struct coap_s *handle;
+
+static uint8_t addr_buf[16] = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+static sn_nsdl_addr_s addr;
+
+static uint8_t payload[PAYLOAD_SIZE];
+static uint8_t token[4] = { 1, 2, 3, 4 };
+static uint8_t uri_path[] = "sensors/temperature/0";
+static uint8_t query[] = "a=1&b=2";
+
+/* Packets seen by the callbacks, linearised */
+static uint8_t sent_packet[HEAD_SIZE + PAYLOAD_SIZE];
+static uint16_t sent_len;
+static uint32_t tx_count;
+static uint32_t tx_scatter_count;
+static uint32_t failed_count;
+static uint8_t failed_payload[PAYLOAD_SIZE];
+static bool failed_uri_path_ok;
+
+static void *test_malloc(uint16_t size)
+{
+    return malloc(size);
+}
+
+static void test_free(void *ptr)
+{
+    free(ptr);
+}
+
+static uint8_t test_tx(uint8_t *data_ptr, uint16_t data_len, sn_nsdl_addr_s *address_ptr, void *param)
+{
+    if (data_len <= sizeof(sent_packet)) {
+        memcpy(sent_packet, data_ptr, data_len);
+        sent_len = data_len;
+    }
+    tx_count++;
+    return 1;
+}
+
+static uint8_t test_tx_scatter(const sn_coap_iovec_s *iov, uint8_t iov_count, sn_nsdl_addr_s *address_ptr, void *param)
+{
+    sent_len = 0;
+    for (uint8_t i = 0; i < iov_count; i++) {
+        if (sent_len + iov[i].len <= sizeof(sent_packet)) {
+            memcpy(sent_packet + sent_len, iov[i].ptr, iov[i].len);
+        }
+        sent_len += iov[i].len;
+    }
+    tx_scatter_count++;
+    return 1;
+}
+
+static int8_t test_rx(sn_coap_hdr_s *msg, sn_nsdl_addr_s *address_ptr, void *param)
+{
+    if (msg->coap_status == COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED) {
+        failed_count++;
+        if (msg->payload_len == PAYLOAD_SIZE) {
+            memcpy(failed_payload, msg->payload_ptr, PAYLOAD_SIZE);
+        }
+        failed_uri_path_ok = msg->uri_path_len == sizeof(uri_path) - 1 &&
+                             memcmp(msg->uri_path_ptr, uri_path, msg->uri_path_len) == 0;
+    }
+    return 0;
+}
+
+static void init_message(sn_coap_hdr_s *msg, sn_coap_options_list_s *options, uint16_t payload_len)
+{
+    sn_coap_parser_init_message(msg);
+    msg->msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    msg->msg_code = COAP_MSG_CODE_REQUEST_PUT;
+    msg->msg_id = 0;
+    msg->token_ptr = token;
+    msg->token_len = sizeof(token);
+    msg->uri_path_ptr = uri_path;
+    msg->uri_path_len = sizeof(uri_path) - 1;
+    msg->content_format = COAP_CT_OCTET_STREAM;
+    msg->payload_ptr = payload_len ? payload : NULL;
+    msg->payload_len = payload_len;
+    if (options) {
+        memset(options, 0, sizeof(*options));
+        options->max_age = COAP_OPTION_MAX_AGE_DEFAULT;
+        options->uri_port = COAP_OPTION_URI_PORT_NONE;
+        options->observe = COAP_OBSERVE_NONE;
+        options->accept = COAP_CT_NONE;
+        options->block1 = COAP_OPTION_BLOCK_NONE;
+        options->block2 = COAP_OPTION_BLOCK_NONE;
+        options->uri_query_ptr = query;
+        options->uri_query_len = sizeof(query) - 1;
+        msg->options_list_ptr = options;
+    }
+}
+
+/* Acknowledges the message with the given ID, so it is dropped from the resend store */
+static void acknowledge(uint16_t msg_id)
+{
+    uint8_t ack[4] = { 0x60, 0x00, (uint8_t)(msg_id >> 8), (uint8_t)msg_id };
+    sn_coap_hdr_s *msg = sn_coap_protocol_parse(handle, &addr, sizeof(ack), ack, NULL);
+    if (msg) {
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+    }
+}
+
+/* Runs the resend timer until every stored message has been resent and failed */
+static void run_resends(void)
+{
+    for (uint32_t t = 1; t < 10000 && ns_list_count(&handle->linked_list_resent_msgs); t++) {
+        sn_coap_protocol_exec(handle, t);
+    }
+}
+
+bool test_sn_coap_builder_scatter_setup()
+{
+    for (uint16_t i = 0; i < PAYLOAD_SIZE; i++) {
+        payload[i] = (uint8_t)(i * 13 + 7);
+    }
+    addr.type = SN_NSDL_ADDRESS_TYPE_IPV6;
+    addr.addr_ptr = addr_buf;
+    addr.addr_len = sizeof(addr_buf);
+    addr.port = 5683;
+
+    sent_len = 0;
+    tx_count = 0;
+    tx_scatter_count = 0;
+    failed_count = 0;
+    memset(failed_payload, 0, sizeof(failed_payload));
+    failed_uri_path_ok = false;
+
+    handle = sn_coap_protocol_init(test_malloc, test_free, test_tx, test_rx);
+    return handle != NULL;
+}
+
+void test_sn_coap_builder_scatter_teardown()
+{
+    sn_coap_protocol_destroy(handle);
+    handle = NULL;
+}
+
+bool test_sn_coap_builder_scatter_same_bytes()
+{
+    static const uint16_t payload_lens[] = { 0, 1, 12, 13, 269, PAYLOAD_SIZE };
+    sn_coap_options_list_s options;
+    sn_coap_hdr_s msg;
+    uint8_t linear[HEAD_SIZE + PAYLOAD_SIZE];
+    uint8_t head[HEAD_SIZE];
+    sn_coap_iovec_s iov[SN_COAP_SCATTER_IOV_COUNT];
+
+    for (uint8_t with_options = 0; with_options < 2; with_options++) {
+        for (uint8_t i = 0; i < sizeof(payload_lens) / sizeof(payload_lens[0]); i++) {
+            init_message(&msg, with_options ? &options : NULL, payload_lens[i]);
+            msg.msg_id = 100 + i;
+
+            int16_t linear_len = sn_coap_builder(linear, &msg);
+            int16_t len = sn_coap_builder_scatter(head, sizeof(head), &msg, iov);
+            if (linear_len <= 0 || len != linear_len) {
+                return false;
+            }
+            if (iov[0].ptr != head || iov[1].len != payload_lens[i] ||
+                    iov[0].len + iov[1].len != len ||
+                    memcmp(linear, iov[0].ptr, iov[0].len) != 0) {
+                return false;
+            }
+            if (payload_lens[i] && (iov[1].ptr != payload ||
+                                    memcmp(linear + iov[0].len, iov[1].ptr, iov[1].len) != 0)) {
+                return false;
+            }
+            if (!payload_lens[i] && iov[1].ptr != NULL) {
+                return false;
+            }
+        }
+    }
+
+    /* Reset message is header only */
+    sn_coap_parser_init_message(&msg);
+    msg.msg_type = COAP_MSG_TYPE_RESET;
+    msg.msg_id = 7;
+    if (sn_coap_builder_scatter(head, sizeof(head), &msg, iov) != 4 || iov[0].len != 4 || iov[1].len != 0) {
+        return false;
+    }
+
+    /* Payload length without payload is left out, as sn_coap_builder() does */
+    init_message(&msg, NULL, 0);
+    msg.payload_len = 10;
+    int16_t linear_len = sn_coap_builder(linear, &msg);
+    if (sn_coap_builder_scatter(head, sizeof(head), &msg, iov) != linear_len || iov[1].len != 0 ||
+            memcmp(linear, head, linear_len) != 0) {
+        return false;
+    }
+    return true;
+}
+
+bool test_sn_coap_builder_scatter_errors()
+{
+    sn_coap_options_list_s options;
+    sn_coap_hdr_s msg;
+    uint8_t head[HEAD_SIZE];
+    sn_coap_iovec_s iov[SN_COAP_SCATTER_IOV_COUNT];
+
+    init_message(&msg, &options, PAYLOAD_SIZE);
+    if (sn_coap_builder_scatter(NULL, sizeof(head), &msg, iov) != -2 ||
+            sn_coap_builder_scatter(head, sizeof(head), NULL, iov) != -2 ||
+            sn_coap_builder_scatter(head, sizeof(head), &msg, NULL) != -2) {
+        return false;
+    }
+
+    /* Head does not fit, nothing is written past the given size */
+    memset(head, 0xaa, sizeof(head));
+    if (sn_coap_builder_scatter(head, 8, &msg, iov) != -3 || head[8] != 0xaa) {
+        return false;
+    }
+
+    msg.token_len = 9;
+    if (sn_coap_builder_scatter(head, sizeof(head), &msg, iov) != -1) {
+        return false;
+    }
+    msg.token_len = sizeof(token);
+
+    if (sn_coap_protocol_build_scatter(handle, &addr, head, sizeof(head), &msg, NULL, NULL) != -2 ||
+            sn_coap_protocol_build_scatter(NULL, &addr, head, sizeof(head), &msg, iov, NULL) != -2 ||
+            sn_coap_protocol_build_scatter(handle, &addr, head, 8, &msg, iov, NULL) != -3) {
+        return false;
+    }
+
+    /* Messages needing blockwise transfer are not scattered */
+    if (sn_coap_protocol_set_block_size(handle, 512) != 0 ||
+            sn_coap_protocol_build_scatter(handle, &addr, head, sizeof(head), &msg, iov, NULL) != -1) {
+        return false;
+    }
+    return ns_list_count(&handle->linked_list_resent_msgs) == 0;
+}
+
+bool test_sn_coap_builder_scatter_resend()
+{
+    sn_coap_options_list_s options;
+    sn_coap_hdr_s msg;
+    uint8_t head[HEAD_SIZE];
+    uint8_t first[HEAD_SIZE + PAYLOAD_SIZE];
+    sn_coap_iovec_s iov[SN_COAP_SCATTER_IOV_COUNT];
+
+    if (sn_coap_protocol_set_tx_scatter_callback(NULL, test_tx_scatter) != -1 ||
+            sn_coap_protocol_set_tx_scatter_callback(handle, test_tx_scatter) != 0) {
+        return false;
+    }
+
+    init_message(&msg, &options, PAYLOAD_SIZE);
+    int16_t len = sn_coap_protocol_build_scatter(handle, &addr, head, sizeof(head), &msg, iov, NULL);
+    if (len <= PAYLOAD_SIZE || iov[1].ptr != payload) {
+        return false;
+    }
+    memcpy(first, iov[0].ptr, iov[0].len);
+    memcpy(first + iov[0].len, iov[1].ptr, iov[1].len);
+
+    /* Only the head is stored, the payload is referenced */
+    coap_send_msg_s *stored = ns_list_get_first(&handle->linked_list_resent_msgs);
+    if (!stored || stored->send_msg_ptr->packet_len != iov[0].len || stored->payload_ptr != payload ||
+            handle->count_resent_bytes != iov[0].len) {
+        return false;
+    }
+
+    /* The head buffer may be reused as soon as the build returns */
+    memset(head, 0, sizeof(head));
+
+    run_resends();
+    if (tx_count != 0 || tx_scatter_count != handle->sn_coap_resending_count ||
+            sent_len != len || memcmp(sent_packet, first, len) != 0) {
+        return false;
+    }
+
+    /* Failure report carries the referenced payload */
+    if (failed_count != 1 || !failed_uri_path_ok || memcmp(failed_payload, payload, PAYLOAD_SIZE) != 0 ||
+            handle->count_resent_bytes != 0) {
+        return false;
+    }
+
+    /* Acknowledged message is not resent */
+    init_message(&msg, &options, PAYLOAD_SIZE);
+    tx_scatter_count = 0;
+    if (sn_coap_protocol_build_scatter(handle, &addr, head, sizeof(head), &msg, iov, NULL) != len) {
+        return false;
+    }
+    acknowledge(msg.msg_id);
+    run_resends();
+    return tx_scatter_count == 0 && handle->count_resent_msgs == 0 && handle->count_resent_bytes == 0;
+}
+
+bool test_sn_coap_builder_scatter_resend_copied()
+{
+    sn_coap_options_list_s options;
+    sn_coap_hdr_s msg;
+    uint8_t head[HEAD_SIZE];
+    uint8_t first[HEAD_SIZE + PAYLOAD_SIZE];
+    sn_coap_iovec_s iov[SN_COAP_SCATTER_IOV_COUNT];
+
+    /* Without a scatter callback the payload is copied and may change after the build */
+    init_message(&msg, &options, PAYLOAD_SIZE);
+    int16_t len = sn_coap_protocol_build_scatter(handle, &addr, head, sizeof(head), &msg, iov, NULL);
+    if (len <= PAYLOAD_SIZE) {
+        return false;
+    }
+    memcpy(first, iov[0].ptr, iov[0].len);
+    memcpy(first + iov[0].len, iov[1].ptr, iov[1].len);
+
+    coap_send_msg_s *stored = ns_list_get_first(&handle->linked_list_resent_msgs);
+    if (!stored || stored->payload_ptr != NULL || stored->send_msg_ptr->packet_len != len ||
+            handle->count_resent_bytes != (uint32_t)len) {
+        return false;
+    }
+
+    payload[0] ^= 0xff;
+    run_resends();
+    payload[0] ^= 0xff;
+
+    return tx_scatter_count == 0 && tx_count == handle->sn_coap_resending_count &&
+           sent_len == len && memcmp(sent_packet, first, len) == 0 &&
+           failed_count == 1 && failed_uri_path_ok && memcmp(failed_payload, payload, PAYLOAD_SIZE) == 0;
+}
+
+static double seconds(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+bool test_sn_coap_builder_scatter_bytes_copied()
+{
+    sn_coap_options_list_s options;
+    sn_coap_hdr_s msg;
+    uint8_t packet[HEAD_SIZE + PAYLOAD_SIZE];
+    uint8_t head[HEAD_SIZE];
+    sn_coap_iovec_s iov[SN_COAP_SCATTER_IOV_COUNT];
+    uint32_t build_written = 0, build_stored = 0;
+    uint32_t scatter_written = 0, scatter_stored = 0;
+    clock_t start;
+    double build_time, scatter_time;
+
+    sn_coap_protocol_set_tx_scatter_callback(handle, test_tx_scatter);
+
+    /* Build, store for resending and acknowledge, as a busy sender does */
+    start = clock();
+    for (uint32_t i = 0; i < BENCH_MESSAGES; i++) {
+        init_message(&msg, &options, PAYLOAD_SIZE);
+        int16_t len = sn_coap_protocol_build(handle, &addr, packet, &msg, NULL);
+        if (len <= PAYLOAD_SIZE) {
+            return false;
+        }
+        build_written += len;
+        build_stored += handle->count_resent_bytes;
+        acknowledge(msg.msg_id);
+    }
+    build_time = seconds(start);
+
+    start = clock();
+    for (uint32_t i = 0; i < BENCH_MESSAGES; i++) {
+        init_message(&msg, &options, PAYLOAD_SIZE);
+        int16_t len = sn_coap_protocol_build_scatter(handle, &addr, head, sizeof(head), &msg, iov, NULL);
+        if (len <= PAYLOAD_SIZE) {
+            return false;
+        }
+        scatter_written += iov[0].len;
+        scatter_stored += handle->count_resent_bytes;
+        acknowledge(msg.msg_id);
+    }
+    scatter_time = seconds(start);
+
+    printf("\nsn_coap_protocol_build:         %5u bytes written, %5u stored, %9.0f messages/s\n",
+           (unsigned)(build_written / BENCH_MESSAGES), (unsigned)(build_stored / BENCH_MESSAGES),
+           BENCH_MESSAGES / build_time);
+    printf("sn_coap_protocol_build_scatter: %5u bytes written, %5u stored, %9.0f messages/s\n",
+           (unsigned)(scatter_written / BENCH_MESSAGES), (unsigned)(scatter_stored / BENCH_MESSAGES),
+           BENCH_MESSAGES / scatter_time);
+
+    /* The payload is neither written nor stored */
+    return build_written - scatter_written == (uint32_t)BENCH_MESSAGES * PAYLOAD_SIZE &&
+           build_stored == build_written && scatter_stored == scatter_written &&
+           handle->count_resent_msgs == 0;
+}
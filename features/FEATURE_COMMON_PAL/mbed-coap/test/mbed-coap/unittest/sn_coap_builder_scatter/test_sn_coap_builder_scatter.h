@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2015-2017, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEST_SN_COAP_BUILDER_SCATTER_H
+#define TEST_SN_COAP_BUILDER_SCATTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+
+bool test_sn_coap_builder_scatter_setup();
+void test_sn_coap_builder_scatter_teardown();
+bool test_sn_coap_builder_scatter_same_bytes();
+bool test_sn_coap_builder_scatter_errors();
+bool test_sn_coap_builder_scatter_resend();
+bool test_sn_coap_builder_scatter_resend_copied();
+bool test_sn_coap_builder_scatter_bytes_copied();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEST_SN_COAP_BUILDER_SCATTER_H
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2015-2017, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "test_sn_coap_parser_bench.h"
+
+TEST_GROUP(sn_coap_parser_bench)
+{
+    void setup()
+    {
+        CHECK(test_sn_coap_parser_bench_setup());
+    }
+
+    void teardown()
+    {
+        test_sn_coap_parser_bench_teardown();
+    }
+};
+
+TEST(sn_coap_parser_bench, test_sn_coap_parser_into_matches_heap)
+{
+    CHECK(test_sn_coap_parser_into_matches_heap());
+}
+
+TEST(sn_coap_parser_bench, test_sn_coap_parser_into_arena_size)
+{
+    CHECK(test_sn_coap_parser_into_arena_size());
+}
+
+TEST(sn_coap_parser_bench, test_sn_coap_protocol_parse_into)
+{
+    CHECK(test_sn_coap_protocol_parse_into());
+}
+
+TEST(sn_coap_parser_bench, test_sn_coap_parser_throughput)
+{
+    CHECK(test_sn_coap_parser_throughput());
+}
+
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2015-2017, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Parses a set of LwM2M-like messages with sn_coap_parser() and with
+ * sn_coap_parser_into(), checks that both give the same message, and
+ * prints packets per second and heap allocations per packet of each.
+ */
+#include "test_sn_coap_parser_bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ns_types.h"
+#include "mbed-coap/sn_coap_header.h"
+#include "mbed-coap/sn_coap_protocol.h"
+#include "sn_coap_protocol_internal.h"
+
+#ifndef PARSER_BENCH_ROUNDS
+#define PARSER_BENCH_ROUNDS 20000
+#endif
+
+#define PACKET_COUNT        5
+#define PACKET_MAX_LEN      256
+#define ARENA_SIZE          SN_COAP_PARSER_ARENA_SIZE(PACKET_MAX_LEN)
+
+static struct coap_s *handle;
+static uint32_t malloc_count;
+static uint32_t free_count;
+
+static uint8_t packets[PACKET_COUNT][PACKET_MAX_LEN];
+static uint16_t packet_lens[PACKET_COUNT];
+static uint8_t arena_buf[ARENA_SIZE];
+
+static void *test_malloc(uint16_t size)
+{
+    malloc_count++;
+    return malloc(size);
+}
+
+static void test_free(void *ptr)
+{
+    if (ptr) {
+        free_count++;
+    }
+    free(ptr);
+}
+
+static uint8_t test_tx(uint8_t *data_ptr, uint16_t data_len, sn_nsdl_addr_s *address_ptr, void *param)
+{
+    return 0;
+}
+
+static bool build_packet(int index, sn_coap_hdr_s *msg)
+{
+    uint16_t len = sn_coap_builder_calc_needed_packet_data_size(msg);
+    int16_t built;
+
+    if (len == 0 || len > PACKET_MAX_LEN) {
+        return false;
+    }
+
+    built = sn_coap_builder(packets[index], msg);
+    if (built <= 0) {
+        return false;
+    }
+
+    packet_lens[index] = built;
+    return true;
+}
+
+bool test_sn_coap_parser_bench_setup()
+{
+    sn_coap_hdr_s msg;
+    sn_coap_options_list_s opts;
+    uint8_t token4[] = { 0x12, 0x34, 0x56, 0x78 };
+    uint8_t token8[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint8_t etag[] = { 0xe1, 0xe2, 0xe3 };
+    uint8_t links[] = "</1/0>,</3/0>,</5/0>";
+    uint8_t tlv[24];
+
+    memset(tlv, 0xa5, sizeof(tlv));
+    malloc_count = 0;
+    free_count = 0;
+    handle = sn_coap_protocol_init(test_malloc, test_free, test_tx, NULL);
+    if (!handle) {
+        return false;
+    }
+
+    /* Read of a resource */
+    sn_coap_parser_init_message(&msg);
+    msg.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    msg.msg_code = COAP_MSG_CODE_REQUEST_GET;
+    msg.msg_id = 0x1001;
+    msg.token_ptr = token4;
+    msg.token_len = sizeof(token4);
+    msg.uri_path_ptr = (uint8_t *) "3/0/0";
+    msg.uri_path_len = 5;
+    if (!build_packet(0, &msg)) {
+        return false;
+    }
+
+    /* Registration */
+    sn_coap_parser_init_message(&msg);
+    memset(&opts, 0, sizeof(opts));
+    opts.max_age = COAP_OPTION_MAX_AGE_DEFAULT;
+    opts.uri_port = COAP_OPTION_URI_PORT_NONE;
+    opts.observe = COAP_OBSERVE_NONE;
+    opts.accept = COAP_CT_NONE;
+    opts.block1 = COAP_OPTION_BLOCK_NONE;
+    opts.block2 = COAP_OPTION_BLOCK_NONE;
+    opts.uri_query_ptr = (uint8_t *) "ep=node-01&lt=3600&b=U";
+    opts.uri_query_len = 22;
+    msg.options_list_ptr = &opts;
+    msg.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    msg.msg_code = COAP_MSG_CODE_REQUEST_POST;
+    msg.msg_id = 0x1002;
+    msg.token_ptr = token8;
+    msg.token_len = sizeof(token8);
+    msg.uri_path_ptr = (uint8_t *) "rd";
+    msg.uri_path_len = 2;
+    msg.content_format = COAP_CT_LINK_FORMAT;
+    msg.payload_ptr = links;
+    msg.payload_len = sizeof(links) - 1;
+    if (!build_packet(1, &msg)) {
+        return false;
+    }
+
+    /* Notification */
+    sn_coap_parser_init_message(&msg);
+    opts.uri_query_ptr = NULL;
+    opts.uri_query_len = 0;
+    opts.observe = 12;
+    msg.options_list_ptr = &opts;
+    msg.msg_type = COAP_MSG_TYPE_NON_CONFIRMABLE;
+    msg.msg_code = COAP_MSG_CODE_RESPONSE_CONTENT;
+    msg.msg_id = 0x1003;
+    msg.token_ptr = token8;
+    msg.token_len = sizeof(token8);
+    msg.content_format = (sn_coap_content_format_e) 11542;
+    msg.payload_ptr = tlv;
+    msg.payload_len = sizeof(tlv);
+    if (!build_packet(2, &msg)) {
+        return false;
+    }
+
+    /* Request through a proxy, with single part options */
+    sn_coap_parser_init_message(&msg);
+    opts.observe = COAP_OBSERVE_NONE;
+    opts.uri_host_ptr = (uint8_t *) "lwm2m.example.org";
+    opts.uri_host_len = 17;
+    opts.proxy_uri_ptr = (uint8_t *) "coap://device.local/5/0/1";
+    opts.proxy_uri_len = 25;
+    opts.etag_ptr = etag;
+    opts.etag_len = sizeof(etag);
+    opts.accept = COAP_CT_TEXT_PLAIN;
+    msg.options_list_ptr = &opts;
+    msg.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    msg.msg_code = COAP_MSG_CODE_REQUEST_PUT;
+    msg.msg_id = 0x1004;
+    msg.token_ptr = token4;
+    msg.token_len = sizeof(token4);
+    msg.uri_path_ptr = (uint8_t *) "5";
+    msg.uri_path_len = 1;
+    msg.payload_ptr = links;
+    msg.payload_len = 4;
+    if (!build_packet(3, &msg)) {
+        return false;
+    }
+
+    /* Registration response */
+    sn_coap_parser_init_message(&msg);
+    memset(&opts, 0, sizeof(opts));
+    opts.max_age = COAP_OPTION_MAX_AGE_DEFAULT;
+    opts.uri_port = COAP_OPTION_URI_PORT_NONE;
+    opts.observe = COAP_OBSERVE_NONE;
+    opts.accept = COAP_CT_NONE;
+    opts.block1 = COAP_OPTION_BLOCK_NONE;
+    opts.block2 = COAP_OPTION_BLOCK_NONE;
+    opts.location_path_ptr = (uint8_t *) "rd/5a3f";
+    opts.location_path_len = 7;
+    msg.options_list_ptr = &opts;
+    msg.msg_type = COAP_MSG_TYPE_ACKNOWLEDGEMENT;
+    msg.msg_code = COAP_MSG_CODE_RESPONSE_CREATED;
+    msg.msg_id = 0x1002;
+    msg.token_ptr = token8;
+    msg.token_len = sizeof(token8);
+    if (!build_packet(4, &msg)) {
+        return false;
+    }
+
+    return true;
+}
+
+void test_sn_coap_parser_bench_teardown()
+{
+    sn_coap_protocol_destroy(handle);
+    handle = NULL;
+}
+
+static bool same_bytes(const uint8_t *a, uint16_t a_len, const uint8_t *b, uint16_t b_len)
+{
+    if (a_len != b_len || (a == NULL) != (b == NULL)) {
+        return false;
+    }
+    return a_len == 0 || memcmp(a, b, a_len) == 0;
+}
+
+static bool same_message(const sn_coap_hdr_s *a, const sn_coap_hdr_s *b)
+{
+    const sn_coap_options_list_s *ao = a->options_list_ptr;
+    const sn_coap_options_list_s *bo = b->options_list_ptr;
+
+    if (a->coap_status != b->coap_status || a->msg_code != b->msg_code ||
+            a->msg_type != b->msg_type || a->content_format != b->content_format ||
+            a->msg_id != b->msg_id ||
+            !same_bytes(a->token_ptr, a->token_len, b->token_ptr, b->token_len) ||
+            !same_bytes(a->uri_path_ptr, a->uri_path_len, b->uri_path_ptr, b->uri_path_len) ||
+            !same_bytes(a->payload_ptr, a->payload_len, b->payload_ptr, b->payload_len)) {
+        return false;
+    }
+
+    if ((ao == NULL) != (bo == NULL)) {
+        return false;
+    }
+    if (ao == NULL) {
+        return true;
+    }
+
+    return ao->max_age == bo->max_age && ao->uri_port == bo->uri_port &&
+           ao->observe == bo->observe && ao->accept == bo->accept &&
+           ao->block1 == bo->block1 && ao->block2 == bo->block2 &&
+           ao->use_size1 == bo->use_size1 && ao->size1 == bo->size1 &&
+           ao->use_size2 == bo->use_size2 && ao->size2 == bo->size2 &&
+           same_bytes(ao->proxy_uri_ptr, ao->proxy_uri_len, bo->proxy_uri_ptr, bo->proxy_uri_len) &&
+           same_bytes(ao->etag_ptr, ao->etag_len, bo->etag_ptr, bo->etag_len) &&
+           same_bytes(ao->uri_host_ptr, ao->uri_host_len, bo->uri_host_ptr, bo->uri_host_len) &&
+           same_bytes(ao->location_path_ptr, ao->location_path_len, bo->location_path_ptr, bo->location_path_len) &&
+           same_bytes(ao->location_query_ptr, ao->location_query_len, bo->location_query_ptr, bo->location_query_len) &&
+           same_bytes(ao->uri_query_ptr, ao->uri_query_len, bo->uri_query_ptr, bo->uri_query_len);
+}
+
+bool test_sn_coap_parser_into_matches_heap()
+{
+    sn_coap_arena_s arena;
+    coap_version_e version;
+
+    if (sn_coap_parser_into(handle, NULL, packet_lens[0], packets[0], &version) != NULL) {
+        return false;
+    }
+
+    for (int i = 0; i < PACKET_COUNT; i++) {
+        sn_coap_hdr_s *heap_msg = sn_coap_parser(handle, packet_lens[i], packets[i], &version);
+        if (heap_msg == NULL || heap_msg->arena) {
+            return false;
+        }
+
+        uint32_t mallocs = malloc_count;
+        sn_coap_arena_init(&arena, arena_buf, sizeof(arena_buf));
+        sn_coap_hdr_s *arena_msg = sn_coap_parser_into(handle, &arena, packet_lens[i], packets[i], &version);
+        if (arena_msg == NULL || !arena_msg->arena || malloc_count != mallocs) {
+            return false;
+        }
+
+        if (arena_msg->coap_status != COAP_STATUS_OK || !same_message(heap_msg, arena_msg)) {
+            return false;
+        }
+
+        /* Releasing an arena message frees nothing */
+        uint32_t frees = free_count;
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, arena_msg);
+        if (free_count != frees) {
+            return false;
+        }
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, heap_msg);
+    }
+
+    return malloc_count == free_count + 1;  /* the handle */
+}
+
+bool test_sn_coap_parser_into_arena_size()
+{
+    static uint8_t small_buf[sizeof(sn_coap_hdr_s) + 8];
+    sn_coap_arena_s arena;
+    coap_version_e version;
+
+    /* Every message fits in the documented size, however many are parsed */
+    for (int i = 0; i < PACKET_COUNT; i++) {
+        sn_coap_arena_init(&arena, arena_buf, SN_COAP_PARSER_ARENA_SIZE(packet_lens[i]));
+        if (sn_coap_parser_into(handle, &arena, packet_lens[i], packets[i], &version) == NULL) {
+            return false;
+        }
+        if (arena.used > arena.size) {
+            return false;
+        }
+    }
+
+    /* The options list of the registration does not fit */
+    uint32_t mallocs = malloc_count;
+    sn_coap_arena_init(&arena, small_buf, sizeof(small_buf));
+    sn_coap_hdr_s *msg = sn_coap_parser_into(handle, &arena, packet_lens[1], packets[1], &version);
+    if (msg == NULL || msg->coap_status != COAP_STATUS_PARSER_ERROR_IN_HEADER || malloc_count != mallocs) {
+        return false;
+    }
+
+    /* Nor does the message */
+    sn_coap_arena_init(&arena, small_buf, sizeof(sn_coap_hdr_s) - 1);
+    if (sn_coap_parser_into(handle, &arena, packet_lens[0], packets[0], &version) != NULL) {
+        return false;
+    }
+
+    return true;
+}
+
+bool test_sn_coap_protocol_parse_into()
+{
+    uint8_t address[16] = { 0xfe, 0x80 };
+    sn_nsdl_addr_s src;
+    sn_coap_arena_s arena;
+
+    src.addr_ptr = address;
+    src.addr_len = sizeof(address);
+    src.type = SN_NSDL_ADDRESS_TYPE_IPV6;
+    src.port = 5683;
+
+    if (sn_coap_protocol_parse_into(handle, NULL, &src, packet_lens[0], packets[0], NULL) != NULL) {
+        return false;
+    }
+
+    for (int i = 0; i < PACKET_COUNT; i++) {
+        uint32_t mallocs = malloc_count;
+        uint32_t frees = free_count;
+
+        sn_coap_arena_init(&arena, arena_buf, sizeof(arena_buf));
+        sn_coap_hdr_s *msg = sn_coap_protocol_parse_into(handle, &arena, &src, packet_lens[i], packets[i], NULL);
+        if (msg == NULL || msg->coap_status != COAP_STATUS_OK) {
+            return false;
+        }
+        if ((uint8_t *) msg < arena_buf || (uint8_t *) msg >= arena_buf + sizeof(arena_buf)) {
+            return false;
+        }
+
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+
+        /* No duplicate detection or blockwise in this build, so nothing
+         * else allocates either */
+        if (malloc_count != mallocs || free_count != frees) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static double seconds(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+bool test_sn_coap_parser_throughput()
+{
+    sn_coap_arena_s arena;
+    coap_version_e version;
+    uint32_t mallocs;
+    clock_t start;
+    double heap_s, arena_s;
+    double heap_allocs, arena_allocs;
+    const double packets_parsed = (double) PARSER_BENCH_ROUNDS * PACKET_COUNT;
+
+    mallocs = malloc_count;
+    start = clock();
+    for (int round = 0; round < PARSER_BENCH_ROUNDS; round++) {
+        for (int i = 0; i < PACKET_COUNT; i++) {
+            sn_coap_hdr_s *msg = sn_coap_parser(handle, packet_lens[i], packets[i], &version);
+            if (msg == NULL) {
+                return false;
+            }
+            sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+        }
+    }
+    heap_s = seconds(start);
+    heap_allocs = (malloc_count - mallocs) / packets_parsed;
+
+    mallocs = malloc_count;
+    start = clock();
+    for (int round = 0; round < PARSER_BENCH_ROUNDS; round++) {
+        for (int i = 0; i < PACKET_COUNT; i++) {
+            sn_coap_arena_init(&arena, arena_buf, sizeof(arena_buf));
+            sn_coap_hdr_s *msg = sn_coap_parser_into(handle, &arena, packet_lens[i], packets[i], &version);
+            if (msg == NULL) {
+                return false;
+            }
+            sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+        }
+    }
+    arena_s = seconds(start);
+    arena_allocs = (malloc_count - mallocs) / packets_parsed;
+
+    printf("\nsn_coap_parser:      %9.0f packets/s, %.2f allocations per packet\n",
+           heap_s > 0 ? packets_parsed / heap_s : 0, heap_allocs);
+    printf("sn_coap_parser_into: %9.0f packets/s, %.2f allocations per packet\n",
+           arena_s > 0 ? packets_parsed / arena_s : 0, arena_allocs);
+
+    return arena_allocs == 0 && heap_allocs >= 2;
+}
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2015-2017, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Keeps 1000 confirmable messages outstanding towards a few peers and checks
+ * acknowledgement, resending and duplicate detection against them, then
+ * prints the cost of an idle sn_coap_protocol_exec() and of an ACK lookup.
+ */
+#include "test_sn_coap_protocol_lookup.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ns_types.h"
+#include "mbed-coap/sn_coap_header.h"
+#include "mbed-coap/sn_coap_protocol.h"
+#include "sn_coap_protocol_internal.h"
+
+#define MESSAGE_COUNT       1000
+#define PEER_COUNT          4
+#define FIRST_MSG_ID        0x4000
+#define EXEC_ROUNDS         100000
+
+static struct coap_s *handle;
+static uint32_t malloc_count;
+static uint32_t free_count;
+static uint32_t tx_count;
+static uint32_t failed_count;
+
+static uint8_t peer_addr[PEER_COUNT][16];
+static sn_nsdl_addr_s peers[PEER_COUNT];
+
+static void *test_malloc(uint16_t size)
+{
+    malloc_count++;
+    return malloc(size);
+}
+
+static void test_free(void *ptr)
+{
+    if (ptr) {
+        free_count++;
+    }
+    free(ptr);
+}
+
+static uint8_t test_tx(uint8_t *data_ptr, uint16_t data_len, sn_nsdl_addr_s *address_ptr, void *param)
+{
+    tx_count++;
+    return 1;
+}
+
+static int8_t test_rx(sn_coap_hdr_s *msg, sn_nsdl_addr_s *address_ptr, void *param)
+{
+    if (msg->coap_status == COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED) {
+        failed_count++;
+    }
+    return 0;
+}
+
+static double seconds(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+bool test_sn_coap_protocol_lookup_setup()
+{
+    malloc_count = 0;
+    free_count = 0;
+    tx_count = 0;
+    failed_count = 0;
+
+    for (int i = 0; i < PEER_COUNT; i++) {
+        memset(peer_addr[i], 0, sizeof(peer_addr[i]));
+        peer_addr[i][0] = 0xfd;
+        peer_addr[i][15] = i + 1;
+        peers[i].addr_ptr = peer_addr[i];
+        peers[i].addr_len = sizeof(peer_addr[i]);
+        peers[i].port = 5683 + i;
+        peers[i].type = SN_NSDL_ADDRESS_TYPE_IPV6;
+    }
+
+    handle = sn_coap_protocol_init(test_malloc, test_free, test_tx, test_rx);
+    if (!handle) {
+        return false;
+    }
+
+    /* The Makefile configures queues of MESSAGE_COUNT messages */
+    return handle->sn_coap_resending_queue_msgs == MESSAGE_COUNT &&
+           handle->sn_coap_duplication_buffer_size == MESSAGE_COUNT;
+}
+
+void test_sn_coap_protocol_lookup_teardown()
+{
+    sn_coap_protocol_destroy(handle);
+    handle = NULL;
+}
+
+static bool send_con(uint16_t msg_id)
+{
+    sn_coap_hdr_s msg;
+    uint8_t packet[32];
+
+    sn_coap_parser_init_message(&msg);
+    msg.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    msg.msg_code = COAP_MSG_CODE_REQUEST_GET;
+    msg.msg_id = msg_id;
+    msg.uri_path_ptr = (uint8_t *) "1/0/0";
+    msg.uri_path_len = 5;
+
+    return sn_coap_protocol_build(handle, &peers[msg_id % PEER_COUNT], packet, &msg, NULL) > 0;
+}
+
+static sn_coap_hdr_s *receive(uint8_t type, uint16_t msg_id, sn_nsdl_addr_s *addr_ptr)
+{
+    uint8_t packet[4];
+
+    packet[0] = COAP_VERSION_1 | type;
+    packet[1] = type == COAP_MSG_TYPE_CONFIRMABLE ? COAP_MSG_CODE_REQUEST_GET : COAP_MSG_CODE_EMPTY;
+    packet[2] = msg_id >> 8;
+    packet[3] = (uint8_t) msg_id;
+
+    return sn_coap_protocol_parse(handle, addr_ptr, sizeof(packet), packet, NULL);
+}
+
+static bool receive_ack(uint16_t msg_id, sn_nsdl_addr_s *addr_ptr)
+{
+    sn_coap_hdr_s *msg = receive(COAP_MSG_TYPE_ACKNOWLEDGEMENT, msg_id, addr_ptr);
+    if (msg == NULL) {
+        return false;
+    }
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+    return true;
+}
+
+static bool resend_list_sorted()
+{
+    uint32_t previous = 0;
+    uint16_t count = 0;
+
+    ns_list_foreach(coap_send_msg_s, msg, &handle->linked_list_resent_msgs) {
+        if (msg->resending_time < previous) {
+            return false;
+        }
+        previous = msg->resending_time;
+        count++;
+    }
+    return count == handle->count_resent_msgs;
+}
+
+bool test_sn_coap_protocol_resend_many()
+{
+    for (uint16_t i = 0; i < MESSAGE_COUNT; i++) {
+        if (!send_con(FIRST_MSG_ID + i)) {
+            return false;
+        }
+    }
+    if (handle->count_resent_msgs != MESSAGE_COUNT || send_con(FIRST_MSG_ID + MESSAGE_COUNT)) {
+        return false;
+    }
+
+    /* An ACK from the wrong port removes nothing */
+    sn_nsdl_addr_s wrong_port = peers[0];
+    wrong_port.port++;
+    if (!receive_ack(FIRST_MSG_ID, &wrong_port) || handle->count_resent_msgs != MESSAGE_COUNT) {
+        return false;
+    }
+
+    /* Acknowledge every other message */
+    for (uint16_t i = 0; i < MESSAGE_COUNT; i += 2) {
+        uint16_t msg_id = FIRST_MSG_ID + i;
+        if (!receive_ack(msg_id, &peers[msg_id % PEER_COUNT])) {
+            return false;
+        }
+    }
+    if (handle->count_resent_msgs != MESSAGE_COUNT / 2 || !resend_list_sorted()) {
+        return false;
+    }
+
+    /* The rest are resent three times, then reported as failed */
+    for (uint32_t now = 0; now < 200; now++) {
+        sn_coap_protocol_exec(handle, now);
+        if (!resend_list_sorted()) {
+            return false;
+        }
+    }
+    if (tx_count != 3 * MESSAGE_COUNT / 2 || failed_count != MESSAGE_COUNT / 2 ||
+            handle->count_resent_msgs != 0 || handle->count_resent_bytes != 0) {
+        return false;
+    }
+
+    /* Only the handle is left */
+    return malloc_count == free_count + 1;
+}
+
+bool test_sn_coap_protocol_resend_order()
+{
+    /* Store messages out of resending time order */
+    for (uint16_t i = 0; i < 100; i++) {
+        handle->system_time = (i * 37) % 100;
+        if (!send_con(FIRST_MSG_ID + i)) {
+            return false;
+        }
+    }
+    if (!resend_list_sorted()) {
+        return false;
+    }
+
+    /* The first resending of each is at its store time + 10, one per second,
+     * and the second 20 seconds after that */
+    for (uint32_t now = 10; now < 30; now++) {
+        uint32_t sent = tx_count;
+        sn_coap_protocol_exec(handle, now);
+        if (tx_count - sent != 1 || !resend_list_sorted()) {
+            return false;
+        }
+    }
+
+    sn_coap_protocol_clear_retransmission_buffer(handle);
+    return handle->count_resent_msgs == 0 && handle->count_resent_bytes == 0 &&
+           ns_list_is_empty(&handle->linked_list_resent_msgs);
+}
+
+bool test_sn_coap_protocol_duplicates_many()
+{
+    for (uint16_t i = 0; i < MESSAGE_COUNT; i++) {
+        uint16_t msg_id = FIRST_MSG_ID + i;
+        sn_coap_hdr_s *msg = receive(COAP_MSG_TYPE_CONFIRMABLE, msg_id, &peers[msg_id % PEER_COUNT]);
+        if (msg == NULL || msg->coap_status == COAP_STATUS_PARSER_DUPLICATED_MSG) {
+            return false;
+        }
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+    }
+    if (handle->count_duplication_msgs != MESSAGE_COUNT) {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < MESSAGE_COUNT; i++) {
+        uint16_t msg_id = FIRST_MSG_ID + i;
+        sn_coap_hdr_s *msg = receive(COAP_MSG_TYPE_CONFIRMABLE, msg_id, &peers[msg_id % PEER_COUNT]);
+        bool duplicate = msg && msg->coap_status == COAP_STATUS_PARSER_DUPLICATED_MSG;
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+        if (!duplicate) {
+            return false;
+        }
+    }
+
+    /* Same message ID from another peer is not a duplicate, and evicts the oldest */
+    sn_coap_hdr_s *msg = receive(COAP_MSG_TYPE_CONFIRMABLE, FIRST_MSG_ID, &peers[1]);
+    bool duplicate = msg && msg->coap_status == COAP_STATUS_PARSER_DUPLICATED_MSG;
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+    if (duplicate || handle->count_duplication_msgs != MESSAGE_COUNT) {
+        return false;
+    }
+    msg = receive(COAP_MSG_TYPE_CONFIRMABLE, FIRST_MSG_ID, &peers[0]);
+    duplicate = msg && msg->coap_status == COAP_STATUS_PARSER_DUPLICATED_MSG;
+    sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+    if (duplicate) {
+        return false;
+    }
+
+    /* All expire together */
+    sn_coap_protocol_exec(handle, SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED + 1);
+    return handle->count_duplication_msgs == 0 && malloc_count == free_count + 1;
+}
+
+bool test_sn_coap_protocol_lookup_timing()
+{
+    clock_t start;
+    double exec_s, ack_s;
+
+    for (uint16_t i = 0; i < MESSAGE_COUNT; i++) {
+        if (!send_con(FIRST_MSG_ID + i)) {
+            return false;
+        }
+    }
+
+    /* Nothing is due before the first resending time */
+    start = clock();
+    for (uint32_t i = 0; i < EXEC_ROUNDS; i++) {
+        sn_coap_protocol_exec(handle, 5);
+    }
+    exec_s = seconds(start);
+    if (tx_count != 0) {
+        return false;
+    }
+
+    /* Acknowledge in reverse order, the worst case of the plain list */
+    start = clock();
+    for (uint16_t i = MESSAGE_COUNT; i > 0; i--) {
+        uint16_t msg_id = FIRST_MSG_ID + i - 1;
+        if (!receive_ack(msg_id, &peers[msg_id % PEER_COUNT])) {
+            return false;
+        }
+    }
+    ack_s = seconds(start);
+
+    printf("\n%d outstanding: idle sn_coap_protocol_exec %.0f ns, ACK %.0f ns\n", MESSAGE_COUNT,
+           exec_s * 1e9 / EXEC_ROUNDS, ack_s * 1e9 / MESSAGE_COUNT);
+
+    return handle->count_resent_msgs == 0;
+}
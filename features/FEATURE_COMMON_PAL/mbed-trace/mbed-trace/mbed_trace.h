@@ -227,6 +227,19 @@ uint8_t mbed_trace_config_get(void);
  *   mbed_trace_prefix_function_set( &trace_time );
  */
 void mbed_trace_prefix_function_set( char* (*pref_f)(size_t) );
+/**
+ * Set trace prefix function with timestamp
+ * Like mbed_trace_prefix_function_set(), but the function also gets the value of the
+ * timestamp function set with mbed_trace_binary_time_function_set(). In deferred mode
+ * the value is read when trace is stored, so the prefix has the time of the trace call
+ * and not the time of mbed_trace_deferred_flush(). Used instead of the function set
+ * with mbed_trace_prefix_function_set().
+ * e.g.
+ *   char* trace_time(uint32_t time, size_t length){ sprintf(str, "[%lu]", (unsigned long)time); return str; }
+ *   mbed_trace_time_prefix_function_set( &trace_time );
+ * @param pref_f  prefix function, NULL to use the function set with mbed_trace_prefix_function_set()
+ */
+void mbed_trace_time_prefix_function_set( char* (*pref_f)(uint32_t, size_t) );
 /**
  * Set trace suffix function
  * suffix -function return string with null terminated
@@ -365,6 +378,66 @@ char* mbed_trace_ipv6_prefix(const uint8_t *prefix, uint8_t prefix_len);
  * which indicate that buffer is too small for array.
  */
 char* mbed_trace_array(const uint8_t* buf, uint16_t len);
+/**
+ * Enable deferred traces
+ * Trace calls only check the level and filters and store group and format pointers
+ * and argument values to a ring buffer, and return. Trace lines are formatted and
+ * printed later by mbed_trace_deferred_flush(), without holding the trace mutex, so
+ * slow print functions do not slow down the callers. Space is reserved from the ring
+ * without locks, so traces can be stored also from interrupts when no mutex is set.
+ * Group names and format strings must stay valid until flushed, e.g. string literals.
+ * %s arguments are copied. Traces that do not fit are dropped and counted.
+ * tr_cmdline() is always printed immediately.
+ * Lines are printed in the mode (color, plain, carriage return) configured at the trace
+ * call. The prefix function is called by the flush, use mbed_trace_time_prefix_function_set()
+ * to prefix lines with the time of the trace call.
+ *
+ * Must not be called while other trace calls are in progress.
+ * @param ring_size  ring buffer size in bytes, power of two, 0 to print synchronously again
+ * @return 0 when success, -1 when size is invalid or allocation fails
+ */
+int mbed_trace_deferred_enable(int ring_size);
+/**
+ * Set function called when deferred traces have been stored
+ * It is called once for the first trace stored after each mbed_trace_deferred_flush(),
+ * possibly from interrupt context, and should only wake up the thread or queue
+ * the event that calls mbed_trace_deferred_flush().
+ * e.g.
+ *   mbed_trace_deferred_notify_function_set(trace_notify); // trace_notify() calls queue.call(mbed_trace_deferred_flush, 0)
+ */
+void mbed_trace_deferred_notify_function_set(void (*notify_f)(void));
+/**
+ * Format and print stored deferred traces, oldest first
+ * Must be called from one thread at a time, e.g. from a low priority thread or an EventQueue.
+ * @param max_lines  maximum number of lines to print, 0 for all
+ * @return number of lines printed
+ */
+int mbed_trace_deferred_flush(int max_lines);
+/**
+ * Get number of deferred traces dropped because the ring was full
+ */
+uint32_t mbed_trace_deferred_dropped(void);
+/**
+ * Set binary trace mode
+ * Instead of text lines, traces are printed as short binary frames that have the level,
+ * a timestamp, the addresses of the format string and group name, and the argument values
+ * packed to variable length integers. %s arguments are included as strings.
+ * Frames are passed to the print function as zero terminated strings, bytes 0x00, '\n',
+ * '\r' and 0x1B are escaped, so they can be printed next to text traces.
+ * tools/debug_tools/trace_decoder reads the strings from the application's elf file
+ * and prints the frames as text again.
+ * Works also with deferred traces. tr_cmdline() is always printed as text.
+ * @param enable  true for binary frames, false for text lines
+ */
+void mbed_trace_binary_mode_set(bool enable);
+/**
+ * Set timestamp function for binary traces and time prefix
+ * The value is included in each binary frame, e.g. us_ticker_read or milliseconds,
+ * and given to the function set with mbed_trace_time_prefix_function_set().
+ * In deferred mode it is read when trace is stored.
+ * @param time_f  timestamp function, NULL to send zero
+ */
+void mbed_trace_binary_time_function_set(uint32_t (*time_f)(void));
 
 #ifdef __cplusplus
 }
@@ -389,6 +462,7 @@ char* mbed_trace_array(const uint8_t* buf, uint16_t len);
 #undef mbed_trace_config_set
 #undef mbed_trace_config_get
 #undef mbed_trace_prefix_function_set
+#undef mbed_trace_time_prefix_function_set
 #undef mbed_trace_suffix_function_set
 #undef mbed_trace_print_function_set
 #undef mbed_trace_cmdprint_function_set
@@ -404,6 +478,12 @@ char* mbed_trace_array(const uint8_t* buf, uint16_t len);
 #undef mbed_trace_ipv6
 #undef mbed_trace_ipv6_prefix
 #undef mbed_trace_array
+#undef mbed_trace_deferred_enable
+#undef mbed_trace_deferred_notify_function_set
+#undef mbed_trace_deferred_flush
+#undef mbed_trace_deferred_dropped
+#undef mbed_trace_binary_mode_set
+#undef mbed_trace_binary_time_function_set
 
 #elif !defined(MBED_TRACE_DUMMIES_DEFINED)
 // define dummies, hiding the real functions
@@ -414,6 +494,7 @@ char* mbed_trace_array(const uint8_t* buf, uint16_t len);
 #define mbed_trace_config_set(...)                  ((void) 0)
 #define mbed_trace_config_get(...)                  ((uint8_t) 0)
 #define mbed_trace_prefix_function_set(...)         ((void) 0)
+#define mbed_trace_time_prefix_function_set(...)    ((void) 0)
 #define mbed_trace_suffix_function_set(...)         ((void) 0)
 #define mbed_trace_print_function_set(...)          ((void) 0)
 #define mbed_trace_cmdprint_function_set(...)       ((void) 0)
@@ -426,6 +507,12 @@ char* mbed_trace_array(const uint8_t* buf, uint16_t len);
 #define mbed_trace_last(...)                        ((const char *) 0)
 #define mbed_tracef(...)                            ((void) 0)
 #define mbed_vtracef(...)                           ((void) 0)
+#define mbed_trace_deferred_enable(...)             ((int) 0)
+#define mbed_trace_deferred_notify_function_set(...) ((void) 0)
+#define mbed_trace_deferred_flush(...)              ((int) 0)
+#define mbed_trace_deferred_dropped(...)            ((uint32_t) 0)
+#define mbed_trace_binary_mode_set(...)             ((void) 0)
+#define mbed_trace_binary_time_function_set(...)    ((void) 0)
 /**
  * These helper functions accumulate strings in a buffer that is only flushed by actual trace calls. Using these
  * functions outside trace calls could cause the buffer to overflow.
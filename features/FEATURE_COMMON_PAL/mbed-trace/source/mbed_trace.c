@@ -26,6 +26,9 @@
 #endif
 
 #include "mbed-trace/mbed_trace.h"
+#if defined(__MBED__)
+#include "platform/mbed_critical.h"
+#endif
 #if MBED_CONF_MBED_TRACE_FEA_IPV6 == 1
 #include "mbed-client-libservice/ip6string.h"
 #include "mbed-client-libservice/common_functions.h"
@@ -85,6 +88,24 @@
 #define DEFAULT_TRACE_FILTER_LENGTH       24
 #endif
 
+/** default max deferred trace record size in bytes, group, format and arguments included */
+#ifdef MBED_TRACE_DEFERRED_RECORD_LENGTH
+#define DEFAULT_TRACE_DEFERRED_RECORD_LENGTH  MBED_TRACE_DEFERRED_RECORD_LENGTH
+#else
+#define DEFAULT_TRACE_DEFERRED_RECORD_LENGTH  128
+#endif
+
+/** atomic operations used by the deferred trace ring */
+#if defined(__MBED__)
+#define trace_atomic_load(ptr)                          (*(volatile uint32_t *)(ptr))
+#define trace_atomic_cas(ptr, expected_ptr, desired)    core_util_atomic_cas_u32(ptr, expected_ptr, desired)
+#define trace_atomic_incr(ptr)                          core_util_atomic_incr_u32(ptr, 1)
+#else
+#define trace_atomic_load(ptr)                          __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define trace_atomic_cas(ptr, expected_ptr, desired)    __atomic_compare_exchange_n(ptr, expected_ptr, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define trace_atomic_incr(ptr)                          __atomic_add_fetch(ptr, 1, __ATOMIC_RELAXED)
+#endif
+
 /** default trace configuration bitmask */
 #ifdef MBED_TRACE_CONFIG
 #define DEFAULT_TRACE_CONFIG              MBED_TRACE_CONFIG
@@ -96,6 +117,12 @@
 static void mbed_trace_realloc( char **buffer, int *length_ptr, int new_length);
 static void mbed_trace_default_print(const char *str);
 static void mbed_trace_reset_tmp(void);
+static void mbed_trace_print_line(char *line, int line_length, uint8_t config, uint8_t dlevel, uint32_t time, const char *grp, const char *fmt, va_list ap);
+static void mbed_trace_deferred_store(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+static void mbed_trace_deferred_release(void);
+static void mbed_trace_binary_line(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+static void mbed_trace_binary_print(char *line, int line_length, uint8_t dlevel, uint32_t time,
+                                    const char *grp, const char *fmt, const uint8_t *args, int args_len);
 
 typedef struct trace_s {
     /** trace configuration bits */
@@ -131,6 +158,35 @@ typedef struct trace_s {
     void (*mutex_release_f)(void);
     /** number of times the mutex has been locked */
     int mutex_lock_count;
+
+    /** deferred trace records, NULL when traces are printed synchronously */
+    uint8_t *deferred_ring;
+    /** deferred ring size in bytes, power of two */
+    uint32_t deferred_size;
+    /** deferred ring write position, reserved by trace calls */
+    uint32_t deferred_head;
+    /** deferred ring read position, advanced by mbed_trace_deferred_flush() */
+    uint32_t deferred_tail;
+    /** number of records not stored because the ring was full */
+    uint32_t deferred_dropped;
+    /** non zero when notify function has been called and flush has not started yet */
+    uint32_t deferred_notified;
+    /** record being printed by mbed_trace_deferred_flush() */
+    uint8_t *deferred_record;
+    /** trace text of the record being printed */
+    char *deferred_body;
+    /** trace line of the record being printed */
+    char *deferred_line;
+    /** deferred body and line length */
+    int deferred_line_length;
+    /** function called when there are records to flush */
+    void (*deferred_notify_f)(void);
+    /** non zero when traces are printed as binary frames */
+    uint8_t binary_mode;
+    /** timestamp function for binary frames and time prefix */
+    uint32_t (*binary_time_f)(void);
+    /** prefix function, which gets the timestamp of the trace call */
+    char *(*time_prefix_f)(uint32_t, size_t);
 } trace_t;
 
 static trace_t m_trace = {
@@ -148,7 +204,21 @@ static trace_t m_trace = {
     .cmd_printf = 0,
     .mutex_wait_f = 0,
     .mutex_release_f = 0,
-    .mutex_lock_count = 0
+    .mutex_lock_count = 0,
+    .deferred_ring = 0,
+    .deferred_size = 0,
+    .deferred_head = 0,
+    .deferred_tail = 0,
+    .deferred_dropped = 0,
+    .deferred_notified = 0,
+    .deferred_record = 0,
+    .deferred_body = 0,
+    .deferred_line = 0,
+    .deferred_line_length = 0,
+    .deferred_notify_f = 0,
+    .binary_mode = 0,
+    .binary_time_f = 0,
+    .time_prefix_f = 0
 };
 
 int mbed_trace_init(void)
@@ -187,6 +257,7 @@ int mbed_trace_init(void)
 void mbed_trace_free(void)
 {
     // release memory
+    mbed_trace_deferred_release();
     MBED_TRACE_MEM_FREE(m_trace.line);
     MBED_TRACE_MEM_FREE(m_trace.tmp_data);
     MBED_TRACE_MEM_FREE(m_trace.filters_exclude);
@@ -208,6 +279,11 @@ void mbed_trace_free(void)
     m_trace.mutex_wait_f = 0;
     m_trace.mutex_release_f = 0;
     m_trace.mutex_lock_count = 0;
+    m_trace.deferred_dropped = 0;
+    m_trace.deferred_notify_f = 0;
+    m_trace.binary_mode = 0;
+    m_trace.binary_time_f = 0;
+    m_trace.time_prefix_f = 0;
 }
 static void mbed_trace_realloc( char **buffer, int *length_ptr, int new_length)
 {
@@ -237,6 +313,10 @@ void mbed_trace_prefix_function_set(char *(*pref_f)(size_t))
 {
     m_trace.prefix_f = pref_f;
 }
+void mbed_trace_time_prefix_function_set(char *(*pref_f)(uint32_t, size_t))
+{
+    m_trace.time_prefix_f = pref_f;
+}
 void mbed_trace_suffix_function_set(char *(*suffix_f)(void))
 {
     m_trace.suffix_f = suffix_f;
@@ -311,92 +391,32 @@ void mbed_tracef(uint8_t dlevel, const char *grp, const char *fmt, ...)
     mbed_vtracef(dlevel, grp, fmt, ap);
     va_end(ap);
 }
-void mbed_vtracef(uint8_t dlevel, const char* grp, const char *fmt, va_list ap)
+static uint32_t mbed_trace_time(void)
 {
-    if ( m_trace.mutex_wait_f ) {
-        m_trace.mutex_wait_f();
-        m_trace.mutex_lock_count++;
-    }
-
-    if (NULL == m_trace.line) {
-        goto end;
-    }
-
-    m_trace.line[0] = 0; //by default trace is empty
+    return m_trace.binary_time_f ? m_trace.binary_time_f() : 0;
+}
+static void mbed_trace_print_line(char *line, int line_length, uint8_t config, uint8_t dlevel, uint32_t time, const char *grp, const char *fmt, va_list ap)
+{
+    bool color = (config & TRACE_MODE_COLOR) != 0;
+    bool plain = (config & TRACE_MODE_PLAIN) != 0;
+    bool cr    = (config & TRACE_CARRIAGE_RETURN) != 0;
 
-    if (mbed_trace_skip(dlevel, grp) || fmt == 0 || grp == 0 || !m_trace.printf) {
-        //return tmp data pointer back to the beginning
-        mbed_trace_reset_tmp();
-        goto end;
-    }
-    if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
-        bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
-        bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
-        bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
-
-        int retval = 0, bLeft = m_trace.line_length;
-        char *ptr = m_trace.line;
-        if (plain == true || dlevel == TRACE_LEVEL_CMD) {
-            //add trace data
-            retval = vsnprintf(ptr, bLeft, fmt, ap);
-            if (dlevel == TRACE_LEVEL_CMD && m_trace.cmd_printf) {
-                m_trace.cmd_printf(m_trace.line);
-                m_trace.cmd_printf("\n");
-            } else {
-                //print out whole data
-                m_trace.printf(m_trace.line);
-            }
+    int retval = 0, bLeft = line_length;
+    char *ptr = line;
+    if (plain == true || dlevel == TRACE_LEVEL_CMD) {
+        //add trace data
+        retval = vsnprintf(ptr, bLeft, fmt, ap);
+        if (dlevel == TRACE_LEVEL_CMD && m_trace.cmd_printf) {
+            m_trace.cmd_printf(line);
+            m_trace.cmd_printf("\n");
         } else {
-            if (color) {
-                if (cr) {
-                    retval = snprintf(ptr, bLeft, "\r\x1b[2K");
-                    if (retval >= bLeft) {
-                        retval = 0;
-                    }
-                    if (retval > 0) {
-                        ptr += retval;
-                        bLeft -= retval;
-                    }
-                }
-                if (bLeft > 0) {
-                    //include color in ANSI/VT100 escape code
-                    switch (dlevel) {
-                        case (TRACE_LEVEL_ERROR):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_ERROR);
-                            break;
-                        case (TRACE_LEVEL_WARN):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_WARN);
-                            break;
-                        case (TRACE_LEVEL_INFO):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_INFO);
-                            break;
-                        case (TRACE_LEVEL_DEBUG):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_DEBUG);
-                            break;
-                        default:
-                            color = 0; //avoid unneeded color-terminate code
-                            retval = 0;
-                            break;
-                    }
-                    if (retval >= bLeft) {
-                        retval = 0;
-                    }
-                    if (retval > 0 && color) {
-                        ptr += retval;
-                        bLeft -= retval;
-                    }
-                }
-
-            }
-            if (bLeft > 0 && m_trace.prefix_f) {
-                //find out length of body
-                size_t sz = 0;
-                va_list ap2;
-                va_copy(ap2, ap);
-                sz = vsnprintf(NULL, 0, fmt, ap2) + retval + (retval ? 4 : 0);
-                va_end(ap2);
-                //add prefix string
-                retval = snprintf(ptr, bLeft, "%s", m_trace.prefix_f(sz));
+            //print out whole data
+            m_trace.printf(line);
+        }
+    } else {
+        if (color) {
+            if (cr) {
+                retval = snprintf(ptr, bLeft, "\r\x1b[2K");
                 if (retval >= bLeft) {
                     retval = 0;
                 }
@@ -406,70 +426,148 @@ void mbed_vtracef(uint8_t dlevel, const char* grp, const char *fmt, va_list ap)
                 }
             }
             if (bLeft > 0) {
-                //add group tag
+                //include color in ANSI/VT100 escape code
                 switch (dlevel) {
                     case (TRACE_LEVEL_ERROR):
-                        retval = snprintf(ptr, bLeft, "[ERR ][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_ERROR);
                         break;
                     case (TRACE_LEVEL_WARN):
-                        retval = snprintf(ptr, bLeft, "[WARN][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_WARN);
                         break;
                     case (TRACE_LEVEL_INFO):
-                        retval = snprintf(ptr, bLeft, "[INFO][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_INFO);
                         break;
                     case (TRACE_LEVEL_DEBUG):
-                        retval = snprintf(ptr, bLeft, "[DBG ][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_DEBUG);
                         break;
                     default:
-                        retval = snprintf(ptr, bLeft, "              ");
+                        color = 0; //avoid unneeded color-terminate code
+                        retval = 0;
                         break;
                 }
                 if (retval >= bLeft) {
                     retval = 0;
                 }
-                if (retval > 0) {
+                if (retval > 0 && color) {
                     ptr += retval;
                     bLeft -= retval;
                 }
             }
-            if (retval > 0 && bLeft > 0) {
-                //add trace text
-                retval = vsnprintf(ptr, bLeft, fmt, ap);
-                if (retval >= bLeft) {
-                    retval = 0;
-                }
-                if (retval > 0) {
-                    ptr += retval;
-                    bLeft -= retval;
-                }
+
+        }
+        if (bLeft > 0 && (m_trace.time_prefix_f || m_trace.prefix_f)) {
+            //find out length of body
+            size_t sz = 0;
+            va_list ap2;
+            va_copy(ap2, ap);
+            sz = vsnprintf(NULL, 0, fmt, ap2) + retval + (retval ? 4 : 0);
+            va_end(ap2);
+            //add prefix string
+            retval = snprintf(ptr, bLeft, "%s", m_trace.time_prefix_f ? m_trace.time_prefix_f(time, sz) : m_trace.prefix_f(sz));
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
             }
+        }
+        if (bLeft > 0) {
+            //add group tag
+            switch (dlevel) {
+                case (TRACE_LEVEL_ERROR):
+                    retval = snprintf(ptr, bLeft, "[ERR ][%-4s]: ", grp);
+                    break;
+                case (TRACE_LEVEL_WARN):
+                    retval = snprintf(ptr, bLeft, "[WARN][%-4s]: ", grp);
+                    break;
+                case (TRACE_LEVEL_INFO):
+                    retval = snprintf(ptr, bLeft, "[INFO][%-4s]: ", grp);
+                    break;
+                case (TRACE_LEVEL_DEBUG):
+                    retval = snprintf(ptr, bLeft, "[DBG ][%-4s]: ", grp);
+                    break;
+                default:
+                    retval = snprintf(ptr, bLeft, "              ");
+                    break;
+            }
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
+            }
+        }
+        if (retval > 0 && bLeft > 0) {
+            //add trace text
+            retval = vsnprintf(ptr, bLeft, fmt, ap);
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
+            }
+        }
 
-            if (retval > 0 && bLeft > 0  && m_trace.suffix_f) {
-                //add suffix string
-                retval = snprintf(ptr, bLeft, "%s", m_trace.suffix_f());
-                if (retval >= bLeft) {
-                    retval = 0;
-                }
-                if (retval > 0) {
-                    ptr += retval;
-                    bLeft -= retval;
-                }
+        if (retval > 0 && bLeft > 0  && m_trace.suffix_f) {
+            //add suffix string
+            retval = snprintf(ptr, bLeft, "%s", m_trace.suffix_f());
+            if (retval >= bLeft) {
+                retval = 0;
             }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
+            }
+        }
 
-            if (retval > 0 && bLeft > 0  && color) {
-                //add zero color VT100 when color mode
-                retval = snprintf(ptr, bLeft, "\x1b[0m");
-                if (retval >= bLeft) {
-                    retval = 0;
-                }
-                if (retval > 0) {
-                    // not used anymore
-                    //ptr += retval;
-                    //bLeft -= retval;
-                }
+        if (retval > 0 && bLeft > 0  && color) {
+            //add zero color VT100 when color mode
+            retval = snprintf(ptr, bLeft, "\x1b[0m");
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                // not used anymore
+                //ptr += retval;
+                //bLeft -= retval;
             }
-            //print out whole data
-            m_trace.printf(m_trace.line);
+        }
+        //print out whole data
+        m_trace.printf(line);
+    }
+}
+void mbed_vtracef(uint8_t dlevel, const char* grp, const char *fmt, va_list ap)
+{
+    if ( m_trace.mutex_wait_f ) {
+        m_trace.mutex_wait_f();
+        m_trace.mutex_lock_count++;
+    }
+
+    if (NULL == m_trace.line) {
+        goto end;
+    }
+
+    if (m_trace.deferred_ring == NULL) {
+        // deferred traces leave the shared line alone, they may not hold the mutex
+        m_trace.line[0] = 0; //by default trace is empty
+    }
+
+    if (mbed_trace_skip(dlevel, grp) || fmt == 0 || grp == 0 || !m_trace.printf) {
+        //return tmp data pointer back to the beginning
+        mbed_trace_reset_tmp();
+        goto end;
+    }
+    if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
+        if (m_trace.deferred_ring && dlevel != TRACE_LEVEL_CMD) {
+            mbed_trace_deferred_store(dlevel, grp, fmt, ap);
+        } else if (m_trace.binary_mode && dlevel != TRACE_LEVEL_CMD) {
+            mbed_trace_binary_line(dlevel, grp, fmt, ap);
+        } else {
+            mbed_trace_print_line(m_trace.line, m_trace.line_length, m_trace.trace_config, dlevel,
+                                  m_trace.time_prefix_f ? mbed_trace_time() : 0, grp, fmt, ap);
         }
         //return tmp data pointer back to the beginning
         mbed_trace_reset_tmp();
@@ -495,12 +593,690 @@ end:
 }
 static void mbed_trace_reset_tmp(void)
 {
-    m_trace.tmp_data_ptr = m_trace.tmp_data;
+    // only written when helpers have been used, which hold the mutex
+    if (m_trace.tmp_data_ptr != m_trace.tmp_data) {
+        m_trace.tmp_data_ptr = m_trace.tmp_data;
+    }
 }
 const char *mbed_trace_last(void)
 {
     return m_trace.line;
 }
+/* Deferred traces */
+/** deferred record starts with header word, timestamp, group and format pointers */
+#define TRACE_DEFERRED_HEADER_LEN   (2 * sizeof(uint32_t) + 2 * sizeof(const char *))
+#define TRACE_DEFERRED_TIME_OFFSET  sizeof(uint32_t)
+#define TRACE_DEFERRED_GRP_OFFSET   (2 * sizeof(uint32_t))
+#define TRACE_DEFERRED_FMT_OFFSET   (2 * sizeof(uint32_t) + sizeof(const char *))
+/** record buffer, rounded up as records are kept 4 byte aligned in the ring */
+#define TRACE_DEFERRED_RECORD_SIZE  ((DEFAULT_TRACE_DEFERRED_RECORD_LENGTH + 3) & ~3)
+
+/** argument types stored to deferred trace records */
+typedef enum {
+    TRACE_ARG_NONE,
+    TRACE_ARG_INT,
+    TRACE_ARG_LONG,
+    TRACE_ARG_LLONG,
+    TRACE_ARG_INTMAX,
+    TRACE_ARG_SIZE,
+    TRACE_ARG_PTRDIFF,
+    TRACE_ARG_DOUBLE,
+    TRACE_ARG_LDOUBLE,
+    TRACE_ARG_PTR,
+    TRACE_ARG_STRING,
+    TRACE_ARG_SKIP,
+    TRACE_ARG_INVALID
+} trace_arg_t;
+
+/** parse conversion specification starting with '%', return pointer after it */
+static const char *mbed_trace_conversion(const char *fmt, trace_arg_t *type, int *stars)
+{
+    const char *p = fmt + 1;
+    char length = 0;
+
+    *stars = 0;
+    while (*p && strchr("-+ #0", *p)) {
+        p++;
+    }
+    if (*p == '*') {
+        (*stars)++;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9') {
+        p++;
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            (*stars)++;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+    switch (*p) {
+        case 'h':
+            length = *p++;
+            if (*p == 'h') {
+                p++;
+            }
+            break;
+        case 'l':
+            length = *p++;
+            if (*p == 'l') {
+                length = 'q';
+                p++;
+            }
+            break;
+        case 'j':
+        case 'z':
+        case 't':
+        case 'L':
+            length = *p++;
+            break;
+        default:
+            break;
+    }
+    switch (*p) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            switch (length) {
+                case 'l':
+                    *type = TRACE_ARG_LONG;
+                    break;
+                case 'q':
+                    *type = TRACE_ARG_LLONG;
+                    break;
+                case 'j':
+                    *type = TRACE_ARG_INTMAX;
+                    break;
+                case 'z':
+                    *type = TRACE_ARG_SIZE;
+                    break;
+                case 't':
+                    *type = TRACE_ARG_PTRDIFF;
+                    break;
+                default:
+                    *type = TRACE_ARG_INT;
+                    break;
+            }
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            *type = length == 'L' ? TRACE_ARG_LDOUBLE : TRACE_ARG_DOUBLE;
+            break;
+        case 'p':
+            *type = TRACE_ARG_PTR;
+            break;
+        case 's':
+            // wide strings are not supported
+            *type = length ? TRACE_ARG_INVALID : TRACE_ARG_STRING;
+            break;
+        case 'n':
+            *type = TRACE_ARG_SKIP;
+            break;
+        case '%':
+            *type = TRACE_ARG_NONE;
+            break;
+        default:
+            *type = TRACE_ARG_INVALID;
+            return p;
+    }
+    return p + 1;
+}
+
+#define TRACE_ARG_STORE(type) do { \
+        type value = va_arg(ap, type); \
+        if (used + (int)sizeof(value) > size) { \
+            return used; \
+        } \
+        memcpy(dst + used, &value, sizeof(value)); \
+        used += sizeof(value); \
+    } while (0)
+
+/** store arguments of fmt as raw values and strings as copies, return bytes used */
+static int mbed_trace_deferred_args(uint8_t *dst, int size, const char *fmt, va_list ap)
+{
+    int used = 0;
+    trace_arg_t type;
+    int stars;
+
+    while ((fmt = strchr(fmt, '%')) != NULL) {
+        fmt = mbed_trace_conversion(fmt, &type, &stars);
+        while (stars-- > 0) {
+            TRACE_ARG_STORE(int);
+        }
+        switch (type) {
+            case TRACE_ARG_NONE:
+                break;
+            case TRACE_ARG_INT:
+                TRACE_ARG_STORE(int);
+                break;
+            case TRACE_ARG_LONG:
+                TRACE_ARG_STORE(long);
+                break;
+            case TRACE_ARG_LLONG:
+                TRACE_ARG_STORE(long long);
+                break;
+            case TRACE_ARG_INTMAX:
+                TRACE_ARG_STORE(intmax_t);
+                break;
+            case TRACE_ARG_SIZE:
+                TRACE_ARG_STORE(size_t);
+                break;
+            case TRACE_ARG_PTRDIFF:
+                TRACE_ARG_STORE(ptrdiff_t);
+                break;
+            case TRACE_ARG_DOUBLE:
+                TRACE_ARG_STORE(double);
+                break;
+            case TRACE_ARG_LDOUBLE:
+                TRACE_ARG_STORE(long double);
+                break;
+            case TRACE_ARG_PTR:
+                TRACE_ARG_STORE(void *);
+                break;
+            case TRACE_ARG_STRING: {
+                // string may be on the caller's stack or in tmp data, so it is copied
+                const char *str = va_arg(ap, const char *);
+                int len;
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                len = strlen(str);
+                if (used >= size) {
+                    return used;
+                }
+                if (len > size - used - 1) {
+                    len = size - used - 1;
+                }
+                memcpy(dst + used, str, len);
+                dst[used + len] = 0;
+                used += len + 1;
+                break;
+            }
+            case TRACE_ARG_SKIP:
+                (void)va_arg(ap, void *);
+                break;
+            default:
+                return used;
+        }
+    }
+    return used;
+}
+
+#define TRACE_ARG_LOAD(type, value) do { \
+        if (args_len < (int)sizeof(type)) { \
+            goto out; \
+        } \
+        memcpy(&(value), args, sizeof(type)); \
+        args += sizeof(type); \
+        args_len -= sizeof(type); \
+    } while (0)
+
+#define TRACE_ARG_PRINT(type) do { \
+        type value; \
+        TRACE_ARG_LOAD(type, value); \
+        if (stars == 0) { \
+            retval = snprintf(ptr, bLeft, spec, value); \
+        } else if (stars == 1) { \
+            retval = snprintf(ptr, bLeft, spec, star[0], value); \
+        } else { \
+            retval = snprintf(ptr, bLeft, spec, star[0], star[1], value); \
+        } \
+    } while (0)
+
+/** print fmt with arguments stored by mbed_trace_deferred_args(), stop at first missing one */
+static void mbed_trace_deferred_vformat(char *dst, int size, const char *fmt, const uint8_t *args, int args_len)
+{
+    char spec[16];
+    int star[2];
+    int bLeft = size;
+    char *ptr = dst;
+    trace_arg_t type;
+    int stars;
+
+    while (*fmt && bLeft > 1) {
+        const char *conv = strchr(fmt, '%');
+        int retval = conv ? conv - fmt : (int)strlen(fmt);
+        if (retval >= bLeft) {
+            retval = bLeft - 1;
+        }
+        memcpy(ptr, fmt, retval);
+        ptr += retval;
+        bLeft -= retval;
+        if (conv == NULL || bLeft <= 1) {
+            break;
+        }
+
+        fmt = mbed_trace_conversion(conv, &type, &stars);
+        if (type == TRACE_ARG_NONE) {
+            *ptr++ = '%';
+            bLeft--;
+            continue;
+        }
+        if (type == TRACE_ARG_INVALID || fmt - conv >= (int)sizeof(spec)) {
+            break;
+        }
+        memcpy(spec, conv, fmt - conv);
+        spec[fmt - conv] = 0;
+        for (int i = 0; i < stars; i++) {
+            TRACE_ARG_LOAD(int, star[i]);
+        }
+
+        switch (type) {
+            case TRACE_ARG_INT:
+                TRACE_ARG_PRINT(int);
+                break;
+            case TRACE_ARG_LONG:
+                TRACE_ARG_PRINT(long);
+                break;
+            case TRACE_ARG_LLONG:
+                TRACE_ARG_PRINT(long long);
+                break;
+            case TRACE_ARG_INTMAX:
+                TRACE_ARG_PRINT(intmax_t);
+                break;
+            case TRACE_ARG_SIZE:
+                TRACE_ARG_PRINT(size_t);
+                break;
+            case TRACE_ARG_PTRDIFF:
+                TRACE_ARG_PRINT(ptrdiff_t);
+                break;
+            case TRACE_ARG_DOUBLE:
+                TRACE_ARG_PRINT(double);
+                break;
+            case TRACE_ARG_LDOUBLE:
+                TRACE_ARG_PRINT(long double);
+                break;
+            case TRACE_ARG_PTR:
+                TRACE_ARG_PRINT(void *);
+                break;
+            case TRACE_ARG_STRING: {
+                const char *value = (const char *)args;
+                const uint8_t *end = memchr(args, 0, args_len > 0 ? args_len : 0);
+                if (end == NULL) {
+                    goto out;
+                }
+                args_len -= end + 1 - args;
+                args = end + 1;
+                if (stars == 0) {
+                    retval = snprintf(ptr, bLeft, spec, value);
+                } else if (stars == 1) {
+                    retval = snprintf(ptr, bLeft, spec, star[0], value);
+                } else {
+                    retval = snprintf(ptr, bLeft, spec, star[0], star[1], value);
+                }
+                break;
+            }
+            default:
+                // %n
+                retval = 0;
+                break;
+        }
+        if (retval < 0) {
+            break;
+        }
+        if (retval >= bLeft) {
+            retval = bLeft - 1;
+        }
+        ptr += retval;
+        bLeft -= retval;
+    }
+out:
+    *ptr = 0;
+}
+
+/** copy to ring position, wrapping at the end of ring. NULL src clears */
+static void mbed_trace_deferred_write(uint32_t pos, const uint8_t *src, uint32_t len)
+{
+    uint32_t index = pos & (m_trace.deferred_size - 1);
+    uint32_t first = m_trace.deferred_size - index;
+    if (first > len) {
+        first = len;
+    }
+    if (src) {
+        memcpy(m_trace.deferred_ring + index, src, first);
+        memcpy(m_trace.deferred_ring, src + first, len - first);
+    } else {
+        memset(m_trace.deferred_ring + index, 0, first);
+        memset(m_trace.deferred_ring, 0, len - first);
+    }
+}
+
+/** copy from ring position, wrapping at the end of ring */
+static void mbed_trace_deferred_read(uint32_t pos, uint8_t *dst, uint32_t len)
+{
+    uint32_t index = pos & (m_trace.deferred_size - 1);
+    uint32_t first = m_trace.deferred_size - index;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(dst, m_trace.deferred_ring + index, first);
+    memcpy(dst + first, m_trace.deferred_ring, len - first);
+}
+
+static void mbed_trace_deferred_store(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    uint8_t record[TRACE_DEFERRED_RECORD_SIZE];
+    uint32_t used, len, head, header;
+    uint32_t expected = 0;
+    uint32_t time = mbed_trace_time();
+
+    memcpy(record + TRACE_DEFERRED_TIME_OFFSET, &time, sizeof(time));
+    memcpy(record + TRACE_DEFERRED_GRP_OFFSET, &grp, sizeof(grp));
+    memcpy(record + TRACE_DEFERRED_FMT_OFFSET, &fmt, sizeof(fmt));
+    used = TRACE_DEFERRED_HEADER_LEN + mbed_trace_deferred_args(record + TRACE_DEFERRED_HEADER_LEN,
+            DEFAULT_TRACE_DEFERRED_RECORD_LENGTH - TRACE_DEFERRED_HEADER_LEN, fmt, ap);
+    len = (used + 3) & ~3;
+
+    // reserve space, without waiting for other trace calls or the flush
+    head = trace_atomic_load(&m_trace.deferred_head);
+    do {
+        if (head - trace_atomic_load(&m_trace.deferred_tail) + len > m_trace.deferred_size) {
+            trace_atomic_incr(&m_trace.deferred_dropped);
+            return;
+        }
+    } while (!trace_atomic_cas(&m_trace.deferred_head, &head, head + len));
+
+    // free space is kept cleared, so the header is written last to commit the record
+    mbed_trace_deferred_write(head + sizeof(uint32_t), record + sizeof(uint32_t), used - sizeof(uint32_t));
+    // the decorations of the line are kept as configured at the trace call
+    header = len | ((uint32_t)dlevel << 16) | ((uint32_t)(m_trace.trace_config & TRACE_MASK_CONFIG) << 24);
+    trace_atomic_cas((uint32_t *)(m_trace.deferred_ring + (head & (m_trace.deferred_size - 1))), &expected, header);
+
+    if (m_trace.deferred_notify_f) {
+        expected = 0;
+        if (trace_atomic_cas(&m_trace.deferred_notified, &expected, 1)) {
+            m_trace.deferred_notify_f();
+        }
+    }
+}
+
+static void mbed_trace_deferred_print(uint8_t config, uint8_t dlevel, uint32_t time, const char *grp, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    mbed_trace_print_line(m_trace.deferred_line, m_trace.deferred_line_length, config, dlevel, time, grp, fmt, ap);
+    va_end(ap);
+}
+
+static void mbed_trace_deferred_release(void)
+{
+    MBED_TRACE_MEM_FREE(m_trace.deferred_ring);
+    MBED_TRACE_MEM_FREE(m_trace.deferred_record);
+    MBED_TRACE_MEM_FREE(m_trace.deferred_body);
+    MBED_TRACE_MEM_FREE(m_trace.deferred_line);
+    m_trace.deferred_ring = 0;
+    m_trace.deferred_size = 0;
+    m_trace.deferred_head = 0;
+    m_trace.deferred_tail = 0;
+    m_trace.deferred_notified = 0;
+    m_trace.deferred_record = 0;
+    m_trace.deferred_body = 0;
+    m_trace.deferred_line = 0;
+    m_trace.deferred_line_length = 0;
+}
+
+int mbed_trace_deferred_enable(int ring_size)
+{
+    // print what is already stored with the old settings
+    mbed_trace_deferred_flush(0);
+    mbed_trace_deferred_release();
+
+    if (ring_size == 0) {
+        return 0;
+    }
+    if (ring_size < (int)TRACE_DEFERRED_RECORD_SIZE || (ring_size & (ring_size - 1)) != 0) {
+        return -1;
+    }
+
+    m_trace.deferred_ring = MBED_TRACE_MEM_ALLOC(ring_size);
+    m_trace.deferred_record = MBED_TRACE_MEM_ALLOC(TRACE_DEFERRED_RECORD_SIZE);
+    m_trace.deferred_body = MBED_TRACE_MEM_ALLOC(m_trace.line_length);
+    m_trace.deferred_line = MBED_TRACE_MEM_ALLOC(m_trace.line_length);
+    if (m_trace.deferred_ring == NULL ||
+            m_trace.deferred_record == NULL ||
+            m_trace.deferred_body == NULL ||
+            m_trace.deferred_line == NULL) {
+        //memory allocation fail
+        mbed_trace_deferred_release();
+        return -1;
+    }
+    memset(m_trace.deferred_ring, 0, ring_size);
+    m_trace.deferred_size = ring_size;
+    m_trace.deferred_line_length = m_trace.line_length;
+    return 0;
+}
+void mbed_trace_deferred_notify_function_set(void (*notify_f)(void))
+{
+    m_trace.deferred_notify_f = notify_f;
+}
+uint32_t mbed_trace_deferred_dropped(void)
+{
+    return trace_atomic_load(&m_trace.deferred_dropped);
+}
+int mbed_trace_deferred_flush(int max_lines)
+{
+    int lines = 0;
+    uint32_t expected = 1;
+
+    if (m_trace.deferred_ring == NULL) {
+        return 0;
+    }
+    // records committed after this notify again
+    trace_atomic_cas(&m_trace.deferred_notified, &expected, 0);
+
+    while (max_lines <= 0 || lines < max_lines) {
+        uint32_t tail = m_trace.deferred_tail;
+        uint32_t header, len;
+        uint32_t time;
+        const char *grp, *fmt;
+
+        if (tail == trace_atomic_load(&m_trace.deferred_head)) {
+            break;
+        }
+        header = trace_atomic_load((uint32_t *)(m_trace.deferred_ring + (tail & (m_trace.deferred_size - 1))));
+        if (header == 0) {
+            // still being written, stay in order
+            break;
+        }
+        len = header & 0xFFFF;
+
+        // take the record out of the ring before the slow part
+        mbed_trace_deferred_read(tail, m_trace.deferred_record, len);
+        mbed_trace_deferred_write(tail, NULL, len);
+        trace_atomic_cas(&m_trace.deferred_tail, &tail, tail + len);
+
+        memcpy(&time, m_trace.deferred_record + TRACE_DEFERRED_TIME_OFFSET, sizeof(time));
+        memcpy(&grp, m_trace.deferred_record + TRACE_DEFERRED_GRP_OFFSET, sizeof(grp));
+        memcpy(&fmt, m_trace.deferred_record + TRACE_DEFERRED_FMT_OFFSET, sizeof(fmt));
+        if (m_trace.printf == NULL) {
+            // nothing to print to
+        } else if (m_trace.binary_mode) {
+            mbed_trace_binary_print(m_trace.deferred_line, m_trace.deferred_line_length, (header >> 16) & 0xFF, time, grp, fmt,
+                                    m_trace.deferred_record + TRACE_DEFERRED_HEADER_LEN, len - TRACE_DEFERRED_HEADER_LEN);
+        } else {
+            mbed_trace_deferred_vformat(m_trace.deferred_body, m_trace.deferred_line_length, fmt,
+                                        m_trace.deferred_record + TRACE_DEFERRED_HEADER_LEN, len - TRACE_DEFERRED_HEADER_LEN);
+            mbed_trace_deferred_print(header >> 24, (header >> 16) & 0xFF, time, grp, "%s", m_trace.deferred_body);
+        }
+        lines++;
+    }
+    return lines;
+}
+/* Binary traces */
+/** first byte of binary frame, not used in text traces */
+#define TRACE_BINARY_MARKER     0x1F
+/** escape byte, followed by escaped byte XOR 0x20 */
+#define TRACE_BINARY_ESCAPE     0x1B
+
+/** append byte to binary frame, escaping bytes that would end or split the line.
+ *  return new length, or size when frame does not fit */
+static int mbed_trace_binary_byte(char *dst, int size, int used, uint8_t byte)
+{
+    if (byte == 0 || byte == '\n' || byte == '\r' || byte == TRACE_BINARY_ESCAPE) {
+        if (used + 2 >= size) {
+            return size;
+        }
+        dst[used++] = TRACE_BINARY_ESCAPE;
+        byte ^= 0x20;
+    } else if (used + 1 >= size) {
+        return size;
+    }
+    dst[used++] = byte;
+    return used;
+}
+
+/** append value 7 bits at a time, least significant first, high bit set when more follow */
+static int mbed_trace_binary_varint(char *dst, int size, int used, uint64_t value)
+{
+    while (value >= 0x80) {
+        used = mbed_trace_binary_byte(dst, size, used, (uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    return mbed_trace_binary_byte(dst, size, used, (uint8_t)value);
+}
+
+/** map signed value to unsigned so that small negative values stay short */
+static uint64_t mbed_trace_binary_zigzag(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+#define TRACE_ARG_ENCODE(type, stype, utype) do { \
+        type value; \
+        TRACE_ARG_LOAD(type, value); \
+        used = mbed_trace_binary_varint(line, line_length, used, is_signed ? \
+                                        mbed_trace_binary_zigzag((stype)value) : (uint64_t)(utype)value); \
+    } while (0)
+
+/** print binary frame of arguments stored by mbed_trace_deferred_args(), only complete arguments are included */
+static void mbed_trace_binary_print(char *line, int line_length, uint8_t dlevel, uint32_t time,
+                                    const char *grp, const char *fmt, const uint8_t *args, int args_len)
+{
+    int used = 0, complete;
+    trace_arg_t type;
+    int stars;
+
+    line[used++] = TRACE_BINARY_MARKER;
+    used = mbed_trace_binary_byte(line, line_length, used, dlevel);
+    used = mbed_trace_binary_varint(line, line_length, used, time);
+    used = mbed_trace_binary_varint(line, line_length, used, (uintptr_t)fmt);
+    used = mbed_trace_binary_varint(line, line_length, used, (uintptr_t)grp);
+    if (used >= line_length) {
+        // line buffer too small for any frame
+        return;
+    }
+    complete = used;
+
+    while ((fmt = strchr(fmt, '%')) != NULL) {
+        bool is_signed;
+        fmt = mbed_trace_conversion(fmt, &type, &stars);
+        if (type == TRACE_ARG_INVALID) {
+            break;
+        }
+        is_signed = fmt[-1] == 'd' || fmt[-1] == 'i';
+        for (int i = 0; i < stars; i++) {
+            int star;
+            TRACE_ARG_LOAD(int, star);
+            used = mbed_trace_binary_varint(line, line_length, used, mbed_trace_binary_zigzag(star));
+        }
+
+        switch (type) {
+            case TRACE_ARG_INT:
+                TRACE_ARG_ENCODE(int, int, unsigned int);
+                break;
+            case TRACE_ARG_LONG:
+                TRACE_ARG_ENCODE(long, long, unsigned long);
+                break;
+            case TRACE_ARG_LLONG:
+                TRACE_ARG_ENCODE(long long, long long, unsigned long long);
+                break;
+            case TRACE_ARG_INTMAX:
+                TRACE_ARG_ENCODE(intmax_t, intmax_t, uintmax_t);
+                break;
+            case TRACE_ARG_SIZE:
+                TRACE_ARG_ENCODE(size_t, ptrdiff_t, size_t);
+                break;
+            case TRACE_ARG_PTRDIFF:
+                TRACE_ARG_ENCODE(ptrdiff_t, ptrdiff_t, size_t);
+                break;
+            case TRACE_ARG_PTR:
+                TRACE_ARG_ENCODE(void *, intptr_t, uintptr_t);
+                break;
+            case TRACE_ARG_DOUBLE:
+            case TRACE_ARG_LDOUBLE: {
+                // IEEE 754 double, least significant byte first
+                double value;
+                uint64_t bits;
+                if (type == TRACE_ARG_DOUBLE) {
+                    TRACE_ARG_LOAD(double, value);
+                } else {
+                    long double lvalue;
+                    TRACE_ARG_LOAD(long double, lvalue);
+                    value = lvalue;
+                }
+                memcpy(&bits, &value, sizeof(bits));
+                for (int i = 0; i < 8; i++) {
+                    used = mbed_trace_binary_byte(line, line_length, used, (uint8_t)(bits >> (8 * i)));
+                }
+                break;
+            }
+            case TRACE_ARG_STRING: {
+                const uint8_t *end = memchr(args, 0, args_len > 0 ? args_len : 0);
+                if (end == NULL) {
+                    goto out;
+                }
+                args_len -= end + 1 - args;
+                // including the terminating zero
+                while (args <= end) {
+                    used = mbed_trace_binary_byte(line, line_length, used, *args++);
+                }
+                break;
+            }
+            default:
+                // %% and %n
+                break;
+        }
+        if (used >= line_length) {
+            break;
+        }
+        complete = used;
+    }
+out:
+    line[complete] = 0;
+    m_trace.printf(line);
+}
+
+static void mbed_trace_binary_line(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    uint8_t args[TRACE_DEFERRED_RECORD_SIZE];
+    uint32_t time = mbed_trace_time();
+    int args_len = mbed_trace_deferred_args(args, DEFAULT_TRACE_DEFERRED_RECORD_LENGTH - TRACE_DEFERRED_HEADER_LEN, fmt, ap);
+    mbed_trace_binary_print(m_trace.line, m_trace.line_length, dlevel, time, grp, fmt, args, args_len);
+}
+
+void mbed_trace_binary_mode_set(bool enable)
+{
+    m_trace.binary_mode = enable;
+}
+void mbed_trace_binary_time_function_set(uint32_t (*time_f)(void))
+{
+    m_trace.binary_time_f = time_f;
+}
 /* Helping functions */
 #define tmp_data_left()  m_trace.tmp_data_length-(m_trace.tmp_data_ptr-m_trace.tmp_data)
 #if MBED_CONF_MBED_TRACE_FEA_IPV6 == 1
@@ -474,3 +474,238 @@ TEST(trace, uninitialized)
     STRCMP_EQUAL("hello", buf);
 }
 
+static int deferred_notify_count = 0;
+void deferred_notify()
+{
+  deferred_notify_count++;
+}
+TEST(trace, deferred)
+{
+  check_mutex_lock_status = false; // lines are printed by flush, outside trace calls
+  deferred_notify_count = 0;
+  buf[0] = 0;
+  CHECK(mbed_trace_deferred_enable(1024) == 0);
+  mbed_trace_deferred_notify_function_set(deferred_notify);
+
+  char name[8] = "first";
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "hello %s %d %.1f %lld %5s|%-*d|%%", name, 12, 5.5, 1234567890123LL, "ab", 4, 7);
+  strcpy(name, "second"); // strings are copied by the trace call
+  STRCMP_EQUAL("", buf);
+  CHECK(deferred_notify_count == 1);
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "world");
+  CHECK(deferred_notify_count == 1);
+
+  CHECK(mbed_trace_deferred_flush(1) == 1);
+  STRCMP_EQUAL("hello first 12 5.5 1234567890123    ab|7   |%", buf);
+  CHECK(mbed_trace_deferred_flush(0) == 1);
+  STRCMP_EQUAL("world", buf);
+  CHECK(mbed_trace_deferred_flush(0) == 0);
+
+  // notified again after flush, decorations are as configured at the trace call
+  mbed_trace_config_set(TRACE_ACTIVE_LEVEL_ALL);
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "again");
+  CHECK(deferred_notify_count == 2);
+  mbed_trace_config_set(TRACE_ACTIVE_LEVEL_ALL|TRACE_MODE_PLAIN);
+  CHECK(mbed_trace_deferred_flush(0) == 1);
+  STRCMP_EQUAL("[DBG ][mygr]: again", buf);
+  mbed_trace_config_set(TRACE_ACTIVE_LEVEL_ALL);
+
+  // filtered out traces are not stored
+  mbed_trace_config_set(TRACE_ACTIVE_LEVEL_INFO);
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "filtered");
+  CHECK(mbed_trace_deferred_flush(0) == 0);
+
+  // cmdline is printed immediately
+  mbed_tracef(TRACE_LEVEL_CMD, "mygr", "cmd %d", 1);
+  STRCMP_EQUAL("cmd 1", buf);
+
+  // disabling prints what is left
+  mbed_tracef(TRACE_LEVEL_INFO, "mygr", "last %u", 3u);
+  CHECK(mbed_trace_deferred_enable(0) == 0);
+  STRCMP_EQUAL("[INFO][mygr]: last 3", buf);
+  mbed_tracef(TRACE_LEVEL_INFO, "mygr", "sync");
+  STRCMP_EQUAL("[INFO][mygr]: sync", buf);
+  check_mutex_lock_status = true;
+}
+TEST(trace, deferred_full)
+{
+  check_mutex_lock_status = false;
+  CHECK(mbed_trace_deferred_enable(100) == -1);
+  CHECK(mbed_trace_deferred_enable(256) == 0);
+
+  for (int i = 0; i < 20; i++) {
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "line %d", i);
+  }
+  int dropped = mbed_trace_deferred_dropped();
+  CHECK(dropped > 0);
+  CHECK(mbed_trace_deferred_flush(0) == 20 - dropped);
+  char expected[32];
+  sprintf(expected, "line %d", 19 - dropped);
+  STRCMP_EQUAL(expected, buf);
+
+  // ring space is reused, records wrap around its end
+  for (int i = 0; i < 50; i++) {
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "wrap %d %s", i, "abcdefghij");
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "%c%c", 'o', 'k');
+    CHECK(mbed_trace_deferred_flush(1) == 1);
+    sprintf(expected, "wrap %d abcdefghij", i);
+    STRCMP_EQUAL(expected, buf);
+    CHECK(mbed_trace_deferred_flush(0) == 1);
+    STRCMP_EQUAL("ok", buf);
+  }
+  CHECK((int)mbed_trace_deferred_dropped() == dropped);
+
+  // long strings are cut to the record size
+  char longStr[300];
+  memset(longStr, 'x', sizeof(longStr) - 1);
+  longStr[sizeof(longStr) - 1] = 0;
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "%s", longStr);
+  CHECK(mbed_trace_deferred_flush(0) == 1);
+  CHECK(strlen(buf) > 64 && strlen(buf) < 128);
+
+  // helper results are copied before the tmp buffer is reused
+  static const unsigned char array[2] = { 0x23, 0x45 };
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "%s", mbed_trace_array(array, 2));
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "%s", mbed_trace_array(array + 1, 1));
+  CHECK(mbed_trace_deferred_flush(1) == 1);
+  STRCMP_EQUAL("23:45", buf);
+  CHECK(mbed_trace_deferred_flush(1) == 1);
+  STRCMP_EQUAL("45", buf);
+  check_mutex_lock_status = true;
+}
+
+static uint32_t binary_time_value = 0;
+uint32_t binary_time()
+{
+  return binary_time_value;
+}
+char* trace_time_prefix(uint32_t time, size_t length)
+{
+  static char str[16];
+  sprintf(str, "[%lu]", (unsigned long)time);
+  return str;
+}
+TEST(trace, time_prefix)
+{
+  mbed_trace_config_set(TRACE_ACTIVE_LEVEL_ALL);
+  mbed_trace_prefix_function_set(&trace_prefix);
+  mbed_trace_time_prefix_function_set(&trace_time_prefix);
+  mbed_trace_binary_time_function_set(binary_time);
+  binary_time_value = 100;
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "test %d", 1);
+  STRCMP_EQUAL("[100][DBG ][mygr]: test 1", buf);
+
+  // deferred lines have the time of the trace call, not of the flush
+  check_mutex_lock_status = false;
+  CHECK(mbed_trace_deferred_enable(1024) == 0);
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "first");
+  binary_time_value = 200;
+  mbed_tracef(TRACE_LEVEL_INFO, "mygr", "second");
+  binary_time_value = 300;
+  CHECK(mbed_trace_deferred_flush(1) == 1);
+  STRCMP_EQUAL("[100][DBG ][mygr]: first", buf);
+  CHECK(mbed_trace_deferred_flush(1) == 1);
+  STRCMP_EQUAL("[200][INFO][mygr]: second", buf);
+  CHECK(mbed_trace_deferred_enable(0) == 0);
+  check_mutex_lock_status = true;
+
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "sync");
+  STRCMP_EQUAL("[300][DBG ][mygr]: sync", buf);
+
+  // without it the prefix function is used again
+  mbed_trace_time_prefix_function_set(NULL);
+  mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "test");
+  STRCMP_EQUAL("[<TIME>][DBG ][mygr]: test", buf);
+}
+// remove escapes from binary frame in buf, return frame length
+static int binary_unescape(unsigned char *frame)
+{
+  int len = 0;
+  for (const unsigned char *p = (const unsigned char *)buf; *p; p++) {
+    if (*p == 0x1B) {
+      p++;
+      frame[len++] = *p ^ 0x20;
+    } else {
+      frame[len++] = *p;
+    }
+  }
+  return len;
+}
+static uint64_t binary_varint(const unsigned char **p)
+{
+  uint64_t value = 0;
+  int shift = 0;
+  do {
+    value |= (uint64_t)(**p & 0x7F) << shift;
+    shift += 7;
+  } while (*(*p)++ & 0x80);
+  return value;
+}
+static void binary_check_frame(uint8_t dlevel, uint32_t time, const char *grp, const char *fmt)
+{
+  unsigned char frame[128];
+  const unsigned char *p = frame;
+  int len = binary_unescape(frame);
+  double value;
+  uint64_t bits = 0;
+
+  CHECK(len > 0 && *p++ == 0x1F);
+  CHECK(*p++ == dlevel);
+  CHECK(binary_varint(&p) == time);
+  CHECK(binary_varint(&p) == (uintptr_t)fmt);
+  CHECK(binary_varint(&p) == (uintptr_t)grp);
+  CHECK(binary_varint(&p) == 3);  // -2 zigzag
+  CHECK(binary_varint(&p) == 0xFFFFFFFF);
+  STRCMP_EQUAL("a\nb", (const char *)p);
+  p += 4;
+  for (int i = 0; i < 8; i++) {
+    bits |= (uint64_t)*p++ << (8 * i);
+  }
+  memcpy(&value, &bits, sizeof(value));
+  CHECK(value == 2.5);
+  CHECK(p == frame + len);
+}
+TEST(trace, binary)
+{
+  static const char fmt[] = "v %d %u %s %.1f%%";
+  static const char grp[] = "mygr";
+
+  mbed_trace_binary_mode_set(true);
+  mbed_trace_binary_time_function_set(binary_time);
+  binary_time_value = 300;
+  mbed_tracef(TRACE_LEVEL_INFO, grp, fmt, -2, 0xFFFFFFFFu, "a\nb", 2.5);
+  CHECK(strchr(buf, '\n') == NULL);
+  binary_check_frame(TRACE_LEVEL_INFO, 300, grp, fmt);
+
+  // cmdline stays as text
+  mbed_tracef(TRACE_LEVEL_CMD, grp, "cmd %d", 1);
+  STRCMP_EQUAL("cmd 1", buf);
+
+  // frames are too long for the line, only complete arguments are sent
+  mbed_trace_buffer_sizes(20, 0);
+  mbed_tracef(TRACE_LEVEL_INFO, grp, "%s", "much too long for the line buffer");
+  CHECK(strlen(buf) < 20);
+  unsigned char frame[128];
+  const unsigned char *p = frame;
+  int len = binary_unescape(frame);
+  p += 2;
+  binary_varint(&p);
+  binary_varint(&p);
+  binary_varint(&p);
+  CHECK(p == frame + len);
+  mbed_trace_buffer_sizes(1024, 0);
+
+  // timestamp is taken when deferred trace is stored
+  check_mutex_lock_status = false;
+  CHECK(mbed_trace_deferred_enable(1024) == 0);
+  mbed_tracef(TRACE_LEVEL_WARN, grp, fmt, -2, 0xFFFFFFFFu, "a\nb", 2.5);
+  binary_time_value = 400;
+  CHECK(mbed_trace_deferred_flush(0) == 1);
+  binary_check_frame(TRACE_LEVEL_WARN, 300, grp, fmt);
+  CHECK(mbed_trace_deferred_enable(0) == 0);
+  check_mutex_lock_status = true;
+
+  mbed_trace_binary_mode_set(false);
+  mbed_tracef(TRACE_LEVEL_INFO, grp, "text");
+  STRCMP_EQUAL("text", buf);
+}
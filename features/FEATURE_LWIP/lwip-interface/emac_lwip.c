@@ -23,26 +23,145 @@
 #include "lwip/ip.h"
 #include "netif/etharp.h"
 #include "lwip/ethip6.h"
+#include "lwip/timeouts.h"
+#include "eth_arch.h"
+#include "platform/mbed_critical.h"
+
+/* Delay before posting receive buffers again when the pool is exhausted */
+#define EMAC_LWIP_RX_RETRY_MS   10
+
+/* Updated from the tcpip thread and the receive thread of the driver,
+ * with atomic operations */
+static emac_lwip_copy_stats_t emac_lwip_stats;
+static uint32_t emac_lwip_rx_outstanding;
+/* Set before the driver is powered up */
+static bool emac_lwip_rx_pool;
+static volatile bool emac_lwip_rx_retry;
+
+static void emac_lwip_rx_refill(struct netif *netif);
+
+static void emac_lwip_rx_retry_timeout(void *arg)
+{
+    emac_lwip_rx_retry = false;
+    emac_lwip_rx_refill((struct netif *)arg);
+}
+
+static void emac_lwip_rx_retry_start(void *arg)
+{
+    sys_timeout(EMAC_LWIP_RX_RETRY_MS, emac_lwip_rx_retry_timeout, arg);
+}
+
+/* Keeps the receive ring of the driver filled with pool buffers */
+static void emac_lwip_rx_refill(struct netif *netif)
+{
+    emac_interface_t *mac = (emac_interface_t *)netif->state;
+    uint32_t size = netif->mtu + SIZEOF_ETH_HDR;
+
+    while (true) {
+        emac_stack_mem_chain_t *chain = emac_stack_mem_pool_alloc(NULL, size);
+        if (!chain) {
+            /* Buffers are held by the stack, if the driver has none left
+             * retry once some are freed, otherwise the next frame does */
+            if (!emac_lwip_rx_outstanding && !emac_lwip_rx_retry) {
+                emac_lwip_rx_retry = true;
+                if (tcpip_callback_with_block(emac_lwip_rx_retry_start, netif, 0) != ERR_OK) {
+                    emac_lwip_rx_retry = false;
+                }
+            }
+            return;
+        }
+
+        if (!mac->ops.rx_post(mac, chain)) {
+            emac_stack_mem_free(NULL, chain);
+            return;
+        }
+        core_util_atomic_incr_u32(&emac_lwip_rx_outstanding, 1);
+        core_util_atomic_incr_u32(&emac_lwip_stats.rx_posted, 1);
+    }
+}
 
 static err_t emac_lwip_low_level_output(struct netif *netif, struct pbuf *p)
 {
     emac_interface_t *mac = (emac_interface_t *)netif->state;
-    bool ret = mac->ops.link_out(mac, (emac_stack_mem_t *)p);
+    bool ret;
+
+    core_util_atomic_incr_u32(&emac_lwip_stats.tx_frames, 1);
+    if (mac->ops.link_out_chain) {
+        /* Driver gathers the pbuf chain itself, no copy needed */
+        ret = mac->ops.link_out_chain(mac, (emac_stack_mem_chain_t *)p);
+    } else {
+        if (p->next) {
+            /* A single buffer driver copies the segments into one */
+            core_util_atomic_incr_u32(&emac_lwip_stats.tx_gathered, 1);
+        }
+        ret = mac->ops.link_out(mac, (emac_stack_mem_t *)p);
+    }
 
     return ret ? ERR_OK : ERR_IF;
 }
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+static u16_t emac_lwip_checksum_flags(uint32_t caps)
+{
+    u16_t flags = NETIF_CHECKSUM_ENABLE_ALL;
+
+    /* Skip software checksums the hardware already takes care of */
+    if (caps & EMAC_CAP_TX_CHECKSUM_IP) {
+        flags &= ~NETIF_CHECKSUM_GEN_IP;
+    }
+    if (caps & EMAC_CAP_TX_CHECKSUM_UDP) {
+        flags &= ~NETIF_CHECKSUM_GEN_UDP;
+    }
+    if (caps & EMAC_CAP_TX_CHECKSUM_TCP) {
+        flags &= ~NETIF_CHECKSUM_GEN_TCP;
+    }
+    if (caps & EMAC_CAP_TX_CHECKSUM_ICMP) {
+        flags &= ~(NETIF_CHECKSUM_GEN_ICMP | NETIF_CHECKSUM_GEN_ICMP6);
+    }
+    if (caps & EMAC_CAP_RX_CHECKSUM_IP) {
+        flags &= ~NETIF_CHECKSUM_CHECK_IP;
+    }
+    if (caps & EMAC_CAP_RX_CHECKSUM_UDP) {
+        flags &= ~NETIF_CHECKSUM_CHECK_UDP;
+    }
+    if (caps & EMAC_CAP_RX_CHECKSUM_TCP) {
+        flags &= ~NETIF_CHECKSUM_CHECK_TCP;
+    }
+    if (caps & EMAC_CAP_RX_CHECKSUM_ICMP) {
+        flags &= ~(NETIF_CHECKSUM_CHECK_ICMP | NETIF_CHECKSUM_CHECK_ICMP6);
+    }
+
+    return flags;
+}
+#endif /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+
 static void emac_lwip_input(void *data, emac_stack_t *buf)
 {
     struct pbuf *p = (struct pbuf *)buf;
     struct netif *netif = (struct netif *)data;
 
+    core_util_atomic_incr_u32(&emac_lwip_stats.rx_frames, 1);
+    if (p->type != PBUF_POOL) {
+        /* Not received in place, the driver copied it from its own memory */
+        core_util_atomic_incr_u32(&emac_lwip_stats.rx_copied, 1);
+    } else {
+        uint32_t outstanding = emac_lwip_rx_outstanding;
+        while (outstanding &&
+               !core_util_atomic_cas_u32(&emac_lwip_rx_outstanding, &outstanding, outstanding - 1)) {
+        }
+    }
+
     /* pass all packets to ethernet_input, which decides what packets it supports */
     if (netif->input(p, netif) != ERR_OK) {
         LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: IP input error\n"));
 
         pbuf_free(p);
     }
+
+    /* Replace the buffer the frame was received in */
+    if (emac_lwip_rx_pool) {
+        emac_lwip_rx_refill(netif);
+    }
 }
 
 static void emac_lwip_state_change(void *data, bool up)
@@ -61,6 +180,11 @@ err_t emac_lwip_if_init(struct netif *netif)
     int err = ERR_OK;
     emac_interface_t *mac = (emac_interface_t *)netif->state;
 
+    /* Receive in place into pool buffers posted to the driver */
+    emac_lwip_rx_pool = mac->ops.get_capabilities && mac->ops.rx_post &&
+                        (mac->ops.get_capabilities(mac) & EMAC_CAP_RX_POOL);
+    emac_lwip_rx_outstanding = 0;
+
     mac->ops.set_link_input_cb(mac, emac_lwip_input, netif);
     mac->ops.set_link_state_cb(mac, emac_lwip_state_change, netif);
 
@@ -77,6 +201,16 @@ err_t emac_lwip_if_init(struct netif *netif)
 
     mac->ops.get_ifname(mac, netif->name, 2);
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    if (mac->ops.get_capabilities) {
+        NETIF_SET_CHECKSUM_CTRL(netif, emac_lwip_checksum_flags(mac->ops.get_capabilities(mac)));
+    }
+#endif /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+
+    if (emac_lwip_rx_pool && err == ERR_OK) {
+        emac_lwip_rx_refill(netif);
+    }
+
 #if LWIP_IPV4
     netif->output = etharp_output;
 #endif /* LWIP_IPV4 */
@@ -89,4 +223,9 @@ err_t emac_lwip_if_init(struct netif *netif)
     return err;
 }
 
+void emac_lwip_get_copy_stats(emac_lwip_copy_stats_t *stats)
+{
+    *stats = emac_lwip_stats;
+}
+
 #endif /* DEVICE_EMAC */
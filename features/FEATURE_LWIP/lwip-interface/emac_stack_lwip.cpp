@@ -83,6 +83,26 @@ uint32_t emac_stack_mem_chain_len(emac_stack_t* stack, emac_stack_mem_chain_t *c
     return ((struct pbuf*)chain)->tot_len;
 }
 
+emac_stack_mem_t *emac_stack_mem_chain_next(emac_stack_t* stack, emac_stack_mem_t *mem)
+{
+    return (emac_stack_mem_t *)((struct pbuf*)mem)->next;
+}
+
+emac_stack_mem_chain_t *emac_stack_mem_pool_alloc(emac_stack_t* stack, uint32_t size)
+{
+    return (emac_stack_mem_chain_t *)pbuf_alloc(PBUF_RAW, size, PBUF_POOL);
+}
+
+void emac_stack_mem_chain_set_len(emac_stack_t* stack, emac_stack_mem_chain_t *chain, uint32_t len)
+{
+    pbuf_realloc((struct pbuf*)chain, len);
+}
+
+uint32_t emac_stack_mem_pool_unit_size(emac_stack_t* stack)
+{
+    return PBUF_POOL_BUFSIZE;
+}
+
 void emac_stack_mem_ref(emac_stack_t* stack, emac_stack_mem_t *mem)
 {
     pbuf_ref((struct pbuf*)mem);
@@ -32,6 +32,17 @@ extern "C" {
 #if DEVICE_EMAC
 err_t emac_lwip_if_init(struct netif *netif);
 
+/** Frames copied on their way between the stack and the EMAC driver */
+typedef struct emac_lwip_copy_stats {
+    uint32_t tx_frames;     /**< Frames handed to the driver */
+    uint32_t tx_gathered;   /**< Chained frames handed to link_out, copied into one buffer by the driver */
+    uint32_t rx_frames;     /**< Frames received from the driver */
+    uint32_t rx_copied;     /**< Frames not received in place in stack pool buffers */
+    uint32_t rx_posted;     /**< Pool buffer chains posted to the driver */
+} emac_lwip_copy_stats_t;
+
+void emac_lwip_get_copy_stats(emac_lwip_copy_stats_t *stats);
+
 #else /* DEVICE_EMAC */
 void eth_arch_enable_interrupts(void);
 void eth_arch_disable_interrupts(void);
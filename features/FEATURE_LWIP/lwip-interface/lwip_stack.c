@@ -29,7 +29,10 @@
 #include "lwip/netif.h"
 #include "lwip/dhcp.h"
 #include "lwip/tcpip.h"
+#include "lwip/priv/tcpip_priv.h"
 #include "lwip/tcp.h"
+#include "lwip/priv/tcp_priv.h"
+#include "lwip/stats.h"
 #include "lwip/ip.h"
 #include "lwip/mld6.h"
 #include "lwip/igmp.h"
@@ -48,6 +51,12 @@ static nsapi_error_t mbed_lwip_err_remap(err_t err);
     #define MBED_NETIF_INIT_FN eth_arch_enetif_init
 #endif
 
+#if MBED_CONF_LWIP_STATS_ENABLED
+    #define MBED_NETIF_INPUT_FN mbed_lwip_stats_input
+#else
+    #define MBED_NETIF_INPUT_FN tcpip_input
+#endif
+
 #ifndef LWIP_SOCKET_MAX_MEMBERSHIPS
     #define LWIP_SOCKET_MAX_MEMBERSHIPS 4
 #endif
@@ -60,6 +69,30 @@ static struct lwip_socket {
     struct netbuf *buf;
     u16_t offset;
 
+    // Number of datagrams queued in the netconn recvmbox
+    s16_t rcvevent;
+
+#if MBED_CONF_LWIP_STATS_ENABLED
+    u32_t tx_bytes;
+    u32_t rx_bytes;
+#endif
+
+#if LWIP_TCP
+    // Buffer sizes granted to this socket, and how much of the pcb's
+    // TCP_SND_BUF / maximum window is held back to enforce them
+    u32_t sndbuf;
+    u32_t rcvbuf;
+    u32_t snd_withheld;
+    u32_t rcv_withheld;
+    bool sndbuf_pinned;
+    bool rcvbuf_pinned;
+#if MBED_CONF_LWIP_TCP_AUTOTUNE_ENABLED
+    bool snd_stalled;
+    u32_t rcv_count;
+    u8_t idle_ticks;
+#endif
+#endif
+
     void (*cb)(void *);
     void *data;
 
@@ -141,15 +174,283 @@ static void mbed_lwip_socket_callback(struct netconn *nc, enum netconn_evt eh, u
 
     for (int i = 0; i < MEMP_NUM_NETCONN; i++) {
         if (lwip_arena[i].in_use
-            && lwip_arena[i].conn == nc
-            && lwip_arena[i].cb) {
-            lwip_arena[i].cb(lwip_arena[i].data);
+            && lwip_arena[i].conn == nc) {
+            if (eh == NETCONN_EVT_RCVPLUS) {
+                lwip_arena[i].rcvevent++;
+            } else if (eh == NETCONN_EVT_RCVMINUS) {
+                lwip_arena[i].rcvevent--;
+            }
+
+            if (lwip_arena[i].cb) {
+                lwip_arena[i].cb(lwip_arena[i].data);
+            }
         }
     }
 
     sys_arch_unprotect(prot);
 }
 
+#if LWIP_TCP
+/* TCP buffer sizing
+ *
+ * Every pcb is created with TCP_SND_BUF of send space and a TCP_WND
+ * window. A smaller per-socket size is enforced by holding back the
+ * difference from the pcb's snd_buf and rcv_wnd, and handing it back
+ * when the socket grows or closes, so lwIP's own accounting is kept.
+ *
+ * With tcp-autotune-enabled, sockets start from the lwIP default sizes
+ * and an arbiter running on the tcpip thread periodically grows sockets
+ * that are stalled on the send buffer or filling their window, and
+ * shrinks sockets that have been idle, keeping the total granted within
+ * tcp-buf-budget.
+ */
+#define LWIP_TCP_BUF_MIN            TCP_MSS
+
+#if MBED_CONF_LWIP_TCP_AUTOTUNE_ENABLED
+#define LWIP_TCP_SNDBUF_DEFAULT     LWIP_MIN(2 * TCP_MSS, TCP_SND_BUF)
+#define LWIP_TCP_RCVBUF_DEFAULT     LWIP_MIN(4 * TCP_MSS, TCP_WND)
+
+#ifdef MBED_CONF_LWIP_TCP_BUF_BUDGET
+#define LWIP_TCP_BUF_BUDGET         MBED_CONF_LWIP_TCP_BUF_BUDGET
+#else
+#define LWIP_TCP_BUF_BUDGET         (MEMP_NUM_TCP_PCB * (LWIP_TCP_SNDBUF_DEFAULT + LWIP_TCP_RCVBUF_DEFAULT))
+#endif
+
+// Number of arbiter passes without traffic before a socket is shrunk
+#define LWIP_TCP_IDLE_TICKS         4
+
+// Budget not granted to any socket. Only touched with the core locked.
+static s32_t lwip_tcp_buf_free = LWIP_TCP_BUF_BUDGET;
+static bool lwip_tcp_arbiter_running = false;
+
+static void mbed_lwip_tcp_arbiter(void *arg);
+#else
+#define LWIP_TCP_SNDBUF_DEFAULT     TCP_SND_BUF
+#define LWIP_TCP_RCVBUF_DEFAULT     TCP_WND
+#endif
+
+static bool mbed_lwip_is_tcp(const struct lwip_socket *s)
+{
+    return NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP;
+}
+
+// Bring the pcb in line with the socket's granted sizes. Call with the core locked.
+static void mbed_lwip_tcp_buf_apply(struct lwip_socket *s)
+{
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    if (!pcb || pcb->state == LISTEN) {
+        return;
+    }
+
+    u32_t snd_target = TCP_SND_BUF - s->sndbuf;
+    if (s->snd_withheld < snd_target) {
+        // Data in flight returns to snd_buf as it is acked, so take what
+        // is free now and the rest on a later pass
+        u32_t take = LWIP_MIN(pcb->snd_buf, snd_target - s->snd_withheld);
+        pcb->snd_buf -= take;
+        s->snd_withheld += take;
+    } else if (s->snd_withheld > snd_target) {
+        pcb->snd_buf += s->snd_withheld - snd_target;
+        s->snd_withheld = snd_target;
+    }
+
+    // The window must be untouched while the SYN is processed (it may be
+    // rescaled then), so only limit it once the connection is up
+    if (pcb->state != ESTABLISHED) {
+        return;
+    }
+
+    u32_t wnd_max = TCP_WND_MAX(pcb);
+    u32_t rcv_target = wnd_max > s->rcvbuf ? wnd_max - s->rcvbuf : 0;
+    if (s->rcv_withheld < rcv_target) {
+        u32_t take = LWIP_MIN(pcb->rcv_wnd, rcv_target - s->rcv_withheld);
+        pcb->rcv_wnd -= take;
+        s->rcv_withheld += take;
+    } else if (s->rcv_withheld > rcv_target) {
+        pcb->rcv_wnd += s->rcv_withheld - rcv_target;
+        s->rcv_withheld = rcv_target;
+        // Announce the larger window now rather than on the next segment
+        tcp_recved(pcb, 0);
+    }
+}
+
+// Grant the default buffers to a newly opened or accepted TCP socket
+static void mbed_lwip_tcp_buf_init(struct lwip_socket *s)
+{
+    LOCK_TCPIP_CORE();
+#if MBED_CONF_LWIP_TCP_AUTOTUNE_ENABLED
+    // A new socket always gets at least the minimum, even if that
+    // briefly overcommits the budget; idle sockets pay it back
+    u32_t avail = lwip_tcp_buf_free > 0 ? (u32_t)lwip_tcp_buf_free : 0;
+    s->sndbuf = LWIP_MAX(LWIP_MIN(LWIP_TCP_SNDBUF_DEFAULT, avail / 3), LWIP_TCP_BUF_MIN);
+    s->rcvbuf = LWIP_MAX(LWIP_MIN(LWIP_TCP_RCVBUF_DEFAULT, avail - avail / 3), LWIP_TCP_BUF_MIN);
+    lwip_tcp_buf_free -= s->sndbuf + s->rcvbuf;
+
+    if (!lwip_tcp_arbiter_running) {
+        lwip_tcp_arbiter_running = true;
+        sys_timeout(MBED_CONF_LWIP_TCP_AUTOTUNE_INTERVAL, mbed_lwip_tcp_arbiter, NULL);
+    }
+#else
+    s->sndbuf = LWIP_TCP_SNDBUF_DEFAULT;
+    s->rcvbuf = LWIP_TCP_RCVBUF_DEFAULT;
+#endif
+    mbed_lwip_tcp_buf_apply(s);
+    UNLOCK_TCPIP_CORE();
+}
+
+// Hand withheld space back to the pcb and the socket's grant back to the
+// budget. The pcb must have its full window before it is closed, or lwIP
+// treats it as holding unread data and resets the connection.
+static void mbed_lwip_tcp_buf_release(struct lwip_socket *s)
+{
+    LOCK_TCPIP_CORE();
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    if (pcb && pcb->state != LISTEN) {
+        pcb->snd_buf += s->snd_withheld;
+        pcb->rcv_wnd += s->rcv_withheld;
+    }
+    s->snd_withheld = 0;
+    s->rcv_withheld = 0;
+
+#if MBED_CONF_LWIP_TCP_AUTOTUNE_ENABLED
+    lwip_tcp_buf_free += s->sndbuf + s->rcvbuf;
+#endif
+    s->sndbuf = 0;
+    s->rcvbuf = 0;
+    UNLOCK_TCPIP_CORE();
+}
+
+static nsapi_error_t mbed_lwip_tcp_buf_resize(struct lwip_socket *s, bool snd, int size)
+{
+    u32_t *buf = snd ? &s->sndbuf : &s->rcvbuf;
+    bool *pinned = snd ? &s->sndbuf_pinned : &s->rcvbuf_pinned;
+    u32_t max = snd ? TCP_SND_BUF : TCP_WND;
+
+    if (size < 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    LOCK_TCPIP_CORE();
+
+    // Listening sockets carry no data and hold no buffers
+    if (!s->conn->pcb.tcp || s->conn->pcb.tcp->state == LISTEN) {
+        UNLOCK_TCPIP_CORE();
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    // Size 0 hands the socket back to the defaults (or the arbiter)
+    u32_t new_size = size ? (u32_t)size : (snd ? LWIP_TCP_SNDBUF_DEFAULT : LWIP_TCP_RCVBUF_DEFAULT);
+    new_size = LWIP_MIN(LWIP_MAX(new_size, LWIP_TCP_BUF_MIN), max);
+
+#if MBED_CONF_LWIP_TCP_AUTOTUNE_ENABLED
+    s32_t delta = (s32_t)new_size - (s32_t)*buf;
+    if (delta > 0 && delta > lwip_tcp_buf_free) {
+        UNLOCK_TCPIP_CORE();
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    lwip_tcp_buf_free -= delta;
+#endif
+
+    *buf = new_size;
+    *pinned = size != 0;
+    mbed_lwip_tcp_buf_apply(s);
+    UNLOCK_TCPIP_CORE();
+
+    return 0;
+}
+
+#if MBED_CONF_LWIP_TCP_AUTOTUNE_ENABLED
+// Runs on the tcpip thread
+static void mbed_lwip_tcp_arbiter(void *arg)
+{
+    int active = 0;
+
+    // Shrink idle sockets first, so the budget they free can go to busy ones
+    for (int i = 0; i < MEMP_NUM_NETCONN; i++) {
+        struct lwip_socket *s = &lwip_arena[i];
+        if (!s->in_use || !s->sndbuf || !mbed_lwip_is_tcp(s) || !s->conn->pcb.tcp) {
+            continue;
+        }
+
+        struct tcp_pcb *pcb = s->conn->pcb.tcp;
+        active++;
+
+        bool idle = !s->snd_stalled && !s->rcv_count && !pcb->unsent && !pcb->unacked;
+        if (!idle) {
+            s->idle_ticks = 0;
+            continue;
+        }
+
+        if (s->idle_ticks < LWIP_TCP_IDLE_TICKS) {
+            s->idle_ticks++;
+            continue;
+        }
+
+        if (!s->sndbuf_pinned && s->sndbuf > LWIP_TCP_BUF_MIN) {
+            u32_t shrink = s->sndbuf - LWIP_MAX(s->sndbuf / 2, LWIP_TCP_BUF_MIN);
+            s->sndbuf -= shrink;
+            lwip_tcp_buf_free += shrink;
+        }
+
+        if (!s->rcvbuf_pinned && s->rcvbuf > LWIP_TCP_BUF_MIN) {
+            u32_t shrink = s->rcvbuf - LWIP_MAX(s->rcvbuf / 2, LWIP_TCP_BUF_MIN);
+            s->rcvbuf -= shrink;
+            lwip_tcp_buf_free += shrink;
+        }
+
+        mbed_lwip_tcp_buf_apply(s);
+    }
+
+    // Grow busy sockets by doubling, as far as the budget allows
+    for (int i = 0; i < MEMP_NUM_NETCONN; i++) {
+        struct lwip_socket *s = &lwip_arena[i];
+        if (!s->in_use || !s->sndbuf || !mbed_lwip_is_tcp(s) || !s->conn->pcb.tcp) {
+            continue;
+        }
+
+        struct tcp_pcb *pcb = s->conn->pcb.tcp;
+        bool grew_snd = false;
+
+        if (s->snd_stalled && !s->sndbuf_pinned && lwip_tcp_buf_free > 0) {
+            u32_t grow = LWIP_MIN(LWIP_MIN(s->sndbuf, TCP_SND_BUF - s->sndbuf), (u32_t)lwip_tcp_buf_free);
+            s->sndbuf += grow;
+            lwip_tcp_buf_free -= grow;
+            grew_snd = grow > 0;
+        }
+
+        // Reading half the window in one period suggests the window, not
+        // the application, is what limits throughput
+        if (s->rcv_count >= s->rcvbuf / 2 && !s->rcvbuf_pinned && lwip_tcp_buf_free > 0) {
+            u32_t wnd_max = TCP_WND_MAX(pcb);
+            u32_t grow = s->rcvbuf < wnd_max ? LWIP_MIN(s->rcvbuf, wnd_max - s->rcvbuf) : 0;
+            grow = LWIP_MIN(grow, (u32_t)lwip_tcp_buf_free);
+            s->rcvbuf += grow;
+            lwip_tcp_buf_free -= grow;
+        }
+
+        mbed_lwip_tcp_buf_apply(s);
+        s->snd_stalled = false;
+        s->rcv_count = 0;
+
+        // A writer blocked on the old limit will not hear from lwIP until
+        // data is acked, so tell it about the new space now
+        if (grew_snd) {
+            sys_prot_t prot = sys_arch_protect();
+            if (s->cb) {
+                s->cb(s->data);
+            }
+            sys_arch_unprotect(prot);
+        }
+    }
+
+    if (active) {
+        sys_timeout(MBED_CONF_LWIP_TCP_AUTOTUNE_INTERVAL, mbed_lwip_tcp_arbiter, NULL);
+    } else {
+        lwip_tcp_arbiter_running = false;
+    }
+}
+#endif
+#endif
 
 /* TCP/IP and Network Interface Initialisation */
 static struct netif lwip_netif;
@@ -685,6 +986,40 @@ static void mbed_lwip_core_init(void)
     }
 }
 
+#if MBED_CONF_LWIP_STATS_ENABLED
+static nsapi_interface_stats_t lwip_netif_stats;
+static netif_linkoutput_fn lwip_netif_linkoutput;
+
+static err_t mbed_lwip_stats_input(struct pbuf *p, struct netif *netif)
+{
+    // p belongs to the stack once it has been accepted
+    u16_t len = p->tot_len;
+
+    err_t err = tcpip_input(p, netif);
+    if (err == ERR_OK) {
+        lwip_netif_stats.rx_packets++;
+        lwip_netif_stats.rx_bytes += len;
+    } else {
+        lwip_netif_stats.rx_drops++;
+    }
+
+    return err;
+}
+
+static err_t mbed_lwip_stats_linkoutput(struct netif *netif, struct pbuf *p)
+{
+    err_t err = lwip_netif_linkoutput(netif, p);
+    if (err == ERR_OK) {
+        lwip_netif_stats.tx_packets++;
+        lwip_netif_stats.tx_bytes += p->tot_len;
+    } else {
+        lwip_netif_stats.tx_drops++;
+    }
+
+    return err;
+}
+#endif
+
 nsapi_error_t mbed_lwip_emac_init(emac_interface_t *emac)
 {
 #if LWIP_ETHERNET
@@ -695,9 +1030,14 @@ nsapi_error_t mbed_lwip_emac_init(emac_interface_t *emac)
 #if LWIP_IPV4
                    0, 0, 0,
 #endif
-                   emac, MBED_NETIF_INIT_FN, tcpip_input)) {
+                   emac, MBED_NETIF_INIT_FN, MBED_NETIF_INPUT_FN)) {
         return NSAPI_ERROR_DEVICE_ERROR;
     }
+#if MBED_CONF_LWIP_STATS_ENABLED
+    // Count frames on their way to the driver
+    lwip_netif_linkoutput = lwip_netif.linkoutput;
+    lwip_netif.linkoutput = mbed_lwip_stats_linkoutput;
+#endif
     // Note the MAC address actually in use
     mbed_lwip_record_mac_address(&lwip_netif);
 #if !DEVICE_EMAC
@@ -1104,6 +1444,11 @@ static nsapi_error_t mbed_lwip_socket_open(nsapi_stack_t *stack, nsapi_socket_t
     }
 
     netconn_set_recvtimeout(s->conn, 1);
+#if LWIP_TCP
+    if (proto == NSAPI_TCP) {
+        mbed_lwip_tcp_buf_init(s);
+    }
+#endif
     *(struct lwip_socket **)handle = s;
     return 0;
 }
@@ -1112,6 +1457,12 @@ static nsapi_error_t mbed_lwip_socket_close(nsapi_stack_t *stack, nsapi_socket_t
 {
     struct lwip_socket *s = (struct lwip_socket *)handle;
 
+#if LWIP_TCP
+    if (mbed_lwip_is_tcp(s)) {
+        mbed_lwip_tcp_buf_release(s);
+    }
+#endif
+
     netbuf_delete(s->buf);
     err_t err = netconn_delete(s->conn);
     mbed_lwip_arena_dealloc(s);
@@ -1152,6 +1503,11 @@ static nsapi_error_t mbed_lwip_socket_listen(nsapi_stack_t *stack, nsapi_socket_
     }
 
     err_t err = netconn_listen_with_backlog(s->conn, backlog);
+#if LWIP_TCP
+    if (err == ERR_OK) {
+        mbed_lwip_tcp_buf_release(s);
+    }
+#endif
     return mbed_lwip_err_remap(err);
 }
 
@@ -1168,6 +1524,15 @@ static nsapi_error_t mbed_lwip_socket_connect(nsapi_stack_t *stack, nsapi_socket
     err_t err = netconn_connect(s->conn, &ip_addr, port);
     netconn_set_nonblocking(s->conn, true);
 
+#if LWIP_TCP
+    // Now established, so the receive window can be limited too
+    if (err == ERR_OK && mbed_lwip_is_tcp(s)) {
+        LOCK_TCPIP_CORE();
+        mbed_lwip_tcp_buf_apply(s);
+        UNLOCK_TCPIP_CORE();
+    }
+#endif
+
     return mbed_lwip_err_remap(err);
 }
 
@@ -1190,6 +1555,9 @@ static nsapi_error_t mbed_lwip_socket_accept(nsapi_stack_t *stack, nsapi_socket_
     }
 
     netconn_set_recvtimeout(ns->conn, 1);
+#if LWIP_TCP
+    mbed_lwip_tcp_buf_init(ns);
+#endif
     *(struct lwip_socket **)handle = ns;
 
     ip_addr_t peer_addr;
@@ -1207,10 +1575,19 @@ static nsapi_size_or_error_t mbed_lwip_socket_send(nsapi_stack_t *stack, nsapi_s
     size_t bytes_written = 0;
 
     err_t err = netconn_write_partly(s->conn, data, size, NETCONN_COPY, &bytes_written);
+#if MBED_CONF_LWIP_TCP_AUTOTUNE_ENABLED
+    if (err == ERR_WOULDBLOCK || bytes_written < size) {
+        s->snd_stalled = true;
+    }
+#endif
     if (err != ERR_OK) {
         return mbed_lwip_err_remap(err);
     }
 
+#if MBED_CONF_LWIP_STATS_ENABLED
+    s->tx_bytes += bytes_written;
+#endif
+
     return (nsapi_size_or_error_t)bytes_written;
 }
 
@@ -1229,6 +1606,12 @@ static nsapi_size_or_error_t mbed_lwip_socket_recv(nsapi_stack_t *stack, nsapi_s
 
     u16_t recv = netbuf_copy_partial(s->buf, data, (u16_t)size, s->offset);
     s->offset += recv;
+#if MBED_CONF_LWIP_TCP_AUTOTUNE_ENABLED
+    s->rcv_count += recv;
+#endif
+#if MBED_CONF_LWIP_STATS_ENABLED
+    s->rx_bytes += recv;
+#endif
 
     if (s->offset >= netbuf_len(s->buf)) {
         netbuf_delete(s->buf);
@@ -1260,6 +1643,9 @@ static nsapi_size_or_error_t mbed_lwip_socket_sendto(nsapi_stack_t *stack, nsapi
         return mbed_lwip_err_remap(err);
     }
 
+#if MBED_CONF_LWIP_STATS_ENABLED
+    s->tx_bytes += size;
+#endif
     return size;
 }
 
@@ -1279,9 +1665,111 @@ static nsapi_size_or_error_t mbed_lwip_socket_recvfrom(nsapi_stack_t *stack, nsa
     u16_t recv = netbuf_copy(buf, data, (u16_t)size);
     netbuf_delete(buf);
 
+#if MBED_CONF_LWIP_STATS_ENABLED
+    s->rx_bytes += recv;
+#endif
     return recv;
 }
 
+/* Batched sendto, runs with the tcpip core locked */
+struct mbed_lwip_sendto_batch_call {
+    struct tcpip_api_call_data call;
+    struct lwip_socket *s;
+    nsapi_datagram_t *dgrams;
+    nsapi_size_t count;
+    nsapi_size_t sent;
+};
+
+static err_t mbed_lwip_do_sendto_batch(struct tcpip_api_call_data *call)
+{
+    struct mbed_lwip_sendto_batch_call *msg = (struct mbed_lwip_sendto_batch_call *)call;
+    struct udp_pcb *pcb = msg->s->conn->pcb.udp;
+
+    if (!pcb || NETCONNTYPE_GROUP(msg->s->conn->type) != NETCONN_UDP) {
+        return ERR_CONN;
+    }
+
+    for (msg->sent = 0; msg->sent < msg->count; msg->sent++) {
+        nsapi_datagram_t *dgram = &msg->dgrams[msg->sent];
+        ip_addr_t ip_addr;
+
+        if (!convert_mbed_addr_to_lwip(&ip_addr, &dgram->addr)) {
+            return ERR_ARG;
+        }
+
+        struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, 0, PBUF_REF);
+        if (!p) {
+            return ERR_MEM;
+        }
+
+        p->payload = dgram->data;
+        p->len = p->tot_len = (u16_t)dgram->size;
+
+        err_t err = udp_sendto(pcb, p, &ip_addr, dgram->port);
+        pbuf_free(p);
+        if (err != ERR_OK) {
+            return err;
+        }
+
+        dgram->len = dgram->size;
+#if MBED_CONF_LWIP_STATS_ENABLED
+        msg->s->tx_bytes += dgram->size;
+#endif
+    }
+
+    return ERR_OK;
+}
+
+static nsapi_size_or_error_t mbed_lwip_socket_sendto_batch(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_datagram_t *dgrams, nsapi_size_t count)
+{
+    struct mbed_lwip_sendto_batch_call msg;
+    msg.s = (struct lwip_socket *)handle;
+    msg.dgrams = dgrams;
+    msg.count = count;
+    msg.sent = 0;
+
+    // A single core lock or tcpip message covers the whole batch
+    err_t err = tcpip_api_call(mbed_lwip_do_sendto_batch, &msg.call);
+    if (err != ERR_OK && msg.sent == 0) {
+        return mbed_lwip_err_remap(err);
+    }
+
+    return msg.sent;
+}
+
+static nsapi_size_or_error_t mbed_lwip_socket_recvfrom_batch(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_datagram_t *dgrams, nsapi_size_t count)
+{
+    struct lwip_socket *s = (struct lwip_socket *)handle;
+    nsapi_size_t i;
+
+    for (i = 0; i < count; i++) {
+        // Only wait on the recvmbox for the first datagram, after that
+        // stop as soon as nothing more is queued
+        if (i > 0 && s->rcvevent <= 0) {
+            break;
+        }
+
+        struct netbuf *buf;
+        err_t err = netconn_recv(s->conn, &buf);
+        if (err != ERR_OK) {
+            if (i == 0) {
+                return mbed_lwip_err_remap(err);
+            }
+            break;
+        }
+
+        convert_lwip_addr_to_mbed(&dgrams[i].addr, netbuf_fromaddr(buf));
+        dgrams[i].port = netbuf_fromport(buf);
+        dgrams[i].len = netbuf_copy(buf, dgrams[i].data, (u16_t)dgrams[i].size);
+        netbuf_delete(buf);
+#if MBED_CONF_LWIP_STATS_ENABLED
+        s->rx_bytes += dgrams[i].len;
+#endif
+    }
+
+    return i;
+}
+
 static int32_t find_multicast_member(const struct lwip_socket *s, const nsapi_ip_mreq_t *imr) {
     uint32_t count = 0;
     uint32_t index = 0;
@@ -1329,6 +1817,14 @@ static nsapi_error_t mbed_lwip_setsockopt(nsapi_stack_t *stack, nsapi_socket_t h
 
             s->conn->pcb.tcp->keep_intvl = *(int*)optval;
             return 0;
+
+        case NSAPI_SNDBUF:
+        case NSAPI_RCVBUF:
+            if (optlen != sizeof(int) || !mbed_lwip_is_tcp(s)) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            return mbed_lwip_tcp_buf_resize(s, optname == NSAPI_SNDBUF, *(const int *)optval);
 #endif
 
         case NSAPI_REUSEADDR:
@@ -1445,6 +1941,92 @@ static nsapi_error_t mbed_lwip_setsockopt(nsapi_stack_t *stack, nsapi_socket_t h
     }
 }
 
+static nsapi_error_t mbed_lwip_getsockopt(nsapi_stack_t *stack, nsapi_socket_t handle, int level, int optname, void *optval, unsigned *optlen)
+{
+    struct lwip_socket *s = (struct lwip_socket *)handle;
+
+    if (level != NSAPI_SOCKET) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    switch (optname) {
+#if MBED_CONF_LWIP_STATS_ENABLED
+        case NSAPI_SOCKET_STATS: {
+            if (*optlen < sizeof(nsapi_socket_stats_t)) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+            nsapi_socket_stats_t *stats = optval;
+            memset(stats, 0, sizeof *stats);
+            stats->tx_bytes = s->tx_bytes;
+            stats->rx_bytes = s->rx_bytes;
+
+#if LWIP_TCP
+            LOCK_TCPIP_CORE();
+            struct tcp_pcb *pcb = s->conn->pcb.tcp;
+            if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP && pcb && pcb->state != LISTEN) {
+                // sa holds the smoothed RTT in slow timer ticks, scaled by 8
+                stats->rtt_ms = (pcb->sa >> 3) * TCP_SLOW_INTERVAL;
+                stats->retransmits = pcb->nrtx;
+                stats->sndbuf_size = s->sndbuf;
+                stats->sndbuf_used = TCP_SND_BUF - s->snd_withheld - pcb->snd_buf;
+            }
+            UNLOCK_TCPIP_CORE();
+#endif
+
+            *optlen = sizeof *stats;
+            return 0;
+        }
+#endif
+
+#if LWIP_TCP
+        case NSAPI_SNDBUF:
+        case NSAPI_RCVBUF:
+            if (*optlen < sizeof(int) || !mbed_lwip_is_tcp(s)) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            *(int *)optval = optname == NSAPI_SNDBUF ? s->sndbuf : s->rcvbuf;
+            *optlen = sizeof(int);
+            return 0;
+#endif
+
+        default:
+            return NSAPI_ERROR_UNSUPPORTED;
+    }
+}
+
+static nsapi_error_t mbed_lwip_getstackopt(nsapi_stack_t *stack, int level, int optname, void *optval, unsigned *optlen)
+{
+    if (level != NSAPI_STACK) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    switch (optname) {
+#if MBED_CONF_LWIP_STATS_ENABLED
+        case NSAPI_INTERFACE_STATS: {
+            if (*optlen < sizeof(nsapi_interface_stats_t)) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+            nsapi_interface_stats_t *stats = optval;
+            sys_prot_t prot = sys_arch_protect();
+            *stats = lwip_netif_stats;
+#if MEMP_STATS
+            stats->buffer_exhausted = lwip_stats.memp[MEMP_PBUF_POOL]->err;
+#endif
+            sys_arch_unprotect(prot);
+
+            *optlen = sizeof *stats;
+            return 0;
+        }
+#endif
+
+        default:
+            return NSAPI_ERROR_UNSUPPORTED;
+    }
+}
+
 static void mbed_lwip_socket_attach(nsapi_stack_t *stack, nsapi_socket_t handle, void (*callback)(void *), void *data)
 {
     struct lwip_socket *s = (struct lwip_socket *)handle;
@@ -1457,6 +2039,7 @@ static void mbed_lwip_socket_attach(nsapi_stack_t *stack, nsapi_socket_t handle,
 const nsapi_stack_api_t lwip_stack_api = {
     .gethostbyname      = mbed_lwip_gethostbyname,
     .add_dns_server     = mbed_lwip_add_dns_server,
+    .getstackopt        = mbed_lwip_getstackopt,
     .socket_open        = mbed_lwip_socket_open,
     .socket_close       = mbed_lwip_socket_close,
     .socket_bind        = mbed_lwip_socket_bind,
@@ -1468,7 +2051,10 @@ const nsapi_stack_api_t lwip_stack_api = {
     .socket_sendto      = mbed_lwip_socket_sendto,
     .socket_recvfrom    = mbed_lwip_socket_recvfrom,
     .setsockopt         = mbed_lwip_setsockopt,
+    .getsockopt         = mbed_lwip_getsockopt,
     .socket_attach      = mbed_lwip_socket_attach,
+    .socket_sendto_batch    = mbed_lwip_socket_sendto_batch,
+    .socket_recvfrom_batch  = mbed_lwip_socket_recvfrom_batch,
 };
 
 nsapi_stack_t lwip_stack = {
@@ -213,6 +213,33 @@
 #define TCP_QUEUE_OOSEQ             0
 #define TCP_OVERSIZE                0
 #define LWIP_TCP_KEEPALIVE          1
+
+#if MBED_CONF_LWIP_TCP_AUTOTUNE_ENABLED
+// Largest buffers a single socket can be granted - the glue hands out
+// smaller per-socket buffers from these at run time within tcp-buf-budget
+#define TCP_SND_BUF                 MBED_CONF_LWIP_TCP_SNDBUF_MAX
+#define TCP_WND                     MBED_CONF_LWIP_TCP_WND_MAX
+
+#if TCP_WND > 0xFFFF || TCP_SND_BUF > 0xFFFF
+#define LWIP_WND_SCALE              1
+#if TCP_WND <= 0xFFFF
+#define TCP_RCV_SCALE               0
+#elif TCP_WND <= (0xFFFF << 1)
+#define TCP_RCV_SCALE               1
+#elif TCP_WND <= (0xFFFF << 2)
+#define TCP_RCV_SCALE               2
+#elif TCP_WND <= (0xFFFF << 3)
+#define TCP_RCV_SCALE               3
+#elif TCP_WND <= (0xFFFF << 4)
+#define TCP_RCV_SCALE               4
+#else
+#error "tcp-wnd-max is too large"
+#endif
+#endif
+
+// Windows are limited at run time by the buffer budget, not by the pbuf pool
+#define LWIP_DISABLE_TCP_SANITY_CHECKS 1
+#endif
 #else
 #define LWIP_TCP                    0
 #endif
@@ -287,8 +314,30 @@
 #define LWIP_DBG_MIN_LEVEL          LWIP_DBG_LEVEL_ALL
 #else
 #define LWIP_NOASSERT               1
+#if MBED_CONF_LWIP_STATS_ENABLED
+// Only the memory pool counters are needed for nsapi interface statistics
+#define LWIP_STATS                  1
+#define MEMP_STATS                  1
+#define LINK_STATS                  0
+#define ETHARP_STATS                0
+#define IP_STATS                    0
+#define IPFRAG_STATS                0
+#define ICMP_STATS                  0
+#define IGMP_STATS                  0
+#define UDP_STATS                   0
+#define TCP_STATS                   0
+#define MEM_STATS                   0
+#define SYS_STATS                   0
+#define IP6_STATS                   0
+#define ICMP6_STATS                 0
+#define IP6_FRAG_STATS              0
+#define MLD6_STATS                  0
+#define ND6_STATS                   0
+#define MIB2_STATS                  0
+#else
 #define LWIP_STATS                  0
 #endif
+#endif
 
 #define TRACE_TO_ASCII_HEX_DUMP     0
 
@@ -339,6 +388,11 @@
 // Checksum-on-copy disabled due to https://savannah.nongnu.org/bugs/?50914
 #define LWIP_CHECKSUM_ON_COPY       0
 
+// Allow EMAC drivers with checksum offload to turn off software checksums
+#if DEVICE_EMAC
+#define LWIP_CHECKSUM_CTRL_PER_NETIF 1
+#endif
+
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETIF_STATUS_CALLBACK  1
 #define LWIP_NETIF_LINK_CALLBACK    1
@@ -0,0 +1,173 @@
+#!/usr/bin/env python
+"""
+Generate the static comb tables used by MBEDTLS_ECP_FIXED_POINT_TABLES.
+
+Copyright (c) 2017, ARM Limited, All Rights Reserved
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License"); you may
+not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+The tables hold exactly what ecp_precompute_comb() in ecp.c computes for the
+base point: with d = ceil(nbits / w) and i = i_{w-1} ... i_1 in binary,
+
+    T[i] = i_{w-1} 2^((w-1)d) G + ... + i_1 2^d G + G
+
+in affine coordinates. The window w must match what ecp_pick_window() picks
+for the base point (one more than for other points), so keep WINDOW below in
+sync with it.
+
+Usage:
+    ecp_comb_tables.py              print the tables to stdout
+    ecp_comb_tables.py FILE         replace the generated section of FILE
+                                    (normally ../src/ecp_curves.c)
+"""
+
+import sys
+
+BEGIN_MARK = "/* BEGIN generated comb tables: importer/ecp_comb_tables.py */"
+END_MARK = "/* END generated comb tables */"
+
+CURVES = [
+    # name, config macro, p, a, gx, gy, n
+    ("secp256r1", "MBEDTLS_ECP_DP_SECP256R1_ENABLED",
+     0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF,
+     -3,
+     0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296,
+     0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5,
+     0xFFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551),
+    ("secp384r1", "MBEDTLS_ECP_DP_SECP384R1_ENABLED",
+     int("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE"
+         "FFFFFFFF0000000000000000FFFFFFFF", 16),
+     -3,
+     int("AA87CA22BE8B05378EB1C71EF320AD746E1D3B628BA79B9859F741E082542A38"
+         "5502F25DBF55296C3A545E3872760AB7", 16),
+     int("3617DE4A96262C6F5D9E98BF9292DC29F8F41DBD289A147CE9DA3113B5F0B8C0"
+         "0A60B1CE1D7E819D7A431D7C90EA0E5F", 16),
+     int("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFC7634D81F4372DDF"
+         "581A0DB248B0A77AECEC196ACCC52973", 16)),
+]
+
+
+def window(nbits):
+    """Window size used by ecp_pick_window() for the base point."""
+    return (5 if nbits >= 384 else 4) + 1
+
+
+def inv(x, p):
+    return pow(x, p - 2, p)
+
+
+def add(P, Q, p, a):
+    """Affine point addition, None being the point at infinity."""
+    if P is None:
+        return Q
+    if Q is None:
+        return P
+    if P[0] == Q[0]:
+        if (P[1] + Q[1]) % p == 0:
+            return None
+        l = (3 * P[0] * P[0] + a) * inv(2 * P[1], p) % p
+    else:
+        l = (Q[1] - P[1]) * inv(Q[0] - P[0], p) % p
+    x = (l * l - P[0] - Q[0]) % p
+    return (x, (l * (P[0] - x) - P[1]) % p)
+
+
+def comb_table(p, a, G, nbits):
+    w = window(nbits)
+    d = (nbits + w - 1) // w
+
+    # B[l] = 2^(ld) G
+    B = [G]
+    for _ in range(1, w):
+        Q = B[-1]
+        for _ in range(d):
+            Q = add(Q, Q, p, a)
+        B.append(Q)
+
+    T = []
+    for i in range(1 << (w - 1)):
+        Q = G
+        for l in range(1, w):
+            if i & (1 << (l - 1)):
+                Q = add(Q, B[l], p, a)
+        T.append(Q)
+
+    return w, d, T
+
+
+def limbs(x, nbytes):
+    """Format x as BYTES_TO_T_UINT_8() lines, little-endian like ecp_curves.c."""
+    b = [(x >> (8 * i)) & 0xFF for i in range(nbytes)]
+    lines = []
+    for i in range(0, nbytes, 8):
+        lines.append("    BYTES_TO_T_UINT_8( " +
+                     ", ".join("0x%02X" % c for c in b[i:i + 8]) + " ),")
+    return lines
+
+
+def generate():
+    out = [BEGIN_MARK]
+    for name, macro, p, a, gx, gy, n in CURVES:
+        nbits = n.bit_length()
+        nbytes = (p.bit_length() + 7) // 8
+        w, d, T = comb_table(p, a, (gx, gy), nbits)
+
+        out.append("")
+        out.append("/*")
+        out.append(" * Comb table for the %s base point (w = %d, d = %d)" %
+                   (name, w, d))
+        out.append(" */")
+        out.append("#if defined(%s)" % macro)
+        for i, (x, y) in enumerate(T):
+            for coord, v in (("X", x), ("Y", y)):
+                out.append("static const mbedtls_mpi_uint %s_T_%d_%s[] = {" %
+                           (name, i, coord))
+                out.extend(limbs(v, nbytes))
+                out.append("};")
+        out.append("static const mbedtls_ecp_point %s_T[%d] = {" %
+                   (name, len(T)))
+        for i in range(len(T)):
+            out.append("    ECP_POINT_INIT_XY_Z1( %s_T_%d_X, %s_T_%d_Y )," %
+                       (name, i, name, i))
+        out.append("};")
+        out.append("#endif /* %s */" % macro)
+    out.append("")
+    out.append(END_MARK)
+    return "\n".join(out) + "\n"
+
+
+def update(path, text):
+    with open(path) as f:
+        src = f.read()
+
+    start = src.find(BEGIN_MARK)
+    end = src.find(END_MARK)
+    if start < 0 or end < start:
+        sys.exit("%s: generated section markers not found" % path)
+    end += len(END_MARK) + 1
+
+    with open(path, "w") as f:
+        f.write(src[:start] + text + src[end:])
+
+
+def main():
+    text = generate()
+    if len(sys.argv) > 1:
+        update(sys.argv[1], text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
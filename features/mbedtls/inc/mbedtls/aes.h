@@ -329,6 +329,30 @@ MBEDTLS_DEPRECATED void mbedtls_aes_decrypt( mbedtls_aes_context *ctx,
 extern "C" {
 #endif
 
+/**
+ * \brief          AES-ECB encryption/decryption of consecutive blocks
+ *
+ *                 Used by GCM and CCM (through the cipher layer) to compute
+ *                 the key stream of many counter blocks in one call. This
+ *                 loops over mbedtls_aes_crypt_ecb() unless the target
+ *                 provides its own implementation, for example handing the
+ *                 blocks to a DMA-capable engine in one transfer (see
+ *                 MBEDTLS_AES_CRYPT_ECB_BLOCKS_ALT).
+ *
+ * \param ctx      AES context
+ * \param mode     MBEDTLS_AES_ENCRYPT or MBEDTLS_AES_DECRYPT
+ * \param blocks   number of 16-byte blocks
+ * \param input    input blocks
+ * \param output   output blocks, may be the same buffer as input
+ *
+ * \return         0 if successful
+ */
+int mbedtls_aes_crypt_ecb_blocks( mbedtls_aes_context *ctx,
+                                  int mode,
+                                  size_t blocks,
+                                  const unsigned char *input,
+                                  unsigned char *output );
+
 /**
  * \brief          Checkup routine
  *
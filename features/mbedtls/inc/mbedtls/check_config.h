@@ -102,6 +102,22 @@
 #error "MBEDTLS_ECDSA_DETERMINISTIC defined, but not all prerequisites"
 #endif
 
+#if defined(MBEDTLS_ECP_RESTARTABLE)           && \
+    ( defined(MBEDTLS_ECP_INTERNAL_ALT)        || \
+      defined(MBEDTLS_ECP_ALT) )
+#error "MBEDTLS_ECP_RESTARTABLE defined, but it cannot coexist with an alternative ECP implementation"
+#endif
+
+#if defined(MBEDTLS_ECP_RESTARTABLE) && !defined(MBEDTLS_ECP_C)
+#error "MBEDTLS_ECP_RESTARTABLE defined, but not all prerequisites"
+#endif
+
+#if defined(MBEDTLS_ECP_FIXED_POINT_TABLES) &&                          \
+    ( !defined(MBEDTLS_ECP_C) || ( defined(MBEDTLS_ECP_FIXED_POINT_OPTIM) && \
+                                   MBEDTLS_ECP_FIXED_POINT_OPTIM == 0 ) )
+#error "MBEDTLS_ECP_FIXED_POINT_TABLES defined, but not all prerequisites"
+#endif
+
 #if defined(MBEDTLS_ECP_C) && ( !defined(MBEDTLS_BIGNUM_C) || (   \
     !defined(MBEDTLS_ECP_DP_SECP192R1_ENABLED) &&                  \
     !defined(MBEDTLS_ECP_DP_SECP224R1_ENABLED) &&                  \
@@ -250,6 +266,11 @@
 #error "MBEDTLS_MEMORY_BUFFER_ALLOC_C defined, but not all prerequisites"
 #endif
 
+#if defined(MBEDTLS_MEMORY_FREE_LISTS) &&                              \
+    ( MBEDTLS_MEMORY_FREE_LISTS < 1 || MBEDTLS_MEMORY_FREE_LISTS > 32 )
+#error "MBEDTLS_MEMORY_FREE_LISTS must be between 1 and 32"
+#endif
+
 #if defined(MBEDTLS_PADLOCK_C) && !defined(MBEDTLS_HAVE_ASM)
 #error "MBEDTLS_PADLOCK_C defined, but not all prerequisites"
 #endif
@@ -574,6 +595,15 @@
 #error "MBEDTLS_SSL_ENCRYPT_THEN_MAC defined, but not all prerequsites"
 #endif
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH) && defined(MBEDTLS_ZLIB_SUPPORT)
+#error "MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH defined, but not all prerequisites"
+#endif
+
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN) &&                       \
+    MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN < 1024
+#error "MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN must be at least 1024"
+#endif
+
 #if defined(MBEDTLS_SSL_EXTENDED_MASTER_SECRET) && \
     !defined(MBEDTLS_SSL_PROTO_TLS1)   &&          \
     !defined(MBEDTLS_SSL_PROTO_TLS1_1) &&          \
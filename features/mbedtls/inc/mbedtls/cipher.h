@@ -530,8 +530,11 @@ int mbedtls_cipher_update_ad( mbedtls_cipher_context_t *ctx,
  *                      that cannot be written immediately will either be added
  *                      to the next block, or flushed when cipher_final is
  *                      called.
- *                      Exception: for MBEDTLS_MODE_ECB, expects single block
- *                                 in size (e.g. 16 bytes for AES)
+ *                      Exception: for MBEDTLS_MODE_ECB, expects whole blocks
+ *                                 (e.g. a multiple of 16 bytes for AES),
+ *                                 processed in a single call to the
+ *                                 cipher where it supports it. output may
+ *                                 then be the same buffer as input.
  *
  * \param ctx           generic cipher context
  * \param input         buffer holding the input data
@@ -49,6 +49,10 @@ struct mbedtls_cipher_base_t
     int (*ecb_func)( void *ctx, mbedtls_operation_t mode,
                      const unsigned char *input, unsigned char *output );
 
+    /** Encrypt using ECB, several consecutive blocks (NULL to loop over ecb_func) */
+    int (*ecb_blocks_func)( void *ctx, mbedtls_operation_t mode, size_t blocks,
+                            const unsigned char *input, unsigned char *output );
+
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     /** Encrypt using CBC */
     int (*cbc_func)( void *ctx, mbedtls_operation_t mode, size_t length,
@@ -345,6 +345,17 @@
 //#define MBEDTLS_AES_ENCRYPT_ALT
 //#define MBEDTLS_AES_DECRYPT_ALT
 
+/**
+ * \def MBEDTLS_AES_CRYPT_ECB_BLOCKS_ALT
+ *
+ * Uncomment to provide your own mbedtls_aes_crypt_ecb_blocks(), which GCM
+ * and CCM use to compute the key stream of several counter blocks at once,
+ * up to a whole record when the output buffer does not overlap the input.
+ * Meant for engines that can process many blocks in one DMA transfer. Also
+ * available with MBEDTLS_AES_ALT.
+ */
+//#define MBEDTLS_AES_CRYPT_ECB_BLOCKS_ALT
+
 /**
  * \def MBEDTLS_ECP_INTERNAL_ALT
  *
@@ -576,6 +587,50 @@
  */
 #define MBEDTLS_ECP_NIST_OPTIM
 
+/**
+ * \def MBEDTLS_ECP_FIXED_POINT_TABLES
+ *
+ * Use pre-computed tables in read-only memory for multiplications by the
+ * base point of secp256r1 and secp384r1 (key generation, ECDSA signature,
+ * ECDHE), instead of building them in RAM the first time each group is used.
+ *
+ * This saves the table construction (roughly the cost of one multiplication)
+ * and 2 to 6 KB of heap for every newly loaded group, which in TLS means
+ * every handshake. It costs about 1.6 KB of ROM for secp256r1 and 4.2 KB for
+ * secp384r1 (on 32-bit platforms), regardless of MBEDTLS_ECP_WINDOW_SIZE.
+ *
+ * The tables are generated by importer/ecp_comb_tables.py.
+ *
+ * Requires: MBEDTLS_ECP_FIXED_POINT_OPTIM == 1
+ *
+ * Uncomment this macro to use static tables for the base point.
+ */
+//#define MBEDTLS_ECP_FIXED_POINT_TABLES
+
+/**
+ * \def MBEDTLS_ECP_RESTARTABLE
+ *
+ * Enable "non-blocking" ECC operations that can return early and be resumed.
+ *
+ * This allows various functions to pause by returning
+ * #MBEDTLS_ERR_ECP_IN_PROGRESS (or, for functions in the SSL module,
+ * #MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS) and then be called later again in
+ * order to further progress and eventually complete their operation. This is
+ * controlled through mbedtls_ecp_set_max_ops() which limits the maximum
+ * number of ECC operations a function may perform before pausing; see
+ * mbedtls_ecp_set_max_ops() for more information.
+ *
+ * This is useful in non-threaded environments if you want to avoid blocking
+ * for too long on ECC (and, hence, SSL/TLS handshake) operations.
+ *
+ * Uncomment this macro to enable restartable ECC computations.
+ *
+ * \note  This option only works with the default software implementation of
+ *        elliptic curve functionality. It is incompatible with
+ *        MBEDTLS_ECP_ALT and MBEDTLS_ECP_INTERNAL_ALT.
+ */
+//#define MBEDTLS_ECP_RESTARTABLE
+
 /**
  * \def MBEDTLS_ECDSA_DETERMINISTIC
  *
@@ -1378,6 +1433,25 @@
  */
 //#define MBEDTLS_SSL_TRUNCATED_HMAC
 
+/**
+ * \def MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+ *
+ * Size the SSL input and output buffers on demand instead of allocating two
+ * buffers of MBEDTLS_SSL_MAX_CONTENT_LEN bytes for every context.
+ *
+ * The buffers start with room for MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN bytes
+ * of content, grow when a larger record arrives or is written, and shrink
+ * back once the handshake is over. This lowers the peak heap used by each
+ * connection at the cost of reallocations when large records are seen.
+ * Datagram (DTLS) input still uses a full size buffer, since a whole
+ * datagram must be read at once.
+ *
+ * Requires: !MBEDTLS_ZLIB_SUPPORT
+ *
+ * Uncomment this macro to size the SSL I/O buffers on demand
+ */
+//#define MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+
 /**
  * \def MBEDTLS_THREADING_ALT
  *
@@ -2628,6 +2702,7 @@
 
 /* Memory buffer allocator options */
 //#define MBEDTLS_MEMORY_ALIGN_MULTIPLE      4 /**< Align on multiples of this value */
+//#define MBEDTLS_MEMORY_FREE_LISTS          1 /**< Number of free lists segregated by block size (1 to 32), 1 for a single first-fit list */
 
 /* Platform options */
 //#define MBEDTLS_PLATFORM_STD_MEM_HDR   <stdlib.h> /**< Header to include if MBEDTLS_PLATFORM_NO_STD_FUNCTIONS is defined. Don't define if no header is needed. */
@@ -2666,6 +2741,7 @@
 /* SSL options */
 //#define MBEDTLS_SSL_MAX_CONTENT_LEN             16384 /**< Maxium fragment length in bytes, determines the size of each of the two internal I/O buffers */
 //#define MBEDTLS_SSL_DEFAULT_TICKET_LIFETIME     86400 /**< Lifetime of session tickets (if enabled) */
+//#define MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN      2048 /**< Initial content size of the SSL I/O buffers with MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
 //#define MBEDTLS_PSK_MAX_LEN               32 /**< Max size of TLS pre-shared keys, in bytes (default 256 bits) */
 //#define MBEDTLS_SSL_COOKIE_TIMEOUT        60 /**< Default expiration delay of DTLS cookies, in seconds if HAVE_TIME, or in number of cookies issued */
 
@@ -52,6 +52,10 @@ typedef struct
     mbedtls_ecp_point Vi;       /*!<  blinding value (for later)                    */
     mbedtls_ecp_point Vf;       /*!<  un-blinding value (for later)                 */
     mbedtls_mpi _d;             /*!<  previous d (for later)                        */
+#if defined(MBEDTLS_ECP_RESTARTABLE)
+    int restart_enabled;        /*!<  enable restartable EC computations?           */
+    mbedtls_ecp_restart_ctx rs; /*!<  restart context for EC computations           */
+#endif
 }
 mbedtls_ecdh_context;
 
@@ -109,6 +113,27 @@ void mbedtls_ecdh_init( mbedtls_ecdh_context *ctx );
  */
 void mbedtls_ecdh_free( mbedtls_ecdh_context *ctx );
 
+#if defined(MBEDTLS_ECP_RESTARTABLE)
+/**
+ * \brief           Enable restartable EC computations for this context.
+ *                  (Default: disabled.)
+ *
+ *                  mbedtls_ecdh_make_params(), mbedtls_ecdh_make_public() and
+ *                  mbedtls_ecdh_calc_secret() may then return
+ *                  MBEDTLS_ERR_ECP_IN_PROGRESS, and must be called again
+ *                  with the same arguments until they return another value.
+ *
+ * \see             \c mbedtls_ecp_set_max_ops()
+ *
+ * \note            It is not possible to safely disable restartable
+ *                  computations once enabled, except by free-ing the context,
+ *                  which cancels possible in-progress operations.
+ *
+ * \param ctx       ECDH context
+ */
+void mbedtls_ecdh_enable_restart( mbedtls_ecdh_context *ctx );
+#endif /* MBEDTLS_ECP_RESTARTABLE */
+
 /**
  * \brief           Generate a public key and a TLS ServerKeyExchange payload.
  *                  (First function used by a TLS server for ECDHE.)
@@ -43,6 +43,15 @@
 #define MBEDTLS_MEMORY_ALIGN_MULTIPLE       4 /**< Align on multiples of this value */
 #endif
 
+/*
+ * Segregated free lists bound the search for a free block on heaps where
+ * long-lived allocations make the first-fit walk long. They are slower than
+ * the single list on the short-lived allocations of a TLS handshake.
+ */
+#if !defined(MBEDTLS_MEMORY_FREE_LISTS)
+#define MBEDTLS_MEMORY_FREE_LISTS           1 /**< Number of free lists segregated by block size (1 to 32), 1 for a single first-fit list */
+#endif
+
 /* \} name SECTION: Module settings */
 
 #define MBEDTLS_MEMORY_VERIFY_NONE         0
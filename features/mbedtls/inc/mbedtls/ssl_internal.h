@@ -145,6 +145,29 @@
                         + MBEDTLS_SSL_PADDING_ADD                   \
                         )
 
+/* Everything in a record buffer besides the content itself */
+#define MBEDTLS_SSL_BUFFER_OVERHEAD ( MBEDTLS_SSL_BUFFER_LEN - MBEDTLS_SSL_MAX_CONTENT_LEN )
+
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+#if !defined(MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN)
+#define MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN     2048
+#endif
+
+#if MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN > MBEDTLS_SSL_MAX_CONTENT_LEN
+#error "MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN must not exceed MBEDTLS_SSL_MAX_CONTENT_LEN"
+#endif
+
+#define MBEDTLS_SSL_IN_BUFFER_LEN( ssl )    ( (ssl)->in_buf_len )
+#define MBEDTLS_SSL_OUT_BUFFER_LEN( ssl )   ( (ssl)->out_buf_len )
+#else
+#define MBEDTLS_SSL_IN_BUFFER_LEN( ssl )    MBEDTLS_SSL_BUFFER_LEN
+#define MBEDTLS_SSL_OUT_BUFFER_LEN( ssl )   MBEDTLS_SSL_BUFFER_LEN
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
+
+/* Room for content currently available in the output buffer */
+#define MBEDTLS_SSL_OUT_CONTENT_LEN( ssl )                                  \
+    ( MBEDTLS_SSL_OUT_BUFFER_LEN( ssl ) - MBEDTLS_SSL_BUFFER_OVERHEAD )
+
 /*
  * TLS extension flags (for extensions with outgoing ServerHello content
  * that need it (e.g. for RENEGOTIATION_INFO the server already knows because
@@ -153,6 +176,17 @@
 #define MBEDTLS_TLS_EXT_SUPPORTED_POINT_FORMATS_PRESENT (1 << 0)
 #define MBEDTLS_TLS_EXT_ECJPAKE_KKPP_OK                 (1 << 1)
 
+/*
+ * Restartable ECC is used in the handshake for the ECDHE-ECDSA key exchange:
+ * ServerKeyExchange signature and ECDH on both sides, CertificateVerify
+ * signature on the client
+ */
+#if defined(MBEDTLS_ECP_RESTARTABLE) && \
+    defined(MBEDTLS_ECDH_C) && defined(MBEDTLS_ECDSA_C) && \
+    defined(MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED)
+#define MBEDTLS_SSL__ECP_RESTARTABLE
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -194,6 +228,19 @@ struct mbedtls_ssl_handshake_params
 #if defined(MBEDTLS_ECDH_C)
     mbedtls_ecdh_context ecdh_ctx;              /*!<  ECDH key exchange       */
 #endif
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+    int ecrs_enabled;                   /*!< Handshake supports EC restart? */
+    mbedtls_pk_restart_ctx ecrs_ctx;    /*!< restart context                */
+    enum { /* this complements ssl->state with info on intra-state operations */
+        ssl_ecrs_none = 0,              /*!< nothing going on (yet)         */
+        ssl_ecrs_ske_start_processing,  /*!< Client: ServerKeyExchange      */
+        ssl_ecrs_cke_ecdh_calc_secret,  /*!< ClientKeyExchange: ECDH step 2 */
+        ssl_ecrs_crt_vrfy_sign,         /*!< Client: CertificateVerify      */
+        ssl_ecrs_ske_ecdh_params,       /*!< Server: ECDH step 1            */
+        ssl_ecrs_ske_sign,              /*!< Server: ServerKeyExchange sig  */
+    } ecrs_state;                       /*!< current (or last) operation    */
+    size_t ecrs_n;                      /*!< place for saving a length      */
+#endif
 #if defined(MBEDTLS_KEY_EXCHANGE_ECJPAKE_ENABLED)
     mbedtls_ecjpake_context ecjpake_ctx;        /*!< EC J-PAKE key exchange */
 #if defined(MBEDTLS_SSL_CLI_C)
@@ -482,6 +529,33 @@ int mbedtls_ssl_fetch_input( mbedtls_ssl_context *ssl, size_t nb_want );
 int mbedtls_ssl_write_record( mbedtls_ssl_context *ssl );
 int mbedtls_ssl_flush_output( mbedtls_ssl_context *ssl );
 
+/**
+ * \brief       Make room for an outgoing message of up to content_len bytes
+ *
+ *              With MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH the output buffer is
+ *              grown if needed; otherwise it always has room for
+ *              MBEDTLS_SSL_MAX_CONTENT_LEN bytes and this does nothing.
+ *              Pointers into the buffer other than those in the context
+ *              must be recomputed after a successful call.
+ *
+ * \param ssl   SSL context
+ * \param content_len   Message size the caller is about to write, capped
+ *                      at MBEDTLS_SSL_MAX_CONTENT_LEN
+ *
+ * \return      0 if successful, or MBEDTLS_ERR_SSL_ALLOC_FAILED
+ */
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+int mbedtls_ssl_out_buffer_ensure( mbedtls_ssl_context *ssl, size_t content_len );
+#else
+static inline int mbedtls_ssl_out_buffer_ensure( mbedtls_ssl_context *ssl,
+                                                 size_t content_len )
+{
+    ((void) ssl);
+    ((void) content_len);
+    return( 0 );
+}
+#endif
+
 int mbedtls_ssl_parse_certificate( mbedtls_ssl_context *ssl );
 int mbedtls_ssl_write_certificate( mbedtls_ssl_context *ssl );
 
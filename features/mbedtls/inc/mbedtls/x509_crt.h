@@ -89,6 +89,8 @@ typedef struct mbedtls_x509_crt
     mbedtls_pk_type_t sig_pk;           /**< Internal representation of the Public Key algorithm of the signature algorithm, e.g. MBEDTLS_PK_RSA */
     void *sig_opts;             /**< Signature options to be passed to mbedtls_pk_verify_ext(), e.g. for RSASSA-PSS */
 
+    int own_buffer;             /**< 1 if raw is a copy owned by this structure, 0 if it references the buffer passed to mbedtls_x509_crt_parse_der_nocopy() */
+
     struct mbedtls_x509_crt *next;     /**< Next certificate in the CA-chain. */
 }
 mbedtls_x509_crt;
@@ -173,6 +175,30 @@ extern const mbedtls_x509_crt_profile mbedtls_x509_crt_profile_suiteb;
 int mbedtls_x509_crt_parse_der( mbedtls_x509_crt *chain, const unsigned char *buf,
                         size_t buflen );
 
+/**
+ * \brief          Parse a single DER formatted certificate and add it
+ *                 to the chained list, without copying it.
+ *
+ *                 The certificate keeps pointers into buf, which may be in
+ *                 flash or ROM, so a trust store only costs the parsed
+ *                 structures. The names and list-valued extensions are not
+ *                 decoded at parse time: the issuer, subject,
+ *                 subject_alt_names and ext_key_usage fields stay empty
+ *                 and verification reads them from the DER as needed.
+ *                 Use mbedtls_x509_crt_parse_der() if the application
+ *                 needs these fields.
+ *
+ * \param chain    points to the start of the chain
+ * \param buf      buffer holding the certificate DER data, which must
+ *                 remain valid and unmodified until the chain is freed
+ * \param buflen   size of the buffer
+ *
+ * \return         0 if successful, or a specific X509 or PEM error code
+ */
+int mbedtls_x509_crt_parse_der_nocopy( mbedtls_x509_crt *chain,
+                                       const unsigned char *buf,
+                                       size_t buflen );
+
 /**
  * \brief          Parse one or more certificates and add them
  *                 to the chained list. Parses permissively. If some
@@ -0,0 +1,116 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_DRBG_H
+#define MBED_DRBG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_CTR_DRBG_C) && defined(MBEDTLS_ENTROPY_C)
+
+#define MBED_DRBG_PRESENT
+
+/*
+ * Process-wide random number generator
+ *
+ * One CTR_DRBG, seeded from the mbed TLS entropy sources (the TRNG HAL on
+ * targets with DEVICE_TRNG), shared by every user instead of each TLS
+ * context seeding its own. Output is generated a pool at a time, so that
+ * the DRBG update which follows each generate call is paid once per pool
+ * rather than once per request, and the pool is refilled by a low priority
+ * thread when it runs low. The same thread gathers entropy ahead of time
+ * and reseeds the DRBG, so a caller never waits on the TRNG once the first
+ * seed is taken.
+ *
+ * Without an RTOS, the pool is refilled and the DRBG reseeded by the
+ * request that finds them due.
+ *
+ * Pass mbed_drbg_random to any mbed TLS function taking f_rng, with a NULL
+ * p_rng:
+ *
+ *     mbedtls_ssl_conf_rng(&conf, mbed_drbg_random, NULL);
+ *
+ * Configuration, in mbed_app.json:
+ *   mbedtls-drbg.pool-size        bytes generated ahead (at most 1024)
+ *   mbedtls-drbg.reseed-interval  bytes of output between reseeds
+ *   mbedtls-drbg.stack-size       stack of the refill thread
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Counters of the shared DRBG, since boot */
+typedef struct {
+    uint64_t bytes;         /**< bytes returned to callers */
+    uint64_t pool_bytes;    /**< of which served from the pool */
+    uint32_t requests;      /**< calls to mbed_drbg_random() */
+    uint32_t refills;       /**< pool refills, in the background or inline */
+    uint32_t inline_refills;/**< of which done by a request on an empty pool */
+    uint32_t reseeds;       /**< reseeds, not counting the first seed */
+} mbed_drbg_stats_t;
+
+/** Seed the shared DRBG and start its refill thread
+ *
+ *  Called by the first mbed_drbg_random(). Calling it early, for example
+ *  at boot, moves the wait for the first seed out of the first connection.
+ *
+ *  @return 0 on success, or an mbed TLS error code
+ */
+int mbed_drbg_init(void);
+
+/** Get random bytes from the shared DRBG
+ *
+ *  Thread safe. Requests smaller than the pool are served from it,
+ *  larger ones are generated directly.
+ *
+ *  @param p_rng   Unused, for compatibility with mbed TLS f_rng
+ *  @param output  Destination buffer
+ *  @param len     Number of bytes to write
+ *  @return 0 on success, or an mbed TLS error code
+ */
+int mbed_drbg_random(void *p_rng, unsigned char *output, size_t len);
+
+/** Reseed the shared DRBG from the entropy sources now
+ *
+ *  For use after events that call for fresh entropy, such as a key
+ *  compromise or leaving a low power mode in which the RAM was kept.
+ *  Blocks while the entropy is gathered.
+ *
+ *  @return 0 on success, or an mbed TLS error code
+ */
+int mbed_drbg_reseed(void);
+
+/** Read the counters of the shared DRBG
+ *
+ *  @param stats   Destination
+ */
+void mbed_drbg_get_stats(mbed_drbg_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_CTR_DRBG_C && MBEDTLS_ENTROPY_C */
+
+#endif /* MBED_DRBG_H */
@@ -0,0 +1,359 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_drbg.h"
+
+#if defined(MBED_DRBG_PRESENT)
+
+#include <string.h>
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/entropy.h"
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+#include "platform/NonCopyable.h"
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "rtos/Thread.h"
+#include "rtos/EventFlags.h"
+#endif
+
+#ifndef MBED_CONF_MBEDTLS_DRBG_POOL_SIZE
+#define MBED_CONF_MBEDTLS_DRBG_POOL_SIZE        512
+#endif
+
+#ifndef MBED_CONF_MBEDTLS_DRBG_RESEED_INTERVAL
+#define MBED_CONF_MBEDTLS_DRBG_RESEED_INTERVAL  65536
+#endif
+
+#ifndef MBED_CONF_MBEDTLS_DRBG_STACK_SIZE
+#define MBED_CONF_MBEDTLS_DRBG_STACK_SIZE       3072
+#endif
+
+#if MBED_CONF_MBEDTLS_DRBG_POOL_SIZE > MBEDTLS_CTR_DRBG_MAX_REQUEST
+#error "mbedtls-drbg.pool-size must not exceed MBEDTLS_CTR_DRBG_MAX_REQUEST"
+#endif
+
+#define POOL_SIZE       MBED_CONF_MBEDTLS_DRBG_POOL_SIZE
+
+/* The thread is woken below half a pool, so that requests keep being served
+ * from the pool while it catches up */
+#define POOL_LOW        (POOL_SIZE / 2)
+
+#define FLAG_REFILL     0x1u
+#define FLAG_RESEED     0x2u
+
+static void zeroize(void *v, size_t n)
+{
+    volatile unsigned char *p = static_cast<unsigned char *>(v);
+    while (n--) {
+        *p++ = 0;
+    }
+}
+
+class DRBGService : private mbed::NonCopyable<DRBGService> {
+public:
+    DRBGService();
+
+    int init();
+    int random(unsigned char *output, size_t len);
+    int reseed();
+    void get_stats(mbed_drbg_stats_t *stats);
+
+private:
+    int refill();
+    int reseed_locked();
+    int gather(unsigned char *seed, size_t len);
+    static int entropy_source(void *ctx, unsigned char *output, size_t len);
+#ifdef MBED_CONF_RTOS_PRESENT
+    void thread_main();
+#endif
+
+    /* _mutex covers everything but the entropy context, which has its own
+     * so the thread can gather without blocking requests. When both are
+     * needed, _mutex is taken first. */
+    PlatformMutex _mutex;
+    PlatformMutex _entropy_mutex;
+
+    mbedtls_ctr_drbg_context _drbg;
+    mbedtls_entropy_context _entropy;
+    bool _seeded;
+
+    /* Bytes not yet handed out are _pool[0.._pool_len) */
+    unsigned char _pool[POOL_SIZE];
+    size_t _pool_len;
+
+    /* Entropy gathered by the thread for the next reseed */
+    unsigned char _seed[MBEDTLS_CTR_DRBG_ENTROPY_LEN];
+    bool _seed_ready;
+    size_t _since_reseed;
+
+    mbed_drbg_stats_t _stats;
+
+#ifdef MBED_CONF_RTOS_PRESENT
+    rtos::Thread _thread;
+    rtos::EventFlags _flags;
+    uint32_t _pending;      // flags set and not yet handled by the thread
+#endif
+};
+
+DRBGService::DRBGService()
+    : _seeded(false), _pool_len(0), _seed_ready(false), _since_reseed(0)
+#ifdef MBED_CONF_RTOS_PRESENT
+    , _thread(osPriorityLow, MBED_CONF_MBEDTLS_DRBG_STACK_SIZE, NULL, "drbg")
+    , _pending(0)
+#endif
+{
+    mbedtls_ctr_drbg_init(&_drbg);
+    mbedtls_entropy_init(&_entropy);
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+/* f_entropy of the DRBG, always called with _mutex held */
+int DRBGService::entropy_source(void *ctx, unsigned char *output, size_t len)
+{
+    DRBGService *self = static_cast<DRBGService *>(ctx);
+
+    if (self->_seed_ready && len <= sizeof(self->_seed)) {
+        memcpy(output, self->_seed, len);
+        zeroize(self->_seed, sizeof(self->_seed));
+        self->_seed_ready = false;
+        return 0;
+    }
+
+    /* First seed, explicit reseed, or the DRBG's own reseed interval ran
+     * out before the thread got to it */
+    return self->gather(output, len);
+}
+
+int DRBGService::gather(unsigned char *seed, size_t len)
+{
+    _entropy_mutex.lock();
+    int ret = mbedtls_entropy_func(&_entropy, seed, len);
+    _entropy_mutex.unlock();
+    return ret;
+}
+
+int DRBGService::init()
+{
+    static const char pers[] = "mbed_drbg";
+    int ret = 0;
+
+    _mutex.lock();
+    if (!_seeded) {
+        ret = mbedtls_ctr_drbg_seed(&_drbg, entropy_source, this,
+                                    reinterpret_cast<const unsigned char *>(pers),
+                                    sizeof(pers) - 1);
+        if (ret == 0) {
+            _seeded = true;
+#ifdef MBED_CONF_RTOS_PRESENT
+            _thread.start(mbed::callback(this, &DRBGService::thread_main));
+            _pending = FLAG_REFILL;
+            _flags.set(FLAG_REFILL);
+#endif
+        }
+    }
+    _mutex.unlock();
+
+    return ret;
+}
+
+/* Top the pool up, with _mutex held */
+int DRBGService::refill()
+{
+    size_t len = POOL_SIZE - _pool_len;
+
+    if (len == 0) {
+        return 0;
+    }
+
+    int ret = mbedtls_ctr_drbg_random(&_drbg, _pool + _pool_len, len);
+    if (ret == 0) {
+        _pool_len = POOL_SIZE;
+        _since_reseed += len;
+        _stats.refills++;
+    }
+    return ret;
+}
+
+int DRBGService::reseed_locked()
+{
+    int ret = mbedtls_ctr_drbg_reseed(&_drbg, NULL, 0);
+    if (ret == 0) {
+        _since_reseed = 0;
+        _stats.reseeds++;
+    }
+    return ret;
+}
+
+int DRBGService::random(unsigned char *output, size_t len)
+{
+    int ret;
+
+    if ((ret = init()) != 0) {
+        return ret;
+    }
+
+    _mutex.lock();
+
+    _stats.requests++;
+
+    if (len > POOL_SIZE) {
+        /* Too big for the pool, and big enough that the update after the
+         * generate call is a small part of the cost */
+        for (size_t n, done = 0; done < len && ret == 0; done += n) {
+            n = len - done;
+            if (n > MBEDTLS_CTR_DRBG_MAX_REQUEST) {
+                n = MBEDTLS_CTR_DRBG_MAX_REQUEST;
+            }
+            ret = mbedtls_ctr_drbg_random(&_drbg, output + done, n);
+        }
+        if (ret == 0) {
+            _since_reseed += len;
+        }
+    } else {
+        if (_pool_len < len) {
+            /* The thread did not keep up, or there is none */
+            ret = refill();
+            _stats.inline_refills++;
+        }
+        if (ret == 0) {
+            _pool_len -= len;
+            memcpy(output, _pool + _pool_len, len);
+            zeroize(_pool + _pool_len, len);
+            _stats.pool_bytes += len;
+        }
+    }
+
+    if (ret == 0) {
+        _stats.bytes += len;
+    }
+
+    bool low = _pool_len < POOL_LOW;
+    bool reseed_due = _since_reseed >= MBED_CONF_MBEDTLS_DRBG_RESEED_INTERVAL;
+
+#ifdef MBED_CONF_RTOS_PRESENT
+    /* Wake the thread once, not on every request until it runs */
+    uint32_t wake = ((low ? FLAG_REFILL : 0) | (reseed_due ? FLAG_RESEED : 0)) & ~_pending;
+    _pending |= wake;
+    _mutex.unlock();
+
+    if (wake) {
+        _flags.set(wake);
+    }
+#else
+    if (reseed_due) {
+        reseed_locked();
+    }
+    if (low) {
+        refill();
+    }
+    _mutex.unlock();
+#endif
+
+    return ret;
+}
+
+int DRBGService::reseed()
+{
+    int ret;
+
+    if ((ret = init()) != 0) {
+        return ret;
+    }
+
+    _mutex.lock();
+
+    /* Fresh entropy now rather than what the thread gathered earlier, and
+     * nothing generated before the reseed is handed out after it */
+    zeroize(_seed, sizeof(_seed));
+    _seed_ready = false;
+    ret = reseed_locked();
+
+    zeroize(_pool, sizeof(_pool));
+    _pool_len = 0;
+    if (ret == 0) {
+        ret = refill();
+    }
+
+    _mutex.unlock();
+
+    return ret;
+}
+
+void DRBGService::get_stats(mbed_drbg_stats_t *stats)
+{
+    _mutex.lock();
+    *stats = _stats;
+    _mutex.unlock();
+}
+
+#ifdef MBED_CONF_RTOS_PRESENT
+void DRBGService::thread_main()
+{
+    unsigned char seed[sizeof(_seed)];
+
+    while (true) {
+        uint32_t flags = _flags.wait_any(FLAG_REFILL | FLAG_RESEED);
+        if (flags & osFlagsError) {
+            continue;
+        }
+
+        if (flags & FLAG_RESEED) {
+            /* The TRNG is polled without holding _mutex */
+            int ret = gather(seed, sizeof(seed));
+
+            _mutex.lock();
+            if (ret == 0) {
+                memcpy(_seed, seed, sizeof(_seed));
+                _seed_ready = true;
+                reseed_locked();
+            }
+            _mutex.unlock();
+
+            zeroize(seed, sizeof(seed));
+        }
+
+        _mutex.lock();
+        refill();
+        _pending &= ~flags;
+        _mutex.unlock();
+    }
+}
+#endif
+
+static SingletonPtr<DRBGService> service;
+
+extern "C" int mbed_drbg_init(void)
+{
+    return service->init();
+}
+
+extern "C" int mbed_drbg_random(void *p_rng, unsigned char *output, size_t len)
+{
+    (void) p_rng;
+    return service->random(output, len);
+}
+
+extern "C" int mbed_drbg_reseed(void)
+{
+    return service->reseed();
+}
+
+extern "C" void mbed_drbg_get_stats(mbed_drbg_stats_t *stats)
+{
+    service->get_stats(stats);
+}
+
+#endif /* MBED_DRBG_PRESENT */
@@ -1053,6 +1053,31 @@ int mbedtls_aes_crypt_ctr( mbedtls_aes_context *ctx,
 
 #endif /* !MBEDTLS_AES_ALT */
 
+/*
+ * AES-ECB encryption/decryption of consecutive blocks
+ */
+#if !defined(MBEDTLS_AES_CRYPT_ECB_BLOCKS_ALT)
+int mbedtls_aes_crypt_ecb_blocks( mbedtls_aes_context *ctx,
+                                  int mode,
+                                  size_t blocks,
+                                  const unsigned char *input,
+                                  unsigned char *output )
+{
+    int ret;
+
+    for( ; blocks > 0; blocks-- )
+    {
+        if( ( ret = mbedtls_aes_crypt_ecb( ctx, mode, input, output ) ) != 0 )
+            return( ret );
+
+        input  += 16;
+        output += 16;
+    }
+
+    return( 0 );
+}
+#endif /* !MBEDTLS_AES_CRYPT_ECB_BLOCKS_ALT */
+
 #if defined(MBEDTLS_SELF_TEST)
 /*
  * AES test vectors from:
@@ -131,6 +131,14 @@ void mbedtls_ccm_free( mbedtls_ccm_context *ctx )
     for( i = 0; i < len; i++ )                                                 \
         dst[i] = src[i] ^ b[i];
 
+/*
+ * Key stream blocks computed per call to the cipher, on the stack. When
+ * output does not overlap input, the key stream of all full blocks is
+ * computed in place in output instead, in one call, so that an engine behind
+ * mbedtls_aes_crypt_ecb_blocks() can take the whole message at once.
+ */
+#define CCM_BATCH_BLOCKS    8
+
 /*
  * Authenticated encryption or decryption
  */
@@ -147,8 +155,12 @@ static int ccm_auth_crypt( mbedtls_ccm_context *ctx, int mode, size_t length,
     unsigned char b[16];
     unsigned char y[16];
     unsigned char ctr[16];
+    unsigned char stream[16 * CCM_BATCH_BLOCKS];
+    unsigned char *ks;
     const unsigned char *src;
     unsigned char *dst;
+    size_t j, blocks;
+    int separate;
 
     /*
      * Check length requirements: SP800-38C A.1
@@ -255,38 +267,68 @@ static int ccm_auth_crypt( mbedtls_ccm_context *ctx, int mode, size_t length,
     len_left = length;
     src = input;
     dst = output;
+    separate = output + length <= input || input + length <= output;
 
     while( len_left > 0 )
     {
-        size_t use_len = len_left > 16 ? 16 : len_left;
-
-        if( mode == CCM_ENCRYPT )
+        if( separate && len_left >= 16 )
         {
-            memset( b, 0, 16 );
-            memcpy( b, src, use_len );
-            UPDATE_CBC_MAC;
+            ks = dst;
+            blocks = len_left / 16;
         }
-
-        CTR_CRYPT( dst, src, use_len );
-
-        if( mode == CCM_DECRYPT )
+        else
         {
-            memset( b, 0, 16 );
-            memcpy( b, dst, use_len );
-            UPDATE_CBC_MAC;
+            ks = stream;
+            blocks = ( len_left + 15 ) / 16;
+            if( blocks > CCM_BATCH_BLOCKS )
+                blocks = CCM_BATCH_BLOCKS;
         }
 
-        dst += use_len;
-        src += use_len;
-        len_left -= use_len;
-
         /*
-         * Increment counter.
+         * Counter blocks, then their key stream in one call.
          * No need to check for overflow thanks to the length check above.
          */
-        for( i = 0; i < q; i++ )
-            if( ++ctr[15-i] != 0 )
-                break;
+        for( j = 0; j < blocks; j++ )
+        {
+            memcpy( ks + 16 * j, ctr, 16 );
+
+            for( i = 0; i < q; i++ )
+                if( ++ctr[15-i] != 0 )
+                    break;
+        }
+
+        if( ( ret = mbedtls_cipher_update( &ctx->cipher_ctx, ks, 16 * blocks,
+                                           ks, &olen ) ) != 0 )
+        {
+            return( ret );
+        }
+
+        for( j = 0; j < blocks; j++ )
+        {
+            size_t k, use_len = len_left > 16 ? 16 : len_left;
+
+            if( mode == CCM_ENCRYPT )
+            {
+                memset( b, 0, 16 );
+                memcpy( b, src, use_len );
+                UPDATE_CBC_MAC;
+            }
+
+            for( k = 0; k < use_len; k++ )
+                dst[k] = src[k] ^ ks[k];
+
+            if( mode == CCM_DECRYPT )
+            {
+                memset( b, 0, 16 );
+                memcpy( b, dst, use_len );
+                UPDATE_CBC_MAC;
+            }
+
+            dst += use_len;
+            src += use_len;
+            ks += 16;
+            len_left -= use_len;
+        }
     }
 
     /*
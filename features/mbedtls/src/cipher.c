@@ -283,15 +283,27 @@ int mbedtls_cipher_update( mbedtls_cipher_context_t *ctx, const unsigned char *i
 
     if( ctx->cipher_info->mode == MBEDTLS_MODE_ECB )
     {
-        if( ilen != block_size )
+        if( ilen == 0 || block_size == 0 || ilen % block_size != 0 )
             return( MBEDTLS_ERR_CIPHER_FULL_BLOCK_EXPECTED );
 
         *olen = ilen;
 
-        if( 0 != ( ret = ctx->cipher_info->base->ecb_func( ctx->cipher_ctx,
-                    ctx->operation, input, output ) ) )
+        if( ilen > block_size && ctx->cipher_info->base->ecb_blocks_func != NULL )
         {
-            return( ret );
+            return( ctx->cipher_info->base->ecb_blocks_func( ctx->cipher_ctx,
+                        ctx->operation, ilen / block_size, input, output ) );
+        }
+
+        for( ; ilen > 0; ilen -= block_size )
+        {
+            if( 0 != ( ret = ctx->cipher_info->base->ecb_func( ctx->cipher_ctx,
+                        ctx->operation, input, output ) ) )
+            {
+                return( ret );
+            }
+
+            input  += block_size;
+            output += block_size;
         }
 
         return( 0 );
@@ -119,6 +119,13 @@ static int aes_crypt_ecb_wrap( void *ctx, mbedtls_operation_t operation,
     return mbedtls_aes_crypt_ecb( (mbedtls_aes_context *) ctx, operation, input, output );
 }
 
+static int aes_crypt_ecb_blocks_wrap( void *ctx, mbedtls_operation_t operation,
+        size_t blocks, const unsigned char *input, unsigned char *output )
+{
+    return mbedtls_aes_crypt_ecb_blocks( (mbedtls_aes_context *) ctx, operation,
+                                         blocks, input, output );
+}
+
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
 static int aes_crypt_cbc_wrap( void *ctx, mbedtls_operation_t operation, size_t length,
         unsigned char *iv, const unsigned char *input, unsigned char *output )
@@ -181,6 +188,7 @@ static void aes_ctx_free( void *ctx )
 static const mbedtls_cipher_base_t aes_info = {
     MBEDTLS_CIPHER_ID_AES,
     aes_crypt_ecb_wrap,
+    aes_crypt_ecb_blocks_wrap,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     aes_crypt_cbc_wrap,
 #endif
@@ -348,6 +356,7 @@ static int gcm_aes_setkey_wrap( void *ctx, const unsigned char *key,
 static const mbedtls_cipher_base_t gcm_aes_info = {
     MBEDTLS_CIPHER_ID_AES,
     NULL,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     NULL,
 #endif
@@ -411,6 +420,7 @@ static int ccm_aes_setkey_wrap( void *ctx, const unsigned char *key,
 static const mbedtls_cipher_base_t ccm_aes_info = {
     MBEDTLS_CIPHER_ID_AES,
     NULL,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     NULL,
 #endif
@@ -538,6 +548,7 @@ static void camellia_ctx_free( void *ctx )
 static const mbedtls_cipher_base_t camellia_info = {
     MBEDTLS_CIPHER_ID_CAMELLIA,
     camellia_crypt_ecb_wrap,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     camellia_crypt_cbc_wrap,
 #endif
@@ -705,6 +716,7 @@ static int gcm_camellia_setkey_wrap( void *ctx, const unsigned char *key,
 static const mbedtls_cipher_base_t gcm_camellia_info = {
     MBEDTLS_CIPHER_ID_CAMELLIA,
     NULL,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     NULL,
 #endif
@@ -768,6 +780,7 @@ static int ccm_camellia_setkey_wrap( void *ctx, const unsigned char *key,
 static const mbedtls_cipher_base_t ccm_camellia_info = {
     MBEDTLS_CIPHER_ID_CAMELLIA,
     NULL,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     NULL,
 #endif
@@ -944,6 +957,7 @@ static void des3_ctx_free( void *ctx )
 static const mbedtls_cipher_base_t des_info = {
     MBEDTLS_CIPHER_ID_DES,
     des_crypt_ecb_wrap,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     des_crypt_cbc_wrap,
 #endif
@@ -989,6 +1003,7 @@ static const mbedtls_cipher_info_t des_cbc_info = {
 static const mbedtls_cipher_base_t des_ede_info = {
     MBEDTLS_CIPHER_ID_DES,
     des3_crypt_ecb_wrap,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     des3_crypt_cbc_wrap,
 #endif
@@ -1034,6 +1049,7 @@ static const mbedtls_cipher_info_t des_ede_cbc_info = {
 static const mbedtls_cipher_base_t des_ede3_info = {
     MBEDTLS_CIPHER_ID_3DES,
     des3_crypt_ecb_wrap,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     des3_crypt_cbc_wrap,
 #endif
@@ -1143,6 +1159,7 @@ static void blowfish_ctx_free( void *ctx )
 static const mbedtls_cipher_base_t blowfish_info = {
     MBEDTLS_CIPHER_ID_BLOWFISH,
     blowfish_crypt_ecb_wrap,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     blowfish_crypt_cbc_wrap,
 #endif
@@ -1253,6 +1270,7 @@ static void arc4_ctx_free( void *ctx )
 static const mbedtls_cipher_base_t arc4_base_info = {
     MBEDTLS_CIPHER_ID_ARC4,
     NULL,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     NULL,
 #endif
@@ -1316,6 +1334,7 @@ static void null_ctx_free( void *ctx )
 static const mbedtls_cipher_base_t null_base_info = {
     MBEDTLS_CIPHER_ID_NULL,
     NULL,
+    NULL,
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     NULL,
 #endif
@@ -346,17 +346,30 @@ int mbedtls_gcm_starts( mbedtls_gcm_context *ctx,
     return( 0 );
 }
 
+/*
+ * The key stream is computed for several counter blocks per call to the
+ * cipher, then each block is XORed and folded into GHASH. When output does
+ * not overlap input, the key stream of all full blocks is computed in place
+ * in output, in one call, which lets an engine behind
+ * mbedtls_aes_crypt_ecb_blocks() take a whole record in one DMA transfer.
+ * Otherwise (in-place TLS records) it goes through a GCM_BATCH_BLOCKS
+ * buffer on the stack.
+ */
+#define GCM_BATCH_BLOCKS    8
+
 int mbedtls_gcm_update( mbedtls_gcm_context *ctx,
                 size_t length,
                 const unsigned char *input,
                 unsigned char *output )
 {
     int ret;
-    unsigned char ectr[16];
-    size_t i;
-    const unsigned char *p;
+    unsigned char ectr[16 * GCM_BATCH_BLOCKS];
+    unsigned char *stream;
+    size_t i, j, blocks, olen;
+    const unsigned char *p = input;
     unsigned char *out_p = output;
-    size_t use_len, olen = 0;
+    size_t use_len;
+    int separate;
 
     if( output > input && (size_t) ( output - input ) < length )
         return( MBEDTLS_ERR_GCM_BAD_INPUT );
@@ -371,35 +384,66 @@ int mbedtls_gcm_update( mbedtls_gcm_context *ctx,
 
     ctx->len += length;
 
-    p = input;
+    separate = output + length <= input || input + length <= output;
+
     while( length > 0 )
     {
-        use_len = ( length < 16 ) ? length : 16;
+        if( separate && length >= 16 )
+        {
+            stream = out_p;
+            blocks = length / 16;
+        }
+        else
+        {
+            stream = ectr;
+            blocks = ( length + 15 ) / 16;
+            if( blocks > GCM_BATCH_BLOCKS )
+                blocks = GCM_BATCH_BLOCKS;
+        }
 
-        for( i = 16; i > 12; i-- )
-            if( ++ctx->y[i - 1] != 0 )
-                break;
+        for( j = 0; j < blocks; j++ )
+        {
+            for( i = 16; i > 12; i-- )
+                if( ++ctx->y[i - 1] != 0 )
+                    break;
 
-        if( ( ret = mbedtls_cipher_update( &ctx->cipher_ctx, ctx->y, 16, ectr,
-                                   &olen ) ) != 0 )
+            memcpy( stream + 16 * j, ctx->y, 16 );
+        }
+
+        if( ( ret = mbedtls_cipher_update( &ctx->cipher_ctx, stream, 16 * blocks,
+                                           stream, &olen ) ) != 0 )
         {
             return( ret );
         }
 
-        for( i = 0; i < use_len; i++ )
+        for( j = 0; j < blocks; j++ )
         {
+            use_len = ( length < 16 ) ? length : 16;
+
             if( ctx->mode == MBEDTLS_GCM_DECRYPT )
-                ctx->buf[i] ^= p[i];
-            out_p[i] = ectr[i] ^ p[i];
-            if( ctx->mode == MBEDTLS_GCM_ENCRYPT )
-                ctx->buf[i] ^= out_p[i];
-        }
+            {
+                for( i = 0; i < use_len; i++ )
+                {
+                    ctx->buf[i] ^= p[i];
+                    out_p[i] = stream[i] ^ p[i];
+                }
+            }
+            else
+            {
+                for( i = 0; i < use_len; i++ )
+                {
+                    out_p[i] = stream[i] ^ p[i];
+                    ctx->buf[i] ^= out_p[i];
+                }
+            }
 
-        gcm_mult( ctx, ctx->buf, ctx->buf );
+            gcm_mult( ctx, ctx->buf, ctx->buf );
 
-        length -= use_len;
-        p += use_len;
-        out_p += use_len;
+            length -= use_len;
+            p += use_len;
+            out_p += use_len;
+            stream += 16;
+        }
     }
 
     return( 0 );
@@ -33,6 +33,7 @@
 #include "mbedtls/platform.h"
 
 #include <string.h>
+#include <stdint.h>
 
 #if defined(MBEDTLS_MEMORY_BACKTRACE)
 #include <execinfo.h>
@@ -73,7 +74,8 @@ typedef struct
     unsigned char   *buf;
     size_t          len;
     memory_header   *first;
-    memory_header   *first_free;
+    memory_header   *first_free[MBEDTLS_MEMORY_FREE_LISTS];
+    uint32_t        free_map;   /* bit i set if first_free[i] != NULL */
     int             verify;
 #if defined(MBEDTLS_MEMORY_DEBUG)
     size_t          alloc_count;
@@ -91,6 +93,168 @@ buffer_alloc_ctx;
 
 static buffer_alloc_ctx heap;
 
+/*
+ * Free blocks are segregated by size: one list per 16 bytes below 128 bytes,
+ * where most bignum limbs and small structures fall, then one list per power
+ * of two, the last list taking everything larger. A request first walks the
+ * list for its own size, whose blocks may be too small, then takes the head
+ * of the next non-empty list, whose blocks are all large enough. A block
+ * that is split or merged keeps its place in its list as long as its size
+ * stays in the same class, so with a single list this is exactly the
+ * original first-fit allocator.
+ *
+ * The lists bound the search, they do not make the allocator faster: on the
+ * mostly short-lived bignum limbs of a TLS handshake the first-fit walk is
+ * about one step long, and the blocks moving between size classes as they
+ * are split and merged make 20 lists about 1.5 times slower than one.
+ */
+#define FREE_LIST_SMALL_STEP    16
+#define FREE_LIST_SMALL_LIMIT   128
+#define FREE_LIST_SMALL_COUNT   ( FREE_LIST_SMALL_LIMIT / FREE_LIST_SMALL_STEP )
+
+static size_t free_list_index( size_t size )
+{
+    size_t index;
+
+    if( size < FREE_LIST_SMALL_LIMIT )
+        index = size / FREE_LIST_SMALL_STEP;
+    else
+    {
+        /* FREE_LIST_SMALL_COUNT + log2( size / FREE_LIST_SMALL_LIMIT ) */
+        index = FREE_LIST_SMALL_COUNT;
+        size /= FREE_LIST_SMALL_LIMIT;
+
+        if( size >= 1 << 8 ) { size >>= 8; index += 8; }
+        if( size >= 1 << 4 ) { size >>= 4; index += 4; }
+        if( size >= 1 << 2 ) { size >>= 2; index += 2; }
+        if( size >= 1 << 1 ) { index += 1; }
+    }
+
+    if( index >= MBEDTLS_MEMORY_FREE_LISTS )
+        index = MBEDTLS_MEMORY_FREE_LISTS - 1;
+
+    return( index );
+}
+
+/* Smallest size kept in list index */
+static size_t free_list_min( size_t index )
+{
+    if( index < FREE_LIST_SMALL_COUNT )
+        return( index * FREE_LIST_SMALL_STEP );
+
+    return( (size_t) FREE_LIST_SMALL_LIMIT << ( index - FREE_LIST_SMALL_COUNT ) );
+}
+
+/* Whether a block of list index has grown past its size class */
+static int free_list_outgrown( size_t index, size_t size )
+{
+#if MBEDTLS_MEMORY_FREE_LISTS > 1
+    return( index < MBEDTLS_MEMORY_FREE_LISTS - 1 &&
+            size >= free_list_min( index + 1 ) );
+#else
+    ((void) index);
+    ((void) size);
+    return( 0 );
+#endif
+}
+
+static void free_list_insert( memory_header *hdr )
+{
+    size_t index = free_list_index( hdr->size );
+
+    hdr->prev_free = NULL;
+    hdr->next_free = heap.first_free[index];
+
+    if( hdr->next_free != NULL )
+        hdr->next_free->prev_free = hdr;
+
+    heap.first_free[index] = hdr;
+    heap.free_map |= (uint32_t) 1 << index;
+}
+
+static void free_list_remove( memory_header *hdr, size_t index )
+{
+    if( hdr->prev_free != NULL )
+        hdr->prev_free->next_free = hdr->next_free;
+    else
+    {
+        heap.first_free[index] = hdr->next_free;
+
+        if( hdr->next_free == NULL )
+            heap.free_map &= ~( (uint32_t) 1 << index );
+    }
+
+    if( hdr->next_free != NULL )
+        hdr->next_free->prev_free = hdr->prev_free;
+
+    hdr->prev_free = NULL;
+    hdr->next_free = NULL;
+}
+
+/* Put hdr in place of old, in list index */
+static void free_list_replace( memory_header *old, memory_header *hdr,
+                               size_t index )
+{
+    hdr->prev_free = old->prev_free;
+    hdr->next_free = old->next_free;
+
+    if( hdr->prev_free != NULL )
+        hdr->prev_free->next_free = hdr;
+    else
+        heap.first_free[index] = hdr;
+
+    if( hdr->next_free != NULL )
+        hdr->next_free->prev_free = hdr;
+
+    old->prev_free = NULL;
+    old->next_free = NULL;
+}
+
+#if MBEDTLS_MEMORY_FREE_LISTS > 1
+/* Index of the lowest bit set in a non-zero map (de Bruijn sequence) */
+static size_t free_list_lowest( uint32_t map )
+{
+    static const unsigned char debruijn[32] =
+    {
+         0,  1, 28,  2, 29, 14, 24,  3, 30, 22, 20, 15, 25, 17,  4,  8,
+        31, 27, 13, 23, 21, 19, 16,  7, 26, 12, 18,  6, 11,  5, 10,  9
+    };
+
+    return( debruijn[( ( map & ( ~map + 1 ) ) * 0x077CB531UL ) >> 27 & 31] );
+}
+#endif
+
+static memory_header *free_list_find( size_t len, size_t *index )
+{
+    memory_header *cur;
+#if MBEDTLS_MEMORY_FREE_LISTS > 1
+    uint32_t map;
+#endif
+    size_t i = free_list_index( len );
+
+    for( cur = heap.first_free[i]; cur != NULL; cur = cur->next_free )
+    {
+        if( cur->size >= len )
+        {
+            *index = i;
+            return( cur );
+        }
+    }
+
+#if MBEDTLS_MEMORY_FREE_LISTS > 1
+    // Any block of a larger size class fits
+    //
+    map = heap.free_map >> i >> 1;
+    if( map == 0 )
+        return( NULL );
+
+    *index = i + 1 + free_list_lowest( map );
+    return( heap.first_free[*index] );
+#else
+    return( NULL );
+#endif
+}
+
 #if defined(MBEDTLS_MEMORY_DEBUG)
 static void debug_header( memory_header *hdr )
 {
@@ -116,6 +280,7 @@ static void debug_header( memory_header *hdr )
 static void debug_chain()
 {
     memory_header *cur = heap.first;
+    size_t i;
 
     mbedtls_fprintf( stderr, "\nBlock list\n" );
     while( cur != NULL )
@@ -124,13 +289,19 @@ static void debug_chain()
         cur = cur->next;
     }
 
-    mbedtls_fprintf( stderr, "Free list\n" );
-    cur = heap.first_free;
-
-    while( cur != NULL )
+    for( i = 0; i < MBEDTLS_MEMORY_FREE_LISTS; i++ )
     {
-        debug_header( cur );
-        cur = cur->next_free;
+        if( heap.first_free[i] == NULL )
+            continue;
+
+        mbedtls_fprintf( stderr, "Free list %zu\n", i );
+        cur = heap.first_free[i];
+
+        while( cur != NULL )
+        {
+            debug_header( cur );
+            cur = cur->next_free;
+        }
     }
 }
 #endif /* MBEDTLS_MEMORY_DEBUG */
@@ -180,6 +351,49 @@ static int verify_header( memory_header *hdr )
     return( 0 );
 }
 
+static int verify_free_lists()
+{
+    memory_header *prv, *cur;
+    size_t i;
+
+    for( i = 0; i < MBEDTLS_MEMORY_FREE_LISTS; i++ )
+    {
+        if( ( heap.first_free[i] != NULL ) !=
+            ( ( heap.free_map >> i ) & 1 ) )
+        {
+#if defined(MBEDTLS_MEMORY_DEBUG)
+            mbedtls_fprintf( stderr, "FATAL: verification failed: "
+                                      "free map out of date\n" );
+#endif
+            return( 1 );
+        }
+
+        for( prv = NULL, cur = heap.first_free[i]; cur != NULL;
+             prv = cur, cur = cur->next_free )
+        {
+            if( cur->alloc != 0 || cur->prev_free != prv )
+            {
+#if defined(MBEDTLS_MEMORY_DEBUG)
+                mbedtls_fprintf( stderr, "FATAL: verification failed: "
+                                          "bad block in free list\n" );
+#endif
+                return( 1 );
+            }
+
+            if( free_list_index( cur->size ) != i )
+            {
+#if defined(MBEDTLS_MEMORY_DEBUG)
+                mbedtls_fprintf( stderr, "FATAL: verification failed: "
+                                          "block in wrong free list\n" );
+#endif
+                return( 1 );
+            }
+        }
+    }
+
+    return( 0 );
+}
+
 static int verify_chain()
 {
     memory_header *prv = heap.first, *cur = heap.first->next;
@@ -226,15 +440,15 @@ static int verify_chain()
         cur = cur->next;
     }
 
-    return( 0 );
+    return( verify_free_lists() );
 }
 
 static void *buffer_alloc_calloc( size_t n, size_t size )
 {
-    memory_header *new, *cur = heap.first_free;
+    memory_header *new, *cur;
     unsigned char *p;
     void *ret;
-    size_t original_len, len;
+    size_t original_len, len, index;
 #if defined(MBEDTLS_MEMORY_BACKTRACE)
     void *trace_buffer[MAX_BT];
     size_t trace_cnt;
@@ -256,13 +470,7 @@ static void *buffer_alloc_calloc( size_t n, size_t size )
 
     // Find block that fits
     //
-    while( cur != NULL )
-    {
-        if( cur->size >= len )
-            break;
-
-        cur = cur->next_free;
-    }
+    cur = free_list_find( len, &index );
 
     if( cur == NULL )
         return( NULL );
@@ -285,21 +493,9 @@ static void *buffer_alloc_calloc( size_t n, size_t size )
     if( cur->size - len < sizeof(memory_header) +
                           MBEDTLS_MEMORY_ALIGN_MULTIPLE )
     {
+        free_list_remove( cur, index );
         cur->alloc = 1;
 
-        // Remove from free_list
-        //
-        if( cur->prev_free != NULL )
-            cur->prev_free->next_free = cur->next_free;
-        else
-            heap.first_free = cur->next_free;
-
-        if( cur->next_free != NULL )
-            cur->next_free->prev_free = cur->prev_free;
-
-        cur->prev_free = NULL;
-        cur->next_free = NULL;
-
 #if defined(MBEDTLS_MEMORY_DEBUG)
         heap.total_used += cur->size;
         if( heap.total_used > heap.maximum_used )
@@ -337,23 +533,20 @@ static void *buffer_alloc_calloc( size_t n, size_t size )
     if( new->next != NULL )
         new->next->prev = new;
 
-    // Replace cur with new in free_list
+    // Replace cur with new in the free list, unless the rest of the block
+    // belongs to a smaller size class
     //
-    new->prev_free = cur->prev_free;
-    new->next_free = cur->next_free;
-    if( new->prev_free != NULL )
-        new->prev_free->next_free = new;
+    if( new->size >= free_list_min( index ) )
+        free_list_replace( cur, new, index );
     else
-        heap.first_free = new;
-
-    if( new->next_free != NULL )
-        new->next_free->prev_free = new;
+    {
+        free_list_remove( cur, index );
+        free_list_insert( new );
+    }
 
     cur->alloc = 1;
     cur->size = len;
     cur->next = new;
-    cur->prev_free = NULL;
-    cur->next_free = NULL;
 
 #if defined(MBEDTLS_MEMORY_DEBUG)
     heap.header_count++;
@@ -382,6 +575,7 @@ static void buffer_alloc_free( void *ptr )
 {
     memory_header *hdr, *old = NULL;
     unsigned char *p = (unsigned char *) ptr;
+    size_t index = 0;
 
     if( ptr == NULL || heap.buf == NULL || heap.first == NULL )
         return;
@@ -430,6 +624,7 @@ static void buffer_alloc_free( void *ptr )
 #if defined(MBEDTLS_MEMORY_DEBUG)
         heap.header_count--;
 #endif
+        index = free_list_index( hdr->prev->size );
         hdr->prev->size += sizeof(memory_header) + hdr->size;
         hdr->prev->next = hdr->next;
         old = hdr;
@@ -448,47 +643,33 @@ static void buffer_alloc_free( void *ptr )
 #if defined(MBEDTLS_MEMORY_DEBUG)
         heap.header_count--;
 #endif
+        // The merged block takes the place of the block after in its list
+        //
+        if( old != NULL )
+            free_list_remove( hdr, index );
+        index = free_list_index( hdr->next->size );
+        free_list_replace( hdr->next, hdr, index );
+
         hdr->size += sizeof(memory_header) + hdr->next->size;
         old = hdr->next;
         hdr->next = hdr->next->next;
 
-        if( hdr->prev_free != NULL || hdr->next_free != NULL )
-        {
-            if( hdr->prev_free != NULL )
-                hdr->prev_free->next_free = hdr->next_free;
-            else
-                heap.first_free = hdr->next_free;
-
-            if( hdr->next_free != NULL )
-                hdr->next_free->prev_free = hdr->prev_free;
-        }
-
-        hdr->prev_free = old->prev_free;
-        hdr->next_free = old->next_free;
-
-        if( hdr->prev_free != NULL )
-            hdr->prev_free->next_free = hdr;
-        else
-            heap.first_free = hdr;
-
-        if( hdr->next_free != NULL )
-            hdr->next_free->prev_free = hdr;
-
         if( hdr->next != NULL )
             hdr->next->prev = hdr;
 
         memset( old, 0, sizeof(memory_header) );
     }
 
-    // Prepend to free_list if we have not merged
+    // Prepend to the free list for its size if we have not merged, or move
+    // the merged block to a larger size class
     // (Does not have to stay in same order as prev / next list)
     //
     if( old == NULL )
+        free_list_insert( hdr );
+    else if( free_list_outgrown( index, hdr->size ) )
     {
-        hdr->next_free = heap.first_free;
-        if( heap.first_free != NULL )
-            heap.first_free->prev_free = hdr;
-        heap.first_free = hdr;
+        free_list_remove( hdr, index );
+        free_list_insert( hdr );
     }
 
     if( ( heap.verify & MBEDTLS_MEMORY_VERIFY_FREE ) && verify_chain() != 0 )
@@ -597,7 +778,7 @@ void mbedtls_memory_buffer_alloc_init( unsigned char *buf, size_t len )
     heap.first->size = len - sizeof(memory_header);
     heap.first->magic1 = MAGIC1;
     heap.first->magic2 = MAGIC2;
-    heap.first_free = heap.first;
+    free_list_insert( heap.first );
 }
 
 void mbedtls_memory_buffer_alloc_free()
@@ -626,7 +807,9 @@ static int check_all_free( )
 #if defined(MBEDTLS_MEMORY_DEBUG)
         heap.total_used != 0 ||
 #endif
-        heap.first != heap.first_free ||
+        heap.first->next != NULL ||
+        heap.first_free[free_list_index( heap.first->size )] != heap.first ||
+        heap.free_map != (uint32_t) 1 << free_list_index( heap.first->size ) ||
         (void *) heap.first != (void *) heap.buf )
     {
         return( -1 );
@@ -735,6 +918,44 @@ int mbedtls_memory_buffer_alloc_self_test( int verbose )
     if( verbose != 0 )
         mbedtls_printf( "passed\n" );
 
+    if( verbose != 0 )
+        mbedtls_printf( "  MBA test #4 (fragmented): " );
+
+    mbedtls_memory_buffer_alloc_init( buf, sizeof( buf ) );
+    mbedtls_memory_buffer_set_verify( MBEDTLS_MEMORY_VERIFY_ALWAYS );
+
+    {
+        unsigned char *blocks[8];
+        size_t i;
+
+        /* Small blocks of different sizes, then free every other one */
+        for( i = 0; i < 8; i++ )
+        {
+            blocks[i] = mbedtls_calloc( 1, 8 + 12 * i );
+            TEST_ASSERT( check_pointer( blocks[i] ) == 0 );
+        }
+
+        for( i = 0; i < 8; i += 2 )
+            mbedtls_free( blocks[i] );
+
+        /* The holes are reused, largest first so that each fits exactly */
+        for( i = 8; i > 0; i -= 2 )
+        {
+            p = mbedtls_calloc( 1, 8 + 12 * ( i - 2 ) );
+            TEST_ASSERT( p == blocks[i - 2] );
+        }
+
+        for( i = 0; i < 8; i++ )
+            mbedtls_free( blocks[i] );
+    }
+
+    TEST_ASSERT( check_all_free( ) == 0 );
+
+    mbedtls_memory_buffer_alloc_free( );
+
+    if( verbose != 0 )
+        mbedtls_printf( "passed\n" );
+
 cleanup:
     mbedtls_memory_buffer_alloc_free( );
 
@@ -73,6 +73,38 @@ void mbedtls_pk_free( mbedtls_pk_context *ctx )
     mbedtls_zeroize( ctx, sizeof( mbedtls_pk_context ) );
 }
 
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
+/*
+ * Initialize a restart context
+ */
+void mbedtls_pk_restart_init( mbedtls_pk_restart_ctx *ctx )
+{
+    mbedtls_ecdsa_restart_init( &ctx->ecdsa );
+}
+
+/*
+ * Free the components of a restart context
+ */
+void mbedtls_pk_restart_free( mbedtls_pk_restart_ctx *ctx )
+{
+    if( ctx == NULL )
+        return;
+
+    mbedtls_ecdsa_restart_free( &ctx->ecdsa );
+}
+
+/*
+ * Tell if restartable ECDSA can be used with this context and arguments
+ */
+static int pk_restart_can_do( const mbedtls_pk_context *ctx,
+                              const mbedtls_pk_restart_ctx *rs_ctx )
+{
+    return( rs_ctx != NULL && mbedtls_ecp_restart_is_enabled() &&
+            ( mbedtls_pk_get_type( ctx ) == MBEDTLS_PK_ECKEY ||
+              mbedtls_pk_get_type( ctx ) == MBEDTLS_PK_ECDSA ) );
+}
+#endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_RESTARTABLE */
+
 /*
  * Get pk_info structure from type
  */
@@ -193,6 +225,39 @@ int mbedtls_pk_verify( mbedtls_pk_context *ctx, mbedtls_md_type_t md_alg,
                                        sig, sig_len ) );
 }
 
+/*
+ * Verify a signature (restartable)
+ */
+int mbedtls_pk_verify_restartable( mbedtls_pk_context *ctx,
+               mbedtls_md_type_t md_alg,
+               const unsigned char *hash, size_t hash_len,
+               const unsigned char *sig, size_t sig_len,
+               mbedtls_pk_restart_ctx *rs_ctx )
+{
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
+    int ret;
+
+    if( ctx == NULL || ctx->pk_info == NULL ||
+        pk_hashlen_helper( md_alg, &hash_len ) != 0 )
+        return( MBEDTLS_ERR_PK_BAD_INPUT_DATA );
+
+    if( pk_restart_can_do( ctx, rs_ctx ) )
+    {
+        ret = mbedtls_ecdsa_read_signature_restartable( mbedtls_pk_ec( *ctx ),
+                                    hash, hash_len, sig, sig_len, &rs_ctx->ecdsa );
+
+        if( ret == MBEDTLS_ERR_ECP_SIG_LEN_MISMATCH )
+            return( MBEDTLS_ERR_PK_SIG_LEN_MISMATCH );
+
+        return( ret );
+    }
+#else
+    (void) rs_ctx;
+#endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_RESTARTABLE */
+
+    return( mbedtls_pk_verify( ctx, md_alg, hash, hash_len, sig, sig_len ) );
+}
+
 /*
  * Verify a signature with options
  */
@@ -270,6 +335,35 @@ int mbedtls_pk_sign( mbedtls_pk_context *ctx, mbedtls_md_type_t md_alg,
                                      sig, sig_len, f_rng, p_rng ) );
 }
 
+/*
+ * Make a signature (restartable)
+ */
+int mbedtls_pk_sign_restartable( mbedtls_pk_context *ctx,
+             mbedtls_md_type_t md_alg,
+             const unsigned char *hash, size_t hash_len,
+             unsigned char *sig, size_t *sig_len,
+             int (*f_rng)(void *, unsigned char *, size_t), void *p_rng,
+             mbedtls_pk_restart_ctx *rs_ctx )
+{
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
+    if( ctx == NULL || ctx->pk_info == NULL ||
+        pk_hashlen_helper( md_alg, &hash_len ) != 0 )
+        return( MBEDTLS_ERR_PK_BAD_INPUT_DATA );
+
+    if( pk_restart_can_do( ctx, rs_ctx ) )
+    {
+        return( mbedtls_ecdsa_write_signature_restartable( mbedtls_pk_ec( *ctx ),
+                    md_alg, hash, hash_len, sig, sig_len, f_rng, p_rng,
+                    &rs_ctx->ecdsa ) );
+    }
+#else
+    (void) rs_ctx;
+#endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_RESTARTABLE */
+
+    return( mbedtls_pk_sign( ctx, md_alg, hash, hash_len, sig, sig_len,
+                             f_rng, p_rng ) );
+}
+
 /*
  * Decrypt message
  */
@@ -2236,7 +2236,7 @@ static void ssl_write_ecjpake_kkpp_ext( mbedtls_ssl_context *ssl,
 {
     int ret;
     unsigned char *p = buf;
-    const unsigned char *end = ssl->out_msg + MBEDTLS_SSL_MAX_CONTENT_LEN;
+    const unsigned char *end = ssl->out_msg + MBEDTLS_SSL_OUT_CONTENT_LEN( ssl );
     size_t kkpp_len;
 
     *olen = 0;
@@ -2343,7 +2343,7 @@ static int ssl_write_hello_verify_request( mbedtls_ssl_context *ssl )
     cookie_len_byte = p++;
 
     if( ( ret = ssl->conf->f_cookie_write( ssl->conf->p_cookie,
-                                     &p, ssl->out_buf + MBEDTLS_SSL_BUFFER_LEN,
+                                     &p, ssl->out_buf + MBEDTLS_SSL_OUT_BUFFER_LEN( ssl ),
                                      ssl->cli_id, ssl->cli_id_len ) ) != 0 )
     {
         MBEDTLS_SSL_DEBUG_RET( 1, "f_cookie_write", ret );
@@ -2639,7 +2639,7 @@ static int ssl_write_certificate_request( mbedtls_ssl_context *ssl )
     size_t dn_size, total_dn_size; /* excluding length bytes */
     size_t ct_len, sa_len; /* including length bytes */
     unsigned char *buf, *p;
-    const unsigned char * const end = ssl->out_msg + MBEDTLS_SSL_MAX_CONTENT_LEN;
+    const unsigned char *end;
     const mbedtls_x509_crt *crt;
     int authmode;
 
@@ -2677,8 +2677,31 @@ static int ssl_write_certificate_request( mbedtls_ssl_context *ssl )
      *    n+4 .. ...  Distinguished Name #1
      *    ... .. ...  length of DN 2, etc.
      */
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    /* Certificate types and signature algorithms fit in 64 bytes */
+    total_dn_size = 0;
+
+    if( ssl->conf->cert_req_ca_list ==  MBEDTLS_SSL_CERT_REQ_CA_LIST_ENABLED )
+    {
+#if defined(MBEDTLS_SSL_SERVER_NAME_INDICATION)
+        if( ssl->handshake->sni_ca_chain != NULL )
+            crt = ssl->handshake->sni_ca_chain;
+        else
+#endif
+            crt = ssl->conf->ca_chain;
+
+        for( ; crt != NULL && crt->version != 0; crt = crt->next )
+            total_dn_size += 2 + crt->subject_raw.len;
+    }
+
+    if( ( ret = mbedtls_ssl_out_buffer_ensure( ssl,
+                    4 + 64 + 2 + total_dn_size ) ) != 0 )
+        return( ret );
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
+
     buf = ssl->out_msg;
     p = buf + 4;
+    end = ssl->out_msg + MBEDTLS_SSL_OUT_CONTENT_LEN( ssl );
 
     /*
      * Supported certificate types
@@ -2837,10 +2860,10 @@ static int ssl_write_server_key_exchange( mbedtls_ssl_context *ssl )
                             ssl->transform_negotiate->ciphersuite_info;
 
 #if defined(MBEDTLS_KEY_EXCHANGE__SOME_PFS__ENABLED)
-    unsigned char *p = ssl->out_msg + 4;
+    unsigned char *p;
     size_t len;
 #if defined(MBEDTLS_KEY_EXCHANGE__WITH_SERVER_SIGNATURE__ENABLED)
-    unsigned char *dig_signed = p;
+    unsigned char *dig_signed;
     size_t dig_signed_len = 0;
 #endif /* MBEDTLS_KEY_EXCHANGE__WITH_SERVER_SIGNATURE__ENABLED */
 #endif /* MBEDTLS_KEY_EXCHANGE__SOME_PFS__ENABLED */
@@ -2874,6 +2897,27 @@ static int ssl_write_server_key_exchange( mbedtls_ssl_context *ssl )
     }
 #endif /* MBEDTLS_KEY_EXCHANGE__NON_PFS__ENABLED */
 
+#if defined(MBEDTLS_KEY_EXCHANGE__SOME_PFS__ENABLED)
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    /*
+     * Room for EC or EC J-PAKE parameters and a signature, plus the DHM
+     * parameters for DHE suites
+     */
+    len = 4 + 2 + 256 + 4 + MBEDTLS_MPI_MAX_SIZE;
+#if defined(MBEDTLS_KEY_EXCHANGE__SOME__DHE_ENABLED)
+    if( mbedtls_ssl_ciphersuite_uses_dhe( ciphersuite_info ) )
+        len += 3 * ( 2 + mbedtls_mpi_size( &ssl->conf->dhm_P ) );
+#endif
+    if( ( ret = mbedtls_ssl_out_buffer_ensure( ssl, len ) ) != 0 )
+        return( ret );
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
+
+    p = ssl->out_msg + 4;
+#if defined(MBEDTLS_KEY_EXCHANGE__WITH_SERVER_SIGNATURE__ENABLED)
+    dig_signed = p;
+#endif
+#endif /* MBEDTLS_KEY_EXCHANGE__SOME_PFS__ENABLED */
+
     /*
      *
      * Part 2: Provide key exchange parameters for chosen ciphersuite.
@@ -2886,7 +2930,7 @@ static int ssl_write_server_key_exchange( mbedtls_ssl_context *ssl )
 #if defined(MBEDTLS_KEY_EXCHANGE_ECJPAKE_ENABLED)
     if( ciphersuite_info->key_exchange == MBEDTLS_KEY_EXCHANGE_ECJPAKE )
     {
-        const unsigned char *end = ssl->out_msg + MBEDTLS_SSL_MAX_CONTENT_LEN;
+        const unsigned char *end = ssl->out_msg + MBEDTLS_SSL_OUT_CONTENT_LEN( ssl );
 
         ret = mbedtls_ecjpake_write_round_two( &ssl->handshake->ecjpake_ctx,
                 p, end - p, &len, ssl->conf->f_rng, ssl->conf->p_rng );
@@ -3002,6 +3046,24 @@ curve_matching_done:
 
         MBEDTLS_SSL_DEBUG_MSG( 2, ( "ECDHE curve: %s", (*curve)->name ) );
 
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+        /* The parameters are already in the output buffer */
+        if( ssl->handshake->ecrs_state == ssl_ecrs_ske_sign )
+        {
+            len = ssl->handshake->ecrs_n;
+            goto ecdh_params_done;
+        }
+
+        if( ssl->handshake->ecrs_state == ssl_ecrs_ske_ecdh_params )
+            goto ecdh_make_params;
+
+        if( ssl->handshake->ecrs_enabled )
+        {
+            mbedtls_ecdh_enable_restart( &ssl->handshake->ecdh_ctx );
+            ssl->handshake->ecrs_state = ssl_ecrs_ske_ecdh_params;
+        }
+#endif
+
         if( ( ret = mbedtls_ecp_group_load( &ssl->handshake->ecdh_ctx.grp,
                                        (*curve)->grp_id ) ) != 0 )
         {
@@ -3009,14 +3071,30 @@ curve_matching_done:
             return( ret );
         }
 
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+ecdh_make_params:
+#endif
         if( ( ret = mbedtls_ecdh_make_params( &ssl->handshake->ecdh_ctx, &len,
-                                      p, MBEDTLS_SSL_MAX_CONTENT_LEN - n,
+                                      p, MBEDTLS_SSL_OUT_CONTENT_LEN( ssl ) - n,
                                       ssl->conf->f_rng, ssl->conf->p_rng ) ) != 0 )
         {
             MBEDTLS_SSL_DEBUG_RET( 1, "mbedtls_ecdh_make_params", ret );
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+            if( ret == MBEDTLS_ERR_ECP_IN_PROGRESS )
+                ret = MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS;
+#endif
             return( ret );
         }
 
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+        if( ssl->handshake->ecrs_enabled )
+        {
+            ssl->handshake->ecrs_n = len;
+            ssl->handshake->ecrs_state = ssl_ecrs_ske_sign;
+        }
+
+ecdh_params_done:
+#endif
 #if defined(MBEDTLS_KEY_EXCHANGE__WITH_SERVER_SIGNATURE__ENABLED)
         dig_signed     = p;
         dig_signed_len = len;
@@ -3041,6 +3119,7 @@ curve_matching_done:
         size_t signature_len = 0;
         unsigned int hashlen = 0;
         unsigned char hash[64];
+        mbedtls_pk_restart_ctx *rs_ctx = NULL;
 
         /*
          * 3.1: Choose hash algorithm:
@@ -3211,10 +3290,20 @@ curve_matching_done:
         }
 #endif /* MBEDTLS_SSL_PROTO_TLS1_2 */
 
-        if( ( ret = mbedtls_pk_sign( mbedtls_ssl_own_key( ssl ), md_alg, hash, hashlen,
-                        p + 2 , &signature_len, ssl->conf->f_rng, ssl->conf->p_rng ) ) != 0 )
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+        if( ssl->handshake->ecrs_enabled )
+            rs_ctx = &ssl->handshake->ecrs_ctx;
+#endif
+
+        if( ( ret = mbedtls_pk_sign_restartable( mbedtls_ssl_own_key( ssl ),
+                        md_alg, hash, hashlen, p + 2 , &signature_len,
+                        ssl->conf->f_rng, ssl->conf->p_rng, rs_ctx ) ) != 0 )
         {
             MBEDTLS_SSL_DEBUG_RET( 1, "mbedtls_pk_sign", ret );
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+            if( ret == MBEDTLS_ERR_ECP_IN_PROGRESS )
+                ret = MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS;
+#endif
             return( ret );
         }
 
@@ -3491,6 +3580,10 @@ static int ssl_parse_client_key_exchange( mbedtls_ssl_context *ssl )
 
     MBEDTLS_SSL_DEBUG_MSG( 2, ( "=> parse client key exchange" ) );
 
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+    /* When resuming the ECDH computation the message is still in in_msg */
+    if( ssl->handshake->ecrs_state != ssl_ecrs_cke_ecdh_calc_secret )
+#endif
     if( ( ret = mbedtls_ssl_read_record( ssl ) ) != 0 )
     {
         MBEDTLS_SSL_DEBUG_RET( 1, "mbedtls_ssl_read_record", ret );
@@ -3559,6 +3652,14 @@ static int ssl_parse_client_key_exchange( mbedtls_ssl_context *ssl )
 
         MBEDTLS_SSL_DEBUG_ECP( 3, "ECDH: Qp ", &ssl->handshake->ecdh_ctx.Qp );
 
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+        if( ssl->handshake->ecrs_enabled )
+        {
+            mbedtls_ecdh_enable_restart( &ssl->handshake->ecdh_ctx );
+            ssl->handshake->ecrs_state = ssl_ecrs_cke_ecdh_calc_secret;
+        }
+#endif
+
         if( ( ret = mbedtls_ecdh_calc_secret( &ssl->handshake->ecdh_ctx,
                                       &ssl->handshake->pmslen,
                                        ssl->handshake->premaster,
@@ -3566,6 +3667,10 @@ static int ssl_parse_client_key_exchange( mbedtls_ssl_context *ssl )
                                        ssl->conf->f_rng, ssl->conf->p_rng ) ) != 0 )
         {
             MBEDTLS_SSL_DEBUG_RET( 1, "mbedtls_ecdh_calc_secret", ret );
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+            if( ret == MBEDTLS_ERR_ECP_IN_PROGRESS )
+                return( MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS );
+#endif
             return( MBEDTLS_ERR_SSL_BAD_HS_CLIENT_KEY_EXCHANGE_CS );
         }
 
@@ -3951,6 +4056,18 @@ static int ssl_write_new_session_ticket( mbedtls_ssl_context *ssl )
 
     MBEDTLS_SSL_DEBUG_MSG( 2, ( "=> write new session ticket" ) );
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    /* The ticket holds the session, the peer certificate and up to 64
+     * bytes of key name, IV and tag */
+    tlen = 10 + 64 + sizeof( mbedtls_ssl_session ) + 3;
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    if( ssl->session_negotiate->peer_cert != NULL )
+        tlen += ssl->session_negotiate->peer_cert->raw.len;
+#endif
+    if( ( ret = mbedtls_ssl_out_buffer_ensure( ssl, tlen ) ) != 0 )
+        return( ret );
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
+
     ssl->out_msgtype = MBEDTLS_SSL_MSG_HANDSHAKE;
     ssl->out_msg[0]  = MBEDTLS_SSL_HS_NEW_SESSION_TICKET;
 
@@ -3968,7 +4085,7 @@ static int ssl_write_new_session_ticket( mbedtls_ssl_context *ssl )
     if( ( ret = ssl->conf->f_ticket_write( ssl->conf->p_ticket,
                                 ssl->session_negotiate,
                                 ssl->out_msg + 10,
-                                ssl->out_msg + MBEDTLS_SSL_MAX_CONTENT_LEN,
+                                ssl->out_msg + MBEDTLS_SSL_OUT_CONTENT_LEN( ssl ),
                                 &tlen, &lifetime ) ) != 0 )
     {
         MBEDTLS_SSL_DEBUG_RET( 1, "mbedtls_ssl_ticket_write", ret );
@@ -2185,6 +2185,139 @@ static int ssl_resend_hello_request( mbedtls_ssl_context *ssl )
 #endif
 #endif /* MBEDTLS_SSL_SRV_C && MBEDTLS_SSL_RENEGOTIATION */
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+/*
+ * Move a record buffer to a new allocation of new_len bytes, keeping its
+ * leading bytes (record counter, header and any pending data) and updating
+ * the pointers into it. The old buffer is wiped before it is freed.
+ */
+static int ssl_buffer_resize( unsigned char **buf, size_t *buf_len,
+                              size_t new_len,
+                              unsigned char ***ptrs, size_t n_ptrs )
+{
+    unsigned char *new_buf;
+    size_t i;
+
+    if( new_len == *buf_len )
+        return( 0 );
+
+    if( ( new_buf = mbedtls_calloc( 1, new_len ) ) == NULL )
+        return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
+
+    memcpy( new_buf, *buf, new_len < *buf_len ? new_len : *buf_len );
+
+    for( i = 0; i < n_ptrs; i++ )
+    {
+        if( *ptrs[i] != NULL )
+            *ptrs[i] = new_buf + ( *ptrs[i] - *buf );
+    }
+
+    mbedtls_zeroize( *buf, *buf_len );
+    mbedtls_free( *buf );
+
+    *buf = new_buf;
+    *buf_len = new_len;
+
+    return( 0 );
+}
+
+static int ssl_in_buffer_resize( mbedtls_ssl_context *ssl, size_t len )
+{
+    int ret;
+    unsigned char **ptrs[6];
+
+    ptrs[0] = &ssl->in_ctr;
+    ptrs[1] = &ssl->in_hdr;
+    ptrs[2] = &ssl->in_len;
+    ptrs[3] = &ssl->in_iv;
+    ptrs[4] = &ssl->in_msg;
+    ptrs[5] = &ssl->in_offt;
+
+    if( ( ret = ssl_buffer_resize( &ssl->in_buf, &ssl->in_buf_len, len,
+                                   ptrs, 6 ) ) != 0 )
+    {
+        MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc(%d bytes) failed", len ) );
+        return( ret );
+    }
+
+    MBEDTLS_SSL_DEBUG_MSG( 3, ( "input buffer resized to %d bytes", len ) );
+
+    return( 0 );
+}
+
+static int ssl_out_buffer_resize( mbedtls_ssl_context *ssl, size_t len )
+{
+    int ret;
+    unsigned char **ptrs[5];
+
+    ptrs[0] = &ssl->out_ctr;
+    ptrs[1] = &ssl->out_hdr;
+    ptrs[2] = &ssl->out_len;
+    ptrs[3] = &ssl->out_iv;
+    ptrs[4] = &ssl->out_msg;
+
+    if( ( ret = ssl_buffer_resize( &ssl->out_buf, &ssl->out_buf_len, len,
+                                   ptrs, 5 ) ) != 0 )
+    {
+        MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc(%d bytes) failed", len ) );
+        return( ret );
+    }
+
+    MBEDTLS_SSL_DEBUG_MSG( 3, ( "output buffer resized to %d bytes", len ) );
+
+    return( 0 );
+}
+
+int mbedtls_ssl_out_buffer_ensure( mbedtls_ssl_context *ssl, size_t content_len )
+{
+    if( content_len > MBEDTLS_SSL_MAX_CONTENT_LEN )
+        content_len = MBEDTLS_SSL_MAX_CONTENT_LEN;
+
+    if( content_len <= MBEDTLS_SSL_OUT_CONTENT_LEN( ssl ) )
+        return( 0 );
+
+    return( ssl_out_buffer_resize( ssl,
+                    content_len + MBEDTLS_SSL_BUFFER_OVERHEAD ) );
+}
+
+/*
+ * Give back buffer space beyond MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN that
+ * holds no pending data. Called when a handshake completes, so that the
+ * space taken by certificates and key exchange messages is released.
+ * Failure to reallocate simply leaves the larger buffer in place.
+ */
+static void ssl_buffers_shrink( mbedtls_ssl_context *ssl )
+{
+    const size_t min_len = MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN +
+                           MBEDTLS_SSL_BUFFER_OVERHEAD;
+    size_t used, msg_end;
+
+    if( ssl->out_left == 0 && ssl->out_buf_len > min_len )
+        (void) ssl_out_buffer_resize( ssl, min_len );
+
+#if defined(MBEDTLS_SSL_PROTO_DTLS)
+    /* Datagrams are always read into a full size buffer */
+    if( ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
+        return;
+#endif
+
+    if( ssl->in_buf_len <= min_len )
+        return;
+
+    /* Keep whatever has been read but not yet consumed */
+    used = ( ssl->in_hdr - ssl->in_buf ) + ssl->in_left;
+    msg_end = ( ( ssl->in_offt != NULL ? ssl->in_offt : ssl->in_msg ) -
+                ssl->in_buf ) + ssl->in_msglen;
+    if( msg_end > used )
+        used = msg_end;
+    if( used < min_len )
+        used = min_len;
+
+    if( used < ssl->in_buf_len )
+        (void) ssl_in_buffer_resize( ssl, used );
+}
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
+
 /*
  * Fill the input message buffer by appending data to it.
  * The amount of data already fetched is in ssl->in_left.
@@ -2220,6 +2353,26 @@ int mbedtls_ssl_fetch_input( mbedtls_ssl_context *ssl, size_t nb_want )
         return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
     }
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    /*
+     * Grow the input buffer to fit the record, in steps of 1 kB to avoid
+     * reallocating for each slightly larger record. CBC padding checks read
+     * up to MBEDTLS_SSL_PADDING_ADD bytes past the end of the record, so
+     * keep that much room after it. Datagram input buffers are allocated
+     * at full size.
+     */
+    len = ( ssl->in_hdr - ssl->in_buf ) + nb_want + MBEDTLS_SSL_PADDING_ADD;
+    if( len > ssl->in_buf_len && ssl->in_buf_len < MBEDTLS_SSL_BUFFER_LEN )
+    {
+        len = ( len + 1023 ) & ~(size_t) 1023;
+        if( len > MBEDTLS_SSL_BUFFER_LEN )
+            len = MBEDTLS_SSL_BUFFER_LEN;
+
+        if( ( ret = ssl_in_buffer_resize( ssl, len ) ) != 0 )
+            return( ret );
+    }
+#endif
+
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
     if( ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
     {
@@ -2297,7 +2450,7 @@ int mbedtls_ssl_fetch_input( mbedtls_ssl_context *ssl, size_t nb_want )
             ret = MBEDTLS_ERR_SSL_TIMEOUT;
         else
         {
-            len = MBEDTLS_SSL_BUFFER_LEN - ( ssl->in_hdr - ssl->in_buf );
+            len = MBEDTLS_SSL_IN_BUFFER_LEN( ssl ) - ( ssl->in_hdr - ssl->in_buf );
 
             if( ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER )
                 timeout = ssl->handshake->retransmit_timeout;
@@ -2614,6 +2767,9 @@ int mbedtls_ssl_resend( mbedtls_ssl_context *ssl )
             ssl_swap_epochs( ssl );
         }
 
+        if( ( ret = mbedtls_ssl_out_buffer_ensure( ssl, cur->len ) ) != 0 )
+            return( ret );
+
         memcpy( ssl->out_msg, cur->p, cur->len );
         ssl->out_msglen = cur->len;
         ssl->out_msgtype = cur->type;
@@ -3048,7 +3204,7 @@ static int ssl_reassemble_dtls_handshake( mbedtls_ssl_context *ssl )
         ssl->next_record_offset = new_remain - ssl->in_hdr;
         ssl->in_left = ssl->next_record_offset + remain_len;
 
-        if( ssl->in_left > MBEDTLS_SSL_BUFFER_LEN -
+        if( ssl->in_left > MBEDTLS_SSL_IN_BUFFER_LEN( ssl ) -
                            (size_t)( ssl->in_hdr - ssl->in_buf ) )
         {
             MBEDTLS_SSL_DEBUG_MSG( 1, ( "reassembled message too large for buffer" ) );
@@ -3422,7 +3578,7 @@ static int ssl_handle_possible_reconnect( mbedtls_ssl_context *ssl )
             ssl->conf->p_cookie,
             ssl->cli_id, ssl->cli_id_len,
             ssl->in_buf, ssl->in_left,
-            ssl->out_buf, MBEDTLS_SSL_MAX_CONTENT_LEN, &len );
+            ssl->out_buf, MBEDTLS_SSL_OUT_CONTENT_LEN( ssl ), &len );
 
     MBEDTLS_SSL_DEBUG_RET( 2, "ssl_check_dtls_clihlo_cookie", ret );
 
@@ -4264,15 +4420,22 @@ int mbedtls_ssl_write_certificate( mbedtls_ssl_context *ssl )
      *    n+3 . ...   upper level cert, etc.
      */
     i = 7;
+    for( crt = mbedtls_ssl_own_cert( ssl ); crt != NULL; crt = crt->next )
+        i += 3 + crt->raw.len;
+
+    if( ( ret = mbedtls_ssl_out_buffer_ensure( ssl, i ) ) != 0 )
+        return( ret );
+
+    i = 7;
     crt = mbedtls_ssl_own_cert( ssl );
 
     while( crt != NULL )
     {
         n = crt->raw.len;
-        if( n > MBEDTLS_SSL_MAX_CONTENT_LEN - 3 - i )
+        if( n > MBEDTLS_SSL_OUT_CONTENT_LEN( ssl ) - 3 - i )
         {
             MBEDTLS_SSL_DEBUG_MSG( 1, ( "certificate too large, %d > %d",
-                           i + 3 + n, MBEDTLS_SSL_MAX_CONTENT_LEN ) );
+                           i + 3 + n, MBEDTLS_SSL_OUT_CONTENT_LEN( ssl ) ) );
             return( MBEDTLS_ERR_SSL_CERTIFICATE_TOO_LARGE );
         }
 
@@ -5221,6 +5384,10 @@ void mbedtls_ssl_handshake_wrapup( mbedtls_ssl_context *ssl )
 #endif
         ssl_handshake_wrapup_free_hs_transform( ssl );
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    ssl_buffers_shrink( ssl );
+#endif
+
     ssl->state++;
 
     MBEDTLS_SSL_DEBUG_MSG( 3, ( "<= handshake wrapup" ) );
@@ -5464,6 +5631,10 @@ static void ssl_handshake_params_init( mbedtls_ssl_handshake_params *handshake )
 #if defined(MBEDTLS_ECDH_C)
     mbedtls_ecdh_init( &handshake->ecdh_ctx );
 #endif
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+    mbedtls_pk_restart_init( &handshake->ecrs_ctx );
+    handshake->ecrs_state = ssl_ecrs_none;
+#endif
 #if defined(MBEDTLS_KEY_EXCHANGE_ECJPAKE_ENABLED)
     mbedtls_ecjpake_init( &handshake->ecjpake_ctx );
 #if defined(MBEDTLS_SSL_CLI_C)
@@ -5545,6 +5716,11 @@ static int ssl_handshake_init( mbedtls_ssl_context *ssl )
     ssl_transform_init( ssl->transform_negotiate );
     ssl_handshake_params_init( ssl->handshake );
 
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+    /* Only restart if a budget was set before this handshake was set up */
+    ssl->handshake->ecrs_enabled = mbedtls_ecp_restart_is_enabled();
+#endif
+
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
     if( ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
     {
@@ -5606,22 +5782,40 @@ int mbedtls_ssl_setup( mbedtls_ssl_context *ssl,
                        const mbedtls_ssl_config *conf )
 {
     int ret;
-    const size_t len = MBEDTLS_SSL_BUFFER_LEN;
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    size_t in_len = MBEDTLS_SSL_VARIABLE_BUFFER_MIN_LEN +
+                    MBEDTLS_SSL_BUFFER_OVERHEAD;
+    const size_t out_len = in_len;
+
+#if defined(MBEDTLS_SSL_PROTO_DTLS)
+    if( conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
+        in_len = MBEDTLS_SSL_BUFFER_LEN;
+#endif
+#else
+    const size_t in_len = MBEDTLS_SSL_BUFFER_LEN;
+    const size_t out_len = MBEDTLS_SSL_BUFFER_LEN;
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
 
     ssl->conf = conf;
 
     /*
      * Prepare base structures
      */
-    if( ( ssl-> in_buf = mbedtls_calloc( 1, len ) ) == NULL ||
-        ( ssl->out_buf = mbedtls_calloc( 1, len ) ) == NULL )
+    if( ( ssl-> in_buf = mbedtls_calloc( 1, in_len ) ) == NULL ||
+        ( ssl->out_buf = mbedtls_calloc( 1, out_len ) ) == NULL )
     {
-        MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc(%d bytes) failed", len ) );
+        MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc(%d bytes) failed",
+                                    ssl->in_buf == NULL ? in_len : out_len ) );
         mbedtls_free( ssl->in_buf );
         ssl->in_buf = NULL;
         return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
     }
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    ssl->in_buf_len = in_len;
+    ssl->out_buf_len = out_len;
+#endif
+
 #if defined(MBEDTLS_SSL_PROTO_DTLS)
     if( conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
     {
@@ -5717,9 +5911,14 @@ static int ssl_session_reset_int( mbedtls_ssl_context *ssl, int partial )
     ssl->transform_in = NULL;
     ssl->transform_out = NULL;
 
-    memset( ssl->out_buf, 0, MBEDTLS_SSL_BUFFER_LEN );
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
     if( partial == 0 )
-        memset( ssl->in_buf, 0, MBEDTLS_SSL_BUFFER_LEN );
+        ssl_buffers_shrink( ssl );
+#endif
+
+    memset( ssl->out_buf, 0, MBEDTLS_SSL_OUT_BUFFER_LEN( ssl ) );
+    if( partial == 0 )
+        memset( ssl->in_buf, 0, MBEDTLS_SSL_IN_BUFFER_LEN( ssl ) );
 
 #if defined(MBEDTLS_SSL_HW_RECORD_ACCEL)
     if( mbedtls_ssl_hw_record_reset != NULL )
@@ -7071,6 +7270,26 @@ static int ssl_write_real( mbedtls_ssl_context *ssl,
     }
 #endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    if( len > MBEDTLS_SSL_OUT_CONTENT_LEN( ssl ) )
+    {
+        /* The buffer is never resized while a record is pending, so a
+         * retried call sees the same capacity and returns the same length */
+        if( ssl->out_left == 0 &&
+            mbedtls_ssl_out_buffer_ensure( ssl, len ) != 0 )
+        {
+#if defined(MBEDTLS_SSL_PROTO_DTLS)
+            if( ssl->conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM )
+                return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
+#endif
+        }
+
+        /* Send what fits if the buffer could not be grown */
+        if( len > MBEDTLS_SSL_OUT_CONTENT_LEN( ssl ) )
+            len = MBEDTLS_SSL_OUT_CONTENT_LEN( ssl );
+    }
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
+
     if( ssl->out_left != 0 )
     {
         if( ( ret = mbedtls_ssl_flush_output( ssl ) ) != 0 )
@@ -7262,6 +7481,9 @@ void mbedtls_ssl_handshake_free( mbedtls_ssl_handshake_params *handshake )
 #if defined(MBEDTLS_ECDH_C)
     mbedtls_ecdh_free( &handshake->ecdh_ctx );
 #endif
+#if defined(MBEDTLS_SSL__ECP_RESTARTABLE)
+    mbedtls_pk_restart_free( &handshake->ecrs_ctx );
+#endif
 #if defined(MBEDTLS_KEY_EXCHANGE_ECJPAKE_ENABLED)
     mbedtls_ecjpake_free( &handshake->ecjpake_ctx );
 #if defined(MBEDTLS_SSL_CLI_C)
@@ -7345,13 +7567,13 @@ void mbedtls_ssl_free( mbedtls_ssl_context *ssl )
 
     if( ssl->out_buf != NULL )
     {
-        mbedtls_zeroize( ssl->out_buf, MBEDTLS_SSL_BUFFER_LEN );
+        mbedtls_zeroize( ssl->out_buf, MBEDTLS_SSL_OUT_BUFFER_LEN( ssl ) );
         mbedtls_free( ssl->out_buf );
     }
 
     if( ssl->in_buf != NULL )
     {
-        mbedtls_zeroize( ssl->in_buf, MBEDTLS_SSL_BUFFER_LEN );
+        mbedtls_zeroize( ssl->in_buf, MBEDTLS_SSL_IN_BUFFER_LEN( ssl ) );
         mbedtls_free( ssl->in_buf );
     }
 
@@ -626,15 +626,19 @@ static int x509_get_crt_ext( unsigned char **p,
             break;
 
         case MBEDTLS_X509_EXT_EXTENDED_KEY_USAGE:
-            /* Parse extended key usage */
-            if( ( ret = x509_get_ext_key_usage( p, end_ext_octet,
+            /* Parse extended key usage, or leave it for on-demand reads */
+            if( ! crt->own_buffer )
+                *p = end_ext_octet;
+            else if( ( ret = x509_get_ext_key_usage( p, end_ext_octet,
                     &crt->ext_key_usage ) ) != 0 )
                 return( ret );
             break;
 
         case MBEDTLS_X509_EXT_SUBJECT_ALT_NAME:
-            /* Parse subject alt name */
-            if( ( ret = x509_get_subject_alt_name( p, end_ext_octet,
+            /* Parse subject alt name, or leave it for on-demand reads */
+            if( ! crt->own_buffer )
+                *p = end_ext_octet;
+            else if( ( ret = x509_get_subject_alt_name( p, end_ext_octet,
                     &crt->subject_alt_names ) ) != 0 )
                 return( ret );
             break;
@@ -659,10 +663,12 @@ static int x509_get_crt_ext( unsigned char **p,
 }
 
 /*
- * Parse and fill a single X.509 certificate in DER format
+ * Parse and fill a single X.509 certificate in DER format. Without make_copy,
+ * the certificate references buf and its names and list-valued extensions
+ * are only decoded on demand.
  */
 static int x509_crt_parse_der_core( mbedtls_x509_crt *crt, const unsigned char *buf,
-                                    size_t buflen )
+                                    size_t buflen, int make_copy )
 {
     int ret;
     size_t len;
@@ -705,15 +711,26 @@ static int x509_crt_parse_der_core( mbedtls_x509_crt *crt, const unsigned char *
     }
     crt_end = p + len;
 
-    // Create and populate a new buffer for the raw field
     crt->raw.len = crt_end - buf;
-    crt->raw.p = p = mbedtls_calloc( 1, crt->raw.len );
-    if( p == NULL )
-        return( MBEDTLS_ERR_X509_ALLOC_FAILED );
 
-    memcpy( p, buf, crt->raw.len );
+    if( make_copy != 0 )
+    {
+        // Create and populate a new buffer for the raw field
+        crt->raw.p = p = mbedtls_calloc( 1, crt->raw.len );
+        if( p == NULL )
+            return( MBEDTLS_ERR_X509_ALLOC_FAILED );
 
-    // Direct pointers to the new buffer 
+        memcpy( p, buf, crt->raw.len );
+        crt->own_buffer = 1;
+    }
+    else
+    {
+        // Reference the caller's buffer, which is never written to
+        crt->raw.p = p = (unsigned char *) buf;
+        crt->own_buffer = 0;
+    }
+
+    // Direct pointers to the raw buffer
     p += crt->raw.len - len;
     end = crt_end = p + len;
 
@@ -776,7 +793,9 @@ static int x509_crt_parse_der_core( mbedtls_x509_crt *crt, const unsigned char *
         return( MBEDTLS_ERR_X509_INVALID_FORMAT + ret );
     }
 
-    if( ( ret = mbedtls_x509_get_name( &p, p + len, &crt->issuer ) ) != 0 )
+    if( ! crt->own_buffer )
+        p += len;
+    else if( ( ret = mbedtls_x509_get_name( &p, p + len, &crt->issuer ) ) != 0 )
     {
         mbedtls_x509_crt_free( crt );
         return( ret );
@@ -809,7 +828,9 @@ static int x509_crt_parse_der_core( mbedtls_x509_crt *crt, const unsigned char *
         return( MBEDTLS_ERR_X509_INVALID_FORMAT + ret );
     }
 
-    if( len && ( ret = mbedtls_x509_get_name( &p, p + len, &crt->subject ) ) != 0 )
+    if( ! crt->own_buffer )
+        p += len;
+    else if( len && ( ret = mbedtls_x509_get_name( &p, p + len, &crt->subject ) ) != 0 )
     {
         mbedtls_x509_crt_free( crt );
         return( ret );
@@ -918,8 +939,9 @@ static int x509_crt_parse_der_core( mbedtls_x509_crt *crt, const unsigned char *
  * Parse one X.509 certificate in DER format from a buffer and add them to a
  * chained list
  */
-int mbedtls_x509_crt_parse_der( mbedtls_x509_crt *chain, const unsigned char *buf,
-                        size_t buflen )
+static int x509_crt_parse_der_internal( mbedtls_x509_crt *chain,
+                                        const unsigned char *buf,
+                                        size_t buflen, int make_copy )
 {
     int ret;
     mbedtls_x509_crt *crt = chain, *prev = NULL;
@@ -951,7 +973,7 @@ int mbedtls_x509_crt_parse_der( mbedtls_x509_crt *chain, const unsigned char *bu
         crt = crt->next;
     }
 
-    if( ( ret = x509_crt_parse_der_core( crt, buf, buflen ) ) != 0 )
+    if( ( ret = x509_crt_parse_der_core( crt, buf, buflen, make_copy ) ) != 0 )
     {
         if( prev )
             prev->next = NULL;
@@ -965,6 +987,19 @@ int mbedtls_x509_crt_parse_der( mbedtls_x509_crt *chain, const unsigned char *bu
     return( 0 );
 }
 
+int mbedtls_x509_crt_parse_der( mbedtls_x509_crt *chain, const unsigned char *buf,
+                        size_t buflen )
+{
+    return( x509_crt_parse_der_internal( chain, buf, buflen, 1 ) );
+}
+
+int mbedtls_x509_crt_parse_der_nocopy( mbedtls_x509_crt *chain,
+                                       const unsigned char *buf,
+                                       size_t buflen )
+{
+    return( x509_crt_parse_der_internal( chain, buf, buflen, 0 ) );
+}
+
 /*
  * Parse one or more PEM certificates from a buffer and add them to the chained
  * list
@@ -1378,6 +1413,20 @@ int mbedtls_x509_crt_info( char *buf, size_t size, const char *prefix,
         return( (int) ( size - n ) );
     }
 
+    if( crt->raw.p != NULL && ! crt->own_buffer )
+    {
+        /* Names and extension lists are not decoded, use a full copy */
+        mbedtls_x509_crt full;
+
+        mbedtls_x509_crt_init( &full );
+        ret = mbedtls_x509_crt_parse_der( &full, crt->raw.p, crt->raw.len );
+        if( ret == 0 )
+            ret = mbedtls_x509_crt_info( buf, size, prefix, &full );
+        mbedtls_x509_crt_free( &full );
+
+        return( ret );
+    }
+
     ret = mbedtls_snprintf( p, n, "%scert. version     : %d\n",
                                prefix, crt->version );
     MBEDTLS_X509_SAFE_SNPRINTF;
@@ -1548,6 +1597,146 @@ int mbedtls_x509_crt_verify_info( char *buf, size_t size, const char *prefix,
     return( (int) ( size - n ) );
 }
 
+/*
+ * Find the value of an extension that was detected at parse time (see
+ * ext_types). Used for the extensions that are read on demand.
+ */
+static int x509_crt_find_ext( const mbedtls_x509_crt *crt, int ext_type,
+                              unsigned char **p, const unsigned char **end )
+{
+    int ret, type, is_critical;
+    size_t len;
+    unsigned char *q = crt->v3_ext.p;
+    unsigned char *end_ext_data;
+    const unsigned char *end_ext = q + crt->v3_ext.len;
+    mbedtls_x509_buf extn_oid;
+
+    /* Extensions  ::=  SEQUENCE SIZE (1..MAX) OF Extension */
+    if( ( ret = mbedtls_asn1_get_tag( &q, end_ext, &len,
+            MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE ) ) != 0 )
+        return( MBEDTLS_ERR_X509_INVALID_EXTENSIONS + ret );
+
+    while( q < end_ext )
+    {
+        if( ( ret = mbedtls_asn1_get_tag( &q, end_ext, &len,
+                MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE ) ) != 0 )
+            return( MBEDTLS_ERR_X509_INVALID_EXTENSIONS + ret );
+
+        end_ext_data = q + len;
+
+        extn_oid.tag = MBEDTLS_ASN1_OID;
+        if( ( ret = mbedtls_asn1_get_tag( &q, end_ext_data, &extn_oid.len,
+                MBEDTLS_ASN1_OID ) ) != 0 )
+            return( MBEDTLS_ERR_X509_INVALID_EXTENSIONS + ret );
+
+        extn_oid.p = q;
+        q += extn_oid.len;
+
+        if( ( ret = mbedtls_asn1_get_bool( &q, end_ext_data, &is_critical ) ) != 0 &&
+            ( ret != MBEDTLS_ERR_ASN1_UNEXPECTED_TAG ) )
+            return( MBEDTLS_ERR_X509_INVALID_EXTENSIONS + ret );
+
+        if( ( ret = mbedtls_asn1_get_tag( &q, end_ext_data, &len,
+                MBEDTLS_ASN1_OCTET_STRING ) ) != 0 )
+            return( MBEDTLS_ERR_X509_INVALID_EXTENSIONS + ret );
+
+        if( mbedtls_oid_get_x509_ext_type( &extn_oid, &type ) == 0 &&
+            type == ext_type )
+        {
+            *p = q;
+            *end = q + len;
+            return( 0 );
+        }
+
+        q = end_ext_data;
+    }
+
+    return( MBEDTLS_ERR_X509_INVALID_EXTENSIONS );
+}
+
+/*
+ * Walk the AttributeTypeAndValue entries of a raw Name one at a time, as
+ * mbedtls_x509_get_name() would list them, without allocating.
+ */
+typedef struct
+{
+    unsigned char *p;               /* next entry */
+    const unsigned char *end;       /* end of the RDNSequence */
+    const unsigned char *end_set;   /* end of the current SET */
+}
+x509_name_walk;
+
+#define X509_NAME_WALK_DONE( w ) \
+    ( (w)->p == (w)->end_set && (w)->p == (w)->end )
+
+static int x509_name_walk_init( x509_name_walk *w, const mbedtls_x509_buf *raw )
+{
+    int ret;
+    size_t len;
+
+    w->p = raw->p;
+
+    if( ( ret = mbedtls_asn1_get_tag( &w->p, raw->p + raw->len, &len,
+            MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE ) ) != 0 )
+        return( MBEDTLS_ERR_X509_INVALID_NAME + ret );
+
+    w->end = w->p + len;
+    w->end_set = w->p;
+
+    return( 0 );
+}
+
+static int x509_name_walk_next( x509_name_walk *w, mbedtls_x509_name *cur )
+{
+    int ret;
+    size_t len;
+
+    if( w->p == w->end_set )
+    {
+        if( ( ret = mbedtls_asn1_get_tag( &w->p, w->end, &len,
+                MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SET ) ) != 0 )
+            return( MBEDTLS_ERR_X509_INVALID_NAME + ret );
+
+        w->end_set = w->p + len;
+    }
+
+    if( ( ret = mbedtls_asn1_get_tag( &w->p, w->end_set, &len,
+            MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE ) ) != 0 )
+        return( MBEDTLS_ERR_X509_INVALID_NAME + ret );
+
+    cur->oid.tag = MBEDTLS_ASN1_OID;
+    if( ( ret = mbedtls_asn1_get_tag( &w->p, w->end_set, &cur->oid.len,
+            MBEDTLS_ASN1_OID ) ) != 0 )
+        return( MBEDTLS_ERR_X509_INVALID_NAME + ret );
+
+    cur->oid.p = w->p;
+    w->p += cur->oid.len;
+
+    if( ( w->end_set - w->p ) < 1 )
+        return( MBEDTLS_ERR_X509_INVALID_NAME +
+                MBEDTLS_ERR_ASN1_OUT_OF_DATA );
+
+    if( *w->p != MBEDTLS_ASN1_BMP_STRING && *w->p != MBEDTLS_ASN1_UTF8_STRING      &&
+        *w->p != MBEDTLS_ASN1_T61_STRING && *w->p != MBEDTLS_ASN1_PRINTABLE_STRING &&
+        *w->p != MBEDTLS_ASN1_IA5_STRING && *w->p != MBEDTLS_ASN1_UNIVERSAL_STRING &&
+        *w->p != MBEDTLS_ASN1_BIT_STRING )
+        return( MBEDTLS_ERR_X509_INVALID_NAME +
+                MBEDTLS_ERR_ASN1_UNEXPECTED_TAG );
+
+    cur->val.tag = *w->p++;
+
+    if( ( ret = mbedtls_asn1_get_len( &w->p, w->end_set, &cur->val.len ) ) != 0 )
+        return( MBEDTLS_ERR_X509_INVALID_NAME + ret );
+
+    cur->val.p = w->p;
+    w->p += cur->val.len;
+
+    cur->next = NULL;
+    cur->next_merged = ( w->p != w->end_set );
+
+    return( 0 );
+}
+
 #if defined(MBEDTLS_X509_CHECK_KEY_USAGE)
 int mbedtls_x509_crt_check_key_usage( const mbedtls_x509_crt *crt,
                                       unsigned int usage )
@@ -1578,26 +1767,43 @@ int mbedtls_x509_crt_check_extended_key_usage( const mbedtls_x509_crt *crt,
                                        const char *usage_oid,
                                        size_t usage_len )
 {
-    const mbedtls_x509_sequence *cur;
+    unsigned char *p;
+    const unsigned char *end;
+    size_t len;
+    mbedtls_x509_buf cur_oid;
 
     /* Extension is not mandatory, absent means no restriction */
     if( ( crt->ext_types & MBEDTLS_X509_EXT_EXTENDED_KEY_USAGE ) == 0 )
         return( 0 );
 
     /*
-     * Look for the requested usage (or wildcard ANY) in our list
+     * Look for the requested usage (or wildcard ANY) in the extension, read
+     * from the DER so that certificates parsed in place work the same
      */
-    for( cur = &crt->ext_key_usage; cur != NULL; cur = cur->next )
+    if( x509_crt_find_ext( crt, MBEDTLS_X509_EXT_EXTENDED_KEY_USAGE,
+                           &p, &end ) != 0 ||
+        mbedtls_asn1_get_tag( &p, end, &len,
+            MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE ) != 0 )
+    {
+        return( MBEDTLS_ERR_X509_BAD_INPUT_DATA );
+    }
+
+    end = p + len;
+    cur_oid.tag = MBEDTLS_ASN1_OID;
+
+    while( p < end &&
+           mbedtls_asn1_get_tag( &p, end, &cur_oid.len, MBEDTLS_ASN1_OID ) == 0 )
     {
-        const mbedtls_x509_buf *cur_oid = &cur->buf;
+        cur_oid.p = p;
+        p += cur_oid.len;
 
-        if( cur_oid->len == usage_len &&
-            memcmp( cur_oid->p, usage_oid, usage_len ) == 0 )
+        if( cur_oid.len == usage_len &&
+            memcmp( cur_oid.p, usage_oid, usage_len ) == 0 )
         {
             return( 0 );
         }
 
-        if( MBEDTLS_OID_CMP( MBEDTLS_OID_ANY_EXTENDED_KEY_USAGE, cur_oid ) == 0 )
+        if( MBEDTLS_OID_CMP( MBEDTLS_OID_ANY_EXTENDED_KEY_USAGE, &cur_oid ) == 0 )
             return( 0 );
     }
 
@@ -1754,7 +1960,7 @@ static int x509_memcasecmp( const void *s1, const void *s2, size_t len )
 /*
  * Return 0 if name matches wildcard, -1 otherwise
  */
-static int x509_check_wildcard( const char *cn, mbedtls_x509_buf *name )
+static int x509_check_wildcard( const char *cn, const mbedtls_x509_buf *name )
 {
     size_t i;
     size_t cn_idx = 0, cn_len = strlen( cn );
@@ -1810,7 +2016,7 @@ static int x509_string_cmp( const mbedtls_x509_buf *a, const mbedtls_x509_buf *b
 }
 
 /*
- * Compare two X.509 Names (aka rdnSequence).
+ * Compare two raw X.509 Names (aka rdnSequence).
  *
  * See RFC 5280 section 7.1, though we don't implement the whole algorithm:
  * we sometimes return unequal when the full algorithm would return equal,
@@ -1819,38 +2025,139 @@ static int x509_string_cmp( const mbedtls_x509_buf *a, const mbedtls_x509_buf *b
  *
  * Return 0 if equal, -1 otherwise.
  */
-static int x509_name_cmp( const mbedtls_x509_name *a, const mbedtls_x509_name *b )
+static int x509_name_cmp( const mbedtls_x509_buf *a_raw, const mbedtls_x509_buf *b_raw )
 {
-    /* Avoid recursion, it might not be optimised by the compiler */
-    while( a != NULL || b != NULL )
+    x509_name_walk wa, wb;
+    mbedtls_x509_name a, b;
+
+    /* Identical encodings are the common case */
+    if( a_raw->len == b_raw->len &&
+        memcmp( a_raw->p, b_raw->p, b_raw->len ) == 0 )
     {
-        if( a == NULL || b == NULL )
+        return( 0 );
+    }
+
+    if( x509_name_walk_init( &wa, a_raw ) != 0 ||
+        x509_name_walk_init( &wb, b_raw ) != 0 )
+    {
+        return( -1 );
+    }
+
+    while( ! X509_NAME_WALK_DONE( &wa ) || ! X509_NAME_WALK_DONE( &wb ) )
+    {
+        if( X509_NAME_WALK_DONE( &wa ) || X509_NAME_WALK_DONE( &wb ) )
+            return( -1 );
+
+        if( x509_name_walk_next( &wa, &a ) != 0 ||
+            x509_name_walk_next( &wb, &b ) != 0 )
+        {
             return( -1 );
+        }
 
         /* type */
-        if( a->oid.tag != b->oid.tag ||
-            a->oid.len != b->oid.len ||
-            memcmp( a->oid.p, b->oid.p, b->oid.len ) != 0 )
+        if( a.oid.tag != b.oid.tag ||
+            a.oid.len != b.oid.len ||
+            memcmp( a.oid.p, b.oid.p, b.oid.len ) != 0 )
         {
             return( -1 );
         }
 
         /* value */
-        if( x509_string_cmp( &a->val, &b->val ) != 0 )
+        if( x509_string_cmp( &a.val, &b.val ) != 0 )
             return( -1 );
 
         /* structure of the list of sets */
-        if( a->next_merged != b->next_merged )
+        if( a.next_merged != b.next_merged )
             return( -1 );
-
-        a = a->next;
-        b = b->next;
     }
 
-    /* a == NULL == b */
     return( 0 );
 }
 
+/*
+ * Return 0 if name (a dNSName or a CN) matches cn, -1 otherwise
+ */
+static int x509_crt_check_name( const mbedtls_x509_buf *name,
+                                const char *cn, size_t cn_len )
+{
+    if( name->len == cn_len &&
+        x509_memcasecmp( cn, name->p, cn_len ) == 0 )
+        return( 0 );
+
+    if( name->len > 2 &&
+        memcmp( name->p, "*.", 2 ) == 0 &&
+        x509_check_wildcard( cn, name ) == 0 )
+        return( 0 );
+
+    return( -1 );
+}
+
+/*
+ * Check the expected name against the dNSNames of subjectAltName if the
+ * extension is present, or against the CNs of the subject otherwise. Both are
+ * read from the DER so that certificates parsed in place work the same.
+ *
+ * Return 0 if found, -1 otherwise.
+ */
+static int x509_crt_verify_name( const mbedtls_x509_crt *crt, const char *cn )
+{
+    size_t cn_len = strlen( cn );
+
+    if( crt->ext_types & MBEDTLS_X509_EXT_SUBJECT_ALT_NAME )
+    {
+        unsigned char *p;
+        const unsigned char *end;
+        size_t len;
+        mbedtls_x509_buf name;
+
+        if( x509_crt_find_ext( crt, MBEDTLS_X509_EXT_SUBJECT_ALT_NAME,
+                               &p, &end ) != 0 ||
+            mbedtls_asn1_get_tag( &p, end, &len,
+                MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE ) != 0 )
+        {
+            return( -1 );
+        }
+
+        end = p + len;
+
+        while( p < end )
+        {
+            name.tag = *p++;
+
+            if( mbedtls_asn1_get_len( &p, end, &name.len ) != 0 )
+                return( -1 );
+
+            name.p = p;
+            p += name.len;
+
+            /* Only dNSName is supported */
+            if( name.tag == ( MBEDTLS_ASN1_CONTEXT_SPECIFIC | 2 ) &&
+                x509_crt_check_name( &name, cn, cn_len ) == 0 )
+                return( 0 );
+        }
+    }
+    else
+    {
+        x509_name_walk w;
+        mbedtls_x509_name name;
+
+        if( x509_name_walk_init( &w, &crt->subject_raw ) != 0 )
+            return( -1 );
+
+        while( ! X509_NAME_WALK_DONE( &w ) )
+        {
+            if( x509_name_walk_next( &w, &name ) != 0 )
+                return( -1 );
+
+            if( MBEDTLS_OID_CMP( MBEDTLS_OID_AT_CN, &name.oid ) == 0 &&
+                x509_crt_check_name( &name.val, cn, cn_len ) == 0 )
+                return( 0 );
+        }
+    }
+
+    return( -1 );
+}
+
 /*
  * Check if 'parent' is a suitable parent (signing CA) for 'child'.
  * Return 0 if yes, -1 if not.
@@ -1865,7 +2172,7 @@ static int x509_crt_check_parent( const mbedtls_x509_crt *child,
     int need_ca_bit;
 
     /* Parent must be the issuer */
-    if( x509_name_cmp( &child->issuer, &parent->subject ) != 0 )
+    if( x509_name_cmp( &child->issuer_raw, &parent->subject_raw ) != 0 )
         return( -1 );
 
     /* Parent must have the basicConstraints CA bit set as a general rule */
@@ -2055,7 +2362,7 @@ static int x509_crt_verify_child(
     const mbedtls_md_info_t *md_info;
 
     /* Counting intermediate self signed certificates */
-    if( ( path_cnt != 0 ) && x509_name_cmp( &child->issuer, &child->subject ) == 0 )
+    if( ( path_cnt != 0 ) && x509_name_cmp( &child->issuer_raw, &child->subject_raw ) == 0 )
         self_cnt++;
 
     /* path_cnt is 0 for the first intermediate CA */
@@ -2198,12 +2505,9 @@ int mbedtls_x509_crt_verify_with_profile( mbedtls_x509_crt *crt,
                      int (*f_vrfy)(void *, mbedtls_x509_crt *, int, uint32_t *),
                      void *p_vrfy )
 {
-    size_t cn_len;
     int ret;
     int pathlen = 0, selfsigned = 0;
     mbedtls_x509_crt *parent;
-    mbedtls_x509_name *name;
-    mbedtls_x509_sequence *cur = NULL;
     mbedtls_pk_type_t pk_type;
 
     *flags = 0;
@@ -2214,57 +2518,8 @@ int mbedtls_x509_crt_verify_with_profile( mbedtls_x509_crt *crt,
         goto exit;
     }
 
-    if( cn != NULL )
-    {
-        name = &crt->subject;
-        cn_len = strlen( cn );
-
-        if( crt->ext_types & MBEDTLS_X509_EXT_SUBJECT_ALT_NAME )
-        {
-            cur = &crt->subject_alt_names;
-
-            while( cur != NULL )
-            {
-                if( cur->buf.len == cn_len &&
-                    x509_memcasecmp( cn, cur->buf.p, cn_len ) == 0 )
-                    break;
-
-                if( cur->buf.len > 2 &&
-                    memcmp( cur->buf.p, "*.", 2 ) == 0 &&
-                    x509_check_wildcard( cn, &cur->buf ) == 0 )
-                {
-                    break;
-                }
-
-                cur = cur->next;
-            }
-
-            if( cur == NULL )
-                *flags |= MBEDTLS_X509_BADCERT_CN_MISMATCH;
-        }
-        else
-        {
-            while( name != NULL )
-            {
-                if( MBEDTLS_OID_CMP( MBEDTLS_OID_AT_CN, &name->oid ) == 0 )
-                {
-                    if( name->val.len == cn_len &&
-                        x509_memcasecmp( name->val.p, cn, cn_len ) == 0 )
-                        break;
-
-                    if( name->val.len > 2 &&
-                        memcmp( name->val.p, "*.", 2 ) == 0 &&
-                        x509_check_wildcard( cn, &name->val ) == 0 )
-                        break;
-                }
-
-                name = name->next;
-            }
-
-            if( name == NULL )
-                *flags |= MBEDTLS_X509_BADCERT_CN_MISMATCH;
-        }
-    }
+    if( cn != NULL && x509_crt_verify_name( crt, cn ) != 0 )
+        *flags |= MBEDTLS_X509_BADCERT_CN_MISMATCH;
 
     /* Check the type and size of the key */
     pk_type = mbedtls_pk_get_type( &crt->pk );
@@ -2399,7 +2654,7 @@ void mbedtls_x509_crt_free( mbedtls_x509_crt *crt )
             mbedtls_free( seq_prv );
         }
 
-        if( cert_cur->raw.p != NULL )
+        if( cert_cur->raw.p != NULL && cert_cur->own_buffer )
         {
             mbedtls_zeroize( cert_cur->raw.p, cert_cur->raw.len );
             mbedtls_free( cert_cur->raw.p );
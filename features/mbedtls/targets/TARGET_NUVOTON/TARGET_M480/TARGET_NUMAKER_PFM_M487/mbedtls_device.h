@@ -23,6 +23,7 @@
 #define MBEDTLS_SHA512_ALT
 
 #define MBEDTLS_AES_ALT
+#define MBEDTLS_AES_CRYPT_ECB_BLOCKS_ALT
 
 #define MBEDTLS_ECP_INTERNAL_ALT
 /* Support for Weierstrass curves with Jacobi representation */
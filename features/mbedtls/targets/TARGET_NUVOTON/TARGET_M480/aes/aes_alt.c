@@ -248,6 +248,37 @@ int mbedtls_aes_crypt_ecb( mbedtls_aes_context *ctx,
     return( 0 );
 }
 
+#if defined(MBEDTLS_AES_CRYPT_ECB_BLOCKS_ALT)
+/*
+ * AES-ECB encryption/decryption of consecutive blocks, MAX_DMA_CHAIN_SIZE
+ * bytes per DMA transfer instead of one block
+ */
+int mbedtls_aes_crypt_ecb_blocks( mbedtls_aes_context *ctx,
+                                  int mode,
+                                  size_t blocks,
+                                  const unsigned char *input,
+                                  unsigned char *output )
+{
+    size_t length = blocks * 16;
+    size_t blockChainLen;
+
+    ctx->opMode = AES_MODE_ECB;
+    ctx->encDec = ( mode == MBEDTLS_AES_ENCRYPT ) ? 1 : 0;
+
+    while( length > 0 ) {
+        blockChainLen = (length > MAX_DMA_CHAIN_SIZE) ? MAX_DMA_CHAIN_SIZE : length;
+
+        __nvt_aes_crypt(ctx, input, output, blockChainLen);
+
+        length -= blockChainLen;
+        input  += blockChainLen;
+        output += blockChainLen;
+    }
+
+    return( 0 );
+}
+#endif /* MBEDTLS_AES_CRYPT_ECB_BLOCKS_ALT */
+
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
 /*
  * AES-CBC buffer encryption/decryption
@@ -17,6 +17,8 @@
 #ifndef __INCLUDE_MESH_SYSTEM__
 #define __INCLUDE_MESH_SYSTEM__
 #include "ns_types.h"
+#include "nsdynmemLIB.h"
+#include "nwk_stats_api.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,6 +41,19 @@ void mesh_system_send_connect_event(uint8_t receiver);
  */
 void mesh_system_init(void);
 
+/*
+ * \brief Get Nanostack network statistics.
+ * \return Statistics collected since mesh_system_init(), or NULL
+ * if statistics are not enabled.
+ */
+const nwk_stats_t *mesh_system_get_nwk_stats(void);
+
+/*
+ * \brief Get Nanostack heap statistics.
+ * \return Heap statistics, or NULL if statistics are not enabled.
+ */
+const mem_stat_t *mesh_system_get_mem_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
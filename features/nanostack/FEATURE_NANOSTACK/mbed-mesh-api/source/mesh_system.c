@@ -37,6 +37,14 @@ static uint8_t *app_stack_heap;
 #endif
 static bool mesh_initialized = false;
 
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+static nwk_stats_t mesh_nwk_stats;
+static mem_stat_t mesh_mem_stats;
+#define MESH_MEM_STATS_PTR &mesh_mem_stats
+#else
+#define MESH_MEM_STATS_PTR NULL
+#endif
+
 /*
  * Heap error handler, called when heap problem is detected.
  * Function is for-ever loop.
@@ -66,14 +74,35 @@ void mesh_system_init(void)
         MBED_ASSERT(app_stack_heap);
 #endif
         ns_hal_init(app_stack_heap, MBED_CONF_MBED_MESH_API_HEAP_SIZE,
-                    mesh_system_heap_error_handler, NULL);
+                    mesh_system_heap_error_handler, MESH_MEM_STATS_PTR);
         eventOS_scheduler_mutex_wait();
         net_init_core();
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+        protocol_stats_start(&mesh_nwk_stats);
+#endif
         eventOS_scheduler_mutex_release();
         mesh_initialized = true;
     }
 }
 
+const nwk_stats_t *mesh_system_get_nwk_stats(void)
+{
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+    return mesh_initialized ? &mesh_nwk_stats : NULL;
+#else
+    return NULL;
+#endif
+}
+
+const mem_stat_t *mesh_system_get_mem_stats(void)
+{
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+    return mesh_initialized ? &mesh_mem_stats : NULL;
+#else
+    return NULL;
+#endif
+}
+
 void mesh_system_send_connect_event(uint8_t receiver)
 {
     arm_event_s event = {
@@ -96,6 +96,11 @@ public:
     int8_t proto;               /*!< UDP or TCP */
     bool addr_valid;
     ns_address_t ns_address;
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    uint32_t sndbuf_used;       /*!< Stream bytes not yet reported sent by SOCKET_TX_DONE */
+#endif
 private:
     bool attach(int8_t socket_id);
     socket_mode_t mode;
@@ -159,6 +164,11 @@ NanostackSocket::NanostackSocket(int8_t protocol)
     proto = protocol;
     addr_valid = false;
     memset(&ns_address, 0, sizeof(ns_address));
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+    tx_bytes = 0;
+    rx_bytes = 0;
+    sndbuf_used = 0;
+#endif
     mode = SOCKET_MODE_UNOPENED;
 }
 
@@ -377,6 +387,9 @@ void NanostackSocket::event_tx_done(socket_callback_t *sock_cb)
         tr_debug("SOCKET_TX_DONE, %d bytes sent", sock_cb->d_len);
     } else if (mode == SOCKET_MODE_STREAM) {
         tr_debug("SOCKET_TX_DONE, %d bytes remaining", sock_cb->d_len);
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+        sndbuf_used = sock_cb->d_len;
+#endif
     }
 
     signal_event();
@@ -474,6 +487,44 @@ const char * NanostackInterface::get_ip_address()
     return "::";
 }
 
+nsapi_error_t NanostackInterface::getstackopt(int level, int optname, void *optval, unsigned *optlen)
+{
+    if (level != NSAPI_STACK) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    switch (optname) {
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+        case NSAPI_INTERFACE_STATS: {
+            if (*optlen < sizeof(nsapi_interface_stats_t)) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+            NanostackLockGuard lock;
+
+            const nwk_stats_t *nwk_stats = mesh_system_get_nwk_stats();
+            const mem_stat_t *mem_stats = mesh_system_get_mem_stats();
+            if (!nwk_stats) {
+                return NSAPI_ERROR_NO_CONNECTION;
+            }
+
+            nsapi_interface_stats_t *stats = static_cast<nsapi_interface_stats_t *>(optval);
+            stats->rx_packets = nwk_stats->ip_rx_count;
+            stats->rx_bytes = nwk_stats->ip_rx_bytes;
+            stats->rx_drops = nwk_stats->ip_rx_drop + nwk_stats->ip_cksum_error;
+            stats->tx_packets = nwk_stats->ip_tx_count;
+            stats->tx_bytes = nwk_stats->ip_tx_bytes;
+            stats->tx_drops = nwk_stats->ip_no_route + nwk_stats->frag_tx_errors;
+            stats->buffer_exhausted = mem_stats ? mem_stats->heap_alloc_fail_cnt : 0;
+            *optlen = sizeof *stats;
+            return NSAPI_ERROR_OK;
+        }
+#endif
+        default:
+            return NSAPI_ERROR_UNSUPPORTED;
+    }
+}
+
 nsapi_error_t NanostackInterface::socket_open(void **handle, nsapi_protocol_t protocol)
 {
     // Validate parameters
@@ -593,6 +644,12 @@ nsapi_size_or_error_t NanostackInterface::do_sendto(void *handle, const ns_addre
         ret = NSAPI_ERROR_DEVICE_ERROR;
     } else {
         ret = retcode;
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+        socket->tx_bytes += retcode;
+        if (socket->proto == SOCKET_TCP) {
+            socket->sndbuf_used += retcode;
+        }
+#endif
     }
 
 out:
@@ -642,6 +699,9 @@ nsapi_size_or_error_t NanostackInterface::socket_recvfrom(void *handle, SocketAd
         ret = NSAPI_ERROR_PARAMETER;
     } else {
         ret = retcode;
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+        socket->rx_bytes += retcode;
+#endif
         if (address != NULL) {
             convert_ns_addr_to_mbed(address, &ns_address);
         }
@@ -765,6 +825,35 @@ nsapi_error_t NanostackInterface::getsockopt(void *handle, int level, int optnam
 
     NanostackLockGuard lock;
 
+    if (level == NSAPI_SOCKET) {
+        switch (optname) {
+#if MBED_CONF_MBED_MESH_API_STATS_ENABLED
+            case NSAPI_SOCKET_STATS: {
+                if (*optlen < sizeof(nsapi_socket_stats_t)) {
+                    return NSAPI_ERROR_PARAMETER;
+                }
+                nsapi_socket_stats_t *stats = static_cast<nsapi_socket_stats_t *>(optval);
+                memset(stats, 0, sizeof *stats);
+                stats->tx_bytes = socket->tx_bytes;
+                stats->rx_bytes = socket->rx_bytes;
+                if (socket->proto == SOCKET_TCP) {
+                    int32_t sndbuf_size;
+                    uint16_t sndbuf_len = sizeof sndbuf_size;
+                    if (::socket_getsockopt(socket->socket_id, SOCKET_SOL_SOCKET, SOCKET_SO_SNDBUF,
+                                            &sndbuf_size, &sndbuf_len) == 0) {
+                        stats->sndbuf_size = sndbuf_size;
+                    }
+                    stats->sndbuf_used = socket->sndbuf_used;
+                }
+                *optlen = sizeof *stats;
+                return NSAPI_ERROR_OK;
+            }
+#endif
+            default:
+                return NSAPI_ERROR_UNSUPPORTED;
+        }
+    }
+
     uint16_t optlen16 = *optlen;
     if (::socket_getsockopt(socket->socket_id, level, optname, optval, &optlen16) == 0) {
         ret = NSAPI_ERROR_OK;
@@ -42,6 +42,19 @@ protected:
      */
     virtual const char *get_ip_address();
 
+    /*  Get stack options
+     *
+     *  Supports NSAPI_INTERFACE_STATS at the NSAPI_STACK level when
+     *  statistics are enabled, otherwise returns NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param level    Stack-specific protocol level or nsapi_stack_level_t
+     *  @param optname  Level-specific option name
+     *  @param optval   Destination for option value
+     *  @param optlen   Length of the option value
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t getstackopt(int level, int optname, void *optval, unsigned *optlen);
+
     /** Opens a socket
      *
      *  Creates a network socket and stores it in the specified handle.
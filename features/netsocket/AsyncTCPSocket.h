@@ -0,0 +1,129 @@
+/** \addtogroup netsocket */
+/** @{*/
+/* AsyncTCPSocket
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASYNC_TCPSOCKET_H
+#define ASYNC_TCPSOCKET_H
+
+#include "netsocket/TCPSocket.h"
+#include "events/AsyncTask.h"
+#include "platform/NonCopyable.h"
+
+
+/** Adapter to await a TCP socket from an events::AsyncTask
+ *
+ *  The socket is set to non-blocking mode and its sigio wakes up the task,
+ *  so a task can serve a connection without a thread of its own:
+ *
+ *  @code
+ *  ASYNC_AWAIT(_socket.try_connect(_address, &_error));
+ *  while (!_error) {
+ *      ASYNC_AWAIT_FOR(_socket.try_recv(_buffer, sizeof(_buffer), &_size), 30000);
+ *      if (timed_out() || _size <= 0) {
+ *          break;
+ *      }
+ *      ...
+ *  }
+ *  @endcode
+ */
+class AsyncTCPSocket : private mbed::NonCopyable<AsyncTCPSocket> {
+public:
+    /** Attach a TCP socket to a task
+     *
+     *  @param task     Task awaiting the socket
+     *  @param socket   Open TCP socket, set to non-blocking mode
+     */
+    AsyncTCPSocket(events::AsyncTask *task, TCPSocket *socket)
+        : _socket(socket)
+    {
+        _socket->set_blocking(false);
+        _socket->sigio(mbed::callback(task, &events::AsyncTask::wake));
+    }
+
+    /** Detach the socket from the task
+     *
+     *  The socket is left in non-blocking mode.
+     */
+    ~AsyncTCPSocket()
+    {
+        _socket->sigio(NULL);
+    }
+
+    /** Try to connect the socket, for use in an await
+     *
+     *  @param address  The SocketAddress of the remote host
+     *  @param result   Where to store 0 once connected or the negative
+     *                  error code of the connection
+     *  @return         False while the connection is in progress
+     */
+    bool try_connect(const SocketAddress &address, nsapi_error_t *result)
+    {
+        nsapi_error_t err = _socket->connect(address);
+        if (err == NSAPI_ERROR_IN_PROGRESS || err == NSAPI_ERROR_ALREADY) {
+            return false;
+        }
+
+        *result = (err == NSAPI_ERROR_IS_CONNECTED) ? NSAPI_ERROR_OK : err;
+        return true;
+    }
+
+    /** Try to send data, for use in an await
+     *
+     *  @param data     Buffer of data to send to the host
+     *  @param size     Size of the buffer in bytes
+     *  @param result   Where to store the number of bytes sent or the
+     *                  negative error code of the send
+     *  @return         False if the send would block
+     */
+    bool try_send(const void *data, nsapi_size_t size, nsapi_size_or_error_t *result)
+    {
+        *result = _socket->send(data, size);
+        return *result != NSAPI_ERROR_WOULD_BLOCK;
+    }
+
+    /** Try to receive data, for use in an await
+     *
+     *  @param data     Destination buffer for data received from the host
+     *  @param size     Size of the buffer in bytes
+     *  @param result   Where to store the number of bytes received, 0 if
+     *                  the peer has shut down the connection, or the
+     *                  negative error code of the receive
+     *  @return         False if there is no data to receive
+     */
+    bool try_recv(void *data, nsapi_size_t size, nsapi_size_or_error_t *result)
+    {
+        *result = _socket->recv(data, size);
+        return *result != NSAPI_ERROR_WOULD_BLOCK;
+    }
+
+    /** Socket of the adapter
+     *
+     *  @return         TCP socket attached to the task
+     */
+    TCPSocket *socket() const
+    {
+        return _socket;
+    }
+
+private:
+    TCPSocket *_socket;
+};
+
+
+#endif
+
+/** @}*/
@@ -79,3 +79,8 @@ nsapi_error_t NetworkInterface::set_blocking(bool blocking)
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_error_t NetworkInterface::get_stats(nsapi_interface_stats_t *stats)
+{
+    unsigned optlen = sizeof *stats;
+    return get_stack()->getstackopt(NSAPI_STACK, NSAPI_INTERFACE_STATS, stats, &optlen);
+}
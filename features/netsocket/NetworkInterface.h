@@ -153,6 +153,19 @@ public:
      */
     virtual nsapi_error_t set_blocking(bool blocking);
 
+    /** Get interface statistics
+     *
+     *  Reads the packet, byte and drop counters of the interface, and the
+     *  number of times the stack ran out of packet buffers.
+     *
+     *  If the stack does not collect statistics, NSAPI_ERROR_UNSUPPORTED
+     *  is returned.
+     *
+     *  @param stats    Destination for the interface statistics
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t get_stats(nsapi_interface_stats_t *stats);
+
 
 protected:
     friend class Socket;
@@ -70,6 +70,48 @@ nsapi_error_t NetworkStack::getsockopt(void *handle, int level, int optname, voi
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_sendto_batch(nsapi_socket_t handle, nsapi_datagram_t *dgrams, nsapi_size_t count)
+{
+    nsapi_size_t i;
+    for (i = 0; i < count; i++) {
+        SocketAddress address(dgrams[i].addr, dgrams[i].port);
+        nsapi_size_or_error_t sent = socket_sendto(handle, address, dgrams[i].data, dgrams[i].size);
+        if (sent < 0) {
+            // Report the error only if nothing got through
+            if (i == 0) {
+                return sent;
+            }
+            break;
+        }
+
+        dgrams[i].len = sent;
+    }
+
+    return i;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvfrom_batch(nsapi_socket_t handle, nsapi_datagram_t *dgrams, nsapi_size_t count)
+{
+    nsapi_size_t i;
+    for (i = 0; i < count; i++) {
+        SocketAddress address;
+        nsapi_size_or_error_t recv = socket_recvfrom(handle, &address, dgrams[i].data, dgrams[i].size);
+        if (recv < 0) {
+            // Report the error only if nothing was received
+            if (i == 0) {
+                return recv;
+            }
+            break;
+        }
+
+        dgrams[i].addr = address.get_addr();
+        dgrams[i].port = address.get_port();
+        dgrams[i].len = recv;
+    }
+
+    return i;
+}
+
 
 // NetworkStackWrapper class for encapsulating the raw nsapi_stack structure
 class NetworkStackWrapper : public NetworkStack
@@ -275,6 +317,24 @@ protected:
 
         return _stack_api()->getsockopt(_stack(), socket, level, optname, optval, optlen);
     }
+
+    virtual nsapi_size_or_error_t socket_sendto_batch(nsapi_socket_t socket, nsapi_datagram_t *dgrams, nsapi_size_t count)
+    {
+        if (!_stack_api()->socket_sendto_batch) {
+            return NetworkStack::socket_sendto_batch(socket, dgrams, count);
+        }
+
+        return _stack_api()->socket_sendto_batch(_stack(), socket, dgrams, count);
+    }
+
+    virtual nsapi_size_or_error_t socket_recvfrom_batch(nsapi_socket_t socket, nsapi_datagram_t *dgrams, nsapi_size_t count)
+    {
+        if (!_stack_api()->socket_recvfrom_batch) {
+            return NetworkStack::socket_recvfrom_batch(socket, dgrams, count);
+        }
+
+        return _stack_api()->socket_recvfrom_batch(_stack(), socket, dgrams, count);
+    }
 };
 
 
@@ -102,6 +102,7 @@ protected:
     friend class Socket;
     friend class UDPSocket;
     friend class TCPSocket;
+    friend class TLSSocket;
     friend class TCPServer;
 
     /** Opens a socket
@@ -253,6 +254,48 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
             void *buffer, nsapi_size_t size) = 0;
 
+    /** Send a batch of packets over a UDP socket
+     *
+     *  Sends each datagram to its own address and records the number of
+     *  bytes sent in its len field. Stops at the first datagram that
+     *  cannot be sent.
+     *
+     *  This call is non-blocking. If no datagram can be sent,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation calls socket_sendto for each datagram.
+     *  Stacks can override this to submit the whole batch at once.
+     *
+     *  @param handle   Socket handle
+     *  @param dgrams   Array of datagrams to send
+     *  @param count    Number of datagrams in the array
+     *  @return         Number of datagrams sent on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendto_batch(nsapi_socket_t handle,
+            nsapi_datagram_t *dgrams, nsapi_size_t count);
+
+    /** Receive a batch of packets over a UDP socket
+     *
+     *  Receives queued datagrams into the buffers of the array, filling in
+     *  the source address, port and len of each one. Stops when no more
+     *  datagrams are queued on the socket.
+     *
+     *  This call is non-blocking. If no datagram is queued,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation calls socket_recvfrom for each datagram.
+     *  Stacks can override this to drain the receive queue at once.
+     *
+     *  @param handle   Socket handle
+     *  @param dgrams   Array of datagram buffers to receive into
+     *  @param count    Number of datagrams in the array
+     *  @return         Number of datagrams received on success, negative
+     *                  error code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvfrom_batch(nsapi_socket_t handle,
+            nsapi_datagram_t *dgrams, nsapi_size_t count);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -171,6 +171,12 @@ nsapi_error_t Socket::getsockopt(int level, int optname, void *optval, unsigned
 
 }
 
+nsapi_error_t Socket::get_stats(nsapi_socket_stats_t *stats)
+{
+    unsigned optlen = sizeof *stats;
+    return getsockopt(NSAPI_SOCKET, NSAPI_SOCKET_STATS, stats, &optlen);
+}
+
 void Socket::sigio(Callback<void()> callback)
 {
     _lock.lock();
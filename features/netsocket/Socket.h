@@ -168,6 +168,20 @@ public:
      */    
     nsapi_error_t getsockopt(int level, int optname, void *optval, unsigned *optlen);
 
+    /** Get socket statistics
+     *
+     *  Reads the byte counters, round trip time estimate and send buffer
+     *  occupancy of the socket. Equivalent to getsockopt with the
+     *  NSAPI_SOCKET_STATS option.
+     *
+     *  If the stack does not collect statistics, NSAPI_ERROR_UNSUPPORTED
+     *  is returned.
+     *
+     *  @param stats    Destination for the socket statistics
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t get_stats(nsapi_socket_stats_t *stats);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
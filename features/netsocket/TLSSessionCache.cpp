@@ -0,0 +1,187 @@
+/* TLSSessionCache
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TLSSessionCache.h"
+
+#if defined(MBEDTLS_SSL_CLI_C)
+
+#include "rtos/Kernel.h"
+#include "mbedtls/platform.h"
+#include "mbedtls/x509_crt.h"
+#include <string.h>
+
+TLSSessionCache::TLSSessionCache(uint32_t lifetime)
+    : _lifetime(lifetime), _use_counter(0)
+{
+    for (unsigned i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        _entries[i].hostname = NULL;
+        _entries[i].in_use = false;
+        mbedtls_ssl_session_init(&_entries[i].session);
+    }
+}
+
+TLSSessionCache::~TLSSessionCache()
+{
+    clear();
+}
+
+TLSSessionCache::entry *TLSSessionCache::find(const char *hostname, uint16_t port)
+{
+    if (!hostname) {
+        hostname = "";
+    }
+
+    for (unsigned i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (_entries[i].in_use && _entries[i].port == port &&
+                strcmp(_entries[i].hostname, hostname) == 0) {
+            return &_entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+void TLSSessionCache::free_entry(entry *e)
+{
+    // mbedtls_ssl_session_free zeroises the master secret
+    mbedtls_ssl_session_free(&e->session);
+    mbedtls_free(e->hostname);
+    e->hostname = NULL;
+    e->in_use = false;
+}
+
+bool TLSSessionCache::get(const char *hostname, uint16_t port, mbedtls_ssl_session *session)
+{
+    _mutex.lock();
+
+    entry *e = find(hostname, port);
+    if (!e) {
+        _mutex.unlock();
+        return false;
+    }
+
+    if (_lifetime && rtos::Kernel::get_ms_count() - e->stored_ms > (uint64_t)_lifetime * 1000) {
+        free_entry(e);
+        _mutex.unlock();
+        return false;
+    }
+
+    // Copy the fixed part and duplicate the ticket; the peer certificate
+    // is not kept, as a resumed handshake does not use it
+    mbedtls_ssl_session_free(session);
+    memcpy(session, &e->session, sizeof *session);
+    if (e->session.ticket) {
+        session->ticket = (unsigned char *)mbedtls_calloc(1, e->session.ticket_len);
+        if (!session->ticket) {
+            mbedtls_ssl_session_init(session);
+            _mutex.unlock();
+            return false;
+        }
+        memcpy(session->ticket, e->session.ticket, e->session.ticket_len);
+    }
+
+    e->last_used = ++_use_counter;
+    _mutex.unlock();
+    return true;
+}
+
+void TLSSessionCache::set(const char *hostname, uint16_t port, const mbedtls_ssl_context *ssl)
+{
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    if (mbedtls_ssl_get_session(ssl, &session) != 0) {
+        mbedtls_ssl_session_free(&session);
+        return;
+    }
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    if (session.peer_cert) {
+        mbedtls_x509_crt_free(session.peer_cert);
+        mbedtls_free(session.peer_cert);
+        session.peer_cert = NULL;
+    }
+#endif
+
+    if (!hostname) {
+        hostname = "";
+    }
+    size_t hostname_len = strlen(hostname) + 1;
+    char *name = (char *)mbedtls_calloc(1, hostname_len);
+    if (!name) {
+        mbedtls_ssl_session_free(&session);
+        return;
+    }
+    memcpy(name, hostname, hostname_len);
+
+    _mutex.lock();
+
+    // Replace the server's existing entry, else a free one, else the
+    // least recently used
+    entry *e = find(hostname, port);
+    for (unsigned i = 0; !e && i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (!_entries[i].in_use) {
+            e = &_entries[i];
+        }
+    }
+    if (!e) {
+        e = &_entries[0];
+        for (unsigned i = 1; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+            if (_entries[i].last_used < e->last_used) {
+                e = &_entries[i];
+            }
+        }
+    }
+
+    if (e->in_use) {
+        free_entry(e);
+    }
+
+    e->hostname = name;
+    e->port = port;
+    e->session = session;
+    e->stored_ms = rtos::Kernel::get_ms_count();
+    e->last_used = ++_use_counter;
+    e->in_use = true;
+
+    _mutex.unlock();
+}
+
+void TLSSessionCache::remove(const char *hostname, uint16_t port)
+{
+    _mutex.lock();
+
+    entry *e = find(hostname, port);
+    if (e) {
+        free_entry(e);
+    }
+
+    _mutex.unlock();
+}
+
+void TLSSessionCache::clear()
+{
+    _mutex.lock();
+
+    for (unsigned i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (_entries[i].in_use) {
+            free_entry(&_entries[i]);
+        }
+    }
+
+    _mutex.unlock();
+}
+
+#endif
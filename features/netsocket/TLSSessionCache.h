@@ -0,0 +1,111 @@
+/** \addtogroup netsocket */
+/** @{*/
+/* TLSSessionCache
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TLSSESSIONCACHE_H
+#define TLSSESSIONCACHE_H
+
+#include "mbedtls/ssl.h"
+#include "rtos/Mutex.h"
+#include "platform/NonCopyable.h"
+
+#if defined(MBEDTLS_SSL_CLI_C)
+
+#ifndef MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE
+#define MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE 4
+#endif
+
+/** Client-side cache of TLS sessions
+ *
+ *  Holds the session (master secret, session ID and any session ticket)
+ *  from completed handshakes, keyed by server name and port, so that a
+ *  later TLSSocket connection to the same server can resume it with an
+ *  abbreviated handshake instead of repeating the key exchange.
+ *
+ *  When full, the least recently used session is replaced. The cache is
+ *  thread safe and may be shared by any number of sockets.
+ */
+class TLSSessionCache : private mbed::NonCopyable<TLSSessionCache> {
+public:
+    /** Create an empty session cache
+     *
+     *  @param lifetime Seconds after which a stored session is no longer
+     *                  offered for resumption, 0 for no limit
+     */
+    TLSSessionCache(uint32_t lifetime = 86400);
+
+    /** Destroy the cache, wiping all stored sessions
+     */
+    ~TLSSessionCache();
+
+    /** Look up a session for a server
+     *
+     *  @param hostname Server name used for the connection
+     *  @param port     Server port
+     *  @param session  Destination for a copy of the stored session,
+     *                  which must have been initialised with
+     *                  mbedtls_ssl_session_init
+     *  @return         True if a usable session was found
+     */
+    bool get(const char *hostname, uint16_t port, mbedtls_ssl_session *session);
+
+    /** Store the session of a completed handshake
+     *
+     *  @param hostname Server name used for the connection
+     *  @param port     Server port
+     *  @param ssl      SSL context that has completed a handshake
+     */
+    void set(const char *hostname, uint16_t port, const mbedtls_ssl_context *ssl);
+
+    /** Forget the session for a server
+     *
+     *  Used when a server rejects a resumption attempt or the connection
+     *  fails, so the stale session is not offered again.
+     *
+     *  @param hostname Server name used for the connection
+     *  @param port     Server port
+     */
+    void remove(const char *hostname, uint16_t port);
+
+    /** Remove all stored sessions
+     */
+    void clear();
+
+private:
+    struct entry {
+        char *hostname;
+        uint16_t port;
+        uint32_t last_used;
+        uint64_t stored_ms;
+        bool in_use;
+        mbedtls_ssl_session session;
+    };
+
+    entry *find(const char *hostname, uint16_t port);
+    void free_entry(entry *e);
+
+    entry _entries[MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE];
+    uint32_t _lifetime;
+    uint32_t _use_counter;
+    rtos::Mutex _mutex;
+};
+
+#endif
+
+#endif
+
+/** @}*/
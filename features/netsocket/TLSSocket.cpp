@@ -0,0 +1,571 @@
+/* TLSSocket
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TLSSocket.h"
+
+#if defined(MBEDTLS_SSL_CLI_C)
+
+#include "mbedtls/platform.h"
+#include "mbedtls/net_sockets.h"
+#include "mbedtls/error.h"
+#include "platform/SingletonPtr.h"
+#include "mbed_assert.h"
+#include "rtos/Thread.h"
+#include <string.h>
+
+#define READ_FLAG           0x1u
+#define WRITE_FLAG          0x2u
+
+#if MBED_CONF_NSAPI_TLS_DEFAULT_SESSION_CACHE
+static SingletonPtr<TLSSessionCache> default_session_cache;
+#endif
+
+TLSSocket::TLSSocket()
+{
+    init();
+}
+
+void TLSSocket::init()
+{
+#if !defined(MBED_DRBG_PRESENT)
+    mbedtls_entropy_init(&_entropy);
+    mbedtls_ctr_drbg_init(&_drbg);
+#endif
+    mbedtls_x509_crt_init(&_cacert);
+    mbedtls_x509_crt_init(&_clicert);
+    mbedtls_pk_init(&_pkey);
+    mbedtls_ssl_config_init(&_conf);
+    mbedtls_ssl_init(&_ssl);
+
+#if MBED_CONF_NSAPI_TLS_DEFAULT_SESSION_CACHE
+    _session_cache = default_session_cache.get();
+#else
+    _session_cache = NULL;
+#endif
+    _hostname = NULL;
+    _port = 0;
+    _tls_error = 0;
+    _transport_error = NSAPI_ERROR_OK;
+    _tls_initialized = false;
+    _ssl_setup = false;
+    _ssl_ready = false;
+    _tcp_connected = false;
+    _handshake_done = false;
+    _offered_session = false;
+    _resumed = false;
+}
+
+TLSSocket::~TLSSocket()
+{
+    close();
+
+    mbedtls_ssl_free(&_ssl);
+    mbedtls_ssl_config_free(&_conf);
+    mbedtls_pk_free(&_pkey);
+    mbedtls_x509_crt_free(&_clicert);
+    mbedtls_x509_crt_free(&_cacert);
+#if !defined(MBED_DRBG_PRESENT)
+    mbedtls_ctr_drbg_free(&_drbg);
+    mbedtls_entropy_free(&_entropy);
+#endif
+    mbedtls_free(_hostname);
+}
+
+nsapi_error_t TLSSocket::tls_error(int err)
+{
+    _tls_error = err;
+
+    switch (err) {
+        case 0:
+            return NSAPI_ERROR_OK;
+        case MBEDTLS_ERR_SSL_WANT_READ:
+        case MBEDTLS_ERR_SSL_WANT_WRITE:
+        case MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS:
+            return NSAPI_ERROR_WOULD_BLOCK;
+        case MBEDTLS_ERR_SSL_ALLOC_FAILED:
+        case MBEDTLS_ERR_X509_ALLOC_FAILED:
+            return NSAPI_ERROR_NO_MEMORY;
+        case MBEDTLS_ERR_X509_CERT_VERIFY_FAILED:
+        case MBEDTLS_ERR_SSL_FATAL_ALERT_MESSAGE:
+        case MBEDTLS_ERR_SSL_NO_CLIENT_CERTIFICATE:
+            return NSAPI_ERROR_AUTH_FAILURE;
+        case MBEDTLS_ERR_SSL_CONN_EOF:
+        case MBEDTLS_ERR_NET_CONN_RESET:
+            return NSAPI_ERROR_CONNECTION_LOST;
+        case MBEDTLS_ERR_NET_SEND_FAILED:
+        case MBEDTLS_ERR_NET_RECV_FAILED:
+            return _transport_error;
+        default:
+            return NSAPI_ERROR_DEVICE_ERROR;
+    }
+}
+
+int TLSSocket::ssl_send(void *ctx, const unsigned char *buf, size_t len)
+{
+    TLSSocket *socket = static_cast<TLSSocket *>(ctx);
+
+    if (!socket->_socket) {
+        return MBEDTLS_ERR_NET_CONN_RESET;
+    }
+
+    nsapi_size_or_error_t ret = socket->_stack->socket_send(socket->_socket, buf, len);
+    if (ret == NSAPI_ERROR_WOULD_BLOCK) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    } else if (ret < 0) {
+        socket->_transport_error = ret;
+        return MBEDTLS_ERR_NET_SEND_FAILED;
+    }
+
+    return ret;
+}
+
+int TLSSocket::ssl_recv(void *ctx, unsigned char *buf, size_t len)
+{
+    TLSSocket *socket = static_cast<TLSSocket *>(ctx);
+
+    if (!socket->_socket) {
+        return MBEDTLS_ERR_NET_CONN_RESET;
+    }
+
+    nsapi_size_or_error_t ret = socket->_stack->socket_recv(socket->_socket, buf, len);
+    if (ret == NSAPI_ERROR_WOULD_BLOCK) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    } else if (ret < 0) {
+        socket->_transport_error = ret;
+        return MBEDTLS_ERR_NET_RECV_FAILED;
+    }
+
+    // 0 is end of stream, which mbed TLS reports as MBEDTLS_ERR_SSL_CONN_EOF
+    return ret;
+}
+
+// Wait for the transport to become ready for the operation mbed TLS is
+// waiting on. Call with the lock held; returns false on timeout.
+bool TLSSocket::wait_for(int err)
+{
+    uint32_t flag;
+
+    // Release lock before blocking so other threads
+    // accessing this object aren't blocked
+    _lock.unlock();
+    flag = _event_flag.wait_any(err == MBEDTLS_ERR_SSL_WANT_WRITE ? WRITE_FLAG : READ_FLAG, _timeout);
+    _lock.lock();
+
+    return !(flag & osFlagsError);
+}
+
+nsapi_error_t TLSSocket::init_tls()
+{
+    if (_tls_initialized) {
+        return NSAPI_ERROR_OK;
+    }
+
+#if defined(MBED_DRBG_PRESENT)
+    /* One DRBG for all sockets, seeded once rather than per connection */
+    int err = mbed_drbg_init();
+#else
+    static const char pers[] = "TLSSocket";
+    int err = mbedtls_ctr_drbg_seed(&_drbg, mbedtls_entropy_func, &_entropy,
+                                    (const unsigned char *)pers, sizeof pers - 1);
+#endif
+    if (err) {
+        return tls_error(err);
+    }
+
+    err = mbedtls_ssl_config_defaults(&_conf, MBEDTLS_SSL_IS_CLIENT,
+                                      MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
+    if (err) {
+        return tls_error(err);
+    }
+
+#if defined(MBED_DRBG_PRESENT)
+    mbedtls_ssl_conf_rng(&_conf, mbed_drbg_random, NULL);
+#else
+    mbedtls_ssl_conf_rng(&_conf, mbedtls_ctr_drbg_random, &_drbg);
+#endif
+    mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+    mbedtls_ssl_conf_ca_chain(&_conf, &_cacert, NULL);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    mbedtls_ssl_conf_session_tickets(&_conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+
+    _tls_initialized = true;
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t TLSSocket::set_root_ca_cert(const void *root_ca, size_t len)
+{
+    _lock.lock();
+    nsapi_error_t ret = init_tls();
+    if (!ret) {
+        ret = tls_error(mbedtls_x509_crt_parse(&_cacert, static_cast<const unsigned char *>(root_ca), len));
+        if (ret == NSAPI_ERROR_DEVICE_ERROR) {
+            ret = NSAPI_ERROR_PARAMETER;
+        }
+    }
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t TLSSocket::set_root_ca_cert(const char *root_ca_pem)
+{
+    return set_root_ca_cert(root_ca_pem, strlen(root_ca_pem) + 1);
+}
+
+nsapi_error_t TLSSocket::set_client_cert_key(const void *client_cert, size_t cert_len,
+                                             const void *client_key, size_t key_len)
+{
+    _lock.lock();
+    nsapi_error_t ret = init_tls();
+    if (ret) {
+        _lock.unlock();
+        return ret;
+    }
+
+    int err = mbedtls_x509_crt_parse(&_clicert, static_cast<const unsigned char *>(client_cert), cert_len);
+    if (!err) {
+        err = mbedtls_pk_parse_key(&_pkey, static_cast<const unsigned char *>(client_key), key_len, NULL, 0);
+    }
+    if (!err) {
+        err = mbedtls_ssl_conf_own_cert(&_conf, &_clicert, &_pkey);
+    }
+
+    ret = tls_error(err);
+    if (ret == NSAPI_ERROR_DEVICE_ERROR) {
+        ret = NSAPI_ERROR_PARAMETER;
+    }
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t TLSSocket::set_hostname(const char *hostname)
+{
+    size_t len = strlen(hostname) + 1;
+    char *copy = static_cast<char *>(mbedtls_calloc(1, len));
+    if (!copy) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    memcpy(copy, hostname, len);
+
+    _lock.lock();
+    mbedtls_free(_hostname);
+    _hostname = copy;
+    _lock.unlock();
+    return NSAPI_ERROR_OK;
+}
+
+void TLSSocket::set_session_cache(TLSSessionCache *cache)
+{
+    _lock.lock();
+    _session_cache = cache;
+    _lock.unlock();
+}
+
+mbedtls_ssl_config *TLSSocket::get_ssl_config()
+{
+    _lock.lock();
+    init_tls();
+    _lock.unlock();
+    return &_conf;
+}
+
+mbedtls_ssl_context *TLSSocket::get_ssl_context()
+{
+    return &_ssl;
+}
+
+bool TLSSocket::is_resumed() const
+{
+    return _resumed;
+}
+
+int TLSSocket::get_tls_error() const
+{
+    return _tls_error;
+}
+
+// Prepare the SSL context for a new connection, offering a cached session
+nsapi_error_t TLSSocket::setup_connection(uint16_t port)
+{
+    nsapi_error_t ret = init_tls();
+    if (ret) {
+        return ret;
+    }
+
+    // A context left by a failed handshake was reset, it is not set up again
+    if (!_ssl_setup) {
+        int err = mbedtls_ssl_setup(&_ssl, &_conf);
+        if (err) {
+            return tls_error(err);
+        }
+        _ssl_setup = true;
+    }
+
+    if (_hostname) {
+        int err = mbedtls_ssl_set_hostname(&_ssl, _hostname);
+        if (err) {
+            return tls_error(err);
+        }
+    }
+
+    mbedtls_ssl_set_bio(&_ssl, this, ssl_send, ssl_recv, NULL);
+    _port = port;
+    _offered_session = false;
+    _resumed = false;
+
+    if (_session_cache) {
+        mbedtls_ssl_session session;
+        mbedtls_ssl_session_init(&session);
+        if (_session_cache->get(_hostname, _port, &session) &&
+                mbedtls_ssl_set_session(&_ssl, &session) == 0) {
+            // A resumed handshake reuses the master secret, which is how
+            // resumption is told apart from a fallback to a full handshake
+            memcpy(_offered_master, session.master, sizeof _offered_master);
+            _offered_session = true;
+        }
+        mbedtls_ssl_session_free(&session);
+    }
+
+    _ssl_ready = true;
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t TLSSocket::handshake()
+{
+    while (true) {
+        _pending = 0;
+        int err = mbedtls_ssl_handshake(&_ssl);
+        if (err == 0) {
+            break;
+        }
+
+        nsapi_error_t ret = tls_error(err);
+        if (ret != NSAPI_ERROR_WOULD_BLOCK) {
+            // Don't offer a session that may be why the handshake failed
+            if (_offered_session && _session_cache) {
+                _session_cache->remove(_hostname, _port);
+            }
+            // The context can't carry on, the next connect starts over
+            mbedtls_ssl_session_reset(&_ssl);
+            _ssl_ready = false;
+            _tcp_connected = false;
+            return ret;
+        }
+
+        if (err == MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS) {
+            // A slice of restartable ECC work is done; nothing to wait for
+            // on the transport, so let other threads run and carry on
+            if (_timeout == 0) {
+                return NSAPI_ERROR_IN_PROGRESS;
+            }
+            _lock.unlock();
+            rtos::Thread::yield();
+            _lock.lock();
+            continue;
+        }
+
+        if (_timeout == 0 || !wait_for(err)) {
+            return NSAPI_ERROR_IN_PROGRESS;
+        }
+    }
+
+    _handshake_done = true;
+    _resumed = _offered_session &&
+               memcmp(_ssl.session->master, _offered_master, sizeof _offered_master) == 0;
+    memset(_offered_master, 0, sizeof _offered_master);
+
+    if (_session_cache) {
+        _session_cache->set(_hostname, _port, &_ssl);
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t TLSSocket::connect(const SocketAddress &address)
+{
+    _lock.lock();
+    nsapi_error_t ret;
+
+    if (_handshake_done) {
+        _lock.unlock();
+        return NSAPI_ERROR_IS_CONNECTED;
+    }
+
+    // Without a server name, the certificate of any server signed by a
+    // trusted CA would be accepted
+    if (!_hostname && (!_tls_initialized || _conf.authmode != MBEDTLS_SSL_VERIFY_NONE)) {
+        _lock.unlock();
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    if (!_ssl_ready) {
+        ret = setup_connection(address.get_port());
+        if (ret) {
+            _lock.unlock();
+            return ret;
+        }
+    }
+
+    if (!_tcp_connected) {
+        ret = TCPSocket::connect(address);
+        if (ret == NSAPI_ERROR_OK || ret == NSAPI_ERROR_IS_CONNECTED) {
+            _tcp_connected = true;
+        } else {
+            _lock.unlock();
+            return ret == NSAPI_ERROR_ALREADY ? NSAPI_ERROR_IN_PROGRESS : ret;
+        }
+    }
+
+    ret = handshake();
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t TLSSocket::connect(const char *host, uint16_t port)
+{
+    if (!_hostname) {
+        nsapi_error_t err = set_hostname(host);
+        if (err) {
+            return err;
+        }
+    }
+
+    if (!_stack) {
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    SocketAddress address;
+    nsapi_error_t err = _stack->gethostbyname(host, &address);
+    if (err) {
+        return NSAPI_ERROR_DNS_FAILURE;
+    }
+
+    address.set_port(port);
+
+    // connect is thread safe
+    return connect(address);
+}
+
+nsapi_size_or_error_t TLSSocket::send(const void *data, nsapi_size_t size)
+{
+    _lock.lock();
+    const unsigned char *data_ptr = static_cast<const unsigned char *>(data);
+    nsapi_size_or_error_t ret = NSAPI_ERROR_OK;
+    nsapi_size_t written = 0;
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(!_write_in_progress);
+    _write_in_progress = true;
+
+    while (written < size) {
+        if (!_handshake_done) {
+            ret = NSAPI_ERROR_NO_CONNECTION;
+            break;
+        }
+
+        _pending = 0;
+        int err = mbedtls_ssl_write(&_ssl, data_ptr + written, size - written);
+        if (err >= 0) {
+            written += err;
+            continue;
+        }
+
+        ret = tls_error(err);
+        if (ret != NSAPI_ERROR_WOULD_BLOCK || _timeout == 0 || !wait_for(err)) {
+            break;
+        }
+    }
+
+    _write_in_progress = false;
+    _lock.unlock();
+    if (ret < 0 && ret != NSAPI_ERROR_WOULD_BLOCK) {
+        return ret;
+    } else if (written == 0 && size != 0) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    } else {
+        return written;
+    }
+}
+
+nsapi_size_or_error_t TLSSocket::recv(void *data, nsapi_size_t size)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(!_read_in_progress);
+    _read_in_progress = true;
+
+    while (true) {
+        if (!_handshake_done) {
+            ret = NSAPI_ERROR_NO_CONNECTION;
+            break;
+        }
+
+        _pending = 0;
+        int err = mbedtls_ssl_read(&_ssl, static_cast<unsigned char *>(data), size);
+        if (err >= 0) {
+            ret = err;
+            break;
+        } else if (err == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY || err == MBEDTLS_ERR_SSL_CONN_EOF) {
+            ret = 0;
+            break;
+        }
+
+        ret = tls_error(err);
+        if (ret != NSAPI_ERROR_WOULD_BLOCK || _timeout == 0) {
+            break;
+        } else if (!wait_for(err)) {
+            // Timeout break
+            ret = NSAPI_ERROR_WOULD_BLOCK;
+            break;
+        }
+    }
+
+    _read_in_progress = false;
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t TLSSocket::close()
+{
+    _lock.lock();
+
+    if (_handshake_done && _socket) {
+        // Best effort; the connection is closed whether or not it is sent
+        mbedtls_ssl_close_notify(&_ssl);
+    }
+
+    if (_ssl_setup) {
+        mbedtls_ssl_free(&_ssl);
+        mbedtls_ssl_init(&_ssl);
+    }
+
+    _ssl_setup = false;
+    _ssl_ready = false;
+    _tcp_connected = false;
+    _handshake_done = false;
+
+    nsapi_error_t ret = TCPSocket::close();
+    _lock.unlock();
+    return ret;
+}
+
+#endif
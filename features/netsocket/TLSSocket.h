@@ -0,0 +1,276 @@
+/** \addtogroup netsocket */
+/** @{*/
+/* TLSSocket
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TLSSOCKET_H
+#define TLSSOCKET_H
+
+#include "netsocket/TCPSocket.h"
+#include "netsocket/TLSSessionCache.h"
+
+#include "mbedtls/ssl.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#include "mbed_drbg.h"
+#include "mbedtls/pk.h"
+
+#if defined(MBEDTLS_SSL_CLI_C)
+
+/** TLS client socket
+ *
+ *  A TCPSocket that runs TLS over its connection using mbed TLS.
+ *
+ *  connect() opens the TCP connection and performs the handshake. If the
+ *  socket's TLSSessionCache holds a session for the server, it is offered
+ *  for resumption, by session ticket if one was issued and by session ID
+ *  otherwise, and the session from every completed handshake is stored
+ *  back into the cache.
+ *
+ *  Blocking, timeout and non-blocking modes and sigio behave as for
+ *  TCPSocket. In non-blocking mode connect() returns
+ *  NSAPI_ERROR_IN_PROGRESS until the handshake completes, and a send()
+ *  that returns NSAPI_ERROR_WOULD_BLOCK must be repeated with the same
+ *  data. After a sigio callback, call recv() until it returns
+ *  NSAPI_ERROR_WOULD_BLOCK, as several records may have arrived.
+ *
+ *  If mbed TLS is built with MBEDTLS_ECP_RESTARTABLE and a budget is set
+ *  with mbedtls_ecp_set_max_ops(), the elliptic curve operations of the
+ *  handshake run in slices. A blocking connect() yields to other threads
+ *  between slices; in non-blocking mode connect() returns
+ *  NSAPI_ERROR_IN_PROGRESS after each slice without a sigio, so an event
+ *  loop should call it again.
+ *
+ *  The TCPSocket is a protected base: its connect(), send() and recv() are
+ *  not virtual, so a TLSSocket used through a TCPSocket or Socket pointer
+ *  would send and receive plaintext. The conversion does not compile, and
+ *  the socket options are made public again below.
+ */
+class TLSSocket : protected TCPSocket {
+public:
+    using TCPSocket::open;
+    using TCPSocket::bind;
+    using TCPSocket::set_blocking;
+    using TCPSocket::set_timeout;
+    using TCPSocket::setsockopt;
+    using TCPSocket::getsockopt;
+    using TCPSocket::get_stats;
+    using TCPSocket::sigio;
+    using TCPSocket::attach;
+
+    /** Create an uninitialized socket
+     *
+     *  Must call open to initialize the socket on a network stack.
+     */
+    TLSSocket();
+
+    /** Create a socket on a network interface
+     *
+     *  Creates and opens a socket on the network stack of the given
+     *  network interface.
+     *
+     *  @param stack    Network stack as target for socket
+     */
+    template <typename S>
+    TLSSocket(S *stack)
+    {
+        init();
+        open(stack);
+    }
+
+    /** Destroy a socket
+     *
+     *  Closes socket if the socket is still open
+     */
+    virtual ~TLSSocket();
+
+    /** Set the trusted root certificates
+     *
+     *  The server certificate is verified against these during the
+     *  handshake, and the connection fails if it does not verify.
+     *
+     *  @param root_ca  Certificates in PEM (null terminated) or DER form
+     *  @param len      Length of the certificate data, including the
+     *                  terminating null for PEM
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t set_root_ca_cert(const void *root_ca, size_t len);
+
+    /** Set the trusted root certificates from a PEM string
+     *
+     *  @param root_ca_pem  Null terminated PEM certificates
+     *  @return             0 on success, negative error code on failure
+     */
+    nsapi_error_t set_root_ca_cert(const char *root_ca_pem);
+
+    /** Set the client certificate and private key
+     *
+     *  Only needed if the server requests client authentication.
+     *
+     *  @param client_cert  Certificate in PEM (null terminated) or DER form
+     *  @param cert_len     Length of the certificate
+     *  @param client_key   Private key in PEM (null terminated) or DER form
+     *  @param key_len      Length of the key
+     *  @return             0 on success, negative error code on failure
+     */
+    nsapi_error_t set_client_cert_key(const void *client_cert, size_t cert_len,
+                                      const void *client_key, size_t key_len);
+
+    /** Set the server name
+     *
+     *  Used for SNI, to verify the server certificate and to key the
+     *  session cache. Defaults to the host passed to connect().
+     *
+     *  @param hostname Server name, copied by the socket
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t set_hostname(const char *hostname);
+
+    /** Set the session cache used for resumption
+     *
+     *  Defaults to a cache shared by all TLSSockets if
+     *  nsapi.tls-default-session-cache is enabled.
+     *
+     *  @param cache    Session cache, or NULL to always use full handshakes
+     */
+    void set_session_cache(TLSSessionCache *cache);
+
+    /** Connects to a remote host and performs the TLS handshake
+     *
+     *  @param host     Hostname of the remote host
+     *  @param port     Port of the remote host
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t connect(const char *host, uint16_t port);
+
+    /** Connects to a remote host and performs the TLS handshake
+     *
+     *  set_hostname must have been called to give the server name, which
+     *  the server certificate is verified against. Without it the
+     *  connection is refused with NSAPI_ERROR_PARAMETER, unless the
+     *  verification was turned off with mbedtls_ssl_conf_authmode() and
+     *  MBEDTLS_SSL_VERIFY_NONE on get_ssl_config().
+     *
+     *  If the handshake fails, the TLS context is reset and the next
+     *  connect() starts a new handshake.
+     *
+     *  @param address  The SocketAddress of the remote host
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t connect(const SocketAddress &address);
+
+    /** Send data over the TLS connection
+     *
+     *  @param data     Buffer of data to send to the host
+     *  @param size     Size of the buffer in bytes
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     *  @see TCPSocket::send
+     */
+    nsapi_size_or_error_t send(const void *data, nsapi_size_t size);
+
+    /** Receive data over the TLS connection
+     *
+     *  Records are decrypted in place in the mbed TLS input buffer, the
+     *  data is copied once, from there into data.
+     *
+     *  @param data     Destination buffer for data received from the host
+     *  @param size     Size of the buffer in bytes
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure. Returns 0 once the peer has closed
+     *                  the connection.
+     *  @see TCPSocket::recv
+     */
+    nsapi_size_or_error_t recv(void *data, nsapi_size_t size);
+
+    /** Close the connection
+     *
+     *  Sends a close_notify alert if connected, then closes the socket.
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t close();
+
+    /** Check whether the last handshake resumed a cached session
+     *
+     *  @return         True if the connection was made by resumption
+     */
+    bool is_resumed() const;
+
+    /** Get the most recent mbed TLS error
+     *
+     *  @return         mbed TLS error code behind the last failure, or 0
+     */
+    int get_tls_error() const;
+
+    /** Get the mbed TLS configuration
+     *
+     *  Can be used to adjust ciphersuites, verification and so on before
+     *  connecting.
+     *
+     *  @return         Configuration used for this socket's connections
+     */
+    mbedtls_ssl_config *get_ssl_config();
+
+    /** Get the mbed TLS context
+     *
+     *  @return         SSL context of the current connection
+     */
+    mbedtls_ssl_context *get_ssl_context();
+
+protected:
+    void init();
+    nsapi_error_t init_tls();
+    nsapi_error_t setup_connection(uint16_t port);
+    nsapi_error_t handshake();
+    nsapi_error_t tls_error(int err);
+    bool wait_for(int err);
+
+    static int ssl_send(void *ctx, const unsigned char *buf, size_t len);
+    static int ssl_recv(void *ctx, unsigned char *buf, size_t len);
+
+#if !defined(MBED_DRBG_PRESENT)
+    mbedtls_entropy_context _entropy;
+    mbedtls_ctr_drbg_context _drbg;
+#endif
+    mbedtls_x509_crt _cacert;
+    mbedtls_x509_crt _clicert;
+    mbedtls_pk_context _pkey;
+    mbedtls_ssl_config _conf;
+    mbedtls_ssl_context _ssl;
+
+    TLSSessionCache *_session_cache;
+    char *_hostname;
+    uint16_t _port;
+    int _tls_error;
+    nsapi_error_t _transport_error;
+
+    bool _tls_initialized;
+    bool _ssl_setup;
+    bool _ssl_ready;
+    bool _tcp_connected;
+    bool _handshake_done;
+    bool _offered_session;
+    bool _resumed;
+    unsigned char _offered_master[48];
+};
+
+#endif
+
+#endif
+
+/** @}*/
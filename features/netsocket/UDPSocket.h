@@ -113,6 +113,43 @@ public:
     nsapi_size_or_error_t recvfrom(SocketAddress *address,
             void *data, nsapi_size_t size);
 
+    /** Send a batch of packets over a UDP socket
+     *
+     *  Sends each datagram in the array to the address and port stored in
+     *  it, and records the number of bytes sent in its len field. The
+     *  whole batch is handed to the network stack in one call, which
+     *  avoids the per-datagram locking overhead of sendto.
+     *
+     *  By default, sendto_batch blocks until at least one datagram is sent.
+     *  If socket is set to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK
+     *  is returned immediately.
+     *
+     *  @param dgrams   Array of datagrams to send
+     *  @param count    Number of datagrams in the array
+     *  @return         Number of sent datagrams on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t sendto_batch(nsapi_datagram_t *dgrams, nsapi_size_t count);
+
+    /** Receive a batch of datagrams over a UDP socket
+     *
+     *  Receives queued datagrams into the buffers described by the array,
+     *  and stores the source address, port and number of received bytes in
+     *  each entry. If a datagram is larger than its buffer, the excess data
+     *  is silently discarded.
+     *
+     *  By default, recvfrom_batch blocks until at least one datagram is
+     *  received, then returns whatever else is already queued. If socket is
+     *  set to non-blocking or times out with no datagram,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned.
+     *
+     *  @param dgrams   Array of datagram buffers to receive into
+     *  @param count    Number of datagrams in the array
+     *  @return         Number of received datagrams on success, negative
+     *                  error code on failure
+     */
+    nsapi_size_or_error_t recvfrom_batch(nsapi_datagram_t *dgrams, nsapi_size_t count);
+
 protected:
     virtual nsapi_protocol_t get_proto();
     virtual void event();
@@ -20,6 +20,10 @@
 
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * Stack memory module
  *
@@ -103,6 +107,49 @@ emac_stack_mem_t *emac_stack_mem_chain_dequeue(emac_stack_t* stack, emac_stack_m
  */
 uint32_t emac_stack_mem_chain_len(emac_stack_t* stack, emac_stack_mem_chain_t *chain);
 
+/**
+ * Returns the memory structure following the given one in a chain, without modifying the chain
+ *
+ * @param  stack Emac stack context
+ * @param  mem   Memory structure within a chain
+ * @return       Next memory structure, or NULL at the end of the chain
+ */
+emac_stack_mem_t *emac_stack_mem_chain_next(emac_stack_t* stack, emac_stack_mem_t *mem);
+
+/**
+ * Allocates memory from the stack's pre-allocated receive pool
+ *
+ * The pool consists of fixed size units, see @a emac_stack_mem_pool_unit_size.
+ * Requests larger than one unit are returned as a chain of units, so drivers
+ * can post them to a scatter-gather receive ring and pass the filled chain
+ * straight to the input callback without copying. Drivers with
+ * @a EMAC_CAP_RX_POOL get their chains posted by the stack instead.
+ *
+ * @param  stack Emac stack context
+ * @param  size  Size of memory to allocate
+ * @return       Allocated memory chain, or NULL if the pool is exhausted
+ */
+emac_stack_mem_chain_t *emac_stack_mem_pool_alloc(emac_stack_t* stack, uint32_t size);
+
+/**
+ * Sets the total length of a chain, dropping the memory past it
+ *
+ * Used by drivers to trim a receive pool chain to the received frame.
+ *
+ * @param stack Emac stack context
+ * @param chain Memory chain
+ * @param len   Length to set, not larger than the length of the chain
+ */
+void emac_stack_mem_chain_set_len(emac_stack_t* stack, emac_stack_mem_chain_t *chain, uint32_t len);
+
+/**
+ * Return the payload size of a single receive pool unit
+ *
+ * @param  stack Emac stack context
+ * @return       Size in bytes
+ */
+uint32_t emac_stack_mem_pool_unit_size(emac_stack_t* stack);
+
 /**
  * Increases the reference counter for the memory
  *
@@ -111,6 +158,10 @@ uint32_t emac_stack_mem_chain_len(emac_stack_t* stack, emac_stack_mem_chain_t *c
  */
 void emac_stack_mem_ref(emac_stack_t* stack, emac_stack_mem_t *mem);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* DEVICE_EMAC */
 
 #endif /* EMAC_MBED_STACK_MEM_h */
@@ -215,6 +215,7 @@ typedef enum nsapi_stack_level {
 typedef enum nsapi_stack_option {
     NSAPI_IPV4_MRU, /*!< Sets/gets size of largest IPv4 fragmented datagram to reassemble */
     NSAPI_IPV6_MRU, /*!< Sets/gets size of largest IPv6 fragmented datagram to reassemble */
+    NSAPI_INTERFACE_STATS, /*!< Gets interface counters as nsapi_interface_stats_t (read only) */
 } nsapi_stack_option_t;
 
 /** Enum of standardized socket option levels
@@ -244,6 +245,7 @@ typedef enum nsapi_socket_option {
     NSAPI_RCVBUF,            /*!< Sets recv buffer size */
     NSAPI_ADD_MEMBERSHIP,    /*!< Add membership to multicast address */
     NSAPI_DROP_MEMBERSHIP,   /*!< Drop membership to multicast address */
+    NSAPI_SOCKET_STATS,      /*!< Gets socket counters as nsapi_socket_stats_t (read only) */
 } nsapi_socket_option_t;
 
 /** Supported IP protocol versions of IP stack
@@ -274,6 +276,35 @@ typedef struct nsapi_wifi_ap {
 } nsapi_wifi_ap_t;
 
 
+/** nsapi_interface_stats structure
+ *
+ *  Counters of a network interface, see NetworkInterface::get_stats.
+ *  Counters that a stack does not track are left at zero.
+ */
+typedef struct nsapi_interface_stats {
+    uint32_t rx_packets;        /*!< Packets received and passed to the stack */
+    uint32_t rx_bytes;          /*!< Bytes received and passed to the stack */
+    uint32_t rx_drops;          /*!< Received packets dropped by the stack */
+    uint32_t tx_packets;        /*!< Packets transmitted */
+    uint32_t tx_bytes;          /*!< Bytes transmitted */
+    uint32_t tx_drops;          /*!< Packets the driver failed to transmit */
+    uint32_t buffer_exhausted;  /*!< Failed packet buffer allocations */
+} nsapi_interface_stats_t;
+
+/** nsapi_socket_stats structure
+ *
+ *  Counters of a socket, see Socket::get_stats.
+ *  Counters that a stack does not track are left at zero.
+ */
+typedef struct nsapi_socket_stats {
+    uint32_t tx_bytes;          /*!< Bytes accepted from the application for sending */
+    uint32_t rx_bytes;          /*!< Bytes delivered to the application */
+    uint32_t rtt_ms;            /*!< Smoothed round trip time estimate in milliseconds (TCP) */
+    uint32_t retransmits;       /*!< Retransmissions of the oldest unacknowledged segment (TCP) */
+    uint32_t sndbuf_used;       /*!< Bytes waiting in the send buffer (TCP) */
+    uint32_t sndbuf_size;       /*!< Size of the send buffer in bytes (TCP) */
+} nsapi_socket_stats_t;
+
 /** nsapi_stack structure
  *
  *  Stack structure representing a specific instance of a stack.
@@ -302,6 +333,23 @@ typedef struct nsapi_ip_mreq {
     nsapi_addr_t imr_interface; /* local IP address of interface */
 } nsapi_ip_mreq_t;
 
+/** nsapi_datagram structure
+ *
+ *  Describes one datagram of a batched sendto or recvfrom operation.
+ *  For sends, addr, port, data and size describe the datagram to send.
+ *  For receives, data and size describe the destination buffer and addr
+ *  and port are filled in with the source of the datagram.
+ *
+ *  On completion, len holds the number of bytes transferred.
+ */
+typedef struct nsapi_datagram {
+    nsapi_addr_t addr;      /* Remote address */
+    uint16_t port;          /* Remote port */
+    void *data;             /* Datagram payload or destination buffer */
+    nsapi_size_t size;      /* Size of the payload or buffer in bytes */
+    nsapi_size_t len;       /* Number of bytes transferred */
+} nsapi_datagram_t;
+
 /** nsapi_stack_api structure
  *
  *  Common api structure for network stack operations. A network stack
@@ -591,6 +639,49 @@ typedef struct nsapi_stack_api
      */
     nsapi_error_t (*getsockopt)(nsapi_stack_t *stack, nsapi_socket_t socket, int level,
             int optname, void *optval, unsigned *optlen);
+
+    /** Send a batch of packets over a UDP socket
+     *
+     *  Sends each datagram to its own address and records the number of
+     *  bytes sent in its len field. Stops at the first datagram that
+     *  cannot be sent.
+     *
+     *  This call is non-blocking. If no datagram can be sent,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  If left null, the batch is sent with repeated calls to socket_sendto.
+     *
+     *  @param stack    Stack handle
+     *  @param socket   Socket handle
+     *  @param dgrams   Array of datagrams to send
+     *  @param count    Number of datagrams in the array
+     *  @return         Number of datagrams sent on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t (*socket_sendto_batch)(nsapi_stack_t *stack, nsapi_socket_t socket,
+            nsapi_datagram_t *dgrams, nsapi_size_t count);
+
+    /** Receive a batch of packets over a UDP socket
+     *
+     *  Receives queued datagrams into the buffers of the array, filling in
+     *  the source address, port and len of each one. Stops when no more
+     *  datagrams are queued on the socket.
+     *
+     *  This call is non-blocking. If no datagram is queued,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  If left null, the batch is received with repeated calls to
+     *  socket_recvfrom.
+     *
+     *  @param stack    Stack handle
+     *  @param socket   Socket handle
+     *  @param dgrams   Array of datagram buffers to receive into
+     *  @param count    Number of datagrams in the array
+     *  @return         Number of datagrams received on success, negative
+     *                  error code on failure
+     */
+    nsapi_size_or_error_t (*socket_recvfrom_batch)(nsapi_stack_t *stack, nsapi_socket_t socket,
+            nsapi_datagram_t *dgrams, nsapi_size_t count);
 } nsapi_stack_api_t;
 
 
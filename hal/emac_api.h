@@ -24,6 +24,25 @@
 
 typedef struct emac_interface emac_interface_t;
 
+/**
+ * Capability flags an Emac interface can advertise through @a get_capabilities
+ *
+ * Checksum flags tell the stack that the hardware generates checksums on
+ * transmit or has already verified them on receive, so the stack can skip
+ * its own software checksum pass.
+ */
+typedef enum emac_capability {
+    EMAC_CAP_TX_CHECKSUM_IP     = 0x0001, /**< Generates IPv4 header checksums */
+    EMAC_CAP_TX_CHECKSUM_UDP    = 0x0002, /**< Generates UDP checksums */
+    EMAC_CAP_TX_CHECKSUM_TCP    = 0x0004, /**< Generates TCP checksums */
+    EMAC_CAP_TX_CHECKSUM_ICMP   = 0x0008, /**< Generates ICMP and ICMPv6 checksums */
+    EMAC_CAP_RX_CHECKSUM_IP     = 0x0100, /**< Verifies IPv4 header checksums, drops bad frames */
+    EMAC_CAP_RX_CHECKSUM_UDP    = 0x0200, /**< Verifies UDP checksums, drops bad frames */
+    EMAC_CAP_RX_CHECKSUM_TCP    = 0x0400, /**< Verifies TCP checksums, drops bad frames */
+    EMAC_CAP_RX_CHECKSUM_ICMP   = 0x0800, /**< Verifies ICMP and ICMPv6 checksums, drops bad frames */
+    EMAC_CAP_RX_POOL            = 0x1000, /**< Receives in place into stack pool buffers posted with @a rx_post */
+} emac_capability_t;
+
 /**
  * EmacInterface
  *
@@ -102,6 +121,47 @@ typedef void (*emac_set_hwaddr_fn)(emac_interface_t *emac, uint8_t *addr);
  */
 typedef bool (*emac_link_out_fn)(emac_interface_t *emac, emac_stack_mem_t *buf);
 
+/**
+ * Sends a packet made of a chain of buffers over the link
+ *
+ * The driver walks the chain with @a emac_stack_mem_chain_next and should
+ * transmit the segments in place (e.g. with scatter-gather DMA), taking
+ * a reference with @a emac_stack_mem_ref on any segment it holds on to
+ * after returning.
+ *
+ * That can not be called from an interrupt context.
+ *
+ * @param emac  Emac interface
+ * @param chain Packet to be send
+ * @return      True if the packet was send successfully, False otherwise
+ */
+typedef bool (*emac_link_out_chain_fn)(emac_interface_t *emac, emac_stack_mem_chain_t *chain);
+
+/**
+ * Return the capabilities of the interface
+ *
+ * @param emac Emac interface
+ * @return     Bitmask of emac_capability_t flags
+ */
+typedef uint32_t (*emac_get_capabilities_fn)(emac_interface_t *emac);
+
+/**
+ * Posts an empty buffer chain from the stack receive pool to the driver
+ *
+ * Used with @a EMAC_CAP_RX_POOL. The stack posts buffers at power up until
+ * the driver refuses one, then one more after each received frame. The
+ * driver receives a frame in place into a posted chain, trims the chain
+ * to the frame with @a emac_stack_mem_chain_set_len and passes it to the
+ * input callback. Buffers still posted are freed by the driver on power
+ * down.
+ *
+ * @param emac  Emac interface
+ * @param chain Buffer chain large enough for a frame of the MTU
+ * @return      True if the driver took the chain, False if it has no room
+ *              for it, the stack keeps the chain then
+ */
+typedef bool (*emac_link_rx_post_fn)(emac_interface_t *emac, emac_stack_mem_chain_t *chain);
+
 /**
  * Initializes the HW
  *
@@ -145,6 +205,10 @@ typedef struct emac_interface_ops {
     emac_power_down_fn          power_down;
     emac_set_link_input_cb_fn   set_link_input_cb;
     emac_set_link_state_cb_fn   set_link_state_cb;
+    /* Optional operations, may be left null */
+    emac_link_out_chain_fn      link_out_chain;
+    emac_get_capabilities_fn    get_capabilities;
+    emac_link_rx_post_fn        rx_post;
 } emac_interface_ops_t;
 
 typedef struct emac_interface {
@@ -18,10 +18,110 @@
 #include "mbed_critical.h"
 #include "sleep_api.h"
 #include "mbed_error.h"
+#include "mbed_stats.h"
+#include "mbed_interface.h"
 #include <limits.h>
+#include <string.h>
+
+// the tracing macros of mbed_sleep.h call these functions
+#undef sleep_manager_lock_deep_sleep
+#undef sleep_manager_unlock_deep_sleep
 
 #if DEVICE_SLEEP
 
+#ifndef MBED_CONF_PLATFORM_SLEEP_LATENCY
+#define MBED_CONF_PLATFORM_SLEEP_LATENCY        0
+#endif
+
+#ifndef MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY
+#define MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY   0
+#endif
+
+#if defined(MBED_SLEEP_STATS_ENABLED) && MBED_SLEEP_STATS_ENABLED
+#if DEVICE_LOWPOWERTIMER
+// the us ticker may stop in deep sleep
+#include "hal/lp_ticker_api.h"
+#define stats_ticker_data() get_lp_ticker_data()
+#else
+#include "hal/us_ticker_api.h"
+#define stats_ticker_data() get_us_ticker_data()
+#endif
+
+static mbed_stats_sleep_t sleep_stats;
+#define SLEEP_STATS_INC(counter) (sleep_stats.counter++)
+#else
+#define SLEEP_STATS_INC(counter)
+#endif
+
+#ifndef MBED_CONF_PLATFORM_SLEEP_STATS_DUMP_INTERVAL
+#define MBED_CONF_PLATFORM_SLEEP_STATS_DUMP_INTERVAL    0
+#endif
+
+#if defined(MBED_SLEEP_STATS_ENABLED) && MBED_SLEEP_STATS_ENABLED && MBED_CONF_PLATFORM_SLEEP_STATS_DUMP_INTERVAL
+static us_timestamp_t last_dump_time;
+static bool dump_pending;
+#endif
+
+#if defined(MBED_SLEEP_TRACING_ENABLED) && MBED_SLEEP_TRACING_ENABLED
+
+#ifndef MBED_SLEEP_TRACING_MAX_OWNERS
+#define MBED_SLEEP_TRACING_MAX_OWNERS   16
+#endif
+
+typedef struct {
+    const char *owner;          // base name of the first call site
+    uint16_t count;
+    uint32_t lock_cnt;
+    us_timestamp_t lock_time;
+    uint64_t held_time;
+} sleep_lock_owner_t;
+
+static sleep_lock_owner_t lock_owners[MBED_SLEEP_TRACING_MAX_OWNERS];
+// locks of owners that did not fit in lock_owners
+static uint32_t untraced_lock_cnt;
+
+static const char *owner_name(const char *file)
+{
+    const char *name = file;
+    for (; *file != '\0'; file++) {
+        if (*file == '/' || *file == '\\') {
+            name = file + 1;
+        }
+    }
+    return name;
+}
+
+// Ticker.h and Ticker.cpp are the same owner
+static bool owner_match(const char *a, const char *b)
+{
+    while (*a == *b && *a != '\0' && *a != '.') {
+        a++;
+        b++;
+    }
+    return (*a == '\0' || *a == '.') && (*b == '\0' || *b == '.');
+}
+
+// Must be called in a critical section.
+static sleep_lock_owner_t *owner_find(const char *owner, bool add)
+{
+    for (int i = 0; i < MBED_SLEEP_TRACING_MAX_OWNERS; i++) {
+        sleep_lock_owner_t *entry = &lock_owners[i];
+        if (entry->owner == NULL) {
+            if (!add) {
+                return NULL;
+            }
+            entry->owner = owner;
+            return entry;
+        }
+        if (entry->owner == owner || owner_match(entry->owner, owner)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+#endif
+
 // deep sleep locking counter. A target is allowed to deep sleep if counter == 0
 static uint16_t deep_sleep_lock = 0U;
 
@@ -52,20 +152,247 @@ bool sleep_manager_can_deep_sleep(void)
     return deep_sleep_lock == 0 ? true : false;
 }
 
+#if defined(MBED_SLEEP_TRACING_ENABLED) && MBED_SLEEP_TRACING_ENABLED
+void sleep_manager_lock_deep_sleep_traced(const char *owner)
+{
+    core_util_critical_section_enter();
+    sleep_manager_lock_deep_sleep();
+    sleep_lock_owner_t *entry = owner_find(owner_name(owner), true);
+    if (entry != NULL) {
+        if (entry->count == 0) {
+            entry->lock_time = ticker_read_us(stats_ticker_data());
+        }
+        entry->count++;
+        entry->lock_cnt++;
+    } else {
+        untraced_lock_cnt++;
+    }
+    core_util_critical_section_exit();
+}
+
+void sleep_manager_unlock_deep_sleep_traced(const char *owner)
+{
+    core_util_critical_section_enter();
+    sleep_manager_unlock_deep_sleep();
+    sleep_lock_owner_t *entry = owner_find(owner_name(owner), false);
+    // unlocks without a traced lock are not accounted
+    if (entry != NULL && entry->count > 0) {
+        entry->count--;
+        if (entry->count == 0) {
+            entry->held_time += ticker_read_us(stats_ticker_data()) - entry->lock_time;
+        }
+    }
+    core_util_critical_section_exit();
+}
+#endif
+
+// Enter the sleep mode and account the time spent in it.
+// Must be called in a critical section.
+static void sleep_manager_enter(bool deep, uint32_t idle_time_us)
+{
+#if defined(MBED_SLEEP_STATS_ENABLED) && MBED_SLEEP_STATS_ENABLED
+    const ticker_data_t *ticker = stats_ticker_data();
+    us_timestamp_t start = ticker_read_us(ticker);
+#endif
+
+    if (deep) {
+        hal_deepsleep();
+    } else {
+        hal_sleep();
+    }
+
+#if defined(MBED_SLEEP_STATS_ENABLED) && MBED_SLEEP_STATS_ENABLED
+    us_timestamp_t slept = ticker_read_us(ticker) - start;
+    if (deep) {
+        sleep_stats.deep_sleep_cnt++;
+        sleep_stats.deep_sleep_time += slept;
+    } else {
+        sleep_stats.sleep_cnt++;
+        sleep_stats.sleep_time += slept;
+    }
+    if (slept > idle_time_us) {
+        us_timestamp_t late = slept - idle_time_us;
+        sleep_stats.late_cnt++;
+        if (late > sleep_stats.max_late_time) {
+            sleep_stats.max_late_time = late > UINT32_MAX ? UINT32_MAX : late;
+        }
+    }
+#else
+    (void)idle_time_us;
+#endif
+}
+
+#if defined(MBED_SLEEP_STATS_ENABLED) && MBED_SLEEP_STATS_ENABLED && MBED_CONF_PLATFORM_SLEEP_STATS_DUMP_INTERVAL
+// Raise the dump once per interval after waking up. It is printed at once out
+// of critical sections, otherwise by the idle loop once it has left them.
+static void sleep_stats_dump_periodic(void)
+{
+    core_util_critical_section_enter();
+    us_timestamp_t now = ticker_read_us(stats_ticker_data());
+    if (now - last_dump_time >= MBED_CONF_PLATFORM_SLEEP_STATS_DUMP_INTERVAL * 1000000ULL) {
+        last_dump_time = now;
+        dump_pending = true;
+    }
+    core_util_critical_section_exit();
+
+    if (!core_util_in_critical_section()) {
+        mbed_stats_sleep_dump_pending();
+    }
+}
+#define SLEEP_STATS_DUMP_PERIODIC() sleep_stats_dump_periodic()
+#else
+#define SLEEP_STATS_DUMP_PERIODIC()
+#endif
+
 void sleep_manager_sleep_auto(void)
 {
     core_util_critical_section_enter();
 // debug profile should keep debuggers attached, no deep sleep allowed
 #ifdef MBED_DEBUG
-    hal_sleep();
+    sleep_manager_enter(false, UINT32_MAX);
 #else
-    if (sleep_manager_can_deep_sleep()) {
-        hal_deepsleep();
-    } else {
-        hal_sleep();
+    sleep_manager_enter(sleep_manager_can_deep_sleep(), UINT32_MAX);
+#endif
+    core_util_critical_section_exit();
+    SLEEP_STATS_DUMP_PERIODIC();
+}
+
+void sleep_manager_sleep_auto_for(uint32_t idle_time_us)
+{
+    core_util_critical_section_enter();
+#if MBED_CONF_PLATFORM_SLEEP_LATENCY > 0
+    if (idle_time_us < MBED_CONF_PLATFORM_SLEEP_LATENCY) {
+        // the wake up would be late, stay awake
+        SLEEP_STATS_INC(awake_cnt);
+        core_util_critical_section_exit();
+        return;
+    }
+#endif
+// debug profile should keep debuggers attached, no deep sleep allowed
+#ifdef MBED_DEBUG
+    sleep_manager_enter(false, idle_time_us);
+#else
+    bool deep = sleep_manager_can_deep_sleep();
+#if MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY > 0
+    if (deep && idle_time_us < MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY) {
+        SLEEP_STATS_INC(demoted_cnt);
+        deep = false;
     }
+#endif
+    sleep_manager_enter(deep, idle_time_us);
 #endif
     core_util_critical_section_exit();
+    SLEEP_STATS_DUMP_PERIODIC();
+}
+
+uint32_t sleep_manager_wake_up_latency(uint32_t idle_time_us)
+{
+#ifdef MBED_DEBUG
+    return 0;
+#else
+    const uint32_t latency = MBED_CONF_PLATFORM_DEEP_SLEEP_LATENCY;
+    if (latency == 0 || !sleep_manager_can_deep_sleep()) {
+        return 0;
+    }
+    // after waking up early, the rest must still cover the deep sleep
+    if (idle_time_us < latency || idle_time_us - latency < latency) {
+        return 0;
+    }
+    return latency;
+#endif
+}
+
+void mbed_stats_sleep_get(mbed_stats_sleep_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_sleep_t));
+
+#if defined(MBED_SLEEP_STATS_ENABLED) && MBED_SLEEP_STATS_ENABLED
+    core_util_critical_section_enter();
+    memcpy(stats, &sleep_stats, sizeof(mbed_stats_sleep_t));
+    stats->run_time = ticker_read_us(stats_ticker_data()) - stats->sleep_time - stats->deep_sleep_time;
+    core_util_critical_section_exit();
+#endif
+}
+
+size_t mbed_stats_sleep_lock_get_each(mbed_stats_sleep_lock_t *stats, size_t count)
+{
+    memset(stats, 0, count * sizeof(mbed_stats_sleep_lock_t));
+    size_t i = 0;
+
+#if defined(MBED_SLEEP_TRACING_ENABLED) && MBED_SLEEP_TRACING_ENABLED
+    core_util_critical_section_enter();
+    us_timestamp_t now = ticker_read_us(stats_ticker_data());
+    for (i = 0; i < count && i < MBED_SLEEP_TRACING_MAX_OWNERS && lock_owners[i].owner != NULL; i++) {
+        const sleep_lock_owner_t *entry = &lock_owners[i];
+        stats[i].owner = entry->owner;
+        stats[i].count = entry->count;
+        stats[i].lock_cnt = entry->lock_cnt;
+        stats[i].held_time = entry->held_time;
+        if (entry->count > 0) {
+            stats[i].held_time += now - entry->lock_time;
+        }
+    }
+    core_util_critical_section_exit();
+#endif
+
+    return i;
+}
+
+void mbed_stats_sleep_dump(void)
+{
+#if defined(MBED_SLEEP_STATS_ENABLED) && MBED_SLEEP_STATS_ENABLED
+    mbed_stats_sleep_t stats;
+
+    // copied in critical sections and printed out of them, printing is too slow
+    // to hold off the interrupts
+    mbed_stats_sleep_get(&stats);
+    mbed_error_printf("sleep stats: run %lu ms, sleep %lu ms (%lu), deep sleep %lu ms (%lu)\n",
+                      (unsigned long)(stats.run_time / 1000),
+                      (unsigned long)(stats.sleep_time / 1000), (unsigned long)stats.sleep_cnt,
+                      (unsigned long)(stats.deep_sleep_time / 1000), (unsigned long)stats.deep_sleep_cnt);
+    mbed_error_printf("sleep stats: awake %lu, demoted %lu, late %lu (max %lu us)\n",
+                      (unsigned long)stats.awake_cnt, (unsigned long)stats.demoted_cnt,
+                      (unsigned long)stats.late_cnt, (unsigned long)stats.max_late_time);
+
+#if defined(MBED_SLEEP_TRACING_ENABLED) && MBED_SLEEP_TRACING_ENABLED
+    for (int i = 0; i < MBED_SLEEP_TRACING_MAX_OWNERS; i++) {
+        core_util_critical_section_enter();
+        sleep_lock_owner_t entry = lock_owners[i];
+        us_timestamp_t now = ticker_read_us(stats_ticker_data());
+        core_util_critical_section_exit();
+
+        if (entry.owner == NULL) {
+            break;
+        }
+        uint64_t held_time = entry.held_time;
+        if (entry.count > 0) {
+            held_time += now - entry.lock_time;
+        }
+        mbed_error_printf("deep sleep lock: %s %s, held %lu ms, locked %lu times\n",
+                          entry.owner, entry.count > 0 ? "locked" : "unlocked",
+                          (unsigned long)(held_time / 1000), (unsigned long)entry.lock_cnt);
+    }
+    uint32_t untraced = untraced_lock_cnt;
+    if (untraced > 0) {
+        mbed_error_printf("deep sleep lock: %lu locks not traced, increase MBED_SLEEP_TRACING_MAX_OWNERS\n",
+                          (unsigned long)untraced);
+    }
+#endif
+#endif
+}
+
+void mbed_stats_sleep_dump_pending(void)
+{
+#if defined(MBED_SLEEP_STATS_ENABLED) && MBED_SLEEP_STATS_ENABLED && MBED_CONF_PLATFORM_SLEEP_STATS_DUMP_INTERVAL
+    core_util_critical_section_enter();
+    bool pending = dump_pending;
+    dump_pending = false;
+    core_util_critical_section_exit();
+
+    if (pending) {
+        mbed_stats_sleep_dump();
+    }
+#endif
 }
 
 #else
@@ -89,4 +416,42 @@ bool sleep_manager_can_deep_sleep(void)
     return false;
 }
 
+void sleep_manager_sleep_auto_for(uint32_t idle_time_us)
+{
+
+}
+
+uint32_t sleep_manager_wake_up_latency(uint32_t idle_time_us)
+{
+    return 0;
+}
+
+void mbed_stats_sleep_get(mbed_stats_sleep_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_sleep_t));
+}
+
+size_t mbed_stats_sleep_lock_get_each(mbed_stats_sleep_lock_t *stats, size_t count)
+{
+    memset(stats, 0, count * sizeof(mbed_stats_sleep_lock_t));
+    return 0;
+}
+
+void mbed_stats_sleep_dump(void)
+{
+
+}
+
+#if defined(MBED_SLEEP_TRACING_ENABLED) && MBED_SLEEP_TRACING_ENABLED
+void sleep_manager_lock_deep_sleep_traced(const char *owner)
+{
+
+}
+
+void sleep_manager_unlock_deep_sleep_traced(const char *owner)
+{
+
+}
+#endif
+
 #endif
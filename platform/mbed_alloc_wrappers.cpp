@@ -65,11 +65,176 @@ void mbed_stats_heap_get(mbed_stats_heap_t *stats)
 #endif
 }
 
+/******************************************************************************/
+/* Host C library memory allocation wrappers (native POSIX target)            */
+/******************************************************************************/
+
+#if defined(TARGET_POSIX)
+
+/* The GCC_NATIVE profiles link with --wrap for malloc, realloc, calloc and
+ * free. This replaces the calls of the program but not the ones made inside
+ * the host libraries, and a block allocated there (by strdup() for instance)
+ * may still be freed by the program. So the blocks of the wrappers are marked
+ * in their header, and the other blocks are passed to the host allocator as
+ * they are.
+ */
+
+#ifdef MBED_HEAP_STATS_ENABLED
+/* Size must keep the 16 byte alignment of the host allocator. The marker is
+ * right before the block, where the host allocator keeps the size of its
+ * chunks, which never takes this value. */
+typedef struct {
+    uint32_t size;
+    uint32_t pad[2];
+    uint32_t marker;
+} host_alloc_info_t;
+
+#define HOST_ALLOC_MARKER   0xA110C8EDu
+
+// Header of a block of the wrappers, NULL for a block of the host libraries
+static host_alloc_info_t *host_alloc_info(void *ptr)
+{
+    host_alloc_info_t *alloc_info = ((host_alloc_info_t*)ptr) - 1;
+    return alloc_info->marker == HOST_ALLOC_MARKER ? alloc_info : NULL;
+}
+#endif // #ifdef MBED_HEAP_STATS_ENABLED
+
+extern "C" {
+    void *__real_malloc(size_t size);
+    void *__real_realloc(void *ptr, size_t size);
+    void *__real_calloc(size_t nmemb, size_t size);
+    void __real_free(void *ptr);
+    void *malloc_wrapper(size_t size, void *caller);
+    void free_wrapper(void *ptr, void *caller);
+}
+
+extern "C" void *__wrap_malloc(size_t size) {
+    return malloc_wrapper(size, MBED_CALLER_ADDR());
+}
+
+extern "C" void *malloc_wrapper(size_t size, void *caller) {
+    void *ptr = NULL;
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_lock();
+#endif
+#ifdef MBED_HEAP_STATS_ENABLED
+    malloc_stats_mutex->lock();
+    host_alloc_info_t *alloc_info = (host_alloc_info_t*)__real_malloc(size + sizeof(host_alloc_info_t));
+    if (alloc_info != NULL) {
+        alloc_info->size = size;
+        alloc_info->marker = HOST_ALLOC_MARKER;
+        ptr = (void*)(alloc_info + 1);
+        heap_stats.current_size += size;
+        heap_stats.total_size += size;
+        heap_stats.alloc_cnt += 1;
+        if (heap_stats.current_size > heap_stats.max_size) {
+            heap_stats.max_size = heap_stats.current_size;
+        }
+    } else {
+        heap_stats.alloc_fail_cnt += 1;
+    }
+    malloc_stats_mutex->unlock();
+#else // #ifdef MBED_HEAP_STATS_ENABLED
+    ptr = __real_malloc(size);
+#endif // #ifdef MBED_HEAP_STATS_ENABLED
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_malloc(ptr, size, caller);
+    mbed_mem_trace_unlock();
+#endif // #ifdef MBED_MEM_TRACING_ENABLED
+    return ptr;
+}
+
+extern "C" void *__wrap_realloc(void *ptr, size_t size) {
+    void *new_ptr = NULL;
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_lock();
+#endif
+#ifdef MBED_HEAP_STATS_ENABLED
+    // Implemented with malloc and free like __wrap__realloc_r, the calls
+    // below go to the wrappers. A block of the host libraries stays one.
+    host_alloc_info_t *alloc_info = ptr != NULL ? host_alloc_info(ptr) : NULL;
+    if (ptr != NULL && alloc_info == NULL) {
+        new_ptr = __real_realloc(ptr, size);
+    } else {
+        uint32_t old_size = alloc_info != NULL ? alloc_info->size : 0;
+
+        if (size != 0) {
+            new_ptr = malloc(size);
+        }
+
+        if (new_ptr != NULL) {
+            uint32_t copy_size = (old_size < size) ? old_size : size;
+            memcpy(new_ptr, ptr, copy_size);
+            free(ptr);
+        }
+    }
+#else // #ifdef MBED_HEAP_STATS_ENABLED
+    new_ptr = __real_realloc(ptr, size);
+#endif // #ifdef MBED_HEAP_STATS_ENABLED
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_realloc(new_ptr, ptr, size, MBED_CALLER_ADDR());
+    mbed_mem_trace_unlock();
+#endif // #ifdef MBED_MEM_TRACING_ENABLED
+    return new_ptr;
+}
+
+extern "C" void *__wrap_calloc(size_t nmemb, size_t size) {
+    void *ptr = NULL;
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_lock();
+#endif
+#ifdef MBED_HEAP_STATS_ENABLED
+    ptr = malloc(nmemb * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, nmemb * size);
+    }
+#else // #ifdef MBED_HEAP_STATS_ENABLED
+    ptr = __real_calloc(nmemb, size);
+#endif // #ifdef MBED_HEAP_STATS_ENABLED
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_calloc(ptr, nmemb, size, MBED_CALLER_ADDR());
+    mbed_mem_trace_unlock();
+#endif // #ifdef MBED_MEM_TRACING_ENABLED
+    return ptr;
+}
+
+extern "C" void __wrap_free(void *ptr) {
+    free_wrapper(ptr, MBED_CALLER_ADDR());
+}
+
+extern "C" void free_wrapper(void *ptr, void *caller) {
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_lock();
+#endif
+#ifdef MBED_HEAP_STATS_ENABLED
+    malloc_stats_mutex->lock();
+    void *block = ptr;
+    if (ptr != NULL) {
+        host_alloc_info_t *alloc_info = host_alloc_info(ptr);
+        if (alloc_info != NULL) {
+            heap_stats.current_size -= alloc_info->size;
+            heap_stats.alloc_cnt -= 1;
+            // The host allocator may hand out the memory for its own blocks
+            alloc_info->marker = 0;
+            block = (void*)alloc_info;
+        }
+    }
+    __real_free(block);
+    malloc_stats_mutex->unlock();
+#else // #ifdef MBED_HEAP_STATS_ENABLED
+    __real_free(ptr);
+#endif // #ifdef MBED_HEAP_STATS_ENABLED
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_free(ptr, caller);
+    mbed_mem_trace_unlock();
+#endif // #ifdef MBED_MEM_TRACING_ENABLED
+}
+
 /******************************************************************************/
 /* GCC memory allocation wrappers                                             */
 /******************************************************************************/
 
-#if defined(TOOLCHAIN_GCC)
+#elif defined(TOOLCHAIN_GCC)
 
 #ifdef   FEATURE_UVISOR
 #include "uvisor-lib/uvisor-lib.h"
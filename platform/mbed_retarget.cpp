@@ -38,6 +38,7 @@
 #define SSIZE_MAX INT_MAX
 #endif
 #include <stdio.h>
+#include <stdarg.h>
 #include <errno.h>
 #include "platform/mbed_retarget.h"
 
@@ -65,6 +66,14 @@ static SingletonPtr<PlatformMutex> _mutex;
 #   define STDOUT_FILENO    1
 #   define STDERR_FILENO    2
 
+#elif defined(TARGET_POSIX)
+#   define PREFIX(x)    x
+#   ifndef OPEN_MAX
+#       define OPEN_MAX 16
+#   endif
+/* Descriptors of mbed FileHandles, above the ones of the host */
+#   define POSIX_FILEHANDLE_BASE    0x40000000
+
 #else
 #   include <sys/syslimits.h>
 #   define PREFIX(x)    x
@@ -113,6 +122,13 @@ void remove_filehandle(FileHandle *file) {
 }
 }
 
+/* The native POSIX target uses the host C library and its file descriptors,
+ * stdio goes to the host stdin/stdout/stderr and mbed FileHandles are used
+ * through mbed::fdopen(). The retargeting of the C library is left out, only
+ * the paths under mbed mount points are routed to the mbed FileSystems.
+ */
+#if !defined(TARGET_POSIX)
+
 #if DEVICE_SERIAL
 extern int stdio_uart_inited;
 extern serial_t stdio_uart;
@@ -299,6 +315,8 @@ static inline int openflags_to_posix(int openflags) {
     return posix;
 }
 
+#endif // !defined(TARGET_POSIX)
+
 static int reserve_filehandle() {
     // find the first empty slot in filehandles, after the slots reserved for stdin/stdout/stderr
     filehandle_mutex->lock();
@@ -329,9 +347,15 @@ int mbed::bind_to_fd(FileHandle *fh) {
     stdio_in_prev[fh_i] = 0;
     stdio_out_prev[fh_i] = 0;
 
+#if defined(TARGET_POSIX)
+    return POSIX_FILEHANDLE_BASE + fh_i;
+#else
     return fh_i;
+#endif
 }
 
+#if !defined(TARGET_POSIX)
+
 static int unbind_from_fd(int fd, FileHandle *fh) {
     if (filehandles[fd] == fh) {
         filehandles[fd] = NULL;
@@ -381,6 +405,240 @@ std::FILE *fdopen(FileHandle *fh, const char *mode)
 }
 }
 
+#else // !defined(TARGET_POSIX)
+
+/* The host C library calls the FileHandle through the stream cookie,
+ * errors are negative error codes from the FileHandle and errno for the C library.
+ */
+static ssize_t cookie_read(void *cookie, char *buffer, size_t size) {
+    ssize_t ret = static_cast<FileHandle *>(cookie)->read(buffer, size);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+    return ret;
+}
+
+static ssize_t cookie_write(void *cookie, const char *buffer, size_t size) {
+    ssize_t ret = static_cast<FileHandle *>(cookie)->write(buffer, size);
+    if (ret < 0) {
+        errno = -ret;
+        return 0;
+    }
+    return ret;
+}
+
+static int cookie_seek(void *cookie, off64_t *offset, int whence) {
+    off_t ret = static_cast<FileHandle *>(cookie)->seek(*offset, whence);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+    *offset = ret;
+    return 0;
+}
+
+static int cookie_close(void *cookie) {
+    int ret = static_cast<FileHandle *>(cookie)->close();
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+    return 0;
+}
+
+namespace mbed {
+std::FILE *fdopen(FileHandle *fh, const char *mode)
+{
+    cookie_io_functions_t io = { cookie_read, cookie_write, cookie_seek, cookie_close };
+    std::FILE *stream = fopencookie(fh, mode, io);
+    if (stream && fh->isatty()) {
+        mbed_set_unbuffered_stream(stream);
+    }
+    return stream;
+}
+}
+
+/* fopen() and the POSIX file functions are linked with --wrap by the
+ * GCC_NATIVE profiles. Paths under the mount points of mbed FileSystems and
+ * the descriptors of mbed FileHandles are handled here, everything else goes
+ * to the host C library.
+ */
+extern "C" {
+std::FILE *__real_fopen(const char *name, const char *mode);
+int __real_open(const char *name, int oflag, ...);
+int __real_close(int fd);
+ssize_t __real_read(int fd, void *buffer, size_t length);
+ssize_t __real_write(int fd, const void *buffer, size_t length);
+off_t __real_lseek(int fd, off_t offset, int whence);
+int __real_isatty(int fd);
+int __real_fsync(int fd);
+}
+
+/* Opens a path under an mbed mount point.
+ * Returns 1 on success, 0 if the path is not under one, or -1 with errno set.
+ */
+static int posix_open_mounted(const char *name, int oflag, FileHandle **res) {
+    if (name[0] != '/' || name[strspn(name, "/")] == 0) {
+        return 0;
+    }
+    FilePath path(name);
+    if (!path.exists()) {
+        return 0;
+    }
+
+    if (path.isFile()) {
+        *res = path.file();
+        return 1;
+    }
+    FileSystemHandle *fs = path.fileSystem();
+    if (fs == NULL) {
+        errno = ENODEV;
+        return -1;
+    }
+    int err = fs->open(res, path.fileName(), oflag);
+    if (err) {
+        errno = -err;
+        return -1;
+    }
+    return 1;
+}
+
+static FileHandle *posix_get_fhc(int fd) {
+    if (fd < POSIX_FILEHANDLE_BASE || fd - POSIX_FILEHANDLE_BASE >= OPEN_MAX) {
+        return NULL;
+    }
+    FileHandle *fh = filehandles[fd - POSIX_FILEHANDLE_BASE];
+    return fh == FILE_HANDLE_RESERVED ? NULL : fh;
+}
+
+static int posix_mode_to_oflag(const char *mode) {
+    int oflag;
+    switch (mode[0]) {
+        case 'w': oflag = O_WRONLY | O_CREAT | O_TRUNC; break;
+        case 'a': oflag = O_WRONLY | O_CREAT | O_APPEND; break;
+        default: oflag = O_RDONLY; break;
+    }
+    if (strchr(mode, '+')) {
+        oflag = (oflag & ~O_WRONLY) | O_RDWR;
+    }
+    return oflag;
+}
+
+extern "C" std::FILE *__wrap_fopen(const char *name, const char *mode) {
+    FileHandle *fh;
+    int ret = posix_open_mounted(name, posix_mode_to_oflag(mode), &fh);
+    if (ret == 0) {
+        return __real_fopen(name, mode);
+    } else if (ret < 0) {
+        return NULL;
+    }
+
+    std::FILE *stream = mbed::fdopen(fh, mode);
+    if (stream == NULL) {
+        fh->close();
+    }
+    return stream;
+}
+
+extern "C" int __wrap_open(const char *name, int oflag, ...) {
+    FileHandle *fh;
+    int ret = posix_open_mounted(name, oflag, &fh);
+    if (ret == 0) {
+        va_list ap;
+        va_start(ap, oflag);
+        mode_t mode = (oflag & O_CREAT) ? va_arg(ap, mode_t) : 0;
+        va_end(ap);
+        return __real_open(name, oflag, mode);
+    } else if (ret < 0) {
+        return -1;
+    }
+
+    int fd = bind_to_fd(fh);
+    if (fd < 0) {
+        fh->close();
+    }
+    return fd;
+}
+
+extern "C" int __wrap_close(int fd) {
+    FileHandle *fh = posix_get_fhc(fd);
+    if (fh == NULL) {
+        return __real_close(fd);
+    }
+    filehandles[fd - POSIX_FILEHANDLE_BASE] = NULL;
+    int err = fh->close();
+    if (err < 0) {
+        errno = -err;
+        return -1;
+    }
+    return 0;
+}
+
+extern "C" ssize_t __wrap_read(int fd, void *buffer, size_t length) {
+    FileHandle *fh = posix_get_fhc(fd);
+    if (fh == NULL) {
+        return __real_read(fd, buffer, length);
+    }
+    ssize_t ret = fh->read(buffer, length);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+    return ret;
+}
+
+extern "C" ssize_t __wrap_write(int fd, const void *buffer, size_t length) {
+    FileHandle *fh = posix_get_fhc(fd);
+    if (fh == NULL) {
+        return __real_write(fd, buffer, length);
+    }
+    ssize_t ret = fh->write(buffer, length);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+    return ret;
+}
+
+extern "C" off_t __wrap_lseek(int fd, off_t offset, int whence) {
+    FileHandle *fh = posix_get_fhc(fd);
+    if (fh == NULL) {
+        return __real_lseek(fd, offset, whence);
+    }
+    off_t ret = fh->seek(offset, whence);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+    return ret;
+}
+
+extern "C" int __wrap_isatty(int fd) {
+    FileHandle *fh = posix_get_fhc(fd);
+    if (fh == NULL) {
+        return __real_isatty(fd);
+    }
+    return fh->isatty();
+}
+
+extern "C" int __wrap_fsync(int fd) {
+    FileHandle *fh = posix_get_fhc(fd);
+    if (fh == NULL) {
+        return __real_fsync(fd);
+    }
+    int err = fh->sync();
+    if (err < 0) {
+        errno = -err;
+        return -1;
+    }
+    return 0;
+}
+
+#endif // !defined(TARGET_POSIX)
+
+#if !defined(TARGET_POSIX)
+
 /* @brief 	standard c library fopen() retargeting function.
  *
  * This function is invoked by the standard c library retargeting to handle fopen()
@@ -1024,6 +1282,8 @@ extern "C" int statvfs(const char *path, struct statvfs *buf) {
     }
 }
 
+#endif // !defined(TARGET_POSIX)
+
 #if defined(TOOLCHAIN_GCC)
 /* prevents the exception handling name demangling code getting pulled in */
 #include "mbed_error.h"
@@ -1093,6 +1353,7 @@ extern "C" WEAK caddr_t _sbrk(int incr) {
 #endif
 #endif
 
+#if !defined(TARGET_POSIX)
 #if defined(TOOLCHAIN_GCC_ARM) || defined(TOOLCHAIN_GCC_CR)
 extern "C" void _exit(int return_code) {
 #else
@@ -1122,8 +1383,9 @@ extern "C" void exit(int return_code) {
 #if !defined(TOOLCHAIN_GCC_ARM) && !defined(TOOLCHAIN_GCC_CR)
 } //namespace std
 #endif
+#endif // !defined(TARGET_POSIX)
 
-#if defined(TOOLCHAIN_ARM) || defined(TOOLCHAIN_GCC)
+#if (defined(TOOLCHAIN_ARM) || defined(TOOLCHAIN_GCC)) && !defined(TARGET_POSIX)
 
 // This series of function disable the registration of global destructors
 // in a dynamic table which will be called when the application exit.
@@ -1147,7 +1409,8 @@ void __cxa_finalize(void *handle) {
 #endif
 
 
-#if defined(TOOLCHAIN_GCC)
+// The host C library of the native POSIX target runs the atexit handlers
+#if defined(TOOLCHAIN_GCC) && !defined(TARGET_POSIX)
 
 /*
  * Depending on how newlib is  configured, it is often not enough to define
@@ -1274,7 +1537,7 @@ extern "C" void __env_unlock( struct _reent *_r )
 
 #endif
 
-#if defined (__GNUC__) || defined(__CC_ARM) || (defined (__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050))
+#if (defined (__GNUC__) || defined(__CC_ARM) || (defined (__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050))) && !defined(TARGET_POSIX)
 
 #define CXA_GUARD_INIT_DONE             (1 << 0)
 #define CXA_GUARD_INIT_IN_PROGRESS      (1 << 1)
@@ -1360,7 +1623,7 @@ void operator delete[](void *ptr)
     free_wrapper(ptr, MBED_CALLER_ADDR());
 }
 
-#elif defined(MBED_MEM_TRACING_ENABLED) && defined(__GNUC__)
+#elif defined(MBED_MEM_TRACING_ENABLED) && defined(__GNUC__) && !defined(TARGET_POSIX)
 
 #include <reent.h>
 
@@ -27,6 +27,28 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#if defined(TARGET_POSIX)
+/* The native POSIX target runs on the host C library, which provides
+ * the types, structures and functions declared below for the other targets.
+ * unistd.h is left out, its sleep() conflicts with the sleep() of mbed_sleep.h,
+ * and poll.h too, the POLL* events of FileHandle are the ones of mbed_poll.h */
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <fcntl.h>
+#include <dirent.h>
+
+#define O_BINARY 0      ///< Open file in binary mode
+#ifndef NAME_MAX
+#define NAME_MAX 255    ///< Maximum size of a name in a file path
+#endif
+
+#ifndef STDIN_FILENO
+#define STDIN_FILENO  0
+#define STDOUT_FILENO 1
+#define STDERR_FILENO 2
+#endif
+#else
 /* We can get the following standard types from sys/types for gcc, but we
  * need to define the types ourselves for the other compilers that normally
  * target embedded systems */
@@ -57,6 +79,7 @@ typedef unsigned int  gid_t;    ///< Group ID
 #define STDIN_FILENO  0
 #define STDOUT_FILENO 1
 #define STDERR_FILENO 2
+#endif
 
 #include <time.h>
 
@@ -115,11 +138,15 @@ FileHandle* mbed_target_override_console(int fd);
 FileHandle* mbed_override_console(int fd);
 
 }
+#endif
 
+#if !defined(TARGET_POSIX)
+#if __cplusplus
 typedef mbed::DirHandle DIR;
 #else
 typedef struct Dir DIR;
 #endif
+#endif
 
 /* The intent of this section is to unify the errno error values to match
  * the POSIX definitions for the GCC_ARM, ARMCC and IAR compilers. This is
@@ -392,6 +419,7 @@ typedef struct Dir DIR;
 #undef  ENOTRECOVERABLE
 #define ENOTRECOVERABLE 131     /* State not recoverable */
 
+#if !defined(TARGET_POSIX)
 /* Missing stat.h defines.
  * The following are sys/stat.h definitions not currently present in the ARMCC
  * errno.h. Note, ARMCC errno.h defines some symbol values differing from
@@ -517,6 +545,10 @@ extern "C" {
     int mkdir(const char *name, mode_t n);
 #if __cplusplus
 }; // extern "C"
+#endif
+#endif // !defined(TARGET_POSIX)
+
+#if __cplusplus
 
 namespace mbed {
 
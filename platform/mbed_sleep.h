@@ -27,6 +27,7 @@
 #include "sleep_api.h"
 #include "mbed_toolchain.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -88,6 +89,37 @@ void sleep_manager_lock_deep_sleep(void);
  */
 void sleep_manager_unlock_deep_sleep(void);
 
+#if defined(MBED_SLEEP_TRACING_ENABLED) && MBED_SLEEP_TRACING_ENABLED
+
+// tracing records the time of the locks, which needs the sleep statistics
+#ifndef MBED_SLEEP_STATS_ENABLED
+#define MBED_SLEEP_STATS_ENABLED 1
+#endif
+
+/** Lock the deep sleep mode and record the owner of the lock
+ *
+ * With MBED_SLEEP_TRACING_ENABLED, sleep_manager_lock_deep_sleep() calls
+ * this function with the file name of the call site, so the drivers holding
+ * deep sleep off are listed by mbed_stats_sleep_lock_get_each().
+ *
+ * Call sites in files with the same base name, like Ticker.h and Ticker.cpp,
+ * are the same owner.
+ *
+ * @param owner File name of the call site
+ */
+void sleep_manager_lock_deep_sleep_traced(const char *owner);
+
+/** Unlock the deep sleep mode and record the owner of the lock
+ *
+ * @param owner File name of the call site
+ */
+void sleep_manager_unlock_deep_sleep_traced(const char *owner);
+
+#define sleep_manager_lock_deep_sleep()     sleep_manager_lock_deep_sleep_traced(__FILE__)
+#define sleep_manager_unlock_deep_sleep()   sleep_manager_unlock_deep_sleep_traced(__FILE__)
+
+#endif
+
 /** Get the status of deep sleep allowance for a target
  *
  * @return true if a target can go to deepsleep, false otherwise
@@ -106,6 +138,38 @@ bool sleep_manager_can_deep_sleep(void);
  */
 void sleep_manager_sleep_auto(void);
 
+/** Enter the sleep mode that pays off for the expected idle time
+ *
+ * The idle governor stays awake if the idle time is shorter than the sleep
+ * latency (platform.sleep-latency), uses deep sleep only if it is allowed by
+ * the deepsleep locking counter and the idle time covers the deep sleep
+ * latency (platform.deep-sleep-latency), and sleeps otherwise.
+ *
+ * The latencies are target specific and are set with target_overrides,
+ * MBED_SLEEP_STATS_ENABLED reports late wake ups to measure them.
+ *
+ * This function is IRQ and thread safe
+ *
+ * @param idle_time_us Time in microseconds until the next wake up event
+ *
+ * @note
+ * If MBED_DEBUG is defined, only hal_sleep is allowed. This ensures the debugger
+ * to be active for debug modes.
+ */
+void sleep_manager_sleep_auto_for(uint32_t idle_time_us);
+
+/** Get how early to wake up before a deadline
+ *
+ * The wake up from deep sleep takes the deep sleep latency, so the wake up
+ * event should be scheduled this much before the deadline. Deep sleep is
+ * selected only if the time left after waking up early still covers
+ * the latency.
+ *
+ * @param idle_time_us Time in microseconds until the deadline
+ * @return Deep sleep latency if sleep_manager_sleep_auto_for() would use deep sleep, 0 otherwise
+ */
+uint32_t sleep_manager_wake_up_latency(uint32_t idle_time_us);
+
 /** Send the microcontroller to sleep
  *
  * @note This function can be a noop if not implemented by the platform.
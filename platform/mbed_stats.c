@@ -8,6 +8,9 @@
 #endif
 
 // note: mbed_stats_heap_get defined in mbed_alloc_wrappers.cpp
+// note: mbed_stats_cpu_get and mbed_stats_thread_get_each defined in rtos/TARGET_CORTEX/mbed_rtx_stats.c
+//       (rtos/TARGET_POSIX/mbed_posix_stats.c on the native POSIX target)
+// note: mbed_stats_sleep_get, mbed_stats_sleep_lock_get_each and mbed_stats_sleep_dump defined in hal/mbed_sleep_manager.c
 
 void mbed_stats_stack_get(mbed_stats_stack_t *stats)
 {
@@ -68,3 +71,20 @@ size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count)
 #if MBED_STACK_STATS_ENABLED && !MBED_CONF_RTOS_PRESENT
 #warning Stack statistics are currently not supported without the rtos.
 #endif
+
+#if !MBED_CONF_RTOS_PRESENT
+void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_cpu_t));
+}
+
+size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
+{
+    memset(stats, 0, count*sizeof(mbed_stats_thread_t));
+    return 0;
+}
+#endif
+
+#if MBED_CPU_STATS_ENABLED && !MBED_CONF_RTOS_PRESENT
+#warning CPU statistics are currently not supported without the rtos.
+#endif
@@ -76,6 +76,114 @@ void mbed_stats_stack_get(mbed_stats_stack_t *stats);
  */
 size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count);
 
+/**
+ * struct mbed_stats_cpu_t definition
+ */
+typedef struct {
+    uint64_t uptime;            /**< Time in microseconds since the RTOS kernel was started. */
+    uint64_t idle_time;         /**< Time in microseconds spent in the idle thread, including sleep. */
+    uint32_t switch_cnt;        /**< Number of thread switches. */
+} mbed_stats_cpu_t;
+
+/**
+ *  Fill the passed in structure with CPU usage stats.
+ *  Requires MBED_CPU_STATS_ENABLED, otherwise the structure is zeroed.
+ *
+ *  @param stats    A pointer to the mbed_stats_cpu_t structure to fill
+ */
+void mbed_stats_cpu_get(mbed_stats_cpu_t *stats);
+
+/**
+ * struct mbed_stats_thread_t definition
+ */
+typedef struct {
+    uint32_t id;                /**< Thread identifier. */
+    uint32_t state;             /**< Thread state, see osThreadState_t. */
+    uint32_t priority;          /**< Thread priority, see osPriority_t. */
+    const char *name;           /**< Thread name. */
+    uint64_t run_time;          /**< Time in microseconds the thread has been running. */
+    uint32_t switch_cnt;        /**< Number of times the thread has been switched to. */
+} mbed_stats_thread_t;
+
+/**
+ *  Fill the passed array of stat structures with the CPU usage stats for each available thread.
+ *  Requires MBED_CPU_STATS_ENABLED, otherwise nothing is filled.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_thread_t structures to fill
+ *  @param count    The number of mbed_stats_thread_t structures in the provided array
+ *  @return         The number of mbed_stats_thread_t structures that have been filled,
+ *                  this is equal to the number of threads on the system.
+ */
+size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count);
+
+/**
+ * struct mbed_stats_sleep_t definition
+ */
+typedef struct {
+    uint64_t run_time;          /**< Time in microseconds spent running, outside of sleep and deep sleep. */
+    uint64_t sleep_time;        /**< Time in microseconds spent in sleep. */
+    uint64_t deep_sleep_time;   /**< Time in microseconds spent in deep sleep. */
+    uint32_t sleep_cnt;         /**< Number of times sleep was entered. */
+    uint32_t deep_sleep_cnt;    /**< Number of times deep sleep was entered. */
+    uint32_t awake_cnt;         /**< Number of idle periods too short to sleep. */
+    uint32_t demoted_cnt;       /**< Number of idle periods too short for deep sleep while it was allowed. */
+    uint32_t late_cnt;          /**< Number of wake ups after the expected idle time. */
+    uint32_t max_late_time;     /**< Longest time in microseconds a wake up was late. */
+} mbed_stats_sleep_t;
+
+/**
+ *  Fill the passed in structure with sleep residency stats of the sleep manager.
+ *  Requires MBED_SLEEP_STATS_ENABLED, otherwise the structure is zeroed.
+ *
+ *  Times are measured with the low power ticker if the target has one, the
+ *  deep sleep time is not reliable otherwise. Late wake ups are counted by
+ *  sleep_manager_sleep_auto_for(), the longest one is the wake up latency to
+ *  configure in platform.sleep-latency or platform.deep-sleep-latency.
+ *
+ *  @param stats    A pointer to the mbed_stats_sleep_t structure to fill
+ */
+void mbed_stats_sleep_get(mbed_stats_sleep_t *stats);
+
+/**
+ * struct mbed_stats_sleep_lock_t definition
+ */
+typedef struct {
+    const char *owner;          /**< File name of the first call site that locked deep sleep. */
+    uint32_t count;             /**< Number of locks currently held. */
+    uint32_t lock_cnt;          /**< Number of times deep sleep was locked. */
+    uint64_t held_time;         /**< Time in microseconds deep sleep has been held locked. */
+} mbed_stats_sleep_lock_t;
+
+/**
+ *  Fill the passed array of stat structures with the owners of deep sleep locks.
+ *  Requires MBED_SLEEP_TRACING_ENABLED, otherwise nothing is filled.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_sleep_lock_t structures to fill
+ *  @param count    The number of mbed_stats_sleep_lock_t structures in the provided array
+ *  @return         The number of mbed_stats_sleep_lock_t structures that have been filled,
+ *                  this is equal to the number of owners that have locked deep sleep.
+ */
+size_t mbed_stats_sleep_lock_get_each(mbed_stats_sleep_lock_t *stats, size_t count);
+
+/**
+ *  Print the sleep stats and the deep sleep lock owners to the stdio serial port.
+ *  Requires MBED_SLEEP_STATS_ENABLED or MBED_SLEEP_TRACING_ENABLED, otherwise nothing is printed.
+ *
+ *  If platform.sleep-stats-dump-interval is set, the stats are also printed
+ *  periodically when the target wakes up, see mbed_stats_sleep_dump_pending().
+ */
+void mbed_stats_sleep_dump(void);
+
+/**
+ *  Print the sleep stats if the periodic dump of platform.sleep-stats-dump-interval is due.
+ *
+ *  The dump is raised when the target wakes up. It is printed at once if the
+ *  sleep was entered out of critical sections, otherwise this prints it
+ *  later. The RTOS idle loop calls it after the sleep, once it has left its
+ *  critical section and resumed the kernel.
+ */
+void mbed_stats_sleep_dump_pending(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -36,8 +36,13 @@
 
 #define OS_TIMER_THREAD_STACK_SIZE 768
 #ifndef OS_IDLE_THREAD_STACK_SIZE
+#if defined(MBED_CONF_PLATFORM_SLEEP_STATS_DUMP_INTERVAL) && MBED_CONF_PLATFORM_SLEEP_STATS_DUMP_INTERVAL
+/* The sleep stats are printed from the idle thread */
+#define OS_IDLE_THREAD_STACK_SIZE  1024
+#else
 #define OS_IDLE_THREAD_STACK_SIZE  512
 #endif
+#endif
 
 #define OS_DYNAMIC_MEM_SIZE         0
 
@@ -22,6 +22,7 @@
 
 #include "rtos/rtos_idle.h"
 #include "platform/mbed_sleep.h"
+#include "platform/mbed_stats.h"
 #include "TimerEvent.h"
 #include "lp_ticker_api.h"
 #include "mbed_critical.h"
@@ -65,9 +66,34 @@ public:
      * Schedule an os tick to fire
      *
      * @param delta Tick to fire at relative to current tick
+     * @param early Time in microseconds to fire before the tick
      */
-    void schedule_tick(uint32_t delta=1) {
-        insert_absolute(_start_time + (_tick + delta) * 1000000 /  OS_TICK_FREQ);
+    void schedule_tick(uint32_t delta=1, uint32_t early=0) {
+        insert_absolute(tick_time(delta) - early);
+    }
+
+    /**
+     * Get the time until an os tick
+     *
+     * @param delta Tick relative to current tick
+     * @return Time in microseconds, saturated to 0xFFFFFFFF
+     */
+    uint32_t time_to_tick(uint32_t delta) {
+        return time_to(tick_time(delta));
+    }
+
+    /**
+     * Get the time until the next event of the ticker, the scheduled os tick
+     * or an earlier event of another low power ticker user
+     *
+     * @return Time in microseconds, saturated to 0xFFFFFFFF
+     */
+    uint32_t time_to_next_event() {
+        us_timestamp_t next;
+        if (!ticker_get_next_timestamp_us(_ticker_data, &next)) {
+            return 0xFFFFFFFF;
+        }
+        return time_to(next);
     }
 
 
@@ -121,6 +147,18 @@ public:
 
 protected:
 
+    us_timestamp_t tick_time(uint32_t delta) {
+        return _start_time + (_tick + delta) * 1000000 /  OS_TICK_FREQ;
+    }
+
+    uint32_t time_to(us_timestamp_t timestamp) {
+        us_timestamp_t now = ticker_read_us(_ticker_data);
+        if (timestamp <= now) {
+            return 0;
+        }
+        return timestamp - now > 0xFFFFFFFF ? 0xFFFFFFFF : timestamp - now;
+    }
+
     void handler() {
 #if (defined(NO_SYSTICK))
         NVIC_SetPendingIRQ(mbed_get_m0_tick_irqn());
@@ -195,9 +233,14 @@ static void default_idle_hook(void)
     core_util_critical_section_enter();
     uint32_t ticks_to_sleep = svcRtxKernelSuspend();
     if (ticks_to_sleep) {
-        os_timer->schedule_tick(ticks_to_sleep);
+        // wake up from deep sleep early enough to be on time for the tick
+        uint32_t latency = sleep_manager_wake_up_latency(os_timer->time_to_tick(ticks_to_sleep));
+        os_timer->schedule_tick(ticks_to_sleep, latency);
 
-        sleep();
+#if !(defined(FEATURE_UVISOR) && defined(TARGET_UVISOR_SUPPORTED))
+        // other low power ticker events may be due before the tick
+        sleep_manager_sleep_auto_for(os_timer->time_to_next_event());
+#endif
 
         os_timer->cancel_tick();
         // calculate how long we slept
@@ -205,6 +248,7 @@ static void default_idle_hook(void)
     }
     svcRtxKernelResume(elapsed_ticks);
     core_util_critical_section_exit();
+    mbed_stats_sleep_dump_pending();
 }
 
 #elif defined(FEATURE_UVISOR)
@@ -225,6 +269,7 @@ static void default_idle_hook(void)
     sleep();
     sleep_manager_unlock_deep_sleep();
     core_util_critical_section_exit();
+    mbed_stats_sleep_dump_pending();
 }
 
 #endif // MBED_TICKLESS
@@ -0,0 +1,131 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_stats.h"
+#include <string.h>
+#include <stdlib.h>
+#include "mbed_assert.h"
+#include "cmsis_os2.h"
+#include "rtx_os.h"
+#include "rtx_evr.h"
+#include "RTX_Config.h"
+
+#if defined(MBED_CPU_STATS_ENABLED) && MBED_CPU_STATS_ENABLED
+
+#if defined(EVR_RTX_DISABLE) || (OS_EVR_THREAD == 0) || defined(EVR_RTX_THREAD_SWITCH_DISABLE)
+#error CPU statistics require the RTX thread switch event (OS_EVR_THREAD).
+#endif
+
+#ifdef MBED_TICKLESS
+// Same ticker as the kernel tick, the us ticker may stop in deep sleep
+#include "hal/lp_ticker_api.h"
+#define stats_ticker_data() get_lp_ticker_data()
+#else
+#include "hal/us_ticker_api.h"
+#define stats_ticker_data() get_us_ticker_data()
+#endif
+
+static const ticker_data_t *stats_ticker;
+static us_timestamp_t start_time;
+static us_timestamp_t switch_time;
+static uint32_t switch_cnt;
+
+// RTX hook which gets called when the kernel has selected the next thread to run.
+// The switch itself happens when the SVC or PendSV handler returns.
+void EvrRtxThreadSwitch (osThreadId_t thread_id)
+{
+    osRtxThread_t *next = (osRtxThread_t *)thread_id;
+    // NULL when the kernel is started
+    osRtxThread_t *curr = osRtxInfo.thread.run.curr;
+    us_timestamp_t now;
+
+    if (stats_ticker == NULL) {
+        stats_ticker = stats_ticker_data();
+        now = ticker_read_us(stats_ticker);
+        start_time = now;
+    } else {
+        now = ticker_read_us(stats_ticker);
+    }
+
+    if (curr != NULL) {
+        curr->run_time += now - switch_time;
+    }
+    switch_time = now;
+    if (next != curr) {
+        next->switch_cnt++;
+        switch_cnt++;
+    }
+}
+
+// Run time of the thread, including the time since the last switch if it is running.
+// Must be called with the kernel locked.
+static uint64_t thread_run_time(osRtxThread_t *thread, us_timestamp_t now)
+{
+    if (thread == osRtxInfo.thread.run.curr) {
+        return thread->run_time + (now - switch_time);
+    }
+    return thread->run_time;
+}
+
+#endif
+
+void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_cpu_t));
+
+#if defined(MBED_CPU_STATS_ENABLED) && MBED_CPU_STATS_ENABLED
+    osKernelLock();
+    if (stats_ticker != NULL) {
+        us_timestamp_t now = ticker_read_us(stats_ticker);
+        stats->uptime = now - start_time;
+        stats->idle_time = thread_run_time(osRtxInfo.thread.idle, now);
+        stats->switch_cnt = switch_cnt;
+    }
+    osKernelUnlock();
+#endif
+}
+
+size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
+{
+    memset(stats, 0, count*sizeof(mbed_stats_thread_t));
+    size_t i = 0;
+
+#if defined(MBED_CPU_STATS_ENABLED) && MBED_CPU_STATS_ENABLED
+    osThreadId_t *threads;
+
+    threads = malloc(sizeof(osThreadId_t) * count);
+    MBED_ASSERT(threads != NULL);
+
+    osKernelLock();
+    count = osThreadEnumerate(threads, count);
+    us_timestamp_t now = stats_ticker ? ticker_read_us(stats_ticker) : 0;
+
+    for(i = 0; i < count; i++) {
+        osRtxThread_t *thread = (osRtxThread_t *)threads[i];
+        stats[i].id = (uint32_t)threads[i];
+        stats[i].state = osThreadGetState(threads[i]);
+        stats[i].priority = osThreadGetPriority(threads[i]);
+        stats[i].name = osThreadGetName(threads[i]);
+        stats[i].run_time = thread_run_time(thread, now);
+        stats[i].switch_cnt = thread->switch_cnt;
+    }
+    osKernelUnlock();
+
+    free(threads);
+#endif
+
+    return i;
+}
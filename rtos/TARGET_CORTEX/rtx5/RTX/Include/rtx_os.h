@@ -128,6 +128,10 @@ typedef struct osRtxThread_s {
   uint32_t                thread_addr;  ///< Thread entry address
   uint32_t                  tz_memory;  ///< TrustZone Memory Identifier
   void                       *context;  ///< Context for OsEventObserver objects
+#if (defined(MBED_CPU_STATS_ENABLED) && MBED_CPU_STATS_ENABLED)
+  uint64_t                   run_time;  ///< Run Time in microseconds, for mbed CPU statistics
+  uint32_t                 switch_cnt;  ///< Number of times switched to, for mbed CPU statistics
+#endif
 } osRtxThread_t;
  
  
@@ -746,6 +746,10 @@ osThreadId_t svcRtxThreadNew (osThreadFunc_t func, void *argument, const osThrea
 #if (__DOMAIN_NS == 1U)
   thread->tz_memory     = tz_memory;
 #endif
+#if (defined(MBED_CPU_STATS_ENABLED) && MBED_CPU_STATS_ENABLED)
+  thread->run_time      = 0U;
+  thread->switch_cnt    = 0U;
+#endif
 
   // Initialize stack
    ptr   = (uint32_t *)stack_mem;
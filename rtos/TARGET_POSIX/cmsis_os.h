@@ -0,0 +1,90 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef CMSIS_OS_H_
+#define CMSIS_OS_H_
+
+/* The types and definitions of the CMSIS-RTOS 1 API which mbed OS uses on
+ * top of CMSIS-RTOS2, see rtx4/cmsis_os.h. The RTOS 1 functions are not
+ * provided on the native POSIX target.
+ */
+
+#include <stdint.h>
+#include "cmsis_os2.h"
+
+#define osCMSIS             0x20001U    ///< API version (main[31:16].sub[15:0])
+
+#define os_InRegs
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+#define osPriority osPriority_t
+
+/// Entry point of a thread.
+typedef void (*os_pthread) (void const *argument);
+
+/// Entry point of a timer call back function.
+typedef void (*os_ptimer) (void const *argument);
+
+#define os_timer_type osTimerType_t
+
+/// Status code values returned by CMSIS-RTOS functions.
+typedef int32_t                  osStatus;
+#define osEventSignal           (0x08)
+#define osEventMessage          (0x10)
+#define osEventMail             (0x20)
+#define osEventTimeout          (0x40)
+#define osErrorOS               osError
+#define osErrorTimeoutResource  osErrorTimeout
+#define osErrorISRRecursive     (-126)
+#define osErrorValue            (-127)
+#define osErrorPriority         (-128)
+
+#define osThreadId osThreadId_t
+#define osTimerId osTimerId_t
+#define osMutexId osMutexId_t
+#define osSemaphoreId osSemaphoreId_t
+
+/// Pool ID identifies the memory pool.
+typedef void *osPoolId;
+
+/// Message ID identifies the message queue.
+typedef void *osMessageQId;
+
+/// Mail ID identifies the mail queue.
+typedef void *osMailQId;
+
+/// Event structure contains detailed information about an event.
+typedef struct {
+  osStatus                    status;   ///< status code: event or error information
+  union {
+    uint32_t                       v;   ///< message as 32-bit value
+    void                          *p;   ///< message or mail as void pointer
+    int32_t                  signals;   ///< signal flags
+  } value;                              ///< event value
+  union {
+    osMailQId                mail_id;   ///< mail id obtained by \ref osMailCreate
+    osMessageQId          message_id;   ///< message id obtained by \ref osMessageCreate
+  } def;                                ///< event definition
+} osEvent;
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif  // CMSIS_OS_H_
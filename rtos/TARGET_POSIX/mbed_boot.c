@@ -0,0 +1,92 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* mbed OS boot sequence on the native POSIX target
+ *
+ * The program is a host process, the host C library is initialized before
+ * any mbed OS code runs. The kernel is started from a constructor which runs
+ * before the C++ static constructors, so they can use the RTOS like on the
+ * other targets, and main is wrapped with the linker (--wrap,main):
+ *
+ * _start (LIBC)
+ *     -> __libc_start_main (LIBC)
+ *         -> mbed_posix_start (MBED: rtos/TARGET_POSIX/mbed_boot.c)
+ *             -> mbed_sdk_init (TARGET)
+ *             -> osKernelInitialize (POSIX), the calling thread becomes the main thread
+ *             -> osKernelStart (POSIX)
+ *         -> static constructors (LIBC)
+ *         -> __wrap_main (MBED: rtos/TARGET_POSIX/mbed_boot.c)
+ *             -> mbed_main (MBED: rtos/TARGET_POSIX/mbed_boot.c)
+ *             -> __real_main (APP)
+ *
+ * The host C library has its own locks, the heap and the environment don't
+ * need RTOS mutexes.
+ */
+
+#include <stdlib.h>
+
+#include "cmsis.h"
+#include "mbed_rtos_storage.h"
+#include "cmsis_os2.h"
+#include "mbed_toolchain.h"
+#include "mbed_error.h"
+
+WEAK void mbed_main(void);
+
+osMutexId_t               singleton_mutex_id;
+mbed_rtos_storage_mutex_t singleton_mutex_obj;
+osMutexAttr_t             singleton_mutex_attr;
+
+/* mbed_main is a function that is called before main()
+ * mbed_sdk_init() is also a function that is called before main(), but unlike
+ * mbed_main(), it is not meant for user code, but for the SDK itself to perform
+ * initializations before main() is called.
+ */
+WEAK void mbed_main(void) {
+
+}
+
+/* This function can be implemented by the target to perform higher level target initialization, before the mbed OS or
+ * the RTOS is started.
+ */
+void mbed_sdk_init(void);
+WEAK void mbed_sdk_init(void) {
+}
+
+// First of the constructors of the program, the priorities below 101 are reserved
+__attribute__((constructor(101)))
+static void mbed_posix_start(void)
+{
+    mbed_sdk_init();
+    osKernelInitialize();
+
+    singleton_mutex_attr.name = "singleton_mutex";
+    singleton_mutex_attr.attr_bits = osMutexRecursive | osMutexPrioInherit | osMutexRobust;
+    singleton_mutex_attr.cb_size = sizeof(singleton_mutex_obj);
+    singleton_mutex_attr.cb_mem = &singleton_mutex_obj;
+    singleton_mutex_id = osMutexNew(&singleton_mutex_attr);
+
+    if (osKernelStart() != osOK) {
+        error("Kernel not started");
+    }
+}
+
+int __real_main(void);
+
+int __wrap_main(void) {
+    mbed_main();
+    return __real_main();
+}
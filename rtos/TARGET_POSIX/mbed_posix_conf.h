@@ -0,0 +1,38 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_POSIX_CONF_H
+#define MBED_POSIX_CONF_H
+
+/** Any access to the data structures of the POSIX port used in common code should be wrapped in ifdef MBED_OS_BACKEND_POSIX */
+#define MBED_OS_BACKEND_POSIX
+
+/** The thread's stack size can be configured by the application, if not explicitly specified it'll default to 4K */
+#ifndef MBED_CONF_APP_THREAD_STACK_SIZE
+#define MBED_CONF_APP_THREAD_STACK_SIZE 4096
+#endif
+
+#define OS_STACK_SIZE               MBED_CONF_APP_THREAD_STACK_SIZE
+
+/* Added to the stack of each thread for the host C library, which needs much
+ * more stack than the mbed OS C libraries. The stack statistics only account
+ * the size requested for the thread. */
+#ifndef OS_POSIX_STACK_MARGIN
+#define OS_POSIX_STACK_MARGIN       (64 * 1024)
+#endif
+
+#define OS_TIMER_THREAD_STACK_SIZE  768
+
+#endif /* MBED_POSIX_CONF_H */
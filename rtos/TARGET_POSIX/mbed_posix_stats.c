@@ -0,0 +1,103 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_stats.h"
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include "mbed_assert.h"
+#include "cmsis_os2.h"
+#include "posix_lib.h"
+
+#if defined(MBED_CPU_STATS_ENABLED) && MBED_CPU_STATS_ENABLED
+
+/* The threads run concurrently on the host, the run time of a thread is the
+ * CPU time of its POSIX thread and the idle time is the time the process
+ * didn't use the CPU. The interrupt threads are accounted to the idle time. */
+
+static uint64_t timespec_us(const struct timespec *ts)
+{
+    return (uint64_t)ts->tv_sec * 1000000U + (uint64_t)ts->tv_nsec / 1000U;
+}
+
+static uint64_t clock_us(clockid_t clock)
+{
+    struct timespec ts;
+
+    if (clock_gettime(clock, &ts) != 0) {
+        return 0;
+    }
+    return timespec_us(&ts);
+}
+
+// Must be called with the kernel locked, the thread can't exit
+static uint64_t thread_run_time(os_thread_t *thread)
+{
+    clockid_t clock;
+
+    if (pthread_getcpuclockid(thread->pthread, &clock) != 0) {
+        return 0;
+    }
+    return clock_us(clock);
+}
+
+#endif
+
+void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_cpu_t));
+
+#if defined(MBED_CPU_STATS_ENABLED) && MBED_CPU_STATS_ENABLED
+    osKernelLock();
+    uint64_t busy_time = clock_us(CLOCK_PROCESS_CPUTIME_ID);
+    stats->uptime = posix_time_us() - osPosixInfo.start_us;
+    // Several threads run at the same time on a multi core host
+    stats->idle_time = (stats->uptime > busy_time) ? (stats->uptime - busy_time) : 0;
+    stats->switch_cnt = osPosixInfo.switch_cnt;
+    osKernelUnlock();
+#endif
+}
+
+size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
+{
+    memset(stats, 0, count*sizeof(mbed_stats_thread_t));
+    size_t i = 0;
+
+#if defined(MBED_CPU_STATS_ENABLED) && MBED_CPU_STATS_ENABLED
+    osThreadId_t *threads;
+
+    threads = malloc(sizeof(osThreadId_t) * count);
+    MBED_ASSERT(threads != NULL);
+
+    osKernelLock();
+    count = osThreadEnumerate(threads, count);
+
+    for(i = 0; i < count; i++) {
+        os_thread_t *thread = (os_thread_t *)threads[i];
+        stats[i].id = (uint32_t)threads[i];
+        stats[i].state = osThreadGetState(threads[i]);
+        stats[i].priority = osThreadGetPriority(threads[i]);
+        stats[i].name = osThreadGetName(threads[i]);
+        stats[i].run_time = thread_run_time(thread);
+        stats[i].switch_cnt = thread->switch_cnt;
+    }
+    osKernelUnlock();
+
+    free(threads);
+#endif
+
+    return i;
+}
@@ -0,0 +1,66 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "posix_lib.h"
+
+//  ==== Public API ====
+
+osStatus_t osDelay(uint32_t ticks)
+{
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (ticks == 0U) {
+        return osOK;
+    }
+
+    posix_core_lock();
+    if (!osPosixThreadCanWait()) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    osPosixThreadWait(NULL, osRtxThreadWaitingDelay, osPosixDeadline(ticks));
+    posix_core_unlock();
+
+    return osOK;
+}
+
+osStatus_t osDelayUntil(uint32_t ticks)
+{
+    uint64_t now;
+    uint64_t tick;
+    uint32_t delay;
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+
+    posix_core_lock();
+    now = posix_time_us() - osPosixInfo.start_us;
+    tick = now / 1000U;
+    delay = ticks - (uint32_t)tick;
+    if ((delay == 0U) || (delay > 0x7FFFFFFFU)) {
+        posix_core_unlock();
+        return osErrorParameter;
+    }
+    if (!osPosixThreadCanWait()) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    osPosixThreadWait(NULL, osRtxThreadWaitingDelay, osPosixInfo.start_us + (tick + delay) * 1000U);
+    posix_core_unlock();
+
+    return osOK;
+}
@@ -0,0 +1,207 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "posix_lib.h"
+
+//  ==== Helper functions ====
+
+static os_event_flags_t *EventFlagsValidate(osEventFlagsId_t ef_id)
+{
+    os_event_flags_t *ef = (os_event_flags_t *)ef_id;
+
+    if ((ef == NULL) || (ef->id != osPosixIdEventFlags)) {
+        return NULL;
+    }
+    return ef;
+}
+
+// Event flags which satisfy a wait, the matched flags are cleared
+static uint32_t EventFlagsCheck(os_event_flags_t *ef, uint32_t flags, uint32_t options)
+{
+    uint32_t event_flags = ef->event_flags;
+
+    if ((options & osFlagsWaitAll) != 0U) {
+        if ((event_flags & flags) != flags) {
+            return 0U;
+        }
+    } else if ((event_flags & flags) == 0U) {
+        return 0U;
+    }
+    if ((options & osFlagsNoClear) == 0U) {
+        ef->event_flags &= ~flags;
+    }
+    return event_flags;
+}
+
+//  ==== Public API ====
+
+osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr)
+{
+    os_event_flags_t *ef;
+    const char *name = NULL;
+    void *cb_mem = NULL;
+    uint32_t cb_size = 0U;
+    uint8_t flags;
+
+    if (posix_in_irq()) {
+        return NULL;
+    }
+
+    if (attr != NULL) {
+        name    = attr->name;
+        cb_mem  = attr->cb_mem;
+        cb_size = attr->cb_size;
+    }
+
+    ef = (os_event_flags_t *)osPosixObjectAlloc(cb_mem, cb_size, sizeof(os_event_flags_t), &flags);
+    if (ef == NULL) {
+        return NULL;
+    }
+    ef->id = osPosixIdEventFlags;
+    ef->state = 1U;
+    ef->flags = flags;
+    ef->name = name;
+
+    return ef;
+}
+
+const char *osEventFlagsGetName(osEventFlagsId_t ef_id)
+{
+    os_event_flags_t *ef = EventFlagsValidate(ef_id);
+
+    if (posix_in_irq() || (ef == NULL)) {
+        return NULL;
+    }
+    return ef->name;
+}
+
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
+{
+    os_event_flags_t *ef = EventFlagsValidate(ef_id);
+    os_thread_t *thread;
+    os_thread_t *next;
+    uint32_t event_flags;
+    uint32_t wait_flags;
+
+    if ((ef == NULL) || ((flags & osFlagsError) != 0U)) {
+        return osFlagsErrorParameter;
+    }
+
+    posix_core_lock();
+    ef->event_flags |= flags;
+    event_flags = ef->event_flags;
+    for (thread = ef->thread_list; thread != NULL; thread = next) {
+        next = thread->wait_next;
+        wait_flags = EventFlagsCheck(ef, thread->wait_flags, thread->flags_options);
+        if (wait_flags != 0U) {
+            thread->wait_value = wait_flags;
+            osPosixThreadWakeup(thread, osOK);
+        }
+    }
+    posix_core_unlock();
+
+    return event_flags;
+}
+
+uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags)
+{
+    os_event_flags_t *ef = EventFlagsValidate(ef_id);
+    uint32_t event_flags;
+
+    if ((ef == NULL) || ((flags & osFlagsError) != 0U)) {
+        return osFlagsErrorParameter;
+    }
+
+    posix_core_lock();
+    event_flags = ef->event_flags;
+    ef->event_flags &= ~flags;
+    posix_core_unlock();
+
+    return event_flags;
+}
+
+uint32_t osEventFlagsGet(osEventFlagsId_t ef_id)
+{
+    os_event_flags_t *ef = EventFlagsValidate(ef_id);
+
+    if (ef == NULL) {
+        return 0U;
+    }
+    return ef->event_flags;
+}
+
+uint32_t osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    os_event_flags_t *ef = EventFlagsValidate(ef_id);
+    os_thread_t *thread = osPosixThreadCurrent;
+    uint32_t event_flags;
+
+    if ((ef == NULL) || ((flags & osFlagsError) != 0U)) {
+        return osFlagsErrorParameter;
+    }
+    if (posix_in_irq() && (timeout != 0U)) {
+        return osFlagsErrorParameter;
+    }
+
+    posix_core_lock();
+    event_flags = EventFlagsCheck(ef, flags, options);
+    if (event_flags == 0U) {
+        if ((timeout != 0U) && osPosixThreadCanWait()) {
+            thread->wait_flags = flags;
+            thread->flags_options = (uint8_t)options;
+            switch (osPosixThreadWait(&ef->thread_list, osRtxThreadWaitingEventFlags, osPosixDeadline(timeout))) {
+                case osOK:
+                    event_flags = thread->wait_value;
+                    break;
+                case osErrorTimeout:
+                    event_flags = osFlagsErrorTimeout;
+                    break;
+                default:
+                    // Deleted while waiting
+                    event_flags = osFlagsErrorResource;
+                    break;
+            }
+        } else {
+            event_flags = osFlagsErrorResource;
+        }
+    }
+    posix_core_unlock();
+
+    return event_flags;
+}
+
+osStatus_t osEventFlagsDelete(osEventFlagsId_t ef_id)
+{
+    os_event_flags_t *ef = EventFlagsValidate(ef_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (ef == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    while (ef->thread_list != NULL) {
+        osPosixThreadWakeup(ef->thread_list, osErrorResource);
+    }
+    ef->id = osPosixIdInvalid;
+    ef->state = 0U;
+    posix_core_unlock();
+
+    osPosixObjectFree(ef, ef->flags);
+
+    return osOK;
+}
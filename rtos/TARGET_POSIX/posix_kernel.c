@@ -0,0 +1,261 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include "posix_lib.h"
+
+#define osPosixVersionAPI       20010001    ///< API version (2.1.1)
+#define osPosixVersionKernel    10000000    ///< Kernel version (1.0.0)
+#define osPosixKernelId         "mbed POSIX V1.0.0"
+
+os_info_t osPosixInfo;
+__thread os_thread_t *osPosixThreadCurrent;
+
+// The thread which runs main, adopted by the kernel
+static os_thread_t os_main_thread;
+
+//  ==== Library functions ====
+
+uint64_t osPosixTickTime(uint32_t ticks)
+{
+    return osPosixInfo.start_us + (uint64_t)ticks * 1000U;
+}
+
+uint64_t osPosixDeadline(uint32_t timeout)
+{
+    if (timeout == osWaitForever) {
+        return osPosixWaitForever;
+    }
+    return posix_time_us() + (uint64_t)timeout * 1000U;
+}
+
+void *osPosixObjectAlloc(void *cb_mem, uint32_t cb_size, uint32_t size, uint8_t *flags)
+{
+    void *cb;
+
+    if (cb_mem != NULL) {
+        if (cb_size < size) {
+            return NULL;
+        }
+        cb = cb_mem;
+        *flags = 0U;
+    } else {
+        if (cb_size != 0U) {
+            return NULL;
+        }
+        cb = malloc(size);
+        if (cb == NULL) {
+            return NULL;
+        }
+        *flags = osPosixFlagSystemObject;
+    }
+    memset(cb, 0, size);
+    return cb;
+}
+
+void osPosixObjectFree(void *cb, uint8_t flags)
+{
+    if ((flags & osPosixFlagSystemObject) != 0U) {
+        free(cb);
+    }
+}
+
+// Stack of the main thread, as set up by the host
+static uint32_t KernelMainStackSize(void)
+{
+    pthread_attr_t attr;
+    size_t size = 0U;
+    struct rlimit limit;
+
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        pthread_attr_getstacksize(&attr, &size);
+        pthread_attr_destroy(&attr);
+    }
+    if ((size == 0U) && (getrlimit(RLIMIT_STACK, &limit) == 0) && (limit.rlim_cur != RLIM_INFINITY)) {
+        size = limit.rlim_cur;
+    }
+    return (size > UINT32_MAX) ? UINT32_MAX : (uint32_t)size;
+}
+
+//  ==== Public API ====
+
+osStatus_t osKernelInitialize(void)
+{
+    os_thread_t *thread = &os_main_thread;
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+
+    posix_core_lock();
+    if (osPosixInfo.state == osKernelReady) {
+        posix_core_unlock();
+        return osOK;
+    }
+    if (osPosixInfo.state != osKernelInactive) {
+        posix_core_unlock();
+        return osError;
+    }
+
+    osPosixInfo.start_us = posix_time_us();
+
+    // The calling thread becomes the main thread, it has no entry function
+    thread->id = osPosixIdThread;
+    thread->state = osPosixThreadRunning;
+    thread->name = "main_thread";
+    thread->priority = (int8_t)osPriorityNormal;
+    thread->stack_size = KernelMainStackSize();
+    thread->pthread = pthread_self();
+    thread->switch_cnt = 1U;
+    posix_core_cond_init(&thread->cond);
+    thread->thread_next = osPosixInfo.thread_list;
+    osPosixInfo.thread_list = thread;
+    osPosixInfo.thread_count = 1U;
+    osPosixThreadCurrent = thread;
+
+    osPosixInfo.state = osKernelReady;
+    posix_core_unlock();
+
+    return osOK;
+}
+
+osStatus_t osKernelGetInfo(osVersion_t *version, char *id_buf, uint32_t id_size)
+{
+    if (version != NULL) {
+        version->api    = osPosixVersionAPI;
+        version->kernel = osPosixVersionKernel;
+    }
+
+    if ((id_buf != NULL) && (id_size != 0U)) {
+        if (id_size > sizeof(osPosixKernelId)) {
+            id_size = sizeof(osPosixKernelId);
+        }
+        memcpy(id_buf, osPosixKernelId, id_size);
+    }
+
+    return osOK;
+}
+
+osKernelState_t osKernelGetState(void)
+{
+    if ((osPosixInfo.state == osKernelRunning) && osPosixInfo.locked) {
+        return osKernelLocked;
+    }
+    return (osKernelState_t)osPosixInfo.state;
+}
+
+osStatus_t osKernelStart(void)
+{
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+
+    posix_core_lock();
+    if (osPosixInfo.state != osKernelReady) {
+        posix_core_unlock();
+        return osError;
+    }
+    if (osPosixTimerSetup() != osOK) {
+        posix_core_unlock();
+        return osError;
+    }
+    osPosixInfo.state = osKernelRunning;
+    posix_core_unlock();
+
+    return osOK;
+}
+
+/* Locking the kernel takes the core lock, which also holds back the
+ * interrupts as the threads have no other way to stop each other */
+int32_t osKernelLock(void)
+{
+    if (posix_in_irq()) {
+        return (int32_t)osErrorISR;
+    }
+
+    posix_core_lock();
+    if (osPosixInfo.locked) {
+        posix_core_unlock();
+        return 1;
+    }
+    osPosixInfo.locked = 1U;
+    return 0;
+}
+
+int32_t osKernelUnlock(void)
+{
+    if (posix_in_irq()) {
+        return (int32_t)osErrorISR;
+    }
+
+    if (!osPosixInfo.locked) {
+        return 0;
+    }
+    osPosixInfo.locked = 0U;
+    posix_core_unlock();
+    return 1;
+}
+
+int32_t osKernelRestoreLock(int32_t lock)
+{
+    if (posix_in_irq()) {
+        return (int32_t)osErrorISR;
+    }
+
+    switch (lock) {
+        case 1:
+            osKernelLock();
+            return 1;
+        case 0:
+            osKernelUnlock();
+            return 0;
+        default:
+            return (int32_t)osError;
+    }
+}
+
+// The host keeps the time, there are no ticks to suppress
+uint32_t osKernelSuspend(void)
+{
+    return 0U;
+}
+
+void osKernelResume(uint32_t sleep_ticks)
+{
+    (void)sleep_ticks;
+}
+
+uint32_t osKernelGetTickCount(void)
+{
+    return (uint32_t)((posix_time_us() - osPosixInfo.start_us) / 1000U);
+}
+
+uint32_t osKernelGetTickFreq(void)
+{
+    return 1000U;
+}
+
+uint32_t osKernelGetSysTimerCount(void)
+{
+    return (uint32_t)(posix_time_us() - osPosixInfo.start_us);
+}
+
+uint32_t osKernelGetSysTimerFreq(void)
+{
+    return 1000000U;
+}
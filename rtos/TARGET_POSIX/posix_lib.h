@@ -0,0 +1,98 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_POSIX_LIB_H
+#define MBED_POSIX_LIB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cmsis_os2.h"
+#include "posix_os.h"
+#include "mbed_posix_conf.h"
+#include "posix_core.h"
+
+/* Internal functions and data of the native POSIX port of CMSIS-RTOS2.
+ *
+ * The kernel data is accessed with the core lock taken, see posix_core.h.
+ * A thread waits with posix_core_wait(), on the condition of its control
+ * block, which releases the core lock; the thread which wakes it up passes
+ * the result of the wait in the control block.
+ */
+
+/// Kernel Information
+typedef struct {
+  uint8_t                     state;    ///< Kernel state
+  uint8_t                    locked;    ///< Kernel locked by osKernelLock
+  uint64_t                 start_us;    ///< Host time of the kernel start, in microseconds
+  os_thread_t          *thread_list;    ///< Active Threads
+  uint32_t             thread_count;    ///< Number of active Threads
+  uint32_t               switch_cnt;    ///< Number of thread switches, for mbed CPU statistics
+  os_thread_t         *timer_thread;    ///< Timer Thread
+  os_thread_t           *timer_wait;    ///< Timer Thread waiting for the next Timer
+  os_timer_t            *timer_list;    ///< Running Timers, sorted by expiry
+} os_info_t;
+
+extern os_info_t osPosixInfo;
+
+/// Control block of the calling thread, NULL for interrupts and host threads
+extern __thread os_thread_t *osPosixThreadCurrent;
+
+/// Wait forever, as deadline of osPosixThreadWait()
+#define osPosixWaitForever          UINT64_MAX
+
+// Kernel
+
+/// Host time of the tick count
+uint64_t osPosixTickTime(uint32_t ticks);
+
+/// Deadline of a timeout in ticks, from now
+uint64_t osPosixDeadline(uint32_t timeout);
+
+// Memory allocation of the objects
+
+/// Get the control block of a new object, from the attributes or the heap
+void *osPosixObjectAlloc(void *cb_mem, uint32_t cb_size, uint32_t size, uint8_t *flags);
+
+/// Release the control block of a deleted object
+void osPosixObjectFree(void *cb, uint8_t flags);
+
+// Thread
+
+/// Check if the calling thread is a thread of the kernel which can wait
+/// (called with the core lock taken)
+int osPosixThreadCanWait(void);
+
+/// Wait on the calling thread, releases the core lock while waiting
+/// @param list         Wait list of the object, sorted by priority, or NULL
+/// @param state        Blocked state of the thread
+/// @param deadline     Host time to wait until, or osPosixWaitForever
+/// @return osOK when woken up, osErrorTimeout at the deadline
+int32_t osPosixThreadWait(os_thread_t **list, uint8_t state, uint64_t deadline);
+
+/// Wake up a waiting thread
+/// @param thread       Waiting thread
+/// @param status       Result of the wait, returned by osPosixThreadWait()
+void osPosixThreadWakeup(os_thread_t *thread, int32_t status);
+
+/// Release the robust mutexes owned by an exiting thread
+void osPosixMutexOwnerRelease(os_thread_t *thread);
+
+/// Wake up the timer thread, after a change of the running timers
+void osPosixTimerWakeup(void);
+
+/// Create the timer thread
+int32_t osPosixTimerSetup(void);
+
+#endif  // MBED_POSIX_LIB_H
@@ -0,0 +1,222 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include "posix_lib.h"
+
+//  ==== Helper functions ====
+
+static os_memory_pool_t *MemoryPoolValidate(osMemoryPoolId_t mp_id)
+{
+    os_memory_pool_t *mp = (os_memory_pool_t *)mp_id;
+
+    if ((mp == NULL) || (mp->id != osPosixIdMemoryPool)) {
+        return NULL;
+    }
+    return mp;
+}
+
+//  ==== Public API ====
+
+osMemoryPoolId_t osMemoryPoolNew(uint32_t block_count, uint32_t block_size, const osMemoryPoolAttr_t *attr)
+{
+    os_memory_pool_t *mp;
+    const char *name = NULL;
+    void *cb_mem = NULL;
+    uint32_t cb_size = 0U;
+    void *mp_mem = NULL;
+    uint32_t mp_size = 0U;
+    uint64_t size;
+    uint8_t *block;
+    uint32_t n;
+    uint8_t flags;
+
+    if (posix_in_irq() || (block_count == 0U) || (block_size == 0U)) {
+        return NULL;
+    }
+    block_size = (block_size + 3U) & ~3U;
+    size = (uint64_t)block_count * block_size;
+    if (size > UINT32_MAX) {
+        return NULL;
+    }
+
+    if (attr != NULL) {
+        name    = attr->name;
+        cb_mem  = attr->cb_mem;
+        cb_size = attr->cb_size;
+        mp_mem  = attr->mp_mem;
+        mp_size = attr->mp_size;
+    }
+    if ((mp_mem != NULL) && (mp_size < size)) {
+        return NULL;
+    }
+
+    mp = (os_memory_pool_t *)osPosixObjectAlloc(cb_mem, cb_size, sizeof(os_memory_pool_t), &flags);
+    if (mp == NULL) {
+        return NULL;
+    }
+    if (mp_mem == NULL) {
+        mp_mem = malloc((size_t)size);
+        if (mp_mem == NULL) {
+            osPosixObjectFree(mp, flags);
+            return NULL;
+        }
+        flags |= osPosixFlagSystemMemory;
+    }
+
+    mp->id = osPosixIdMemoryPool;
+    mp->state = 1U;
+    mp->flags = flags;
+    mp->name = name;
+    mp->block_mem = mp_mem;
+    mp->max_blocks = block_count;
+    mp->block_size = block_size;
+
+    // Free blocks start with the link to the next free block
+    block = (uint8_t *)mp_mem;
+    for (n = 0U; n < (block_count - 1U); n++) {
+        *((void **)block) = block + block_size;
+        block += block_size;
+    }
+    *((void **)block) = NULL;
+    mp->block_free = mp_mem;
+
+    return mp;
+}
+
+const char *osMemoryPoolGetName(osMemoryPoolId_t mp_id)
+{
+    os_memory_pool_t *mp = MemoryPoolValidate(mp_id);
+
+    if (posix_in_irq() || (mp == NULL)) {
+        return NULL;
+    }
+    return mp->name;
+}
+
+void *osMemoryPoolAlloc(osMemoryPoolId_t mp_id, uint32_t timeout)
+{
+    os_memory_pool_t *mp = MemoryPoolValidate(mp_id);
+    void *block = NULL;
+
+    if ((mp == NULL) || (posix_in_irq() && (timeout != 0U))) {
+        return NULL;
+    }
+
+    posix_core_lock();
+    if (mp->block_free != NULL) {
+        block = mp->block_free;
+        mp->block_free = *((void **)block);
+        mp->used_blocks++;
+    } else if ((timeout != 0U) && osPosixThreadCanWait()) {
+        // A free hands its block to the first waiting thread
+        osPosixThreadCurrent->wait_ptr = NULL;
+        if (osPosixThreadWait(&mp->thread_list, osRtxThreadWaitingMemoryPool, osPosixDeadline(timeout)) == osOK) {
+            block = osPosixThreadCurrent->wait_ptr;
+        }
+    }
+    posix_core_unlock();
+
+    return block;
+}
+
+osStatus_t osMemoryPoolFree(osMemoryPoolId_t mp_id, void *block)
+{
+    os_memory_pool_t *mp = MemoryPoolValidate(mp_id);
+    os_thread_t *thread;
+    uintptr_t offset;
+
+    if ((mp == NULL) || (block == NULL)) {
+        return osErrorParameter;
+    }
+    offset = (uintptr_t)block - (uintptr_t)mp->block_mem;
+    if (((uintptr_t)block < (uintptr_t)mp->block_mem) ||
+            (offset >= ((uintptr_t)mp->max_blocks * mp->block_size)) || ((offset % mp->block_size) != 0U)) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if (mp->used_blocks == 0U) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    thread = mp->thread_list;
+    if (thread != NULL) {
+        thread->wait_ptr = block;
+        osPosixThreadWakeup(thread, osOK);
+    } else {
+        *((void **)block) = mp->block_free;
+        mp->block_free = block;
+        mp->used_blocks--;
+    }
+    posix_core_unlock();
+
+    return osOK;
+}
+
+uint32_t osMemoryPoolGetCapacity(osMemoryPoolId_t mp_id)
+{
+    os_memory_pool_t *mp = MemoryPoolValidate(mp_id);
+
+    return (mp == NULL) ? 0U : mp->max_blocks;
+}
+
+uint32_t osMemoryPoolGetBlockSize(osMemoryPoolId_t mp_id)
+{
+    os_memory_pool_t *mp = MemoryPoolValidate(mp_id);
+
+    return (mp == NULL) ? 0U : mp->block_size;
+}
+
+uint32_t osMemoryPoolGetCount(osMemoryPoolId_t mp_id)
+{
+    os_memory_pool_t *mp = MemoryPoolValidate(mp_id);
+
+    return (mp == NULL) ? 0U : mp->used_blocks;
+}
+
+uint32_t osMemoryPoolGetSpace(osMemoryPoolId_t mp_id)
+{
+    os_memory_pool_t *mp = MemoryPoolValidate(mp_id);
+
+    return (mp == NULL) ? 0U : (mp->max_blocks - mp->used_blocks);
+}
+
+osStatus_t osMemoryPoolDelete(osMemoryPoolId_t mp_id)
+{
+    os_memory_pool_t *mp = MemoryPoolValidate(mp_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (mp == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    while (mp->thread_list != NULL) {
+        osPosixThreadWakeup(mp->thread_list, osErrorResource);
+    }
+    mp->id = osPosixIdInvalid;
+    mp->state = 0U;
+    posix_core_unlock();
+
+    if ((mp->flags & osPosixFlagSystemMemory) != 0U) {
+        free(mp->block_mem);
+    }
+    osPosixObjectFree(mp, mp->flags);
+
+    return osOK;
+}
@@ -0,0 +1,295 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "posix_lib.h"
+
+//  ==== Helper functions ====
+
+static os_message_queue_t *MessageQueueValidate(osMessageQueueId_t mq_id)
+{
+    os_message_queue_t *mq = (os_message_queue_t *)mq_id;
+
+    if ((mq == NULL) || (mq->id != osPosixIdMessageQueue)) {
+        return NULL;
+    }
+    return mq;
+}
+
+static inline void *MessageData(os_message_t *msg)
+{
+    return (void *)(msg + 1);
+}
+
+// Queue a message in a free slot, after the messages with the same priority
+static void MessagePut(os_message_queue_t *mq, const void *msg_ptr, uint8_t msg_prio)
+{
+    os_message_t *msg = mq->free;
+    os_message_t **prev = &mq->first;
+
+    mq->free = msg->next;
+    memcpy(MessageData(msg), msg_ptr, mq->msg_size);
+    msg->priority = msg_prio;
+    while ((*prev != NULL) && ((*prev)->priority >= msg_prio)) {
+        prev = &(*prev)->next;
+    }
+    msg->next = *prev;
+    *prev = msg;
+    mq->msg_count++;
+}
+
+// Wake up the first thread waiting to put a message, if there is space
+static void MessageQueuePutWaiting(os_message_queue_t *mq)
+{
+    os_thread_t *thread = mq->thread_list;
+
+    if ((thread != NULL) && (thread->state == osRtxThreadWaitingMessagePut) && (mq->free != NULL)) {
+        MessagePut(mq, thread->wait_ptr, (uint8_t)thread->wait_value);
+        osPosixThreadWakeup(thread, osOK);
+    }
+}
+
+//  ==== Public API ====
+
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr)
+{
+    os_message_queue_t *mq;
+    const char *name = NULL;
+    void *cb_mem = NULL;
+    uint32_t cb_size = 0U;
+    void *mq_mem = NULL;
+    uint32_t mq_size = 0U;
+    uint32_t block_size;
+    uint64_t size;
+    os_message_t *msg;
+    uint32_t n;
+    uint8_t flags;
+
+    if (posix_in_irq() || (msg_count == 0U) || (msg_size == 0U)) {
+        return NULL;
+    }
+    block_size = ((msg_size + 3U) & ~3U) + sizeof(os_message_t);
+    size = (uint64_t)msg_count * block_size;
+    if (size > UINT32_MAX) {
+        return NULL;
+    }
+
+    if (attr != NULL) {
+        name    = attr->name;
+        cb_mem  = attr->cb_mem;
+        cb_size = attr->cb_size;
+        mq_mem  = attr->mq_mem;
+        mq_size = attr->mq_size;
+    }
+    if ((mq_mem != NULL) && (mq_size < size)) {
+        return NULL;
+    }
+
+    mq = (os_message_queue_t *)osPosixObjectAlloc(cb_mem, cb_size, sizeof(os_message_queue_t), &flags);
+    if (mq == NULL) {
+        return NULL;
+    }
+    if (mq_mem == NULL) {
+        mq_mem = malloc((size_t)size);
+        if (mq_mem == NULL) {
+            osPosixObjectFree(mq, flags);
+            return NULL;
+        }
+        flags |= osPosixFlagSystemMemory;
+    }
+
+    mq->id = osPosixIdMessageQueue;
+    mq->state = 1U;
+    mq->flags = flags;
+    mq->name = name;
+    mq->msg_mem = mq_mem;
+    mq->msg_size = msg_size;
+    mq->max_count = msg_count;
+
+    msg = (os_message_t *)mq_mem;
+    for (n = 0U; n < (msg_count - 1U); n++) {
+        msg->next = (os_message_t *)((uint8_t *)msg + block_size);
+        msg = msg->next;
+    }
+    msg->next = NULL;
+    mq->free = (os_message_t *)mq_mem;
+
+    return mq;
+}
+
+const char *osMessageQueueGetName(osMessageQueueId_t mq_id)
+{
+    os_message_queue_t *mq = MessageQueueValidate(mq_id);
+
+    if (posix_in_irq() || (mq == NULL)) {
+        return NULL;
+    }
+    return mq->name;
+}
+
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout)
+{
+    os_message_queue_t *mq = MessageQueueValidate(mq_id);
+    os_thread_t *thread;
+    osStatus_t status = osOK;
+
+    if ((mq == NULL) || (msg_ptr == NULL) || (posix_in_irq() && (timeout != 0U))) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    thread = mq->thread_list;
+    if ((thread != NULL) && (thread->state == osRtxThreadWaitingMessageGet)) {
+        // Straight to the waiting thread
+        memcpy(thread->wait_ptr, msg_ptr, mq->msg_size);
+        thread->wait_value = msg_prio;
+        osPosixThreadWakeup(thread, osOK);
+    } else if (mq->free != NULL) {
+        MessagePut(mq, msg_ptr, msg_prio);
+    } else if ((timeout != 0U) && osPosixThreadCanWait()) {
+        thread = osPosixThreadCurrent;
+        thread->wait_ptr = (void *)msg_ptr;
+        thread->wait_value = msg_prio;
+        status = (osStatus_t)osPosixThreadWait(&mq->thread_list, osRtxThreadWaitingMessagePut, osPosixDeadline(timeout));
+    } else {
+        status = osErrorResource;
+    }
+    posix_core_unlock();
+
+    return status;
+}
+
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout)
+{
+    os_message_queue_t *mq = MessageQueueValidate(mq_id);
+    os_thread_t *thread;
+    os_message_t *msg;
+    osStatus_t status = osOK;
+
+    if ((mq == NULL) || (msg_ptr == NULL) || (posix_in_irq() && (timeout != 0U))) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    msg = mq->first;
+    if (msg != NULL) {
+        mq->first = msg->next;
+        mq->msg_count--;
+        memcpy(msg_ptr, MessageData(msg), mq->msg_size);
+        if (msg_prio != NULL) {
+            *msg_prio = msg->priority;
+        }
+        msg->next = mq->free;
+        mq->free = msg;
+        MessageQueuePutWaiting(mq);
+    } else if ((timeout != 0U) && osPosixThreadCanWait()) {
+        thread = osPosixThreadCurrent;
+        thread->wait_ptr = msg_ptr;
+        status = (osStatus_t)osPosixThreadWait(&mq->thread_list, osRtxThreadWaitingMessageGet, osPosixDeadline(timeout));
+        if ((status == osOK) && (msg_prio != NULL)) {
+            *msg_prio = (uint8_t)thread->wait_value;
+        }
+    } else {
+        status = osErrorResource;
+    }
+    posix_core_unlock();
+
+    return status;
+}
+
+uint32_t osMessageQueueGetCapacity(osMessageQueueId_t mq_id)
+{
+    os_message_queue_t *mq = MessageQueueValidate(mq_id);
+
+    return (mq == NULL) ? 0U : mq->max_count;
+}
+
+uint32_t osMessageQueueGetMsgSize(osMessageQueueId_t mq_id)
+{
+    os_message_queue_t *mq = MessageQueueValidate(mq_id);
+
+    return (mq == NULL) ? 0U : mq->msg_size;
+}
+
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id)
+{
+    os_message_queue_t *mq = MessageQueueValidate(mq_id);
+
+    return (mq == NULL) ? 0U : mq->msg_count;
+}
+
+uint32_t osMessageQueueGetSpace(osMessageQueueId_t mq_id)
+{
+    os_message_queue_t *mq = MessageQueueValidate(mq_id);
+
+    return (mq == NULL) ? 0U : (mq->max_count - mq->msg_count);
+}
+
+osStatus_t osMessageQueueReset(osMessageQueueId_t mq_id)
+{
+    os_message_queue_t *mq = MessageQueueValidate(mq_id);
+    os_message_t *msg;
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (mq == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    while ((msg = mq->first) != NULL) {
+        mq->first = msg->next;
+        msg->next = mq->free;
+        mq->free = msg;
+    }
+    mq->msg_count = 0U;
+    // The threads waiting to put messages fill the queue again
+    while ((mq->thread_list != NULL) && (mq->thread_list->state == osRtxThreadWaitingMessagePut) &&
+            (mq->free != NULL)) {
+        MessageQueuePutWaiting(mq);
+    }
+    posix_core_unlock();
+
+    return osOK;
+}
+
+osStatus_t osMessageQueueDelete(osMessageQueueId_t mq_id)
+{
+    os_message_queue_t *mq = MessageQueueValidate(mq_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (mq == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    while (mq->thread_list != NULL) {
+        osPosixThreadWakeup(mq->thread_list, osErrorResource);
+    }
+    mq->id = osPosixIdInvalid;
+    mq->state = 0U;
+    posix_core_unlock();
+
+    if ((mq->flags & osPosixFlagSystemMemory) != 0U) {
+        free(mq->msg_mem);
+    }
+    osPosixObjectFree(mq, mq->flags);
+
+    return osOK;
+}
@@ -0,0 +1,237 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "posix_lib.h"
+
+//  ==== Helper functions ====
+
+static os_mutex_t *MutexValidate(osMutexId_t mutex_id)
+{
+    os_mutex_t *mutex = (os_mutex_t *)mutex_id;
+
+    if ((mutex == NULL) || (mutex->id != osPosixIdMutex)) {
+        return NULL;
+    }
+    return mutex;
+}
+
+static void MutexOwnerAdd(os_mutex_t *mutex, os_thread_t *thread)
+{
+    mutex->owner_thread = thread;
+    mutex->owner_prev = NULL;
+    mutex->owner_next = NULL;
+    mutex->lock = 1U;
+    // Host threads use mutexes without ownership tracking
+    if (thread != NULL) {
+        mutex->owner_next = thread->mutex_list;
+        if (thread->mutex_list != NULL) {
+            thread->mutex_list->owner_prev = mutex;
+        }
+        thread->mutex_list = mutex;
+    }
+}
+
+static void MutexOwnerRemove(os_mutex_t *mutex)
+{
+    os_thread_t *thread = mutex->owner_thread;
+
+    if (mutex->owner_prev != NULL) {
+        mutex->owner_prev->owner_next = mutex->owner_next;
+    } else if (thread != NULL) {
+        thread->mutex_list = mutex->owner_next;
+    }
+    if (mutex->owner_next != NULL) {
+        mutex->owner_next->owner_prev = mutex->owner_prev;
+    }
+    mutex->owner_prev = NULL;
+    mutex->owner_next = NULL;
+}
+
+// Release an unlocked mutex, the first waiting thread becomes the owner
+static void MutexRelease(os_mutex_t *mutex)
+{
+    os_thread_t *thread = mutex->thread_list;
+
+    MutexOwnerRemove(mutex);
+    if (thread != NULL) {
+        MutexOwnerAdd(mutex, thread);
+        osPosixThreadWakeup(thread, osOK);
+    } else {
+        mutex->owner_thread = NULL;
+        mutex->lock = 0U;
+    }
+}
+
+//  ==== Library functions ====
+
+void osPosixMutexOwnerRelease(os_thread_t *thread)
+{
+    os_mutex_t *mutex;
+    os_mutex_t *next;
+
+    for (mutex = thread->mutex_list; mutex != NULL; mutex = next) {
+        next = mutex->owner_next;
+        if ((mutex->attr & osMutexRobust) != 0U) {
+            MutexRelease(mutex);
+        } else {
+            // Stays locked without owner, like RTX
+            mutex->owner_thread = NULL;
+            mutex->owner_prev = NULL;
+            mutex->owner_next = NULL;
+        }
+    }
+    thread->mutex_list = NULL;
+}
+
+//  ==== Public API ====
+
+osMutexId_t osMutexNew(const osMutexAttr_t *attr)
+{
+    os_mutex_t *mutex;
+    const char *name = NULL;
+    uint32_t attr_bits = 0U;
+    void *cb_mem = NULL;
+    uint32_t cb_size = 0U;
+    uint8_t flags;
+
+    if (posix_in_irq()) {
+        return NULL;
+    }
+
+    if (attr != NULL) {
+        name      = attr->name;
+        attr_bits = attr->attr_bits;
+        cb_mem    = attr->cb_mem;
+        cb_size   = attr->cb_size;
+    }
+
+    mutex = (os_mutex_t *)osPosixObjectAlloc(cb_mem, cb_size, sizeof(os_mutex_t), &flags);
+    if (mutex == NULL) {
+        return NULL;
+    }
+    mutex->id = osPosixIdMutex;
+    mutex->state = 1U;
+    mutex->flags = flags;
+    mutex->attr = (uint8_t)attr_bits;
+    mutex->name = name;
+
+    return mutex;
+}
+
+const char *osMutexGetName(osMutexId_t mutex_id)
+{
+    os_mutex_t *mutex = MutexValidate(mutex_id);
+
+    if (posix_in_irq() || (mutex == NULL)) {
+        return NULL;
+    }
+    return mutex->name;
+}
+
+// Priority inheritance is left to the host, which schedules the threads
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
+{
+    os_mutex_t *mutex = MutexValidate(mutex_id);
+    os_thread_t *thread = osPosixThreadCurrent;
+    osStatus_t status;
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (mutex == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if (mutex->lock == 0U) {
+        MutexOwnerAdd(mutex, thread);
+        status = osOK;
+    } else if (mutex->owner_thread == thread) {
+        if ((mutex->attr & osMutexRecursive) != 0U) {
+            mutex->lock++;
+            status = osOK;
+        } else {
+            status = osErrorResource;
+        }
+    } else if ((timeout != 0U) && osPosixThreadCanWait()) {
+        status = (osStatus_t)osPosixThreadWait(&mutex->thread_list, osRtxThreadWaitingMutex, osPosixDeadline(timeout));
+    } else {
+        status = osErrorResource;
+    }
+    posix_core_unlock();
+
+    return status;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id)
+{
+    os_mutex_t *mutex = MutexValidate(mutex_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (mutex == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if ((mutex->lock == 0U) || (mutex->owner_thread != osPosixThreadCurrent)) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    if (--mutex->lock == 0U) {
+        MutexRelease(mutex);
+    }
+    posix_core_unlock();
+
+    return osOK;
+}
+
+osThreadId_t osMutexGetOwner(osMutexId_t mutex_id)
+{
+    os_mutex_t *mutex = MutexValidate(mutex_id);
+
+    if (posix_in_irq() || (mutex == NULL) || (mutex->lock == 0U)) {
+        return NULL;
+    }
+    return mutex->owner_thread;
+}
+
+osStatus_t osMutexDelete(osMutexId_t mutex_id)
+{
+    os_mutex_t *mutex = MutexValidate(mutex_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (mutex == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if (mutex->lock != 0U) {
+        MutexOwnerRemove(mutex);
+    }
+    while (mutex->thread_list != NULL) {
+        osPosixThreadWakeup(mutex->thread_list, osErrorResource);
+    }
+    mutex->id = osPosixIdInvalid;
+    mutex->state = 0U;
+    posix_core_unlock();
+
+    osPosixObjectFree(mutex, mutex->flags);
+
+    return osOK;
+}
@@ -0,0 +1,200 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_POSIX_OS_H
+#define MBED_POSIX_OS_H
+
+#include <stdint.h>
+#include <pthread.h>
+#include "cmsis_os2.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Control blocks of the CMSIS-RTOS2 objects of the native POSIX port.
+ *
+ * The layout follows the RTX control blocks (rtx_os.h) where the common code
+ * relies on it. Threads are POSIX threads, the kernel state is protected by
+ * the core lock of the target (posix_core.h) which also serializes the
+ * interrupt handlers, and a thread waits for an object on its own condition.
+ */
+
+/// Object Identifier definitions
+#define osPosixIdInvalid            0x00U
+#define osPosixIdThread             0x01U
+#define osPosixIdTimer              0x02U
+#define osPosixIdEventFlags         0x03U
+#define osPosixIdMutex              0x04U
+#define osPosixIdSemaphore          0x05U
+#define osPosixIdMemoryPool         0x06U
+#define osPosixIdMessage            0x07U
+#define osPosixIdMessageQueue       0x08U
+
+/// Object Flags definitions
+#define osPosixFlagSystemObject     0x01U   ///< Control block allocated by the port
+#define osPosixFlagSystemMemory     0x02U   ///< Data memory allocated by the port
+
+/// Thread State definitions, the blocked states are the ones of RTX
+#define osPosixThreadInactive       ((uint8_t)osThreadInactive)
+#define osPosixThreadReady          ((uint8_t)osThreadReady)
+#define osPosixThreadRunning        ((uint8_t)osThreadRunning)
+#define osPosixThreadBlocked        ((uint8_t)osThreadBlocked)
+#define osPosixThreadTerminated     ((uint8_t)osThreadTerminated)
+
+#define osRtxThreadWaitingDelay         (osPosixThreadBlocked | 0x10U)
+#define osRtxThreadWaitingJoin          (osPosixThreadBlocked | 0x20U)
+#define osRtxThreadWaitingThreadFlags   (osPosixThreadBlocked | 0x30U)
+#define osRtxThreadWaitingEventFlags    (osPosixThreadBlocked | 0x40U)
+#define osRtxThreadWaitingMutex         (osPosixThreadBlocked | 0x50U)
+#define osRtxThreadWaitingSemaphore     (osPosixThreadBlocked | 0x60U)
+#define osRtxThreadWaitingMemoryPool    (osPosixThreadBlocked | 0x70U)
+#define osRtxThreadWaitingMessageGet    (osPosixThreadBlocked | 0x80U)
+#define osRtxThreadWaitingMessagePut    (osPosixThreadBlocked | 0x90U)
+
+/// Timer State definitions
+#define osPosixTimerInactive        0x00U
+#define osPosixTimerStopped         0x01U
+#define osPosixTimerRunning         0x02U
+
+struct os_mutex_s;
+
+/// Thread Control Block
+typedef struct os_thread_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t                       state;  ///< Object State
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                        attr;  ///< Object Attributes
+  const char                    *name;  ///< Object Name
+  struct os_thread_s     *thread_next;  ///< Link pointer to next Thread in the list of threads
+  struct os_thread_s     *thread_prev;  ///< Link pointer to previous Thread in the list of threads
+  struct os_thread_s       *wait_next;  ///< Link pointer to next Thread waiting for the same object
+  struct os_thread_s      **wait_list;  ///< List of waiting Threads the Thread is in
+  struct os_thread_s       *exit_list;  ///< Threads waiting for the Thread to exit
+  struct os_mutex_s       *mutex_list;  ///< Link pointer to list of owned Mutexes
+  int8_t                     priority;  ///< Thread Priority
+  uint8_t                     waiting;  ///< Thread waits for a wakeup
+  uint8_t                 cancel_wait;  ///< Wait was interrupted by a cancellation
+  uint8_t               flags_options;  ///< Thread/Event Flags Options
+  uint32_t                 wait_flags;  ///< Waiting Thread/Event Flags
+  uint32_t               thread_flags;  ///< Thread Flags
+  int32_t                 wait_status;  ///< Result of the wait
+  void                      *wait_ptr;  ///< Wait argument: message, memory block
+  uint32_t                 wait_value;  ///< Wait argument: flags, message priority
+  void                     *stack_mem;  ///< Stack Memory of the POSIX thread
+  uint32_t                 stack_size;  ///< Stack Size
+  uint32_t                 stack_host;  ///< Stack Size of the POSIX thread below the thread entry
+  osThreadFunc_t                 func;  ///< Thread entry function
+  void                      *argument;  ///< Thread entry argument
+  uint32_t                 switch_cnt;  ///< Number of times switched to, for mbed CPU statistics
+  pthread_t                   pthread;  ///< POSIX thread
+  pthread_cond_t                 cond;  ///< Condition the Thread waits on
+} os_thread_t;
+
+/// Timer Control Block
+typedef struct os_timer_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t                       state;  ///< Object State
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                        type;  ///< Timer Type (Periodic/One-shot)
+  const char                    *name;  ///< Object Name
+  struct os_timer_s             *next;  ///< Link pointer to next active Timer
+  uint64_t                        due;  ///< Host time of the next expiry in microseconds
+  uint32_t                       load;  ///< Timer Load value in ticks
+  osTimerFunc_t                  func;  ///< Timer Function
+  void                           *arg;  ///< Timer Function Argument
+} os_timer_t;
+
+/// Event Flags Control Block
+typedef struct os_event_flags_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t                       state;  ///< Object State
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                    reserved;
+  const char                    *name;  ///< Object Name
+  os_thread_t            *thread_list;  ///< Waiting Threads List
+  uint32_t                event_flags;  ///< Event Flags
+} os_event_flags_t;
+
+/// Mutex Control Block
+typedef struct os_mutex_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t                       state;  ///< Object State
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                        attr;  ///< Object Attributes
+  const char                    *name;  ///< Object Name
+  os_thread_t            *thread_list;  ///< Waiting Threads List
+  os_thread_t           *owner_thread;  ///< Owner Thread
+  struct os_mutex_s       *owner_prev;  ///< Pointer to previous Mutex in owner Thread list
+  struct os_mutex_s       *owner_next;  ///< Pointer to next Mutex in owner Thread list
+  uint32_t                       lock;  ///< Lock counter
+} os_mutex_t;
+
+/// Semaphore Control Block
+typedef struct os_semaphore_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t                       state;  ///< Object State
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                    reserved;
+  const char                    *name;  ///< Object Name
+  os_thread_t            *thread_list;  ///< Waiting Threads List
+  uint16_t                     tokens;  ///< Current number of tokens
+  uint16_t                 max_tokens;  ///< Maximum number of tokens
+} os_semaphore_t;
+
+/// Memory Pool Control Block
+typedef struct os_memory_pool_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t                       state;  ///< Object State
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                    reserved;
+  const char                    *name;  ///< Object Name
+  os_thread_t            *thread_list;  ///< Waiting Threads List
+  void                     *block_mem;  ///< Memory of the blocks
+  void                    *block_free;  ///< First free block, a free block links to the next one
+  uint32_t                 max_blocks;  ///< Maximum number of Blocks
+  uint32_t                used_blocks;  ///< Number of used Blocks
+  uint32_t                 block_size;  ///< Block size
+} os_memory_pool_t;
+
+/// Message Control Block, in front of the data of each message
+typedef struct os_message_s {
+  struct os_message_s           *next;  ///< Pointer to next Message
+  uint8_t                    priority;  ///< Message Priority
+  uint8_t                 reserved[3];
+} os_message_t;
+
+/// Message Queue Control Block
+typedef struct os_message_queue_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t                       state;  ///< Object State
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                    reserved;
+  const char                    *name;  ///< Object Name
+  os_thread_t            *thread_list;  ///< Waiting Threads List, all getters or all putters
+  os_message_t                 *first;  ///< First Message, the list is sorted by priority
+  os_message_t                  *free;  ///< First free Message
+  void                       *msg_mem;  ///< Memory of the Messages
+  uint32_t                   msg_size;  ///< Message size
+  uint32_t                  max_count;  ///< Maximum number of Messages
+  uint32_t                  msg_count;  ///< Number of queued Messages
+} os_message_queue_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MBED_POSIX_OS_H
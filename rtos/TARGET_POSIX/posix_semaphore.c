@@ -0,0 +1,160 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "posix_lib.h"
+
+#define osPosixSemaphoreTokenLimit  65535U  ///< Maximum number of tokens per semaphore
+
+//  ==== Helper functions ====
+
+static os_semaphore_t *SemaphoreValidate(osSemaphoreId_t semaphore_id)
+{
+    os_semaphore_t *semaphore = (os_semaphore_t *)semaphore_id;
+
+    if ((semaphore == NULL) || (semaphore->id != osPosixIdSemaphore)) {
+        return NULL;
+    }
+    return semaphore;
+}
+
+//  ==== Public API ====
+
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr)
+{
+    os_semaphore_t *semaphore;
+    const char *name = NULL;
+    void *cb_mem = NULL;
+    uint32_t cb_size = 0U;
+    uint8_t flags;
+
+    if (posix_in_irq()) {
+        return NULL;
+    }
+    if ((max_count == 0U) || (max_count > osPosixSemaphoreTokenLimit) || (initial_count > max_count)) {
+        return NULL;
+    }
+
+    if (attr != NULL) {
+        name    = attr->name;
+        cb_mem  = attr->cb_mem;
+        cb_size = attr->cb_size;
+    }
+
+    semaphore = (os_semaphore_t *)osPosixObjectAlloc(cb_mem, cb_size, sizeof(os_semaphore_t), &flags);
+    if (semaphore == NULL) {
+        return NULL;
+    }
+    semaphore->id = osPosixIdSemaphore;
+    semaphore->state = 1U;
+    semaphore->flags = flags;
+    semaphore->name = name;
+    semaphore->tokens = (uint16_t)initial_count;
+    semaphore->max_tokens = (uint16_t)max_count;
+
+    return semaphore;
+}
+
+const char *osSemaphoreGetName(osSemaphoreId_t semaphore_id)
+{
+    os_semaphore_t *semaphore = SemaphoreValidate(semaphore_id);
+
+    if (posix_in_irq() || (semaphore == NULL)) {
+        return NULL;
+    }
+    return semaphore->name;
+}
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+    os_semaphore_t *semaphore = SemaphoreValidate(semaphore_id);
+    osStatus_t status;
+
+    if (semaphore == NULL) {
+        return osErrorParameter;
+    }
+    if (posix_in_irq() && (timeout != 0U)) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if (semaphore->tokens != 0U) {
+        semaphore->tokens--;
+        status = osOK;
+    } else if ((timeout != 0U) && osPosixThreadCanWait()) {
+        // A release hands its token to the first waiting thread
+        status = (osStatus_t)osPosixThreadWait(&semaphore->thread_list, osRtxThreadWaitingSemaphore, osPosixDeadline(timeout));
+    } else {
+        status = osErrorResource;
+    }
+    posix_core_unlock();
+
+    return status;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id)
+{
+    os_semaphore_t *semaphore = SemaphoreValidate(semaphore_id);
+    osStatus_t status = osOK;
+
+    if (semaphore == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if (semaphore->thread_list != NULL) {
+        osPosixThreadWakeup(semaphore->thread_list, osOK);
+    } else if (semaphore->tokens < semaphore->max_tokens) {
+        semaphore->tokens++;
+    } else {
+        status = osErrorResource;
+    }
+    posix_core_unlock();
+
+    return status;
+}
+
+uint32_t osSemaphoreGetCount(osSemaphoreId_t semaphore_id)
+{
+    os_semaphore_t *semaphore = SemaphoreValidate(semaphore_id);
+
+    if (semaphore == NULL) {
+        return 0U;
+    }
+    return semaphore->tokens;
+}
+
+osStatus_t osSemaphoreDelete(osSemaphoreId_t semaphore_id)
+{
+    os_semaphore_t *semaphore = SemaphoreValidate(semaphore_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (semaphore == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    while (semaphore->thread_list != NULL) {
+        osPosixThreadWakeup(semaphore->thread_list, osErrorResource);
+    }
+    semaphore->id = osPosixIdInvalid;
+    semaphore->state = 0U;
+    posix_core_unlock();
+
+    osPosixObjectFree(semaphore, semaphore->flags);
+
+    return osOK;
+}
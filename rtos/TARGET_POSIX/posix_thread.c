@@ -0,0 +1,702 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <limits.h>
+#include <sched.h>
+#include <stdlib.h>
+#include "posix_lib.h"
+
+#define osPosixStackMagicWord   0xE25A2EA5U ///< Fill pattern of the unused stack, as the mbed Thread class uses
+
+extern void thread_terminate_hook(osThreadId_t id);
+
+//  ==== Helper functions ====
+
+static os_thread_t *ThreadValidate(osThreadId_t thread_id)
+{
+    os_thread_t *thread = (os_thread_t *)thread_id;
+
+    if ((thread == NULL) || (thread->id != osPosixIdThread)) {
+        return NULL;
+    }
+    return thread;
+}
+
+// Put a thread in a wait list, after the threads with the same priority
+static void ThreadListPut(os_thread_t **list, os_thread_t *thread)
+{
+    os_thread_t **prev = list;
+
+    while ((*prev != NULL) && ((*prev)->priority >= thread->priority)) {
+        prev = &(*prev)->wait_next;
+    }
+    thread->wait_next = *prev;
+    *prev = thread;
+    thread->wait_list = list;
+}
+
+static void ThreadListRemove(os_thread_t *thread)
+{
+    os_thread_t **prev = thread->wait_list;
+
+    if (prev == NULL) {
+        return;
+    }
+    while ((*prev != NULL) && (*prev != thread)) {
+        prev = &(*prev)->wait_next;
+    }
+    if (*prev != NULL) {
+        *prev = thread->wait_next;
+    }
+    thread->wait_next = NULL;
+    thread->wait_list = NULL;
+}
+
+static void ThreadActiveAdd(os_thread_t *thread)
+{
+    thread->thread_prev = NULL;
+    thread->thread_next = osPosixInfo.thread_list;
+    if (osPosixInfo.thread_list != NULL) {
+        osPosixInfo.thread_list->thread_prev = thread;
+    }
+    osPosixInfo.thread_list = thread;
+    osPosixInfo.thread_count++;
+}
+
+static void ThreadActiveRemove(os_thread_t *thread)
+{
+    if (thread->thread_prev != NULL) {
+        thread->thread_prev->thread_next = thread->thread_next;
+    } else {
+        osPosixInfo.thread_list = thread->thread_next;
+    }
+    if (thread->thread_next != NULL) {
+        thread->thread_next->thread_prev = thread->thread_prev;
+    }
+    thread->thread_next = NULL;
+    thread->thread_prev = NULL;
+    osPosixInfo.thread_count--;
+}
+
+static void ThreadFree(os_thread_t *thread)
+{
+    pthread_cond_destroy(&thread->cond);
+    thread->id = osPosixIdInvalid;
+    osPosixObjectFree(thread, thread->flags);
+}
+
+// Event flags which satisfy the wait of the thread, the matched flags are cleared
+static uint32_t ThreadFlagsCheck(os_thread_t *thread, uint32_t flags, uint32_t options)
+{
+    uint32_t thread_flags = thread->thread_flags;
+
+    if ((options & osFlagsWaitAll) != 0U) {
+        if ((thread_flags & flags) != flags) {
+            return 0U;
+        }
+    } else if ((thread_flags & flags) == 0U) {
+        return 0U;
+    }
+    if ((options & osFlagsNoClear) == 0U) {
+        thread->thread_flags &= ~flags;
+    }
+    return thread_flags;
+}
+
+#if defined(MBED_STACK_STATS_ENABLED) && MBED_STACK_STATS_ENABLED
+// Fill the unused stack of the calling thread with the magic word, for osThreadGetStackSpace
+static void ThreadStackFill(os_thread_t *thread)
+{
+    pthread_attr_t attr;
+    void *stack_addr;
+    size_t stack_size;
+    volatile uint32_t *stack;
+    uint32_t *stack_end;
+
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+        return;
+    }
+    pthread_attr_getstack(&attr, &stack_addr, &stack_size);
+    pthread_attr_destroy(&attr);
+
+    // The host keeps the thread local storage at the top of the stack,
+    // the stack of the thread starts at the entry function
+    stack = (volatile uint32_t *)stack_addr;
+    stack_end = (uint32_t *)((uintptr_t)__builtin_frame_address(0) - 256U);
+    while (stack < stack_end) {
+        *stack++ = osPosixStackMagicWord;
+    }
+    thread->stack_mem = stack_addr;
+    thread->stack_host = (uint32_t)((uintptr_t)__builtin_frame_address(0) - (uintptr_t)stack_addr);
+}
+#endif
+
+// Cleanup of an exiting thread, when it returns, exits or is cancelled
+static void ThreadExit(void *argument)
+{
+    os_thread_t *thread = (os_thread_t *)argument;
+    os_thread_t *waiter;
+
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+    posix_core_lock_exit();
+
+    // Cancelled while waiting
+    if (thread->waiting) {
+        ThreadListRemove(thread);
+        thread->waiting = 0U;
+    }
+    osPosixMutexOwnerRelease(thread);
+    ThreadActiveRemove(thread);
+    thread->state = osPosixThreadTerminated;
+    osPosixThreadCurrent = NULL;
+
+    if (thread->exit_list == NULL) {
+        if ((thread->attr & osThreadJoinable) == 0U) {
+            ThreadFree(thread);
+        }
+    } else {
+        // The last thread woken up from osThreadJoin or osThreadTerminate frees the thread
+        while ((waiter = thread->exit_list) != NULL) {
+            waiter->wait_value = (waiter->wait_next == NULL) ? 1U : 0U;
+            osPosixThreadWakeup(waiter, osOK);
+        }
+    }
+
+    posix_core_unlock();
+}
+
+static void *ThreadEntry(void *argument)
+{
+    os_thread_t *thread = (os_thread_t *)argument;
+
+    osPosixThreadCurrent = thread;
+#if defined(MBED_STACK_STATS_ENABLED) && MBED_STACK_STATS_ENABLED
+    ThreadStackFill(thread);
+#endif
+
+    // Waits for osThreadNew to complete
+    posix_core_lock();
+    thread->state = osPosixThreadRunning;
+    thread->switch_cnt++;
+    osPosixInfo.switch_cnt++;
+    posix_core_unlock();
+
+    pthread_cleanup_push(ThreadExit, thread);
+    thread->func(thread->argument);
+    thread_terminate_hook(thread);
+    pthread_cleanup_pop(1);
+
+    return NULL;
+}
+
+//  ==== Library functions ====
+
+int osPosixThreadCanWait(void)
+{
+    return (osPosixThreadCurrent != NULL) && !posix_in_irq() && (posix_core_depth() == 1U);
+}
+
+int32_t osPosixThreadWait(os_thread_t **list, uint8_t state, uint64_t deadline)
+{
+    os_thread_t *thread = osPosixThreadCurrent;
+    struct timespec ts;
+    struct timespec *abstime = NULL;
+
+    if (list != NULL) {
+        ThreadListPut(list, thread);
+    } else {
+        thread->wait_list = NULL;
+    }
+    thread->state = state;
+    thread->waiting = 1U;
+    thread->wait_status = (int32_t)osErrorTimeout;
+    osPosixInfo.switch_cnt++;
+
+    if (deadline != osPosixWaitForever) {
+        posix_timespec(&ts, deadline);
+        abstime = &ts;
+    }
+    while (thread->waiting) {
+        if ((posix_core_wait(&thread->cond, abstime) == ETIMEDOUT) && thread->waiting) {
+            ThreadListRemove(thread);
+            thread->waiting = 0U;
+        }
+    }
+
+    thread->state = osPosixThreadRunning;
+    thread->switch_cnt++;
+    osPosixInfo.switch_cnt++;
+    return thread->wait_status;
+}
+
+void osPosixThreadWakeup(os_thread_t *thread, int32_t status)
+{
+    ThreadListRemove(thread);
+    thread->waiting = 0U;
+    thread->wait_status = status;
+    thread->state = osPosixThreadReady;
+    pthread_cond_signal(&thread->cond);
+}
+
+//  ==== Public API ====
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr)
+{
+    os_thread_t *thread;
+    pthread_attr_t thread_attr;
+    const char *name = NULL;
+    uint32_t attr_bits = 0U;
+    void *cb_mem = NULL;
+    uint32_t cb_size = 0U;
+    uint32_t stack_size = OS_STACK_SIZE;
+    osPriority_t priority = osPriorityNormal;
+    size_t host_size;
+    uint8_t flags;
+
+    if (posix_in_irq() || (func == NULL)) {
+        return NULL;
+    }
+
+    if (attr != NULL) {
+        name      = attr->name;
+        attr_bits = attr->attr_bits;
+        cb_mem    = attr->cb_mem;
+        cb_size   = attr->cb_size;
+        if (attr->stack_size != 0U) {
+            stack_size = attr->stack_size;
+        }
+        if (attr->priority != osPriorityNone) {
+            priority = attr->priority;
+        }
+        // The stack memory of the attributes is not used, the host allocates the stacks
+    }
+    if ((priority < osPriorityIdle) || (priority > osPriorityISR)) {
+        return NULL;
+    }
+
+    thread = (os_thread_t *)osPosixObjectAlloc(cb_mem, cb_size, sizeof(os_thread_t), &flags);
+    if (thread == NULL) {
+        return NULL;
+    }
+    thread->id = osPosixIdThread;
+    thread->state = osPosixThreadReady;
+    thread->flags = flags;
+    thread->attr = (uint8_t)(attr_bits & osThreadJoinable);
+    thread->name = name;
+    thread->priority = (int8_t)priority;
+    thread->stack_size = stack_size;
+    thread->func = func;
+    thread->argument = argument;
+    posix_core_cond_init(&thread->cond);
+
+    host_size = (size_t)stack_size + OS_POSIX_STACK_MARGIN;
+    if (host_size < (size_t)PTHREAD_STACK_MIN) {
+        host_size = PTHREAD_STACK_MIN;
+    }
+    pthread_attr_init(&thread_attr);
+    pthread_attr_setdetachstate(&thread_attr, PTHREAD_CREATE_DETACHED);
+    pthread_attr_setstacksize(&thread_attr, host_size);
+
+    posix_core_lock();
+    ThreadActiveAdd(thread);
+    if (pthread_create(&thread->pthread, &thread_attr, ThreadEntry, thread) != 0) {
+        ThreadActiveRemove(thread);
+        posix_core_unlock();
+        pthread_attr_destroy(&thread_attr);
+        ThreadFree(thread);
+        return NULL;
+    }
+    posix_core_unlock();
+    pthread_attr_destroy(&thread_attr);
+
+    return thread;
+}
+
+const char *osThreadGetName(osThreadId_t thread_id)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+
+    if (posix_in_irq() || (thread == NULL)) {
+        return NULL;
+    }
+    return thread->name;
+}
+
+osThreadId_t osThreadGetId(void)
+{
+    return osPosixThreadCurrent;
+}
+
+osThreadState_t osThreadGetState(osThreadId_t thread_id)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+
+    if (posix_in_irq() || (thread == NULL)) {
+        return osThreadError;
+    }
+    return (osThreadState_t)(thread->state & 0x0FU);
+}
+
+uint32_t osThreadGetStackSize(osThreadId_t thread_id)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+
+    if (posix_in_irq() || (thread == NULL)) {
+        return 0U;
+    }
+    return thread->stack_size;
+}
+
+/* The space left of the stack size of the thread, the host C library uses
+ * part of the stack margin before it uses the stack of the thread */
+uint32_t osThreadGetStackSpace(osThreadId_t thread_id)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+    const uint32_t *stack;
+    uint32_t space;
+    uint32_t used;
+
+    if (posix_in_irq() || (thread == NULL) || (thread->stack_mem == NULL)) {
+        return 0U;
+    }
+
+    stack = (const uint32_t *)thread->stack_mem;
+    for (space = 0U; space < thread->stack_host; space += sizeof(uint32_t)) {
+        if (*stack++ != osPosixStackMagicWord) {
+            break;
+        }
+    }
+    used = thread->stack_host - space;
+    return (used < thread->stack_size) ? (thread->stack_size - used) : 0U;
+}
+
+osStatus_t osThreadSetPriority(osThreadId_t thread_id, osPriority_t priority)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if ((thread == NULL) || (priority < osPriorityIdle) || (priority > osPriorityISR)) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if (thread->state == osPosixThreadTerminated) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    // Only orders the waiting threads, the host schedules the threads
+    thread->priority = (int8_t)priority;
+    posix_core_unlock();
+
+    return osOK;
+}
+
+osPriority_t osThreadGetPriority(osThreadId_t thread_id)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+
+    if (posix_in_irq() || (thread == NULL) || (thread->state == osPosixThreadTerminated)) {
+        return osPriorityError;
+    }
+    return (osPriority_t)thread->priority;
+}
+
+osStatus_t osThreadYield(void)
+{
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    sched_yield();
+    return osOK;
+}
+
+// The host can't stop another thread, a thread can only suspend itself
+osStatus_t osThreadSuspend(osThreadId_t thread_id)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (thread == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if ((thread != osPosixThreadCurrent) || !osPosixThreadCanWait()) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    osPosixThreadWait(NULL, osPosixThreadBlocked, osPosixWaitForever);
+    posix_core_unlock();
+
+    return osOK;
+}
+
+osStatus_t osThreadResume(osThreadId_t thread_id)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (thread == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if (thread->state != osPosixThreadBlocked) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    osPosixThreadWakeup(thread, osOK);
+    posix_core_unlock();
+
+    return osOK;
+}
+
+osStatus_t osThreadDetach(osThreadId_t thread_id)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (thread == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if ((thread->attr & osThreadJoinable) == 0U) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    thread->attr &= ~osThreadJoinable;
+    if ((thread->state == osPosixThreadTerminated) && (thread->exit_list == NULL)) {
+        ThreadFree(thread);
+    }
+    posix_core_unlock();
+
+    return osOK;
+}
+
+osStatus_t osThreadJoin(osThreadId_t thread_id)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (thread == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if ((thread == osPosixThreadCurrent) || ((thread->attr & osThreadJoinable) == 0U) ||
+            (thread->exit_list != NULL)) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    if (thread->state != osPosixThreadTerminated) {
+        if (!osPosixThreadCanWait()) {
+            posix_core_unlock();
+            return osErrorResource;
+        }
+        osPosixThreadWait(&thread->exit_list, osRtxThreadWaitingJoin, osPosixWaitForever);
+    }
+    ThreadFree(thread);
+    posix_core_unlock();
+
+    return osOK;
+}
+
+__NO_RETURN void osThreadExit(void)
+{
+    os_thread_t *thread = osPosixThreadCurrent;
+
+    if (thread != NULL) {
+        thread_terminate_hook(thread);
+        // The main thread has no cleanup handler
+        if (thread->func == NULL) {
+            ThreadExit(thread);
+        }
+    }
+    pthread_exit(NULL);
+}
+
+/* The thread is cancelled, it terminates at its next cancellation point,
+ * which is any wait of the kernel or a blocking call of the host */
+osStatus_t osThreadTerminate(osThreadId_t thread_id)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (thread == NULL) {
+        return osErrorParameter;
+    }
+    if (thread == osPosixThreadCurrent) {
+        osThreadExit();
+    }
+
+    posix_core_lock();
+    if ((thread->state == osPosixThreadInactive) || (thread->state == osPosixThreadTerminated)) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    // The main thread can't be cancelled, it has no cleanup handler
+    if (thread->func == NULL) {
+        posix_core_unlock();
+        return osErrorParameter;
+    }
+    posix_core_unlock();
+
+    thread_terminate_hook(thread);
+
+    posix_core_lock();
+    pthread_cancel(thread->pthread);
+    // Wait until the thread has released its mutexes, unless in a critical section
+    if (osPosixThreadCanWait() && (thread->state != osPosixThreadTerminated)) {
+        osPosixThreadWait(&thread->exit_list, osRtxThreadWaitingJoin, osPosixWaitForever);
+        if ((osPosixThreadCurrent->wait_value != 0U) && ((thread->attr & osThreadJoinable) == 0U)) {
+            ThreadFree(thread);
+        }
+    }
+    posix_core_unlock();
+
+    return osOK;
+}
+
+uint32_t osThreadGetCount(void)
+{
+    if (posix_in_irq()) {
+        return 0U;
+    }
+    return osPosixInfo.thread_count;
+}
+
+uint32_t osThreadEnumerate(osThreadId_t *thread_array, uint32_t array_items)
+{
+    os_thread_t *thread;
+    uint32_t count = 0U;
+
+    if (posix_in_irq() || (thread_array == NULL) || (array_items == 0U)) {
+        return 0U;
+    }
+
+    posix_core_lock();
+    for (thread = osPosixInfo.thread_list; (thread != NULL) && (count < array_items); thread = thread->thread_next) {
+        thread_array[count++] = thread;
+    }
+    posix_core_unlock();
+
+    return count;
+}
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+{
+    os_thread_t *thread = ThreadValidate(thread_id);
+    uint32_t thread_flags;
+    uint32_t wait_flags;
+
+    if ((thread == NULL) || ((flags & osFlagsError) != 0U)) {
+        return osFlagsErrorParameter;
+    }
+
+    posix_core_lock();
+    if (thread->state == osPosixThreadTerminated) {
+        posix_core_unlock();
+        return osFlagsErrorResource;
+    }
+    thread->thread_flags |= flags;
+    thread_flags = thread->thread_flags;
+    if (thread->waiting && (thread->state == osRtxThreadWaitingThreadFlags)) {
+        wait_flags = ThreadFlagsCheck(thread, thread->wait_flags, thread->flags_options);
+        if (wait_flags != 0U) {
+            thread->wait_value = wait_flags;
+            osPosixThreadWakeup(thread, osOK);
+        }
+    }
+    posix_core_unlock();
+
+    return thread_flags;
+}
+
+uint32_t osThreadFlagsClear(uint32_t flags)
+{
+    os_thread_t *thread = osPosixThreadCurrent;
+    uint32_t thread_flags;
+
+    if (posix_in_irq()) {
+        return osFlagsErrorISR;
+    }
+    if ((thread == NULL) || ((flags & osFlagsError) != 0U)) {
+        return osFlagsErrorParameter;
+    }
+
+    posix_core_lock();
+    thread_flags = thread->thread_flags;
+    thread->thread_flags &= ~flags;
+    posix_core_unlock();
+
+    return thread_flags;
+}
+
+uint32_t osThreadFlagsGet(void)
+{
+    os_thread_t *thread = osPosixThreadCurrent;
+
+    if (posix_in_irq() || (thread == NULL)) {
+        return 0U;
+    }
+    return thread->thread_flags;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    os_thread_t *thread = osPosixThreadCurrent;
+    uint32_t thread_flags;
+
+    if (posix_in_irq()) {
+        return osFlagsErrorISR;
+    }
+    if ((thread == NULL) || ((flags & osFlagsError) != 0U)) {
+        return osFlagsErrorParameter;
+    }
+
+    posix_core_lock();
+    thread_flags = ThreadFlagsCheck(thread, flags, options);
+    if (thread_flags == 0U) {
+        if ((timeout != 0U) && osPosixThreadCanWait()) {
+            thread->wait_flags = flags;
+            thread->flags_options = (uint8_t)options;
+            if (osPosixThreadWait(NULL, osRtxThreadWaitingThreadFlags, osPosixDeadline(timeout)) == osOK) {
+                thread_flags = thread->wait_value;
+            } else {
+                thread_flags = osFlagsErrorTimeout;
+            }
+        } else {
+            thread_flags = osFlagsErrorResource;
+        }
+    }
+    posix_core_unlock();
+
+    return thread_flags;
+}
@@ -0,0 +1,239 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "posix_lib.h"
+
+//  ==== Helper functions ====
+
+static os_timer_t *TimerValidate(osTimerId_t timer_id)
+{
+    os_timer_t *timer = (os_timer_t *)timer_id;
+
+    if ((timer == NULL) || (timer->id != osPosixIdTimer)) {
+        return NULL;
+    }
+    return timer;
+}
+
+// Add a timer to the running timers, after the ones with the same expiry
+static void TimerInsert(os_timer_t *timer)
+{
+    os_timer_t **prev = &osPosixInfo.timer_list;
+
+    while ((*prev != NULL) && ((*prev)->due <= timer->due)) {
+        prev = &(*prev)->next;
+    }
+    timer->next = *prev;
+    *prev = timer;
+    timer->state = osPosixTimerRunning;
+}
+
+static void TimerRemove(os_timer_t *timer)
+{
+    os_timer_t **prev = &osPosixInfo.timer_list;
+
+    while ((*prev != NULL) && (*prev != timer)) {
+        prev = &(*prev)->next;
+    }
+    if (*prev != NULL) {
+        *prev = timer->next;
+    }
+    timer->next = NULL;
+    timer->state = osPosixTimerStopped;
+}
+
+// Runs the callbacks of the expired timers, without the core lock
+static void TimerThread(void *argument)
+{
+    os_timer_t *timer;
+    osTimerFunc_t func;
+    void *arg;
+
+    (void)argument;
+
+    posix_core_lock();
+    for (;;) {
+        timer = osPosixInfo.timer_list;
+        if (timer == NULL) {
+            osPosixThreadWait(&osPosixInfo.timer_wait, osRtxThreadWaitingDelay, osPosixWaitForever);
+            continue;
+        }
+        if (timer->due > posix_time_us()) {
+            osPosixThreadWait(&osPosixInfo.timer_wait, osRtxThreadWaitingDelay, timer->due);
+            continue;
+        }
+
+        TimerRemove(timer);
+        if (timer->type == osTimerPeriodic) {
+            timer->due += (uint64_t)timer->load * 1000U;
+            TimerInsert(timer);
+        }
+        func = timer->func;
+        arg = timer->arg;
+
+        posix_core_unlock();
+        func(arg);
+        posix_core_lock();
+    }
+}
+
+//  ==== Library functions ====
+
+void osPosixTimerWakeup(void)
+{
+    if (osPosixInfo.timer_wait != NULL) {
+        osPosixThreadWakeup(osPosixInfo.timer_wait, osOK);
+    }
+}
+
+int32_t osPosixTimerSetup(void)
+{
+    osThreadAttr_t attr = {
+        .name = "timer_thread",
+        .priority = osPriorityHigh,
+        .stack_size = OS_TIMER_THREAD_STACK_SIZE,
+    };
+
+    osPosixInfo.timer_thread = (os_thread_t *)osThreadNew(TimerThread, NULL, &attr);
+    if (osPosixInfo.timer_thread == NULL) {
+        return (int32_t)osError;
+    }
+    return (int32_t)osOK;
+}
+
+//  ==== Public API ====
+
+osTimerId_t osTimerNew(osTimerFunc_t func, osTimerType_t type, void *argument, const osTimerAttr_t *attr)
+{
+    os_timer_t *timer;
+    const char *name = NULL;
+    void *cb_mem = NULL;
+    uint32_t cb_size = 0U;
+    uint8_t flags;
+
+    if (posix_in_irq() || (func == NULL) || ((type != osTimerOnce) && (type != osTimerPeriodic))) {
+        return NULL;
+    }
+
+    if (attr != NULL) {
+        name    = attr->name;
+        cb_mem  = attr->cb_mem;
+        cb_size = attr->cb_size;
+    }
+
+    timer = (os_timer_t *)osPosixObjectAlloc(cb_mem, cb_size, sizeof(os_timer_t), &flags);
+    if (timer == NULL) {
+        return NULL;
+    }
+    timer->id = osPosixIdTimer;
+    timer->state = osPosixTimerStopped;
+    timer->flags = flags;
+    timer->type = (uint8_t)type;
+    timer->name = name;
+    timer->func = func;
+    timer->arg = argument;
+
+    return timer;
+}
+
+const char *osTimerGetName(osTimerId_t timer_id)
+{
+    os_timer_t *timer = TimerValidate(timer_id);
+
+    if (posix_in_irq() || (timer == NULL)) {
+        return NULL;
+    }
+    return timer->name;
+}
+
+osStatus_t osTimerStart(osTimerId_t timer_id, uint32_t ticks)
+{
+    os_timer_t *timer = TimerValidate(timer_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if ((timer == NULL) || (ticks == 0U)) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if (timer->state == osPosixTimerRunning) {
+        TimerRemove(timer);
+    }
+    timer->load = ticks;
+    timer->due = posix_time_us() + (uint64_t)ticks * 1000U;
+    TimerInsert(timer);
+    osPosixTimerWakeup();
+    posix_core_unlock();
+
+    return osOK;
+}
+
+osStatus_t osTimerStop(osTimerId_t timer_id)
+{
+    os_timer_t *timer = TimerValidate(timer_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (timer == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if (timer->state != osPosixTimerRunning) {
+        posix_core_unlock();
+        return osErrorResource;
+    }
+    TimerRemove(timer);
+    posix_core_unlock();
+
+    return osOK;
+}
+
+uint32_t osTimerIsRunning(osTimerId_t timer_id)
+{
+    os_timer_t *timer = TimerValidate(timer_id);
+
+    if (posix_in_irq() || (timer == NULL)) {
+        return 0U;
+    }
+    return (timer->state == osPosixTimerRunning) ? 1U : 0U;
+}
+
+osStatus_t osTimerDelete(osTimerId_t timer_id)
+{
+    os_timer_t *timer = TimerValidate(timer_id);
+
+    if (posix_in_irq()) {
+        return osErrorISR;
+    }
+    if (timer == NULL) {
+        return osErrorParameter;
+    }
+
+    posix_core_lock();
+    if (timer->state == osPosixTimerRunning) {
+        TimerRemove(timer);
+    }
+    timer->id = osPosixIdInvalid;
+    timer->state = osPosixTimerInactive;
+    posix_core_unlock();
+
+    osPosixObjectFree(timer, timer->flags);
+
+    return osOK;
+}
@@ -187,7 +187,7 @@ Thread::State Thread::get_state() {
     _mutex.lock();
 
     if (_tid != NULL) {
-#if defined(MBED_OS_BACKEND_RTX5)
+#if defined(MBED_OS_BACKEND_RTX5) || defined(MBED_OS_BACKEND_POSIX)
         state = _obj_mem.state;
 #else
         state = osThreadGetState(_tid);
@@ -208,7 +208,7 @@ Thread::State Thread::get_state() {
         case osThreadRunning:
             user_state = Running;
             break;
-#if defined(MBED_OS_BACKEND_RTX5)
+#if defined(MBED_OS_BACKEND_RTX5) || defined(MBED_OS_BACKEND_POSIX)
         case osRtxThreadWaitingDelay:
             user_state = WaitingDelay;
             break;
@@ -0,0 +1,245 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2017 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef VALUEQUEUE_H
+#define VALUEQUEUE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "cmsis_os2.h"
+#include "mbed_rtos_storage.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "platform/NonCopyable.h"
+#include "mbed_rtos1_types.h"
+
+// Default of RTX_Config.h, which is not included by the RTOS headers
+#ifndef OS_ISR_FIFO_QUEUE
+#define OS_ISR_FIFO_QUEUE 16
+#endif
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+/**
+ * \defgroup rtos_ValueQueue ValueQueue class
+ * @{
+ */
+
+/** The ValueQueue class allow to send messages by value to a thread or interrupt service routine.
+ Unlike Queue, which passes pointers, and Mail, which pairs a Queue with a MemoryPool, the messages
+ are copied into the slots of the queue, so a message is sent with a single put and received with a
+ single get.
+  @tparam  T         data type of a single message element, copied with memcpy. Keep it small and
+                     without constructors, destructors or pointers to owned data.
+  @tparam  queue_sz  maximum number of messages in queue.
+
+ @note
+ Memory considerations: The queue data store and control structures will be created on current thread's stack,
+ both for the mbed OS and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
+*/
+template<typename T, uint32_t queue_sz>
+class ValueQueue : private mbed::NonCopyable<ValueQueue<T, queue_sz> > {
+public:
+    /** Create and initialize a message ValueQueue.
+     *
+     * @note You cannot call this function from ISR context.
+    */
+    ValueQueue() {
+        memset(&_obj_mem, 0, sizeof(_obj_mem));
+        osMessageQueueAttr_t attr = { 0 };
+        attr.mq_mem = _queue_mem;
+        attr.mq_size = sizeof(_queue_mem);
+        attr.cb_mem = &_obj_mem;
+        attr.cb_size = sizeof(_obj_mem);
+        _id = osMessageQueueNew(queue_sz, sizeof(T), &attr);
+        MBED_ASSERT(_id);
+    }
+
+    /** ValueQueue destructor
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    ~ValueQueue() {
+        osMessageQueueDelete(_id);
+    }
+
+    /** Check if the queue is empty
+     *
+     * @return True if the queue is empty, false if not
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool empty() const {
+        return osMessageQueueGetCount(_id) == 0;
+    }
+
+    /** Check if the queue is full
+     *
+     * @return True if the queue is full, false if not
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool full() const {
+        return osMessageQueueGetSpace(_id) == 0;
+    }
+
+    /** Get the number of messages in the queue
+     *
+     * @return Number of queued messages
+     *
+     * @note You may call this function from ISR context.
+     */
+    uint32_t count() const {
+        return osMessageQueueGetCount(_id);
+    }
+
+    /** Put a copy of a message in the queue.
+      @param   data      message to copy into the queue.
+      @param   millisec  timeout value or 0 in case of no time-out. (default: 0)
+      @param   prio      priority value or 0 in case of default. (default: 0)
+      @return  status code that indicates the execution status of the function:
+               @a osOK the message has been put into the queue.
+               @a osErrorTimeout the message could not be put into the queue in the given time.
+               @a osErrorResource not enough space in the queue.
+               @a osErrorParameter internal error or non-zero timeout specified in an ISR.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+    */
+    osStatus put(const T &data, uint32_t millisec=0, uint8_t prio=0) {
+        return osMessageQueuePut(_id, &data, prio, millisec);
+    }
+
+    /** Get a message or wait for a message from the queue. Messages are retrieved in a descending priority order or
+        first in first out when the priorities are the same.
+      @param   data      message copied from the queue.
+      @param   millisec  timeout value or 0 in case of no time-out. (default: osWaitForever).
+      @return  status code that indicates the execution status of the function:
+               @a osOK the message has been copied to data.
+               @a osErrorTimeout no message has arrived during the given timeout period.
+               @a osErrorResource no message is available in the queue and no timeout was specified.
+               @a osErrorParameter a parameter is invalid or outside of a permitted range.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+    */
+    osStatus get(T &data, uint32_t millisec=osWaitForever) {
+        return osMessageQueueGet(_id, &data, NULL, millisec);
+    }
+
+    /** Put a copy of a message in the queue if there is space, without waiting.
+      @param   data      message to copy into the queue.
+      @return  true if the message has been put into the queue, false if the queue is full.
+
+      @note You may call this function from ISR context.
+    */
+    bool try_put(const T &data) {
+        return osMessageQueuePut(_id, &data, 0, 0) == osOK;
+    }
+
+    /** Get a message from the queue if there is one, without waiting.
+      @param   data      message copied from the queue.
+      @return  true if a message has been copied to data, false if the queue is empty.
+
+      @note You may call this function from ISR context.
+    */
+    bool try_get(T &data) {
+        return osMessageQueueGet(_id, &data, NULL, 0) == osOK;
+    }
+
+    /** Put copies of several messages in the queue.
+
+      Waits for space for the first message, then puts as many of the
+      others as fit without waiting. Each message is put as by put(), so a
+      higher priority thread waiting for the messages may run before the
+      rest of the batch is put.
+
+      @param   data      messages to copy into the queue.
+      @param   count     number of messages.
+      @param   millisec  timeout value or 0 in case of no time-out. (default: 0)
+      @param   prio      priority value or 0 in case of default. (default: 0)
+      @return  number of messages put into the queue.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+      In ISR context, every message posts to the RTOS ISR queue, which overflows with a fatal
+      error beyond OS_ISR_FIFO_QUEUE entries, so at most OS_ISR_FIFO_QUEUE messages are put.
+    */
+    uint32_t put_n(const T *data, uint32_t count, uint32_t millisec=0, uint8_t prio=0) {
+        count = batch_size(count);
+        if (count == 0 || osMessageQueuePut(_id, &data[0], prio, millisec) != osOK) {
+            return 0;
+        }
+        uint32_t i;
+        for (i = 1; i < count; i++) {
+            if (osMessageQueuePut(_id, &data[i], prio, 0) != osOK) {
+                break;
+            }
+        }
+        return i;
+    }
+
+    /** Get several messages from the queue.
+
+      Waits for the first message, then gets as many of the others as
+      are available without waiting.
+
+      @param   data      buffer for the messages copied from the queue.
+      @param   count     size of the buffer in messages.
+      @param   millisec  timeout value or 0 in case of no time-out. (default: osWaitForever).
+      @return  number of messages copied to data.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+      As for put_n, at most OS_ISR_FIFO_QUEUE messages are got in ISR context.
+    */
+    uint32_t get_n(T *data, uint32_t count, uint32_t millisec=osWaitForever) {
+        count = batch_size(count);
+        if (count == 0 || osMessageQueueGet(_id, &data[0], NULL, millisec) != osOK) {
+            return 0;
+        }
+        uint32_t i;
+        for (i = 1; i < count; i++) {
+            if (osMessageQueueGet(_id, &data[i], NULL, 0) != osOK) {
+                break;
+            }
+        }
+        return i;
+    }
+
+private:
+    static uint32_t batch_size(uint32_t count) {
+        if (count > OS_ISR_FIFO_QUEUE && core_util_is_isr_active()) {
+            return OS_ISR_FIFO_QUEUE;
+        }
+        return count;
+    }
+
+    // RTX keeps messages 4 byte aligned after a message header
+    static const uint32_t msg_mem_sz = ((sizeof(T) + 3) & ~3) + sizeof(mbed_rtos_storage_message_t);
+
+    osMessageQueueId_t            _id;
+    uint32_t                      _queue_mem[queue_sz * msg_mem_sz / sizeof(uint32_t)];
+    mbed_rtos_storage_msg_queue_t _obj_mem;
+};
+/** @}*/
+/** @}*/
+
+}
+#endif
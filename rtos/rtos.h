@@ -34,6 +34,7 @@
 #include "rtos/Mail.h"
 #include "rtos/MemoryPool.h"
 #include "rtos/Queue.h"
+#include "rtos/ValueQueue.h"
 #include "rtos/EventFlags.h"
 #include "rtos/ConditionVariable.h"
 
@@ -0,0 +1,132 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PINNAMES_H
+#define MBED_PINNAMES_H
+
+#include "cmsis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    PIN_INPUT,
+    PIN_OUTPUT
+} PinDirection;
+
+#define PORT_SHIFT  5
+
+typedef enum {
+/* Virtual GPIO pins, the value written to a pin is read back and
+ * raises the interrupts of the pin, which loops outputs back to inputs */
+/* GPIO0 */
+    P0_0 = 0,
+    P0_1 = 1,
+    P0_2 = 2,
+    P0_3 = 3,
+    P0_4 = 4,
+    P0_5 = 5,
+    P0_6 = 6,
+    P0_7 = 7,
+    P0_8 = 8,
+    P0_9 = 9,
+    P0_10 = 10,
+    P0_11 = 11,
+    P0_12 = 12,
+    P0_13 = 13,
+    P0_14 = 14,
+    P0_15 = 15,
+
+/* GPIO1 */
+    P1_0 = 16,
+    P1_1 = 17,
+    P1_2 = 18,
+    P1_3 = 19,
+    P1_4 = 20,
+    P1_5 = 21,
+    P1_6 = 22,
+    P1_7 = 23,
+    P1_8 = 24,
+    P1_9 = 25,
+    P1_10 = 26,
+    P1_11 = 27,
+    P1_12 = 28,
+    P1_13 = 29,
+    P1_14 = 30,
+    P1_15 = 31,
+
+/* Arduino Connector Namings */
+    D0 = P0_0,
+    D1 = P0_1,
+    D2 = P0_2,
+    D3 = P0_3,
+    D4 = P0_4,
+    D5 = P0_5,
+    D6 = P0_6,
+    D7 = P0_7,
+    D8 = P0_8,
+    D9 = P0_9,
+    D10 = P0_10,
+    D11 = P0_11,
+    D12 = P0_12,
+    D13 = P0_13,
+    D14 = P0_14,
+    D15 = P0_15,
+
+    LED1 = P1_0,
+    LED2 = P1_1,
+    LED3 = P1_2,
+    LED4 = P1_3,
+
+    SW1 = P1_4,
+    SW2 = P1_5,
+
+/* Serial ports, the console is stdin/stdout of the process (or a pseudo
+ * terminal with target.console-pty), the others are pseudo terminals */
+    UART_TX0 = 400,
+    UART_RX0 = 401,
+    UART_TX1 = 402,
+    UART_RX1 = 403,
+    UART_TX2 = 404,
+    UART_RX2 = 405,
+    UART_TX3 = 406,
+    UART_RX3 = 407,
+
+    USBTX = UART_TX0,
+    USBRX = UART_RX0,
+    STDIO_UART_TX = USBTX,
+    STDIO_UART_RX = USBRX,
+    SERIAL_TX = USBTX,
+    SERIAL_RX = USBRX,
+
+    // Not connected
+    NC = (int)0xFFFFFFFF
+} PinName;
+
+typedef enum {
+    PullUp = 2,
+    PullDown = 1,
+    PullNone = 0,
+    Repeater = 3,
+    OpenDrain = 4,
+    PullDefault = PullNone
+} PinMode;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
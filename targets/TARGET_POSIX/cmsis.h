@@ -0,0 +1,50 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CMSIS_H
+#define MBED_CMSIS_H
+
+#include <stdint.h>
+#include "posix_core.h"
+
+/* The subset of the CMSIS core functions used by mbed OS, on the emulated
+ * core of the native POSIX target, see posix_core.h.
+ */
+
+#define __INLINE            inline
+#define __STATIC_INLINE     static inline
+
+#define __I                 volatile const
+#define __O                 volatile
+#define __IO                volatile
+
+// No exclusive access instructions, atomics use critical sections
+#define __EXCLUSIVE_ACCESS  0U
+
+#define __disable_irq()     posix_disable_irq()
+#define __enable_irq()      posix_enable_irq()
+#define __get_PRIMASK()     posix_get_primask()
+// Any exception number while an interrupt handler runs
+#define __get_IPSR()        ((uint32_t)posix_in_irq() << 4)
+
+#define __NOP()             __asm__ volatile ("" ::: "memory")
+#define __DMB()             __sync_synchronize()
+#define __DSB()             __sync_synchronize()
+#define __ISB()             __sync_synchronize()
+#define __WFI()             posix_wait_for_interrupt()
+#define __WFE()             posix_wait_for_interrupt()
+#define __SEV()
+
+#endif
@@ -0,0 +1,147 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "flash_api.h"
+#include "cmsis.h"
+
+#if DEVICE_FLASH
+
+#ifndef MBED_CONF_TARGET_FLASH_FILE
+#define MBED_CONF_TARGET_FLASH_FILE "mbed_flash.bin"
+#endif
+
+/* NOR flash emulated with a host file, which keeps its contents between runs.
+ * Erased bytes are 0xFF and programming can only clear bits.
+ *
+ * Addresses are checked as offsets from FLASH_START, which wrap around to
+ * out of range values below it.
+ */
+#define FLASH_START         0x00000000
+#define FLASH_SIZE          0x00100000
+#define FLASH_SECTOR_SIZE   0x1000
+#define FLASH_PAGE_SIZE     8
+
+static uint8_t *flash_mem;
+static uint32_t flash_users;
+
+int32_t flash_init(flash_t *obj)
+{
+    posix_core_lock();
+    if (flash_mem == NULL) {
+        int fd = open(MBED_CONF_TARGET_FLASH_FILE, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        struct stat st;
+        if ((fd < 0) || (fstat(fd, &st) != 0)) {
+            goto fail;
+        }
+        if ((st.st_size < FLASH_SIZE) && (ftruncate(fd, FLASH_SIZE) != 0)) {
+            close(fd);
+            goto fail;
+        }
+        void *mem = mmap(NULL, FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED) {
+            goto fail;
+        }
+        flash_mem = (uint8_t *)mem;
+        // The part added to the file is erased
+        if (st.st_size < FLASH_SIZE) {
+            memset(flash_mem + st.st_size, 0xFF, FLASH_SIZE - st.st_size);
+        }
+    }
+    flash_users++;
+    obj->mem = flash_mem;
+    posix_core_unlock();
+    return 0;
+
+fail:
+    posix_core_unlock();
+    return -1;
+}
+
+int32_t flash_free(flash_t *obj)
+{
+    posix_core_lock();
+    if (obj->mem != NULL) {
+        obj->mem = NULL;
+        if (--flash_users == 0) {
+            msync(flash_mem, FLASH_SIZE, MS_SYNC);
+            munmap(flash_mem, FLASH_SIZE);
+            flash_mem = NULL;
+        }
+    }
+    posix_core_unlock();
+    return 0;
+}
+
+int32_t flash_erase_sector(flash_t *obj, uint32_t address)
+{
+    if ((address - FLASH_START >= FLASH_SIZE) || (address % FLASH_SECTOR_SIZE)) {
+        return -1;
+    }
+    memset(obj->mem + (address - FLASH_START), 0xFF, FLASH_SECTOR_SIZE);
+    return 0;
+}
+
+int32_t flash_read(flash_t *obj, uint32_t address, uint8_t *data, uint32_t size)
+{
+    if ((size > FLASH_SIZE) || (address - FLASH_START > FLASH_SIZE - size)) {
+        return -1;
+    }
+    memcpy(data, obj->mem + (address - FLASH_START), size);
+    return 0;
+}
+
+int32_t flash_program_page(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size)
+{
+    if ((size > FLASH_SIZE) || (address - FLASH_START > FLASH_SIZE - size) ||
+            (address % FLASH_PAGE_SIZE) || (size % FLASH_PAGE_SIZE)) {
+        return -1;
+    }
+    uint8_t *mem = obj->mem + (address - FLASH_START);
+    for (uint32_t i = 0; i < size; i++) {
+        mem[i] &= data[i];
+    }
+    return 0;
+}
+
+uint32_t flash_get_sector_size(const flash_t *obj, uint32_t address)
+{
+    if (address - FLASH_START >= FLASH_SIZE) {
+        return MBED_FLASH_INVALID_SIZE;
+    }
+    return FLASH_SECTOR_SIZE;
+}
+
+uint32_t flash_get_page_size(const flash_t *obj)
+{
+    return FLASH_PAGE_SIZE;
+}
+
+uint32_t flash_get_start_address(const flash_t *obj)
+{
+    return FLASH_START;
+}
+
+uint32_t flash_get_size(const flash_t *obj)
+{
+    return FLASH_SIZE;
+}
+
+#endif
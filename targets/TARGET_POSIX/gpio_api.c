@@ -0,0 +1,72 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gpio_api.h"
+#include "mbed_assert.h"
+
+// Values of the virtual pins, outputs are looped back to the inputs
+static volatile uint8_t pin_values[GPIO_NUM];
+
+uint32_t gpio_set(PinName pin)
+{
+    MBED_ASSERT(pin != (PinName)NC);
+    return 1 << (pin % GPIO_NUM);
+}
+
+int gpio_is_connected(const gpio_t *obj)
+{
+    return obj->pin != (PinName)NC;
+}
+
+void gpio_init(gpio_t *obj, PinName pin)
+{
+    obj->pin = pin;
+    obj->direction = PIN_INPUT;
+    if (pin == (PinName)NC) {
+        return;
+    }
+    MBED_ASSERT(pin < GPIO_NUM);
+}
+
+void gpio_mode(gpio_t *obj, PinMode mode)
+{
+    // The pins keep the last value written to them
+}
+
+void gpio_dir(gpio_t *obj, PinDirection direction)
+{
+    obj->direction = direction;
+}
+
+void gpio_write(gpio_t *obj, int value)
+{
+    MBED_ASSERT(obj->pin != (PinName)NC);
+    uint8_t new_value = value ? 1 : 0;
+
+    posix_core_lock();
+    uint8_t old_value = pin_values[obj->pin];
+    pin_values[obj->pin] = new_value;
+    posix_core_unlock();
+
+    if (new_value != old_value) {
+        posix_gpio_edge(obj->pin, new_value);
+    }
+}
+
+int gpio_read(gpio_t *obj)
+{
+    MBED_ASSERT(obj->pin != (PinName)NC);
+    return pin_values[obj->pin];
+}
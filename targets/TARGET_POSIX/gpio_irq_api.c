@@ -0,0 +1,84 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gpio_irq_api.h"
+#include "mbed_assert.h"
+
+static gpio_irq_handler irq_handler;
+static gpio_irq_t *pin_irqs[GPIO_NUM];
+
+int gpio_irq_init(gpio_irq_t *obj, PinName pin, gpio_irq_handler handler, uint32_t id)
+{
+    if (pin == (PinName)NC) {
+        return -1;
+    }
+    MBED_ASSERT(pin < GPIO_NUM);
+
+    obj->pin = pin;
+    obj->id = id;
+    obj->rise = 0;
+    obj->fall = 0;
+    obj->enabled = 1;
+
+    posix_core_lock();
+    irq_handler = handler;
+    pin_irqs[pin] = obj;
+    posix_core_unlock();
+    return 0;
+}
+
+void gpio_irq_free(gpio_irq_t *obj)
+{
+    posix_core_lock();
+    if (pin_irqs[obj->pin] == obj) {
+        pin_irqs[obj->pin] = NULL;
+    }
+    obj->id = 0;
+    posix_core_unlock();
+}
+
+void gpio_irq_set(gpio_irq_t *obj, gpio_irq_event event, uint32_t enable)
+{
+    if (event == IRQ_RISE) {
+        obj->rise = enable ? 1 : 0;
+    } else if (event == IRQ_FALL) {
+        obj->fall = enable ? 1 : 0;
+    }
+}
+
+void gpio_irq_enable(gpio_irq_t *obj)
+{
+    obj->enabled = 1;
+}
+
+void gpio_irq_disable(gpio_irq_t *obj)
+{
+    obj->enabled = 0;
+}
+
+void posix_gpio_edge(PinName pin, int value)
+{
+    // The edge interrupt is taken right away by the core writing the pin
+    posix_irq_enter();
+    gpio_irq_t *obj = pin_irqs[pin];
+    if ((obj != NULL) && obj->enabled && (obj->id != 0)) {
+        if (value && obj->rise) {
+            irq_handler(obj->id, IRQ_RISE);
+        } else if (!value && obj->fall) {
+            irq_handler(obj->id, IRQ_FALL);
+        }
+    }
+    posix_irq_exit();
+}
@@ -0,0 +1,146 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "posix_core.h"
+
+static pthread_mutex_t core_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t core_once = PTHREAD_ONCE_INIT;
+static pthread_cond_t irq_cond;
+static uint32_t irq_count;
+
+// Per thread state of the emulated core
+static __thread uint32_t core_depth;
+static __thread uint32_t core_in_irq;
+static __thread uint8_t core_primask;
+
+static void core_init(void)
+{
+    posix_core_cond_init(&irq_cond);
+}
+
+void posix_core_lock(void)
+{
+    if (core_depth++ == 0) {
+        pthread_mutex_lock(&core_mutex);
+    }
+}
+
+void posix_core_unlock(void)
+{
+    if (--core_depth == 0) {
+        pthread_mutex_unlock(&core_mutex);
+    }
+}
+
+uint32_t posix_core_depth(void)
+{
+    return core_depth;
+}
+
+int posix_core_wait(pthread_cond_t *cond, const struct timespec *abstime)
+{
+    if (abstime == NULL) {
+        return pthread_cond_wait(cond, &core_mutex);
+    }
+    return pthread_cond_timedwait(cond, &core_mutex, abstime);
+}
+
+void posix_core_cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+void posix_core_lock_exit(void)
+{
+    // A thread cancelled in pthread_cond_wait() holds the mutex again
+    if (core_depth == 0) {
+        pthread_mutex_lock(&core_mutex);
+    }
+    core_depth = 1;
+    core_primask = 0;
+}
+
+void posix_irq_enter(void)
+{
+    posix_core_lock();
+    core_in_irq++;
+}
+
+void posix_irq_exit(void)
+{
+    pthread_once(&core_once, core_init);
+    core_in_irq--;
+    irq_count++;
+    pthread_cond_broadcast(&irq_cond);
+    posix_core_unlock();
+}
+
+int posix_in_irq(void)
+{
+    return core_in_irq != 0;
+}
+
+void posix_disable_irq(void)
+{
+    // Nested critical sections disable interrupts again but enable them once
+    if (!core_primask) {
+        posix_core_lock();
+        core_primask = 1;
+    }
+}
+
+void posix_enable_irq(void)
+{
+    if (core_primask) {
+        core_primask = 0;
+        posix_core_unlock();
+    }
+}
+
+uint32_t posix_get_primask(void)
+{
+    return core_primask;
+}
+
+void posix_wait_for_interrupt(void)
+{
+    pthread_once(&core_once, core_init);
+    posix_core_lock();
+    // Like WFI, a pending interrupt wakes up the core even if interrupts are disabled
+    uint32_t count = irq_count;
+    while (irq_count == count) {
+        pthread_cond_wait(&irq_cond, &core_mutex);
+    }
+    posix_core_unlock();
+}
+
+uint64_t posix_time_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void posix_timespec(struct timespec *ts, uint64_t us)
+{
+    ts->tv_sec = us / 1000000;
+    ts->tv_nsec = (us % 1000000) * 1000;
+}
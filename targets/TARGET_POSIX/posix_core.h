@@ -0,0 +1,103 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_POSIX_CORE_H
+#define MBED_POSIX_CORE_H
+
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Emulation of the core for the native POSIX target.
+ *
+ * Peripheral interrupts are raised by host threads, one for each peripheral
+ * which needs them. A single core lock serializes the interrupt handlers with
+ * the code running with interrupts disabled and with the RTOS kernel, which
+ * keeps the behaviour of the single core targets for the drivers.
+ *
+ * The core lock can be taken recursively by a thread, a handler runs with
+ * the lock taken and can take it again, like nested critical sections.
+ */
+
+/** Take the core lock, waits for the running interrupt handler */
+void posix_core_lock(void);
+
+/** Release the core lock taken with posix_core_lock() */
+void posix_core_unlock(void);
+
+/** Number of times the calling thread holds the core lock */
+uint32_t posix_core_depth(void);
+
+/** Wait for a condition, releases the core lock while waiting
+ *
+ * The calling thread must hold the core lock once, the interrupts and the
+ * other threads run while it waits.
+ *
+ * @param cond      Condition initialized with posix_core_cond_init()
+ * @param abstime   Timeout as CLOCK_MONOTONIC time, NULL to wait forever
+ * @return 0 when signalled, ETIMEDOUT on timeout
+ */
+int posix_core_wait(pthread_cond_t *cond, const struct timespec *abstime);
+
+/** Initialize a condition to use with posix_core_wait() */
+void posix_core_cond_init(pthread_cond_t *cond);
+
+/** Take the core lock once for a thread which exits
+ *
+ * Drops the nested locks and the disabled interrupts of the thread, which may
+ * be cancelled in a critical section.
+ */
+void posix_core_lock_exit(void);
+
+/** Enter an interrupt handler from a peripheral thread */
+void posix_irq_enter(void);
+
+/** Leave an interrupt handler, wakes up the cores waiting for interrupts */
+void posix_irq_exit(void);
+
+/** Check if the calling thread runs an interrupt handler */
+int posix_in_irq(void);
+
+/** Disable interrupts for the calling thread, see __disable_irq() */
+void posix_disable_irq(void);
+
+/** Enable interrupts for the calling thread, see __enable_irq() */
+void posix_enable_irq(void);
+
+/** Interrupt mask of the calling thread, see __get_PRIMASK() */
+uint32_t posix_get_primask(void);
+
+/** Wait until the next interrupt handler has run, see __WFI() */
+void posix_wait_for_interrupt(void);
+
+/** Host time in microseconds, CLOCK_MONOTONIC */
+uint64_t posix_time_us(void);
+
+/** CLOCK_MONOTONIC time to use as timeout for posix_core_wait()
+ *
+ * @param ts    Timeout to set
+ * @param us    Absolute host time in microseconds, see posix_time_us()
+ */
+void posix_timespec(struct timespec *ts, uint64_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,265 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <errno.h>
+#include <termios.h>
+#include "serial_api.h"
+#include "mbed_error.h"
+#include "cmsis.h"
+
+#ifndef MBED_CONF_TARGET_CONSOLE_PTY
+#define MBED_CONF_TARGET_CONSOLE_PTY    0
+#endif
+
+/* The console UART is stdin/stdout of the process, the other UARTs are
+ * pseudo terminals which are opened on first use, a terminal program or a
+ * test host connects to the name printed on stderr.
+ *
+ * The interrupts of an UART are raised by a thread, which polls for received
+ * data while the RX interrupt is enabled. The TX interrupt is raised as long
+ * as it is enabled, writes to the host never fill the transmitter.
+ */
+
+typedef struct {
+    int fd_in;
+    int fd_out;
+    bool opened;
+    bool rx_closed;
+    uart_irq_handler handler;
+    uint32_t id;
+    bool rx_irq;
+    bool tx_irq;
+    bool thread_started;
+    pthread_t thread;
+    int wake[2];
+} uart_state_t;
+
+static uart_state_t uarts[UART_NUM];
+
+int stdio_uart_inited = 0;
+serial_t stdio_uart;
+
+static UARTName pin_to_uart(PinName tx, PinName rx)
+{
+    PinName pin = (tx != (PinName)NC) ? tx : rx;
+    if ((pin < UART_TX0) || (pin > UART_RX3)) {
+        error("Serial pinout mapping failed");
+    }
+    return (UARTName)((pin - UART_TX0) / 2);
+}
+
+static void uart_open_pty(uart_state_t *uart, UARTName name)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0)) {
+        error("Serial pseudo terminal failed, errno=%d\r\n", errno);
+    }
+    const char *slave_name = ptsname(master);
+
+    /* The slave side is kept open, so that the UART does not read EIO while
+     * no terminal program is connected, and it is raw like a serial port. */
+    int slave = open(slave_name, O_RDWR | O_NOCTTY);
+    struct termios tio;
+    if ((slave >= 0) && (tcgetattr(slave, &tio) == 0)) {
+        cfmakeraw(&tio);
+        tcsetattr(slave, TCSANOW, &tio);
+    }
+
+    fprintf(stderr, "UART_%d: %s\n", (int)name, slave_name);
+    uart->fd_in = master;
+    uart->fd_out = master;
+}
+
+void serial_init(serial_t *obj, PinName tx, PinName rx)
+{
+    UARTName name = pin_to_uart(tx, rx);
+    uart_state_t *uart = &uarts[name];
+
+    posix_core_lock();
+    if (!uart->opened) {
+        if ((name == STDIO_UART) && !MBED_CONF_TARGET_CONSOLE_PTY) {
+            uart->fd_in = STDIN_FILENO;
+            uart->fd_out = STDOUT_FILENO;
+        } else {
+            uart_open_pty(uart, name);
+        }
+        uart->opened = true;
+    }
+    posix_core_unlock();
+
+    obj->uart = name;
+    obj->fd_in = uart->fd_in;
+    obj->fd_out = uart->fd_out;
+
+    if (name == STDIO_UART) {
+        stdio_uart_inited = 1;
+        memcpy(&stdio_uart, obj, sizeof(serial_t));
+    }
+}
+
+void serial_free(serial_t *obj)
+{
+    uart_state_t *uart = &uarts[obj->uart];
+
+    posix_core_lock();
+    uart->id = 0;
+    posix_core_unlock();
+}
+
+void serial_baud(serial_t *obj, int baudrate)
+{
+    // The host transfers at its own speed
+}
+
+void serial_format(serial_t *obj, int data_bits, SerialParity parity, int stop_bits)
+{
+}
+
+static void *uart_irq_thread(void *arg)
+{
+    uart_state_t *uart = (uart_state_t *)arg;
+    char buf[16];
+
+    while (true) {
+        posix_core_lock();
+        bool rx = uart->rx_irq && !uart->rx_closed;
+        bool tx = uart->tx_irq;
+        posix_core_unlock();
+
+        struct pollfd fds[2] = {
+            { uart->wake[0], POLLIN, 0 },
+            { uart->fd_in, rx ? POLLIN : 0, 0 },
+        };
+        poll(fds, 2, tx ? 0 : -1);
+
+        if (fds[0].revents & POLLIN) {
+            while (read(uart->wake[0], buf, sizeof(buf)) > 0);
+        }
+        bool rx_ready = (fds[1].revents & POLLIN) != 0;
+        if (!rx_ready && (fds[1].revents & (POLLHUP | POLLERR | POLLNVAL))) {
+            // End of input, no more data to receive
+            posix_core_lock();
+            uart->rx_closed = true;
+            posix_core_unlock();
+        }
+        if (!rx_ready && !tx) {
+            continue;
+        }
+
+        posix_irq_enter();
+        if (rx_ready && uart->rx_irq && uart->id) {
+            uart->handler(uart->id, RxIrq);
+        }
+        if (tx && uart->tx_irq && uart->id) {
+            uart->handler(uart->id, TxIrq);
+        }
+        posix_irq_exit();
+    }
+    return NULL;
+}
+
+void serial_irq_handler(serial_t *obj, uart_irq_handler handler, uint32_t id)
+{
+    uart_state_t *uart = &uarts[obj->uart];
+
+    posix_core_lock();
+    uart->handler = handler;
+    uart->id = id;
+    posix_core_unlock();
+}
+
+void serial_irq_set(serial_t *obj, SerialIrq irq, uint32_t enable)
+{
+    uart_state_t *uart = &uarts[obj->uart];
+
+    posix_core_lock();
+    if (irq == RxIrq) {
+        uart->rx_irq = enable ? true : false;
+    } else {
+        uart->tx_irq = enable ? true : false;
+    }
+    if (!uart->thread_started) {
+        if ((pipe2(uart->wake, O_NONBLOCK | O_CLOEXEC) != 0) ||
+                (pthread_create(&uart->thread, NULL, uart_irq_thread, uart) != 0)) {
+            error("Serial interrupt thread failed\r\n");
+        }
+        uart->thread_started = true;
+    }
+    posix_core_unlock();
+
+    // Let the interrupt thread poll for the new set of interrupts
+    if (write(uart->wake[1], "", 1) < 0) {
+        // the pipe is full, the thread wakes up anyway
+    }
+}
+
+int serial_getc(serial_t *obj)
+{
+    unsigned char c;
+    ssize_t ret;
+
+    while ((ret = read(obj->fd_in, &c, 1)) != 1) {
+        if ((ret == 0) || (errno != EINTR)) {
+            // End of input, like a disconnected serial line nothing is received
+            while (true) {
+                pause();
+            }
+        }
+    }
+    return c;
+}
+
+void serial_putc(serial_t *obj, int c)
+{
+    unsigned char ch = (unsigned char)c;
+
+    while ((write(obj->fd_out, &ch, 1) != 1) && (errno == EINTR));
+}
+
+int serial_readable(serial_t *obj)
+{
+    struct pollfd fds = { obj->fd_in, POLLIN, 0 };
+
+    return (poll(&fds, 1, 0) == 1) && (fds.revents & POLLIN);
+}
+
+int serial_writable(serial_t *obj)
+{
+    return 1;
+}
+
+void serial_clear(serial_t *obj)
+{
+}
+
+void serial_pinout_tx(PinName tx)
+{
+}
+
+void serial_break_set(serial_t *obj)
+{
+}
+
+void serial_break_clear(serial_t *obj)
+{
+}
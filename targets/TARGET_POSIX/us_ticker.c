@@ -0,0 +1,121 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdbool.h>
+#include "us_ticker_api.h"
+#include "mbed_error.h"
+#include "cmsis.h"
+
+/* The 1 MHz counter is the host monotonic clock, the compare interrupt is
+ * raised by a thread which sleeps until the compare time.
+ */
+
+static pthread_mutex_t ticker_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ticker_cond;
+static pthread_t ticker_thread;
+static bool ticker_inited;
+static bool ticker_armed;
+static uint64_t ticker_start;
+static uint64_t ticker_deadline;
+
+static void *ticker_irq_thread(void *arg)
+{
+    struct timespec ts;
+
+    pthread_mutex_lock(&ticker_mutex);
+    while (true) {
+        if (!ticker_armed) {
+            pthread_cond_wait(&ticker_cond, &ticker_mutex);
+            continue;
+        }
+        if (posix_time_us() < ticker_deadline) {
+            posix_timespec(&ts, ticker_deadline);
+            pthread_cond_timedwait(&ticker_cond, &ticker_mutex, &ts);
+            continue;
+        }
+        ticker_armed = false;
+
+        // The handler sets the next interrupt, which takes the ticker mutex
+        pthread_mutex_unlock(&ticker_mutex);
+        posix_irq_enter();
+        us_ticker_irq_handler();
+        posix_irq_exit();
+        pthread_mutex_lock(&ticker_mutex);
+    }
+    return NULL;
+}
+
+static void ticker_arm(uint64_t deadline)
+{
+    pthread_mutex_lock(&ticker_mutex);
+    ticker_deadline = deadline;
+    ticker_armed = true;
+    pthread_cond_signal(&ticker_cond);
+    pthread_mutex_unlock(&ticker_mutex);
+}
+
+void us_ticker_init(void)
+{
+    if (ticker_inited) {
+        return;
+    }
+    ticker_inited = true;
+    ticker_start = posix_time_us();
+
+    posix_core_cond_init(&ticker_cond);
+    if (pthread_create(&ticker_thread, NULL, ticker_irq_thread, NULL) != 0) {
+        error("us_ticker: thread create failed\r\n");
+    }
+}
+
+uint32_t us_ticker_read(void)
+{
+    return (uint32_t)(posix_time_us() - ticker_start);
+}
+
+void us_ticker_set_interrupt(timestamp_t timestamp)
+{
+    uint64_t now = posix_time_us();
+    int32_t delta = (int32_t)(timestamp - (uint32_t)(now - ticker_start));
+
+    // The time may have passed since the ticker layer has read it
+    ticker_arm(delta > 0 ? now + delta : now);
+}
+
+void us_ticker_fire_interrupt(void)
+{
+    ticker_arm(posix_time_us());
+}
+
+void us_ticker_disable_interrupt(void)
+{
+    pthread_mutex_lock(&ticker_mutex);
+    ticker_armed = false;
+    pthread_mutex_unlock(&ticker_mutex);
+}
+
+void us_ticker_clear_interrupt(void)
+{
+    // The interrupt is cleared when it is raised
+}
+
+const ticker_info_t* us_ticker_get_info(void)
+{
+    static const ticker_info_t info = {
+        1000000,    // 1 MHz
+        32          // 32 bit counter
+    };
+    return &info;
+}
@@ -0,0 +1,315 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2019 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Decoder for binary mbed-trace output, see mbed_trace_binary_mode_set()
+"""
+
+from __future__ import print_function
+import argparse
+import bisect
+import json
+import re
+import struct
+import sys
+
+# first byte of a binary frame, the rest of the line is escaped
+_MARKER = 0x1F
+_ESCAPE = 0x1B
+
+_LEVELS = {
+    0x10: "DBG ",
+    0x08: "INFO",
+    0x04: "WARN",
+    0x02: "ERR ",
+}
+
+# printf conversion, same subset as mbed_trace_conversion() in mbed_trace.c
+_CONVERSION = re.compile(
+    r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t|L)?(.)", re.S)
+
+_DICT_VERSION = 1
+
+# section flags used to pick the read-only sections
+_SHF_WRITE = 0x1
+_SHF_ALLOC = 0x2
+
+
+def _printable(byte):
+    return byte >= 0x20 and byte != 0x7F or byte in (0x09, 0x0A, 0x0D)
+
+
+class TraceDictionary(object):
+    """Strings of the application image, looked up by their address
+
+    Format strings and group names are identified in the frames by their
+    address, so the dictionary is the read-only data of the linked image.
+    """
+
+    def __init__(self, strings):
+        self.strings = sorted(strings)
+        self.addrs = [addr for addr, _ in self.strings]
+
+    @classmethod
+    def from_elf(cls, elf_file):
+        from elftools.elf.elffile import ELFFile
+
+        strings = []
+        for section in ELFFile(elf_file).iter_sections():
+            if section['sh_type'] != 'SHT_PROGBITS':
+                continue
+            flags = section['sh_flags']
+            if not flags & _SHF_ALLOC or flags & _SHF_WRITE:
+                continue
+            strings.extend(cls._strings(section['sh_addr'],
+                                        bytearray(section.data())))
+        return cls(strings)
+
+    @classmethod
+    def from_json(cls, json_file):
+        data = json.load(json_file)
+        if data.get("version") != _DICT_VERSION:
+            raise ValueError("unsupported dictionary version")
+        return cls([(addr, text) for addr, text in data["strings"]])
+
+    def to_json(self, json_file):
+        json.dump({"version": _DICT_VERSION, "strings": self.strings},
+                  json_file)
+
+    @staticmethod
+    def _strings(base, data):
+        """Zero terminated printable strings of data
+
+        Strings may be preceded by code or other constants in the same
+        section, so only the printable tail before each zero is kept.
+        Compilers merge string tails, so lookups can point inside a string.
+        """
+        end = data.find(b"\0")
+        while end >= 0:
+            start = end
+            while start > 0 and _printable(data[start - 1]):
+                start -= 1
+            if start < end:
+                text = data[start:end].decode("utf-8", "replace")
+                yield base + start, text
+            end = data.find(b"\0", end + 1)
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i < 0:
+            return None
+        start, text = self.strings[i]
+        # utf-8 may be shorter than the bytes, good enough for lookups
+        if addr - start >= len(text):
+            return None
+        return text[addr - start:]
+
+
+class Frame(object):
+    """Fields of one binary frame, unescaped"""
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def left(self):
+        return len(self.data) - self.pos
+
+    def byte(self):
+        if self.pos >= len(self.data):
+            raise IndexError("frame ends")
+        self.pos += 1
+        return self.data[self.pos - 1]
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self.byte()
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    def signed(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def double(self):
+        if self.left() < 8:
+            raise IndexError("frame ends")
+        self.pos += 8
+        return struct.unpack("<d", bytes(self.data[self.pos - 8:self.pos]))[0]
+
+    def string(self):
+        end = self.data.find(b"\0", self.pos)
+        if end < 0:
+            raise IndexError("frame ends")
+        text = self.data[self.pos:end].decode("utf-8", "replace")
+        self.pos = end + 1
+        return text
+
+
+def unescape(line):
+    data = bytearray()
+    escaped = False
+    for byte in bytearray(line):
+        if escaped:
+            data.append(byte ^ 0x20)
+            escaped = False
+        elif byte == _ESCAPE:
+            escaped = True
+        else:
+            data.append(byte)
+    return data
+
+
+def format_args(fmt, frame):
+    """printf fmt with the values of the frame, stop at first missing one"""
+    out = []
+    pos = 0
+    try:
+        for conv in _CONVERSION.finditer(fmt):
+            out.append(fmt[pos:conv.start()])
+            pos = conv.end()
+            flags, width, precision, _, kind = conv.groups()
+            if kind == "%":
+                out.append("%")
+                continue
+            if width == "*":
+                width = frame.signed()
+                if width < 0:
+                    flags += "-"
+                    width = -width
+                width = str(width)
+            if precision == "*":
+                precision = frame.signed()
+                precision = str(precision) if precision >= 0 else None
+            spec = "%" + flags + (width or "")
+            if precision is not None:
+                spec += "." + precision
+
+            if kind in "di":
+                out.append((spec + "d") % frame.signed())
+            elif kind in "uxX":
+                out.append((spec + kind.replace("u", "d")) % frame.varint())
+            elif kind == "o":
+                value = frame.varint()
+                text = ("%o" % value) if "#" not in flags or not value else ("0%o" % value)
+                out.append((spec.replace("#", "") + "s") % text)
+            elif kind == "c":
+                out.append((spec + "c") % chr(frame.varint() & 0xFF))
+            elif kind in "fFeEgG":
+                out.append((spec + kind) % frame.double())
+            elif kind in "aA":
+                # same digits as C, without the trailing zeros
+                text = re.sub(r"\.?0+p", "p", float.hex(frame.double()))
+                out.append((spec + "s") % (text if kind == "a" else text.upper()))
+            elif kind == "p":
+                out.append((spec + "s") % ("0x%x" % frame.varint()))
+            elif kind == "s":
+                out.append((spec + "s") % frame.string())
+            elif kind == "n":
+                pass
+            else:
+                # not understood by the target either
+                break
+        else:
+            out.append(fmt[pos:])
+    except IndexError:
+        # cut by the target when line buffer was full
+        pass
+    return "".join(out)
+
+
+def decode_frame(line, dictionary):
+    frame = Frame(unescape(line[1:]))
+    try:
+        level = frame.byte()
+        time = frame.varint()
+        fmt_addr = frame.varint()
+        grp_addr = frame.varint()
+    except IndexError:
+        return "<truncated frame>"
+    fmt = dictionary.lookup(fmt_addr)
+    grp = dictionary.lookup(grp_addr)
+    if grp is None:
+        grp = "0x%x" % grp_addr
+    if fmt is None:
+        text = "<unknown format 0x%x>" % fmt_addr
+    else:
+        text = format_args(fmt, frame)
+    return "%10u [%s][%-4s]: %s" % (time, _LEVELS.get(level, "    "), grp, text)
+
+
+def decode(lines, dictionary, output):
+    for line in lines:
+        line = line.rstrip(b"\n")
+        if line.endswith(b"\r"):
+            line = line[:-1]
+        if line[:1] == bytearray([_MARKER]):
+            output.write(decode_frame(line, dictionary) + "\n")
+        else:
+            # text lines, e.g. tr_cmdline() and printf
+            output.write(line.decode("utf-8", "replace") + "\n")
+        output.flush()
+
+
+def load_dictionary(path):
+    with open(path, "rb") as file_handle:
+        if file_handle.read(4) == b"\x7fELF":
+            file_handle.seek(0)
+            return TraceDictionary.from_elf(file_handle)
+    with open(path, "r") as file_handle:
+        return TraceDictionary.from_json(file_handle)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode binary mbed-trace output to text lines")
+    parser.add_argument("dictionary", metavar="ELF_OR_DICT",
+                        help="elf file of the application, or dictionary "
+                        "saved from it with --save")
+    parser.add_argument("input", nargs="?", default=None,
+                        help="captured trace output, stdin by default")
+    parser.add_argument("-s", "--save", metavar="DICT",
+                        help="save dictionary of the elf file and exit, so "
+                        "that the elf file is not needed for decoding")
+    parser.add_argument("-p", "--port", help="read traces from serial port")
+    parser.add_argument("-b", "--baudrate", type=int, default=9600,
+                        help="serial port baud rate, default: 9600")
+    args = parser.parse_args()
+
+    dictionary = load_dictionary(args.dictionary)
+    if args.save:
+        with open(args.save, "w") as file_handle:
+            dictionary.to_json(file_handle)
+        return
+
+    if args.port:
+        from serial import Serial
+        port = Serial(args.port, args.baudrate)
+        decode(iter(port.readline, b""), dictionary, sys.stdout)
+    elif args.input:
+        with open(args.input, "rb") as file_handle:
+            decode(file_handle, dictionary, sys.stdout)
+    else:
+        stdin = getattr(sys.stdin, "buffer", sys.stdin)
+        decode(iter(stdin.readline, b""), dictionary, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -30,11 +30,13 @@ except:
 
 #import module_copy_firefox
 from . import module_copy_mps2
+from . import module_copy_native_posix
 
 # Plugins used to reset certain platform
 from . import module_reset_mbed
 from . import module_reset_silabs
 from . import module_reset_mps2
+from . import module_reset_native_posix
 
 
 # Plugin registry instance
@@ -58,6 +60,8 @@ HOST_TEST_PLUGIN_REGISTRY.register_plugin(module_copy_mps2.load_plugin())
 HOST_TEST_PLUGIN_REGISTRY.register_plugin(module_reset_mps2.load_plugin())
 HOST_TEST_PLUGIN_REGISTRY.register_plugin(module_copy_silabs.load_plugin())
 HOST_TEST_PLUGIN_REGISTRY.register_plugin(module_reset_silabs.load_plugin())
+HOST_TEST_PLUGIN_REGISTRY.register_plugin(module_copy_native_posix.load_plugin())
+HOST_TEST_PLUGIN_REGISTRY.register_plugin(module_reset_native_posix.load_plugin())
 
 # TODO: extend plugin loading to files with name module_*.py loaded ad-hoc
 
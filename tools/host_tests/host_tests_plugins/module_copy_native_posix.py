@@ -0,0 +1,147 @@
+"""
+mbed SDK
+Copyright (c) 2019 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+from __future__ import print_function
+
+import os
+import pty
+import tty
+import atexit
+import select
+import shutil
+import threading
+from os.path import join, basename
+from subprocess import Popen, PIPE
+from time import sleep
+
+from .host_test_plugins import HostTestPluginBase
+
+
+class NativePosixTarget(object):
+    """ NATIVE_POSIX image running as a host process
+
+    The disk is the directory the image is copied to and run from. The
+    console of the image is relayed to a pseudo terminal linked as
+    <disk>/console, the serial port to give to the host test. The pseudo
+    terminal outlives the process, so a reset keeps the serial port open.
+    """
+    CONSOLE = 'console'
+
+    def __init__(self):
+        self.image = None
+        self.process = None
+        self.master = None
+        self.slave = None
+        atexit.register(self.stop)
+
+    def open_console(self, disk):
+        if self.master is None:
+            self.master, self.slave = pty.openpty()
+            tty.setraw(self.slave)
+        link = join(disk, self.CONSOLE)
+        if os.path.lexists(link):
+            os.remove(link)
+        os.symlink(os.ttyname(self.slave), link)
+
+    def start(self):
+        self.stop()
+        self.process = Popen([self.image], cwd=os.path.dirname(self.image),
+                             stdin=PIPE, stdout=PIPE, bufsize=0)
+        relay = threading.Thread(target=self.relay, args=(self.process,))
+        relay.daemon = True
+        relay.start()
+
+    def stop(self):
+        if self.process is not None and self.process.poll() is None:
+            self.process.kill()
+            self.process.wait()
+        self.process = None
+
+    def relay(self, process):
+        """ Copy the console between the process and the pseudo terminal,
+            until the process exits
+        """
+        out = process.stdout.fileno()
+        while True:
+            ready, _, _ = select.select([out, self.master], [], [])
+            if out in ready:
+                data = os.read(out, 1024)
+                if not data:
+                    break
+                os.write(self.master, data)
+            if self.master in ready:
+                data = os.read(self.master, 1024)
+                try:
+                    process.stdin.write(data)
+                    process.stdin.flush()
+                except (IOError, OSError):
+                    break
+
+NATIVE_POSIX_TARGET = NativePosixTarget()
+
+
+class HostTestPluginCopyMethod_NativePosix(HostTestPluginBase):
+    """ Plugin used to run NATIVE_POSIX images
+
+    The image is copied to the disk directory and started, its console is
+    <disk>/console.
+    """
+
+    # Plugin interface
+    name = 'HostTestPluginCopyMethod_NativePosix'
+    type = 'CopyMethod'
+    stable = True
+    capabilities = ['native-posix']
+    required_parameters = ['image_path', 'destination_disk', 'program_cycle_s']
+
+    def setup(self, *args, **kwargs):
+        """ Configure plugin, this function should be called before plugin execute() method is used.
+        """
+        return True
+
+    def execute(self, capability, *args, **kwargs):
+        """ Executes capability by name.
+            Each capability may directly just call some command line
+            program or execute building pythonic function
+        """
+        result = False
+        if self.check_parameters(capability, *args, **kwargs) is True:
+            image_path = kwargs['image_path']
+            destination_disk = kwargs['destination_disk']
+            program_cycle_s = kwargs['program_cycle_s']
+            if capability == 'native-posix':
+                try:
+                    if not os.path.isdir(destination_disk):
+                        os.makedirs(destination_disk)
+                    target = NATIVE_POSIX_TARGET
+                    target.image = os.path.abspath(join(destination_disk, basename(image_path)))
+                    shutil.copy(image_path, target.image)
+                    target.open_console(destination_disk)
+                    target.start()
+                    result = True
+                except (IOError, OSError) as e:
+                    self.print_plugin_error(str(e))
+
+            # Allow the process to start
+            sleep(program_cycle_s)
+
+        return result
+
+
+def load_plugin():
+    """ Returns plugin available in this module
+    """
+    return HostTestPluginCopyMethod_NativePosix()
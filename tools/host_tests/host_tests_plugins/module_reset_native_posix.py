@@ -0,0 +1,62 @@
+"""
+mbed SDK
+Copyright (c) 2019 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+from __future__ import print_function
+
+from .host_test_plugins import HostTestPluginBase
+from .module_copy_native_posix import NATIVE_POSIX_TARGET
+
+
+class HostTestPluginResetMethod_NativePosix(HostTestPluginBase):
+    """ Plugin used to reset NATIVE_POSIX images
+
+    The process started by the copy plugin is killed and started again.
+    """
+
+    # Plugin interface
+    name = 'HostTestPluginResetMethod_NativePosix'
+    type = 'ResetMethod'
+    stable = True
+    capabilities = ['native-posix']
+    required_parameters = ['disk']
+
+    def setup(self, *args, **kwargs):
+        """ Configure plugin, this function should be called before plugin execute() method is used.
+        """
+        return True
+
+    def execute(self, capability, *args, **kwargs):
+        """ Executes capability by name.
+            Each capability may directly just call some command line
+            program or execute building pythonic function
+        """
+        result = False
+        if self.check_parameters(capability, *args, **kwargs) is True:
+            if capability == 'native-posix':
+                if NATIVE_POSIX_TARGET.image is None:
+                    return self.print_plugin_error("no image, copy it with '-c native-posix'")
+                try:
+                    NATIVE_POSIX_TARGET.start()
+                    result = True
+                except (IOError, OSError) as e:
+                    self.print_plugin_error(str(e))
+        return result
+
+
+def load_plugin():
+    """ Returns plugin available in this module
+    """
+    return HostTestPluginResetMethod_NativePosix()
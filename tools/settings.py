@@ -39,6 +39,9 @@ GCC_ARM_PATH = ""
 # GCC CodeRed
 GCC_CR_PATH = ""
 
+# Host GCC for the native POSIX target
+GCC_NATIVE_PATH = ""
+
 # IAR
 IAR_PATH = ""
 
@@ -74,7 +77,7 @@ except ImportError:
 # User Settings (env vars)
 ##############################################################################
 _ENV_PATHS = ['ARM_PATH', 'GCC_ARM_PATH', 'GCC_CR_PATH', 'IAR_PATH',
-              'ARMC6_PATH']
+              'ARMC6_PATH', 'GCC_NATIVE_PATH']
 
 for _n in _ENV_PATHS:
     if getenv('MBED_'+_n):
@@ -310,6 +310,7 @@ LEGACY_TOOLCHAIN_NAMES = {
     'GCC_ARM': 'GCC_ARM', 'GCC_CR': 'GCC_CR',
     'IAR': 'IAR',
     'ARMC6': 'ARMC6',
+    'GCC_NATIVE': 'GCC_NATIVE',
 }
 
 
@@ -1131,7 +1132,7 @@ class mbedToolchain:
 
         filename = name+'.'+ext
         elf = join(tmp_path, name + '.elf')
-        bin = None if ext is 'elf' else join(tmp_path, filename)
+        bin = None if ext == 'elf' else join(tmp_path, filename)
         map = join(tmp_path, name + '.map')
 
         r.objects = sorted(set(r.objects))
@@ -1595,17 +1596,19 @@ class mbedToolchain:
         return to_ret
 
 from tools.settings import ARM_PATH, ARMC6_PATH, GCC_ARM_PATH, IAR_PATH
+from tools.settings import GCC_NATIVE_PATH
 
 TOOLCHAIN_PATHS = {
     'ARM': ARM_PATH,
     'uARM': ARM_PATH,
     'ARMC6': ARMC6_PATH,
     'GCC_ARM': GCC_ARM_PATH,
+    'GCC_NATIVE': GCC_NATIVE_PATH,
     'IAR': IAR_PATH
 }
 
 from tools.toolchains.arm import ARM_STD, ARM_MICRO, ARMC6
-from tools.toolchains.gcc import GCC_ARM
+from tools.toolchains.gcc import GCC_ARM, GCC_NATIVE
 from tools.toolchains.iar import IAR
 
 TOOLCHAIN_CLASSES = {
@@ -1613,6 +1616,7 @@ TOOLCHAIN_CLASSES = {
     u'uARM': ARM_MICRO,
     u'ARMC6': ARMC6,
     u'GCC_ARM': GCC_ARM,
+    u'GCC_NATIVE': GCC_NATIVE,
     u'IAR': IAR
 }
 
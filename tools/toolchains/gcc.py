@@ -287,3 +287,62 @@ class GCC(mbedToolchain):
 
 class GCC_ARM(GCC):
     pass
+
+class GCC_NATIVE(GCC):
+    """Host GCC for the NATIVE_POSIX target
+
+    The program runs as a Linux process, so it is linked with the host C
+    library and can be profiled with the host tools (perf, valgrind, gprof).
+    The mbed code casts pointers to 32 bit integers, so the program is built
+    for the 32 bit ABI of the host (gcc-multilib).
+    """
+    def __init__(self, target, notify=None, macros=None,
+                 silent=False, extra_verbose=False, build_profile=None,
+                 build_dir=None):
+        mbedToolchain.__init__(self, target, notify, macros, silent,
+                               extra_verbose=extra_verbose,
+                               build_profile=build_profile, build_dir=build_dir)
+
+        tool_path = TOOLCHAIN_PATHS['GCC_NATIVE']
+
+        self.cpu = ["-m32"]
+        self.flags["common"] += self.cpu
+
+        main_cc = join(tool_path, "gcc")
+        main_cppc = join(tool_path, "g++")
+        self.asm = [main_cc] + self.flags['asm'] + self.flags["common"]
+        self.cc  = [main_cc]
+        self.cppc =[main_cppc]
+        self.cc += self.flags['c'] + self.flags['common']
+        self.cppc += self.flags['cxx'] + self.flags['common']
+
+        self.flags['ld'] += self.cpu
+        self.ld = [main_cc] + self.flags['ld']
+        self.sys_libs = ["stdc++", "m", "pthread", "rt"]
+        self.preproc = [join(tool_path, "cpp"), "-E", "-P"]
+
+        self.ar = join(tool_path, "ar")
+        self.elf2bin = join(tool_path, "objcopy")
+
+    @staticmethod
+    def check_executable():
+        """Returns True if the executable (gcc) location specified by the
+        user exists OR the executable can be found on the PATH.
+        Returns False otherwise."""
+        if not TOOLCHAIN_PATHS['GCC_NATIVE'] or not exists(TOOLCHAIN_PATHS['GCC_NATIVE']):
+            if find_executable('gcc'):
+                TOOLCHAIN_PATHS['GCC_NATIVE'] = ''
+                return True
+            else:
+                return False
+        else:
+            exec_name = join(TOOLCHAIN_PATHS['GCC_NATIVE'], 'gcc')
+            return exists(exec_name)
+
+    def link_program(self, r, tmp_path, name):
+        """The image of NATIVE_POSIX is the elf executable (OUTPUT_EXT elf),
+        there is no binary, so the elf is returned as the image to run and test.
+        """
+        image, needed_update = mbedToolchain.link_program(self, r, tmp_path,
+                                                          name)
+        return image or join(tmp_path, name + '.elf'), needed_update